@@ -159,6 +159,8 @@ constexpr const char *GDAL_GEN_IMG_TRANSFORMER_CLASS_NAME =
 constexpr const char *GDAL_RPC_TRANSFORMER_CLASS_NAME = "GDALRPCTransformer";
 constexpr const char *GDAL_REPROJECTION_TRANSFORMER_CLASS_NAME =
     "GDALReprojectionTransformer";
+constexpr const char *GDAL_TRANSFORMATION_GRID_TRANSFORMER_CLASS_NAME =
+    "GDALTransformationGridTransformer";
 
 bool GDALIsTransformer(void *hTransformerArg, const char *pszClassName);
 
@@ -194,6 +196,20 @@ bool GDALTransformIsAffineNoRotation(GDALTransformerFunc pfnTransformer,
 
 bool GDALTransformHasFastClone(void *pTransformerArg);
 
+/* Transformer interpolating from a grid of precomputed coordinates */
+
+void *GDALCreateTransformationGridTransformer(
+    GDALTransformerFunc pfnBaseTransformer, void *pBaseTransformerArg,
+    int nDstXSize, int nDstYSize, CSLConstList papszOptions);
+
+int GDALTransformationGridTransform(void *pTransformArg, int bDstToSrc,
+                                    int nPointCount, double *x, double *y,
+                                    double *z, int *panSuccess);
+
+void GDALRefreshTransformationGridTransformer(void *pTransformArg);
+
+void *GDALGetTransformationGridBaseTransformer(void *pTransformArg);
+
 typedef struct _CPLQuadTree CPLQuadTree;
 
 typedef struct
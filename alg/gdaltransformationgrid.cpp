@@ -0,0 +1,849 @@
+/******************************************************************************
+ *
+ * Project:  GDAL
+ * Purpose:  Transformer backed by a grid of precomputed target to source
+ *           coordinates, that can be persisted and reused across warps.
+ * Author:   agent <agent at local>
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, agent <agent at local>
+ *
+ * SPDX-License-Identifier: MIT
+ ****************************************************************************/
+
+#include "cpl_port.h"
+#include "gdal_alg.h"
+#include "gdal_alg_priv.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "cpl_conv.h"
+#include "cpl_error.h"
+#include "cpl_minixml.h"
+#include "cpl_string.h"
+#include "cpl_vsi.h"
+#include "gdal.h"
+#include "gdal_priv.h"
+
+// Default (maximum) spacing, in target pixels, between grid nodes, and
+// minimum spacing the automatic refinement goes down to.
+constexpr int DEFAULT_GRID_STEP = 32;
+constexpr int MIN_AUTO_GRID_STEP = 4;
+
+// Maximum ratio of cells not fulfilling the error threshold before the
+// automatic refinement halves the grid step.
+constexpr double MAX_RATIO_INVALID_CELLS = 0.01;
+
+/************************************************************************/
+/*                       GDALTransformationGrid                         */
+/************************************************************************/
+
+namespace
+{
+/** Source pixel/line coordinates (and Z shift) of the nodes of a regular
+ * lattice in target pixel/line space, with a node every nStep pixels and
+ * nodes on the right and bottom edges of the target raster. */
+struct GDALTransformationGrid
+{
+    int nDstXSize = 0;
+    int nDstYSize = 0;
+    int nStep = 0;
+    int nGridXSize = 0;
+    int nGridYSize = 0;
+
+    // Node values, NaN when the node failed to transform.
+    std::vector<double> adfSrcX{};
+    std::vector<double> adfSrcY{};
+    std::vector<double> adfZOffset{};
+
+    // For each cell, indexed as its top-left node, whether the bilinear
+    // interpolation of its 4 nodes is within the error threshold. Always
+    // 0 on the last grid column and line.
+    std::vector<GByte> abyCellValid{};
+
+    bool Allocate(int nDstXSizeIn, int nDstYSizeIn, int nStepIn);
+    bool Compute(GDALTransformerFunc pfnTransformer, void *pTransformerArg,
+                 double dfMaxError, double &dfRatioInvalidCells);
+    bool Interpolate(double &dfX, double &dfY, double *pdfZ) const;
+
+    double NodeX(int i) const
+    {
+        return std::min(static_cast<double>(i) * nStep,
+                        static_cast<double>(nDstXSize));
+    }
+
+    double NodeY(int j) const
+    {
+        return std::min(static_cast<double>(j) * nStep,
+                        static_cast<double>(nDstYSize));
+    }
+};
+}  // namespace
+
+/************************************************************************/
+/*                 GDALTransformationGrid::Allocate()                   */
+/************************************************************************/
+
+bool GDALTransformationGrid::Allocate(int nDstXSizeIn, int nDstYSizeIn,
+                                      int nStepIn)
+{
+    nDstXSize = nDstXSizeIn;
+    nDstYSize = nDstYSizeIn;
+    nStep = nStepIn;
+    nGridXSize = DIV_ROUND_UP(nDstXSize, nStep) + 1;
+    nGridYSize = DIV_ROUND_UP(nDstYSize, nStep) + 1;
+    const size_t nNodes = static_cast<size_t>(nGridXSize) * nGridYSize;
+    try
+    {
+        adfSrcX.resize(nNodes);
+        adfSrcY.resize(nNodes);
+        adfZOffset.resize(nNodes);
+        abyCellValid.resize(nNodes);
+    }
+    catch (const std::bad_alloc &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate transformation grid of %d x %d nodes",
+                 nGridXSize, nGridYSize);
+        return false;
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                  GDALTransformationGrid::Compute()                   */
+/************************************************************************/
+
+/** Transform the grid nodes with the exact transformer, and check the
+ * bilinear interpolation of each cell against the transformed cell center.
+ *
+ * dfRatioInvalidCells is set to the ratio of cells whose 4 nodes transform
+ * successfully, but that exceed the error threshold.
+ */
+bool GDALTransformationGrid::Compute(GDALTransformerFunc pfnTransformer,
+                                     void *pTransformerArg, double dfMaxError,
+                                     double &dfRatioInvalidCells)
+{
+    constexpr double dfNaN = std::numeric_limits<double>::quiet_NaN();
+    std::vector<double> adfX, adfY, adfZ;
+    std::vector<int> abSuccess;
+    try
+    {
+        adfX.resize(nGridXSize);
+        adfY.resize(nGridXSize);
+        adfZ.resize(nGridXSize);
+        abSuccess.resize(nGridXSize);
+    }
+    catch (const std::bad_alloc &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate transformation grid working buffers");
+        return false;
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Transform nodes, one grid line at a time.                       */
+    /* -------------------------------------------------------------------- */
+    for (int j = 0; j < nGridYSize; ++j)
+    {
+        for (int i = 0; i < nGridXSize; ++i)
+        {
+            adfX[i] = NodeX(i);
+            adfY[i] = NodeY(j);
+            adfZ[i] = 0;
+            abSuccess[i] = FALSE;
+        }
+        pfnTransformer(pTransformerArg, TRUE, nGridXSize, adfX.data(),
+                       adfY.data(), adfZ.data(), abSuccess.data());
+        const size_t iLineOffset = static_cast<size_t>(j) * nGridXSize;
+        for (int i = 0; i < nGridXSize; ++i)
+        {
+            const bool bOK = abSuccess[i] && std::isfinite(adfX[i]) &&
+                             std::isfinite(adfY[i]) && std::isfinite(adfZ[i]);
+            adfSrcX[iLineOffset + i] = bOK ? adfX[i] : dfNaN;
+            adfSrcY[iLineOffset + i] = bOK ? adfY[i] : dfNaN;
+            adfZOffset[iLineOffset + i] = bOK ? adfZ[i] : dfNaN;
+        }
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Validate cells by transforming their center.                    */
+    /* -------------------------------------------------------------------- */
+    const int nCellsX = nGridXSize - 1;
+    const int nCellsY = nGridYSize - 1;
+    size_t nCandidateCells = 0;
+    size_t nInvalidCells = 0;
+    std::fill(abyCellValid.begin(), abyCellValid.end(), 0);
+    for (int j = 0; j < nCellsY; ++j)
+    {
+        for (int i = 0; i < nCellsX; ++i)
+        {
+            adfX[i] = (NodeX(i) + NodeX(i + 1)) / 2;
+            adfY[i] = (NodeY(j) + NodeY(j + 1)) / 2;
+            adfZ[i] = 0;
+            abSuccess[i] = FALSE;
+        }
+        pfnTransformer(pTransformerArg, TRUE, nCellsX, adfX.data(),
+                       adfY.data(), adfZ.data(), abSuccess.data());
+        for (int i = 0; i < nCellsX; ++i)
+        {
+            const size_t iNode = static_cast<size_t>(j) * nGridXSize + i;
+            const size_t aiNodes[] = {iNode, iNode + 1, iNode + nGridXSize,
+                                      iNode + nGridXSize + 1};
+            double dfAvgX = 0;
+            double dfAvgY = 0;
+            bool bNodesOK = true;
+            for (const size_t iCorner : aiNodes)
+            {
+                if (std::isnan(adfSrcX[iCorner]))
+                {
+                    bNodesOK = false;
+                    break;
+                }
+                dfAvgX += adfSrcX[iCorner];
+                dfAvgY += adfSrcY[iCorner];
+            }
+            if (!bNodesOK)
+                continue;
+            ++nCandidateCells;
+            dfAvgX /= 4;
+            dfAvgY /= 4;
+            if (abSuccess[i] && std::fabs(adfX[i] - dfAvgX) <= dfMaxError &&
+                std::fabs(adfY[i] - dfAvgY) <= dfMaxError)
+            {
+                abyCellValid[iNode] = 1;
+            }
+            else
+            {
+                ++nInvalidCells;
+            }
+        }
+    }
+
+    dfRatioInvalidCells =
+        nCandidateCells ? static_cast<double>(nInvalidCells) /
+                              static_cast<double>(nCandidateCells)
+                        : 0.0;
+    return true;
+}
+
+/************************************************************************/
+/*                GDALTransformationGrid::Interpolate()                 */
+/************************************************************************/
+
+/** Replace (dfX, dfY) target pixel/line coordinates by the interpolated
+ * source pixel/line coordinates, and add the interpolated Z shift to *pdfZ.
+ *
+ * @return false, leaving values untouched, if the point is outside of the
+ * target raster or in a cell not fulfilling the error threshold.
+ */
+bool GDALTransformationGrid::Interpolate(double &dfX, double &dfY,
+                                         double *pdfZ) const
+{
+    if (!(dfX >= 0 && dfX <= nDstXSize && dfY >= 0 && dfY <= nDstYSize))
+        return false;
+
+    const int iCellX =
+        std::min(static_cast<int>(dfX / nStep), nGridXSize - 2);
+    const int iCellY =
+        std::min(static_cast<int>(dfY / nStep), nGridYSize - 2);
+    const size_t iNode = static_cast<size_t>(iCellY) * nGridXSize + iCellX;
+    if (!abyCellValid[iNode])
+        return false;
+
+    const double dfX0 = NodeX(iCellX);
+    const double dfY0 = NodeY(iCellY);
+    const double dfFracX = (dfX - dfX0) / (NodeX(iCellX + 1) - dfX0);
+    const double dfFracY = (dfY - dfY0) / (NodeY(iCellY + 1) - dfY0);
+
+    const auto Bilinear = [iNode, dfFracX, dfFracY,
+                           this](const std::vector<double> &adfValues)
+    {
+        const double dfTop =
+            adfValues[iNode] +
+            (adfValues[iNode + 1] - adfValues[iNode]) * dfFracX;
+        const double dfBottom = adfValues[iNode + nGridXSize] +
+                                (adfValues[iNode + nGridXSize + 1] -
+                                 adfValues[iNode + nGridXSize]) *
+                                    dfFracX;
+        return dfTop + (dfBottom - dfTop) * dfFracY;
+    };
+
+    dfX = Bilinear(adfSrcX);
+    dfY = Bilinear(adfSrcY);
+    if (pdfZ)
+        *pdfZ += Bilinear(adfZOffset);
+    return true;
+}
+
+/************************************************************************/
+/*                GDALTransformationGridTransformInfo                   */
+/************************************************************************/
+
+namespace
+{
+struct GDALTransformationGridTransformInfo
+{
+    GDALTransformerInfo sTI;
+
+    GDALTransformerFunc pfnBaseTransformer = nullptr;
+    void *pBaseTransformerArg = nullptr;
+    bool bOwnBaseTransformer = false;
+
+    // Shared between clones with the same source ratio
+    std::shared_ptr<const GDALTransformationGrid> poGrid{};
+
+    // Working buffers for points that go through the base transformer
+    std::vector<int> anFallbackIdx{};
+    std::vector<double> adfFallbackX{};
+    std::vector<double> adfFallbackY{};
+    std::vector<double> adfFallbackZ{};
+    std::vector<int> abFallbackSuccess{};
+
+    GDALTransformationGridTransformInfo() : sTI()
+    {
+        memset(&sTI, 0, sizeof(sTI));
+    }
+
+    GDALTransformationGridTransformInfo(
+        const GDALTransformationGridTransformInfo &) = delete;
+    GDALTransformationGridTransformInfo &
+    operator=(const GDALTransformationGridTransformInfo &) = delete;
+};
+}  // namespace
+
+static void GDALDestroyTransformationGridTransformer(void *pTransformArg);
+static void *GDALCreateSimilarTransformationGridTransformer(void *pTransformArg,
+                                                           double dfSrcRatioX,
+                                                           double dfSrcRatioY);
+
+/************************************************************************/
+/*              GDALCreateTransformationGridTransformInfo()             */
+/************************************************************************/
+
+static GDALTransformationGridTransformInfo *
+GDALCreateTransformationGridTransformInfo(
+    GDALTransformerFunc pfnBaseTransformer, void *pBaseTransformerArg,
+    bool bOwnBaseTransformer,
+    const std::shared_ptr<const GDALTransformationGrid> &poGrid)
+{
+    auto psInfo = new GDALTransformationGridTransformInfo();
+    psInfo->pfnBaseTransformer = pfnBaseTransformer;
+    psInfo->pBaseTransformerArg = pBaseTransformerArg;
+    psInfo->bOwnBaseTransformer = bOwnBaseTransformer;
+    psInfo->poGrid = poGrid;
+
+    memcpy(psInfo->sTI.abySignature, GDAL_GTI2_SIGNATURE,
+           strlen(GDAL_GTI2_SIGNATURE));
+    psInfo->sTI.pszClassName = GDAL_TRANSFORMATION_GRID_TRANSFORMER_CLASS_NAME;
+    psInfo->sTI.pfnTransform = GDALTransformationGridTransform;
+    psInfo->sTI.pfnCleanup = GDALDestroyTransformationGridTransformer;
+    psInfo->sTI.pfnSerialize = nullptr;
+    psInfo->sTI.pfnCreateSimilar =
+        GDALCreateSimilarTransformationGridTransformer;
+
+    return psInfo;
+}
+
+/************************************************************************/
+/*             GDALDestroyTransformationGridTransformer()               */
+/************************************************************************/
+
+static void GDALDestroyTransformationGridTransformer(void *pTransformArg)
+{
+    if (pTransformArg == nullptr)
+        return;
+
+    auto psInfo =
+        static_cast<GDALTransformationGridTransformInfo *>(pTransformArg);
+    if (psInfo->bOwnBaseTransformer)
+        GDALDestroyTransformer(psInfo->pBaseTransformerArg);
+    delete psInfo;
+}
+
+/************************************************************************/
+/*          GDALCreateSimilarTransformationGridTransformer()            */
+/************************************************************************/
+
+static void *GDALCreateSimilarTransformationGridTransformer(void *pTransformArg,
+                                                           double dfSrcRatioX,
+                                                           double dfSrcRatioY)
+{
+    VALIDATE_POINTER1(pTransformArg,
+                      "GDALCreateSimilarTransformationGridTransformer",
+                      nullptr);
+
+    auto psInfo =
+        static_cast<GDALTransformationGridTransformInfo *>(pTransformArg);
+
+    void *pBaseTransformerArg =
+        (dfSrcRatioX == 1.0 && dfSrcRatioY == 1.0)
+            ? GDALCloneTransformer(psInfo->pBaseTransformerArg)
+            : GDALCreateSimilarTransformer(psInfo->pBaseTransformerArg,
+                                           dfSrcRatioX, dfSrcRatioY);
+    if (pBaseTransformerArg == nullptr)
+        return nullptr;
+
+    std::shared_ptr<const GDALTransformationGrid> poGrid = psInfo->poGrid;
+    if (dfSrcRatioX != 1.0 || dfSrcRatioY != 1.0)
+    {
+        // Source coordinates of a similar transformer are expressed in
+        // the pixel/line space of a source overview.
+        try
+        {
+            auto poNewGrid =
+                std::make_shared<GDALTransformationGrid>(*(psInfo->poGrid));
+            for (double &dfX : poNewGrid->adfSrcX)
+                dfX /= dfSrcRatioX;
+            for (double &dfY : poNewGrid->adfSrcY)
+                dfY /= dfSrcRatioY;
+            poGrid = std::move(poNewGrid);
+        }
+        catch (const std::bad_alloc &)
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "Cannot allocate transformation grid");
+            GDALDestroyTransformer(pBaseTransformerArg);
+            return nullptr;
+        }
+    }
+
+    return GDALCreateTransformationGridTransformInfo(
+        psInfo->pfnBaseTransformer, pBaseTransformerArg, true, poGrid);
+}
+
+/************************************************************************/
+/*                   GDALTransformationGridTransform()                  */
+/************************************************************************/
+
+/** Transformer function of the transformation grid transformer.
+ *
+ * Target to source transformations of points within the target raster
+ * extent, in grid cells that fulfill the error threshold, are bilinearly
+ * interpolated from the grid. Other points, and all source to target
+ * transformations, are forwarded to the base transformer.
+ */
+int GDALTransformationGridTransform(void *pTransformArg, int bDstToSrc,
+                                    int nPointCount, double *x, double *y,
+                                    double *z, int *panSuccess)
+{
+    auto psInfo =
+        static_cast<GDALTransformationGridTransformInfo *>(pTransformArg);
+
+    if (!bDstToSrc)
+    {
+        return psInfo->pfnBaseTransformer(psInfo->pBaseTransformerArg,
+                                          bDstToSrc, nPointCount, x, y, z,
+                                          panSuccess);
+    }
+
+    const GDALTransformationGrid &oGrid = *(psInfo->poGrid);
+    auto &anFallbackIdx = psInfo->anFallbackIdx;
+    anFallbackIdx.clear();
+    for (int i = 0; i < nPointCount; ++i)
+    {
+        if (oGrid.Interpolate(x[i], y[i], z ? z + i : nullptr))
+            panSuccess[i] = TRUE;
+        else
+            anFallbackIdx.push_back(i);
+    }
+    if (anFallbackIdx.empty())
+        return TRUE;
+
+    /* -------------------------------------------------------------------- */
+    /*      Forward remaining points to the base transformer in one call.   */
+    /* -------------------------------------------------------------------- */
+    const size_t nFallback = anFallbackIdx.size();
+    psInfo->adfFallbackX.resize(nFallback);
+    psInfo->adfFallbackY.resize(nFallback);
+    psInfo->adfFallbackZ.resize(nFallback);
+    psInfo->abFallbackSuccess.resize(nFallback);
+    for (size_t k = 0; k < nFallback; ++k)
+    {
+        const int i = anFallbackIdx[k];
+        psInfo->adfFallbackX[k] = x[i];
+        psInfo->adfFallbackY[k] = y[i];
+        psInfo->adfFallbackZ[k] = z ? z[i] : 0.0;
+        psInfo->abFallbackSuccess[k] = FALSE;
+    }
+    const int nRet = psInfo->pfnBaseTransformer(
+        psInfo->pBaseTransformerArg, bDstToSrc, static_cast<int>(nFallback),
+        psInfo->adfFallbackX.data(), psInfo->adfFallbackY.data(),
+        psInfo->adfFallbackZ.data(), psInfo->abFallbackSuccess.data());
+    for (size_t k = 0; k < nFallback; ++k)
+    {
+        const int i = anFallbackIdx[k];
+        x[i] = psInfo->adfFallbackX[k];
+        y[i] = psInfo->adfFallbackY[k];
+        if (z)
+            z[i] = psInfo->adfFallbackZ[k];
+        panSuccess[i] = psInfo->abFallbackSuccess[k];
+    }
+
+    return nRet;
+}
+
+/************************************************************************/
+/*             GDALRefreshTransformationGridTransformer()               */
+/************************************************************************/
+
+/** Refresh the base transformer, typically after a change of the
+ * CHECK_WITH_INVERT_PROJ configuration option. */
+void GDALRefreshTransformationGridTransformer(void *pTransformArg)
+{
+    auto psInfo =
+        static_cast<GDALTransformationGridTransformInfo *>(pTransformArg);
+    if (GDALIsTransformer(psInfo->pBaseTransformerArg,
+                          GDAL_GEN_IMG_TRANSFORMER_CLASS_NAME))
+    {
+        GDALRefreshGenImgProjTransformer(psInfo->pBaseTransformerArg);
+    }
+    else if (GDALIsTransformer(psInfo->pBaseTransformerArg,
+                               GDAL_APPROX_TRANSFORMER_CLASS_NAME))
+    {
+        GDALRefreshApproxTransformer(psInfo->pBaseTransformerArg);
+    }
+}
+
+/************************************************************************/
+/*             GDALGetTransformationGridBaseTransformer()               */
+/************************************************************************/
+
+/** Return the argument of the transformer used for points outside of valid
+ * grid cells, so that callers can check its class. */
+void *GDALGetTransformationGridBaseTransformer(void *pTransformArg)
+{
+    return static_cast<GDALTransformationGridTransformInfo *>(pTransformArg)
+        ->pBaseTransformerArg;
+}
+
+/************************************************************************/
+/*                     GetTransformerDescription()                      */
+/************************************************************************/
+
+/** Return the XML serialization of the transformer, used to check that a
+ * persisted grid matches it, or an empty string if it cannot be serialized.
+ */
+static std::string GetTransformerDescription(void *pTransformerArg)
+{
+    const auto psTI = static_cast<GDALTransformerInfo *>(pTransformerArg);
+    if (psTI->pfnSerialize == nullptr)
+        return std::string();
+    CPLXMLTreeCloser oTree(psTI->pfnSerialize(pTransformerArg));
+    if (!oTree)
+        return std::string();
+    char *pszXML = CPLSerializeXMLTree(oTree.get());
+    std::string osXML(pszXML ? pszXML : "");
+    CPLFree(pszXML);
+    return osXML;
+}
+
+/************************************************************************/
+/*                    LoadTransformationGrid()                          */
+/************************************************************************/
+
+/** Load a persisted transformation grid. Return nullptr if the file does
+ * not exist, or does not match the requested parameters. */
+static std::unique_ptr<GDALTransformationGrid>
+LoadTransformationGrid(const char *pszFilename, int nDstXSize, int nDstYSize,
+                       int nRequestedStep, const std::string *posTransformer)
+{
+    VSIStatBufL sStat;
+    if (VSIStatL(pszFilename, &sStat) != 0)
+        return nullptr;
+
+    const char *const apszAllowedDrivers[] = {"GTiff", nullptr};
+    auto poDS = std::unique_ptr<GDALDataset>(
+        GDALDataset::Open(pszFilename, GDAL_OF_RASTER, apszAllowedDrivers));
+    if (!poDS)
+        return nullptr;
+
+    const auto GetMD = [&poDS](const char *pszKey)
+    {
+        const char *pszValue = poDS->GetMetadataItem(pszKey);
+        return pszValue ? pszValue : "";
+    };
+    const int nStep = atoi(GetMD("STEP"));
+    if (poDS->GetRasterCount() != 4 ||
+        atoi(GetMD("TARGET_WIDTH")) != nDstXSize ||
+        atoi(GetMD("TARGET_HEIGHT")) != nDstYSize || nStep <= 0 ||
+        (nRequestedStep > 0 && nStep != nRequestedStep) ||
+        poDS->GetRasterXSize() != DIV_ROUND_UP(nDstXSize, nStep) + 1 ||
+        poDS->GetRasterYSize() != DIV_ROUND_UP(nDstYSize, nStep) + 1)
+    {
+        CPLDebug("WARP",
+                 "Transformation grid %s does not match the target raster "
+                 "dimensions or step",
+                 pszFilename);
+        return nullptr;
+    }
+    if (posTransformer && *posTransformer != GetMD("TRANSFORMER"))
+    {
+        CPLDebug("WARP",
+                 "Transformation grid %s does not match the current "
+                 "transformer",
+                 pszFilename);
+        return nullptr;
+    }
+
+    auto poGrid = std::make_unique<GDALTransformationGrid>();
+    if (!poGrid->Allocate(nDstXSize, nDstYSize, nStep))
+        return nullptr;
+    const int nGridXSize = poGrid->nGridXSize;
+    const int nGridYSize = poGrid->nGridYSize;
+    std::vector<double> adfValid;
+    try
+    {
+        adfValid.resize(static_cast<size_t>(nGridXSize) * nGridYSize);
+    }
+    catch (const std::bad_alloc &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate transformation grid");
+        return nullptr;
+    }
+    double *const apadfBands[] = {poGrid->adfSrcX.data(),
+                                  poGrid->adfSrcY.data(),
+                                  poGrid->adfZOffset.data(), adfValid.data()};
+    for (int iBand = 0; iBand < 4; ++iBand)
+    {
+        if (poDS->GetRasterBand(iBand + 1)->RasterIO(
+                GF_Read, 0, 0, nGridXSize, nGridYSize, apadfBands[iBand],
+                nGridXSize, nGridYSize, GDT_Float64, 0, 0,
+                nullptr) != CE_None)
+        {
+            return nullptr;
+        }
+    }
+    for (size_t i = 0; i < adfValid.size(); ++i)
+        poGrid->abyCellValid[i] = adfValid[i] == 1.0 ? 1 : 0;
+
+    return poGrid;
+}
+
+/************************************************************************/
+/*                    SaveTransformationGrid()                          */
+/************************************************************************/
+
+static bool SaveTransformationGrid(const char *pszFilename,
+                                   const GDALTransformationGrid &oGrid,
+                                   const std::string &osTransformer)
+{
+    auto poDriver = GetGDALDriverManager()->GetDriverByName("GTiff");
+    if (!poDriver)
+    {
+        CPLError(CE_Warning, CPLE_AppDefined,
+                 "GTiff driver needed to save transformation grid %s",
+                 pszFilename);
+        return false;
+    }
+
+    std::vector<double> adfValid(oGrid.abyCellValid.begin(),
+                                 oGrid.abyCellValid.end());
+    const double *const apadfBands[] = {
+        oGrid.adfSrcX.data(), oGrid.adfSrcY.data(), oGrid.adfZOffset.data(),
+        adfValid.data()};
+    const char *const apszBandDesc[] = {"source_x", "source_y", "z_offset",
+                                        "cell_valid"};
+
+    // Write to a temporary file in the same directory and rename it into
+    // place, so that a concurrent reader never sees a partially written grid.
+    const std::string osTmpFilename = CPLFormFilenameSafe(
+        CPLGetPathSafe(pszFilename).c_str(),
+        CPLGetFilename(
+            CPLGenerateTempFilenameSafe(CPLGetFilename(pszFilename)).c_str()),
+        "tmp");
+
+    bool bOK;
+    {
+        CPLErrorStateBackuper oErrorStateBackuper(CPLQuietErrorHandler);
+        auto poDS = std::unique_ptr<GDALDataset>(poDriver->Create(
+            osTmpFilename.c_str(), oGrid.nGridXSize, oGrid.nGridYSize, 4,
+            GDT_Float64, nullptr));
+        bOK = poDS != nullptr;
+        if (bOK)
+        {
+            poDS->SetMetadataItem("TARGET_WIDTH",
+                                  CPLSPrintf("%d", oGrid.nDstXSize));
+            poDS->SetMetadataItem("TARGET_HEIGHT",
+                                  CPLSPrintf("%d", oGrid.nDstYSize));
+            poDS->SetMetadataItem("STEP", CPLSPrintf("%d", oGrid.nStep));
+            poDS->SetMetadataItem("TRANSFORMER", osTransformer.c_str());
+            for (int iBand = 0; bOK && iBand < 4; ++iBand)
+            {
+                auto poBand = poDS->GetRasterBand(iBand + 1);
+                poBand->SetDescription(apszBandDesc[iBand]);
+                bOK = poBand->RasterIO(
+                          GF_Write, 0, 0, oGrid.nGridXSize, oGrid.nGridYSize,
+                          const_cast<double *>(apadfBands[iBand]),
+                          oGrid.nGridXSize, oGrid.nGridYSize, GDT_Float64, 0,
+                          0, nullptr) == CE_None;
+            }
+            bOK = poDS->Close() == CE_None && bOK;
+            poDS.reset();
+            bOK = bOK && VSIRename(osTmpFilename.c_str(), pszFilename) == 0;
+            if (!bOK)
+                VSIUnlink(osTmpFilename.c_str());
+        }
+    }
+    if (!bOK)
+    {
+        CPLError(CE_Warning, CPLE_AppDefined,
+                 "Cannot save transformation grid %s", pszFilename);
+    }
+    return bOK;
+}
+
+/************************************************************************/
+/*             GDALCreateTransformationGridTransformer()                */
+/************************************************************************/
+
+/**
+ * Create a transformer that interpolates target to source transformations
+ * from a grid of precomputed coordinates.
+ *
+ * Grid nodes are computed with the exact transformer underlying
+ * pfnBaseTransformer (the base transformer of an approximate transformer),
+ * every STEP target pixels. A grid cell is used only if the bilinear
+ * interpolation of its 4 nodes at its center is within ERROR_THRESHOLD
+ * source pixels of the exact transformation. Other points, as well as source
+ * to target transformations, go through pfnBaseTransformer.
+ *
+ * When FILENAME is set, the grid is read from that file if it exists and
+ * matches the target raster dimensions and the transformer, and otherwise
+ * it is computed and written to it (as a GeoTIFF file), so that subsequent
+ * warps with the same geometry skip the computation of coordinates.
+ *
+ * Supported options:
+ * <ul>
+ * <li>FILENAME=filename: file where to persist the grid.</li>
+ * <li>STEP=integer: spacing between grid nodes, in target pixels. By default,
+ * starts at 32 and is halved down to 4 while more than 1% of the grid cells
+ * exceed the error threshold.</li>
+ * <li>ERROR_THRESHOLD=float: maximum error, in source pixels. Defaults to
+ * the reverse error threshold of an approximate base transformer, or 0
+ * otherwise, in which case no grid is created.</li>
+ * <li>CHECK_TRANSFORMER=YES/NO: whether to check that a persisted grid was
+ * computed with the same transformer. Defaults to YES. Setting it to NO
+ * allows reusing a grid when the transformer cannot be serialized.</li>
+ * </ul>
+ *
+ * The base transformer is not owned by the returned transformer, which must
+ * be destroyed with GDALDestroyTransformer() before it.
+ *
+ * @return the transformer, or nullptr in case of error.
+ */
+void *GDALCreateTransformationGridTransformer(
+    GDALTransformerFunc pfnBaseTransformer, void *pBaseTransformerArg,
+    int nDstXSize, int nDstYSize, CSLConstList papszOptions)
+{
+    if (nDstXSize <= 0 || nDstYSize <= 0)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Invalid target dimensions for transformation grid");
+        return nullptr;
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Nodes are computed with the exact transformer.                  */
+    /* -------------------------------------------------------------------- */
+    GDALTransformerFunc pfnExactTransformer = pfnBaseTransformer;
+    void *pExactTransformerArg = pBaseTransformerArg;
+    // An exact transformer means that exact transformations are requested
+    double dfMaxError = 0;
+    if (GDALIsTransformer(pBaseTransformerArg,
+                          GDAL_APPROX_TRANSFORMER_CLASS_NAME))
+    {
+        const auto psApproxInfo =
+            static_cast<GDALApproxTransformInfo *>(pBaseTransformerArg);
+        pfnExactTransformer = psApproxInfo->pfnBaseTransformer;
+        pExactTransformerArg = psApproxInfo->pBaseCBData;
+        dfMaxError = psApproxInfo->dfMaxErrorReverse;
+    }
+    if (const char *pszMaxError =
+            CSLFetchNameValue(papszOptions, "ERROR_THRESHOLD"))
+    {
+        dfMaxError = CPLAtof(pszMaxError);
+    }
+    if (!(dfMaxError > 0))
+    {
+        CPLError(CE_Warning, CPLE_AppDefined,
+                 "A transformation grid cannot be used with an error "
+                 "threshold of 0");
+        return nullptr;
+    }
+
+    const int nRequestedStep =
+        atoi(CSLFetchNameValueDef(papszOptions, "STEP", "0"));
+    const char *pszFilename = CSLFetchNameValue(papszOptions, "FILENAME");
+    const std::string osTransformer =
+        GetTransformerDescription(pBaseTransformerArg);
+    const bool bCheckTransformer =
+        CPLFetchBool(papszOptions, "CHECK_TRANSFORMER", true);
+
+    /* -------------------------------------------------------------------- */
+    /*      Try to reuse a persisted grid.                                  */
+    /* -------------------------------------------------------------------- */
+    std::shared_ptr<const GDALTransformationGrid> poGrid;
+    if (pszFilename)
+    {
+        poGrid = LoadTransformationGrid(
+            pszFilename, nDstXSize, nDstYSize, nRequestedStep,
+            bCheckTransformer ? &osTransformer : nullptr);
+        if (poGrid)
+        {
+            CPLDebug("WARP", "Transformation grid loaded from %s (step %d)",
+                     pszFilename, poGrid->nStep);
+        }
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Otherwise compute it, refining the step if needed.              */
+    /* -------------------------------------------------------------------- */
+    if (!poGrid)
+    {
+        auto poNewGrid = std::make_unique<GDALTransformationGrid>();
+        int nStep = nRequestedStep > 0
+                        ? nRequestedStep
+                        : std::min(DEFAULT_GRID_STEP,
+                                   std::max(nDstXSize, nDstYSize));
+        while (true)
+        {
+            double dfRatioInvalidCells = 0;
+            if (!poNewGrid->Allocate(nDstXSize, nDstYSize, nStep) ||
+                !poNewGrid->Compute(pfnExactTransformer, pExactTransformerArg,
+                                    dfMaxError, dfRatioInvalidCells))
+            {
+                return nullptr;
+            }
+            CPLDebug("WARP",
+                     "Transformation grid computed with step %d: "
+                     "%.2f%% of cells exceed the error threshold",
+                     nStep, dfRatioInvalidCells * 100);
+            if (nRequestedStep > 0 ||
+                dfRatioInvalidCells <= MAX_RATIO_INVALID_CELLS ||
+                nStep / 2 < MIN_AUTO_GRID_STEP)
+            {
+                break;
+            }
+            nStep /= 2;
+        }
+
+        if (pszFilename &&
+            SaveTransformationGrid(pszFilename, *poNewGrid, osTransformer))
+        {
+            CPLDebug("WARP", "Transformation grid saved to %s", pszFilename);
+        }
+        poGrid = std::move(poNewGrid);
+    }
+
+    return GDALCreateTransformationGridTransformInfo(
+        pfnBaseTransformer, pBaseTransformerArg, false, poGrid);
+}
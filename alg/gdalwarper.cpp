@@ -1163,6 +1163,21 @@ const char *GDALWarpGetOptionList(void)
            "Can be set to a numeric value or ALL_CPUS to set the number of "
            "threads to use to parallelize the computation part of the warping. "
            "If not set, computation will be done in a single thread..'/>"
+           "<Option name='PIPELINE_DEPTH' type='string' description='"
+           "Can be set to a numeric value or ALL_CPUS. Only used by "
+           "GDALWarpOperation::ChunkAndWarpMulti() (gdalwarp -multi). Number "
+           "of chunks processed concurrently: while the warp kernel runs on a "
+           "chunk, the source data of the next ones is read, and the result "
+           "of the previous ones is written. When explicitly set, the warp "
+           "memory limit is shared among the chunks in flight. The NUM_THREADS "
+           "threads are also shared among them.' default='2'/>"
+           "<Option name='PIPELINE_ORDERED_WRITES' type='boolean' "
+           "description='Only used by GDALWarpOperation::ChunkAndWarpMulti() "
+           "(gdalwarp -multi). Whether chunks must be written to the "
+           "destination dataset in the order they are generated. Setting it "
+           "to NO may increase throughput, but may also cause more seeking "
+           "in the output file. Ignored when STREAMABLE_OUTPUT=YES.' "
+           "default='YES'/>"
            "<Option name='STREAMABLE_OUTPUT' type='boolean' description='"
            "This defaults to FALSE, but may be set to TRUE typically when "
            "writing to a streamed file. The gdalwarp utility automatically "
@@ -1265,6 +1280,34 @@ const char *GDALWarpGetOptionList(void)
            "  <Value>MIN</Value>"
            "  <Value>MAX</Value>"
            "</Option>"
+           "<Option name='SEPARABLE_RESAMPLING' type='boolean' "
+           "description='"
+           "Whether bilinear, cubic, cubicspline and lanczos resampling "
+           "(when there is no source mask), and average and sum resampling, "
+           "may be done as a horizontal pass followed by a vertical pass, "
+           "when the transformation is only a scaling and a translation "
+           "(for average and sum, within the error threshold of the "
+           "approximate transformer over a chunk). "
+           "Results may differ from the per-pixel code path by rounding "
+           "errors.' default='NO'/>"
+           "<Option name='SPECIALIZED_MASKED_RESAMPLING' type='boolean' "
+           "description='"
+           "Whether bilinear, cubic, cubicspline and lanczos resampling of "
+           "Byte, Int16, UInt16 and Float32 sources with a nodata value or "
+           "a validity mask, but no alpha band, may use code paths "
+           "specialized for those data types. Results are identical to the "
+           "generic code path.' default='YES'/>"
+           "<Option name='TRANSFORMATION_GRID' type='string' description='"
+           "MEM, or name of a file where to persist a grid of precomputed "
+           "target to source coordinates, reused by subsequent warps with "
+           "the same geometry.'/>"
+           "<Option name='TRANSFORMATION_GRID_STEP' type='int' min='1' "
+           "description='Spacing between nodes of the transformation grid, "
+           "in target pixels. Automatically determined by default.'/>"
+           "<Option name='TRANSFORMATION_GRID_CHECK_TRANSFORMER' "
+           "type='boolean' description='"
+           "Whether to check that a persisted transformation grid has been "
+           "computed with the same transformer.' default='YES'/>"
            "</OptionList>";
 }
 
@@ -1399,6 +1442,25 @@ const char *GDALWarpGetOptionList(void)
  * set the number of threads to use to parallelize the computation part of the
  * warping. If not set, computation will be done in a single thread.</li>
  *
+ * <li>PIPELINE_DEPTH: (GDAL >= 3.12) Can be set to a numeric value or
+ * ALL_CPUS. Only used by GDALWarpOperation::ChunkAndWarpMulti() (gdalwarp
+ * -multi). Number of chunks processed concurrently: while the warp kernel
+ * runs on a chunk, the source data of the next ones is read, and the result
+ * of the previous ones is written. Reads of the source dataset are done in
+ * parallel when it is thread-safe, or, if PIPELINE_DEPTH is greater than 2,
+ * when a thread-safe instance of it can be obtained with
+ * GDALGetThreadSafeDataset(). When explicitly set, the warp memory limit is
+ * shared among the chunks in flight. The NUM_THREADS threads of the warp
+ * kernel are also shared among them, rather than used by each of them.
+ * The default is 2.</li>
+ *
+ * <li>PIPELINE_ORDERED_WRITES: (GDAL >= 3.12) Only used by
+ * GDALWarpOperation::ChunkAndWarpMulti() (gdalwarp -multi). Whether chunks
+ * must be written to the destination dataset in the order they are generated.
+ * Setting it to NO may increase throughput, but may also cause more seeking
+ * in the output file. Ignored when STREAMABLE_OUTPUT=YES. The default is
+ * YES.</li>
+ *
  * <li>STREAMABLE_OUTPUT: (GDAL >= 2.0) This defaults to FALSE, but may
  * be set to TRUE typically when writing to a streamed file. The
  * gdalwarp utility automatically sets this option when writing to
@@ -1503,6 +1565,53 @@ const char *GDALWarpGetOptionList(void)
  * ties with MODE resampling. By default, the first value encountered will be used.
  * Alternatively, the minimum or maximum value can be selected.</li>
  *
+ * <li>SEPARABLE_RESAMPLING=YES/NO: (GDAL >= 3.12) Whether Bilinear, Cubic,
+ * CubicSpline and Lanczos resampling may be done as a horizontal pass followed
+ * by a vertical pass, with filter weights computed once per destination column
+ * and line, when the transformation between the source and target pixel
+ * spaces is only a scaling and a translation, and the source has no
+ * nodata/mask/alpha. Average and Sum resampling are also done in two passes
+ * in that situation, or when the transformation is so within the error
+ * threshold of the approximate transformer over a warped chunk, as for
+ * reprojections of small areas, source masks being supported: source lines
+ * are first accumulated per source column, and each target pixel is then
+ * computed from the column aggregates of its footprint, so that each source
+ * pixel is read about once whatever the downsampling factor. This is much
+ * faster when downsampling. Results may differ from the per-pixel code path
+ * by rounding errors (integer output values may differ by one), which is why
+ * this is not enabled by default. Default is NO.</li>
+ *
+ * <li>SPECIALIZED_MASKED_RESAMPLING=YES/NO: (GDAL >= 3.12) Whether Bilinear,
+ * Cubic, CubicSpline and Lanczos resampling of Byte, Int16, UInt16 and Float32
+ * sources with a nodata value or a validity mask, but no alpha band, may use
+ * code paths specialized for those data types, that read source pixels and
+ * validity masks directly. Results are identical to the generic code path.
+ * Default is YES.</li>
+ *
+ * <li>TRANSFORMATION_GRID=MEM/filename: (GDAL >= 3.12) Interpolate target to
+ * source coordinates from a grid of coordinates precomputed with the exact
+ * transformer, instead of calling the transformer for each chunk and
+ * scanline. Grid cells whose bilinear interpolation exceeds the error
+ * threshold (ERROR_THRESHOLD, or the one of the approximate transformer)
+ * fall back to the transformer. Not used with an exact transformer, unless
+ * ERROR_THRESHOLD is set to a positive value. When set to a filename, the
+ * grid is read from that file (a GeoTIFF file) if it exists and matches the
+ * target raster dimensions and the transformer, and is otherwise computed
+ * and written to it. This saves most of the coordinate transformation cost
+ * when warping many rasters with the same geometry, typically with
+ * geolocation arrays or RPC. Not used for affine transformations.</li>
+ *
+ * <li>TRANSFORMATION_GRID_STEP=integer: (GDAL >= 3.12) Spacing between
+ * nodes of the transformation grid, in target pixels. By default, starts at
+ * 32 and is halved down to 4 while more than 1% of the grid cells exceed the
+ * error threshold.</li>
+ *
+ * <li>TRANSFORMATION_GRID_CHECK_TRANSFORMER=YES/NO: (GDAL >= 3.12) Whether
+ * to check that a persisted transformation grid has been computed with the
+ * same transformer, by comparing its serialization. Setting it to NO allows
+ * reusing a grid for sources whose transformer differs only in ways that do
+ * not affect coordinates. Default is YES.</li>
+ *
  * </ul>
  */
 
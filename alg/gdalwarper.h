@@ -498,6 +498,7 @@ void GWKThreadsEnd(void *psThreadDataIn);
 
 /*! @cond Doxygen_Suppress */
 typedef struct _GDALWarpChunk GDALWarpChunk;
+struct GDALWarpPipelineJob;
 
 struct GDALTransformerUniquePtrReleaser
 {
@@ -521,8 +522,14 @@ class CPL_DLL GDALWarpOperation final
   private:
     GDALWarpOptions *psOptions = nullptr;
     GDALTransformerArgUniquePtr m_psOwnedTransformerArg{nullptr};
+    // Transformer interpolating target to source coordinates from a grid,
+    // when the TRANSFORMATION_GRID warp option is set.
+    GDALTransformerArgUniquePtr m_psTransformationGridArg{nullptr};
 
     void WipeOptions();
+    GDALTransformerFunc GetTransformer() const;
+    void *GetTransformerArg() const;
+    CPLErr CreateTransformationGrid();
     int ValidateOptions();
 
     bool ComputeSourceWindowTransformPoints(
@@ -541,9 +548,6 @@ class CPL_DLL GDALWarpOperation final
     static CPLErr CreateKernelMask(GDALWarpKernel *, int iBand,
                                    const char *pszType);
 
-    CPLMutex *hIOMutex = nullptr;
-    CPLMutex *hWarpMutex = nullptr;
-
     int nChunkListCount = 0;
     int nChunkListMax = 0;
     GDALWarpChunk *pasChunkList = nullptr;
@@ -561,11 +565,25 @@ class CPL_DLL GDALWarpOperation final
 
     void WipeChunkList();
     CPLErr CollectChunkListInternal(int nDstXOff, int nDstYOff, int nDstXSize,
-                                    int nDstYSize);
+                                    int nDstYSize, double dfChunkMemoryLimit);
     void CollectChunkList(int nDstXOff, int nDstYOff, int nDstXSize,
-                          int nDstYSize);
+                          int nDstYSize, double dfChunkMemoryLimit);
     void ReportTiming(const char *);
 
+    CPLErr WarpRegionInternal(int nDstXOff, int nDstYOff, int nDstXSize,
+                              int nDstYSize, int nSrcXOff, int nSrcYOff,
+                              int nSrcXSize, int nSrcYSize,
+                              double dfSrcXExtraSize, double dfSrcYExtraSize,
+                              double dfProgressBase, double dfProgressScale,
+                              GDALWarpPipelineJob *psJob);
+    CPLErr WarpRegionToBufferInternal(
+        int nDstXOff, int nDstYOff, int nDstXSize, int nDstYSize,
+        void *pDataBuf, int nSrcXOff, int nSrcYOff, int nSrcXSize,
+        int nSrcYSize, double dfSrcXExtraSize, double dfSrcYExtraSize,
+        double dfProgressBase, double dfProgressScale,
+        GDALWarpPipelineJob *psJob);
+    void WarpPipelineChunk(GDALWarpPipelineJob *psJob);
+
   public:
     GDALWarpOperation();
     ~GDALWarpOperation();
@@ -191,6 +191,10 @@ static CPLErr GWKNearestNoMasksOrDstDensityOnlyFloat(GDALWarpKernel *poWK);
 static CPLErr GWKNearestFloat(GDALWarpKernel *poWK);
 static CPLErr GWKAverageOrMode(GDALWarpKernel *);
 static CPLErr GWKSumPreserving(GDALWarpKernel *);
+static bool GWKSeparableCanBeUsed(const GDALWarpKernel *poWK);
+static CPLErr GWKSeparableResample(GDALWarpKernel *poWK);
+static bool GWKSeparableAreaCanBeUsed(const GDALWarpKernel *poWK);
+static CPLErr GWKSeparableAreaResample(GDALWarpKernel *poWK);
 static CPLErr GWKCubicNoMasksOrDstDensityOnlyUShort(GDALWarpKernel *);
 static CPLErr GWKCubicSplineNoMasksOrDstDensityOnlyUShort(GDALWarpKernel *);
 static CPLErr GWKBilinearNoMasksOrDstDensityOnlyUShort(GDALWarpKernel *);
@@ -1201,6 +1205,12 @@ CPLErr GDALWarpKernel::PerformWarp()
     if (CPLFetchBool(papszWarpOptions, "USE_GENERAL_CASE", false))
         return GWKGeneralCase(this);
 
+    if (GWKSeparableCanBeUsed(this))
+        return GWKSeparableResample(this);
+
+    if (GWKSeparableAreaCanBeUsed(this))
+        return GWKSeparableAreaResample(this);
+
     const bool bNoMasksOrDstDensityOnly =
         papanBandSrcValid == nullptr && panUnifiedSrcValid == nullptr &&
         pafUnifiedSrcDensity == nullptr && panDstValid == nullptr;
@@ -3888,31 +3898,19 @@ static bool GWKResample(const GDALWarpKernel *poWK, int iBand, double dfSrcX,
 }
 
 /************************************************************************/
-/*                      GWKResampleOptimizedLanczos()                   */
+/*              GWKResampleOptimizedLanczosComputeWeights()             */
 /************************************************************************/
 
-static bool GWKResampleOptimizedLanczos(const GDALWarpKernel *poWK, int iBand,
-                                        double dfSrcX, double dfSrcY,
-                                        double *pdfDensity, double *pdfReal,
-                                        double *pdfImag,
-                                        GWKResampleWrkStruct *psWrkStruct)
-
+// Computes the bounds of the Lanczos window around (iSrcX, iSrcY), clipped
+// to the source image, and the X and Y weights of that window into
+// psWrkStruct->padfWeightsX and psWrkStruct->padfWeightsY.
+static void GWKResampleOptimizedLanczosComputeWeights(
+    const GDALWarpKernel *poWK, GWKResampleWrkStruct *psWrkStruct, int iSrcX,
+    int iSrcY, double dfDeltaX, double dfDeltaY, int &iMin, int &iMax,
+    int &jMin, int &jMax)
 {
-    // Save as local variables to avoid following pointers in loops.
     const int nSrcXSize = poWK->nSrcXSize;
     const int nSrcYSize = poWK->nSrcYSize;
-
-    double dfAccumulatorReal = 0.0;
-    double dfAccumulatorImag = 0.0;
-    double dfAccumulatorDensity = 0.0;
-    double dfAccumulatorWeight = 0.0;
-    const int iSrcX = static_cast<int>(floor(dfSrcX - 0.5));
-    const int iSrcY = static_cast<int>(floor(dfSrcY - 0.5));
-    const GPtrDiff_t iSrcOffset =
-        iSrcX + static_cast<GPtrDiff_t>(iSrcY) * nSrcXSize;
-    const double dfDeltaX = dfSrcX - 0.5 - iSrcX;
-    const double dfDeltaY = dfSrcY - 0.5 - iSrcY;
-
     const double dfXScale = poWK->dfXScale;
     const double dfYScale = poWK->dfYScale;
 
@@ -3922,21 +3920,16 @@ static bool GWKResampleOptimizedLanczos(const GDALWarpKernel *poWK, int iBand,
     double *const padfWeightsYShifted =
         psWrkStruct->padfWeightsY - poWK->nFiltInitY;
 
-    // Space for saving a row of pixels.
-    double *const padfRowDensity = psWrkStruct->padfRowDensity;
-    double *const padfRowReal = psWrkStruct->padfRowReal;
-    double *const padfRowImag = psWrkStruct->padfRowImag;
-
     // Skip sampling over edge of image.
-    int jMin = poWK->nFiltInitY;
-    int jMax = poWK->nYRadius;
+    jMin = poWK->nFiltInitY;
+    jMax = poWK->nYRadius;
     if (iSrcY + jMin < 0)
         jMin = -iSrcY;
     if (iSrcY + jMax >= nSrcYSize)
         jMax = nSrcYSize - iSrcY - 1;
 
-    int iMin = poWK->nFiltInitX;
-    int iMax = poWK->nXRadius;
+    iMin = poWK->nFiltInitX;
+    iMax = poWK->nXRadius;
     if (iSrcX + iMin < 0)
         iMin = -iSrcX;
     if (iSrcX + iMax >= nSrcXSize)
@@ -4209,6 +4202,51 @@ static bool GWKResampleOptimizedLanczos(const GDALWarpKernel *poWK, int iBand,
             psWrkStruct->dfLastDeltaY = dfDeltaY;
         }
     }
+}
+
+/************************************************************************/
+/*                      GWKResampleOptimizedLanczos()                   */
+/************************************************************************/
+
+static bool GWKResampleOptimizedLanczos(const GDALWarpKernel *poWK, int iBand,
+                                        double dfSrcX, double dfSrcY,
+                                        double *pdfDensity, double *pdfReal,
+                                        double *pdfImag,
+                                        GWKResampleWrkStruct *psWrkStruct)
+
+{
+    // Save as local variables to avoid following pointers in loops.
+    const int nSrcXSize = poWK->nSrcXSize;
+
+    double dfAccumulatorReal = 0.0;
+    double dfAccumulatorImag = 0.0;
+    double dfAccumulatorDensity = 0.0;
+    double dfAccumulatorWeight = 0.0;
+    const int iSrcX = static_cast<int>(floor(dfSrcX - 0.5));
+    const int iSrcY = static_cast<int>(floor(dfSrcY - 0.5));
+    const GPtrDiff_t iSrcOffset =
+        iSrcX + static_cast<GPtrDiff_t>(iSrcY) * nSrcXSize;
+    const double dfDeltaX = dfSrcX - 0.5 - iSrcX;
+    const double dfDeltaY = dfSrcY - 0.5 - iSrcY;
+
+    // Space for saved X weights.
+    const double *const padfWeightsXShifted =
+        psWrkStruct->padfWeightsX - poWK->nFiltInitX;
+    const double *const padfWeightsYShifted =
+        psWrkStruct->padfWeightsY - poWK->nFiltInitY;
+
+    // Space for saving a row of pixels.
+    double *const padfRowDensity = psWrkStruct->padfRowDensity;
+    double *const padfRowReal = psWrkStruct->padfRowReal;
+    double *const padfRowImag = psWrkStruct->padfRowImag;
+
+    int iMin = 0;
+    int iMax = 0;
+    int jMin = 0;
+    int jMax = 0;
+    GWKResampleOptimizedLanczosComputeWeights(poWK, psWrkStruct, iSrcX, iSrcY,
+                                              dfDeltaX, dfDeltaY, iMin, iMax,
+                                              jMin, jMax);
 
     // If we have no density information, we can simply compute the
     // accumulated weight.
@@ -4440,16 +4478,14 @@ static bool GWKResampleOptimizedLanczos(const GDALWarpKernel *poWK, int iBand,
 }
 
 /************************************************************************/
-/*                        GWKComputeWeights()                           */
+/*                       GWKComputeWeights1D()                          */
 /************************************************************************/
 
-static void GWKComputeWeights(GDALResampleAlg eResample, int iMin, int iMax,
-                              double dfDeltaX, double dfXScale, int jMin,
-                              int jMax, double dfDeltaY, double dfYScale,
-                              double *padfWeightsHorizontal,
-                              double *padfWeightsVertical, double &dfInvWeights)
+// Returns the sum of the weights
+static double GWKComputeWeights1D(GDALResampleAlg eResample, int iMin,
+                                  int iMax, double dfDelta, double dfScale,
+                                  double *padfWeights)
 {
-
     const FilterFuncType pfnGetWeight = apfGWKFilter[eResample];
     CPLAssert(pfnGetWeight);
     const FilterFunc4ValuesType pfnGetWeight4Values =
@@ -4460,45 +4496,39 @@ static void GWKComputeWeights(GDALResampleAlg eResample, int iMin, int iMax,
     int iC = 0;    // Used after for.
     // Not zero, but as close as possible to it, to avoid potential division by
     // zero at end of function
-    double dfAccumulatorWeightHorizontal = cpl::NumericLimits<double>::min();
+    double dfAccumulatorWeight = cpl::NumericLimits<double>::min();
     for (; i + 2 < iMax; i += 4, iC += 4)
     {
-        padfWeightsHorizontal[iC] = (i - dfDeltaX) * dfXScale;
-        padfWeightsHorizontal[iC + 1] = padfWeightsHorizontal[iC] + dfXScale;
-        padfWeightsHorizontal[iC + 2] =
-            padfWeightsHorizontal[iC + 1] + dfXScale;
-        padfWeightsHorizontal[iC + 3] =
-            padfWeightsHorizontal[iC + 2] + dfXScale;
-        dfAccumulatorWeightHorizontal +=
-            pfnGetWeight4Values(padfWeightsHorizontal + iC);
+        padfWeights[iC] = (i - dfDelta) * dfScale;
+        padfWeights[iC + 1] = padfWeights[iC] + dfScale;
+        padfWeights[iC + 2] = padfWeights[iC + 1] + dfScale;
+        padfWeights[iC + 3] = padfWeights[iC + 2] + dfScale;
+        dfAccumulatorWeight += pfnGetWeight4Values(padfWeights + iC);
     }
     for (; i <= iMax; ++i, ++iC)
     {
-        const double dfWeight = pfnGetWeight((i - dfDeltaX) * dfXScale);
-        padfWeightsHorizontal[iC] = dfWeight;
-        dfAccumulatorWeightHorizontal += dfWeight;
+        const double dfWeight = pfnGetWeight((i - dfDelta) * dfScale);
+        padfWeights[iC] = dfWeight;
+        dfAccumulatorWeight += dfWeight;
     }
 
-    int j = jMin;  // Used after for.
-    int jC = 0;    // Used after for.
-    // Not zero, but as close as possible to it, to avoid potential division by
-    // zero at end of function
-    double dfAccumulatorWeightVertical = cpl::NumericLimits<double>::min();
-    for (; j + 2 < jMax; j += 4, jC += 4)
-    {
-        padfWeightsVertical[jC] = (j - dfDeltaY) * dfYScale;
-        padfWeightsVertical[jC + 1] = padfWeightsVertical[jC] + dfYScale;
-        padfWeightsVertical[jC + 2] = padfWeightsVertical[jC + 1] + dfYScale;
-        padfWeightsVertical[jC + 3] = padfWeightsVertical[jC + 2] + dfYScale;
-        dfAccumulatorWeightVertical +=
-            pfnGetWeight4Values(padfWeightsVertical + jC);
-    }
-    for (; j <= jMax; ++j, ++jC)
-    {
-        const double dfWeight = pfnGetWeight((j - dfDeltaY) * dfYScale);
-        padfWeightsVertical[jC] = dfWeight;
-        dfAccumulatorWeightVertical += dfWeight;
-    }
+    return dfAccumulatorWeight;
+}
+
+/************************************************************************/
+/*                        GWKComputeWeights()                           */
+/************************************************************************/
+
+static void GWKComputeWeights(GDALResampleAlg eResample, int iMin, int iMax,
+                              double dfDeltaX, double dfXScale, int jMin,
+                              int jMax, double dfDeltaY, double dfYScale,
+                              double *padfWeightsHorizontal,
+                              double *padfWeightsVertical, double &dfInvWeights)
+{
+    const double dfAccumulatorWeightHorizontal = GWKComputeWeights1D(
+        eResample, iMin, iMax, dfDeltaX, dfXScale, padfWeightsHorizontal);
+    const double dfAccumulatorWeightVertical = GWKComputeWeights1D(
+        eResample, jMin, jMax, dfDeltaY, dfYScale, padfWeightsVertical);
 
     dfInvWeights =
         1. / (dfAccumulatorWeightHorizontal * dfAccumulatorWeightVertical);
@@ -5499,113 +5529,605 @@ static CPLErr GWKGeneralCase(GDALWarpKernel *poWK)
 }
 
 /************************************************************************/
-/*                            GWKRealCase()                             */
-/*                                                                      */
-/*      General case for non-complex data types.                        */
+/*                         GWKMaskAllSet()                              */
 /************************************************************************/
 
-static void GWKRealCaseThread(void *pData)
+// Returns whether the nCount bits of panMask starting at iOffset are all
+// set, testing up to 32 of them at a time.
+static bool GWKMaskAllSet(const GUInt32 *panMask, GPtrDiff_t iOffset,
+                          int nCount)
+{
+    if (panMask == nullptr)
+        return true;
+    while (nCount > 0)
+    {
+        const int nBit = static_cast<int>(iOffset & 0x1f);
+        const int nBits = std::min(nCount, 32 - nBit);
+        const GUInt32 nWanted = nBits == 32 ? ~0U : ((1U << nBits) - 1) << nBit;
+        if ((panMask[iOffset >> 5] & nWanted) != nWanted)
+            return false;
+        iOffset += nBits;
+        nCount -= nBits;
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                       GWKMaskedSrcIsValid()                          */
+/************************************************************************/
 
+static CPL_INLINE bool GWKMaskedSrcIsValid(GUInt32 *panUnifiedSrcValid,
+                                           GUInt32 *panBandSrcValid,
+                                           GPtrDiff_t iOffset)
 {
-    GWKJobStruct *psJob = static_cast<GWKJobStruct *>(pData);
-    GDALWarpKernel *poWK = psJob->poWK;
-    const int iYMin = psJob->iYMin;
-    const int iYMax = psJob->iYMax;
+    return (panUnifiedSrcValid == nullptr ||
+            CPLMaskGet(panUnifiedSrcValid, iOffset)) &&
+           (panBandSrcValid == nullptr || CPLMaskGet(panBandSrcValid, iOffset));
+}
 
-    const int nDstXSize = poWK->nDstXSize;
+/************************************************************************/
+/*                  GWKBilinearResampleMasked4SampleT()                 */
+/************************************************************************/
+
+// The GWK*MaskedT() functions below are specializations of
+// GWKBilinearResample4Sample(), GWKCubicResample4Sample(), GWKResample() and
+// GWKResampleOptimizedLanczos() for non-complex sources whose validity is
+// only described by bit masks (typically coming from a nodata value), and
+// without source density. They read the source pixels and the masks
+// directly, instead of going through GWKGetPixelRow(), but do the same
+// computations in the same order, so that results are strictly identical.
+
+typedef bool (*GWKMaskedResampleFunc)(const GDALWarpKernel *poWK, int iBand,
+                                      double dfSrcX, double dfSrcY,
+                                      double *pdfDensity, double *pdfReal,
+                                      GWKResampleWrkStruct *psWrkStruct);
+
+template <class T>
+static bool GWKBilinearResampleMasked4SampleT(
+    const GDALWarpKernel *poWK, int iBand, double dfSrcX, double dfSrcY,
+    double *pdfDensity, double *pdfReal,
+    GWKResampleWrkStruct * /* psWrkStruct */)
+
+{
+    // Save as local variables to avoid following pointers.
     const int nSrcXSize = poWK->nSrcXSize;
     const int nSrcYSize = poWK->nSrcYSize;
-    const double dfMultFactorVerticalShiftPipeline =
-        poWK->bApplyVerticalShift
-            ? CPLAtof(CSLFetchNameValueDef(
-                  poWK->papszWarpOptions, "MULT_FACTOR_VERTICAL_SHIFT_PIPELINE",
-                  "1.0"))
-            : 0.0;
+    const T *const pSrc =
+        reinterpret_cast<const T *>(poWK->papabySrcImage[iBand]);
+    GUInt32 *const panUnifiedSrcValid = poWK->panUnifiedSrcValid;
+    GUInt32 *const panBandSrcValid =
+        poWK->papanBandSrcValid ? poWK->papanBandSrcValid[iBand] : nullptr;
 
-    /* -------------------------------------------------------------------- */
-    /*      Allocate x,y,z coordinate arrays for transformation ... one     */
-    /*      scanlines worth of positions.                                   */
-    /* -------------------------------------------------------------------- */
+    int iSrcX = static_cast<int>(floor(dfSrcX - 0.5));
+    int iSrcY = static_cast<int>(floor(dfSrcY - 0.5));
+    double dfRatioX = 1.5 - (dfSrcX - iSrcX);
+    double dfRatioY = 1.5 - (dfSrcY - iSrcY);
 
-    // For x, 2 *, because we cache the precomputed values at the end.
-    double *padfX =
-        static_cast<double *>(CPLMalloc(2 * sizeof(double) * nDstXSize));
-    double *padfY =
-        static_cast<double *>(CPLMalloc(sizeof(double) * nDstXSize));
-    double *padfZ =
-        static_cast<double *>(CPLMalloc(sizeof(double) * nDstXSize));
-    int *pabSuccess = static_cast<int *>(CPLMalloc(sizeof(int) * nDstXSize));
+    if (iSrcX == -1)
+    {
+        iSrcX = 0;
+        dfRatioX = 1;
+    }
+    if (iSrcY == -1)
+    {
+        iSrcY = 0;
+        dfRatioY = 1;
+    }
 
-    const bool bUse4SamplesFormula =
-        poWK->dfXScale >= 0.95 && poWK->dfYScale >= 0.95;
+    double dfAccumulatorReal = 0.0;
+    double dfAccumulatorDivisor = 0.0;
 
-    GWKResampleWrkStruct *psWrkStruct = nullptr;
-    if (poWK->eResample != GRA_NearestNeighbour)
+    const auto Accumulate = [&](int iX, int iY, double dfMult)
     {
-        psWrkStruct = GWKResampleCreateWrkStruct(poWK);
+        if (iX >= 0 && iX < nSrcXSize && iY >= 0 && iY < nSrcYSize)
+        {
+            const GPtrDiff_t iOffset =
+                iX + static_cast<GPtrDiff_t>(iY) * nSrcXSize;
+            if (GWKMaskedSrcIsValid(panUnifiedSrcValid, panBandSrcValid,
+                                    iOffset))
+            {
+                dfAccumulatorDivisor += dfMult;
+                dfAccumulatorReal += pSrc[iOffset] * dfMult;
+            }
+        }
+    };
+
+    Accumulate(iSrcX, iSrcY, dfRatioX * dfRatioY);
+    Accumulate(iSrcX + 1, iSrcY, (1.0 - dfRatioX) * dfRatioY);
+    Accumulate(iSrcX, iSrcY + 1, dfRatioX * (1.0 - dfRatioY));
+    Accumulate(iSrcX + 1, iSrcY + 1, (1.0 - dfRatioX) * (1.0 - dfRatioY));
+
+    if (dfAccumulatorDivisor == 1.0)
+    {
+        *pdfReal = dfAccumulatorReal;
+        *pdfDensity = 1.0;
+        return false;
     }
-    const double dfSrcCoordPrecision = CPLAtof(CSLFetchNameValueDef(
-        poWK->papszWarpOptions, "SRC_COORD_PRECISION", "0"));
-    const double dfErrorThreshold = CPLAtof(
-        CSLFetchNameValueDef(poWK->papszWarpOptions, "ERROR_THRESHOLD", "0"));
+    else if (dfAccumulatorDivisor < 0.00001)
+    {
+        *pdfReal = 0.0;
+        *pdfDensity = 0.0;
+        return false;
+    }
+    else
+    {
+        *pdfReal = dfAccumulatorReal / dfAccumulatorDivisor;
+        *pdfDensity = 1.0;
+        return true;
+    }
+}
 
-    const bool bSrcMaskIsDensity = poWK->panUnifiedSrcValid == nullptr &&
-                                   poWK->papanBandSrcValid == nullptr &&
-                                   poWK->pafUnifiedSrcDensity != nullptr;
+/************************************************************************/
+/*                    GWKCubicResampleMasked4SampleT()                  */
+/************************************************************************/
 
-    const bool bOneSourceCornerFailsToReproject =
-        GWKOneSourceCornerFailsToReproject(psJob);
+template <class T>
+static bool GWKCubicResampleMasked4SampleT(const GDALWarpKernel *poWK,
+                                           int iBand, double dfSrcX,
+                                           double dfSrcY, double *pdfDensity,
+                                           double *pdfReal,
+                                           GWKResampleWrkStruct *psWrkStruct)
 
-    // Precompute values.
-    for (int iDstX = 0; iDstX < nDstXSize; iDstX++)
-        padfX[nDstXSize + iDstX] = iDstX + 0.5 + poWK->nDstXOff;
+{
+    const int nSrcXSize = poWK->nSrcXSize;
+    const int iSrcX = static_cast<int>(dfSrcX - 0.5);
+    const int iSrcY = static_cast<int>(dfSrcY - 0.5);
 
-    /* ==================================================================== */
-    /*      Loop over output lines.                                         */
-    /* ==================================================================== */
-    for (int iDstY = iYMin; iDstY < iYMax; iDstY++)
-    {
-        /* --------------------------------------------------------------------
-         */
-        /*      Setup points to transform to source image space. */
-        /* --------------------------------------------------------------------
-         */
-        memcpy(padfX, padfX + nDstXSize, sizeof(double) * nDstXSize);
-        const double dfY = iDstY + 0.5 + poWK->nDstYOff;
-        for (int iDstX = 0; iDstX < nDstXSize; iDstX++)
-            padfY[iDstX] = dfY;
-        memset(padfZ, 0, sizeof(double) * nDstXSize);
+    // Get the bilinear interpolation at the image borders.
+    if (iSrcX - 1 < 0 || iSrcX + 2 >= nSrcXSize || iSrcY - 1 < 0 ||
+        iSrcY + 2 >= poWK->nSrcYSize)
+        return GWKBilinearResampleMasked4SampleT<T>(
+            poWK, iBand, dfSrcX, dfSrcY, pdfDensity, pdfReal, psWrkStruct);
 
-        /* --------------------------------------------------------------------
-         */
-        /*      Transform the points from destination pixel/line coordinates */
-        /*      to source pixel/line coordinates. */
-        /* --------------------------------------------------------------------
-         */
-        poWK->pfnTransformer(psJob->pTransformerArg, TRUE, nDstXSize, padfX,
-                             padfY, padfZ, pabSuccess);
-        if (dfSrcCoordPrecision > 0.0)
+    const GPtrDiff_t iSrcOffset =
+        iSrcX + static_cast<GPtrDiff_t>(iSrcY) * nSrcXSize;
+
+    // As in GWKCubicResample4Sample(), fallback on bilinear interpolation
+    // if any pixel of the kernel area is missing.
+    GUInt32 *const panBandSrcValid =
+        poWK->papanBandSrcValid ? poWK->papanBandSrcValid[iBand] : nullptr;
+    for (GPtrDiff_t i = -1; i < 3; i++)
+    {
+        const GPtrDiff_t iRowOffset = iSrcOffset + i * nSrcXSize - 1;
+        if (!GWKMaskAllSet(poWK->panUnifiedSrcValid, iRowOffset, 4) ||
+            !GWKMaskAllSet(panBandSrcValid, iRowOffset, 4))
         {
-            GWKRoundSourceCoordinates(
-                nDstXSize, padfX, padfY, padfZ, pabSuccess, dfSrcCoordPrecision,
-                dfErrorThreshold, poWK->pfnTransformer, psJob->pTransformerArg,
-                0.5 + poWK->nDstXOff, iDstY + 0.5 + poWK->nDstYOff);
+            return GWKBilinearResampleMasked4SampleT<T>(
+                poWK, iBand, dfSrcX, dfSrcY, pdfDensity, pdfReal, psWrkStruct);
         }
+    }
 
-        /* ====================================================================
-         */
-        /*      Loop over pixels in output scanline. */
-        /* ====================================================================
-         */
-        for (int iDstX = 0; iDstX < nDstXSize; iDstX++)
-        {
-            GPtrDiff_t iSrcOffset = 0;
-            if (!GWKCheckAndComputeSrcOffsets(psJob, pabSuccess, iDstX, iDstY,
-                                              padfX, padfY, nSrcXSize,
-                                              nSrcYSize, iSrcOffset))
-                continue;
+    const T *pSrc =
+        reinterpret_cast<const T *>(poWK->papabySrcImage[iBand]) +
+        iSrcOffset - nSrcXSize - 1;
+    const double dfDeltaX = dfSrcX - 0.5 - iSrcX;
+    const double dfDeltaY = dfSrcY - 0.5 - iSrcY;
 
-            /* --------------------------------------------------------------------
+    double adfCoeffsX[4] = {};
+    GWKCubicComputeWeights(dfDeltaX, adfCoeffsX);
+    double adfCoeffsY[4] = {};
+    GWKCubicComputeWeights(dfDeltaY, adfCoeffsY);
+
+    // Density of each row, and of the whole kernel, computed as
+    // GWKCubicResample4Sample() does with source densities equal to 1.
+    const double adfOnes[4] = {1.0, 1.0, 1.0, 1.0};
+    const double dfRowDensity = CONVOL4(adfCoeffsX, adfOnes);
+    const double adfValueDens[4] = {dfRowDensity, dfRowDensity, dfRowDensity,
+                                    dfRowDensity};
+
+    double adfValueReal[4] = {};
+    for (int i = 0; i < 4; i++)
+    {
+        const double adfReal[4] = {static_cast<double>(pSrc[0]),
+                                   static_cast<double>(pSrc[1]),
+                                   static_cast<double>(pSrc[2]),
+                                   static_cast<double>(pSrc[3])};
+        adfValueReal[i] = CONVOL4(adfCoeffsX, adfReal);
+        pSrc += nSrcXSize;
+    }
+
+    *pdfDensity = CONVOL4(adfCoeffsY, adfValueDens);
+    *pdfReal = CONVOL4(adfCoeffsY, adfValueReal);
+
+    return true;
+}
+
+/************************************************************************/
+/*                          GWKResampleMaskedT()                        */
+/************************************************************************/
+
+template <class T>
+static bool GWKResampleMaskedT(const GDALWarpKernel *poWK, int iBand,
+                               double dfSrcX, double dfSrcY,
+                               double *pdfDensity, double *pdfReal,
+                               GWKResampleWrkStruct *psWrkStruct)
+
+{
+    // Save as local variables to avoid following pointers in loops.
+    const int nSrcXSize = poWK->nSrcXSize;
+    const int nSrcYSize = poWK->nSrcYSize;
+    const T *const pSrc =
+        reinterpret_cast<const T *>(poWK->papabySrcImage[iBand]);
+    GUInt32 *const panUnifiedSrcValid = poWK->panUnifiedSrcValid;
+    GUInt32 *const panBandSrcValid =
+        poWK->papanBandSrcValid ? poWK->papanBandSrcValid[iBand] : nullptr;
+
+    const int iSrcX = static_cast<int>(floor(dfSrcX - 0.5));
+    const int iSrcY = static_cast<int>(floor(dfSrcY - 0.5));
+    const GPtrDiff_t iSrcOffset =
+        iSrcX + static_cast<GPtrDiff_t>(iSrcY) * nSrcXSize;
+    const double dfDeltaX = dfSrcX - 0.5 - iSrcX;
+    const double dfDeltaY = dfSrcY - 0.5 - iSrcY;
+
+    const double dfXScale = poWK->dfXScale;
+    const double dfYScale = poWK->dfYScale;
+
+    const FilterFuncType pfnGetWeight = apfGWKFilter[poWK->eResample];
+    CPLAssert(pfnGetWeight);
+
+    // Skip sampling over edge of image.
+    int j = poWK->nFiltInitY;
+    int jMax = poWK->nYRadius;
+    if (iSrcY + j < 0)
+        j = -iSrcY;
+    if (iSrcY + jMax >= nSrcYSize)
+        jMax = nSrcYSize - iSrcY - 1;
+
+    int iMin = poWK->nFiltInitX;
+    int iMax = poWK->nXRadius;
+    if (iSrcX + iMin < 0)
+        iMin = -iSrcX;
+    if (iSrcX + iMax >= nSrcXSize)
+        iMax = nSrcXSize - iSrcX - 1;
+
+    // Compute the X weights once for all rows.
+    double *const padfWeightsX = psWrkStruct->padfWeightsX;
+    for (int i = iMin; i <= iMax; ++i)
+    {
+        padfWeightsX[i - iMin] = (dfXScale < 1.0)
+                                     ? pfnGetWeight((i - dfDeltaX) * dfXScale)
+                                     : pfnGetWeight(i - dfDeltaX);
+    }
+    const int nRowLen = iMax - iMin + 1;
+
+    // As all valid pixels have a density of 1, the accumulated density of
+    // GWKResample() is equal to the accumulated weight.
+    double dfAccumulatorReal = 0.0;
+    double dfAccumulatorWeight = 0.0;
+
+    // Loop over pixel rows in the kernel.
+    for (; j <= jMax; ++j)
+    {
+        const GPtrDiff_t iRowOffset =
+            iSrcOffset + static_cast<GPtrDiff_t>(j) * nSrcXSize + iMin;
+        const T *const pSrcRow = pSrc + iRowOffset;
+
+        // Calculate the Y weight.
+        const double dfWeight1 = (dfYScale < 1.0)
+                                     ? pfnGetWeight((j - dfDeltaY) * dfYScale)
+                                     : pfnGetWeight(j - dfDeltaY);
+
+        // Iterate over pixels in row.
+        double dfAccumulatorRealLocal = 0.0;
+        double dfAccumulatorWeightLocal = 0.0;
+
+        if (GWKMaskAllSet(panUnifiedSrcValid, iRowOffset, nRowLen) &&
+            GWKMaskAllSet(panBandSrcValid, iRowOffset, nRowLen))
+        {
+            for (int i = 0; i < nRowLen; ++i)
+            {
+                const double dfWeight2 = padfWeightsX[i];
+                dfAccumulatorRealLocal += pSrcRow[i] * dfWeight2;
+                dfAccumulatorWeightLocal += dfWeight2;
+            }
+        }
+        else
+        {
+            for (int i = 0; i < nRowLen; ++i)
+            {
+                // Skip sampling if pixel is invalid.
+                if (!GWKMaskedSrcIsValid(panUnifiedSrcValid, panBandSrcValid,
+                                         iRowOffset + i))
+                    continue;
+
+                const double dfWeight2 = padfWeightsX[i];
+                dfAccumulatorRealLocal += pSrcRow[i] * dfWeight2;
+                dfAccumulatorWeightLocal += dfWeight2;
+            }
+        }
+
+        dfAccumulatorReal += dfAccumulatorRealLocal * dfWeight1;
+        dfAccumulatorWeight += dfAccumulatorWeightLocal * dfWeight1;
+    }
+
+    if (dfAccumulatorWeight < 0.000001)
+    {
+        *pdfDensity = 0.0;
+        return false;
+    }
+
+    // Calculate the output taking into account weighting.
+    if (dfAccumulatorWeight < 0.99999 || dfAccumulatorWeight > 1.00001)
+    {
+        *pdfReal = dfAccumulatorReal / dfAccumulatorWeight;
+        *pdfDensity = dfAccumulatorWeight / dfAccumulatorWeight;
+    }
+    else
+    {
+        *pdfReal = dfAccumulatorReal;
+        *pdfDensity = dfAccumulatorWeight;
+    }
+
+    return true;
+}
+
+/************************************************************************/
+/*                  GWKResampleOptimizedLanczosMaskedT()                */
+/************************************************************************/
+
+template <class T>
+static bool GWKResampleOptimizedLanczosMaskedT(
+    const GDALWarpKernel *poWK, int iBand, double dfSrcX, double dfSrcY,
+    double *pdfDensity, double *pdfReal, GWKResampleWrkStruct *psWrkStruct)
+
+{
+    // Save as local variables to avoid following pointers in loops.
+    const int nSrcXSize = poWK->nSrcXSize;
+    const T *const pSrc =
+        reinterpret_cast<const T *>(poWK->papabySrcImage[iBand]);
+    GUInt32 *const panUnifiedSrcValid = poWK->panUnifiedSrcValid;
+    GUInt32 *const panBandSrcValid =
+        poWK->papanBandSrcValid ? poWK->papanBandSrcValid[iBand] : nullptr;
+
+    const int iSrcX = static_cast<int>(floor(dfSrcX - 0.5));
+    const int iSrcY = static_cast<int>(floor(dfSrcY - 0.5));
+    const GPtrDiff_t iSrcOffset =
+        iSrcX + static_cast<GPtrDiff_t>(iSrcY) * nSrcXSize;
+    const double dfDeltaX = dfSrcX - 0.5 - iSrcX;
+    const double dfDeltaY = dfSrcY - 0.5 - iSrcY;
+
+    int iMin = 0;
+    int iMax = 0;
+    int jMin = 0;
+    int jMax = 0;
+    GWKResampleOptimizedLanczosComputeWeights(poWK, psWrkStruct, iSrcX, iSrcY,
+                                              dfDeltaX, dfDeltaY, iMin, iMax,
+                                              jMin, jMax);
+    const double *const padfWeightsXShifted =
+        psWrkStruct->padfWeightsX - poWK->nFiltInitX;
+    const double *const padfWeightsYShifted =
+        psWrkStruct->padfWeightsY - poWK->nFiltInitY;
+    const int nRowLen = iMax - iMin + 1;
+
+    // As all valid pixels have a density of 1, the accumulated density of
+    // GWKResampleOptimizedLanczos() is equal to the accumulated weight.
+    double dfAccumulatorReal = 0.0;
+    double dfAccumulatorWeight = 0.0;
+    int nCountValid = 0;
+
+    for (int j = jMin; j <= jMax; ++j)
+    {
+        const GPtrDiff_t iRowOffset =
+            iSrcOffset + static_cast<GPtrDiff_t>(j) * nSrcXSize + iMin;
+        const T *const pSrcRow = pSrc + iRowOffset - iMin;
+        const double dfWeight1 = padfWeightsYShifted[j];
+
+        if (GWKMaskAllSet(panUnifiedSrcValid, iRowOffset, nRowLen) &&
+            GWKMaskAllSet(panBandSrcValid, iRowOffset, nRowLen))
+        {
+            nCountValid += nRowLen;
+            for (int i = iMin; i <= iMax; ++i)
+            {
+                const double dfWeight2 = dfWeight1 * padfWeightsXShifted[i];
+                dfAccumulatorReal += pSrcRow[i] * dfWeight2;
+                dfAccumulatorWeight += dfWeight2;
+            }
+        }
+        else
+        {
+            for (int i = iMin; i <= iMax; ++i)
+            {
+                // Skip sampling if pixel is invalid.
+                if (!GWKMaskedSrcIsValid(panUnifiedSrcValid, panBandSrcValid,
+                                         iRowOffset + i - iMin))
+                    continue;
+
+                nCountValid++;
+
+                const double dfWeight2 = dfWeight1 * padfWeightsXShifted[i];
+                dfAccumulatorReal += pSrcRow[i] * dfWeight2;
+                dfAccumulatorWeight += dfWeight2;
+            }
+        }
+    }
+
+    if (dfAccumulatorWeight < 0.000001 ||
+        nCountValid < (jMax - jMin + 1) * (iMax - iMin + 1) / 2)
+    {
+        *pdfDensity = 0.0;
+        return false;
+    }
+
+    // Calculate the output taking into account weighting.
+    if (dfAccumulatorWeight < 0.99999 || dfAccumulatorWeight > 1.00001)
+    {
+        const double dfInvAcc = 1.0 / dfAccumulatorWeight;
+        *pdfReal = dfAccumulatorReal * dfInvAcc;
+        *pdfDensity = dfAccumulatorWeight * dfInvAcc;
+    }
+    else
+    {
+        *pdfReal = dfAccumulatorReal;
+        *pdfDensity = dfAccumulatorWeight;
+    }
+
+    return true;
+}
+
+/************************************************************************/
+/*                      GWKGetMaskedResampleFunc()                      */
+/************************************************************************/
+
+template <class T>
+static GWKMaskedResampleFunc
+GWKGetMaskedResampleFuncT(const GDALWarpKernel *poWK, bool bUse4SamplesFormula)
+{
+    if (poWK->eResample == GRA_Bilinear && bUse4SamplesFormula)
+        return GWKBilinearResampleMasked4SampleT<T>;
+    if (poWK->eResample == GRA_Cubic && bUse4SamplesFormula)
+        return GWKCubicResampleMasked4SampleT<T>;
+    if (poWK->eResample == GRA_Lanczos)
+        return GWKResampleOptimizedLanczosMaskedT<T>;
+    return GWKResampleMaskedT<T>;
+}
+
+// Returns the specialized resampling function to use in GWKRealCaseThread()
+// for sources with validity masks but no density, or nullptr.
+static GWKMaskedResampleFunc
+GWKGetMaskedResampleFunc(const GDALWarpKernel *poWK, bool bUse4SamplesFormula)
+{
+    if (poWK->pafUnifiedSrcDensity != nullptr ||
+        (poWK->panUnifiedSrcValid == nullptr &&
+         poWK->papanBandSrcValid == nullptr))
+        return nullptr;
+
+    if (poWK->eResample != GRA_Bilinear && poWK->eResample != GRA_Cubic &&
+        poWK->eResample != GRA_CubicSpline && poWK->eResample != GRA_Lanczos)
+        return nullptr;
+
+    if (!CPLFetchBool(poWK->papszWarpOptions, "SPECIALIZED_MASKED_RESAMPLING",
+                      true))
+        return nullptr;
+
+    switch (poWK->eWorkingDataType)
+    {
+        case GDT_Byte:
+            return GWKGetMaskedResampleFuncT<GByte>(poWK, bUse4SamplesFormula);
+        case GDT_Int16:
+            return GWKGetMaskedResampleFuncT<GInt16>(poWK,
+                                                     bUse4SamplesFormula);
+        case GDT_UInt16:
+            return GWKGetMaskedResampleFuncT<GUInt16>(poWK,
+                                                      bUse4SamplesFormula);
+        case GDT_Float32:
+            return GWKGetMaskedResampleFuncT<float>(poWK, bUse4SamplesFormula);
+        default:
+            break;
+    }
+    return nullptr;
+}
+
+/************************************************************************/
+/*                            GWKRealCase()                             */
+/*                                                                      */
+/*      General case for non-complex data types.                        */
+/************************************************************************/
+
+static void GWKRealCaseThread(void *pData)
+
+{
+    GWKJobStruct *psJob = static_cast<GWKJobStruct *>(pData);
+    GDALWarpKernel *poWK = psJob->poWK;
+    const int iYMin = psJob->iYMin;
+    const int iYMax = psJob->iYMax;
+
+    const int nDstXSize = poWK->nDstXSize;
+    const int nSrcXSize = poWK->nSrcXSize;
+    const int nSrcYSize = poWK->nSrcYSize;
+    const double dfMultFactorVerticalShiftPipeline =
+        poWK->bApplyVerticalShift
+            ? CPLAtof(CSLFetchNameValueDef(
+                  poWK->papszWarpOptions, "MULT_FACTOR_VERTICAL_SHIFT_PIPELINE",
+                  "1.0"))
+            : 0.0;
+
+    /* -------------------------------------------------------------------- */
+    /*      Allocate x,y,z coordinate arrays for transformation ... one     */
+    /*      scanlines worth of positions.                                   */
+    /* -------------------------------------------------------------------- */
+
+    // For x, 2 *, because we cache the precomputed values at the end.
+    double *padfX =
+        static_cast<double *>(CPLMalloc(2 * sizeof(double) * nDstXSize));
+    double *padfY =
+        static_cast<double *>(CPLMalloc(sizeof(double) * nDstXSize));
+    double *padfZ =
+        static_cast<double *>(CPLMalloc(sizeof(double) * nDstXSize));
+    int *pabSuccess = static_cast<int *>(CPLMalloc(sizeof(int) * nDstXSize));
+
+    const bool bUse4SamplesFormula =
+        poWK->dfXScale >= 0.95 && poWK->dfYScale >= 0.95;
+
+    GWKResampleWrkStruct *psWrkStruct = nullptr;
+    if (poWK->eResample != GRA_NearestNeighbour)
+    {
+        psWrkStruct = GWKResampleCreateWrkStruct(poWK);
+    }
+    const double dfSrcCoordPrecision = CPLAtof(CSLFetchNameValueDef(
+        poWK->papszWarpOptions, "SRC_COORD_PRECISION", "0"));
+    const double dfErrorThreshold = CPLAtof(
+        CSLFetchNameValueDef(poWK->papszWarpOptions, "ERROR_THRESHOLD", "0"));
+
+    const bool bSrcMaskIsDensity = poWK->panUnifiedSrcValid == nullptr &&
+                                   poWK->papanBandSrcValid == nullptr &&
+                                   poWK->pafUnifiedSrcDensity != nullptr;
+
+    const bool bOneSourceCornerFailsToReproject =
+        GWKOneSourceCornerFailsToReproject(psJob);
+
+    const GWKMaskedResampleFunc pfnMaskedResample =
+        GWKGetMaskedResampleFunc(poWK, bUse4SamplesFormula);
+
+    // Precompute values.
+    for (int iDstX = 0; iDstX < nDstXSize; iDstX++)
+        padfX[nDstXSize + iDstX] = iDstX + 0.5 + poWK->nDstXOff;
+
+    /* ==================================================================== */
+    /*      Loop over output lines.                                         */
+    /* ==================================================================== */
+    for (int iDstY = iYMin; iDstY < iYMax; iDstY++)
+    {
+        /* --------------------------------------------------------------------
+         */
+        /*      Setup points to transform to source image space. */
+        /* --------------------------------------------------------------------
+         */
+        memcpy(padfX, padfX + nDstXSize, sizeof(double) * nDstXSize);
+        const double dfY = iDstY + 0.5 + poWK->nDstYOff;
+        for (int iDstX = 0; iDstX < nDstXSize; iDstX++)
+            padfY[iDstX] = dfY;
+        memset(padfZ, 0, sizeof(double) * nDstXSize);
+
+        /* --------------------------------------------------------------------
+         */
+        /*      Transform the points from destination pixel/line coordinates */
+        /*      to source pixel/line coordinates. */
+        /* --------------------------------------------------------------------
+         */
+        poWK->pfnTransformer(psJob->pTransformerArg, TRUE, nDstXSize, padfX,
+                             padfY, padfZ, pabSuccess);
+        if (dfSrcCoordPrecision > 0.0)
+        {
+            GWKRoundSourceCoordinates(
+                nDstXSize, padfX, padfY, padfZ, pabSuccess, dfSrcCoordPrecision,
+                dfErrorThreshold, poWK->pfnTransformer, psJob->pTransformerArg,
+                0.5 + poWK->nDstXOff, iDstY + 0.5 + poWK->nDstYOff);
+        }
+
+        /* ====================================================================
+         */
+        /*      Loop over pixels in output scanline. */
+        /* ====================================================================
+         */
+        for (int iDstX = 0; iDstX < nDstXSize; iDstX++)
+        {
+            GPtrDiff_t iSrcOffset = 0;
+            if (!GWKCheckAndComputeSrcOffsets(psJob, pabSuccess, iDstX, iDstY,
+                                              padfX, padfY, nSrcXSize,
+                                              nSrcYSize, iSrcOffset))
+                continue;
+
+            /* --------------------------------------------------------------------
              */
             /*      Do not try to apply transparent/invalid source pixels to the
              */
@@ -5616,191 +6138,1224 @@ static void GWKRealCaseThread(void *pData)
              */
             double dfDensity = 1.0;
 
-            if (poWK->pafUnifiedSrcDensity != nullptr)
+            if (poWK->pafUnifiedSrcDensity != nullptr)
+            {
+                dfDensity = poWK->pafUnifiedSrcDensity[iSrcOffset];
+                if (dfDensity < SRC_DENSITY_THRESHOLD)
+                {
+                    if (!bOneSourceCornerFailsToReproject)
+                    {
+                        continue;
+                    }
+                    else if (GWKAdjustSrcOffsetOnEdgeUnifiedSrcDensity(
+                                 psJob, iSrcOffset))
+                    {
+                        dfDensity = poWK->pafUnifiedSrcDensity[iSrcOffset];
+                    }
+                    else
+                    {
+                        continue;
+                    }
+                }
+            }
+
+            if (poWK->panUnifiedSrcValid != nullptr &&
+                !CPLMaskGet(poWK->panUnifiedSrcValid, iSrcOffset))
+            {
+                if (!bOneSourceCornerFailsToReproject)
+                {
+                    continue;
+                }
+                else if (!GWKAdjustSrcOffsetOnEdge(psJob, iSrcOffset))
+                {
+                    continue;
+                }
+            }
+
+            /* ====================================================================
+             */
+            /*      Loop processing each band. */
+            /* ====================================================================
+             */
+            bool bHasFoundDensity = false;
+
+            const GPtrDiff_t iDstOffset =
+                iDstX + static_cast<GPtrDiff_t>(iDstY) * nDstXSize;
+            for (int iBand = 0; iBand < poWK->nBands; iBand++)
+            {
+                double dfBandDensity = 0.0;
+                double dfValueReal = 0.0;
+
+                /* --------------------------------------------------------------------
+                 */
+                /*      Collect the source value. */
+                /* --------------------------------------------------------------------
+                 */
+                if (poWK->eResample == GRA_NearestNeighbour || nSrcXSize == 1 ||
+                    nSrcYSize == 1)
+                {
+                    // FALSE is returned if dfBandDensity == 0, which is
+                    // checked below.
+                    CPL_IGNORE_RET_VAL(GWKGetPixelValueReal(
+                        poWK, iBand, iSrcOffset, &dfBandDensity, &dfValueReal));
+                }
+                else if (pfnMaskedResample)
+                {
+                    pfnMaskedResample(
+                        poWK, iBand, padfX[iDstX] - poWK->nSrcXOff,
+                        padfY[iDstX] - poWK->nSrcYOff, &dfBandDensity,
+                        &dfValueReal, psWrkStruct);
+                }
+                else if (poWK->eResample == GRA_Bilinear && bUse4SamplesFormula)
+                {
+                    double dfValueImagIgnored = 0.0;
+                    GWKBilinearResample4Sample(
+                        poWK, iBand, padfX[iDstX] - poWK->nSrcXOff,
+                        padfY[iDstX] - poWK->nSrcYOff, &dfBandDensity,
+                        &dfValueReal, &dfValueImagIgnored);
+                }
+                else if (poWK->eResample == GRA_Cubic && bUse4SamplesFormula)
+                {
+                    if (bSrcMaskIsDensity)
+                    {
+                        if (poWK->eWorkingDataType == GDT_Byte)
+                        {
+                            GWKCubicResampleSrcMaskIsDensity4SampleRealT<GByte>(
+                                poWK, iBand, padfX[iDstX] - poWK->nSrcXOff,
+                                padfY[iDstX] - poWK->nSrcYOff, &dfBandDensity,
+                                &dfValueReal);
+                        }
+                        else if (poWK->eWorkingDataType == GDT_UInt16)
+                        {
+                            GWKCubicResampleSrcMaskIsDensity4SampleRealT<
+                                GUInt16>(poWK, iBand,
+                                         padfX[iDstX] - poWK->nSrcXOff,
+                                         padfY[iDstX] - poWK->nSrcYOff,
+                                         &dfBandDensity, &dfValueReal);
+                        }
+                        else
+                        {
+                            GWKCubicResampleSrcMaskIsDensity4SampleReal(
+                                poWK, iBand, padfX[iDstX] - poWK->nSrcXOff,
+                                padfY[iDstX] - poWK->nSrcYOff, &dfBandDensity,
+                                &dfValueReal);
+                        }
+                    }
+                    else
+                    {
+                        double dfValueImagIgnored = 0.0;
+                        GWKCubicResample4Sample(
+                            poWK, iBand, padfX[iDstX] - poWK->nSrcXOff,
+                            padfY[iDstX] - poWK->nSrcYOff, &dfBandDensity,
+                            &dfValueReal, &dfValueImagIgnored);
+                    }
+                }
+                else
+#ifdef DEBUG
+                    // Only useful for clang static analyzer.
+                    if (psWrkStruct != nullptr)
+#endif
+                    {
+                        double dfValueImagIgnored = 0.0;
+                        psWrkStruct->pfnGWKResample(
+                            poWK, iBand, padfX[iDstX] - poWK->nSrcXOff,
+                            padfY[iDstX] - poWK->nSrcYOff, &dfBandDensity,
+                            &dfValueReal, &dfValueImagIgnored, psWrkStruct);
+                    }
+
+                // If we didn't find any valid inputs skip to next band.
+                if (dfBandDensity < BAND_DENSITY_THRESHOLD)
+                    continue;
+
+                if (poWK->bApplyVerticalShift)
+                {
+                    if (!std::isfinite(padfZ[iDstX]))
+                        continue;
+                    // Subtract padfZ[] since the coordinate transformation is
+                    // from target to source
+                    dfValueReal =
+                        dfValueReal * poWK->dfMultFactorVerticalShift -
+                        padfZ[iDstX] * dfMultFactorVerticalShiftPipeline;
+                }
+
+                bHasFoundDensity = true;
+
+                /* --------------------------------------------------------------------
+                 */
+                /*      We have a computed value from the source.  Now apply it
+                 * to      */
+                /*      the destination pixel. */
+                /* --------------------------------------------------------------------
+                 */
+                GWKSetPixelValueReal(poWK, iBand, iDstOffset, dfBandDensity,
+                                     dfValueReal);
+            }
+
+            if (!bHasFoundDensity)
+                continue;
+
+            /* --------------------------------------------------------------------
+             */
+            /*      Update destination density/validity masks. */
+            /* --------------------------------------------------------------------
+             */
+            GWKOverlayDensity(poWK, iDstOffset, dfDensity);
+
+            if (poWK->panDstValid != nullptr)
+            {
+                CPLMaskSet(poWK->panDstValid, iDstOffset);
+            }
+        }  // Next iDstX.
+
+        /* --------------------------------------------------------------------
+         */
+        /*      Report progress to the user, and optionally cancel out. */
+        /* --------------------------------------------------------------------
+         */
+        if (psJob->pfnProgress && psJob->pfnProgress(psJob))
+            break;
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Cleanup and return.                                             */
+    /* -------------------------------------------------------------------- */
+    CPLFree(padfX);
+    CPLFree(padfY);
+    CPLFree(padfZ);
+    CPLFree(pabSuccess);
+    if (psWrkStruct)
+        GWKResampleDeleteWrkStruct(psWrkStruct);
+}
+
+static CPLErr GWKRealCase(GDALWarpKernel *poWK)
+{
+    return GWKRun(poWK, "GWKRealCase", GWKRealCaseThread);
+}
+
+/************************************************************************/
+/*                     GWKSeparableCanBeUsed()                          */
+/************************************************************************/
+
+// Whether the warp can be done with GWKSeparableResample(): the destination
+// to source transformation must be a pure scaling and translation, so that
+// the source column (resp. line) of a destination pixel only depends on its
+// destination column (resp. line), and the filter can be applied as a
+// horizontal pass followed by a vertical pass.
+static bool GWKSeparableCanBeUsed(const GDALWarpKernel *poWK)
+{
+    if (!CPLFetchBool(poWK->papszWarpOptions, "SEPARABLE_RESAMPLING", false))
+        return false;
+
+    if (poWK->papanBandSrcValid != nullptr ||
+        poWK->panUnifiedSrcValid != nullptr ||
+        poWK->pafUnifiedSrcDensity != nullptr || poWK->bApplyVerticalShift)
+        return false;
+
+    if (poWK->eWorkingDataType != GDT_Byte &&
+        poWK->eWorkingDataType != GDT_Int16 &&
+        poWK->eWorkingDataType != GDT_UInt16 &&
+        poWK->eWorkingDataType != GDT_Float32 &&
+        poWK->eWorkingDataType != GDT_Float64)
+        return false;
+
+    // Bilinear and cubic use a dedicated 4-sample formula when there is no
+    // (or little) downsampling, which is already fast.
+    const bool bUse4SamplesFormula =
+        poWK->dfXScale >= 0.95 && poWK->dfYScale >= 0.95;
+    if (!(poWK->eResample == GRA_Lanczos ||
+          poWK->eResample == GRA_CubicSpline ||
+          ((poWK->eResample == GRA_Bilinear || poWK->eResample == GRA_Cubic) &&
+           !bUse4SamplesFormula)))
+        return false;
+
+    // Cases where the per-pixel code paths fallback to other methods.
+    if (poWK->nSrcXSize <= 1 || poWK->nSrcYSize <= 1 ||
+        poWK->nXRadius > poWK->nSrcXSize || poWK->nYRadius > poWK->nSrcYSize)
+        return false;
+
+    if (CPLAtof(CSLFetchNameValueDef(poWK->papszWarpOptions,
+                                     "SRC_COORD_PRECISION", "0")) > 0)
+        return false;
+
+    return GDALTransformIsAffineNoRotation(poWK->pfnTransformer,
+                                           poWK->pTransformerArg);
+}
+
+/************************************************************************/
+/*                   GWKSeparableComputeWindow()                        */
+/************************************************************************/
+
+// Same source window as in GWKResampleNoMasksT()
+static void GWKSeparableComputeWindow(double dfSrc, int nRadius, int nSrcSize,
+                                      int &iSrc, int &iMin, int &iMax,
+                                      double &dfDelta)
+{
+    iSrc = static_cast<int>(floor(dfSrc - 0.5));
+    dfDelta = dfSrc - 0.5 - iSrc;
+
+    iMin = 1 - nRadius;
+    if (iSrc + iMin < 0)
+        iMin = -iSrc;
+    iMax = nRadius;
+    if (iSrc + iMax >= nSrcSize - 1)
+        iMax = nSrcSize - 1 - iSrc;
+}
+
+/************************************************************************/
+/*                     GWKSeparableHorizontalT()                        */
+/************************************************************************/
+
+// Same summation order as the accumulation on a single row of
+// GWKResampleNoMasksT().
+template <class T>
+static CPL_INLINE double GWKSeparableHorizontalT(const T *pSrc,
+                                                 const double *padfWeights,
+                                                 int nCount)
+{
+    int i = 0;
+#if defined(USE_SSE2)
+    XMMReg4Double v_acc = XMMReg4Double::Zero();
+    for (; i + 3 < nCount; i += 4)
+    {
+        v_acc += XMMReg4Double::Load4Val(pSrc + i) *
+                 XMMReg4Double::Load4Val(padfWeights + i);
+    }
+    double dfAccumulator = v_acc.GetHorizSum();
+#else
+    double dfAccumulator = 0.0;
+    double dfAccumulator2 = 0.0;
+    for (; i + 3 < nCount; i += 4)
+    {
+        dfAccumulator += pSrc[i] * padfWeights[i];
+        dfAccumulator += pSrc[i + 1] * padfWeights[i + 1];
+        dfAccumulator2 += pSrc[i + 2] * padfWeights[i + 2];
+        dfAccumulator2 += pSrc[i + 3] * padfWeights[i + 3];
+    }
+    dfAccumulator += dfAccumulator2;
+#endif
+    if (i + 1 < nCount)
+    {
+        dfAccumulator += pSrc[i] * padfWeights[i];
+        dfAccumulator += pSrc[i + 1] * padfWeights[i + 1];
+        i += 2;
+    }
+    if (i < nCount)
+        dfAccumulator += static_cast<double>(pSrc[i]) * padfWeights[i];
+    return dfAccumulator;
+}
+
+/************************************************************************/
+/*                   GWKSeparableResampleThread()                       */
+/************************************************************************/
+
+template <class T> static void GWKSeparableResampleThread(void *pData)
+{
+    GWKJobStruct *psJob = static_cast<GWKJobStruct *>(pData);
+    GDALWarpKernel *poWK = psJob->poWK;
+    const int iYMin = psJob->iYMin;
+    const int iYMax = psJob->iYMax;
+    if (iYMin >= iYMax)
+        return;
+
+    const int nDstXSize = poWK->nDstXSize;
+    const int nSrcXSize = poWK->nSrcXSize;
+    const int nSrcYSize = poWK->nSrcYSize;
+    const int nBands = poWK->nBands;
+    const double dfXScale = std::min(poWK->dfXScale, 1.0);
+    const double dfYScale = std::min(poWK->dfYScale, 1.0);
+
+    /* -------------------------------------------------------------------- */
+    /*      Compute the source column of each destination column, from      */
+    /*      the first line, and the source line of each destination line,   */
+    /*      from the first column.                                          */
+    /* -------------------------------------------------------------------- */
+    const int nDstYCount = iYMax - iYMin;
+    const int nPoints = std::max(nDstXSize, nDstYCount);
+    std::vector<double> adfX(nPoints);
+    std::vector<double> adfY(nPoints);
+    std::vector<double> adfZ(nPoints);
+    std::vector<int> abSuccess(nPoints);
+
+    for (int iDstX = 0; iDstX < nDstXSize; iDstX++)
+    {
+        adfX[iDstX] = iDstX + 0.5 + poWK->nDstXOff;
+        adfY[iDstX] = iYMin + 0.5 + poWK->nDstYOff;
+    }
+    poWK->pfnTransformer(psJob->pTransformerArg, TRUE, nDstXSize, adfX.data(),
+                         adfY.data(), adfZ.data(), abSuccess.data());
+
+    // Horizontal weights of each destination column. A zero count means
+    // that the column is outside of the source window.
+    const int nXDist = 2 * poWK->nXRadius + 1;
+    std::vector<int> anColSrcStart(nDstXSize);
+    std::vector<int> anColCount(nDstXSize);
+    std::vector<double> adfColWeights(static_cast<size_t>(nDstXSize) * nXDist);
+    std::vector<double> adfColWeightSum(nDstXSize);
+    for (int iDstX = 0; iDstX < nDstXSize; iDstX++)
+    {
+        const double dfSrcX = adfX[iDstX];
+        // Same tests as in GWKCheckAndComputeSrcOffsets(). Written so that
+        // NaN is rejected.
+        if (!abSuccess[iDstX] || !(dfSrcX >= poWK->nSrcXOff) ||
+            !(dfSrcX + 1e-10 <= nSrcXSize + poWK->nSrcXOff))
+            continue;
+
+        int iSrcX = 0;
+        int iMin = 0;
+        int iMax = 0;
+        double dfDeltaX = 0;
+        GWKSeparableComputeWindow(dfSrcX - poWK->nSrcXOff, poWK->nXRadius,
+                                  nSrcXSize, iSrcX, iMin, iMax, dfDeltaX);
+        anColSrcStart[iDstX] = iSrcX + iMin;
+        anColCount[iDstX] = iMax - iMin + 1;
+        adfColWeightSum[iDstX] = GWKComputeWeights1D(
+            poWK->eResample, iMin, iMax, dfDeltaX, dfXScale,
+            adfColWeights.data() + static_cast<size_t>(iDstX) * nXDist);
+    }
+
+    for (int iDstY = iYMin; iDstY < iYMax; iDstY++)
+    {
+        adfX[iDstY - iYMin] = 0.5 + poWK->nDstXOff;
+        adfY[iDstY - iYMin] = iDstY + 0.5 + poWK->nDstYOff;
+        adfZ[iDstY - iYMin] = 0;
+    }
+    poWK->pfnTransformer(psJob->pTransformerArg, TRUE, nDstYCount, adfX.data(),
+                         adfY.data(), adfZ.data(), abSuccess.data());
+
+    /* -------------------------------------------------------------------- */
+    /*      The result of the horizontal pass on a source line is kept in   */
+    /*      a ring buffer, as it is generally needed by several             */
+    /*      consecutive destination lines. The window of a destination      */
+    /*      line spans at most 2 * nYRadius source lines, so they are all   */
+    /*      in distinct slots.                                              */
+    /* -------------------------------------------------------------------- */
+    const int nRingSize = 2 * poWK->nYRadius + 1;
+    std::vector<int> anRingSrcLine(nRingSize, -1);
+    std::vector<double> adfRing(static_cast<size_t>(nRingSize) * nBands *
+                                    nDstXSize,
+                                0.0);
+    std::vector<double> adfWeightsY(nRingSize);
+    std::vector<double> adfAccumulator(nDstXSize);
+
+    const auto GetRingLine = [&adfRing, nRingSize, nBands,
+                              nDstXSize](int iSrcY, int iBand)
+    {
+        return adfRing.data() +
+               (static_cast<size_t>(iSrcY % nRingSize) * nBands + iBand) *
+                   nDstXSize;
+    };
+
+    /* ==================================================================== */
+    /*      Loop over output lines.                                         */
+    /* ==================================================================== */
+    for (int iDstY = iYMin; iDstY < iYMax; iDstY++)
+    {
+        const double dfSrcY = adfY[iDstY - iYMin];
+        if (abSuccess[iDstY - iYMin] && dfSrcY >= poWK->nSrcYOff &&
+            dfSrcY + 1e-10 <= nSrcYSize + poWK->nSrcYOff)
+        {
+            int iSrcY = 0;
+            int jMin = 0;
+            int jMax = 0;
+            double dfDeltaY = 0;
+            GWKSeparableComputeWindow(dfSrcY - poWK->nSrcYOff, poWK->nYRadius,
+                                      nSrcYSize, iSrcY, jMin, jMax, dfDeltaY);
+            const double dfWeightSumY =
+                GWKComputeWeights1D(poWK->eResample, jMin, jMax, dfDeltaY,
+                                    dfYScale, adfWeightsY.data());
+
+            /* ------------------------------------------------------------ */
+            /*      Horizontal pass on source lines not yet in the ring.    */
+            /* ------------------------------------------------------------ */
+            for (int j = iSrcY + jMin; j <= iSrcY + jMax; ++j)
+            {
+                if (anRingSrcLine[j % nRingSize] == j)
+                    continue;
+                anRingSrcLine[j % nRingSize] = j;
+
+                for (int iBand = 0; iBand < nBands; iBand++)
+                {
+                    const T *pSrcLine =
+                        reinterpret_cast<const T *>(
+                            poWK->papabySrcImage[iBand]) +
+                        static_cast<GPtrDiff_t>(j) * nSrcXSize;
+                    double *padfRingLine = GetRingLine(j, iBand);
+                    for (int iDstX = 0; iDstX < nDstXSize; iDstX++)
+                    {
+                        if (anColCount[iDstX] == 0)
+                            continue;
+                        padfRingLine[iDstX] = GWKSeparableHorizontalT(
+                            pSrcLine + anColSrcStart[iDstX],
+                            adfColWeights.data() +
+                                static_cast<size_t>(iDstX) * nXDist,
+                            anColCount[iDstX]);
+                    }
+                }
+            }
+
+            /* ------------------------------------------------------------ */
+            /*      Vertical pass.                                          */
+            /* ------------------------------------------------------------ */
+            const GPtrDiff_t iDstLineOffset =
+                static_cast<GPtrDiff_t>(iDstY) * nDstXSize;
+            for (int iBand = 0; iBand < nBands; iBand++)
+            {
+                std::fill(adfAccumulator.begin(), adfAccumulator.end(), 0.0);
+                for (int j = jMin; j <= jMax; ++j)
+                {
+                    const double dfWeight = adfWeightsY[j - jMin];
+                    const double *padfRingLine = GetRingLine(iSrcY + j, iBand);
+                    for (int iDstX = 0; iDstX < nDstXSize; iDstX++)
+                        adfAccumulator[iDstX] += dfWeight * padfRingLine[iDstX];
+                }
+
+                for (int iDstX = 0; iDstX < nDstXSize; iDstX++)
+                {
+                    if (anColCount[iDstX] == 0)
+                        continue;
+                    const double dfInvWeights =
+                        1. / (adfColWeightSum[iDstX] * dfWeightSumY);
+                    ClampRoundAndAvoidNoData<T>(
+                        poWK, iBand, iDstLineOffset + iDstX,
+                        adfAccumulator[iDstX] * dfInvWeights);
+                }
+            }
+
+            /* ------------------------------------------------------------ */
+            /*      Update destination density/validity masks.              */
+            /* ------------------------------------------------------------ */
+            for (int iDstX = 0; iDstX < nDstXSize; iDstX++)
+            {
+                if (anColCount[iDstX] == 0)
+                    continue;
+                if (poWK->pafDstDensity)
+                    poWK->pafDstDensity[iDstLineOffset + iDstX] = 1.0f;
+                if (poWK->panDstValid)
+                    CPLMaskSet(poWK->panDstValid, iDstLineOffset + iDstX);
+            }
+        }
+
+        /* ---------------------------------------------------------------- */
+        /*      Report progress to the user, and optionally cancel out.     */
+        /* ---------------------------------------------------------------- */
+        if (psJob->pfnProgress && psJob->pfnProgress(psJob))
+            break;
+    }
+}
+
+/************************************************************************/
+/*                      GWKSeparableResample()                          */
+/************************************************************************/
+
+static CPLErr GWKSeparableResample(GDALWarpKernel *poWK)
+{
+    switch (poWK->eWorkingDataType)
+    {
+        case GDT_Byte:
+            return GWKRun(poWK, "GWKSeparableResample",
+                          GWKSeparableResampleThread<GByte>);
+        case GDT_Int16:
+            return GWKRun(poWK, "GWKSeparableResample",
+                          GWKSeparableResampleThread<GInt16>);
+        case GDT_UInt16:
+            return GWKRun(poWK, "GWKSeparableResample",
+                          GWKSeparableResampleThread<GUInt16>);
+        case GDT_Float32:
+            return GWKRun(poWK, "GWKSeparableResample",
+                          GWKSeparableResampleThread<float>);
+        case GDT_Float64:
+            return GWKRun(poWK, "GWKSeparableResample",
+                          GWKSeparableResampleThread<double>);
+        default:
+            break;
+    }
+    CPLAssert(false);
+    return CE_Failure;
+}
+
+/************************************************************************/
+/*                   GWKSeparableAreaCanBeUsed()                        */
+/************************************************************************/
+
+// Whether, over the chunk, the X coordinate of the transformation of a
+// point by pfnTransformer only depends on its X coordinate, and its Y
+// coordinate on its Y coordinate, within dfMaxError, as probed on a lattice
+// of points of the destination (bDstToSrc) or source window.
+// GWKSeparableAreaResampleThread() computes the footprints of all the
+// columns (resp. lines) of a job from its first line (resp. column), so the
+// spacing of the lattice is bounded, whatever the size of the chunk.
+static bool GWKTransformIsNearlySeparable(const GDALWarpKernel *poWK,
+                                          GDALTransformerFunc pfnTransformer,
+                                          void *pTransformerArg,
+                                          bool bDstToSrc, double dfMaxError)
+{
+    const int nXOff = bDstToSrc ? poWK->nDstXOff : poWK->nSrcXOff;
+    const int nYOff = bDstToSrc ? poWK->nDstYOff : poWK->nSrcYOff;
+    const int nXSize = bDstToSrc ? poWK->nDstXSize : poWK->nSrcXSize;
+    const int nYSize = bDstToSrc ? poWK->nDstYSize : poWK->nSrcYSize;
+
+    // At most 32 pixels between 2 points, and at least 5 points, along
+    // each axis.
+    constexpr int MAX_SPACING = 32;
+    const int nXPoints =
+        std::max(5, (nXSize + MAX_SPACING - 1) / MAX_SPACING + 1);
+    const int nYPoints =
+        std::max(5, (nYSize + MAX_SPACING - 1) / MAX_SPACING + 1);
+    const size_t nPoints = static_cast<size_t>(nXPoints) * nYPoints;
+
+    std::vector<double> adfX(nPoints);
+    std::vector<double> adfY(nPoints);
+    std::vector<double> adfZ(nPoints);
+    std::vector<int> abSuccess(nPoints);
+    for (int j = 0; j < nYPoints; ++j)
+    {
+        for (int i = 0; i < nXPoints; ++i)
+        {
+            const size_t k = static_cast<size_t>(j) * nXPoints + i;
+            adfX[k] = nXOff + static_cast<double>(nXSize) * i / (nXPoints - 1);
+            adfY[k] = nYOff + static_cast<double>(nYSize) * j / (nYPoints - 1);
+        }
+    }
+    pfnTransformer(pTransformerArg, bDstToSrc, static_cast<int>(nPoints),
+                   adfX.data(), adfY.data(), adfZ.data(), abSuccess.data());
+    for (size_t k = 0; k < nPoints; ++k)
+    {
+        if (!abSuccess[k] || !std::isfinite(adfX[k]) ||
+            !std::isfinite(adfY[k]))
+            return false;
+    }
+    for (int j = 0; j < nYPoints; ++j)
+    {
+        const size_t nRowStart = static_cast<size_t>(j) * nXPoints;
+        for (int i = 0; i < nXPoints; ++i)
+        {
+            if (!(std::fabs(adfX[nRowStart + i] - adfX[i]) <= dfMaxError &&
+                  std::fabs(adfY[nRowStart + i] - adfY[nRowStart]) <=
+                      dfMaxError))
+                return false;
+        }
+    }
+    return true;
+}
+
+// Whether Average or Sum resampling can be done with
+// GWKSeparableAreaResample(). As for GWKSeparableCanBeUsed(), the
+// transformation must be a pure scaling and translation, so that the source
+// footprint of a destination pixel is the product of a range of source
+// columns depending only on its destination column, and of a range of source
+// lines depending only on its destination line. With an approximate
+// transformer, this needs only be true over the chunk within its error
+// threshold, which is the case of reprojections of small areas.
+static bool GWKSeparableAreaCanBeUsed(const GDALWarpKernel *poWK)
+{
+    if (!CPLFetchBool(poWK->papszWarpOptions, "SEPARABLE_RESAMPLING", false))
+        return false;
+
+    if (poWK->eResample != GRA_Average && poWK->eResample != GRA_Sum)
+        return false;
+
+    if (poWK->pafUnifiedSrcDensity != nullptr || poWK->bApplyVerticalShift)
+        return false;
+
+    if (poWK->eWorkingDataType != GDT_Byte &&
+        poWK->eWorkingDataType != GDT_Int16 &&
+        poWK->eWorkingDataType != GDT_UInt16 &&
+        poWK->eWorkingDataType != GDT_Float32 &&
+        poWK->eWorkingDataType != GDT_Float64)
+        return false;
+
+    if (poWK->nSrcXSize <= 0 || poWK->nSrcYSize <= 0)
+        return false;
+
+    // Cases handled by the special all-bands path of
+    // GWKAverageOrModeThread().
+    if (poWK->eResample == GRA_Average &&
+        (!poWK->m_aadfExcludedValues.empty() ||
+         CPLAtof(CSLFetchNameValueDef(poWK->papszWarpOptions,
+                                      "NODATA_VALUES_PCT_THRESHOLD", "100")) <
+             100))
+        return false;
+
+    // for debug/testing purposes, as in GWKSumPreservingThread()
+    if (poWK->eResample == GRA_Sum &&
+        !CPLTestBool(
+            CPLGetConfigOption("GDAL_WARP_USE_AFFINE_OPTIMIZATION", "YES")))
+        return false;
+
+    if (CPLAtof(CSLFetchNameValueDef(poWK->papszWarpOptions,
+                                     "SRC_COORD_PRECISION", "0")) > 0)
+        return false;
+
+    if (GDALTransformIsAffineNoRotation(poWK->pfnTransformer,
+                                        poWK->pTransformerArg))
+        return true;
+
+    // A transformation grid wrapping the approximate transformer has the
+    // same error threshold.
+    void *pTransformerArg = poWK->pTransformerArg;
+    if (GDALIsTransformer(pTransformerArg,
+                          GDAL_TRANSFORMATION_GRID_TRANSFORMER_CLASS_NAME))
+    {
+        pTransformerArg =
+            GDALGetTransformationGridBaseTransformer(pTransformerArg);
+    }
+    if (!GDALIsTransformer(pTransformerArg,
+                           GDAL_APPROX_TRANSFORMER_CLASS_NAME))
+        return false;
+    // Probe the exact transformation, so that the approximation done when
+    // computing the footprints is not taken into account twice.
+    const auto *psApproxInfo =
+        static_cast<const GDALApproxTransformInfo *>(pTransformerArg);
+    // The Sum footprints are computed from source to destination.
+    return GWKTransformIsNearlySeparable(
+               poWK, psApproxInfo->pfnBaseTransformer,
+               psApproxInfo->pBaseCBData, true,
+               psApproxInfo->dfMaxErrorReverse) &&
+           (poWK->eResample != GRA_Sum ||
+            GWKTransformIsNearlySeparable(
+                poWK, psApproxInfo->pfnBaseTransformer,
+                psApproxInfo->pBaseCBData, false,
+                psApproxInfo->dfMaxErrorForward));
+}
+
+/************************************************************************/
+/*                        GWKAreaFootprint                              */
+/************************************************************************/
+
+namespace
+{
+// Range [iMin, iMax[ of source columns (resp. lines) contributing to a
+// destination column (resp. line), with the weights of the first and last
+// ones. Other ones have a weight of 1. An empty range (iMin == iMax) means
+// that the destination column (resp. line) gets no source pixel.
+struct GWKAreaFootprint
+{
+    int iMin = 0;
+    int iMax = 0;
+    double dfWeightFirst = 0;
+    double dfWeightLast = 0;
+
+    inline double GetWeight(int i) const
+    {
+        return i == iMin ? dfWeightFirst
+               : i + 1 == iMax ? dfWeightLast
+                               : 1.0;
+    }
+};
+}  // namespace
+
+/************************************************************************/
+/*                   GWKComputeAverageFootprint()                       */
+/************************************************************************/
+
+// Same source range and weights as in GWKAverageOrModeThread(), from the
+// source coordinates dfA and dfB (relative to the source window) of the 2
+// edges of the destination column (resp. line).
+static bool GWKComputeAverageFootprint(double dfA, double dfB, int nSrcSize,
+                                       int nMargin, GWKAreaFootprint &sFP)
+{
+    if (!(dfA >= -nMargin && dfB >= -nMargin && dfA - nSrcSize <= nMargin &&
+          dfB - nSrcSize <= nMargin))
+        return false;
+
+    if (dfA > dfB)
+        std::swap(dfA, dfB);
+
+    constexpr double EPS = 1e-10;
+    if (!(dfB > -EPS && dfA < nSrcSize + EPS))
+        return false;
+    const int iMin = static_cast<int>(std::max(floor(dfA + EPS), 0.0));
+    int iMax = static_cast<int>(
+        std::min(ceil(dfB - EPS), static_cast<double>(nSrcSize)));
+    if (iMin == iMax && iMax < nSrcSize)
+        iMax++;
+    if (iMin >= iMax)
+        return false;
+
+    sFP.iMin = iMin;
+    sFP.iMax = iMax;
+    sFP.dfWeightFirst = (iMin + 1 == iMax) ? 1.0 : 1 - (dfA - iMin);
+    sFP.dfWeightLast = 1 - (iMax - dfB);
+    return true;
+}
+
+/************************************************************************/
+/*                     GWKComputeSumFootprint()                         */
+/************************************************************************/
+
+// Source range of the destination column (resp. line) [dfDst, dfDst + 1],
+// given the strictly monotonic destination coordinates padfEdges[0..nSrcSize]
+// of the edges of the source columns (resp. lines). The weight of a source
+// column is the ratio of its extent that is covered by the destination one,
+// as in the affine case of GWKSumPreservingThread().
+static bool GWKComputeSumFootprint(const double *padfEdges, int nSrcSize,
+                                   double dfDst, GWKAreaFootprint &sFP)
+{
+    const bool bIncreasing = padfEdges[nSrcSize] > padfEdges[0];
+    // First index in [0, nSrcSize] for which pred() is true, pred() being
+    // false and then true over that interval.
+    const auto FindFirst = [nSrcSize](auto pred)
+    {
+        int iLow = 0;
+        int iHigh = nSrcSize;
+        while (iLow < iHigh)
+        {
+            const int iMid = iLow + (iHigh - iLow) / 2;
+            if (pred(iMid))
+                iHigh = iMid;
+            else
+                iLow = iMid + 1;
+        }
+        return iLow;
+    };
+    if (bIncreasing)
+    {
+        sFP.iMin = FindFirst([padfEdges, dfDst](int i)
+                             { return padfEdges[i + 1] > dfDst; });
+        sFP.iMax = FindFirst([padfEdges, dfDst](int i)
+                             { return padfEdges[i] >= dfDst + 1; });
+    }
+    else
+    {
+        sFP.iMin = FindFirst([padfEdges, dfDst](int i)
+                             { return padfEdges[i + 1] < dfDst + 1; });
+        sFP.iMax = FindFirst([padfEdges, dfDst](int i)
+                             { return padfEdges[i] <= dfDst; });
+    }
+    if (sFP.iMin >= sFP.iMax)
+        return false;
+
+    const auto GetWeight = [padfEdges, dfDst](int i)
+    {
+        const double dfLow = std::min(padfEdges[i], padfEdges[i + 1]);
+        const double dfHigh = std::max(padfEdges[i], padfEdges[i + 1]);
+        return (std::min(dfHigh, dfDst + 1) - std::max(dfLow, dfDst)) /
+               (dfHigh - dfLow);
+    };
+    sFP.dfWeightFirst = GetWeight(sFP.iMin);
+    sFP.dfWeightLast = GetWeight(sFP.iMax - 1);
+    return true;
+}
+
+/************************************************************************/
+/*                   GWKSeparableAreaPixelValue()                       */
+/************************************************************************/
+
+// Direct computation of the value of a destination pixel, with the
+// accumulation of GWKAverageOrModeThread() or GWKSumPreservingThread(). Used
+// when the sum of the column aggregates is not finite, so that NaN and
+// infinity are propagated as in those functions.
+template <class T>
+static bool GWKSeparableAreaPixelValue(const GDALWarpKernel *poWK, int iBand,
+                                       const GWKAreaFootprint &sColFP,
+                                       const GWKAreaFootprint &sRowFP,
+                                       double &dfValue)
+{
+    const bool bSum = poWK->eResample == GRA_Sum;
+    const T *pSrc = reinterpret_cast<const T *>(poWK->papabySrcImage[iBand]);
+    GUInt32 *panBandSrcValid =
+        poWK->papanBandSrcValid ? poWK->papanBandSrcValid[iBand] : nullptr;
+    double dfTotalWeight = 0;
+    dfValue = 0;
+    for (int iSrcY = sRowFP.iMin; iSrcY < sRowFP.iMax; ++iSrcY)
+    {
+        const double dfWeightY = sRowFP.GetWeight(iSrcY);
+        for (int iSrcX = sColFP.iMin; iSrcX < sColFP.iMax; ++iSrcX)
+        {
+            const GPtrDiff_t iSrcOffset =
+                iSrcX + static_cast<GPtrDiff_t>(iSrcY) * poWK->nSrcXSize;
+            if ((poWK->panUnifiedSrcValid &&
+                 !CPLMaskGet(poWK->panUnifiedSrcValid, iSrcOffset)) ||
+                (panBandSrcValid && !CPLMaskGet(panBandSrcValid, iSrcOffset)))
+                continue;
+            const double dfWeight = dfWeightY * sColFP.GetWeight(iSrcX);
+            const double dfSrc = static_cast<double>(pSrc[iSrcOffset]);
+            dfTotalWeight += dfWeight;
+            if (bSum)
+                dfValue += dfSrc * dfWeight;
+            else
+                dfValue += (dfWeight / dfTotalWeight) * (dfSrc - dfValue);
+        }
+    }
+    return dfTotalWeight > 0;
+}
+
+/************************************************************************/
+/*                  GWKSeparableAreaResampleThread()                    */
+/************************************************************************/
+
+static void GWKAverageOrModeThread(void *pData);
+static void GWKSumPreservingThread(void *pData);
+
+template <class T> static void GWKSeparableAreaResampleThread(void *pData)
+{
+    GWKJobStruct *psJob = static_cast<GWKJobStruct *>(pData);
+    GDALWarpKernel *poWK = psJob->poWK;
+    const int iYMin = psJob->iYMin;
+    const int iYMax = psJob->iYMax;
+    if (iYMin >= iYMax)
+        return;
+
+    const bool bSum = poWK->eResample == GRA_Sum;
+    const int nDstXSize = poWK->nDstXSize;
+    const int nSrcXSize = poWK->nSrcXSize;
+    const int nSrcYSize = poWK->nSrcYSize;
+    const int nBands = poWK->nBands;
+    const int nDstYCount = iYMax - iYMin;
+
+    /* -------------------------------------------------------------------- */
+    /*      Compute the source footprint of each destination column, from   */
+    /*      the first line, and of each destination line, from the first    */
+    /*      column. Should the transformer fail on one of the edges, fall   */
+    /*      back to the per-pixel code path.                                */
+    /* -------------------------------------------------------------------- */
+    std::vector<GWKAreaFootprint> asColFP(nDstXSize);
+    std::vector<GWKAreaFootprint> asRowFP(nDstYCount);
+    std::vector<char> abColValid(nDstXSize);
+    std::vector<char> abRowValid(nDstYCount);
+    bool bTransformOK = true;
+
+    if (bSum)
+    {
+        // Destination coordinates of the edges of the source columns and
+        // lines.
+        const int nPoints = std::max(nSrcXSize, nSrcYSize) + 1;
+        std::vector<double> adfX(nPoints);
+        std::vector<double> adfY(nPoints);
+        std::vector<double> adfZ(nPoints);
+        std::vector<int> abSuccess(nPoints);
+        std::vector<double> adfColEdges(nSrcXSize + 1);
+        std::vector<double> adfRowEdges(nSrcYSize + 1);
+
+        const auto IsStrictlyMonotonic = [](const std::vector<double> &v)
+        {
+            const bool bIncreasing = v.back() > v.front();
+            for (size_t i = 0; i + 1 < v.size(); ++i)
             {
-                dfDensity = poWK->pafUnifiedSrcDensity[iSrcOffset];
-                if (dfDensity < SRC_DENSITY_THRESHOLD)
+                if (!(bIncreasing ? v[i + 1] > v[i] : v[i + 1] < v[i]))
+                    return false;
+            }
+            return true;
+        };
+
+        for (int iX = 0; iX <= nSrcXSize; ++iX)
+        {
+            adfX[iX] = iX + poWK->nSrcXOff;
+            adfY[iX] = poWK->nSrcYOff;
+            adfZ[iX] = 0;
+        }
+        poWK->pfnTransformer(psJob->pTransformerArg, FALSE, nSrcXSize + 1,
+                             adfX.data(), adfY.data(), adfZ.data(),
+                             abSuccess.data());
+        for (int iX = 0; bTransformOK && iX <= nSrcXSize; ++iX)
+        {
+            bTransformOK = abSuccess[iX] && std::isfinite(adfX[iX]);
+            adfColEdges[iX] = adfX[iX] - poWK->nDstXOff;
+        }
+
+        for (int iY = 0; iY <= nSrcYSize; ++iY)
+        {
+            adfX[iY] = poWK->nSrcXOff;
+            adfY[iY] = iY + poWK->nSrcYOff;
+            adfZ[iY] = 0;
+        }
+        poWK->pfnTransformer(psJob->pTransformerArg, FALSE, nSrcYSize + 1,
+                             adfX.data(), adfY.data(), adfZ.data(),
+                             abSuccess.data());
+        for (int iY = 0; bTransformOK && iY <= nSrcYSize; ++iY)
+        {
+            bTransformOK = abSuccess[iY] && std::isfinite(adfY[iY]);
+            adfRowEdges[iY] = adfY[iY] - poWK->nDstYOff;
+        }
+
+        bTransformOK = bTransformOK && IsStrictlyMonotonic(adfColEdges) &&
+                       IsStrictlyMonotonic(adfRowEdges);
+        if (bTransformOK)
+        {
+            for (int iDstX = 0; iDstX < nDstXSize; ++iDstX)
+            {
+                abColValid[iDstX] = GWKComputeSumFootprint(
+                    adfColEdges.data(), nSrcXSize, iDstX, asColFP[iDstX]);
+            }
+            for (int iDstY = iYMin; iDstY < iYMax; ++iDstY)
+            {
+                abRowValid[iDstY - iYMin] =
+                    GWKComputeSumFootprint(adfRowEdges.data(), nSrcYSize,
+                                           iDstY, asRowFP[iDstY - iYMin]);
+            }
+        }
+    }
+    else
+    {
+        const int nXMargin =
+            2 * std::max(1, static_cast<int>(std::ceil(1. / poWK->dfXScale)));
+        const int nYMargin =
+            2 * std::max(1, static_cast<int>(std::ceil(1. / poWK->dfYScale)));
+
+        // Same points as in GWKAverageOrModeThread()
+        const int nPoints = std::max(nDstXSize, nDstYCount);
+        std::vector<double> adfX(nPoints);
+        std::vector<double> adfY(nPoints);
+        std::vector<double> adfZ(nPoints);
+        std::vector<int> abSuccess(nPoints);
+        std::vector<double> adfX2(nPoints);
+        std::vector<double> adfY2(nPoints);
+        std::vector<double> adfZ2(nPoints);
+        std::vector<int> abSuccess2(nPoints);
+
+        for (int iDstX = 0; iDstX < nDstXSize; ++iDstX)
+        {
+            adfX[iDstX] = iDstX + poWK->nDstXOff;
+            adfY[iDstX] = iYMin + poWK->nDstYOff;
+            adfZ[iDstX] = 0;
+            adfX2[iDstX] = iDstX + 1.0 + poWK->nDstXOff;
+            adfY2[iDstX] = iYMin + 1.0 + poWK->nDstYOff;
+            adfZ2[iDstX] = 0;
+        }
+        poWK->pfnTransformer(psJob->pTransformerArg, TRUE, nDstXSize,
+                             adfX.data(), adfY.data(), adfZ.data(),
+                             abSuccess.data());
+        poWK->pfnTransformer(psJob->pTransformerArg, TRUE, nDstXSize,
+                             adfX2.data(), adfY2.data(), adfZ2.data(),
+                             abSuccess2.data());
+        for (int iDstX = 0; bTransformOK && iDstX < nDstXSize; ++iDstX)
+        {
+            bTransformOK = abSuccess[iDstX] && abSuccess2[iDstX];
+            abColValid[iDstX] = GWKComputeAverageFootprint(
+                adfX[iDstX] - poWK->nSrcXOff, adfX2[iDstX] - poWK->nSrcXOff,
+                nSrcXSize, nXMargin, asColFP[iDstX]);
+        }
+
+        for (int iDstY = iYMin; iDstY < iYMax; ++iDstY)
+        {
+            adfX[iDstY - iYMin] = poWK->nDstXOff;
+            adfY[iDstY - iYMin] = iDstY + poWK->nDstYOff;
+            adfZ[iDstY - iYMin] = 0;
+            adfX2[iDstY - iYMin] = 1.0 + poWK->nDstXOff;
+            adfY2[iDstY - iYMin] = iDstY + 1.0 + poWK->nDstYOff;
+            adfZ2[iDstY - iYMin] = 0;
+        }
+        poWK->pfnTransformer(psJob->pTransformerArg, TRUE, nDstYCount,
+                             adfX.data(), adfY.data(), adfZ.data(),
+                             abSuccess.data());
+        poWK->pfnTransformer(psJob->pTransformerArg, TRUE, nDstYCount,
+                             adfX2.data(), adfY2.data(), adfZ2.data(),
+                             abSuccess2.data());
+        for (int i = 0; bTransformOK && i < nDstYCount; ++i)
+        {
+            bTransformOK = abSuccess[i] && abSuccess2[i];
+            abRowValid[i] = GWKComputeAverageFootprint(
+                adfY[i] - poWK->nSrcYOff, adfY2[i] - poWK->nSrcYOff, nSrcYSize,
+                nYMargin, asRowFP[i]);
+        }
+    }
+
+    if (!bTransformOK)
+    {
+        if (bSum)
+            GWKSumPreservingThread(pData);
+        else
+            GWKAverageOrModeThread(pData);
+        return;
+    }
+
+    // Union of the source columns used by the destination columns, and sum
+    // of the horizontal weights of each destination column.
+    int iSrcXMin = nSrcXSize;
+    int iSrcXMax = 0;
+    std::vector<double> adfColWeightSum(nDstXSize);
+    for (int iDstX = 0; iDstX < nDstXSize; ++iDstX)
+    {
+        if (abColValid[iDstX])
+        {
+            const GWKAreaFootprint &sColFP = asColFP[iDstX];
+            iSrcXMin = std::min(iSrcXMin, sColFP.iMin);
+            iSrcXMax = std::max(iSrcXMax, sColFP.iMax);
+            adfColWeightSum[iDstX] =
+                (sColFP.iMin + 1 == sColFP.iMax)
+                    ? sColFP.dfWeightFirst
+                    : sColFP.dfWeightFirst + sColFP.dfWeightLast +
+                          (sColFP.iMax - sColFP.iMin - 2);
+        }
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      For each destination line, the source lines of its footprint    */
+    /*      are first accumulated per source column, with their vertical    */
+    /*      weights. Each destination pixel is then the weighted sum of     */
+    /*      the column aggregates of its footprint. As the footprints of    */
+    /*      consecutive destination pixels are adjacent, each source pixel  */
+    /*      is read about once.                                             */
+    /* -------------------------------------------------------------------- */
+    const bool bHasMasks = poWK->panUnifiedSrcValid != nullptr ||
+                           poWK->papanBandSrcValid != nullptr;
+    std::vector<double> adfColSum(static_cast<size_t>(nBands) * nSrcXSize);
+    // Only used with masks. Otherwise the weight of every column is the sum
+    // of the vertical weights.
+    std::vector<double> adfColWeight(
+        bHasMasks ? static_cast<size_t>(nBands) * nSrcXSize : 0);
+
+    for (int iDstY = iYMin; iDstY < iYMax; iDstY++)
+    {
+        const GWKAreaFootprint &sRowFP = asRowFP[iDstY - iYMin];
+        if (abRowValid[iDstY - iYMin] && iSrcXMin < iSrcXMax)
+        {
+            std::fill(adfColSum.begin(), adfColSum.end(), 0.0);
+            std::fill(adfColWeight.begin(), adfColWeight.end(), 0.0);
+            double dfRowWeightSum = 0;
+
+            for (int iSrcY = sRowFP.iMin; iSrcY < sRowFP.iMax; ++iSrcY)
+            {
+                const double dfWeightY = sRowFP.GetWeight(iSrcY);
+                dfRowWeightSum += dfWeightY;
+                const GPtrDiff_t iSrcLineOffset =
+                    static_cast<GPtrDiff_t>(iSrcY) * nSrcXSize;
+                for (int iBand = 0; iBand < nBands; iBand++)
                 {
-                    if (!bOneSourceCornerFailsToReproject)
+                    const T *pSrcLine = reinterpret_cast<const T *>(
+                                            poWK->papabySrcImage[iBand]) +
+                                        iSrcLineOffset;
+                    double *padfColSum = adfColSum.data() +
+                                         static_cast<size_t>(iBand) * nSrcXSize;
+                    if (!bHasMasks)
                     {
+                        for (int iSrcX = iSrcXMin; iSrcX < iSrcXMax; ++iSrcX)
+                            padfColSum[iSrcX] += dfWeightY * pSrcLine[iSrcX];
                         continue;
                     }
-                    else if (GWKAdjustSrcOffsetOnEdgeUnifiedSrcDensity(
-                                 psJob, iSrcOffset))
-                    {
-                        dfDensity = poWK->pafUnifiedSrcDensity[iSrcOffset];
-                    }
-                    else
+
+                    GUInt32 *panBandSrcValid =
+                        poWK->papanBandSrcValid
+                            ? poWK->papanBandSrcValid[iBand]
+                            : nullptr;
+                    double *padfColWeight = adfColWeight.data() +
+                                            static_cast<size_t>(iBand) *
+                                                nSrcXSize;
+                    for (int iSrcX = iSrcXMin; iSrcX < iSrcXMax; ++iSrcX)
                     {
-                        continue;
+                        const GPtrDiff_t iSrcOffset = iSrcLineOffset + iSrcX;
+                        if ((poWK->panUnifiedSrcValid &&
+                             !CPLMaskGet(poWK->panUnifiedSrcValid,
+                                         iSrcOffset)) ||
+                            (panBandSrcValid &&
+                             !CPLMaskGet(panBandSrcValid, iSrcOffset)))
+                            continue;
+                        padfColSum[iSrcX] += dfWeightY * pSrcLine[iSrcX];
+                        padfColWeight[iSrcX] += dfWeightY;
                     }
                 }
             }
 
-            if (poWK->panUnifiedSrcValid != nullptr &&
-                !CPLMaskGet(poWK->panUnifiedSrcValid, iSrcOffset))
+            const GPtrDiff_t iDstLineOffset =
+                static_cast<GPtrDiff_t>(iDstY) * nDstXSize;
+            for (int iDstX = 0; iDstX < nDstXSize; iDstX++)
             {
-                if (!bOneSourceCornerFailsToReproject)
-                {
-                    continue;
-                }
-                else if (!GWKAdjustSrcOffsetOnEdge(psJob, iSrcOffset))
-                {
+                if (!abColValid[iDstX])
                     continue;
-                }
-            }
-
-            /* ====================================================================
-             */
-            /*      Loop processing each band. */
-            /* ====================================================================
-             */
-            bool bHasFoundDensity = false;
-
-            const GPtrDiff_t iDstOffset =
-                iDstX + static_cast<GPtrDiff_t>(iDstY) * nDstXSize;
-            for (int iBand = 0; iBand < poWK->nBands; iBand++)
-            {
-                double dfBandDensity = 0.0;
-                double dfValueReal = 0.0;
-
-                /* --------------------------------------------------------------------
-                 */
-                /*      Collect the source value. */
-                /* --------------------------------------------------------------------
-                 */
-                if (poWK->eResample == GRA_NearestNeighbour || nSrcXSize == 1 ||
-                    nSrcYSize == 1)
-                {
-                    // FALSE is returned if dfBandDensity == 0, which is
-                    // checked below.
-                    CPL_IGNORE_RET_VAL(GWKGetPixelValueReal(
-                        poWK, iBand, iSrcOffset, &dfBandDensity, &dfValueReal));
-                }
-                else if (poWK->eResample == GRA_Bilinear && bUse4SamplesFormula)
-                {
-                    double dfValueImagIgnored = 0.0;
-                    GWKBilinearResample4Sample(
-                        poWK, iBand, padfX[iDstX] - poWK->nSrcXOff,
-                        padfY[iDstX] - poWK->nSrcYOff, &dfBandDensity,
-                        &dfValueReal, &dfValueImagIgnored);
-                }
-                else if (poWK->eResample == GRA_Cubic && bUse4SamplesFormula)
+                const GWKAreaFootprint &sColFP = asColFP[iDstX];
+                const GPtrDiff_t iDstOffset = iDstLineOffset + iDstX;
+                bool bHasFoundDensity = false;
+                for (int iBand = 0; iBand < nBands; iBand++)
                 {
-                    if (bSrcMaskIsDensity)
+                    const double *padfColSum =
+                        adfColSum.data() +
+                        static_cast<size_t>(iBand) * nSrcXSize;
+                    double dfValue = sColFP.dfWeightFirst *
+                                     padfColSum[sColFP.iMin];
+                    for (int iSrcX = sColFP.iMin + 1; iSrcX < sColFP.iMax - 1;
+                         ++iSrcX)
+                        dfValue += padfColSum[iSrcX];
+                    if (sColFP.iMin + 1 < sColFP.iMax)
+                        dfValue +=
+                            sColFP.dfWeightLast * padfColSum[sColFP.iMax - 1];
+
+                    double dfWeight;
+                    if (bHasMasks)
                     {
-                        if (poWK->eWorkingDataType == GDT_Byte)
-                        {
-                            GWKCubicResampleSrcMaskIsDensity4SampleRealT<GByte>(
-                                poWK, iBand, padfX[iDstX] - poWK->nSrcXOff,
-                                padfY[iDstX] - poWK->nSrcYOff, &dfBandDensity,
-                                &dfValueReal);
-                        }
-                        else if (poWK->eWorkingDataType == GDT_UInt16)
-                        {
-                            GWKCubicResampleSrcMaskIsDensity4SampleRealT<
-                                GUInt16>(poWK, iBand,
-                                         padfX[iDstX] - poWK->nSrcXOff,
-                                         padfY[iDstX] - poWK->nSrcYOff,
-                                         &dfBandDensity, &dfValueReal);
-                        }
-                        else
-                        {
-                            GWKCubicResampleSrcMaskIsDensity4SampleReal(
-                                poWK, iBand, padfX[iDstX] - poWK->nSrcXOff,
-                                padfY[iDstX] - poWK->nSrcYOff, &dfBandDensity,
-                                &dfValueReal);
-                        }
+                        const double *padfColWeight =
+                            adfColWeight.data() +
+                            static_cast<size_t>(iBand) * nSrcXSize;
+                        dfWeight = 0;
+                        for (int iSrcX = sColFP.iMin; iSrcX < sColFP.iMax;
+                             ++iSrcX)
+                            dfWeight +=
+                                sColFP.GetWeight(iSrcX) * padfColWeight[iSrcX];
                     }
                     else
                     {
-                        double dfValueImagIgnored = 0.0;
-                        GWKCubicResample4Sample(
-                            poWK, iBand, padfX[iDstX] - poWK->nSrcXOff,
-                            padfY[iDstX] - poWK->nSrcYOff, &dfBandDensity,
-                            &dfValueReal, &dfValueImagIgnored);
+                        dfWeight = dfRowWeightSum * adfColWeightSum[iDstX];
                     }
-                }
-                else
-#ifdef DEBUG
-                    // Only useful for clang static analyzer.
-                    if (psWrkStruct != nullptr)
-#endif
+                    if (!(dfWeight > 0))
+                        continue;
+
+                    if (!std::isfinite(dfValue))
                     {
-                        double dfValueImagIgnored = 0.0;
-                        psWrkStruct->pfnGWKResample(
-                            poWK, iBand, padfX[iDstX] - poWK->nSrcXOff,
-                            padfY[iDstX] - poWK->nSrcYOff, &dfBandDensity,
-                            &dfValueReal, &dfValueImagIgnored, psWrkStruct);
+                        // Only possible with floating-point data
+                        if (!GWKSeparableAreaPixelValue<T>(
+                                poWK, iBand, sColFP, sRowFP, dfValue))
+                            continue;
+                    }
+                    else if (!bSum)
+                    {
+                        dfValue /= dfWeight;
                     }
 
-                // If we didn't find any valid inputs skip to next band.
-                if (dfBandDensity < BAND_DENSITY_THRESHOLD)
-                    continue;
-
-                if (poWK->bApplyVerticalShift)
-                {
-                    if (!std::isfinite(padfZ[iDstX]))
-                        continue;
-                    // Subtract padfZ[] since the coordinate transformation is
-                    // from target to source
-                    dfValueReal =
-                        dfValueReal * poWK->dfMultFactorVerticalShift -
-                        padfZ[iDstX] * dfMultFactorVerticalShiftPipeline;
+                    bHasFoundDensity = true;
+                    GWKSetPixelValue(poWK, iBand, iDstOffset, 1.0, dfValue,
+                                     0.0);
                 }
 
-                bHasFoundDensity = true;
-
-                /* --------------------------------------------------------------------
-                 */
-                /*      We have a computed value from the source.  Now apply it
-                 * to      */
-                /*      the destination pixel. */
-                /* --------------------------------------------------------------------
-                 */
-                GWKSetPixelValueReal(poWK, iBand, iDstOffset, dfBandDensity,
-                                     dfValueReal);
-            }
-
-            if (!bHasFoundDensity)
-                continue;
+                if (!bHasFoundDensity)
+                    continue;
 
-            /* --------------------------------------------------------------------
-             */
-            /*      Update destination density/validity masks. */
-            /* --------------------------------------------------------------------
-             */
-            GWKOverlayDensity(poWK, iDstOffset, dfDensity);
+                /* -------------------------------------------------------- */
+                /*      Update destination density/validity masks.          */
+                /* -------------------------------------------------------- */
+                GWKOverlayDensity(poWK, iDstOffset, 1.0);
 
-            if (poWK->panDstValid != nullptr)
-            {
-                CPLMaskSet(poWK->panDstValid, iDstOffset);
+                if (poWK->panDstValid != nullptr)
+                {
+                    CPLMaskSet(poWK->panDstValid, iDstOffset);
+                }
             }
-        }  // Next iDstX.
+        }
 
-        /* --------------------------------------------------------------------
-         */
-        /*      Report progress to the user, and optionally cancel out. */
-        /* --------------------------------------------------------------------
-         */
+        /* ---------------------------------------------------------------- */
+        /*      Report progress to the user, and optionally cancel out.     */
+        /* ---------------------------------------------------------------- */
         if (psJob->pfnProgress && psJob->pfnProgress(psJob))
             break;
     }
-
-    /* -------------------------------------------------------------------- */
-    /*      Cleanup and return.                                             */
-    /* -------------------------------------------------------------------- */
-    CPLFree(padfX);
-    CPLFree(padfY);
-    CPLFree(padfZ);
-    CPLFree(pabSuccess);
-    if (psWrkStruct)
-        GWKResampleDeleteWrkStruct(psWrkStruct);
 }
 
-static CPLErr GWKRealCase(GDALWarpKernel *poWK)
+/************************************************************************/
+/*                    GWKSeparableAreaResample()                        */
+/************************************************************************/
+
+static CPLErr GWKSeparableAreaResample(GDALWarpKernel *poWK)
 {
-    return GWKRun(poWK, "GWKRealCase", GWKRealCaseThread);
+    switch (poWK->eWorkingDataType)
+    {
+        case GDT_Byte:
+            return GWKRun(poWK, "GWKSeparableAreaResample",
+                          GWKSeparableAreaResampleThread<GByte>);
+        case GDT_Int16:
+            return GWKRun(poWK, "GWKSeparableAreaResample",
+                          GWKSeparableAreaResampleThread<GInt16>);
+        case GDT_UInt16:
+            return GWKRun(poWK, "GWKSeparableAreaResample",
+                          GWKSeparableAreaResampleThread<GUInt16>);
+        case GDT_Float32:
+            return GWKRun(poWK, "GWKSeparableAreaResample",
+                          GWKSeparableAreaResampleThread<float>);
+        case GDT_Float64:
+            return GWKRun(poWK, "GWKSeparableAreaResample",
+                          GWKSeparableAreaResampleThread<double>);
+        default:
+            break;
+    }
+    CPLAssert(false);
+    return CE_Failure;
 }
 
 /************************************************************************/
@@ -6534,6 +8089,10 @@ static void GWKAverageOrModeThread(void *pData)
     int nBinsOffset = 0;
     const GWKTieStrategy eTieStrategy = poWK->eTieStrategy;
 
+    // Only used for GWKAOM_Imode: bins of pafCounts[] that have been set
+    // since it was last cleared.
+    std::vector<int> anModeUsedBins;
+
     // Only used with nAlgo = 6.
     float quant = 0.5;
 
@@ -6581,7 +8140,7 @@ static void GWKAverageOrModeThread(void *pData)
                 nBins = 65536;
             }
             pafCounts =
-                static_cast<float *>(VSI_MALLOC_VERBOSE(nBins * sizeof(float)));
+                static_cast<float *>(VSI_CALLOC_VERBOSE(nBins, sizeof(float)));
             if (pafCounts == nullptr)
                 return;
         }
@@ -7354,7 +8913,20 @@ static void GWKAverageOrModeThread(void *pData)
                         int nMode = -1;
                         bool bHasSourceValues = false;
 
-                        memset(pafCounts, 0, nBins * sizeof(float));
+                        // Only reset the bins used by the previous pixel,
+                        // unless there are many of them. This matters for
+                        // Int16 and UInt16, which have 65536 bins.
+                        if (anModeUsedBins.size() >
+                            static_cast<size_t>(nBins / 4))
+                        {
+                            memset(pafCounts, 0, nBins * sizeof(float));
+                        }
+                        else
+                        {
+                            for (const int iBin : anModeUsedBins)
+                                pafCounts[iBin] = 0;
+                        }
+                        anModeUsedBins.clear();
 
                         for (int iSrcY = iSrcYMin; iSrcY < iSrcYMax; iSrcY++)
                         {
@@ -7389,6 +8961,8 @@ static void GWKAverageOrModeThread(void *pData)
                                         COMPUTE_WEIGHT(iSrcX, dfWeightY);
 
                                     // Sum the density.
+                                    if (pafCounts[iBin] == 0)
+                                        anModeUsedBins.push_back(iBin);
                                     pafCounts[iBin] +=
                                         static_cast<float>(dfWeight);
                                     // Is it the most common value so far?
@@ -22,10 +22,13 @@
 #include <cstring>
 
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <limits>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <vector>
 
 #include "cpl_config.h"
 #include "cpl_conv.h"
@@ -35,9 +38,11 @@
 #include "cpl_multiproc.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 #include "gdal_priv.h"
 #include "gdal_alg_priv.h"
+#include "gdal_thread_pool.h"
 #include "ogr_api.h"
 #include "ogr_core.h"
 
@@ -174,12 +179,6 @@ GDALWarpOperation::~GDALWarpOperation()
 
     WipeOptions();
 
-    if (hIOMutex != nullptr)
-    {
-        CPLDestroyMutex(hIOMutex);
-        CPLDestroyMutex(hWarpMutex);
-    }
-
     WipeChunkList();
     if (psThreadData)
         GWKThreadsEnd(psThreadData);
@@ -203,6 +202,7 @@ const GDALWarpOptions *GDALWarpOperation::GetOptions()
 void GDALWarpOperation::WipeOptions()
 
 {
+    m_psTransformationGridArg.reset();
     if (psOptions != nullptr)
     {
         GDALDestroyWarpOptions(psOptions);
@@ -210,6 +210,82 @@ void GDALWarpOperation::WipeOptions()
     }
 }
 
+/************************************************************************/
+/*                    GetTransformer() / GetTransformerArg()            */
+/************************************************************************/
+
+/** Return the transformer to use for target to source transformations:
+ * the transformation grid one if set, or the one of the warp options. */
+GDALTransformerFunc GDALWarpOperation::GetTransformer() const
+{
+    return m_psTransformationGridArg ? GDALTransformationGridTransform
+                                     : psOptions->pfnTransformer;
+}
+
+void *GDALWarpOperation::GetTransformerArg() const
+{
+    return m_psTransformationGridArg ? m_psTransformationGridArg.get()
+                                     : psOptions->pTransformerArg;
+}
+
+/************************************************************************/
+/*                      CreateTransformationGrid()                      */
+/************************************************************************/
+
+/** Create the transformation grid transformer, if requested by the
+ * TRANSFORMATION_GRID warp option and useful for the current transformer. */
+CPLErr GDALWarpOperation::CreateTransformationGrid()
+{
+    const char *pszGrid =
+        CSLFetchNameValue(psOptions->papszWarpOptions, "TRANSFORMATION_GRID");
+    if (pszGrid == nullptr || EQUAL(pszGrid, "NO") ||
+        psOptions->hDstDS == nullptr || psOptions->pTransformerArg == nullptr)
+    {
+        return CE_None;
+    }
+
+    // Affine transformations are already cheap to evaluate.
+    if (m_bIsTranslationOnPixelBoundaries ||
+        GDALTransformIsAffineNoRotation(psOptions->pfnTransformer,
+                                        psOptions->pTransformerArg))
+    {
+        CPLDebug("WARP", "Transformation grid not used for an affine "
+                         "transformation");
+        return CE_None;
+    }
+
+    CPLStringList aosOptions;
+    if (!EQUAL(pszGrid, "MEM") && !EQUAL(pszGrid, "YES"))
+        aosOptions.SetNameValue("FILENAME", pszGrid);
+    if (const char *pszStep = CSLFetchNameValue(psOptions->papszWarpOptions,
+                                                "TRANSFORMATION_GRID_STEP"))
+    {
+        aosOptions.SetNameValue("STEP", pszStep);
+    }
+    if (!GDALIsTransformer(psOptions->pTransformerArg,
+                           GDAL_APPROX_TRANSFORMER_CLASS_NAME))
+    {
+        if (const char *pszErrorThreshold = CSLFetchNameValue(
+                psOptions->papszWarpOptions, "ERROR_THRESHOLD"))
+        {
+            aosOptions.SetNameValue("ERROR_THRESHOLD", pszErrorThreshold);
+        }
+    }
+    aosOptions.SetNameValue(
+        "CHECK_TRANSFORMER",
+        CSLFetchNameValueDef(psOptions->papszWarpOptions,
+                             "TRANSFORMATION_GRID_CHECK_TRANSFORMER", "YES"));
+
+    CPLErrorReset();
+    m_psTransformationGridArg.reset(GDALCreateTransformationGridTransformer(
+        psOptions->pfnTransformer, psOptions->pTransformerArg,
+        GDALGetRasterXSize(psOptions->hDstDS),
+        GDALGetRasterYSize(psOptions->hDstDS), aosOptions.List()));
+    if (!m_psTransformationGridArg && CPLGetLastErrorType() == CE_Failure)
+        return CE_Failure;
+    return CE_None;
+}
+
 /************************************************************************/
 /*                          ValidateOptions()                           */
 /************************************************************************/
@@ -668,12 +744,6 @@ GDALWarpOperation::Initialize(const GDALWarpOptions *psNewOptions,
     }
     else
     {
-        psThreadData = GWKThreadsCreate(psOptions->papszWarpOptions,
-                                        psOptions->pfnTransformer,
-                                        psOptions->pTransformerArg);
-        if (psThreadData == nullptr)
-            eErr = CE_Failure;
-
         /* --------------------------------------------------------------------
          */
         /*      Compute dstcoordinates of a few special points. */
@@ -709,6 +779,17 @@ GDALWarpOperation::Initialize(const GDALWarpOptions *psNewOptions,
             CPLDebug("WARP",
                      "Using translation-on-pixel-boundaries optimization");
         }
+
+        eErr = CreateTransformationGrid();
+
+        if (eErr == CE_None)
+        {
+            psThreadData = GWKThreadsCreate(psOptions->papszWarpOptions,
+                                            GetTransformer(),
+                                            GetTransformerArg());
+            if (psThreadData == nullptr)
+                eErr = CE_Failure;
+        }
     }
 
     return eErr;
@@ -928,14 +1009,16 @@ void GDALDestroyWarpOperation(GDALWarpOperationH hOperation)
 /************************************************************************/
 
 void GDALWarpOperation::CollectChunkList(int nDstXOff, int nDstYOff,
-                                         int nDstXSize, int nDstYSize)
+                                         int nDstXSize, int nDstYSize,
+                                         double dfChunkMemoryLimit)
 
 {
     /* -------------------------------------------------------------------- */
     /*      Collect the list of chunks to operate on.                       */
     /* -------------------------------------------------------------------- */
     WipeChunkList();
-    CollectChunkListInternal(nDstXOff, nDstYOff, nDstXSize, nDstYSize);
+    CollectChunkListInternal(nDstXOff, nDstYOff, nDstXSize, nDstYSize,
+                             dfChunkMemoryLimit);
 
     // Sort chunks from top to bottom, and for equal y, from left to right.
     if (nChunkListCount > 1)
@@ -1023,7 +1106,8 @@ CPLErr GDALWarpOperation::ChunkAndWarpImage(int nDstXOff, int nDstYOff,
     /* -------------------------------------------------------------------- */
     /*      Collect the list of chunks to operate on.                       */
     /* -------------------------------------------------------------------- */
-    CollectChunkList(nDstXOff, nDstYOff, nDstXSize, nDstYSize);
+    CollectChunkList(nDstXOff, nDstYOff, nDstXSize, nDstYSize,
+                     psOptions->dfWarpMemoryLimit);
 
     /* -------------------------------------------------------------------- */
     /*      Total up output pixels to process.                              */
@@ -1093,71 +1177,224 @@ CPLErr GDALChunkAndWarpImage(GDALWarpOperationH hOperation, int nDstXOff,
 }
 
 /************************************************************************/
-/*                          ChunkThreadMain()                           */
+/*                          GDALWarpPipeline                            */
 /************************************************************************/
 
-struct ChunkThreadData
+// Warp kernel execution context. Each slot has its own kernel thread data and
+// transformer, so that chunks using different slots can be warped
+// concurrently.
+struct GDALWarpKernelSlot
 {
-    GDALWarpOperation *poOperation = nullptr;
-    GDALWarpChunk *pasChunkInfo = nullptr;
-    CPLJoinableThread *hThreadHandle = nullptr;
-    CPLErr eErr = CE_None;
-    double dfProgressBase = 0;
-    double dfProgressScale = 0;
-    CPLMutex *hIOMutex = nullptr;
+    void *psThreadData = nullptr;
+    void *pTransformerArg = nullptr;
+    // Whether psThreadData and pTransformerArg are owned by the slot, or
+    // are the ones of the GDALWarpOperation.
+    bool bOwned = false;
+};
 
-    CPLMutex *hCondMutex = nullptr;
-    volatile int bIOMutexTaken = 0;
-    CPLCond *hCond = nullptr;
+// State shared by the chunks in flight in ChunkAndWarpMulti()
+struct GDALWarpPipeline
+{
+    // Serializes accesses to the source dataset, unless it is thread-safe.
+    bool bLockSrc = true;
+    std::mutex oSrcMutex{};
 
-    CPLErrorAccumulator *poErrorAccumulator = nullptr;
-};
+    // Serializes accesses to the destination dataset. Points to oSrcMutex
+    // when the source and destination datasets may share their storage.
+    std::mutex oDstMutex{};
+    std::mutex *poDstMutex = &oDstMutex;
 
-static void ChunkThreadMain(void *pThreadData)
+    // Serializes uses of GDALWarpOptions::pTransformerArg
+    std::mutex oTransformerMutex{};
 
-{
-    volatile ChunkThreadData *psData =
-        static_cast<volatile ChunkThreadData *>(pThreadData);
+    std::mutex oKernelMutex{};
+    std::condition_variable oKernelCond{};
+    std::vector<GDALWarpKernelSlot> aoKernelSlots{};
+    std::vector<size_t> anFreeKernelSlots{};
 
-    GDALWarpChunk *pasChunkInfo = psData->pasChunkInfo;
+    bool bOrderedWrites = true;
+    std::mutex oWriteMutex{};
+    std::condition_variable oWriteCond{};
+    int iNextChunkToWrite = 0;
 
-    /* -------------------------------------------------------------------- */
-    /*      Acquire IO mutex.                                               */
-    /* -------------------------------------------------------------------- */
-    if (!CPLAcquireMutex(psData->hIOMutex, 600.0))
+    std::mutex oProgressMutex{};
+    GDALProgressFunc pfnProgress = nullptr;
+    void *pProgressArg = nullptr;
+    double dfProgress = 0;
+    bool bStop = false;
+
+    std::atomic<bool> bFailed{false};
+
+    std::unique_lock<std::mutex> LockSrc()
     {
-        CPLError(CE_Failure, CPLE_AppDefined,
-                 "Failed to acquire IOMutex in WarpRegion().");
-        psData->eErr = CE_Failure;
+        return bLockSrc ? std::unique_lock<std::mutex>(oSrcMutex)
+                        : std::unique_lock<std::mutex>();
     }
-    else
+
+    std::unique_lock<std::mutex> LockDst()
+    {
+        return std::unique_lock<std::mutex>(*poDstMutex);
+    }
+
+    size_t AcquireKernelSlot()
+    {
+        std::unique_lock<std::mutex> oLock(oKernelMutex);
+        oKernelCond.wait(oLock, [this] { return !anFreeKernelSlots.empty(); });
+        const size_t iSlot = anFreeKernelSlots.back();
+        anFreeKernelSlots.pop_back();
+        return iSlot;
+    }
+
+    void ReleaseKernelSlot(size_t iSlot)
     {
-        if (psData->hCond != nullptr)
         {
-            CPLAcquireMutex(psData->hCondMutex, 1.0);
-            psData->bIOMutexTaken = TRUE;
-            CPLCondSignal(psData->hCond);
-            CPLReleaseMutex(psData->hCondMutex);
+            std::lock_guard<std::mutex> oLock(oKernelMutex);
+            anFreeKernelSlots.push_back(iSlot);
         }
+        oKernelCond.notify_one();
+    }
 
-        auto oAccumulator =
-            psData->poErrorAccumulator->InstallForCurrentScope();
-        CPL_IGNORE_RET_VAL(oAccumulator);
+    // When writes are ordered, wait for all previous chunks to be written.
+    void WaitForWriteTurn(int iChunk)
+    {
+        if (bOrderedWrites)
+        {
+            std::unique_lock<std::mutex> oLock(oWriteMutex);
+            oWriteCond.wait(oLock,
+                            [this, iChunk]
+                            { return iNextChunkToWrite >= iChunk; });
+        }
+    }
 
-        psData->eErr = psData->poOperation->WarpRegion(
-            pasChunkInfo->dx, pasChunkInfo->dy, pasChunkInfo->dsx,
-            pasChunkInfo->dsy, pasChunkInfo->sx, pasChunkInfo->sy,
-            pasChunkInfo->ssx, pasChunkInfo->ssy, pasChunkInfo->sExtraSx,
-            pasChunkInfo->sExtraSy, psData->dfProgressBase,
-            psData->dfProgressScale);
+    void SetChunkWritten(int iChunk)
+    {
+        if (bOrderedWrites)
+        {
+            {
+                std::lock_guard<std::mutex> oLock(oWriteMutex);
+                if (iNextChunkToWrite == iChunk)
+                    iNextChunkToWrite = iChunk + 1;
+            }
+            oWriteCond.notify_all();
+        }
+    }
 
-        /* --------------------------------------------------------------------
-         */
-        /*      Release the IO mutex. */
-        /* --------------------------------------------------------------------
-         */
-        CPLReleaseMutex(psData->hIOMutex);
+    bool Progress(GDALWarpPipelineJob *psJob, double dfComplete);
+};
+
+struct GDALWarpPipelineJob
+{
+    GDALWarpPipeline *poPipeline = nullptr;
+    const GDALWarpChunk *psChunk = nullptr;
+    int iChunk = 0;
+    int nChunkCount = 0;
+    // Share of this chunk in the total progress
+    double dfProgressScale = 0;
+    // Last progress reported for this chunk, in [0,1]
+    double dfLastProgress = 0;
+    CPLErr eErr = CE_None;
+};
+
+/************************************************************************/
+/*                     GDALWarpPipeline::Progress()                     */
+/************************************************************************/
+
+// Chunks report their progress from different threads, and in any order:
+// accumulate their contributions and forward the total to the user callback,
+// which is thus never called concurrently.
+bool GDALWarpPipeline::Progress(GDALWarpPipelineJob *psJob, double dfComplete)
+{
+    std::lock_guard<std::mutex> oLock(oProgressMutex);
+    if (bStop)
+        return false;
+    dfProgress += (dfComplete - psJob->dfLastProgress) * psJob->dfProgressScale;
+    psJob->dfLastProgress = dfComplete;
+    if (!pfnProgress(std::min(dfProgress, 1.0), "", pProgressArg))
+        bStop = true;
+    return !bStop;
+}
+
+static int CPL_STDCALL GDALWarpPipelineProgress(double dfComplete,
+                                                const char *, void *pData)
+{
+    auto psJob = static_cast<GDALWarpPipelineJob *>(pData);
+    return psJob->poPipeline->Progress(psJob, dfComplete);
+}
+
+/************************************************************************/
+/*                     GDALWarpDatasetsMayAlias()                       */
+/************************************************************************/
+
+// Whether reading the source dataset may see, or interfere with, writes to
+// the destination dataset, in which case they must share a single lock. This
+// is assumed when they are the same dataset, when they have common files
+// (e.g. a VRT source referencing the destination file, or the destination
+// file opened twice), or when neither has a file, as MEM datasets may share
+// their buffers.
+static bool GDALWarpDatasetsMayAlias(GDALDataset *poSrcDS,
+                                     GDALDataset *poDstDS)
+{
+    if (poSrcDS == poDstDS)
+        return true;
+
+    const CPLStringList aosSrcFiles(poSrcDS->GetFileList());
+    const CPLStringList aosDstFiles(poDstDS->GetFileList());
+    if (aosSrcFiles.empty() && aosDstFiles.empty())
+        return true;
+    for (const char *pszSrcFile : aosSrcFiles)
+    {
+        VSIStatBufL sSrcStat;
+        const bool bSrcStat = VSIStatL(pszSrcFile, &sSrcStat) == 0;
+        for (const char *pszDstFile : aosDstFiles)
+        {
+            if (EQUAL(pszSrcFile, pszDstFile))
+                return true;
+            // Compare inodes to catch different paths to the same file
+            VSIStatBufL sDstStat;
+            if (bSrcStat && sSrcStat.st_ino != 0 &&
+                VSIStatL(pszDstFile, &sDstStat) == 0 &&
+                sSrcStat.st_dev == sDstStat.st_dev &&
+                sSrcStat.st_ino == sDstStat.st_ino)
+            {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/************************************************************************/
+/*                         WarpPipelineChunk()                          */
+/************************************************************************/
+
+void GDALWarpOperation::WarpPipelineChunk(GDALWarpPipelineJob *psJob)
+{
+    GDALWarpPipeline *poPipeline = psJob->poPipeline;
+    const GDALWarpChunk *psChunk = psJob->psChunk;
+
+    if (!poPipeline->bFailed)
+    {
+        CPLDebug("GDAL", "Start chunk %d / %d.", psJob->iChunk,
+                 psJob->nChunkCount);
+        psJob->eErr = WarpRegionInternal(
+            psChunk->dx, psChunk->dy, psChunk->dsx, psChunk->dsy, psChunk->sx,
+            psChunk->sy, psChunk->ssx, psChunk->ssy, psChunk->sExtraSx,
+            psChunk->sExtraSy, 0.0, 1.0, psJob);
+        if (psJob->eErr == CE_None && !poPipeline->Progress(psJob, 1.0))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            psJob->eErr = CE_Failure;
+        }
+        if (psJob->eErr != CE_None)
+            poPipeline->bFailed = true;
+        CPLDebug("GDAL", "Finished chunk %d / %d.", psJob->iChunk,
+                 psJob->nChunkCount);
     }
+
+    // If the chunk failed before being written, make sure that the following
+    // ones do not wait for it forever.
+    poPipeline->WaitForWriteTurn(psJob->iChunk);
+    poPipeline->SetChunkWritten(psJob->iChunk);
 }
 
 /************************************************************************/
@@ -1173,8 +1410,20 @@ static void ChunkThreadMain(void *pThreadData)
  * Progress is reported to the installed progress monitor, if any.
  *
  * Externally this method operates the same as ChunkAndWarpImage(), but
- * internally this method uses multiple threads to interleave input/output
- * for one region while the processing is being done for another.
+ * internally this method processes several chunks concurrently, as a
+ * pipeline: while the warp kernel runs on one chunk, the source data of the
+ * next ones is read and the result of the previous ones is written.
+ *
+ * The number of chunks in flight is controlled by the PIPELINE_DEPTH warp
+ * option (2 by default). When it is explicitly set, the warp memory limit
+ * is shared among the chunks in flight. Reads of the source dataset are
+ * done in parallel when it is thread-safe, or, if PIPELINE_DEPTH is greater
+ * than 2, when a thread-safe instance of it can be obtained with
+ * GDALGetThreadSafeDataset(). Accesses to the destination dataset are
+ * serialized, and done in the order of chunks unless the
+ * PIPELINE_ORDERED_WRITES warp option is set to NO. When the source and
+ * destination datasets may share their storage (same dataset, common files,
+ * or in-memory datasets), a single lock serializes all their accesses.
  *
  * @param nDstXOff X offset to window of destination data to be produced.
  * @param nDstYOff Y offset to window of destination data to be produced.
@@ -1188,133 +1437,216 @@ CPLErr GDALWarpOperation::ChunkAndWarpMulti(int nDstXOff, int nDstYOff,
                                             int nDstXSize, int nDstYSize)
 
 {
-    hIOMutex = CPLCreateMutex();
-    hWarpMutex = CPLCreateMutex();
-
-    CPLReleaseMutex(hIOMutex);
-    CPLReleaseMutex(hWarpMutex);
-
-    CPLCond *hCond = CPLCreateCond();
-    CPLMutex *hCondMutex = CPLCreateMutex();
-    CPLReleaseMutex(hCondMutex);
+    const char *pszPipelineDepth =
+        CSLFetchNameValue(psOptions->papszWarpOptions, "PIPELINE_DEPTH");
+    int nPipelineDepth = 2;
+    if (pszPipelineDepth)
+    {
+        nPipelineDepth = EQUAL(pszPipelineDepth, "ALL_CPUS")
+                             ? CPLGetNumCPUs()
+                             : atoi(pszPipelineDepth);
+        nPipelineDepth = std::clamp(nPipelineDepth, 1, 128);
+    }
 
     /* -------------------------------------------------------------------- */
-    /*      Collect the list of chunks to operate on.                       */
+    /*      Collect the list of chunks to operate on. When the pipeline     */
+    /*      depth is explicitly set, the memory limit applies to all        */
+    /*      chunks in flight.                                               */
     /* -------------------------------------------------------------------- */
-    CollectChunkList(nDstXOff, nDstYOff, nDstXSize, nDstYSize);
+    CollectChunkList(nDstXOff, nDstYOff, nDstXSize, nDstYSize,
+                     pszPipelineDepth
+                         ? psOptions->dfWarpMemoryLimit / nPipelineDepth
+                         : psOptions->dfWarpMemoryLimit);
 
-    /* -------------------------------------------------------------------- */
-    /*      Process them one at a time, updating the progress               */
-    /*      information for each region.                                    */
-    /* -------------------------------------------------------------------- */
-    ChunkThreadData volatile asThreadData[2] = {};
-    CPLErrorAccumulator oErrorAccumulator;
-    for (int i = 0; i < 2; ++i)
+    CPLWorkerThreadPool oThreadPool;
+    if (!oThreadPool.Setup(nPipelineDepth, nullptr, nullptr))
     {
-        asThreadData[i].poOperation = this;
-        asThreadData[i].hIOMutex = hIOMutex;
-        asThreadData[i].poErrorAccumulator = &oErrorAccumulator;
+        WipeChunkList();
+        return CE_Failure;
     }
 
-    double dfPixelsProcessed = 0.0;
-    double dfTotalPixels = static_cast<double>(nDstXSize) * nDstYSize;
+    GDALWarpPipeline oPipeline;
+    oPipeline.pfnProgress = psOptions->pfnProgress;
+    oPipeline.pProgressArg = psOptions->pProgressArg;
+    oPipeline.bOrderedWrites =
+        CPLFetchBool(psOptions->papszWarpOptions, "PIPELINE_ORDERED_WRITES",
+                     true) ||
+        CPLFetchBool(psOptions->papszWarpOptions, "STREAMABLE_OUTPUT", false);
 
-    CPLErr eErr = CE_None;
-    for (int iChunk = 0; iChunk < nChunkListCount + 1; iChunk++)
+    /* -------------------------------------------------------------------- */
+    /*      Determine whether the source dataset can be read concurrently.  */
+    /* -------------------------------------------------------------------- */
+    GDALDatasetH hSrcDSBackup = psOptions->hSrcDS;
+    GDALDataset *poSrcDS = GDALDataset::FromHandle(psOptions->hSrcDS);
+    GDALDataset *poThreadSafeSrcDS = nullptr;
+    if (GDALWarpDatasetsMayAlias(
+            poSrcDS, GDALDataset::FromHandle(psOptions->hDstDS)))
     {
-        int iThread = iChunk % 2;
-
-        /* --------------------------------------------------------------------
-         */
-        /*      Launch thread for this chunk. */
-        /* --------------------------------------------------------------------
-         */
-        if (pasChunkList != nullptr && iChunk < nChunkListCount)
+        CPLDebug("WARP", "Source and destination datasets may share their "
+                         "storage. Using a single I/O lock");
+        oPipeline.poDstMutex = &oPipeline.oSrcMutex;
+    }
+    else if (poSrcDS->IsThreadSafe(GDAL_OF_RASTER))
+    {
+        oPipeline.bLockSrc = false;
+    }
+    else if (nPipelineDepth > 2 &&
+             // Datasets opened in update mode may have pending changes that
+             // would not be seen by their re-opened instances. MEM datasets
+             // are cloned by sharing their memory buffers.
+             (poSrcDS->GetAccess() == GA_ReadOnly ||
+              EQUAL(poSrcDS->GetDriverName(), "MEM")))
+    {
+        CPLErrorStateBackuper oBackuper(CPLQuietErrorHandler);
+        poThreadSafeSrcDS = GDALGetThreadSafeDataset(poSrcDS, GDAL_OF_RASTER);
+        if (poThreadSafeSrcDS)
         {
-            GDALWarpChunk *pasThisChunk = pasChunkList + iChunk;
-            const double dfChunkPixels =
-                pasThisChunk->dsx * static_cast<double>(pasThisChunk->dsy);
-
-            asThreadData[iThread].dfProgressBase =
-                dfPixelsProcessed / dfTotalPixels;
-            asThreadData[iThread].dfProgressScale =
-                dfChunkPixels / dfTotalPixels;
-
-            dfPixelsProcessed += dfChunkPixels;
-
-            asThreadData[iThread].pasChunkInfo = pasThisChunk;
+            psOptions->hSrcDS = GDALDataset::ToHandle(poThreadSafeSrcDS);
+            oPipeline.bLockSrc = false;
+        }
+    }
 
-            if (iChunk == 0)
-            {
-                asThreadData[iThread].hCond = hCond;
-                asThreadData[iThread].hCondMutex = hCondMutex;
-            }
-            else
-            {
-                asThreadData[iThread].hCond = nullptr;
-                asThreadData[iThread].hCondMutex = nullptr;
-            }
-            asThreadData[iThread].bIOMutexTaken = FALSE;
+    /* -------------------------------------------------------------------- */
+    /*      Create the warp kernel slots. Chunk processors provided by the  */
+    /*      application are not assumed to be thread-safe, and transformers */
+    /*      that cannot be cloned must not be used concurrently.            */
+    /* -------------------------------------------------------------------- */
+    if (psOptions->pfnPreWarpChunkProcessor == nullptr &&
+        psOptions->pfnPostWarpChunkProcessor == nullptr &&
+        GetTransformerArg() != nullptr)
+    {
+        // The NUM_THREADS warp kernel threads are split between the slots,
+        // rather than given to each of them. They all use the global pool,
+        // sized to NUM_THREADS threads.
+        const char *pszWarpThreads =
+            CSLFetchNameValue(psOptions->papszWarpOptions, "NUM_THREADS");
+        if (pszWarpThreads == nullptr)
+            pszWarpThreads = CPLGetConfigOption("GDAL_NUM_THREADS", "1");
+        const int nWarpThreads = std::clamp(
+            EQUAL(pszWarpThreads, "ALL_CPUS") ? CPLGetNumCPUs()
+                                              : atoi(pszWarpThreads),
+            1, 128);
+        if (nWarpThreads > 1)
+            GDALGetGlobalThreadPool(nWarpThreads);
+        CPLStringList aosSlotWarpOptions(
+            CSLDuplicate(psOptions->papszWarpOptions));
+        aosSlotWarpOptions.SetNameValue(
+            "NUM_THREADS",
+            CPLSPrintf("%d", (nWarpThreads + nPipelineDepth - 1) /
+                                 nPipelineDepth));
 
-            CPLDebug("GDAL", "Start chunk %d / %d.", iChunk, nChunkListCount);
-            asThreadData[iThread].hThreadHandle = CPLCreateJoinableThread(
-                ChunkThreadMain,
-                const_cast<ChunkThreadData *>(&asThreadData[iThread]));
-            if (asThreadData[iThread].hThreadHandle == nullptr)
-            {
-                CPLError(
-                    CE_Failure, CPLE_AppDefined,
-                    "CPLCreateJoinableThread() failed in ChunkAndWarpMulti()");
-                eErr = CE_Failure;
+        CPLErrorStateBackuper oBackuper(CPLQuietErrorHandler);
+        for (int i = 0; i < nPipelineDepth; ++i)
+        {
+            GDALWarpKernelSlot oSlot;
+            oSlot.bOwned = true;
+            oSlot.pTransformerArg = GDALCloneTransformer(GetTransformerArg());
+            if (!oSlot.pTransformerArg)
                 break;
-            }
-
-            // Wait that the first thread has acquired the IO mutex before
-            // proceeding.  This will ensure that the first thread will run
-            // before the second one.
-            if (iChunk == 0)
+            oSlot.psThreadData =
+                GWKThreadsCreate(aosSlotWarpOptions.List(), GetTransformer(),
+                                 oSlot.pTransformerArg);
+            if (!oSlot.psThreadData)
             {
-                CPLAcquireMutex(hCondMutex, 1.0);
-                while (asThreadData[iThread].bIOMutexTaken == FALSE)
-                    CPLCondWait(hCond, hCondMutex);
-                CPLReleaseMutex(hCondMutex);
+                GDALDestroyTransformer(oSlot.pTransformerArg);
+                break;
             }
+            oPipeline.aoKernelSlots.push_back(oSlot);
         }
+    }
+    if (oPipeline.aoKernelSlots.empty())
+    {
+        GDALWarpKernelSlot oSlot;
+        oSlot.psThreadData = psThreadData;
+        oSlot.pTransformerArg = GetTransformerArg();
+        oPipeline.aoKernelSlots.push_back(oSlot);
+    }
+    for (size_t i = 0; i < oPipeline.aoKernelSlots.size(); ++i)
+        oPipeline.anFreeKernelSlots.push_back(i);
 
-        /* --------------------------------------------------------------------
-         */
-        /*      Wait for previous chunks thread to complete. */
-        /* --------------------------------------------------------------------
-         */
-        if (iChunk > 0)
-        {
-            iThread = (iChunk - 1) % 2;
-
-            // Wait for thread to finish.
-            CPLJoinThread(asThreadData[iThread].hThreadHandle);
-            asThreadData[iThread].hThreadHandle = nullptr;
+    CPLDebug("WARP",
+             "Pipelined warping of %d chunks with %d chunks in flight, "
+             "%s source reads and %d warp kernel(s)",
+             nChunkListCount, nPipelineDepth,
+             oPipeline.bLockSrc ? "serialized" : "concurrent",
+             static_cast<int>(oPipeline.aoKernelSlots.size()));
 
-            CPLDebug("GDAL", "Finished chunk %d / %d.", iChunk - 1,
-                     nChunkListCount);
+    /* -------------------------------------------------------------------- */
+    /*      Submit chunks, while keeping at most nPipelineDepth of them     */
+    /*      in flight. As the thread pool has as many threads, all          */
+    /*      submitted chunks run at the same time, which guarantees that    */
+    /*      waiting for the write turn of previous chunks cannot deadlock.  */
+    /* -------------------------------------------------------------------- */
+    double dfTotalPixels = 0.0;
+    for (int iChunk = 0; iChunk < nChunkListCount; iChunk++)
+    {
+        const GDALWarpChunk *pasThisChunk = pasChunkList + iChunk;
+        dfTotalPixels +=
+            pasThisChunk->dsx * static_cast<double>(pasThisChunk->dsy);
+    }
 
-            eErr = asThreadData[iThread].eErr;
+    std::vector<GDALWarpPipelineJob> asJobs(nChunkListCount);
+    CPLErrorAccumulator oErrorAccumulator;
+    auto poJobQueue = oThreadPool.CreateJobQueue();
+    for (int iChunk = 0; iChunk < nChunkListCount; iChunk++)
+    {
+        poJobQueue->WaitCompletion(nPipelineDepth - 1);
+        if (oPipeline.bFailed)
+            break;
+
+        GDALWarpPipelineJob *psJob = &asJobs[iChunk];
+        psJob->poPipeline = &oPipeline;
+        psJob->psChunk = pasChunkList + iChunk;
+        psJob->iChunk = iChunk;
+        psJob->nChunkCount = nChunkListCount;
+        psJob->dfProgressScale =
+            psJob->psChunk->dsx * static_cast<double>(psJob->psChunk->dsy) /
+            dfTotalPixels;
+
+        if (!poJobQueue->SubmitJob(
+                [this, psJob, &oErrorAccumulator]()
+                {
+                    auto oAccumulator =
+                        oErrorAccumulator.InstallForCurrentScope();
+                    CPL_IGNORE_RET_VAL(oAccumulator);
+                    WarpPipelineChunk(psJob);
+                }))
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Cannot submit job in ChunkAndWarpMulti()");
+            oPipeline.bFailed = true;
+            break;
+        }
+    }
+    poJobQueue->WaitCompletion();
 
-            if (eErr != CE_None)
-                break;
+    CPLErr eErr = oPipeline.bFailed ? CE_Failure : CE_None;
+    for (const auto &sJob : asJobs)
+    {
+        if (sJob.eErr != CE_None)
+        {
+            eErr = sJob.eErr;
+            break;
         }
     }
 
     /* -------------------------------------------------------------------- */
-    /*      Wait for all threads to complete.                               */
+    /*      Cleanup.                                                        */
     /* -------------------------------------------------------------------- */
-    for (int iThread = 0; iThread < 2; iThread++)
+    for (const auto &oSlot : oPipeline.aoKernelSlots)
     {
-        if (asThreadData[iThread].hThreadHandle)
-            CPLJoinThread(asThreadData[iThread].hThreadHandle);
+        if (oSlot.bOwned)
+        {
+            GWKThreadsEnd(oSlot.psThreadData);
+            GDALDestroyTransformer(oSlot.pTransformerArg);
+        }
     }
 
-    CPLDestroyCond(hCond);
-    CPLDestroyMutex(hCondMutex);
+    if (poThreadSafeSrcDS)
+    {
+        psOptions->hSrcDS = hSrcDSBackup;
+        poThreadSafeSrcDS->ReleaseRef();
+    }
 
     WipeChunkList();
 
@@ -1426,7 +1758,8 @@ double GDALWarpOperation::GetWorkingMemoryForWindow(int nSrcXSize,
 /************************************************************************/
 
 CPLErr GDALWarpOperation::CollectChunkListInternal(int nDstXOff, int nDstYOff,
-                                                   int nDstXSize, int nDstYSize)
+                                                   int nDstXSize, int nDstYSize,
+                                                   double dfChunkMemoryLimit)
 
 {
     /* -------------------------------------------------------------------- */
@@ -1500,7 +1833,7 @@ CPLErr GDALWarpOperation::CollectChunkListInternal(int nDstXOff, int nDstYOff,
              nSrcXSize, nSrcYSize, dfSrcFillRatio,
              dfTotalMemoryUse / (1024 * 1024));
 #endif
-    if ((dfTotalMemoryUse > psOptions->dfWarpMemoryLimit &&
+    if ((dfTotalMemoryUse > dfChunkMemoryLimit &&
          (nDstXSize > 2 || nDstYSize > 2)) ||
         (dfSrcFillRatio > 0 && dfSrcFillRatio < 0.5 &&
          (nDstXSize > 100 || nDstYSize > 100) &&
@@ -1562,10 +1895,11 @@ CPLErr GDALWarpOperation::CollectChunkListInternal(int nDstXOff, int nDstYOff,
             int nChunk2 = nDstXSize - nChunk1;
 
             eErr = CollectChunkListInternal(nDstXOff, nDstYOff, nChunk1,
-                                            nDstYSize);
+                                            nDstYSize, dfChunkMemoryLimit);
 
             eErr2 = CollectChunkListInternal(nDstXOff + nChunk1, nDstYOff,
-                                             nChunk2, nDstYSize);
+                                             nChunk2, nDstYSize,
+                                             dfChunkMemoryLimit);
         }
         else if (!(bStreamableOutput && nDstYSize / 2 < nBlockYSize))
         {
@@ -1580,10 +1914,11 @@ CPLErr GDALWarpOperation::CollectChunkListInternal(int nDstXOff, int nDstYOff,
             const int nChunk2 = nDstYSize - nChunk1;
 
             eErr = CollectChunkListInternal(nDstXOff, nDstYOff, nDstXSize,
-                                            nChunk1);
+                                            nChunk1, dfChunkMemoryLimit);
 
             eErr2 = CollectChunkListInternal(nDstXOff, nDstYOff + nChunk1,
-                                             nDstXSize, nChunk2);
+                                             nDstXSize, nChunk2,
+                                             dfChunkMemoryLimit);
         }
 
         if (bHasDivided)
@@ -1704,6 +2039,28 @@ CPLErr GDALWarpOperation::WarpRegion(
     double dfSrcYExtraSize, double dfProgressBase, double dfProgressScale)
 
 {
+    return WarpRegionInternal(nDstXOff, nDstYOff, nDstXSize, nDstYSize,
+                              nSrcXOff, nSrcYOff, nSrcXSize, nSrcYSize,
+                              dfSrcXExtraSize, dfSrcYExtraSize, dfProgressBase,
+                              dfProgressScale, nullptr);
+}
+
+/************************************************************************/
+/*                         WarpRegionInternal()                         */
+/************************************************************************/
+
+// psJob is set when called from ChunkAndWarpMulti(), in which case accesses
+// to the datasets are synchronized with the other chunks in flight.
+
+CPLErr GDALWarpOperation::WarpRegionInternal(
+    int nDstXOff, int nDstYOff, int nDstXSize, int nDstYSize, int nSrcXOff,
+    int nSrcYOff, int nSrcXSize, int nSrcYSize, double dfSrcXExtraSize,
+    double dfSrcYExtraSize, double dfProgressBase, double dfProgressScale,
+    GDALWarpPipelineJob *psJob)
+
+{
+    GDALWarpPipeline *poPipeline = psJob ? psJob->poPipeline : nullptr;
+
     ReportTiming(nullptr);
 
     /* -------------------------------------------------------------------- */
@@ -1724,6 +2081,8 @@ CPLErr GDALWarpOperation::WarpRegion(
     GDALDataset *poDstDS = GDALDataset::FromHandle(psOptions->hDstDS);
     if (!bDstBufferInitialized)
     {
+        auto oDstLock = poPipeline ? poPipeline->LockDst()
+                                   : std::unique_lock<std::mutex>();
         CPLErr eErr = CE_None;
         if (psOptions->nBandCount == 1)
         {
@@ -1755,19 +2114,26 @@ CPLErr GDALWarpOperation::WarpRegion(
     /* -------------------------------------------------------------------- */
     /*      Perform the warp.                                               */
     /* -------------------------------------------------------------------- */
-    CPLErr eErr = nSrcXSize == 0
-                      ? CE_None
-                      : WarpRegionToBuffer(
-                            nDstXOff, nDstYOff, nDstXSize, nDstYSize,
-                            pDstBuffer, psOptions->eWorkingDataType, nSrcXOff,
-                            nSrcYOff, nSrcXSize, nSrcYSize, dfSrcXExtraSize,
-                            dfSrcYExtraSize, dfProgressBase, dfProgressScale);
+    CPLErr eErr =
+        nSrcXSize == 0
+            ? CE_None
+            : WarpRegionToBufferInternal(
+                  nDstXOff, nDstYOff, nDstXSize, nDstYSize, pDstBuffer,
+                  nSrcXOff, nSrcYOff, nSrcXSize, nSrcYSize, dfSrcXExtraSize,
+                  dfSrcYExtraSize, dfProgressBase, dfProgressScale, psJob);
 
     /* -------------------------------------------------------------------- */
     /*      Write the output data back to disk if all went well.            */
     /* -------------------------------------------------------------------- */
     if (eErr == CE_None)
     {
+        std::unique_lock<std::mutex> oDstLock;
+        if (poPipeline)
+        {
+            poPipeline->WaitForWriteTurn(psJob->iChunk);
+            oDstLock = poPipeline->LockDst();
+        }
+
         if (psOptions->nBandCount == 1)
         {
             // Particular case to simplify the stack a bit.
@@ -1796,6 +2162,12 @@ CPLErr GDALWarpOperation::WarpRegion(
                 osLastErrMsg.compare(CPLGetLastErrorMsg()) != 0)
                 eErr = CE_Failure;
         }
+
+        if (poPipeline)
+        {
+            oDstLock.unlock();
+            poPipeline->SetChunkWritten(psJob->iChunk);
+        }
         ReportTiming("Output buffer write");
     }
 
@@ -1910,30 +2282,49 @@ CPLErr GDALWarpOperation::WarpRegionToBuffer(
     double dfSrcYExtraSize, double dfProgressBase, double dfProgressScale)
 
 {
-    const int nWordSize = GDALGetDataTypeSizeBytes(psOptions->eWorkingDataType);
-
     CPLAssert(eBufDataType == psOptions->eWorkingDataType);
 
+    return WarpRegionToBufferInternal(
+        nDstXOff, nDstYOff, nDstXSize, nDstYSize, pDataBuf, nSrcXOff, nSrcYOff,
+        nSrcXSize, nSrcYSize, dfSrcXExtraSize, dfSrcYExtraSize, dfProgressBase,
+        dfProgressScale, nullptr);
+}
+
+/************************************************************************/
+/*                     WarpRegionToBufferInternal()                     */
+/************************************************************************/
+
+// psJob is set when called from ChunkAndWarpMulti(), in which case accesses
+// to the datasets and to the warp kernel are synchronized with the other
+// chunks in flight.
+
+CPLErr GDALWarpOperation::WarpRegionToBufferInternal(
+    int nDstXOff, int nDstYOff, int nDstXSize, int nDstYSize, void *pDataBuf,
+    int nSrcXOff, int nSrcYOff, int nSrcXSize, int nSrcYSize,
+    double dfSrcXExtraSize, double dfSrcYExtraSize, double dfProgressBase,
+    double dfProgressScale, GDALWarpPipelineJob *psJob)
+
+{
+    const int nWordSize = GDALGetDataTypeSizeBytes(psOptions->eWorkingDataType);
+    GDALWarpPipeline *poPipeline = psJob ? psJob->poPipeline : nullptr;
+
     /* -------------------------------------------------------------------- */
     /*      If not given a corresponding source window compute one now.     */
     /* -------------------------------------------------------------------- */
     if (nSrcXSize == 0 && nSrcYSize == 0)
     {
-        // TODO: This taking of the warp mutex is suboptimal. We could get rid
-        // of it, but that would require making sure ComputeSourceWindow()
-        // uses a different pTransformerArg than the warp kernel.
-        if (hWarpMutex != nullptr && !CPLAcquireMutex(hWarpMutex, 600.0))
-        {
-            CPLError(CE_Failure, CPLE_AppDefined,
-                     "Failed to acquire WarpMutex in WarpRegion().");
-            return CE_Failure;
-        }
+        // ComputeSourceWindow() uses psOptions->pTransformerArg, which may
+        // also be used by a warp kernel of the pipeline.
+        std::unique_lock<std::mutex> oTransformerLock;
+        if (poPipeline)
+            oTransformerLock =
+                std::unique_lock<std::mutex>(poPipeline->oTransformerMutex);
         const CPLErr eErr =
             ComputeSourceWindow(nDstXOff, nDstYOff, nDstXSize, nDstYSize,
                                 &nSrcXOff, &nSrcYOff, &nSrcXSize, &nSrcYSize,
                                 &dfSrcXExtraSize, &dfSrcYExtraSize, nullptr);
-        if (hWarpMutex != nullptr)
-            CPLReleaseMutex(hWarpMutex);
+        if (oTransformerLock.owns_lock())
+            oTransformerLock.unlock();
         if (eErr != CE_None)
         {
             const bool bErrorOutIfEmptySourceWindow =
@@ -1956,11 +2347,19 @@ CPLErr GDALWarpOperation::WarpRegionToBuffer(
     oWK.nBands = psOptions->nBandCount;
     oWK.eWorkingDataType = psOptions->eWorkingDataType;
 
-    oWK.pfnTransformer = psOptions->pfnTransformer;
-    oWK.pTransformerArg = psOptions->pTransformerArg;
+    oWK.pfnTransformer = GetTransformer();
+    oWK.pTransformerArg = GetTransformerArg();
 
-    oWK.pfnProgress = psOptions->pfnProgress;
-    oWK.pProgress = psOptions->pProgressArg;
+    if (psJob)
+    {
+        oWK.pfnProgress = GDALWarpPipelineProgress;
+        oWK.pProgress = psJob;
+    }
+    else
+    {
+        oWK.pfnProgress = psOptions->pfnProgress;
+        oWK.pProgress = psOptions->pProgressArg;
+    }
     oWK.dfProgressBase = dfProgressBase;
     oWK.dfProgressScale = dfProgressScale;
 
@@ -2014,6 +2413,10 @@ CPLErr GDALWarpOperation::WarpRegionToBuffer(
                  WARP_EXTRA_ELTS) *
                 i;
 
+    // Held until the source alpha band has been read
+    auto oSrcLock =
+        poPipeline ? poPipeline->LockSrc() : std::unique_lock<std::mutex>();
+
     if (eErr == CE_None && nSrcXSize > 0 && nSrcYSize > 0)
     {
         GDALDataset *poSrcDS = GDALDataset::FromHandle(psOptions->hSrcDS);
@@ -2097,6 +2500,9 @@ CPLErr GDALWarpOperation::WarpRegionToBuffer(
         }
     }
 
+    if (oSrcLock.owns_lock())
+        oSrcLock.unlock();
+
     /* -------------------------------------------------------------------- */
     /*      Generate a source density mask if we have a source cutline.     */
     /* -------------------------------------------------------------------- */
@@ -2144,6 +2550,8 @@ CPLErr GDALWarpOperation::WarpRegionToBuffer(
 
         eErr = CreateKernelMask(&oWK, 0 /* not used */, "DstDensity");
 
+        auto oDstLock =
+            poPipeline ? poPipeline->LockDst() : std::unique_lock<std::mutex>();
         if (eErr == CE_None)
             eErr = GDALWarpDstAlphaMasker(
                 psOptions, psOptions->nBandCount, psOptions->eWorkingDataType,
@@ -2291,6 +2699,8 @@ CPLErr GDALWarpOperation::WarpRegionToBuffer(
     {
         eErr = CreateKernelMask(&oWK, 0 /* not used */, "UnifiedSrcValid");
 
+        auto oSrcMaskLock =
+            poPipeline ? poPipeline->LockSrc() : std::unique_lock<std::mutex>();
         if (eErr == CE_None)
             eErr = GDALWarpSrcMaskMasker(
                 psOptions, psOptions->nBandCount, psOptions->eWorkingDataType,
@@ -2355,17 +2765,19 @@ CPLErr GDALWarpOperation::WarpRegionToBuffer(
     }
 
     /* -------------------------------------------------------------------- */
-    /*      Release IO Mutex, and acquire warper mutex.                     */
+    /*      Acquire a warp kernel slot of the pipeline.                     */
     /* -------------------------------------------------------------------- */
-    if (hIOMutex != nullptr)
+    size_t iKernelSlot = 0;
+    std::unique_lock<std::mutex> oTransformerLock;
+    if (poPipeline)
     {
-        CPLReleaseMutex(hIOMutex);
-        if (!CPLAcquireMutex(hWarpMutex, 600.0))
-        {
-            CPLError(CE_Failure, CPLE_AppDefined,
-                     "Failed to acquire WarpMutex in WarpRegion().");
-            return CE_Failure;
-        }
+        iKernelSlot = poPipeline->AcquireKernelSlot();
+        const auto &oSlot = poPipeline->aoKernelSlots[iKernelSlot];
+        oWK.psThreadData = oSlot.psThreadData;
+        oWK.pTransformerArg = oSlot.pTransformerArg;
+        if (!oSlot.bOwned)
+            oTransformerLock =
+                std::unique_lock<std::mutex>(poPipeline->oTransformerMutex);
     }
 
     /* -------------------------------------------------------------------- */
@@ -2392,17 +2804,13 @@ CPLErr GDALWarpOperation::WarpRegionToBuffer(
             &oWK, psOptions->pPostWarpProcessorArg);
 
     /* -------------------------------------------------------------------- */
-    /*      Release Warp Mutex, and acquire io mutex.                       */
+    /*      Release the warp kernel slot.                                   */
     /* -------------------------------------------------------------------- */
-    if (hIOMutex != nullptr)
+    if (poPipeline)
     {
-        CPLReleaseMutex(hWarpMutex);
-        if (!CPLAcquireMutex(hIOMutex, 600.0))
-        {
-            CPLError(CE_Failure, CPLE_AppDefined,
-                     "Failed to acquire IOMutex in WarpRegion().");
-            return CE_Failure;
-        }
+        if (oTransformerLock.owns_lock())
+            oTransformerLock.unlock();
+        poPipeline->ReleaseKernelSlot(iKernelSlot);
     }
 
     /* -------------------------------------------------------------------- */
@@ -2410,6 +2818,12 @@ CPLErr GDALWarpOperation::WarpRegionToBuffer(
     /* -------------------------------------------------------------------- */
     if (eErr == CE_None && psOptions->nDstAlphaBand > 0)
     {
+        std::unique_lock<std::mutex> oDstLock;
+        if (poPipeline)
+        {
+            poPipeline->WaitForWriteTurn(psJob->iChunk);
+            oDstLock = poPipeline->LockDst();
+        }
         eErr = GDALWarpDstAlphaMasker(
             psOptions, -psOptions->nBandCount, psOptions->eWorkingDataType,
             oWK.nDstXOff, oWK.nDstYOff, oWK.nDstXSize, oWK.nDstYSize,
@@ -2894,7 +3308,12 @@ bool GDALWarpOperation::ComputeSourceWindowTransformPoints(
 
     const auto RefreshTransformer = [this]()
     {
-        if (GDALIsTransformer(psOptions->pTransformerArg,
+        if (m_psTransformationGridArg)
+        {
+            GDALRefreshTransformationGridTransformer(
+                m_psTransformationGridArg.get());
+        }
+        else if (GDALIsTransformer(psOptions->pTransformerArg,
                               GDAL_GEN_IMG_TRANSFORMER_CLASS_NAME))
         {
             GDALRefreshGenImgProjTransformer(psOptions->pTransformerArg);
@@ -2911,8 +3330,8 @@ bool GDALWarpOperation::ComputeSourceWindowTransformPoints(
         CPLSetThreadLocalConfigOption("CHECK_WITH_INVERT_PROJ", "YES");
         RefreshTransformer();
     }
-    psOptions->pfnTransformer(psOptions->pTransformerArg, TRUE, nSamplePoints,
-                              padfX, padfY, padfZ, pabSuccess);
+    GetTransformer()(GetTransformerArg(), TRUE, nSamplePoints, padfX, padfY,
+                     padfZ, pabSuccess);
     if (bTryWithCheckWithInvertProj)
     {
         CPLSetThreadLocalConfigOption("CHECK_WITH_INVERT_PROJ", nullptr);
@@ -3026,9 +3445,8 @@ CPLErr GDALWarpOperation::ComputeSourceWindow(
         adfCornerY[2] = nDstYOff + nDstYSize;
         adfCornerX[3] = nDstXOff + nDstXSize;
         adfCornerY[3] = nDstYOff + nDstYSize;
-        if (!psOptions->pfnTransformer(psOptions->pTransformerArg, TRUE, 4,
-                                       adfCornerX, adfCornerY, adfCornerZ,
-                                       anCornerSuccess) ||
+        if (!GetTransformer()(GetTransformerArg(), TRUE, 4, adfCornerX,
+                              adfCornerY, adfCornerZ, anCornerSuccess) ||
             !anCornerSuccess[0] || !anCornerSuccess[1] || !anCornerSuccess[2] ||
             !anCornerSuccess[3])
         {
@@ -94,6 +94,14 @@ GDALRasterReprojectAlgorithm::GDALRasterReprojectAlgorithm(bool standaloneStep)
         this, m_warpOptions, m_transformOptions, m_errorThreshold);
 
     AddNumThreadsArg(&m_numThreads, &m_numThreadsStr);
+
+    AddArg("pipeline-depth", 0,
+           _("Number of chunks processed concurrently, while reading input "
+             "and writing output"),
+           &m_pipelineDepth)
+        .SetMinValueIncluded(1)
+        .SetMaxValueIncluded(128)
+        .SetCategory(GAAC_ADVANCED);
 }
 
 /************************************************************************/
@@ -307,6 +315,12 @@ bool GDALRasterReprojectAlgorithm::RunStep(GDALPipelineStepRunContext &ctxt)
             bFoundNumThreads = true;
         aosOptions.AddString(opt.c_str());
     }
+    if (m_pipelineDepth > 0)
+    {
+        aosOptions.AddString("-multi");
+        aosOptions.AddString("-wo");
+        aosOptions.AddString(CPLSPrintf("PIPELINE_DEPTH=%d", m_pipelineDepth));
+    }
     if (bFoundNumThreads)
     {
         if (GetArg("num-threads")->IsExplicitlySet())
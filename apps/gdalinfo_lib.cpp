@@ -376,6 +376,190 @@ std::string GDALInfoAppGetParserUsage()
     }
 }
 
+/************************************************************************/
+/*                GDALInfoComputeMultiBandStatistics()                  */
+/************************************************************************/
+
+namespace
+{
+struct GDALInfoHistogram
+{
+    bool bValid = false;
+    double dfMin = 0;
+    double dfMax = 0;
+    std::vector<GUIntBig> anHistogram{};
+};
+}  // namespace
+
+/** Compute the statistics and default histograms that are not yet available
+ * with a single pass over the dataset, so that blocks of pixel-interleaved
+ * datasets are decoded once for all bands, rather than once per band.
+ *
+ * Only what the per-band reporting would compute is computed, through the
+ * methods of the bands, so that side effects, such as the storage of
+ * statistics and histograms in the .aux.xml file, are the same. Statistics
+ * are retrieved by GDALGetRasterStatistics() afterwards. Histograms are
+ * returned in aoHistograms. Errors are silenced: bands for which the
+ * computation failed are processed again, band per band, when reporting
+ * them.
+ */
+static void
+GDALInfoComputeMultiBandStatistics(const GDALInfoOptions *psOptions,
+                                   GDALDatasetH hDataset, bool bJson,
+                                   std::vector<GDALInfoHistogram> &aoHistograms)
+{
+    GDALDataset *poDS = GDALDataset::FromHandle(hDataset);
+    const int nBands = poDS->GetRasterCount();
+    aoHistograms.resize(nBands);
+    if (nBands < 2 || (!psOptions->bStats && !psOptions->bReportHistograms))
+        return;
+
+    CPLErrorStateBackuper oErrorStateBackuper(CPLQuietErrorHandler);
+
+    const auto SetHistogram = [&aoHistograms](int nBand, double dfMin,
+                                              double dfMax, int nBuckets,
+                                              const GUIntBig *panHistogram)
+    {
+        auto &oHistogram = aoHistograms[nBand - 1];
+        oHistogram.bValid = true;
+        oHistogram.dfMin = dfMin;
+        oHistogram.dfMax = dfMax;
+        oHistogram.anHistogram.assign(panHistogram, panHistogram + nBuckets);
+    };
+
+    // Bands whose default histogram is not already stored
+    std::vector<bool> abNeedHistogram(nBands);
+    if (psOptions->bReportHistograms)
+    {
+        for (int i = 1; i <= nBands; ++i)
+        {
+            double dfMin = 0, dfMax = 0;
+            int nBucketCount = 0;
+            GUIntBig *panHistogram = nullptr;
+            abNeedHistogram[i - 1] =
+                poDS->GetRasterBand(i)->GetDefaultHistogram(
+                    &dfMin, &dfMax, &nBucketCount, &panHistogram, FALSE,
+                    nullptr, nullptr) != CE_None;
+            CPLFree(panHistogram);
+        }
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Missing statistics, and the default histograms of the same      */
+    /*      bands, which are computed with those statistics.                */
+    /* -------------------------------------------------------------------- */
+    if (psOptions->bStats)
+    {
+        std::vector<int> anBandList;
+        for (int i = 1; i <= nBands; ++i)
+        {
+            double dfMin = 0, dfMax = 0;
+            if (GDALGetRasterStatistics(
+                    GDALGetRasterBand(hDataset, i), psOptions->bApproxStats,
+                    FALSE, &dfMin, &dfMax, nullptr, nullptr) != CE_None)
+                anBandList.push_back(i);
+        }
+        const int nBandCount = static_cast<int>(anBandList.size());
+        if (nBandCount > 1)
+        {
+            const bool bHistograms = psOptions->bReportHistograms;
+            std::vector<double> adfHistMin(nBandCount);
+            std::vector<double> adfHistMax(nBandCount);
+            std::vector<int> anHistBuckets(nBandCount);
+            std::vector<GUIntBig *> apanHistograms(nBandCount);
+            poDS->ComputeStatistics(
+                psOptions->bApproxStats, nBandCount, anBandList.data(),
+                nullptr, nullptr, nullptr, nullptr, adfHistMin.data(),
+                adfHistMax.data(), anHistBuckets.data(),
+                bHistograms ? apanHistograms.data() : nullptr,
+                bHistograms && !bJson ? GDALTermProgress : GDALDummyProgress,
+                nullptr);
+            for (int i = 0; i < nBandCount; ++i)
+            {
+                if (apanHistograms[i])
+                {
+                    SetHistogram(anBandList[i], adfHistMin[i], adfHistMax[i],
+                                 anHistBuckets[i], apanHistograms[i]);
+                    abNeedHistogram[anBandList[i] - 1] = false;
+                }
+                VSIFree(apanHistograms[i]);
+            }
+        }
+    }
+
+    if (!psOptions->bReportHistograms)
+        return;
+
+    /* -------------------------------------------------------------------- */
+    /*      Other default histograms, whose bounds are known without        */
+    /*      computing statistics. The per-band reporting computes the       */
+    /*      other ones after reporting the statistics of the band, as       */
+    /*      GDALRasterBand::GetDefaultHistogram() computes approximate      */
+    /*      statistics to get their bounds.                                 */
+    /* -------------------------------------------------------------------- */
+    constexpr int nBuckets = 256;
+    std::vector<int> anBandList;
+    std::vector<double> adfMin;
+    std::vector<double> adfMax;
+    for (int i = 1; i <= nBands; ++i)
+    {
+        if (!abNeedHistogram[i - 1])
+            continue;
+
+        // Same bounds as GDALRasterBand::GetDefaultHistogram()
+        GDALRasterBand *poBand = poDS->GetRasterBand(i);
+        double dfMin = 0, dfMax = 0;
+        bool bUnsignedByte = false;
+        if (poBand->GetRasterDataType() == GDT_Byte)
+        {
+            poBand->EnablePixelTypeSignedByteWarning(false);
+            const char *pszPixelType =
+                poBand->GetMetadataItem("PIXELTYPE", "IMAGE_STRUCTURE");
+            poBand->EnablePixelTypeSignedByteWarning(true);
+            bUnsignedByte =
+                !(pszPixelType && EQUAL(pszPixelType, "SIGNEDBYTE"));
+        }
+        if (bUnsignedByte)
+        {
+            dfMin = -0.5;
+            dfMax = 255.5;
+        }
+        else
+        {
+            if (poBand->GetStatistics(TRUE, FALSE, &dfMin, &dfMax, nullptr,
+                                      nullptr) != CE_None)
+                continue;
+            const double dfHalfBucket = (dfMax - dfMin) / (2 * (nBuckets - 1));
+            dfMin -= dfHalfBucket;
+            dfMax += dfHalfBucket;
+        }
+        anBandList.push_back(i);
+        adfMin.push_back(dfMin);
+        adfMax.push_back(dfMax);
+    }
+    const int nBandCount = static_cast<int>(anBandList.size());
+    if (nBandCount < 2)
+        return;
+
+    std::vector<std::vector<GUIntBig>> aanHistograms(
+        nBandCount, std::vector<GUIntBig>(nBuckets));
+    std::vector<GUIntBig *> apanHistograms;
+    for (auto &anHistogram : aanHistograms)
+        apanHistograms.push_back(anHistogram.data());
+    if (poDS->GetHistogram(nBandCount, anBandList.data(), adfMin.data(),
+                           adfMax.data(), nBuckets, apanHistograms.data(),
+                           true, false,
+                           bJson ? GDALDummyProgress : GDALTermProgress,
+                           nullptr) == CE_None)
+    {
+        for (int i = 0; i < nBandCount; ++i)
+        {
+            SetHistogram(anBandList[i], adfMin[i], adfMax[i], nBuckets,
+                         apanHistograms[i]);
+        }
+    }
+}
+
 /************************************************************************/
 /*                             GDALInfo()                               */
 /************************************************************************/
@@ -1002,6 +1186,10 @@ char *GDALInfo(GDALDatasetH hDataset, const GDALInfoOptions *psOptions)
         hTransform = nullptr;
     }
 
+    std::vector<GDALInfoHistogram> aoHistograms;
+    GDALInfoComputeMultiBandStatistics(psOptions, hDataset, bJson,
+                                       aoHistograms);
+
     /* ==================================================================== */
     /*      Loop over bands.                                                */
     /* ==================================================================== */
@@ -1306,7 +1494,19 @@ char *GDALInfo(GDALDatasetH hDataset, const GDALInfoOptions *psOptions)
             int nBucketCount = 0;
             GUIntBig *panHistogram = nullptr;
 
-            if (bJson)
+            const auto &oHistogram = aoHistograms[iBand];
+            if (oHistogram.bValid)
+            {
+                dfMinStat = oHistogram.dfMin;
+                dfMaxStat = oHistogram.dfMax;
+                nBucketCount = static_cast<int>(oHistogram.anHistogram.size());
+                panHistogram = static_cast<GUIntBig *>(
+                    CPLMalloc(sizeof(GUIntBig) * nBucketCount));
+                memcpy(panHistogram, oHistogram.anHistogram.data(),
+                       sizeof(GUIntBig) * nBucketCount);
+                eErr = CE_None;
+            }
+            else if (bJson)
                 eErr = GDALGetDefaultHistogramEx(
                     hBand, &dfMinStat, &dfMaxStat, &nBucketCount, &panHistogram,
                     TRUE, GDALDummyProgress, nullptr);
@@ -178,7 +178,8 @@ struct GDALWarpAppOptions
 
     /*! use multithreaded warping implementation. Multiple threads will be used
         to process chunks of image and perform input/output operation
-       simultaneously. */
+       simultaneously. The number of chunks in flight is set with the
+       PIPELINE_DEPTH warping option, which also implies this mode. */
     bool bMulti = false;
 
     /*! list of transformer options suitable to pass to
@@ -3238,7 +3239,9 @@ GDALWarpDirect(const char *pszDest, GDALDatasetH hDstDS, int nSrcCount,
                            std::move(hTransformArg)) == CE_None)
         {
             CPLErr eErr;
-            if (psOptions->bMulti)
+            // Setting the pipeline depth implies -multi
+            if (psOptions->bMulti ||
+                psOptions->aosWarpOptions.FetchNameValue("PIPELINE_DEPTH"))
                 eErr = oWO.ChunkAndWarpMulti(nWarpDstXOff, nWarpDstYOff,
                                              nWarpDstXSize, nWarpDstYSize);
             else
@@ -2112,3 +2112,426 @@ def test_warp_validate_options():
     except Exception:
         print(xml)
         raise
+
+
+###############################################################################
+# Test that the separable resampling code path, used when the transformation
+# is only a scaling and a translation, gives the same results as the per-pixel
+# one
+
+
+@pytest.mark.parametrize("resampling", ["bilinear", "cubic", "cubicspline", "lanczos"])
+@pytest.mark.parametrize(
+    "datatype",
+    [
+        gdal.GDT_Byte,
+        gdal.GDT_Int16,
+        gdal.GDT_UInt16,
+        gdal.GDT_Float32,
+        gdal.GDT_Float64,
+    ],
+    ids=gdal.GetDataTypeName,
+)
+@pytest.mark.parametrize("scale", [0.37, 1, 1.7])
+@pytest.mark.parametrize("num_threads", [1, 2])
+def test_warp_separable_resampling(resampling, datatype, scale, num_threads):
+
+    src_ds = gdal.Translate(
+        "", "../gcore/data/rgbsmall.tif", format="MEM", outputType=datatype
+    )
+    gt = src_ds.GetGeoTransform()
+    # Shift the output grid by a fraction of pixel, and make it overlap the
+    # source extent, so that edges are tested
+    minx = gt[0] + gt[1] * 3.3
+    maxx = gt[0] + gt[1] * (src_ds.RasterXSize + 2.6)
+    maxy = gt[3] + gt[5] * 1.2
+    miny = gt[3] + gt[5] * (src_ds.RasterYSize - 4.1)
+
+    def warp(separable):
+        with gdal.config_option("WARP_THREAD_CHUNK_SIZE", "0"):
+            return gdal.Warp(
+                "",
+                src_ds,
+                format="MEM",
+                outputBounds=(minx, miny, maxx, maxy),
+                width=int(src_ds.RasterXSize * scale),
+                height=int(src_ds.RasterYSize * scale),
+                resampleAlg=resampling,
+                dstAlpha=True,
+                warpOptions=[
+                    f"SEPARABLE_RESAMPLING={separable}",
+                    f"NUM_THREADS={num_threads}",
+                ],
+            )
+
+    ds = warp("YES")
+    ref_ds = warp("NO")
+
+    for i in range(ref_ds.RasterCount):
+        band = ds.GetRasterBand(i + 1)
+        ref_band = ref_ds.GetRasterBand(i + 1)
+        if i == 3:
+            assert band.ReadRaster() == ref_band.ReadRaster()
+            continue
+        type_char = gdaltest.gdal_data_type_to_python_struct_format(band.DataType)
+        count = ds.RasterXSize * ds.RasterYSize
+        values = struct.unpack(type_char * count, band.ReadRaster())
+        ref_values = struct.unpack(type_char * count, ref_band.ReadRaster())
+        maxdiff = max(abs(a - b) for a, b in zip(values, ref_values))
+        if datatype in (gdal.GDT_Float32, gdal.GDT_Float64):
+            assert maxdiff < 1e-3
+        else:
+            assert maxdiff <= 1
+
+
+###############################################################################
+# Test that average and sum resampling done in two passes give the same
+# results as the per-pixel code paths
+
+
+@pytest.mark.parametrize("resampling", ["average", "sum"])
+@pytest.mark.parametrize(
+    "datatype",
+    [
+        gdal.GDT_Byte,
+        gdal.GDT_Int16,
+        gdal.GDT_UInt16,
+        gdal.GDT_Float32,
+        gdal.GDT_Float64,
+    ],
+    ids=gdal.GetDataTypeName,
+)
+@pytest.mark.parametrize("scale", [0.1, 0.37, 1, 1.7])
+@pytest.mark.parametrize("nodata", [None, 0])
+def test_warp_separable_average_sum(resampling, datatype, scale, nodata):
+
+    src_ds = gdal.Translate(
+        "", "../gcore/data/rgbsmall.tif", format="MEM", outputType=datatype
+    )
+    gt = src_ds.GetGeoTransform()
+    # Shift the output grid by a fraction of pixel, and make it overlap the
+    # source extent, so that edges are tested
+    minx = gt[0] + gt[1] * 3.3
+    maxx = gt[0] + gt[1] * (src_ds.RasterXSize + 2.6)
+    maxy = gt[3] + gt[5] * 1.2
+    miny = gt[3] + gt[5] * (src_ds.RasterYSize - 4.1)
+
+    def warp(separable):
+        with gdal.config_option("WARP_THREAD_CHUNK_SIZE", "0"):
+            return gdal.Warp(
+                "",
+                src_ds,
+                format="MEM",
+                outputBounds=(minx, miny, maxx, maxy),
+                width=max(1, int(src_ds.RasterXSize * scale)),
+                height=max(1, int(src_ds.RasterYSize * scale)),
+                resampleAlg=resampling,
+                srcNodata=nodata,
+                dstAlpha=True,
+                warpOptions=[f"SEPARABLE_RESAMPLING={separable}"],
+            )
+
+    ds = warp("YES")
+    ref_ds = warp("NO")
+
+    for i in range(ref_ds.RasterCount):
+        band = ds.GetRasterBand(i + 1)
+        ref_band = ref_ds.GetRasterBand(i + 1)
+        if i == 3:
+            assert band.ReadRaster() == ref_band.ReadRaster()
+            continue
+        type_char = gdaltest.gdal_data_type_to_python_struct_format(band.DataType)
+        count = ds.RasterXSize * ds.RasterYSize
+        values = struct.unpack(type_char * count, band.ReadRaster())
+        ref_values = struct.unpack(type_char * count, ref_band.ReadRaster())
+        for a, b in zip(values, ref_values):
+            if datatype in (gdal.GDT_Float32, gdal.GDT_Float64):
+                assert a == pytest.approx(b, rel=1e-5, abs=1e-5)
+            else:
+                assert abs(a - b) <= 1
+
+
+###############################################################################
+# Test that the separable average/sum code path is also used for a
+# reprojection of a small area, with an approximate transformer
+
+
+@pytest.mark.parametrize("resampling", ["average", "sum"])
+def test_warp_separable_average_sum_reprojection(resampling):
+
+    src_ds = gdal.Open("../gcore/data/byte.tif")
+
+    def warp(separable, grid=False):
+        warp_options = [f"SEPARABLE_RESAMPLING={separable}"]
+        if grid:
+            warp_options.append("TRANSFORMATION_GRID=MEM")
+        return gdal.Warp(
+            "",
+            src_ds,
+            format="MEM",
+            dstSRS="EPSG:32611",
+            width=7,
+            height=7,
+            outputType=gdal.GDT_Float32,
+            resampleAlg=resampling,
+            warpOptions=warp_options,
+        )
+
+    messages = []
+
+    def handler(err_class, err_no, msg):
+        messages.append(msg)
+
+    with gdaltest.config_option("CPL_DEBUG", "ON"), gdaltest.error_handler(handler):
+        ds = warp("YES")
+    assert any("GWKSeparableAreaResample" in msg for msg in messages)
+
+    # Opt-in only
+    messages.clear()
+    with gdaltest.config_option("CPL_DEBUG", "ON"), gdaltest.error_handler(handler):
+        gdal.Warp(
+            "",
+            src_ds,
+            format="MEM",
+            dstSRS="EPSG:32611",
+            width=7,
+            height=7,
+            outputType=gdal.GDT_Float32,
+            resampleAlg=resampling,
+        )
+    assert not any("GWKSeparableAreaResample" in msg for msg in messages)
+
+    # Also with a transformation grid, wrapping the approximate transformer
+    messages.clear()
+    with gdaltest.config_option("CPL_DEBUG", "ON"), gdaltest.error_handler(handler):
+        warp("YES", grid=True)
+    assert any("GWKSeparableAreaResample" in msg for msg in messages)
+    ref_ds = warp("NO")
+
+    count = ds.RasterXSize * ds.RasterYSize
+    values = struct.unpack("f" * count, ds.ReadRaster())
+    ref_values = struct.unpack("f" * count, ref_ds.ReadRaster())
+    assert values == pytest.approx(ref_values, rel=1e-2)
+
+
+###############################################################################
+# Test that the code paths specialized for sources with a nodata value or a
+# validity mask give the same results as the generic one
+
+
+@pytest.mark.parametrize("resampling", ["bilinear", "cubic", "cubicspline", "lanczos"])
+@pytest.mark.parametrize(
+    "datatype",
+    [
+        gdal.GDT_Byte,
+        gdal.GDT_Int16,
+        gdal.GDT_UInt16,
+        gdal.GDT_Float32,
+    ],
+    ids=gdal.GetDataTypeName,
+)
+@pytest.mark.parametrize("scale", [0.37, 1, 1.7])
+@pytest.mark.parametrize("band_count", [1, 3])
+def test_warp_specialized_masked_resampling(resampling, datatype, scale, band_count):
+
+    src_ds = gdal.Translate(
+        "",
+        "../gcore/data/rgbsmall.tif",
+        format="MEM",
+        outputType=datatype,
+        bandList=list(range(1, band_count + 1)),
+    )
+    # Punch nodata holes: scattered pixels, and a rectangle
+    xsize = src_ds.RasterXSize
+    ysize = src_ds.RasterYSize
+    count = xsize * ysize
+    hole = b"\x00" * (8 * 5 * gdal.GetDataTypeSizeBytes(datatype))
+    for i in range(band_count):
+        band = src_ds.GetRasterBand(i + 1)
+        band.SetNoDataValue(0)
+        type_char = gdaltest.gdal_data_type_to_python_struct_format(band.DataType)
+        values = list(struct.unpack(type_char * count, band.ReadRaster()))
+        for j in range(i, count, 7 + i):
+            values[j] = 0
+        band.WriteRaster(0, 0, xsize, ysize, struct.pack(type_char * count, *values))
+        band.WriteRaster(10, 12, 8, 5, hole)
+
+    gt = src_ds.GetGeoTransform()
+    minx = gt[0] + gt[1] * 3.3
+    maxx = gt[0] + gt[1] * (src_ds.RasterXSize + 2.6)
+    maxy = gt[3] + gt[5] * 1.2
+    miny = gt[3] + gt[5] * (src_ds.RasterYSize - 4.1)
+
+    def warp(specialized):
+        return gdal.Warp(
+            "",
+            src_ds,
+            format="MEM",
+            outputBounds=(minx, miny, maxx, maxy),
+            width=int(src_ds.RasterXSize * scale),
+            height=int(src_ds.RasterYSize * scale),
+            resampleAlg=resampling,
+            warpOptions=[f"SPECIALIZED_MASKED_RESAMPLING={specialized}"],
+        )
+
+    ds = warp("YES")
+    ref_ds = warp("NO")
+
+    for i in range(band_count):
+        data = ds.GetRasterBand(i + 1).ReadRaster()
+        assert data == ref_ds.GetRasterBand(i + 1).ReadRaster()
+
+
+###############################################################################
+# Test the TRANSFORMATION_GRID warping option
+
+
+def test_warp_transformation_grid(tmp_vsimem):
+
+    grid_filename = str(tmp_vsimem / "grid.tif")
+    src_ds = gdal.Open("../gcore/data/byte.tif")
+
+    def warp(width=40, height=40, dstSRS="EPSG:4326", errorThreshold=0.001, **kwargs):
+        return gdal.Warp(
+            "",
+            src_ds,
+            format="MEM",
+            dstSRS=dstSRS,
+            width=width,
+            height=height,
+            resampleAlg="bilinear",
+            errorThreshold=errorThreshold,
+            **kwargs,
+        )
+
+    def values(ds):
+        return struct.unpack("B" * (ds.RasterXSize * ds.RasterYSize), ds.ReadRaster())
+
+    ref_ds = warp()
+    ds = warp(warpOptions=[f"TRANSFORMATION_GRID={grid_filename}"])
+    diffs = [abs(a - b) for a, b in zip(values(ds), values(ref_ds))]
+    assert max(diffs) <= 1
+    assert sum(diffs) / len(diffs) < 0.1
+
+    grid_ds = gdal.Open(grid_filename)
+    assert grid_ds.RasterCount == 4
+    assert grid_ds.GetMetadataItem("TARGET_WIDTH") == "40"
+    assert grid_ds.GetMetadataItem("TARGET_HEIGHT") == "40"
+    step = int(grid_ds.GetMetadataItem("STEP"))
+    assert grid_ds.RasterXSize == (40 + step - 1) // step + 1
+    transformer = grid_ds.GetMetadataItem("TRANSFORMER")
+    assert "GenImgProjTransformer" in transformer
+    assert grid_ds.GetRasterBand(1).GetDescription() == "source_x"
+    grid_ds = None
+
+    # Reusing the grid gives the same result
+    ds2 = warp(warpOptions=[f"TRANSFORMATION_GRID={grid_filename}"])
+    assert ds2.ReadRaster() == ds.ReadRaster()
+
+    # Shift source coordinates of the persisted grid to check it is used
+    grid_ds = gdal.Open(grid_filename, gdal.GA_Update)
+    band = grid_ds.GetRasterBand(1)
+    count = grid_ds.RasterXSize * grid_ds.RasterYSize
+    src_x = struct.unpack("d" * count, band.ReadRaster())
+    band.WriteRaster(
+        0,
+        0,
+        grid_ds.RasterXSize,
+        grid_ds.RasterYSize,
+        struct.pack("d" * count, *[x + 5 for x in src_x]),
+    )
+    grid_ds = None
+    ds2 = warp(warpOptions=[f"TRANSFORMATION_GRID={grid_filename}"])
+    assert ds2.ReadRaster() != ds.ReadRaster()
+
+    # A grid computed for another transformer is reused only if
+    # TRANSFORMATION_GRID_CHECK_TRANSFORMER=NO
+    ds2 = warp(
+        dstSRS="EPSG:32611",
+        warpOptions=[
+            f"TRANSFORMATION_GRID={grid_filename}",
+            "TRANSFORMATION_GRID_CHECK_TRANSFORMER=NO",
+        ],
+    )
+    grid_ds = gdal.Open(grid_filename)
+    assert grid_ds.GetMetadataItem("TRANSFORMER") == transformer
+    grid_ds = None
+
+    ds2 = warp(
+        dstSRS="EPSG:32611", warpOptions=[f"TRANSFORMATION_GRID={grid_filename}"]
+    )
+    grid_ds = gdal.Open(grid_filename)
+    assert grid_ds.GetMetadataItem("TRANSFORMER") != transformer
+    grid_ds = None
+
+    # A grid computed for other target dimensions is recomputed
+    ds = warp(width=30, height=35, warpOptions=[f"TRANSFORMATION_GRID={grid_filename}"])
+    grid_ds = gdal.Open(grid_filename)
+    assert grid_ds.GetMetadataItem("TARGET_WIDTH") == "30"
+    assert grid_ds.GetMetadataItem("TARGET_HEIGHT") == "35"
+    grid_ds = None
+
+    # Explicit step
+    ds = warp(
+        warpOptions=[
+            f"TRANSFORMATION_GRID={grid_filename}",
+            "TRANSFORMATION_GRID_STEP=8",
+        ]
+    )
+    grid_ds = gdal.Open(grid_filename)
+    assert grid_ds.GetMetadataItem("STEP") == "8"
+    assert grid_ds.RasterXSize == 6
+    grid_ds = None
+
+    # In-memory grid
+    ds = warp(warpOptions=["TRANSFORMATION_GRID=MEM"])
+    diffs = [abs(a - b) for a, b in zip(values(ds), values(ref_ds))]
+    assert max(diffs) <= 1
+
+    # Not possible with an exact transformer
+    with gdaltest.error_raised(gdal.CE_Warning, match="error threshold of 0"):
+        ds = warp(errorThreshold=0, warpOptions=["TRANSFORMATION_GRID=MEM"])
+    assert ds.ReadRaster() == warp(errorThreshold=0).ReadRaster()
+
+
+###############################################################################
+# Test TRANSFORMATION_GRID with a RPC transformer
+
+
+def test_warp_transformation_grid_rpc(tmp_vsimem):
+
+    grid_filename = str(tmp_vsimem / "grid.tif")
+    src_ds = gdal.Open("../gcore/data/byte_rpc.tif")
+
+    def warp(**kwargs):
+        return gdal.Warp(
+            "",
+            src_ds,
+            format="MEM",
+            rpc=True,
+            dstSRS="EPSG:4326",
+            width=40,
+            height=40,
+            resampleAlg="bilinear",
+            errorThreshold=0.001,
+            **kwargs,
+        )
+
+    def values(ds):
+        return struct.unpack("B" * (ds.RasterXSize * ds.RasterYSize), ds.ReadRaster())
+
+    ref_ds = warp()
+    ds = warp(warpOptions=[f"TRANSFORMATION_GRID={grid_filename}"])
+    diffs = [abs(a - b) for a, b in zip(values(ds), values(ref_ds))]
+    assert max(diffs) <= 1
+    assert sum(diffs) / len(diffs) < 0.1
+
+    grid_ds = gdal.Open(grid_filename)
+    assert "RPCTransformer" in grid_ds.GetMetadataItem("TRANSFORMER")
+    grid_ds = None
+
+    # No temporary file left behind
+    assert gdal.ReadDir(str(tmp_vsimem)) == ["grid.tif"]
+
+    ds2 = warp(warpOptions=[f"TRANSFORMATION_GRID={grid_filename}"])
+    assert ds2.ReadRaster() == ds.ReadRaster()
@@ -54,3 +54,55 @@ def test_gdalwarp(tmp_vsimem, source_ds_filename, num_threads, resample_alg):
             source_ds_filename,
             options=f"-co TILED=YES -r {resample_alg} -t_srs EPSG:4326",
         )
+
+
+@pytest.mark.parametrize("separable", ["YES", "NO"])
+@pytest.mark.parametrize("resample_alg", ["cubic", "lanczos"])
+def test_gdalwarp_downsample(tmp_vsimem, source_ds_filename, separable, resample_alg):
+    filename = str(tmp_vsimem / "test_gdalwarp_downsample.tif")
+    if gdal.VSIStatL(filename):
+        gdal.Unlink(filename)
+    gdal.Warp(
+        filename,
+        source_ds_filename,
+        options=f"-co TILED=YES -r {resample_alg} -tr 3.3 3.3 -wo SEPARABLE_RESAMPLING={separable}",
+    )
+
+
+@pytest.mark.parametrize("separable", ["YES", "NO"])
+@pytest.mark.parametrize("resample_alg", ["average", "sum"])
+def test_gdalwarp_downsample_average_sum(
+    tmp_vsimem, source_ds_filename, separable, resample_alg
+):
+    filename = str(tmp_vsimem / "test_gdalwarp_downsample_average_sum.tif")
+    if gdal.VSIStatL(filename):
+        gdal.Unlink(filename)
+    gdal.Warp(
+        filename,
+        source_ds_filename,
+        options=f"-co TILED=YES -r {resample_alg} -tr 10 10 -wo SEPARABLE_RESAMPLING={separable}",
+    )
+
+
+def test_gdalwarp_downsample_mode(tmp_vsimem, source_ds_filename):
+    filename = str(tmp_vsimem / "test_gdalwarp_downsample_mode.tif")
+    if gdal.VSIStatL(filename):
+        gdal.Unlink(filename)
+    gdal.Warp(
+        filename,
+        source_ds_filename,
+        options="-co TILED=YES -ot UInt16 -r mode -tr 10 10",
+    )
+
+
+@pytest.mark.parametrize("specialized", ["YES", "NO"])
+@pytest.mark.parametrize("resample_alg", ["bilinear", "cubic", "lanczos"])
+def test_gdalwarp_src_nodata(tmp_vsimem, source_ds_filename, specialized, resample_alg):
+    filename = str(tmp_vsimem / "test_gdalwarp_src_nodata.tif")
+    if gdal.VSIStatL(filename):
+        gdal.Unlink(filename)
+    gdal.Warp(
+        filename,
+        source_ds_filename,
+        options=f"-co TILED=YES -r {resample_alg} -t_srs EPSG:4326 -srcnodata 0 -wo SPECIALIZED_MASKED_RESAMPLING={specialized}",
+    )
@@ -48,6 +48,7 @@
 #include <limits>
 #include <fstream>
 #include <string>
+#include <thread>
 
 #include "gtest_include.h"
 
@@ -4130,6 +4131,114 @@ TEST_F(test_cpl, builtin_compressors_zlib_high_compression_rate)
     CPLFree(out_buffer2);
 }
 
+// Test multi-threaded compression and concurrent use of builtin compressors
+TEST_F(test_cpl, builtin_compressors_multithreaded)
+{
+    // Compressible, but not trivially, data spanning several chunks
+    std::vector<GByte> abyInput(5 * 1024 * 1024 + 123);
+    for (size_t i = 0; i < abyInput.size(); ++i)
+        abyInput[i] = static_cast<GByte>((i / 7) % 251 ^ (i >> 15));
+
+    for (const char *id : {"zlib", "gzip", "zstd"})
+    {
+        const auto pCompressor = CPLGetCompressor(id);
+        const auto pDecompressor = CPLGetDecompressor(id);
+        if (pCompressor == nullptr || pDecompressor == nullptr)
+        {
+            CPLDebug("TEST", "%s not available", id);
+            continue;
+        }
+        CPLDebug("TEST", "Testing %s", id);
+
+        EXPECT_STREQ(
+            CSLFetchNameValue(pCompressor->papszMetadata, "THREAD_SAFE"),
+            "YES");
+        EXPECT_STREQ(
+            CSLFetchNameValue(pDecompressor->papszMetadata, "THREAD_SAFE"),
+            "YES");
+        const char *pszChunkSize = CSLFetchNameValue(
+            pCompressor->papszMetadata, "PREFERRED_CHUNK_SIZE");
+        ASSERT_NE(pszChunkSize, nullptr);
+        EXPECT_GT(atoi(pszChunkSize), 0);
+
+        const auto Decompress =
+            [pDecompressor](const void *data, size_t size)
+        {
+            void *out_buffer = nullptr;
+            size_t out_size = 0;
+            std::vector<GByte> ret;
+            if (pDecompressor->pfnFunc(data, size, &out_buffer, &out_size,
+                                       nullptr, pDecompressor->user_data))
+            {
+                ret.assign(static_cast<GByte *>(out_buffer),
+                           static_cast<GByte *>(out_buffer) + out_size);
+            }
+            CPLFree(out_buffer);
+            return ret;
+        };
+
+        const char *const options[] = {"NUM_THREADS=4", nullptr};
+
+        // Let it alloc the output buffer
+        void *out_buffer = nullptr;
+        size_t out_size = 0;
+        ASSERT_TRUE(pCompressor->pfnFunc(abyInput.data(), abyInput.size(),
+                                         &out_buffer, &out_size, options,
+                                         pCompressor->user_data));
+        EXPECT_TRUE(Decompress(out_buffer, out_size) == abyInput);
+
+        // Provide the output buffer
+        size_t out_size2 = 0;
+        ASSERT_TRUE(pCompressor->pfnFunc(abyInput.data(), abyInput.size(),
+                                         nullptr, &out_size2, options,
+                                         pCompressor->user_data));
+        ASSERT_GE(out_size2, out_size);
+        std::vector<GByte> out_buffer2(out_size2);
+        void *out_buffer2_ptr = out_buffer2.data();
+        ASSERT_TRUE(pCompressor->pfnFunc(abyInput.data(), abyInput.size(),
+                                         &out_buffer2_ptr, &out_size2, options,
+                                         pCompressor->user_data));
+        EXPECT_EQ(out_size2, out_size);
+        EXPECT_TRUE(memcmp(out_buffer2.data(), out_buffer, out_size) == 0);
+        CPLFree(out_buffer);
+
+        // Provide not large enough buffer size
+        size_t out_size3 = 1000;
+        ASSERT_TRUE(!(pCompressor->pfnFunc(abyInput.data(), abyInput.size(),
+                                           &out_buffer2_ptr, &out_size3,
+                                           options, pCompressor->user_data)));
+
+        // Concurrent calls, half of them multi-threaded
+        std::atomic<int> nErrors{0};
+        std::vector<std::thread> aoThreads;
+        for (int iThread = 0; iThread < 4; ++iThread)
+        {
+            aoThreads.emplace_back(
+                [&abyInput, &nErrors, pCompressor, iThread, &Decompress,
+                 &options]()
+                {
+                    for (int iIter = 0; iIter < 2; ++iIter)
+                    {
+                        void *buffer = nullptr;
+                        size_t size = 0;
+                        if (!pCompressor->pfnFunc(
+                                abyInput.data(), abyInput.size(), &buffer,
+                                &size, (iThread % 2) == 0 ? options : nullptr,
+                                pCompressor->user_data) ||
+                            Decompress(buffer, size) != abyInput)
+                        {
+                            ++nErrors;
+                        }
+                        CPLFree(buffer);
+                    }
+                });
+        }
+        for (auto &oThread : aoThreads)
+            oThread.join();
+        EXPECT_EQ(nErrors, 0);
+    }
+}
+
 template <class T> struct TesterDelta
 {
     static void test(const char *dtypeOption)
@@ -4558,6 +4667,141 @@ TEST_F(test_cpl, VSI_plugin_advise_read)
     VSIFCloseL(fp);
 }
 
+// Test VSICreateSharedCachedFile()
+TEST_F(test_cpl, VSICreateSharedCachedFile)
+{
+    class CountingHandle final : public VSIVirtualHandle
+    {
+        const std::vector<GByte> &m_abyData;
+        std::atomic<int> &m_nReads;
+        vsi_l_offset m_nOffset = 0;
+
+      public:
+        CountingHandle(const std::vector<GByte> &abyData,
+                       std::atomic<int> &nReads)
+            : m_abyData(abyData), m_nReads(nReads)
+        {
+        }
+
+        int Seek(vsi_l_offset nOffset, int nWhence) override
+        {
+            if (nWhence == SEEK_END)
+                nOffset += m_abyData.size();
+            m_nOffset = nOffset;
+            return 0;
+        }
+
+        vsi_l_offset Tell() override
+        {
+            return m_nOffset;
+        }
+
+        size_t Read(void *pBuffer, size_t nSize, size_t nCount) override
+        {
+            ++m_nReads;
+            if (m_nOffset >= m_abyData.size())
+                return 0;
+            const size_t nToRead = std::min(
+                nSize * nCount,
+                static_cast<size_t>(m_abyData.size() - m_nOffset));
+            memcpy(pBuffer, m_abyData.data() + m_nOffset, nToRead);
+            m_nOffset += nToRead;
+            return nToRead / nSize;
+        }
+
+        size_t Write(const void *, size_t, size_t) override
+        {
+            return 0;
+        }
+
+        void ClearErr() override
+        {
+        }
+
+        int Eof() override
+        {
+            return m_nOffset >= m_abyData.size();
+        }
+
+        int Error() override
+        {
+            return 0;
+        }
+
+        int Close() override
+        {
+            return 0;
+        }
+    };
+
+    const char *pszFilename = "/i_do/not/exist/VSICreateSharedCachedFile.bin";
+    std::vector<GByte> abyData(100 * 1000);
+    for (size_t i = 0; i < abyData.size(); ++i)
+        abyData[i] = static_cast<GByte>(i % 251);
+    std::atomic<int> nReads{0};
+
+    // First handle populates the cache
+    {
+        VSIVirtualHandleUniquePtr poHandle(VSICreateSharedCachedFile(
+            new CountingHandle(abyData, nReads), pszFilename, 1024));
+        std::vector<GByte> abyRead(abyData.size() + 1);
+        EXPECT_EQ(poHandle->Read(abyRead.data(), 1, abyRead.size()),
+                  abyData.size());
+        EXPECT_TRUE(poHandle->Eof());
+        abyRead.resize(abyData.size());
+        EXPECT_EQ(abyRead, abyData);
+        EXPECT_GT(nReads.load(), 0);
+    }
+
+    // Second handle on the same file is served from the cache, including
+    // from concurrent PRead() calls
+    nReads = 0;
+    {
+        VSIVirtualHandleUniquePtr poHandle(VSICreateSharedCachedFile(
+            new CountingHandle(abyData, nReads), pszFilename, 1024));
+        ASSERT_TRUE(poHandle->HasPRead());
+        std::vector<std::thread> aoThreads;
+        std::atomic<bool> bOK{true};
+        for (int iThread = 0; iThread < 4; ++iThread)
+        {
+            aoThreads.emplace_back(
+                [&poHandle, &abyData, &bOK, iThread]()
+                {
+                    std::vector<GByte> abyRead(3000);
+                    for (size_t nOffset = iThread * 100;
+                         nOffset + abyRead.size() <= abyData.size();
+                         nOffset += 5000)
+                    {
+                        if (poHandle->PRead(abyRead.data(), abyRead.size(),
+                                            nOffset) != abyRead.size() ||
+                            memcmp(abyRead.data(), abyData.data() + nOffset,
+                                   abyRead.size()) != 0)
+                        {
+                            bOK = false;
+                        }
+                    }
+                });
+        }
+        for (auto &oThread : aoThreads)
+            oThread.join();
+        EXPECT_TRUE(bOK);
+        EXPECT_EQ(nReads.load(), 0);
+    }
+
+    // A file with the same name but a different size does not use the
+    // chunks of the previous one
+    std::vector<GByte> abyOtherData(abyData.size() / 2, 1);
+    {
+        VSIVirtualHandleUniquePtr poHandle(VSICreateSharedCachedFile(
+            new CountingHandle(abyOtherData, nReads), pszFilename, 1024));
+        std::vector<GByte> abyRead(abyOtherData.size());
+        EXPECT_EQ(poHandle->Read(abyRead.data(), 1, abyRead.size()),
+                  abyRead.size());
+        EXPECT_EQ(abyRead, abyOtherData);
+        EXPECT_GT(nReads.load(), 0);
+    }
+}
+
 // Test CPLIsASCII()
 TEST_F(test_cpl, CPLIsASCII)
 {
@@ -4588,6 +4832,93 @@ TEST_F(test_cpl, VSIIsLocal)
 #endif
 }
 
+#ifndef _WIN32
+// Test VSIFReadMultiRangeL() on a local file, with the various strategies
+TEST_F(test_cpl, VSIFReadMultiRangeL_local)
+{
+    const std::string osTmp(CPLGenerateTempFilenameSafe(nullptr) + ".bin");
+    constexpr int FILE_SIZE = 1024 * 1024;
+    std::vector<GByte> abyFile(FILE_SIZE);
+    for (int i = 0; i < FILE_SIZE; ++i)
+        abyFile[i] = static_cast<GByte>((i * 7) ^ (i >> 11));
+    {
+        VSILFILE *fp = VSIFOpenL(osTmp.c_str(), "wb");
+        ASSERT_NE(fp, nullptr);
+        ASSERT_EQ(VSIFWriteL(abyFile.data(), 1, abyFile.size(), fp),
+                  abyFile.size());
+        VSIFCloseL(fp);
+    }
+
+    // More ranges than the queue depth, of various sizes
+    constexpr int N_RANGES = 100;
+    std::vector<vsi_l_offset> anOffsets;
+    std::vector<size_t> anSizes;
+    for (int i = 0; i < N_RANGES; ++i)
+    {
+        anOffsets.push_back(static_cast<vsi_l_offset>(i) * 10007);
+        anSizes.push_back(1 + (i * 997) % 9000);
+    }
+    // Last range up to the end of the file
+    anOffsets.back() = FILE_SIZE - 1000;
+    anSizes.back() = 1000;
+
+    for (const char *pszMethod : {"NO", "THREADS", "IO_URING", "AUTO"})
+    {
+        CPLConfigOptionSetter oSetter("CPL_VSIL_LOCAL_READ_MULTI_RANGE",
+                                      pszMethod, false);
+        CPLConfigOptionSetter oSetterDepth("CPL_VSIL_LOCAL_READ_QUEUE_DEPTH",
+                                           "8", false);
+        if (EQUAL(pszMethod, "NO"))
+        {
+            EXPECT_FALSE(VSIHasOptimizedReadMultiRange(osTmp.c_str()));
+        }
+        else if (EQUAL(pszMethod, "THREADS"))
+        {
+            EXPECT_TRUE(VSIHasOptimizedReadMultiRange(osTmp.c_str()));
+        }
+
+        VSILFILE *fp = VSIFOpenL(osTmp.c_str(), "rb");
+        ASSERT_NE(fp, nullptr);
+
+        std::vector<std::vector<GByte>> aabyData(N_RANGES);
+        std::vector<void *> apData;
+        for (int i = 0; i < N_RANGES; ++i)
+        {
+            aabyData[i].resize(anSizes[i]);
+            apData.push_back(aabyData[i].data());
+        }
+        EXPECT_EQ(VSIFReadMultiRangeL(N_RANGES, apData.data(),
+                                      anOffsets.data(), anSizes.data(), fp),
+                  0)
+            << pszMethod;
+        for (int i = 0; i < N_RANGES; ++i)
+        {
+            EXPECT_TRUE(memcmp(aabyData[i].data(),
+                               abyFile.data() + anOffsets[i],
+                               anSizes[i]) == 0)
+                << pszMethod << ", range " << i;
+        }
+
+        // Range beyond the end of the file
+        const vsi_l_offset nOffset = FILE_SIZE - 10;
+        const size_t nSize = 20;
+        GByte abyBuffer[20];
+        void *pBuffer = abyBuffer;
+        vsi_l_offset anOffsetsEOF[] = {0, nOffset};
+        size_t anSizesEOF[] = {nSize, nSize};
+        void *apDataEOF[] = {pBuffer, pBuffer};
+        EXPECT_NE(VSIFReadMultiRangeL(2, apDataEOF, anOffsetsEOF, anSizesEOF,
+                                      fp),
+                  0)
+            << pszMethod;
+
+        VSIFCloseL(fp);
+    }
+
+    VSIUnlink(osTmp.c_str());
+}
+#endif
+
 // Test VSISupportsSequentialWrite()
 TEST_F(test_cpl, VSISupportsSequentialWrite)
 {
@@ -4833,6 +5164,62 @@ TEST_F(test_cpl, CPLWorkerThreadPool_recursion)
     ASSERT_EQ(ctxt.nCounter, 3 * 3);
 }
 
+// Test CPLWorkerThreadPool with jobs submitting sub-jobs and waiting for them
+TEST_F(test_cpl, CPLWorkerThreadPool_nested_wait)
+{
+    for (int nThreads : {1, 2, 4})
+    {
+        CPLWorkerThreadPool oPool;
+        ASSERT_TRUE(oPool.Setup(nThreads, nullptr, nullptr, false));
+        std::atomic<int> nCounter{0};
+        {
+            auto poQueue = oPool.CreateJobQueue();
+            for (int i = 0; i < 50; ++i)
+            {
+                poQueue->SubmitJob(
+                    [&oPool, &nCounter]
+                    {
+                        auto poSubQueue = oPool.CreateJobQueue();
+                        for (int j = 0; j < 10; ++j)
+                        {
+                            poSubQueue->SubmitJob(
+                                [&oPool, &nCounter]
+                                {
+                                    auto poSubSubQueue = oPool.CreateJobQueue();
+                                    for (int k = 0; k < 3; ++k)
+                                        poSubSubQueue->SubmitJob(
+                                            [&nCounter] { ++nCounter; });
+                                    poSubSubQueue->WaitCompletion();
+                                });
+                        }
+                        poSubQueue->WaitCompletion();
+                    });
+            }
+            poQueue->WaitCompletion();
+        }
+        EXPECT_EQ(nCounter, 50 * 10 * 3);
+
+        // Many small jobs, from several submitting threads
+        nCounter = 0;
+        std::vector<std::thread> aoThreads;
+        for (int i = 0; i < 4; ++i)
+        {
+            aoThreads.emplace_back(
+                [&oPool, &nCounter]
+                {
+                    auto poQueue = oPool.CreateJobQueue();
+                    for (int j = 0; j < 10000; ++j)
+                        poQueue->SubmitJob([&nCounter] { ++nCounter; });
+                    poQueue->WaitCompletion();
+                });
+        }
+        for (auto &oThread : aoThreads)
+            oThread.join();
+        EXPECT_EQ(nCounter, 4 * 10000);
+        oPool.WaitCompletion();
+    }
+}
+
 // Test /vsimem/ PRead() implementation
 TEST_F(test_cpl, vsimem_pread)
 {
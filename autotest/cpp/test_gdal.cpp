@@ -3821,6 +3821,69 @@ TEST_F(test_gdal, GDALDeinterleave4ComponentsUInt16)
     VSIFree(panDest3);
 }
 
+// Test GDALDeinterleave() and GDALTranspose2D() (interleaving) with
+// 2 to 9 components of various data types, with and without SIMD
+TEST_F(test_gdal, GDALDeinterleaveInterleaveNComponents)
+{
+    for (const char *pszSIMDOption : {"", "GDAL_USE_AVX2", "GDAL_USE_SSSE3"})
+    {
+        std::unique_ptr<CPLConfigOptionSetter> poSetter;
+        if (*pszSIMDOption)
+            poSetter = std::make_unique<CPLConfigOptionSetter>(pszSIMDOption,
+                                                               "NO", false);
+        for (GDALDataType eDT :
+             {GDT_Byte, GDT_UInt16, GDT_Float32, GDT_Float64, GDT_CFloat64})
+        {
+            const int nDTSize = GDALGetDataTypeSizeBytes(eDT);
+            for (int nComponents = 2; nComponents <= 9; ++nComponents)
+            {
+                for (size_t nIters : {1, 17, 67})
+                {
+                    SCOPED_TRACE(std::string(pszSIMDOption)
+                                     .append(" ")
+                                     .append(GDALGetDataTypeName(eDT))
+                                     .append(" ")
+                                     .append(std::to_string(nComponents))
+                                     .append(" ")
+                                     .append(std::to_string(nIters)));
+                    const size_t nSize = nIters * nComponents * nDTSize;
+                    std::vector<GByte> abySrc(nSize);
+                    for (size_t i = 0; i < nSize; ++i)
+                        abySrc[i] = static_cast<GByte>(i * 7 + 3);
+                    std::vector<GByte> abyPlanar(nSize);
+                    std::vector<void *> apDest;
+                    for (int iComp = 0; iComp < nComponents; ++iComp)
+                        apDest.push_back(abyPlanar.data() +
+                                         iComp * nIters * nDTSize);
+                    GDALDeinterleave(abySrc.data(), eDT, nComponents,
+                                     apDest.data(), eDT, nIters);
+                    bool bOK = true;
+                    for (size_t i = 0; bOK && i < nIters; ++i)
+                    {
+                        for (int iComp = 0; bOK && iComp < nComponents;
+                             ++iComp)
+                        {
+                            bOK = memcmp(static_cast<GByte *>(apDest[iComp]) +
+                                             i * nDTSize,
+                                         abySrc.data() +
+                                             (i * nComponents + iComp) *
+                                                 nDTSize,
+                                         nDTSize) == 0;
+                        }
+                    }
+                    EXPECT_TRUE(bOK);
+
+                    std::vector<GByte> abyInterleaved(nSize);
+                    GDALTranspose2D(abyPlanar.data(), eDT,
+                                    abyInterleaved.data(), eDT, nIters,
+                                    nComponents);
+                    EXPECT_TRUE(abyInterleaved == abySrc);
+                }
+            }
+        }
+    }
+}
+
 // Test GDALDataset::ReportError()
 TEST_F(test_gdal, GDALDatasetReportError)
 {
@@ -5963,4 +6026,576 @@ TEST_F(test_gdal, GDALRasterBand_arithmetic_operators)
         std::runtime_error);
 }
 
+// Test GDALGetCacheStatistics()
+TEST_F(test_gdal, GDALGetCacheStatistics)
+{
+    GDALDatasetUniquePtr poDS(
+        MEMDataset::Create("", 10, 10, 1, GDT_Byte, nullptr));
+    auto poBand = poDS->GetRasterBand(1);
+
+    GIntBig nHits0 = 0, nMisses0 = 0, nEvictions0 = 0;
+    GDALGetCacheStatistics(&nHits0, &nMisses0, &nEvictions0);
+
+    GIntBig nHits = 0, nMisses = 0, nEvictions = 0;
+    auto poBlock = poBand->GetLockedBlockRef(0, 0);
+    ASSERT_NE(poBlock, nullptr);
+    poBlock->DropLock();
+    GDALGetCacheStatistics(&nHits, &nMisses, &nEvictions);
+    EXPECT_EQ(nHits, nHits0);
+    EXPECT_EQ(nMisses, nMisses0 + 1);
+    EXPECT_EQ(nEvictions, nEvictions0);
+
+    poBlock = poBand->GetLockedBlockRef(0, 0);
+    ASSERT_NE(poBlock, nullptr);
+    poBlock->DropLock();
+    GDALGetCacheStatistics(&nHits, &nMisses, &nEvictions);
+    EXPECT_EQ(nHits, nHits0 + 1);
+    EXPECT_EQ(nMisses, nMisses0 + 1);
+    EXPECT_EQ(nEvictions, nEvictions0);
+
+    const auto nOldCacheMax = GDALGetCacheMax64();
+    GDALSetCacheMax64(0);
+    GDALGetCacheStatistics(&nHits, &nMisses, &nEvictions);
+    EXPECT_GE(nEvictions, nEvictions0 + 1);
+    GDALSetCacheMax64(nOldCacheMax);
+
+    GDALResetCacheStatistics();
+    GDALGetCacheStatistics(&nHits, &nMisses, &nEvictions);
+    EXPECT_EQ(nHits, 0);
+    EXPECT_EQ(nMisses, 0);
+    EXPECT_EQ(nEvictions, 0);
+}
+
+// Test that, with the 2Q block cache policy, a sequential scan larger than
+// the cache does not evict the frequently used blocks.
+// Run by the test-unit-block-cache-2q test, with GDAL_BLOCK_CACHE_POLICY=2Q.
+TEST_F(test_gdal, GDALRasterBlock_2Q_scan_resistance)
+{
+    if (!EQUAL(CPLGetConfigOption("GDAL_BLOCK_CACHE_POLICY", "LRU"), "2Q"))
+    {
+        GTEST_SKIP() << "GDAL_BLOCK_CACHE_POLICY=2Q not set";
+    }
+
+    // Blocks of 10000 bytes, with a cache of about 100 blocks
+    constexpr int BLOCK_SIZE = 10000;
+    constexpr int HOT_BLOCKS = 10;
+    const auto nOldCacheMax = GDALGetCacheMax64();
+    GDALSetCacheMax64(100 * BLOCK_SIZE);
+
+    GDALDatasetUniquePtr poHotDS(
+        MEMDataset::Create("", BLOCK_SIZE, HOT_BLOCKS, 1, GDT_Byte, nullptr));
+    GDALDatasetUniquePtr poColdDS(
+        MEMDataset::Create("", BLOCK_SIZE, 110, 1, GDT_Byte, nullptr));
+    GDALDatasetUniquePtr poScanDS(
+        MEMDataset::Create("", BLOCK_SIZE, 300, 1, GDT_Byte, nullptr));
+    auto poHotBand = poHotDS->GetRasterBand(1);
+
+    const auto ReadBlocks = [](GDALRasterBand *poBand, int nBlocks)
+    {
+        for (int i = 0; i < nBlocks; ++i)
+        {
+            auto poBlock = poBand->GetLockedBlockRef(0, i);
+            ASSERT_NE(poBlock, nullptr);
+            poBlock->DropLock();
+        }
+    };
+
+    // Load the hot blocks, and have them evicted from the A1in list by
+    // a first scan, so that they are remembered in the A1out list.
+    ReadBlocks(poHotBand, HOT_BLOCKS);
+    ReadBlocks(poColdDS->GetRasterBand(1), 110);
+    for (int i = 0; i < HOT_BLOCKS; ++i)
+    {
+        auto poBlock = poHotBand->TryGetLockedBlockRef(0, i);
+        EXPECT_EQ(poBlock, nullptr);
+        if (poBlock)
+            poBlock->DropLock();
+    }
+
+    // Second reference: the hot blocks go to the Am list
+    ReadBlocks(poHotBand, HOT_BLOCKS);
+
+    // A full scan of a raster larger than the cache must not evict them
+    ReadBlocks(poScanDS->GetRasterBand(1), 300);
+    for (int i = 0; i < HOT_BLOCKS; ++i)
+    {
+        auto poBlock = poHotBand->TryGetLockedBlockRef(0, i);
+        EXPECT_NE(poBlock, nullptr);
+        if (poBlock)
+            poBlock->DropLock();
+    }
+
+    poHotDS.reset();
+    poColdDS.reset();
+    poScanDS.reset();
+    GDALSetCacheMax64(nOldCacheMax);
+}
+
+// Test GDALDatasetGetBlockCacheStatistics() and GDALDatasetSetBlockCacheMax()
+TEST_F(test_gdal, GDALDatasetGetBlockCacheStatistics)
+{
+    GDALDatasetUniquePtr poDS(
+        MEMDataset::Create("", 1000, 100, 1, GDT_Byte, nullptr));
+    GDALDatasetH hDS = GDALDataset::ToHandle(poDS.get());
+    auto poBand = poDS->GetRasterBand(1);
+
+    GIntBig nCachedBytes = -1, nHits = -1, nMisses = -1, nDirtyBytes = -1;
+    GDALDatasetGetBlockCacheStatistics(hDS, &nCachedBytes, &nHits, &nMisses,
+                                       &nDirtyBytes);
+    EXPECT_EQ(nCachedBytes, 0);
+    EXPECT_EQ(nHits, 0);
+    EXPECT_EQ(nMisses, 0);
+    EXPECT_EQ(nDirtyBytes, 0);
+    EXPECT_EQ(GDALDatasetGetBlockCacheMax(hDS), 0);
+
+    auto poBlock = poBand->GetLockedBlockRef(0, 0);
+    ASSERT_NE(poBlock, nullptr);
+    poBlock->MarkDirty();
+    poBlock->DropLock();
+    poBlock = poBand->GetLockedBlockRef(0, 0);
+    ASSERT_NE(poBlock, nullptr);
+    poBlock->DropLock();
+    GDALDatasetGetBlockCacheStatistics(hDS, &nCachedBytes, &nHits, &nMisses,
+                                       &nDirtyBytes);
+    EXPECT_GE(nCachedBytes, 1000);
+    EXPECT_EQ(nHits, 1);
+    EXPECT_EQ(nMisses, 1);
+    EXPECT_EQ(nDirtyBytes, 1000);
+
+    // Limit the dataset to a few blocks, and check that reading all its
+    // lines does not make it go above that quota.
+    const GIntBig nQuota = 10 * nCachedBytes;
+    GDALDatasetSetBlockCacheMax(hDS, nQuota);
+    EXPECT_EQ(GDALDatasetGetBlockCacheMax(hDS), nQuota);
+    for (int i = 0; i < 100; ++i)
+    {
+        poBlock = poBand->GetLockedBlockRef(0, i);
+        ASSERT_NE(poBlock, nullptr);
+        poBlock->DropLock();
+    }
+    GDALDatasetGetBlockCacheStatistics(hDS, &nCachedBytes, nullptr, &nMisses,
+                                       &nDirtyBytes);
+    EXPECT_LE(nCachedBytes, nQuota);
+    EXPECT_GT(nCachedBytes, 0);
+    EXPECT_EQ(nMisses, 100);
+    // The dirty block has been evicted, and thus written
+    EXPECT_EQ(nDirtyBytes, 0);
+
+    poDS->FlushCache(false);
+    poDS->DropCache();
+    GDALDatasetGetBlockCacheStatistics(hDS, &nCachedBytes, nullptr, nullptr,
+                                       nullptr);
+    EXPECT_EQ(nCachedBytes, 0);
+}
+
+// Test that GDAL_DATASET_CACHEMAX only evicts blocks of the dataset above
+// its quota
+TEST_F(test_gdal, GDAL_DATASET_CACHEMAX)
+{
+    GDALDatasetUniquePtr poOtherDS(
+        MEMDataset::Create("", 1000, 10, 1, GDT_Byte, nullptr));
+    GDALDatasetUniquePtr poDS(
+        MEMDataset::Create("", 1000, 100, 1, GDT_Byte, nullptr));
+    auto poOtherBand = poOtherDS->GetRasterBand(1);
+    auto poBand = poDS->GetRasterBand(1);
+
+    // The configuration option is read when the first block is cached
+    CPLConfigOptionSetter oSetter("GDAL_DATASET_CACHEMAX", "20000", false);
+    for (int i = 0; i < 10; ++i)
+    {
+        auto poBlock = poOtherBand->GetLockedBlockRef(0, i);
+        ASSERT_NE(poBlock, nullptr);
+        poBlock->DropLock();
+    }
+    poOtherDS->SetBlockCacheMax(0);
+    for (int i = 0; i < 100; ++i)
+    {
+        auto poBlock = poBand->GetLockedBlockRef(0, i);
+        ASSERT_NE(poBlock, nullptr);
+        poBlock->DropLock();
+    }
+    EXPECT_EQ(poDS->GetBlockCacheMax(), 20000);
+
+    GIntBig nCachedBytes = 0;
+    poDS->GetBlockCacheStatistics(&nCachedBytes, nullptr, nullptr, nullptr);
+    EXPECT_LE(nCachedBytes, 20000);
+    EXPECT_GT(nCachedBytes, 0);
+
+    // The most recently used blocks of the dataset are kept
+    auto poBlock = poBand->TryGetLockedBlockRef(0, 99);
+    EXPECT_NE(poBlock, nullptr);
+    if (poBlock)
+        poBlock->DropLock();
+
+    // and the blocks of the other dataset, older, are not evicted
+    for (int i = 0; i < 10; ++i)
+    {
+        poBlock = poOtherBand->TryGetLockedBlockRef(0, i);
+        EXPECT_NE(poBlock, nullptr);
+        if (poBlock)
+            poBlock->DropLock();
+    }
+}
+
+// Test reading with GDAL_BLOCK_PREFETCH
+TEST_F(test_gdal, GDAL_BLOCK_PREFETCH)
+{
+    auto poDrv = GetGDALDriverManager()->GetDriverByName("GTiff");
+    if (!poDrv)
+    {
+        GTEST_SKIP() << "GTiff driver missing";
+    }
+
+    constexpr int SIZE = 256;
+    constexpr int BLOCK_SIZE = 16;
+    const char *pszFilename = "/vsimem/test_gdal_block_prefetch.tif";
+    {
+        CPLStringList aosOptions;
+        aosOptions.SetNameValue("TILED", "YES");
+        aosOptions.SetNameValue("BLOCKXSIZE", CPLSPrintf("%d", BLOCK_SIZE));
+        aosOptions.SetNameValue("BLOCKYSIZE", CPLSPrintf("%d", BLOCK_SIZE));
+        std::unique_ptr<GDALDataset> poDS(poDrv->Create(
+            pszFilename, SIZE, SIZE, 1, GDT_Byte, aosOptions.List()));
+        ASSERT_NE(poDS, nullptr);
+        std::vector<GByte> abyData(SIZE * SIZE);
+        for (int i = 0; i < SIZE * SIZE; ++i)
+            abyData[i] = static_cast<GByte>((i / SIZE) * 7 + (i % SIZE));
+        ASSERT_EQ(poDS->GetRasterBand(1)->RasterIO(
+                      GF_Write, 0, 0, SIZE, SIZE, abyData.data(), SIZE, SIZE,
+                      GDT_Byte, 0, 0, nullptr),
+                  CE_None);
+        const int nOvrFactor = 2;
+        ASSERT_EQ(poDS->BuildOverviews("NEAREST", 1, &nOvrFactor, 0, nullptr,
+                                       nullptr, nullptr, nullptr),
+                  CE_None);
+    }
+
+    for (int iIter = 0; iIter < 2; ++iIter)
+    {
+        CPLConfigOptionSetter oSetter("GDAL_BLOCK_PREFETCH", "4", false);
+        GDALDatasetUniquePtr poDS(GDALDataset::Open(pszFilename));
+        ASSERT_NE(poDS, nullptr);
+        auto poBand = poDS->GetRasterBand(1);
+        if (iIter == 0)
+        {
+            // Once a stride has been seen twice, the next blocks are read
+            // ahead.
+            for (int nXBlock = 0; nXBlock < 3; ++nXBlock)
+            {
+                GDALRasterBlock *poBlock =
+                    poBand->GetLockedBlockRef(nXBlock, 0);
+                ASSERT_NE(poBlock, nullptr);
+                EXPECT_FALSE(poBlock->IsPrefetched());
+                poBlock->DropLock();
+            }
+            GDALRasterBlock *poPrefetchedBlock = nullptr;
+            for (int i = 0; i < 500 && !poPrefetchedBlock; ++i)
+            {
+                poPrefetchedBlock = poBand->TryGetLockedBlockRef(3, 0);
+                if (!poPrefetchedBlock)
+                    CPLSleep(0.01);
+            }
+            ASSERT_NE(poPrefetchedBlock, nullptr);
+            EXPECT_TRUE(poPrefetchedBlock->IsPrefetched());
+            poPrefetchedBlock->DropLock();
+
+            // Sequential block access
+            for (int nYBlock = 0; nYBlock < SIZE / BLOCK_SIZE; ++nYBlock)
+            {
+                for (int nXBlock = 0; nXBlock < SIZE / BLOCK_SIZE; ++nXBlock)
+                {
+                    GDALRasterBlock *poBlock =
+                        poBand->GetLockedBlockRef(nXBlock, nYBlock);
+                    ASSERT_NE(poBlock, nullptr);
+                    const GByte *pabyData =
+                        static_cast<const GByte *>(poBlock->GetDataRef());
+                    for (int j = 0; j < BLOCK_SIZE; ++j)
+                    {
+                        for (int i = 0; i < BLOCK_SIZE; ++i)
+                        {
+                            const int nY = nYBlock * BLOCK_SIZE + j;
+                            const int nX = nXBlock * BLOCK_SIZE + i;
+                            ASSERT_EQ(pabyData[j * BLOCK_SIZE + i],
+                                      static_cast<GByte>(nY * 7 + nX));
+                        }
+                    }
+                    poBlock->DropLock();
+                }
+            }
+        }
+        else
+        {
+            // Line by line RasterIO() requests, interleaved with ones on
+            // the overview, which shares the TIFF handle of the main dataset
+            // and is thus not read ahead, and close the dataset while
+            // prefetch jobs might still be pending.
+            auto poOvrBand = poBand->GetOverview(0);
+            ASSERT_NE(poOvrBand, nullptr);
+            int nOvrBlockXSize = 0;
+            int nOvrBlockYSize = 0;
+            poOvrBand->GetBlockSize(&nOvrBlockXSize, &nOvrBlockYSize);
+            if (nOvrBlockXSize * 4 <= SIZE / 2)
+            {
+                for (int nXBlock = 0; nXBlock < 3; ++nXBlock)
+                {
+                    GDALRasterBlock *poBlock =
+                        poOvrBand->GetLockedBlockRef(nXBlock, 0);
+                    ASSERT_NE(poBlock, nullptr);
+                    poBlock->DropLock();
+                }
+                CPLSleep(0.1);
+                EXPECT_EQ(poOvrBand->TryGetLockedBlockRef(3, 0), nullptr);
+            }
+            std::vector<GByte> abyLine(SIZE);
+            for (int nY = 0; nY < SIZE / 2; ++nY)
+            {
+                ASSERT_EQ(poBand->RasterIO(GF_Read, 0, nY, SIZE, 1,
+                                           abyLine.data(), SIZE, 1, GDT_Byte,
+                                           0, 0, nullptr),
+                          CE_None);
+                for (int nX = 0; nX < SIZE; ++nX)
+                {
+                    ASSERT_EQ(abyLine[nX], static_cast<GByte>(nY * 7 + nX));
+                }
+                ASSERT_EQ(poOvrBand->RasterIO(GF_Read, 0, nY / 2, SIZE / 2, 1,
+                                              abyLine.data(), SIZE / 2, 1,
+                                              GDT_Byte, 0, 0, nullptr),
+                          CE_None);
+                for (int nX = 0; nX < SIZE / 2; ++nX)
+                {
+                    ASSERT_EQ(abyLine[nX],
+                              static_cast<GByte>((nY / 2) * 2 * 7 + nX * 2));
+                }
+            }
+        }
+    }
+
+    VSIUnlink(pszFilename);
+}
+
+// Test that multi-threaded ComputeStatistics(), ComputeRasterMinMax() and
+// GetHistogram() give the same results as the single-threaded versions
+TEST_F(test_gdal, ComputeStatistics_GDAL_NUM_THREADS)
+{
+    constexpr int SIZE_X = 1000;
+    constexpr int SIZE_Y = 500;
+    std::unique_ptr<GDALDataset> poDS(
+        MEMDataset::Create("", SIZE_X, SIZE_Y, 0, GDT_Byte, nullptr));
+    for (const GDALDataType eDT : {GDT_Byte, GDT_UInt16, GDT_Int16,
+                                   GDT_Float32, GDT_Float64})
+    {
+        ASSERT_EQ(poDS->AddBand(eDT, nullptr), CE_None);
+    }
+    // Last band with a mask band
+    ASSERT_EQ(poDS->AddBand(GDT_Float32, nullptr), CE_None);
+    const int nBands = poDS->GetRasterCount();
+    auto poMaskedBand = poDS->GetRasterBand(nBands);
+    ASSERT_EQ(poMaskedBand->CreateMaskBand(0), CE_None);
+
+    std::vector<double> adfData(SIZE_X * SIZE_Y);
+    std::vector<GByte> abyMask(SIZE_X * SIZE_Y);
+    unsigned nSeed = 1;
+    for (int i = 0; i < SIZE_X * SIZE_Y; ++i)
+    {
+        nSeed = nSeed * 1103515245U + 12345U;
+        adfData[i] = (nSeed >> 16) % 251 + ((nSeed >> 8) & 0xFF) / 256.0;
+        abyMask[i] = (i % 7) != 0 ? 255 : 0;
+    }
+    for (int iBand = 1; iBand <= nBands; ++iBand)
+    {
+        ASSERT_EQ(poDS->GetRasterBand(iBand)->RasterIO(
+                      GF_Write, 0, 0, SIZE_X, SIZE_Y, adfData.data(), SIZE_X,
+                      SIZE_Y, GDT_Float64, 0, 0, nullptr),
+                  CE_None);
+    }
+    poDS->GetRasterBand(1)->SetNoDataValue(0);
+    ASSERT_EQ(poMaskedBand->GetMaskBand()->RasterIO(
+                  GF_Write, 0, 0, SIZE_X, SIZE_Y, abyMask.data(), SIZE_X,
+                  SIZE_Y, GDT_Byte, 0, 0, nullptr),
+              CE_None);
+
+    struct Results
+    {
+        double adfStats[4] = {0, 0, 0, 0};
+        double adfMinMax[2] = {0, 0};
+        std::vector<GUIntBig> anHistogram = std::vector<GUIntBig>(256);
+    };
+
+    const auto compute = [&poDS, nBands](const char *pszThreads)
+    {
+        CPLConfigOptionSetter oSetter("GDAL_NUM_THREADS", pszThreads, false);
+        std::vector<Results> aoResults(nBands);
+        for (int iBand = 1; iBand <= nBands; ++iBand)
+        {
+            auto poBand = poDS->GetRasterBand(iBand);
+            auto &oRes = aoResults[iBand - 1];
+            EXPECT_EQ(poBand->ComputeStatistics(
+                          false, &oRes.adfStats[0], &oRes.adfStats[1],
+                          &oRes.adfStats[2], &oRes.adfStats[3], nullptr,
+                          nullptr),
+                      CE_None);
+            EXPECT_EQ(poBand->ComputeRasterMinMax(false, oRes.adfMinMax),
+                      CE_None);
+            EXPECT_EQ(poBand->GetHistogram(-0.5, 255.5, 256,
+                                           oRes.anHistogram.data(), false,
+                                           false, nullptr, nullptr),
+                      CE_None);
+        }
+        return aoResults;
+    };
+
+    const auto aoRef = compute("1");
+    for (const char *pszThreads : {"2", "4"})
+    {
+        const auto aoRes = compute(pszThreads);
+        for (int iBand = 0; iBand < nBands; ++iBand)
+        {
+            SCOPED_TRACE(CPLSPrintf("band %d, %s threads", iBand + 1,
+                                    pszThreads));
+            EXPECT_EQ(aoRes[iBand].adfStats[0], aoRef[iBand].adfStats[0]);
+            EXPECT_EQ(aoRes[iBand].adfStats[1], aoRef[iBand].adfStats[1]);
+            EXPECT_EQ(aoRes[iBand].adfStats[2], aoRef[iBand].adfStats[2]);
+            EXPECT_EQ(aoRes[iBand].adfStats[3], aoRef[iBand].adfStats[3]);
+            EXPECT_EQ(aoRes[iBand].adfMinMax[0], aoRef[iBand].adfMinMax[0]);
+            EXPECT_EQ(aoRes[iBand].adfMinMax[1], aoRef[iBand].adfMinMax[1]);
+            EXPECT_EQ(aoRes[iBand].anHistogram, aoRef[iBand].anHistogram);
+        }
+    }
+}
+
+// Test GDALDataset::ComputeStatistics() and GDALDataset::GetHistogram()
+TEST_F(test_gdal, GDALDatasetComputeStatistics)
+{
+    auto poDrv = GetGDALDriverManager()->GetDriverByName("GTiff");
+    if (!poDrv)
+    {
+        GTEST_SKIP() << "GTiff driver missing";
+    }
+
+    constexpr int SIZE_X = 300;
+    constexpr int SIZE_Y = 200;
+    const char *pszFilename = "/vsimem/test_gdal_dataset_compute_stats.tif";
+    for (const GDALDataType eDT :
+         {GDT_Byte, GDT_UInt16, GDT_Int16, GDT_Float32})
+    {
+        SCOPED_TRACE(GDALGetDataTypeName(eDT));
+        {
+            CPLStringList aosOptions;
+            aosOptions.SetNameValue("TILED", "YES");
+            aosOptions.SetNameValue("BLOCKXSIZE", "64");
+            aosOptions.SetNameValue("BLOCKYSIZE", "64");
+            aosOptions.SetNameValue("INTERLEAVE", "PIXEL");
+            std::unique_ptr<GDALDataset> poDS(poDrv->Create(
+                pszFilename, SIZE_X, SIZE_Y, 3, eDT, aosOptions.List()));
+            ASSERT_NE(poDS, nullptr);
+            std::vector<double> adfData(SIZE_X * SIZE_Y * 3);
+            for (size_t i = 0; i < adfData.size(); ++i)
+                adfData[i] = static_cast<double>((i * 37) % 251);
+            ASSERT_EQ(poDS->RasterIO(GF_Write, 0, 0, SIZE_X, SIZE_Y,
+                                     adfData.data(), SIZE_X, SIZE_Y,
+                                     GDT_Float64, 3, nullptr, 0, 0, 0,
+                                     nullptr),
+                      CE_None);
+            poDS->GetRasterBand(2)->SetNoDataValue(0);
+        }
+
+        GDALDatasetUniquePtr poDS(GDALDataset::Open(pszFilename));
+        ASSERT_NE(poDS, nullptr);
+        double adfMin[3], adfMax[3], adfMean[3], adfStdDev[3];
+        double adfDefaultHistMin[3], adfDefaultHistMax[3];
+        int anDefaultHistBuckets[3];
+        GUIntBig *apanDefaultHistograms[3];
+        ASSERT_EQ(poDS->ComputeStatistics(
+                      false, 0, nullptr, adfMin, adfMax, adfMean, adfStdDev,
+                      adfDefaultHistMin, adfDefaultHistMax,
+                      anDefaultHistBuckets, apanDefaultHistograms, nullptr,
+                      nullptr),
+                  CE_None);
+        std::vector<std::vector<GUIntBig>> aanDefaultHistograms;
+        for (int i = 0; i < 3; ++i)
+        {
+            ASSERT_NE(apanDefaultHistograms[i], nullptr);
+            ASSERT_EQ(anDefaultHistBuckets[i], 256);
+            aanDefaultHistograms.emplace_back(apanDefaultHistograms[i],
+                                              apanDefaultHistograms[i] + 256);
+            VSIFree(apanDefaultHistograms[i]);
+        }
+
+        std::vector<std::vector<GUIntBig>> aanHistograms(
+            3, std::vector<GUIntBig>(100));
+        GUIntBig *apanHistograms[] = {aanHistograms[0].data(),
+                                      aanHistograms[1].data(),
+                                      aanHistograms[2].data()};
+        const double adfHistMin[] = {-0.5, 0.5, 10};
+        const double adfHistMax[] = {255.5, 250.5, 200};
+        ASSERT_EQ(poDS->GetHistogram(0, nullptr, adfHistMin, adfHistMax, 100,
+                                     apanHistograms, true, false, nullptr,
+                                     nullptr),
+                  CE_None);
+        poDS.reset();
+
+        // The histograms have been stored in the .aux.xml file by
+        // GDALPamRasterBand::GetHistogram()
+        poDS.reset(GDALDataset::Open(pszFilename));
+        ASSERT_NE(poDS, nullptr);
+        for (int i = 0; i < 3; ++i)
+        {
+            double dfMin = 0, dfMax = 0;
+            int nBuckets = 0;
+            GUIntBig *panHistogram = nullptr;
+            EXPECT_EQ(poDS->GetRasterBand(i + 1)->GetDefaultHistogram(
+                          &dfMin, &dfMax, &nBuckets, &panHistogram, false,
+                          nullptr, nullptr),
+                      CE_None);
+            EXPECT_EQ(nBuckets, 256);
+            VSIFree(panHistogram);
+        }
+        poDS.reset();
+
+        // Compare with the results computed band per band
+        VSIUnlink(std::string(pszFilename).append(".aux.xml").c_str());
+        poDS.reset(GDALDataset::Open(pszFilename));
+        ASSERT_NE(poDS, nullptr);
+        for (int i = 0; i < 3; ++i)
+        {
+            SCOPED_TRACE(CPLSPrintf("band %d", i + 1));
+            auto poBand = poDS->GetRasterBand(i + 1);
+            double dfMin = 0, dfMax = 0, dfMean = 0, dfStdDev = 0;
+            ASSERT_EQ(poBand->ComputeStatistics(false, &dfMin, &dfMax, &dfMean,
+                                                &dfStdDev, nullptr, nullptr),
+                      CE_None);
+            EXPECT_EQ(adfMin[i], dfMin);
+            EXPECT_EQ(adfMax[i], dfMax);
+            EXPECT_EQ(adfMean[i], dfMean);
+            EXPECT_EQ(adfStdDev[i], dfStdDev);
+
+            std::vector<GUIntBig> anDefaultHistogram(256);
+            ASSERT_EQ(poBand->GetHistogram(
+                          adfDefaultHistMin[i], adfDefaultHistMax[i], 256,
+                          anDefaultHistogram.data(), true, false, nullptr,
+                          nullptr),
+                      CE_None);
+            EXPECT_EQ(aanDefaultHistograms[i], anDefaultHistogram);
+
+            std::vector<GUIntBig> anHistogram(100);
+            ASSERT_EQ(poBand->GetHistogram(adfHistMin[i], adfHistMax[i], 100,
+                                           anHistogram.data(), true, false,
+                                           nullptr, nullptr),
+                      CE_None);
+            EXPECT_EQ(aanHistograms[i], anHistogram);
+        }
+
+        // Invalid band number
+        const int nBand = 4;
+        CPLErrorStateBackuper oErrorHandler(CPLQuietErrorHandler);
+        EXPECT_EQ(poDS->ComputeStatistics(false, 1, &nBand, nullptr, nullptr,
+                                          nullptr, nullptr, nullptr, nullptr,
+                                          nullptr, nullptr, nullptr, nullptr),
+                  CE_Failure);
+    }
+
+    VSIUnlink(pszFilename);
+    VSIUnlink(std::string(pszFilename).append(".aux.xml").c_str());
+}
+
 }  // namespace
@@ -1171,6 +1171,69 @@ void CheckPacked<GUInt16, GInt16>(GDALDataType eIn, GDALDataType eOut)
     }
 }
 
+template <>
+void CheckPacked<double, GByte>(GDALDataType eIn, GDALDataType eOut)
+{
+    CheckPackedGeneric<double, GByte>(eIn, eOut);
+
+    const int N = 64 + 7;
+    // 13 values, so that NaN and infinities land in every lane of the
+    // vectors, and in the scalar tail
+    const double adfValues[] = {-cpl::NumericLimits<double>::infinity(),
+                                cpl::NumericLimits<double>::quiet_NaN(),
+                                -1.0,
+                                -0.5,
+                                0.49,
+                                0.5,
+                                254.5,
+                                255.0,
+                                255.5,
+                                1e10,
+                                cpl::NumericLimits<double>::infinity(),
+                                -cpl::NumericLimits<double>::quiet_NaN(),
+                                -0.0};
+    const int anExpected[] = {0, 0, 0, 0, 0, 1, 255, 255, 255, 255, 255, 0, 0};
+    static_assert(CPL_ARRAYSIZE(adfValues) == CPL_ARRAYSIZE(anExpected));
+    constexpr int nValues = static_cast<int>(CPL_ARRAYSIZE(adfValues));
+    double arrayIn[N] = {0};
+    GByte arrayOut[N] = {0};
+    for (int i = 0; i < N; i++)
+    {
+        arrayIn[i] = adfValues[i % nValues];
+    }
+    GDALCopyWords(arrayIn, eIn, GDALGetDataTypeSizeBytes(eIn), arrayOut, eOut,
+                  GDALGetDataTypeSizeBytes(eOut), N);
+    for (int i = 0; i < N; i++)
+    {
+        // Exact comparison: AssertRes() tolerates an error of 1
+        EXPECT_EQ(arrayOut[i], anExpected[i % nValues])
+            << "i=" << i << ", inval=" << arrayIn[i];
+    }
+}
+
+template <>
+void CheckPacked<GInt32, float>(GDALDataType eIn, GDALDataType eOut)
+{
+    CheckPackedGeneric<GInt32, float>(eIn, eOut);
+
+    const int N = 64 + 7;
+    GInt32 arrayIn[N] = {0};
+    float arrayOut[N] = {0};
+    for (int i = 0; i < N; i++)
+    {
+        // Values not exactly representable as float
+        arrayIn[i] = (i % 2) == 0 ? (1 << 24) + 1 + i : -(1 << 30) - 1 - i;
+    }
+    GDALCopyWords(arrayIn, eIn, GDALGetDataTypeSizeBytes(eIn), arrayOut, eOut,
+                  GDALGetDataTypeSizeBytes(eOut), N);
+    int numLine = 0;
+    for (int i = 0; i < N; i++)
+    {
+        MY_EXPECT(eIn, arrayIn[i], eOut, static_cast<float>(arrayIn[i]),
+                  arrayOut[i]);
+    }
+}
+
 template <class Tin> void CheckPacked(GDALDataType eIn, GDALDataType eOut)
 {
     switch (eOut)
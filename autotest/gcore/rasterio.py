@@ -13,6 +13,7 @@
 ###############################################################################
 
 import math
+import random
 import struct
 import sys
 
@@ -3260,6 +3261,82 @@ def test_rasterio_rms_halfsize_downsampling_cfloat32():
     assert ovr_data == data
 
 
+###############################################################################
+# Test the fast path of average/RMS/mode downsampling by an integer factor,
+# against the overview code, for all non-complex data types
+
+
+@pytest.mark.parametrize(
+    "dt,struct_type,max_val",
+    [
+        (gdal.GDT_Byte, "B", 255),
+        (gdal.GDT_Int8, "b", 127),
+        (gdal.GDT_UInt16, "H", 65535),
+        (gdal.GDT_Int16, "h", 32767),
+        (gdal.GDT_UInt32, "I", 100000),
+        (gdal.GDT_Int32, "i", 100000),
+        (gdal.GDT_UInt64, "Q", 100000),
+        (gdal.GDT_Int64, "q", 100000),
+        (gdal.GDT_Float32, "f", 1000),
+        (gdal.GDT_Float64, "d", 1000),
+    ],
+)
+@pytest.mark.parametrize(
+    "resample_alg,resampling",
+    [
+        (gdal.GRIORA_Average, "AVERAGE"),
+        (gdal.GRIORA_RMS, "RMS"),
+        (gdal.GRIORA_Mode, "MODE"),
+    ],
+)
+@pytest.mark.parametrize("factor", [2, 3, 4, 8])
+def test_rasterio_downsampling_integer_factor(
+    dt, struct_type, max_val, resample_alg, resampling, factor
+):
+
+    rng = random.Random(factor)
+    if resampling == "MODE":
+        # Few distinct values to exercise ties
+        max_val = 3
+    xsize = 37 * factor
+    ysize = 11 * factor
+    ds = gdal.GetDriverByName("MEM").Create("", xsize, ysize, 1, dt)
+    ds.WriteRaster(
+        0,
+        0,
+        xsize,
+        ysize,
+        struct.pack(
+            struct_type * (xsize * ysize),
+            *[rng.randint(0, max_val) for _ in range(xsize * ysize)],
+        ),
+    )
+
+    ref_ds = gdal.GetDriverByName("MEM").CreateCopy("", ds)
+    ref_ds.BuildOverviews(resampling, [factor])
+    ovr_band = ref_ds.GetRasterBand(1).GetOverview(0)
+    assert ovr_band.XSize == 37
+    assert ovr_band.YSize == 11
+
+    data = ds.GetRasterBand(1).ReadRaster(
+        buf_xsize=37, buf_ysize=11, resample_alg=resample_alg
+    )
+    assert data == ovr_band.ReadRaster()
+
+    # Sub-window, with a data type conversion
+    data = ds.GetRasterBand(1).ReadRaster(
+        3 * factor,
+        2 * factor,
+        30 * factor,
+        8 * factor,
+        buf_xsize=30,
+        buf_ysize=8,
+        buf_type=gdal.GDT_Float64,
+        resample_alg=resample_alg,
+    )
+    assert data == ovr_band.ReadRaster(3, 2, 30, 8, buf_type=gdal.GDT_Float64)
+
+
 ###############################################################################
 # Test WriteRaster() on a bytearray
 
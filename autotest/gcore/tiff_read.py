@@ -1204,6 +1204,95 @@ def test_tiff_read_vsicurl_multirange():
         gdal.VSICurlClearCache()
 
 
+###############################################################################
+# Test that ranges of a multi-range request separated by less than
+# GDAL_HTTP_MULTIRANGE_MAX_GAP bytes are fetched with a single request, and
+# that GDAL_HTTP_MULTIRANGE_MAX_IN_FLIGHT_BYTES does not affect the result
+
+
+@pytest.mark.require_curl()
+@pytest.mark.parametrize(
+    "max_gap,max_in_flight_bytes", [("0", "1"), ("65536", "16777216")]
+)
+def test_tiff_read_vsicurl_multirange_max_gap(max_gap, max_in_flight_bytes):
+
+    (webserver_process, webserver_port) = webserver.launch(
+        handler=webserver.DispatcherHttpHandler
+    )
+    if webserver_port == 0:
+        pytest.skip()
+
+    filesize = 262976
+
+    class RangeRecordingHandler:
+        def __init__(self):
+            self.ranges = []
+
+        def final_check(self):
+            pass
+
+        def do_HEAD(self, request):
+            request.send_response(200)
+            request.send_header("Content-Length", "%d" % filesize)
+            request.end_headers()
+
+        def do_GET(self, request):
+            rng = request.headers["Range"][len("bytes=") :]
+            start = int(rng.split("-")[0])
+            end = int(rng.split("-")[1])
+            self.ranges.append((start, end))
+
+            request.protocol_version = "HTTP/1.1"
+            request.send_response(206)
+            request.send_header("Content-type", "application/octet-stream")
+            request.send_header(
+                "Content-Range", "bytes %d-%d/%d" % (start, end, filesize)
+            )
+            request.send_header("Content-Length", end - start + 1)
+            request.send_header("Connection", "close")
+            request.end_headers()
+            with open("../gdrivers/data/utm.tif", "rb") as f:
+                f.seek(start, 0)
+                request.wfile.write(f.read(end - start + 1))
+
+    gdal.VSICurlClearCache()
+
+    try:
+        handler = RangeRecordingHandler()
+        with webserver.install_http_handler(handler), gdaltest.config_options(
+            {
+                "GTIFF_DIRECT_IO": "YES",
+                "CPL_VSIL_CURL_ALLOWED_EXTENSIONS": ".tif",
+                "GDAL_DISABLE_READDIR_ON_OPEN": "EMPTY_DIR",
+                "GDAL_HTTP_MULTIRANGE_MAX_GAP": max_gap,
+                "GDAL_HTTP_MULTIRANGE_MAX_IN_FLIGHT_BYTES": max_in_flight_bytes,
+            }
+        ):
+            ds = gdal.Open("/vsicurl/http://127.0.0.1:%d/utm.tif" % webserver_port)
+            assert ds is not None, "could not open dataset"
+            nranges_at_open = len(handler.ranges)
+
+            # Read subsampled data: rows 0, 8, 16 and 24 of the single strip
+            subsampled_data = ds.ReadRaster(0, 0, 512, 32, 128, 4)
+            ds = None
+
+        ranges = handler.ranges[nranges_at_open:]
+        if max_gap == "0":
+            assert len(ranges) > 1
+        else:
+            assert len(ranges) == 1
+            assert ranges[0][1] - ranges[0][0] + 1 < 65536
+
+        ds = gdal.GetDriverByName("MEM").Create("", 128, 4)
+        ds.WriteRaster(0, 0, 128, 4, subsampled_data)
+        assert ds.GetRasterBand(1).Checksum() == 6429
+
+    finally:
+        webserver.server_stop(webserver_process, webserver_port)
+
+        gdal.VSICurlClearCache()
+
+
 ###############################################################################
 # Test reading a TIFF made of a single-strip that is more than 2GB (#5403)
 
@@ -12075,3 +12075,50 @@ def test_tiff_write_5_bands_interleaved_predictor_2(tmp_vsimem):
     with gdal.Open(tmp_vsimem / "test.tif") as ds:
         content = ds.ReadRaster()
         assert ref_content == content, struct.unpack("B" * 10, content)
+
+
+###############################################################################
+# Test writing and reading with CPL_VSIL_LOCAL_DIRECT_IO=YES
+
+
+@pytest.mark.skipif(sys.platform == "win32", reason="Unix specific test")
+def test_tiff_write_direct_io(tmp_path):
+    if not gdaltest.filesystem_supports_direct_io(tmp_path):
+        pytest.skip("O_DIRECT not supported on this file system")
+
+    src_ds = gdal.Open("data/byte.tif")
+    filename = str(tmp_path / "test.tif")
+    with gdal.config_option("CPL_VSIL_LOCAL_DIRECT_IO", "YES"):
+        gdal.GetDriverByName("GTiff").CreateCopy(
+            filename, src_ds, options=["TILED=YES", "BLOCKXSIZE=16", "BLOCKYSIZE=16"]
+        )
+        with gdal.Open(filename, gdal.GA_Update) as ds:
+            ds.GetRasterBand(1).Fill(1)
+            ds.GetRasterBand(1).WriteRaster(0, 0, 20, 20, src_ds.ReadRaster())
+        with gdal.Open(filename) as ds:
+            assert ds.GetRasterBand(1).Checksum() == 4672
+    with gdal.Open(filename) as ds:
+        assert ds.GetRasterBand(1).Checksum() == 4672
+
+
+###############################################################################
+# Test multi-threaded decoding with CPL_VSIL_LOCAL_DIRECT_IO=YES, which uses
+# PRead()
+
+
+@pytest.mark.skipif(sys.platform == "win32", reason="Unix specific test")
+def test_tiff_write_direct_io_multithreaded_read(tmp_path):
+
+    if not gdaltest.filesystem_supports_direct_io(tmp_path):
+        pytest.skip("O_DIRECT not supported on this file system")
+
+    filename = str(tmp_path / "test.tif")
+    gdal.Translate(
+        filename,
+        "data/byte.tif",
+        creationOptions=["TILED=YES", "BLOCKXSIZE=16", "BLOCKYSIZE=16", "COMPRESS=LZW"],
+    )
+    with gdal.config_options(
+        {"CPL_VSIL_LOCAL_DIRECT_IO": "YES", "GDAL_NUM_THREADS": "2"}
+    ), gdal.Open(filename) as ds:
+        assert ds.GetRasterBand(1).Checksum() == 4672
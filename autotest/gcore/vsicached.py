@@ -117,3 +117,64 @@ def test_vsicached_readdir_error():
 
     with gdal.quiet_errors():
         assert gdal.ReadDir("/vsicached?") is None
+
+
+def test_vsicached_shared(tmp_vsimem):
+
+    filename = str(tmp_vsimem / "test_vsicached_shared.bin")
+    content = bytes(range(256)) * 1000
+    gdal.FileFromMemBuffer(filename, content)
+
+    cached_filename = "/vsicached?shared=yes&chunk_size=1KB&file=" + filename
+    with gdal.VSIFile(cached_filename, "rb") as f1, gdal.VSIFile(
+        cached_filename, "rb"
+    ) as f2:
+        assert f1.read() == content
+        f2.seek(1000)
+        assert f2.read(5000) == content[1000:6000]
+        f2.seek(len(content) - 10)
+        assert f2.read(100) == content[-10:]
+
+    # A file of different size does not reuse chunks of the previous one
+    content = b"x" * 5000
+    gdal.FileFromMemBuffer(filename, content)
+    with gdal.VSIFile(cached_filename, "rb") as f:
+        assert f.read() == content
+
+
+def test_vsicached_shared_same_size_rewrite(tmp_vsimem, tmp_path):
+
+    for filename in (str(tmp_vsimem / "test.bin"), str(tmp_path / "test.bin")):
+        cached_filename = "/vsicached?shared=yes&chunk_size=1KB&file=" + filename
+
+        with gdal.VSIFile(filename, "wb") as f:
+            f.write(b"a" * 5000)
+        with gdal.VSIFile(cached_filename, "rb") as f:
+            assert f.read() == b"a" * 5000
+
+        # Rewritten with the same size, likely within the same second
+        with gdal.VSIFile(filename, "wb") as f:
+            f.write(b"b" * 5000)
+        with gdal.VSIFile(cached_filename, "rb") as f:
+            assert f.read() == b"b" * 5000
+
+        # Updated in place
+        with gdal.VSIFile(filename, "rb+") as f:
+            f.seek(1000)
+            f.write(b"c")
+        with gdal.VSIFile(cached_filename, "rb") as f:
+            assert f.read(1001)[1000:] == b"c"
+
+
+def test_vsicached_shared_read_larger_than_cache(tmp_vsimem):
+
+    filename = str(tmp_vsimem / "test.bin")
+    content = bytes(range(256)) * 1000
+    gdal.FileFromMemBuffer(filename, content)
+
+    cached_filename = "/vsicached?shared=yes&chunk_size=1KB&file=" + filename
+    with gdal.config_option("VSI_SHARED_CACHE_SIZE", "64KB"):
+        with gdal.VSIFile(cached_filename, "rb") as f:
+            assert f.read() == content
+            f.seek(100)
+            assert f.read(1000) == content[100:1100]
@@ -11,6 +11,9 @@
 # SPDX-License-Identifier: MIT
 ###############################################################################
 
+import gzip
+import json
+import os
 import sys
 import time
 
@@ -1678,3 +1681,332 @@ def test_vsicurl_GDAL_HTTP_MAX_TOTAL_CONNECTIONS(server):
         full_filename = f"/vsicurl/http://localhost:{server.port}/test.bin"
         statres = gdal.VSIStatL(full_filename)
         assert statres.size == 3
+
+
+###############################################################################
+# Test background readahead of sequential reads
+
+
+@pytest.mark.parametrize("readahead_max_size", [None, "0", "8MB"])
+def test_vsicurl_readahead(server, readahead_max_size):
+
+    gdal.VSICurlClearCache()
+
+    filesize = 12 * 1024 * 1024
+    content = (bytes(range(251)) * (filesize // 251 + 1))[:filesize]
+
+    class RangeRecordingHandler:
+        def __init__(self):
+            self.ranges = []
+
+        def final_check(self):
+            pass
+
+        def do_HEAD(self, request):
+            request.send_response(200)
+            request.send_header("Content-Length", "%d" % filesize)
+            request.end_headers()
+
+        def do_GET(self, request):
+            rng = request.headers["Range"][len("bytes=") :]
+            start = int(rng.split("-")[0])
+            end = min(int(rng.split("-")[1]), filesize - 1)
+            self.ranges.append((start, end))
+
+            request.protocol_version = "HTTP/1.1"
+            request.send_response(206)
+            request.send_header(
+                "Content-Range", "bytes %d-%d/%d" % (start, end, filesize)
+            )
+            request.send_header("Content-Length", end - start + 1)
+            request.send_header("Connection", "close")
+            request.end_headers()
+            request.wfile.write(content[start : end + 1])
+
+    handler = RangeRecordingHandler()
+    with webserver.install_http_handler(handler), gdal.config_options(
+        {
+            "GDAL_DISABLE_READDIR_ON_OPEN": "EMPTY_DIR",
+            "CPL_VSIL_CURL_READAHEAD_MAX_SIZE": readahead_max_size,
+        }
+    ):
+        with gdal.VSIFile(
+            f"/vsicurl/http://localhost:{server.port}/test_readahead.bin", "rb"
+        ) as f:
+            data = b""
+            while True:
+                chunk = f.read(1024 * 1024)
+                if not chunk:
+                    break
+                data += chunk
+    assert data == content
+
+    max_request_size = max(end - start + 1 for start, end in handler.ranges)
+    if readahead_max_size == "0":
+        assert max_request_size <= 2 * 1024 * 1024
+    elif readahead_max_size == "8MB":
+        # Two windows of at most 4 MB each
+        assert max_request_size == 4 * 1024 * 1024
+    else:
+        assert max_request_size > 2 * 1024 * 1024
+
+    gdal.VSICurlClearCache()
+
+
+###############################################################################
+# Test that /vsigzip/ does not look for a .gz.idx file on network file systems
+# by default
+
+
+@pytest.mark.parametrize("gzip_index,idx_requested", [(None, False), ("YES", True)])
+def test_vsicurl_vsigzip_index_lookup(server, gzip_index, idx_requested):
+
+    gdal.VSICurlClearCache()
+
+    content = gzip.compress(b"hello world")
+
+    class PathRecordingHandler:
+        def __init__(self):
+            self.paths = []
+
+        def final_check(self):
+            pass
+
+        def do_HEAD(self, request):
+            self.paths.append(request.path)
+            if request.path != "/test.gz":
+                request.send_response(404)
+                request.send_header("Content-Length", 0)
+                request.end_headers()
+                return
+            request.send_response(200)
+            request.send_header("Content-Length", "%d" % len(content))
+            request.end_headers()
+
+        def do_GET(self, request):
+            self.paths.append(request.path)
+            if request.path != "/test.gz":
+                request.send_response(404)
+                request.send_header("Content-Length", 0)
+                request.end_headers()
+                return
+            rng = request.headers["Range"][len("bytes=") :]
+            start = int(rng.split("-")[0])
+            end = min(int(rng.split("-")[1]), len(content) - 1)
+
+            request.protocol_version = "HTTP/1.1"
+            request.send_response(206)
+            request.send_header(
+                "Content-Range", "bytes %d-%d/%d" % (start, end, len(content))
+            )
+            request.send_header("Content-Length", end - start + 1)
+            request.send_header("Connection", "close")
+            request.end_headers()
+            request.wfile.write(content[start : end + 1])
+
+    handler = PathRecordingHandler()
+    with webserver.install_http_handler(handler), gdal.config_options(
+        {
+            "GDAL_DISABLE_READDIR_ON_OPEN": "EMPTY_DIR",
+            "CPL_VSIL_GZIP_INDEX": gzip_index,
+        }
+    ):
+        with gdal.VSIFile(
+            f"/vsigzip//vsicurl/http://localhost:{server.port}/test.gz", "rb"
+        ) as f:
+            assert f.read() == b"hello world"
+
+    assert any(path.endswith(".gz.idx") for path in handler.paths) == idx_requested
+
+    gdal.VSICurlClearCache()
+
+
+###############################################################################
+# Test parallel ranged reads in VSICopyFile()
+
+
+@pytest.mark.parametrize("num_threads", [None, "0"])
+def test_vsicurl_copyfile_parallel_ranges(server, tmp_vsimem, num_threads):
+
+    gdal.VSICurlClearCache()
+
+    chunk_size = 65536
+    filesize = 4 * chunk_size + 1000
+    content = (bytes(range(251)) * (filesize // 251 + 1))[:filesize]
+
+    class RangeRecordingHandler:
+        def __init__(self):
+            self.ranges = []
+
+        def final_check(self):
+            pass
+
+        def do_HEAD(self, request):
+            request.send_response(200)
+            request.send_header("Content-Length", "%d" % filesize)
+            request.end_headers()
+
+        def do_GET(self, request):
+            rng = request.headers["Range"][len("bytes=") :]
+            start = int(rng.split("-")[0])
+            end = min(int(rng.split("-")[1]), filesize - 1)
+            self.ranges.append((start, end))
+
+            request.protocol_version = "HTTP/1.1"
+            request.send_response(206)
+            request.send_header(
+                "Content-Range", "bytes %d-%d/%d" % (start, end, filesize)
+            )
+            request.send_header("Content-Length", end - start + 1)
+            request.send_header("Connection", "close")
+            request.end_headers()
+            request.wfile.write(content[start : end + 1])
+
+    handler = RangeRecordingHandler()
+    with webserver.install_http_handler(handler), gdal.config_options(
+        {
+            "GDAL_DISABLE_READDIR_ON_OPEN": "EMPTY_DIR",
+            "CPL_VSIL_COPYFILE_NUM_THREADS": num_threads,
+            "CPL_VSIL_COPYFILE_CHUNK_SIZE": str(chunk_size),
+        },
+        thread_local=False,
+    ):
+        assert (
+            gdal.CopyFile(
+                f"/vsicurl/http://localhost:{server.port}/test_copyfile.bin",
+                tmp_vsimem / "out.bin",
+            )
+            == 0
+        )
+
+        # The copy starts at the current position of the source handle
+        gdal.VSICurlClearCache()
+        f = gdal.VSIFOpenL(
+            f"/vsicurl/http://localhost:{server.port}/test_copyfile.bin", "rb"
+        )
+        assert f
+        try:
+            gdal.VSIFSeekL(f, 1000, 0)
+            assert (
+                gdal.CopyFile(
+                    f"/vsicurl/http://localhost:{server.port}/test_copyfile.bin",
+                    tmp_vsimem / "out2.bin",
+                    fpSource=f,
+                )
+                == 0
+            )
+        finally:
+            gdal.VSIFCloseL(f)
+
+    with gdal.VSIFile(tmp_vsimem / "out.bin", "rb") as f:
+        assert f.read() == content
+
+    with gdal.VSIFile(tmp_vsimem / "out2.bin", "rb") as f:
+        assert f.read() == content[1000:]
+
+    if num_threads is None:
+        # In parallel mode, each chunk is fetched by its own ranged request
+        starts = set(start for start, _ in handler.ranges)
+        for offset in range(0, filesize, chunk_size):
+            assert offset in starts
+
+    gdal.VSICurlClearCache()
+
+
+###############################################################################
+# Test CPL_VSIL_CURL_DISK_CACHE_DIR
+
+
+@gdaltest.enable_exceptions()
+def test_vsicurl_disk_cache(server, tmp_path):
+
+    cache_dir = tmp_path / "cache"
+
+    def read_file(filename, etag, content, with_get):
+        gdal.VSICurlClearCache()
+        handler = webserver.SequentialHandler()
+        handler.add(
+            "HEAD",
+            "/" + filename,
+            200,
+            {"Content-Length": str(len(content)), "ETag": '"%s"' % etag},
+        )
+        if with_get:
+            handler.add(
+                "GET",
+                "/" + filename,
+                200,
+                {"Content-Length": str(len(content)), "ETag": '"%s"' % etag},
+                content,
+            )
+        with webserver.install_http_handler(handler):
+            with gdal.VSIFile(
+                f"/vsicurl/http://localhost:{server.port}/{filename}", "rb"
+            ) as f:
+                assert f.read(len(content)).decode("ascii") == content
+
+    def get_cache_files(directory=cache_dir):
+        return [
+            os.path.join(root, f)
+            for root, _, files in os.walk(directory)
+            for f in files
+            if f != ".lock"
+        ]
+
+    gdal.NetworkStatsReset()
+    with gdal.config_options(
+        {
+            "CPL_VSIL_CURL_DISK_CACHE_DIR": str(cache_dir),
+            "CPL_VSIL_NETWORK_STATS_ENABLED": "YES",
+            "GDAL_DISABLE_READDIR_ON_OPEN": "EMPTY_DIR",
+        },
+        thread_local=False,
+    ):
+        read_file("test.bin", "etag1", "foobar", with_get=True)
+        assert len(get_cache_files()) == 1
+
+        # Served from the disk cache
+        read_file("test.bin", "etag1", "foobar", with_get=False)
+
+        j = json.loads(gdal.NetworkStatsGetAsSerializedJSON())
+        assert j["disk_cache"] == {"hit_count": 1, "miss_count": 1, "read_bytes": 6}
+        assert j["methods"] == {
+            "HEAD": {"count": 2},
+            "GET": {"count": 1, "downloaded_bytes": 6},
+        }
+
+        # File modified on the server: the cached chunk must not be used
+        read_file("test.bin", "etag2", "barbaz", with_get=True)
+        read_file("test.bin", "etag2", "barbaz", with_get=False)
+        assert len(get_cache_files()) == 2
+
+        # Check that the cache is trimmed to its maximum size.
+        # Each chunk file is 22 bytes (16-byte header + 6 bytes)
+        with gdal.config_option("CPL_VSIL_CURL_DISK_CACHE_SIZE", "50"):
+            read_file("test2.bin", "etag", "foobaz", with_get=True)
+            assert len(get_cache_files()) == 2
+
+    # Check that the least recently used chunks are removed first, and not
+    # the least recently written ones
+    cache_dir2 = tmp_path / "cache2"
+    with gdal.config_options(
+        {
+            "CPL_VSIL_CURL_DISK_CACHE_DIR": str(cache_dir2),
+            "CPL_VSIL_CURL_DISK_CACHE_SIZE": "50",
+            "GDAL_DISABLE_READDIR_ON_OPEN": "EMPTY_DIR",
+        },
+        thread_local=False,
+    ):
+        read_file("a.bin", "etag", "aaaaaa", with_get=True)
+        read_file("b.bin", "etag", "bbbbbb", with_get=True)
+        # Served from the disk cache
+        read_file("a.bin", "etag", "aaaaaa", with_get=False)
+        read_file("c.bin", "etag", "cccccc", with_get=True)
+        contents = set()
+        for f in get_cache_files(cache_dir2):
+            with open(f, "rb") as fp:
+                contents.add(fp.read()[16:])
+        assert contents == {b"aaaaaa", b"cccccc"}
+
+    gdal.NetworkStatsReset()
+    gdal.VSICurlClearCache()
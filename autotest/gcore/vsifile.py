@@ -13,8 +13,11 @@
 ###############################################################################
 
 import os
+import random
+import struct
 import sys
 import time
+import zlib
 
 import gdaltest
 import pytest
@@ -206,6 +209,56 @@ def test_vsifile_WRITE_THROUGH(tmp_path):
     vsifile_generic(f"{tmp_path}/vsifile.bin", ["WRITE_THROUGH=YES"])
 
 
+###############################################################################
+# Test DIRECT_IO=YES (O_DIRECT)
+
+
+@pytest.mark.skipif(sys.platform == "win32", reason="Unix specific test")
+def test_vsifile_DIRECT_IO(tmp_path):
+    if not gdaltest.filesystem_supports_direct_io(tmp_path):
+        pytest.skip("O_DIRECT not supported on this file system")
+    vsifile_generic(f"{tmp_path}/vsifile.bin", ["DIRECT_IO=YES"])
+
+
+@pytest.mark.skipif(sys.platform == "win32", reason="Unix specific test")
+def test_vsifile_DIRECT_IO_unaligned_accesses(tmp_path):
+    if not gdaltest.filesystem_supports_direct_io(tmp_path):
+        pytest.skip("O_DIRECT not supported on this file system")
+
+    filename = str(tmp_path / "vsifile.bin")
+    data = bytes(i % 251 for i in range(10 * 1000 * 1000))
+
+    with gdal.config_option("CPL_VSIL_LOCAL_DIRECT_IO", "YES"):
+        fp = gdal.VSIFOpenL(filename, "wb+")
+        assert fp
+        # Larger than the bounce buffer, unaligned size
+        assert gdal.VSIFWriteL(data, 1, len(data), fp) == len(data)
+        # Overwrite in the middle of already flushed blocks
+        assert gdal.VSIFSeekL(fp, 4095, 0) == 0
+        assert gdal.VSIFWriteL(b"XYZ", 1, 3, fp) == 3
+        assert gdal.VSIFSeekL(fp, 4093, 0) == 0
+        assert gdal.VSIFReadL(1, 7, fp) == data[4093:4095] + b"XYZ" + data[4098:4100]
+        # Write past end of file
+        assert gdal.VSIFSeekL(fp, len(data) + 10, 0) == 0
+        assert gdal.VSIFWriteL(b"end", 1, 3, fp) == 3
+        gdal.VSIFCloseL(fp)
+
+        expected = data[0:4095] + b"XYZ" + data[4098:] + b"\0" * 10 + b"end"
+        assert gdal.VSIStatL(filename).size == len(expected)
+
+        fp = gdal.VSIFOpenL(filename, "rb")
+        assert fp
+        assert gdal.VSIFSeekL(fp, 12345, 0) == 0
+        assert gdal.VSIFReadL(1, 100, fp) == expected[12345:12445]
+        assert gdal.VSIFSeekL(fp, 0, 0) == 0
+        assert gdal.VSIFReadL(1, len(expected) + 1, fp) == expected
+        assert gdal.VSIFEofL(fp) == 1
+        gdal.VSIFCloseL(fp)
+
+    with open(filename, "rb") as f:
+        assert f.read() == expected
+
+
 ###############################################################################
 # Test ftruncate >= 32 bit
 
@@ -914,6 +967,71 @@ def test_vsigzip_multi_thread():
         pytest.fail()
 
 
+###############################################################################
+# Test seek index of .gz files
+
+
+def _gzip_member(data, bgzf=False):
+
+    compressor = zlib.compressobj(6, zlib.DEFLATED, -zlib.MAX_WBITS)
+    deflated = compressor.compress(data) + compressor.flush()
+    if bgzf:
+        # Extra field with the BGZF "BC" subfield, giving the block size - 1
+        header = b"\x1f\x8b\x08\x04" + b"\x00" * 5 + b"\xff"
+        header += struct.pack("<H2sHH", 6, b"BC", 2, 18 + len(deflated) + 8 - 1)
+    else:
+        header = b"\x1f\x8b\x08\x00" + b"\x00" * 5 + b"\x03"
+    return header + deflated + struct.pack("<II", zlib.crc32(data), len(data))
+
+
+@pytest.mark.parametrize("layout", ["single_member", "multi_member", "bgzf"])
+def test_vsigzip_index(tmp_vsimem, layout):
+
+    rng = random.Random(0)
+    words = [b"foo,", b"bar ", b"baz\n", b"12345 ", b"3.14159,"]
+    data = b"".join(rng.choice(words) for _ in range(300000))
+    if layout == "single_member":
+        gz = _gzip_member(data)
+    else:
+        step = 50000 if layout == "bgzf" else 400000
+        gz = b"".join(
+            _gzip_member(data[i : i + step], layout == "bgzf")
+            for i in range(0, len(data), step)
+        )
+        if layout == "bgzf":
+            gz += _gzip_member(b"", True)
+
+    filename = str(tmp_vsimem / "test.gz")
+    gdal.FileFromMemBuffer(filename, gz)
+
+    with gdaltest.config_options(
+        {
+            "CPL_VSIL_GZIP_INDEX": "BUILD",
+            "CPL_VSIL_GZIP_INDEX_SPAN": "64K",
+            "GDAL_NUM_THREADS": "4",
+        }
+    ):
+        with gdal.VSIFile("/vsigzip/" + filename, "rb") as f:
+            assert f.read() == data
+    assert gdal.VSIStatL(filename + ".idx") is not None
+
+    assert gdal.VSIStatL("/vsigzip/" + filename).size == len(data)
+    with gdaltest.config_option("GDAL_NUM_THREADS", "4"):
+        with gdal.VSIFile("/vsigzip/" + filename, "rb") as f:
+            for _ in range(50):
+                offset = rng.randrange(len(data))
+                size = rng.randrange(200000)
+                f.seek(offset)
+                assert f.read(size) == data[offset : offset + size]
+            f.seek(len(data) - 10)
+            assert f.read(100) == data[-10:]
+
+    # The index of another version of the file is not used
+    gdal.FileFromMemBuffer(filename, gz + _gzip_member(b"extra"))
+    with gdal.VSIFile("/vsigzip/" + filename, "rb") as f:
+        assert f.read() == data + b"extra"
+
+
 ###############################################################################
 # Test vsisync()
 
@@ -3135,6 +3135,128 @@ def test_vsis3_write_multipart_retry(aws_test_config, webserver_port):
                 gdal.VSIFCloseL(f)
 
 
+###############################################################################
+# Test multipart upload with parts uploaded in the background
+
+
+def test_vsis3_write_multipart_background(aws_test_config, webserver_port):
+
+    chunk_size = 1024 * 1024
+    size = 3 * chunk_size + 1
+    big_buffer = b"a" * size
+
+    # Parts may be received in any order
+    handler = webserver.NonSequentialMockedHttpHandler()
+    handler.add(
+        "POST",
+        "/s3_fake_bucket4/large_file_background.bin?uploads",
+        200,
+        {},
+        """<?xml version="1.0" encoding="UTF-8"?>
+        <InitiateMultipartUploadResult>
+        <UploadId>my_id</UploadId>
+        </InitiateMultipartUploadResult>""",
+    )
+    for part_number in range(1, 5):
+        handler.add(
+            "PUT",
+            "/s3_fake_bucket4/large_file_background.bin?partNumber=%d&uploadId=my_id"
+            % part_number,
+            200,
+            {"ETag": '"etag_%d"' % part_number, "Content-Length": "0"},
+            b"",
+            expected_headers={
+                "Content-Length": str(chunk_size if part_number < 4 else 1)
+            },
+        )
+    expected_body = b"<CompleteMultipartUpload>\n"
+    for part_number in range(1, 5):
+        expected_body += (
+            b'<Part>\n<PartNumber>%d</PartNumber><ETag>"etag_%d"</ETag></Part>\n'
+            % (part_number, part_number)
+        )
+    expected_body += b"</CompleteMultipartUpload>\n"
+    handler.add(
+        "POST",
+        "/s3_fake_bucket4/large_file_background.bin?uploadId=my_id",
+        200,
+        {},
+        b"",
+        expected_headers={"Content-Length": str(len(expected_body))},
+        expected_body=expected_body,
+    )
+
+    gdal.ErrorReset()
+    with webserver.install_http_handler(handler):
+        f = gdal.VSIFOpenExL(
+            "/vsis3/s3_fake_bucket4/large_file_background.bin",
+            "wb",
+            False,
+            ["CHUNK_SIZE=1", "NUM_THREADS=2"],
+        )
+        assert f is not None
+        assert gdal.VSIFWriteL(big_buffer, 1, size, f) == size
+        assert gdal.VSIFCloseL(f) == 0
+    assert gdal.GetLastErrorMsg() == ""
+
+
+###############################################################################
+# Test errors of parts uploaded in the background
+
+
+@pytest.mark.parametrize("error_at_close", [False, True])
+def test_vsis3_write_multipart_background_error(
+    aws_test_config, webserver_port, error_at_close
+):
+
+    chunk_size = 1024 * 1024
+
+    handler = webserver.SequentialHandler()
+    handler.add(
+        "POST",
+        "/s3_fake_bucket4/large_file_background_error.bin?uploads",
+        200,
+        {},
+        """<?xml version="1.0" encoding="UTF-8"?>
+        <InitiateMultipartUploadResult>
+        <UploadId>my_id</UploadId>
+        </InitiateMultipartUploadResult>""",
+    )
+    handler.add(
+        "PUT",
+        "/s3_fake_bucket4/large_file_background_error.bin?partNumber=1&uploadId=my_id",
+        403,
+    )
+    handler.add(
+        "DELETE",
+        "/s3_fake_bucket4/large_file_background_error.bin?uploadId=my_id",
+        204,
+    )
+
+    with webserver.install_http_handler(handler), gdal.config_options(
+        {"CPL_VSIL_MULTIPART_UPLOAD_NUM_THREADS": "1", "VSIS3_CHUNK_SIZE": "1"},
+        thread_local=False,
+    ):
+        f = gdal.VSIFOpenL(
+            "/vsis3/s3_fake_bucket4/large_file_background_error.bin", "wb"
+        )
+        assert f is not None
+        # The first part is handed over to the background upload: no error yet
+        assert gdal.VSIFWriteL(b"a" * chunk_size, 1, chunk_size, f) == chunk_size
+        gdal.ErrorReset()
+        if error_at_close:
+            assert gdal.VSIFWriteL(b"a", 1, 1, f) == 1
+            with gdal.quiet_errors():
+                assert gdal.VSIFCloseL(f) != 0
+            assert "UploadPart(1)" in gdal.GetLastErrorMsg()
+        else:
+            # Submitting the second part reports the failure of the first one
+            with gdal.quiet_errors():
+                assert gdal.VSIFWriteL(b"a" * chunk_size, 1, chunk_size, f) == 0
+            assert "UploadPart(1)" in gdal.GetLastErrorMsg()
+            assert gdal.VSIFCloseL(f) == 0
+
+
 ###############################################################################
 # Test abort pending multipart uploads
 
@@ -15,6 +15,7 @@
 
 import os
 import struct
+import sys
 
 import gdaltest
 import pytest
@@ -390,3 +391,42 @@ def test_ehdr_approx_stats_flag():
     ds = None
 
     gdal.GetDriverByName("EHDR").Delete(tmpfile)
+
+
+###############################################################################
+# Test RAW_VIRTUAL_MEM_IO
+
+
+@pytest.mark.parametrize("virtual_mem_io", ["YES", "IF_ENOUGH_RAM"])
+def test_ehdr_virtual_mem_io(tmp_path, virtual_mem_io):
+
+    tmpfile = str(tmp_path / "test.bil")
+    gdal.Translate(tmpfile, "data/ehdr/float32.bil", format="EHdr")
+
+    # The mapping is not used when byte swapping is needed
+    mapping_used = sys.platform != "win32" and sys.byteorder == "little"
+
+    def get_virtual_mem_io_count(ds):
+        return int(
+            ds.GetRasterBand(1).GetMetadataItem("VIRTUAL_MEM_IO_COUNT", "_DEBUG_")
+        )
+
+    with gdal.Open(tmpfile) as ds:
+        ref_data = ds.ReadRaster()
+        ref_subwindow = ds.GetRasterBand(1).ReadRaster(
+            3, 4, 10, 5, buf_type=gdal.GDT_Float64
+        )
+        assert get_virtual_mem_io_count(ds) == 0
+
+    with gdal.config_option("RAW_VIRTUAL_MEM_IO", virtual_mem_io):
+        with gdal.Open(tmpfile) as ds:
+            assert ds.ReadRaster() == ref_data
+            assert get_virtual_mem_io_count(ds) == (1 if mapping_used else 0)
+            assert (
+                ds.GetRasterBand(1).ReadRaster(3, 4, 10, 5, buf_type=gdal.GDT_Float64)
+                == ref_subwindow
+            )
+            assert get_virtual_mem_io_count(ds) == (2 if mapping_used else 0)
+            # Requests with resampling use the generic implementation
+            assert ds.ReadRaster(0, 0, 20, 20, 10, 10) is not None
+            assert get_virtual_mem_io_count(ds) == (2 if mapping_used else 0)
@@ -17,6 +17,7 @@
 
 import os
 import struct
+import sys
 
 import gdaltest
 import pytest
@@ -1156,3 +1157,48 @@ fwhm = {0.0003, 0.0002, 0.0001}""",
     assert ds.GetRasterBand(2).GetMetadataItem("FWHM_UM", "IMAGERY") == "0.200"
     ds = None
     gdal.GetDriverByName("ENVI").Delete("/vsimem/test.bin")
+
+
+###############################################################################
+# Test RAW_VIRTUAL_MEM_IO on a pixel-interleaved dataset
+
+
+def test_envi_virtual_mem_io_bip(tmp_path):
+
+    tmpfile = str(tmp_path / "test.bin")
+    gdal.Translate(
+        tmpfile, "data/rgbsmall.tif", format="ENVI", creationOptions=["INTERLEAVE=BIP"]
+    )
+
+    with gdal.Open(tmpfile) as ds:
+        ref_data = ds.ReadRaster()
+        ref_bip_data = ds.ReadRaster(buf_pixel_space=3, buf_band_space=1)
+        ref_band_data = ds.GetRasterBand(2).ReadRaster(10, 5, 20, 30)
+        ref_checksums = [ds.GetRasterBand(i + 1).Checksum() for i in range(3)]
+
+    def get_virtual_mem_io_counts(ds):
+        return [
+            int(
+                ds.GetRasterBand(i + 1).GetMetadataItem(
+                    "VIRTUAL_MEM_IO_COUNT", "_DEBUG_"
+                )
+            )
+            for i in range(ds.RasterCount)
+        ]
+
+    with gdal.config_option("RAW_VIRTUAL_MEM_IO", "YES"):
+        with gdal.Open(tmpfile) as ds:
+            assert ds.ReadRaster() == ref_data
+            counts = get_virtual_mem_io_counts(ds)
+            mapping_used = sys.platform != "win32"
+            assert (min(counts) >= 1) == mapping_used
+            # Served by the direct access to the BIP dataset
+            assert ds.ReadRaster(buf_pixel_space=3, buf_band_space=1) == ref_bip_data
+            new_counts = get_virtual_mem_io_counts(ds)
+            assert new_counts[0] == counts[0] + (1 if mapping_used else 0)
+            counts = new_counts
+            assert ds.GetRasterBand(2).ReadRaster(10, 5, 20, 30) == ref_band_data
+            new_counts = get_virtual_mem_io_counts(ds)
+            assert new_counts[1] == counts[1] + (1 if mapping_used else 0)
+            checksums = [ds.GetRasterBand(i + 1).Checksum() for i in range(3)]
+            assert checksums == ref_checksums
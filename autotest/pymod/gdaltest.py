@@ -1397,6 +1397,40 @@ def filesystem_supports_sparse_files(path):
     return False
 
 
+###############################################################################
+# Return whether files in path are actually read and written with O_DIRECT
+# when DIRECT_IO=YES is set. File systems such as tmpfs make the local file
+# handler fall back to buffered I/O.
+
+
+def filesystem_supports_direct_io(path):
+
+    if sys.platform == "win32":
+        return False
+
+    filename = os.path.join(str(path), "direct_io_probe.bin")
+    messages = []
+
+    def handler(err_class, err_no, msg):
+        messages.append(msg)
+
+    with config_option("CPL_DEBUG", "ON"), error_handler(handler):
+        fp = gdal.VSIFOpenExL(filename, "wb+", False, ["DIRECT_IO=YES"])
+        if fp is None:
+            return False
+        gdal.VSIFWriteL(b"\0" * 8192, 1, 8192, fp)
+        gdal.VSIFCloseL(fp)
+        fp = gdal.VSIFOpenExL(filename, "rb", False, ["DIRECT_IO=YES"])
+        if fp:
+            gdal.VSIFReadL(1, 8192, fp)
+            gdal.VSIFCloseL(fp)
+    gdal.Unlink(filename)
+
+    return any("using direct I/O" in msg for msg in messages) and not any(
+        "Disabling direct I/O" in msg for msg in messages
+    )
+
+
 ###############################################################################
 # Unzip a file
 
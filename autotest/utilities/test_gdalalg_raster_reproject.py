@@ -315,3 +315,23 @@ def test_gdalalg_raster_reproject_complete_dst_crs_iau_mars(tmp_path):
     )
     assert "Earth" not in out
     assert "Mars" in out
+
+
+def test_gdalalg_raster_reproject_pipeline_depth(tmp_vsimem):
+
+    out_filename = str(tmp_vsimem / "out.tif")
+
+    alg = get_reproject_alg()
+    assert alg.ParseRunAndFinalize(
+        [
+            "--src-crs=EPSG:32611",
+            "--dst-crs=EPSG:4326",
+            "--pipeline-depth=3",
+            "--wo=PIPELINE_ORDERED_WRITES=NO",
+            "../gcore/data/byte.tif",
+            out_filename,
+        ],
+    )
+
+    with gdal.Open(out_filename) as ds:
+        assert ds.GetRasterBand(1).Checksum() == 4727
@@ -362,3 +362,67 @@ def test_gdalinfo_lib_json_color_table_and_rat():
     assert "rat" in ret["bands"][0]
 
     gdaltest.validate_json(ret, "gdalinfo_output.schema.json")
+
+
+###############################################################################
+# Test that statistics and histograms of a pixel-interleaved multi-band
+# dataset, computed with a single pass over the dataset, are the same as
+# the ones computed band per band.
+
+
+@pytest.mark.parametrize("datatype", [gdal.GDT_Byte, gdal.GDT_Int16])
+def test_gdalinfo_lib_stats_hist_multiband(tmp_vsimem, datatype):
+
+    src_ds = gdal.Translate(
+        "", "../gcore/data/rgbsmall.tif", format="MEM", outputType=datatype
+    )
+
+    filename = str(tmp_vsimem / "test.tif")
+    gdal.Translate(filename, src_ds, creationOptions=["INTERLEAVE=PIXEL"])
+    ret = gdal.Info(filename, format="json", stats=True, reportHistograms=True)
+
+    filename_band = str(tmp_vsimem / "test_band.tif")
+    gdal.Translate(filename_band, src_ds, creationOptions=["INTERLEAVE=BAND"])
+    ret_band = gdal.Info(
+        filename_band, format="json", stats=True, reportHistograms=True
+    )
+
+    for band, band_ref in zip(ret["bands"], ret_band["bands"]):
+        for key in ("minimum", "maximum", "mean", "stdDev", "histogram"):
+            assert band[key] == band_ref[key]
+
+    # Statistics and histograms are persisted in the .aux.xml file
+    ds = gdal.Open(filename)
+    assert ds.GetRasterBand(3).GetMetadataItem("STATISTICS_MEAN") is not None
+    assert ds.GetRasterBand(3).GetDefaultHistogram(force=False) is not None
+
+
+###############################################################################
+# Test that the output of "gdalinfo -hist", without -stats, is the same on a
+# pixel-interleaved multi-band dataset as band per band: statistics computed
+# to get the bounds of the histograms are not reported on the first run.
+
+
+@pytest.mark.parametrize("datatype", [gdal.GDT_Byte, gdal.GDT_Int16])
+def test_gdalinfo_lib_hist_multiband(tmp_vsimem, datatype):
+
+    src_ds = gdal.Translate(
+        "", "../gcore/data/rgbsmall.tif", format="MEM", outputType=datatype
+    )
+
+    rets = []
+    for interleave in ("PIXEL", "BAND"):
+        filename = str(tmp_vsimem / f"test_{interleave}.tif")
+        gdal.Translate(filename, src_ds, creationOptions=[f"INTERLEAVE={interleave}"])
+        rets.append(
+            [
+                gdal.Info(filename, format="json", reportHistograms=True)["bands"]
+                for _ in range(2)
+            ]
+        )
+
+    for run in range(2):
+        for band, band_ref in zip(rets[0][run], rets[1][run]):
+            for key in ("minimum", "maximum", "mean", "stdDev", "histogram"):
+                assert band.get(key) == band_ref.get(key)
+    assert "mean" not in rets[0][0][0]
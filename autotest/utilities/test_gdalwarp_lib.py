@@ -4587,3 +4587,122 @@ def test_gdalwarp_te_srs_check_extent():
     assert out_ds.GetGeoTransform() == pytest.approx(
         (166021, 37108, 0.0, 0.0, 0.0, -36622), abs=1000
     )
+
+
+###############################################################################
+# Test pipelined multi-chunk warping (-multi and PIPELINE_DEPTH warp option)
+
+
+@pytest.mark.parametrize("pipeline_depth", [None, "1", "4", "ALL_CPUS"])
+@pytest.mark.parametrize("ordered_writes", ["YES", "NO"])
+@pytest.mark.parametrize("src_format", ["MEM", "GTiff"])
+def test_gdalwarp_lib_multi_pipeline(
+    tmp_vsimem, pipeline_depth, ordered_writes, src_format
+):
+
+    src_ds = gdal.Translate(
+        tmp_vsimem / "src.tif" if src_format == "GTiff" else "",
+        "../gcore/data/byte.tif",
+        format=src_format,
+        width=400,
+        height=400,
+    )
+    if src_format == "GTiff":
+        src_ds.Close()
+        src_ds = gdal.Open(tmp_vsimem / "src.tif")
+
+    # Use the exact transformer, so that the output does not depend on the
+    # shape of chunks
+    options = {
+        "dstSRS": "EPSG:4326",
+        "errorThreshold": 0,
+        "dstAlpha": True,
+        "warpMemoryLimit": 100000,
+    }
+    ref_ds = gdal.Warp("", src_ds, format="MEM", **options)
+
+    warp_options = ["PIPELINE_ORDERED_WRITES=" + ordered_writes]
+    if pipeline_depth:
+        warp_options.append("PIPELINE_DEPTH=" + pipeline_depth)
+
+    progress_values = []
+
+    def my_progress(pct, msg, user_data):
+        progress_values.append(pct)
+        return True
+
+    out_ds = gdal.Warp(
+        tmp_vsimem / "out.tif",
+        src_ds,
+        multithread=pipeline_depth is None,
+        warpOptions=warp_options,
+        callback=my_progress,
+        **options,
+    )
+    assert [out_ds.GetRasterBand(i + 1).Checksum() for i in range(2)] == [
+        ref_ds.GetRasterBand(i + 1).Checksum() for i in range(2)
+    ]
+    assert progress_values == sorted(progress_values)
+    assert progress_values[-1] == 1.0
+
+
+###############################################################################
+# Test that pipelined multi-chunk warping uses a single I/O lock when the
+# source and destination datasets share their storage
+
+
+@pytest.mark.parametrize("same_file", [True, False])
+def test_gdalwarp_lib_multi_pipeline_aliasing(tmp_vsimem, same_file):
+
+    gdal.Translate(
+        tmp_vsimem / "src.tif", "../gcore/data/byte.tif", width=400, height=400
+    )
+    src_ds = gdal.Open(tmp_vsimem / "src.tif")
+    if same_file:
+        dst_ds = gdal.Open(tmp_vsimem / "src.tif", gdal.GA_Update)
+    else:
+        dst_ds = gdal.Translate(tmp_vsimem / "dst.tif", src_ds)
+    checksum = src_ds.GetRasterBand(1).Checksum()
+
+    messages = []
+
+    def handler(err_class, err_no, msg):
+        messages.append(msg)
+
+    # Identity transformation, so that the result does not depend on the
+    # order of reads and writes
+    with gdaltest.config_option("CPL_DEBUG", "ON"), gdaltest.error_handler(handler):
+        gdal.Warp(
+            dst_ds,
+            src_ds,
+            multithread=True,
+            warpMemoryLimit=100000,
+            warpOptions=["PIPELINE_DEPTH=4"],
+        )
+    assert any("Using a single I/O lock" in msg for msg in messages) == same_file
+    dst_ds.FlushCache()
+    assert dst_ds.GetRasterBand(1).Checksum() == checksum
+
+
+###############################################################################
+# Test interruption of pipelined multi-chunk warping
+
+
+def test_gdalwarp_lib_multi_pipeline_interrupted(tmp_vsimem):
+
+    src_ds = gdal.Translate(
+        "", "../gcore/data/byte.tif", format="MEM", width=400, height=400
+    )
+
+    def my_progress(pct, msg, user_data):
+        return pct < 0.5
+
+    with pytest.raises(Exception):
+        gdal.Warp(
+            tmp_vsimem / "out.tif",
+            src_ds,
+            dstSRS="EPSG:4326",
+            warpMemoryLimit=100000,
+            warpOptions=["PIPELINE_DEPTH=4"],
+            callback=my_progress,
+        )
@@ -808,6 +808,9 @@ VRTWarpedDataset *VRTWarpedDataset::CreateImplicitOverview(int iOvr) const
     psWOOvr->hSrcDS = poSrcOvrDS;
     psWOOvr->pfnTransformer = psWO->pfnTransformer;
     psWOOvr->pTransformerArg = pTransformerArg;
+    // A transformation grid is specific to the full resolution target.
+    psWOOvr->papszWarpOptions = CSLSetNameValue(psWOOvr->papszWarpOptions,
+                                                "TRANSFORMATION_GRID", nullptr);
 
     /* --------------------------------------------------------------------
      */
@@ -1288,8 +1291,15 @@ CPLErr VRTWarpedDataset::IBuildOverviews(
             poBaseDataset->GetRasterXSize() / static_cast<double>(nOXSize),
             poBaseDataset->GetRasterYSize() / static_cast<double>(nOYSize));
 
+        // A transformation grid is specific to the full resolution target.
+        char **papszWarpOptionsBase = psWO->papszWarpOptions;
+        psWO->papszWarpOptions = CSLSetNameValue(
+            CSLDuplicate(papszWarpOptionsBase), "TRANSFORMATION_GRID", nullptr);
+
         eErr = poOverviewDS->Initialize(psWO);
 
+        CSLDestroy(psWO->papszWarpOptions);
+        psWO->papszWarpOptions = papszWarpOptionsBase;
         psWO->pfnTransformer = pfnTransformerBase;
         psWO->pTransformerArg = pTransformerBaseArg;
 
@@ -1957,6 +1967,9 @@ CPLErr VRTWarpedDataset::IRasterIO(
         psRescaledWO->hSrcDS = psWO->hSrcDS;
         psRescaledWO->pfnTransformer = psWO->pfnTransformer;
         psRescaledWO->pTransformerArg = pTransformerArg;
+        // A transformation grid is specific to the full resolution target.
+        psRescaledWO->papszWarpOptions = CSLSetNameValue(
+            psRescaledWO->papszWarpOptions, "TRANSFORMATION_GRID", nullptr);
 
         // Rescale the output geotransform on the transformer.
         double adfDstGeoTransform[6] = {0.0};
@@ -1429,6 +1429,17 @@ OGRErr CPL_DLL GDALDatasetStartTransaction(GDALDatasetH hDS, int bForce);
 OGRErr CPL_DLL GDALDatasetCommitTransaction(GDALDatasetH hDS);
 OGRErr CPL_DLL GDALDatasetRollbackTransaction(GDALDatasetH hDS);
 void CPL_DLL GDALDatasetClearStatistics(GDALDatasetH hDS);
+CPLErr CPL_DLL GDALDatasetComputeStatistics(
+    GDALDatasetH hDS, int bApproxOK, int nBandCount, const int *panBandMap,
+    double *padfMin, double *padfMax, double *padfMean, double *padfStdDev,
+    double *padfHistMin, double *padfHistMax, int *panHistBuckets,
+    GUIntBig **ppanHistograms, GDALProgressFunc pfnProgress,
+    void *pProgressData);
+CPLErr CPL_DLL GDALDatasetGetHistogram(
+    GDALDatasetH hDS, int nBandCount, const int *panBandMap,
+    const double *padfMin, const double *padfMax, int nBuckets,
+    GUIntBig **ppanHistograms, int bIncludeOutOfRange, int bApproxOK,
+    GDALProgressFunc pfnProgress, void *pProgressData);
 
 char CPL_DLL **GDALDatasetGetFieldDomainNames(GDALDatasetH, CSLConstList)
     CPL_WARN_UNUSED_RESULT;
@@ -2423,6 +2434,18 @@ GIntBig CPL_DLL CPL_STDCALL GDALGetCacheUsed64(void);
 
 int CPL_DLL CPL_STDCALL GDALFlushCacheBlock(void);
 
+void CPL_DLL GDALGetCacheStatistics(GIntBig *pnHits, GIntBig *pnMisses,
+                                    GIntBig *pnEvictions);
+void CPL_DLL GDALResetCacheStatistics(void);
+
+void CPL_DLL GDALDatasetSetBlockCacheMax(GDALDatasetH hDS, GIntBig nBytes);
+GIntBig CPL_DLL GDALDatasetGetBlockCacheMax(GDALDatasetH hDS);
+void CPL_DLL GDALDatasetGetBlockCacheStatistics(GDALDatasetH hDS,
+                                                GIntBig *pnCachedBytes,
+                                                GIntBig *pnHits,
+                                                GIntBig *pnMisses,
+                                                GIntBig *pnDirtyBytes);
+
 /* ==================================================================== */
 /*      GDAL virtual memory                                             */
 /* ==================================================================== */
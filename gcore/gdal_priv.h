@@ -706,6 +706,10 @@ typedef struct GDALSQLParseInfo GDALSQLParseInfo;
 #endif
 //! @endcond
 
+//! @cond Doxygen_Suppress
+class GDALRasterBlockPrefetcher;
+//! @endcond
+
 /** A set of associated raster bands, usually from one file. */
 class CPL_DLL GDALDataset : public GDALMajorObject
 {
@@ -837,6 +841,21 @@ class CPL_DLL GDALDataset : public GDALMajorObject
     char **papszOpenOptions = nullptr;
 
     friend class GDALRasterBand;
+    friend class GDALRasterBlock;
+
+    // Per-dataset block cache accounting, updated by GDALRasterBlock.
+    void UpdateBlockCacheUsage(GIntBig nCachedBytesDelta,
+                               GIntBig nDirtyBytesDelta);
+    void IncBlockCacheHits();
+    void IncBlockCacheMisses();
+    GIntBig GetBlockCacheUsage() const;
+
+    // Read-ahead of blocks (GDAL_BLOCK_PREFETCH configuration option)
+    GDALRasterBlockPrefetcher *GetBlockPrefetcher();
+    GDALDataset *GetBlockPrefetchLockDataset();
+    bool EnterBlockPrefetchLock();
+    void LeaveBlockPrefetchLock();
+    void StopBlockPrefetcher();
 
     // The below methods related to read write mutex are fragile logic, and
     // should not be used by out-of-tree code if possible.
@@ -920,6 +939,12 @@ class CPL_DLL GDALDataset : public GDALMajorObject
     virtual CPLErr FlushCache(bool bAtClosing = false);
     virtual CPLErr DropCache();
 
+    void SetBlockCacheMax(GIntBig nBytes);
+    GIntBig GetBlockCacheMax() const;
+    void GetBlockCacheStatistics(GIntBig *pnCachedBytes, GIntBig *pnHits,
+                                 GIntBig *pnMisses,
+                                 GIntBig *pnDirtyBytes) const;
+
     virtual GIntBig GetEstimatedRAMUsage();
 
     virtual const OGRSpatialReference *GetSpatialRef() const;
@@ -1126,6 +1151,21 @@ class CPL_DLL GDALDataset : public GDALMajorObject
 
     virtual void ClearStatistics();
 
+    virtual CPLErr
+    ComputeStatistics(bool bApproxOK, int nBandCount, const int *panBandMap,
+                      double *padfMin, double *padfMax, double *padfMean,
+                      double *padfStdDev, double *padfHistMin,
+                      double *padfHistMax, int *panHistBuckets,
+                      GUIntBig **ppanHistograms, GDALProgressFunc pfnProgress,
+                      void *pProgressData);
+
+    virtual CPLErr GetHistogram(int nBandCount, const int *panBandMap,
+                                const double *padfMin, const double *padfMax,
+                                int nBuckets, GUIntBig **ppanHistograms,
+                                bool bIncludeOutOfRange, bool bApproxOK,
+                                GDALProgressFunc pfnProgress,
+                                void *pProgressData);
+
     /** Convert a GDALDataset* to a GDALDatasetH.
      * @since GDAL 2.3
      */
@@ -1481,8 +1521,25 @@ class CPL_DLL GDALRasterBlock
 
     bool bMustDetach;
 
+    // Index of the global block cache shard the block belongs to.
+    int nCacheShard;
+
+    // Index of the list of the shard the block belongs to (2Q policy).
+    int nCacheList;
+
+    // Whether the block has been read ahead by the block prefetcher, and not
+    // yet requested.
+    bool bPrefetched;
+
+    // Neighbours in the list, in order of age, of the blocks of the same
+    // dataset and cache shard. Used to enforce per-dataset cache quotas.
+    GDALRasterBlock *poDatasetNext;
+    GDALRasterBlock *poDatasetPrevious;
+
     CPL_INTERNAL void Detach_unlocked(void);
     CPL_INTERNAL void Touch_unlocked(void);
+    CPL_INTERNAL void DetachFromDatasetList_unlocked(void);
+    CPL_INTERNAL void TouchInDatasetList_unlocked(void);
 
     CPL_INTERNAL void RecycleFor(int nXOffIn, int nYOffIn);
 
@@ -1512,6 +1569,22 @@ class CPL_DLL GDALRasterBlock
 
     CPLErr Write();
 
+    //! @cond Doxygen_Suppress
+    /** Return whether the block has been read ahead by the block prefetcher,
+     * and not yet requested. */
+    bool IsPrefetched() const
+    {
+        return bPrefetched;
+    }
+
+    /** Set whether the block has been read ahead by the block prefetcher. */
+    void SetPrefetched(bool bPrefetchedIn)
+    {
+        bPrefetched = bPrefetchedIn;
+    }
+
+    //! @endcond
+
     /** Return the data type
      * @return data type
      */
@@ -5192,6 +5265,15 @@ std::string CPL_DLL GDALGetNormalizedOvrResampling(const char *pszResampling);
 GDALDataType GDALGetOvrWorkDataType(const char *pszResampling,
                                     GDALDataType eSrcDataType);
 
+typedef void (*GDALDownsampleIntegerFactorFunction)(int nFactor,
+                                                    const void *pSrc,
+                                                    int nSrcLineStride,
+                                                    int nDstXSize, void *pDst);
+
+GDALDownsampleIntegerFactorFunction
+GDALGetDownsampleIntegerFactorFunction(const char *pszResampling,
+                                       GDALDataType eDataType);
+
 CPL_C_START
 
 CPLErr CPL_DLL
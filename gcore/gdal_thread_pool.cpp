@@ -46,9 +46,31 @@ CPLWorkerThreadPool *GDALGetGlobalThreadPool(int nThreads)
     return gpoCompressThreadPool;
 }
 
+// Dedicated to the jobs of GDALRasterBlockPrefetcher, that may wait for a
+// dataset in use by a thread itself waiting for jobs of the global pool.
+static CPLWorkerThreadPool *gpoBlockPrefetchThreadPool = nullptr;
+
+CPLWorkerThreadPool *GDALGetBlockPrefetchThreadPool(int nThreads)
+{
+    std::lock_guard oGuard(GetMutexThreadPool());
+    if (gpoBlockPrefetchThreadPool == nullptr)
+    {
+        gpoBlockPrefetchThreadPool = new CPLWorkerThreadPool();
+        if (!gpoBlockPrefetchThreadPool->Setup(nThreads, nullptr, nullptr,
+                                               false))
+        {
+            delete gpoBlockPrefetchThreadPool;
+            gpoBlockPrefetchThreadPool = nullptr;
+        }
+    }
+    return gpoBlockPrefetchThreadPool;
+}
+
 void GDALDestroyGlobalThreadPool()
 {
     std::lock_guard oGuard(GetMutexThreadPool());
     delete gpoCompressThreadPool;
     gpoCompressThreadPool = nullptr;
+    delete gpoBlockPrefetchThreadPool;
+    gpoBlockPrefetchThreadPool = nullptr;
 }
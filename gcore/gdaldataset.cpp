@@ -22,6 +22,7 @@
 #include <cstdlib>
 #include <cstring>
 #include <algorithm>
+#include <atomic>
 #include <map>
 #include <mutex>
 #include <new>
@@ -38,6 +39,7 @@
 #include "cpl_vsi.h"
 #include "cpl_vsi_error.h"
 #include "gdal_alg.h"
+#include "gdalrasterblockprefetcher.h"
 #include "ogr_api.h"
 #include "ogr_attrind.h"
 #include "ogr_core.h"
@@ -115,6 +117,20 @@ class GDALDataset::Private
     std::vector<int>
         m_anBandMap{};  // used by RasterIO(). Values are 1, 2, etc.
 
+    // Block cache accounting for the bands of this dataset
+    std::atomic<GIntBig> m_nBlockCacheUsed{0};
+    std::atomic<GIntBig> m_nBlockCacheDirty{0};
+    std::atomic<GIntBig> m_nBlockCacheHits{0};
+    std::atomic<GIntBig> m_nBlockCacheMisses{0};
+    // Maximum number of bytes of the global block cache this dataset may use.
+    // 0 means no specific limit, and -1 that the GDAL_DATASET_CACHEMAX
+    // configuration option has not been read yet.
+    std::atomic<GIntBig> m_nBlockCacheMax{-1};
+
+    // Read-ahead of blocks (GDAL_BLOCK_PREFETCH)
+    bool m_bBlockPrefetcherInitDone = false;
+    std::unique_ptr<GDALRasterBlockPrefetcher> m_poBlockPrefetcher{};
+
     Private() = default;
 };
 
@@ -359,6 +375,8 @@ GDALDataset::~GDALDataset()
 
     if (m_poPrivate != nullptr)
     {
+        m_poPrivate->m_poBlockPrefetcher.reset();
+
         if (m_poPrivate->hMutex != nullptr)
             CPLDestroyMutex(m_poPrivate->hMutex);
 
@@ -461,6 +479,10 @@ GDALDataset::~GDALDataset()
  */
 CPLErr GDALDataset::Close()
 {
+    // Normally already done by FlushCache(true) in the Close() method of the
+    // derived class, before it releases its resources.
+    StopBlockPrefetcher();
+
     // Call UnregisterFromSharedDataset() before altering nOpenFlags
     UnregisterFromSharedDataset();
 
@@ -555,6 +577,12 @@ CPLErr GDALDataset::FlushCache(bool bAtClosing)
 
 {
     CPLErr eErr = CE_None;
+
+    // Prefetch jobs must be finished before the derived class releases the
+    // resources they use.
+    if (bAtClosing)
+        StopBlockPrefetcher();
+
     // This sometimes happens if a dataset is destroyed before completely
     // built.
 
@@ -662,6 +690,324 @@ CPLErr CPL_STDCALL GDALDropCache(GDALDatasetH hDS)
     return GDALDataset::FromHandle(hDS)->DropCache();
 }
 
+/************************************************************************/
+/*                         SetBlockCacheMax()                           */
+/************************************************************************/
+
+/**
+ * \brief Set the maximum amount of the global block cache that the raster
+ * blocks of this dataset may use.
+ *
+ * When caching a new block would make the blocks of this dataset exceed this
+ * quota, the least recently used blocks of this dataset are evicted first,
+ * instead of blocks of other datasets. The quota is a soft limit: when the
+ * global block cache is sharded (see GDAL_BLOCK_CACHE_SHARDS), only blocks
+ * belonging to the same shard as the new block are candidates for eviction.
+ *
+ * The initial value is taken from the GDAL_DATASET_CACHEMAX configuration
+ * option, read when the first block of the dataset is cached (or when
+ * GetBlockCacheMax() is called), unless this method has been called before.
+ *
+ * This method is the same as the C function GDALDatasetSetBlockCacheMax().
+ *
+ * @param nBytes Maximum number of bytes, or 0 to remove the quota.
+ * @since GDAL 3.12
+ */
+
+void GDALDataset::SetBlockCacheMax(GIntBig nBytes)
+{
+    if (m_poPrivate)
+        m_poPrivate->m_nBlockCacheMax = std::max<GIntBig>(0, nBytes);
+}
+
+/************************************************************************/
+/*                    GDALDatasetSetBlockCacheMax()                     */
+/************************************************************************/
+
+/**
+ * \brief Set the maximum amount of the global block cache that the raster
+ * blocks of this dataset may use.
+ *
+ * @see GDALDataset::SetBlockCacheMax()
+ * @since GDAL 3.12
+ */
+
+void GDALDatasetSetBlockCacheMax(GDALDatasetH hDS, GIntBig nBytes)
+{
+    VALIDATE_POINTER0(hDS, "GDALDatasetSetBlockCacheMax");
+
+    GDALDataset::FromHandle(hDS)->SetBlockCacheMax(nBytes);
+}
+
+/************************************************************************/
+/*                         GetBlockCacheMax()                           */
+/************************************************************************/
+
+/**
+ * \brief Return the maximum amount of the global block cache that the raster
+ * blocks of this dataset may use.
+ *
+ * This method is the same as the C function GDALDatasetGetBlockCacheMax().
+ *
+ * @return maximum number of bytes, or 0 if there is no quota.
+ * @since GDAL 3.12
+ */
+
+GIntBig GDALDataset::GetBlockCacheMax() const
+{
+    if (!m_poPrivate)
+        return 0;
+    GIntBig nMax = m_poPrivate->m_nBlockCacheMax.load();
+    if (nMax >= 0)
+        return nMax;
+
+    // Lazy initialization from the configuration option, so that datasets
+    // that never cache a block do not pay for it.
+    nMax = 0;
+    const char *pszBlockCacheMax =
+        CPLGetConfigOption("GDAL_DATASET_CACHEMAX", nullptr);
+    if (pszBlockCacheMax)
+    {
+        if (CPLParseMemorySize(pszBlockCacheMax, &nMax, nullptr) != CE_None ||
+            nMax <= 0)
+        {
+            CPLError(CE_Warning, CPLE_IllegalArg,
+                     "Invalid value for GDAL_DATASET_CACHEMAX: %s",
+                     pszBlockCacheMax);
+            nMax = 0;
+        }
+    }
+    // Do not override a value set concurrently with SetBlockCacheMax()
+    GIntBig nExpected = -1;
+    if (!m_poPrivate->m_nBlockCacheMax.compare_exchange_strong(nExpected,
+                                                               nMax))
+        nMax = nExpected;
+    return nMax;
+}
+
+/************************************************************************/
+/*                    GDALDatasetGetBlockCacheMax()                     */
+/************************************************************************/
+
+/**
+ * \brief Return the maximum amount of the global block cache that the raster
+ * blocks of this dataset may use.
+ *
+ * @see GDALDataset::GetBlockCacheMax()
+ * @since GDAL 3.12
+ */
+
+GIntBig GDALDatasetGetBlockCacheMax(GDALDatasetH hDS)
+{
+    VALIDATE_POINTER1(hDS, "GDALDatasetGetBlockCacheMax", 0);
+
+    return GDALDataset::FromHandle(hDS)->GetBlockCacheMax();
+}
+
+/************************************************************************/
+/*                      GetBlockCacheStatistics()                       */
+/************************************************************************/
+
+/**
+ * \brief Return statistics on the use of the global block cache by the raster
+ * bands of this dataset.
+ *
+ * Hits are requests for a block that was found in the cache, and misses
+ * requests for a block that had to be read (or created).
+ *
+ * This method is the same as the C function
+ * GDALDatasetGetBlockCacheStatistics().
+ *
+ * @param pnCachedBytes Pointer to the number of bytes currently cached, or
+ *                      NULL.
+ * @param pnHits Pointer to the number of hits, or NULL.
+ * @param pnMisses Pointer to the number of misses, or NULL.
+ * @param pnDirtyBytes Pointer to the number of bytes of cached blocks not yet
+ *                     written, or NULL.
+ * @since GDAL 3.12
+ */
+
+void GDALDataset::GetBlockCacheStatistics(GIntBig *pnCachedBytes,
+                                          GIntBig *pnHits, GIntBig *pnMisses,
+                                          GIntBig *pnDirtyBytes) const
+{
+    const Private *psPrivate = m_poPrivate;
+    if (pnCachedBytes)
+        *pnCachedBytes = psPrivate ? psPrivate->m_nBlockCacheUsed.load() : 0;
+    if (pnHits)
+        *pnHits = psPrivate ? psPrivate->m_nBlockCacheHits.load() : 0;
+    if (pnMisses)
+        *pnMisses = psPrivate ? psPrivate->m_nBlockCacheMisses.load() : 0;
+    if (pnDirtyBytes)
+        *pnDirtyBytes = psPrivate ? psPrivate->m_nBlockCacheDirty.load() : 0;
+}
+
+/************************************************************************/
+/*                 GDALDatasetGetBlockCacheStatistics()                 */
+/************************************************************************/
+
+/**
+ * \brief Return statistics on the use of the global block cache by the raster
+ * bands of this dataset.
+ *
+ * @see GDALDataset::GetBlockCacheStatistics()
+ * @since GDAL 3.12
+ */
+
+void GDALDatasetGetBlockCacheStatistics(GDALDatasetH hDS,
+                                        GIntBig *pnCachedBytes,
+                                        GIntBig *pnHits, GIntBig *pnMisses,
+                                        GIntBig *pnDirtyBytes)
+{
+    VALIDATE_POINTER0(hDS, "GDALDatasetGetBlockCacheStatistics");
+
+    GDALDataset::FromHandle(hDS)->GetBlockCacheStatistics(
+        pnCachedBytes, pnHits, pnMisses, pnDirtyBytes);
+}
+
+//! @cond Doxygen_Suppress
+
+/************************************************************************/
+/*                       UpdateBlockCacheUsage()                        */
+/************************************************************************/
+
+void GDALDataset::UpdateBlockCacheUsage(GIntBig nCachedBytesDelta,
+                                        GIntBig nDirtyBytesDelta)
+{
+    if (!m_poPrivate)
+        return;
+    if (nCachedBytesDelta)
+        m_poPrivate->m_nBlockCacheUsed.fetch_add(nCachedBytesDelta,
+                                                 std::memory_order_relaxed);
+    if (nDirtyBytesDelta)
+        m_poPrivate->m_nBlockCacheDirty.fetch_add(nDirtyBytesDelta,
+                                                  std::memory_order_relaxed);
+}
+
+/************************************************************************/
+/*                         IncBlockCacheHits()                          */
+/************************************************************************/
+
+void GDALDataset::IncBlockCacheHits()
+{
+    if (m_poPrivate)
+        m_poPrivate->m_nBlockCacheHits.fetch_add(1, std::memory_order_relaxed);
+}
+
+/************************************************************************/
+/*                        IncBlockCacheMisses()                         */
+/************************************************************************/
+
+void GDALDataset::IncBlockCacheMisses()
+{
+    if (m_poPrivate)
+        m_poPrivate->m_nBlockCacheMisses.fetch_add(1,
+                                                   std::memory_order_relaxed);
+}
+
+/************************************************************************/
+/*                        GetBlockCacheUsage()                          */
+/************************************************************************/
+
+GIntBig GDALDataset::GetBlockCacheUsage() const
+{
+    return m_poPrivate
+               ? m_poPrivate->m_nBlockCacheUsed.load(std::memory_order_relaxed)
+               : 0;
+}
+
+/************************************************************************/
+/*                        GetBlockPrefetcher()                          */
+/************************************************************************/
+
+/** Return the block prefetcher of this dataset, instantiating it on the
+ * first call if the GDAL_BLOCK_PREFETCH configuration option is set.
+ *
+ * Read-ahead is only done on datasets opened in read-only mode, as their
+ * blocks cannot be dirty, and thus the prefetch jobs never need to
+ * interact with the read-write mutex of other datasets.
+ *
+ * It is not done on datasets that share the lock of a parent dataset (cf
+ * ShareLockWithParentDataset()), such as GTiff overviews and masks, as they
+ * also share its file handle. Their accesses are instead serialized with the
+ * prefetch jobs of the parent dataset, cf EnterBlockPrefetchLock().
+ */
+GDALRasterBlockPrefetcher *GDALDataset::GetBlockPrefetcher()
+{
+    if (!m_poPrivate || m_poPrivate->poParentDataset)
+        return nullptr;
+    // Wait for the bands to be set, which happens after eAccess is set by
+    // drivers.
+    if (!m_poPrivate->m_bBlockPrefetcherInitDone && nBands > 0)
+    {
+        m_poPrivate->m_bBlockPrefetcherInitDone = true;
+        if (eAccess == GA_ReadOnly)
+        {
+            m_poPrivate->m_poBlockPrefetcher =
+                GDALRasterBlockPrefetcher::Create(std::max(
+                    0, atoi(CPLGetConfigOption("GDAL_BLOCK_PREFETCH", "0"))));
+        }
+    }
+    return m_poPrivate->m_poBlockPrefetcher.get();
+}
+
+/************************************************************************/
+/*                   GetBlockPrefetchLockDataset()                      */
+/************************************************************************/
+
+/** Return the dataset whose prefetch jobs must be serialized with the
+ * accesses to this dataset: its top-level parent dataset, if any.
+ */
+GDALDataset *GDALDataset::GetBlockPrefetchLockDataset()
+{
+    GDALDataset *poDS = this;
+    while (poDS->m_poPrivate && poDS->m_poPrivate->poParentDataset)
+        poDS = poDS->m_poPrivate->poParentDataset;
+    return poDS;
+}
+
+/************************************************************************/
+/*                      EnterBlockPrefetchLock()                        */
+/************************************************************************/
+
+/** Serialize access to the dataset with the block prefetch jobs.
+ *
+ * @return true if LeaveBlockPrefetchLock() must be called afterwards.
+ */
+bool GDALDataset::EnterBlockPrefetchLock()
+{
+    GDALRasterBlockPrefetcher *poPrefetcher =
+        GetBlockPrefetchLockDataset()->GetBlockPrefetcher();
+    if (!poPrefetcher)
+        return false;
+    poPrefetcher->GetDatasetMutex().lock();
+    return true;
+}
+
+/************************************************************************/
+/*                      LeaveBlockPrefetchLock()                        */
+/************************************************************************/
+
+void GDALDataset::LeaveBlockPrefetchLock()
+{
+    GetBlockPrefetchLockDataset()
+        ->m_poPrivate->m_poBlockPrefetcher->GetDatasetMutex()
+        .unlock();
+}
+
+/************************************************************************/
+/*                        StopBlockPrefetcher()                         */
+/************************************************************************/
+
+/** Wait for pending block prefetch jobs and prevent new ones. */
+void GDALDataset::StopBlockPrefetcher()
+{
+    if (m_poPrivate && m_poPrivate->m_poBlockPrefetcher)
+        m_poPrivate->m_poBlockPrefetcher->Stop();
+}
+
+//! @endcond
+
 /************************************************************************/
 /*                      GetEstimatedRAMUsage()                          */
 /************************************************************************/
@@ -2936,6 +3282,7 @@ CPLErr GDALDataset::RasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
         panBandMap = m_poPrivate->m_anBandMap.data();
     }
 
+    const bool bCallLeaveBlockPrefetchLock = EnterBlockPrefetchLock();
     int bCallLeaveReadWrite = EnterReadWrite(eRWFlag);
 
     /* -------------------------------------------------------------------- */
@@ -2965,6 +3312,8 @@ CPLErr GDALDataset::RasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
 
     if (bCallLeaveReadWrite)
         LeaveReadWrite();
+    if (bCallLeaveBlockPrefetchLock)
+        LeaveBlockPrefetchLock();
 
     return eErr;
 }
@@ -24,10 +24,14 @@
 #include <cstdlib>
 #include <cstring>
 #include <algorithm>
+#include <atomic>
+#include <deque>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <new>
 #include <type_traits>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
@@ -39,8 +43,10 @@
 #include "gdal.h"
 #include "gdal_rat.h"
 #include "gdal_priv_templates.hpp"
+#include "gdal_thread_pool.h"
 #include "gdal_interpolateatpoint.h"
 #include "gdal_minmax_element.hpp"
+#include "gdalrasterblockprefetcher.h"
 
 /************************************************************************/
 /*                           GDALRasterBand()                           */
@@ -445,6 +451,8 @@ CPLErr GDALRasterBand::RasterIOInternal(
     /*      Call the format specific function.                              */
     /* -------------------------------------------------------------------- */
 
+    const bool bCallLeaveBlockPrefetchLock =
+        poDS && poDS->EnterBlockPrefetchLock();
     const bool bCallLeaveReadWrite = CPL_TO_BOOL(EnterReadWrite(eRWFlag));
 
     CPLErr eErr;
@@ -459,6 +467,8 @@ CPLErr GDALRasterBand::RasterIOInternal(
 
     if (bCallLeaveReadWrite)
         LeaveReadWrite();
+    if (bCallLeaveBlockPrefetchLock)
+        poDS->LeaveBlockPrefetchLock();
 
     return eErr;
 }
@@ -1098,10 +1108,14 @@ CPLErr GDALRasterBand::ReadBlock(int nXBlockOff, int nYBlockOff, void *pImage)
     /*      Invoke underlying implementation method.                        */
     /* -------------------------------------------------------------------- */
 
+    const bool bCallLeaveBlockPrefetchLock =
+        poDS && poDS->EnterBlockPrefetchLock();
     int bCallLeaveReadWrite = EnterReadWrite(GF_Read);
     CPLErr eErr = IReadBlock(nXBlockOff, nYBlockOff, pImage);
     if (bCallLeaveReadWrite)
         LeaveReadWrite();
+    if (bCallLeaveBlockPrefetchLock)
+        poDS->LeaveBlockPrefetchLock();
     return eErr;
 }
 
@@ -1660,7 +1674,12 @@ CPLErr GDALRasterBand::FlushCache(bool bAtClosing)
     if (poBandBlockCache == nullptr || !poBandBlockCache->IsInitOK())
         return eGlobalErr;
 
-    return poBandBlockCache->FlushCache();
+    const bool bCallLeaveBlockPrefetchLock =
+        poDS && poDS->EnterBlockPrefetchLock();
+    const CPLErr eErr = poBandBlockCache->FlushCache();
+    if (bCallLeaveBlockPrefetchLock)
+        poDS->LeaveBlockPrefetchLock();
+    return eErr;
 }
 
 /************************************************************************/
@@ -1716,9 +1735,17 @@ CPLErr GDALRasterBand::DropCache()
     }
 
     if (poBandBlockCache == nullptr || !poBandBlockCache->IsInitOK())
+    {
         result = eGlobalErr;
+    }
     else
+    {
+        const bool bCallLeaveBlockPrefetchLock =
+            poDS && poDS->EnterBlockPrefetchLock();
         result = poBandBlockCache->FlushCache();
+        if (bCallLeaveBlockPrefetchLock)
+            poDS->LeaveBlockPrefetchLock();
+    }
 
     if (poBandBlockCache)
         poBandBlockCache->EnableDirtyBlockWriting();
@@ -1938,10 +1965,28 @@ GDALRasterBlock *GDALRasterBand::GetLockedBlockRef(int nXBlockOff,
                                                    int bJustInitialize)
 
 {
+    // When blocks are read ahead, serialize with the prefetch jobs.
+    // Requests that only initialize a block do not read from the driver, and
+    // are issued by drivers from worker threads while the thread that spawned
+    // them holds the dataset mutex (e.g. GTiff multi-threaded decoding), so
+    // they must not wait for it.
+    GDALRasterBlockPrefetcher *poPrefetcher =
+        poDS && !bJustInitialize ? poDS->GetBlockPrefetcher() : nullptr;
+    std::unique_lock<std::recursive_timed_mutex> oPrefetchLock;
+    if (poPrefetcher)
+        oPrefetchLock = std::unique_lock<std::recursive_timed_mutex>(
+            poPrefetcher->GetDatasetMutex());
+
     /* -------------------------------------------------------------------- */
     /*      Try and fetch from cache.                                       */
     /* -------------------------------------------------------------------- */
     GDALRasterBlock *poBlock = TryGetLockedBlockRef(nXBlockOff, nYBlockOff);
+    if (poBlock && poPrefetcher && poBlock->IsPrefetched())
+    {
+        // Continue reading ahead the access pattern that led to this block.
+        poBlock->SetPrefetched(false);
+        poPrefetcher->NotifyBlockRequest(this, nXBlockOff, nYBlockOff);
+    }
 
     /* -------------------------------------------------------------------- */
     /*      If we didn't find it in our memory cache, instantiate a         */
@@ -2036,6 +2081,9 @@ GDALRasterBlock *GDALRasterBand::GetLockedBlockRef(int nXBlockOff,
                 return nullptr;
             }
 
+            if (poPrefetcher)
+                poPrefetcher->NotifyBlockRequest(this, nXBlockOff, nYBlockOff);
+
             nBlockReads++;
             if (static_cast<GIntBig>(nBlockReads) ==
                     static_cast<GIntBig>(nBlocksPerRow) * nBlocksPerColumn +
@@ -4088,873 +4136,897 @@ inline bool ARE_REAL_EQUAL(GFloat16 dfVal1, GFloat16 dfVal2, int ulp = 2)
 }
 
 /************************************************************************/
-/*                            GetHistogram()                            */
+/*                  GetNumThreadsForBlockProcessing()                   */
 /************************************************************************/
 
-/**
- * \brief Compute raster histogram.
- *
- * Note that the bucket size is (dfMax-dfMin) / nBuckets.
- *
- * For example to compute a simple 256 entry histogram of eight bit data,
- * the following would be suitable.  The unusual bounds are to ensure that
- * bucket boundaries don't fall right on integer values causing possible errors
- * due to rounding after scaling.
-\code{.cpp}
-    GUIntBig anHistogram[256];
+/** Return the number of threads to use to process the content of
+ * nSampledBlocks blocks when computing statistics, min/max or histograms,
+ * according to the GDAL_NUM_THREADS configuration option.
+ */
+static int GetNumThreadsForBlockProcessing(GIntBig nSampledBlocks)
+{
+    const char *pszThreads = CPLGetConfigOption("GDAL_NUM_THREADS", "1");
+    const int nThreads = std::max(1, std::min(128, EQUAL(pszThreads, "ALL_CPUS")
+                                                       ? CPLGetNumCPUs()
+                                                       : atoi(pszThreads)));
+    return static_cast<int>(
+        std::max<GIntBig>(1, std::min<GIntBig>(nThreads, nSampledBlocks)));
+}
 
-    poBand->GetHistogram( -0.5, 255.5, 256, anHistogram, FALSE, FALSE,
-                          GDALDummyProgress, nullptr );
-\endcode
+/************************************************************************/
+/*                        ProcessSampledBlocks()                        */
+/************************************************************************/
+
+/** Iterate over one block every nSampleRate blocks of a band, and accumulate
+ * their content into oAcc with processBlock(pData, pabyMaskData, nXCheck,
+ * nYCheck, nBlockXSize, oBlockAcc).
  *
- * Note that setting bApproxOK will generally result in a subsampling of the
- * file, and will utilize overviews if available.  It should generally
- * produce a representative histogram for the data that is suitable for use
- * in generating histogram based luts for instance.  Generally bApproxOK is
- * much faster than an exactly computed histogram.
+ * Blocks, and the corresponding part of the mask band if poMaskBand is not
+ * null, are read by the calling thread, as datasets are not thread-safe.
+ * When GDAL_NUM_THREADS is greater than 1, the processing of the content of
+ * the blocks is done by worker threads of the global thread pool, and
+ * overlaps with the reading of the next blocks.
  *
- * This method is the same as the C functions GDALGetRasterHistogram() and
- * GDALGetRasterHistogramEx().
+ * When bOrderedMerge is true, each block is accumulated into its own
+ * accumulator, and those accumulators are merged into oAcc with
+ * Accumulator::Merge() in block order, whether blocks are processed in the
+ * calling thread or in worker threads, so that the result does not depend on
+ * the number of threads. When bOrderedMerge is false, blocks are accumulated
+ * into a small pool of accumulators, which is only valid if Merge() is
+ * associative and commutative, as for integer sums, minimum and maximum, or
+ * histograms.
  *
- * @param dfMin the lower bound of the histogram.
- * @param dfMax the upper bound of the histogram.
- * @param nBuckets the number of buckets in panHistogram.
- * @param panHistogram array into which the histogram totals are placed.
- * @param bIncludeOutOfRange if TRUE values below the histogram range will
- * mapped into panHistogram[0], and values above will be mapped into
- * panHistogram[nBuckets-1] otherwise out of range values are discarded.
- * @param bApproxOK TRUE if an approximate, or incomplete histogram OK.
- * @param pfnProgress function to report progress to completion.
- * @param pProgressData application data to pass to pfnProgress.
+ * progress(iSampleBlock) is called after each block, and must return false
+ * to interrupt processing. canStop(oAcc), if not nullptr, may return true to
+ * stop iterating once the result can no longer change. With an unordered
+ * merge in several threads, it is evaluated on an accumulator into which the
+ * pool accumulators are merged after each block, possibly several times, so
+ * it must only depend on values for which Merge() is idempotent, such as the
+ * minimum and maximum.
  *
- * @return CE_None on success, or CE_Failure if something goes wrong.
+ * @return CE_None on success, CE_Failure in case of error (*pbInterrupted set
+ * to true if the error comes from the progress callback).
  */
+template <class Accumulator, class ProcessBlockFunc, class ProgressFunc,
+          class CanStopFunc>
+static CPLErr ProcessSampledBlocks(
+    GDALRasterBand *poBand, int nSampleRate, GDALRasterBand *poMaskBand,
+    bool bOrderedMerge, Accumulator &oAcc, const ProcessBlockFunc &processBlock,
+    const ProgressFunc &progress, const CanStopFunc &canStop,
+    bool *pbInterrupted)
+{
+    constexpr bool bHasCanStop =
+        !std::is_same_v<CanStopFunc, std::nullptr_t>;
 
-CPLErr GDALRasterBand::GetHistogram(double dfMin, double dfMax, int nBuckets,
-                                    GUIntBig *panHistogram,
-                                    int bIncludeOutOfRange, int bApproxOK,
-                                    GDALProgressFunc pfnProgress,
-                                    void *pProgressData)
+    *pbInterrupted = false;
 
-{
-    CPLAssert(nullptr != panHistogram);
+    int nBlockXSize = 0;
+    int nBlockYSize = 0;
+    poBand->GetBlockSize(&nBlockXSize, &nBlockYSize);
+    const int nBlocksPerRow =
+        DIV_ROUND_UP(poBand->GetXSize(), nBlockXSize);
+    const int nBlocksPerColumn =
+        DIV_ROUND_UP(poBand->GetYSize(), nBlockYSize);
+    const GIntBig nTotalBlocks =
+        static_cast<GIntBig>(nBlocksPerRow) * nBlocksPerColumn;
+    const size_t nMaskSize =
+        poMaskBand ? static_cast<size_t>(nBlockXSize) * nBlockYSize : 0;
 
-    if (pfnProgress == nullptr)
-        pfnProgress = GDALDummyProgress;
+    const int nThreads = GetNumThreadsForBlockProcessing(
+        DIV_ROUND_UP(nTotalBlocks, nSampleRate));
+    CPLWorkerThreadPool *poThreadPool =
+        nThreads > 1 ? GDALGetGlobalThreadPool(nThreads) : nullptr;
+
+    const Accumulator oEmptyAcc(oAcc);
 
     /* -------------------------------------------------------------------- */
-    /*      If we have overviews, use them for the histogram.               */
+    /*      Single-threaded processing.                                     */
     /* -------------------------------------------------------------------- */
-    if (bApproxOK && GetOverviewCount() > 0 && !HasArbitraryOverviews())
+    if (!poThreadPool)
     {
-        // FIXME: should we use the most reduced overview here or use some
-        // minimum number of samples like GDALRasterBand::ComputeStatistics()
-        // does?
-        GDALRasterBand *poBestOverview = GetRasterSampleOverview(0);
+        std::vector<GByte> abyMaskData;
+        try
+        {
+            abyMaskData.resize(nMaskSize);
+        }
+        catch (const std::exception &)
+        {
+            poBand->ReportError(CE_Failure, CPLE_OutOfMemory,
+                                "Out of memory allocating mask buffer");
+            return CE_Failure;
+        }
+        GByte *pabyMaskData = poMaskBand ? abyMaskData.data() : nullptr;
 
-        if (poBestOverview != this)
+        for (GIntBig iSampleBlock = 0; iSampleBlock < nTotalBlocks;
+             iSampleBlock += nSampleRate)
         {
-            return poBestOverview->GetHistogram(
-                dfMin, dfMax, nBuckets, panHistogram, bIncludeOutOfRange,
-                bApproxOK, pfnProgress, pProgressData);
+            const int iYBlock = static_cast<int>(iSampleBlock / nBlocksPerRow);
+            const int iXBlock = static_cast<int>(iSampleBlock % nBlocksPerRow);
+
+            GDALRasterBlock *const poBlock =
+                poBand->GetLockedBlockRef(iXBlock, iYBlock);
+            if (poBlock == nullptr)
+                return CE_Failure;
+
+            int nXCheck = 0, nYCheck = 0;
+            poBand->GetActualBlockSize(iXBlock, iYBlock, &nXCheck, &nYCheck);
+
+            if (poMaskBand &&
+                poMaskBand->RasterIO(GF_Read, iXBlock * nBlockXSize,
+                                     iYBlock * nBlockYSize, nXCheck, nYCheck,
+                                     pabyMaskData, nXCheck, nYCheck, GDT_Byte,
+                                     0, nBlockXSize, nullptr) != CE_None)
+            {
+                poBlock->DropLock();
+                return CE_Failure;
+            }
+
+            if (bOrderedMerge)
+            {
+                Accumulator oBlockAcc(oEmptyAcc);
+                processBlock(poBlock->GetDataRef(), pabyMaskData, nXCheck,
+                             nYCheck, nBlockXSize, oBlockAcc);
+                oAcc.Merge(oBlockAcc);
+            }
+            else
+            {
+                processBlock(poBlock->GetDataRef(), pabyMaskData, nXCheck,
+                             nYCheck, nBlockXSize, oAcc);
+            }
+
+            poBlock->DropLock();
+
+            if (!progress(iSampleBlock))
+            {
+                *pbInterrupted = true;
+                return CE_Failure;
+            }
+
+            if constexpr (bHasCanStop)
+            {
+                if (canStop(oAcc))
+                    break;
+            }
         }
+
+        return CE_None;
     }
 
     /* -------------------------------------------------------------------- */
-    /*      Read actual data and build histogram.                           */
+    /*      Multi-threaded processing.                                      */
     /* -------------------------------------------------------------------- */
-    if (!pfnProgress(0.0, "Compute Histogram", pProgressData))
-    {
-        ReportError(CE_Failure, CPLE_UserInterrupt, "User terminated");
-        return CE_Failure;
-    }
+    auto poJobQueue = poThreadPool->CreateJobQueue();
+    const int nMaxJobsInFlight = 2 * nThreads;
 
-    // Written this way to deal with NaN
-    if (!(dfMax > dfMin))
+    // Used when bOrderedMerge is false
+    std::vector<Accumulator> aoPoolAcc;
+    std::vector<Accumulator *> apoFreeAcc;
+    std::mutex oMutexFreeAcc;
+    // Used to evaluate canStop() when bOrderedMerge is false. Protected by
+    // oMutexFreeAcc.
+    Accumulator oStopAcc(oEmptyAcc);
+    std::atomic<bool> bCanStop{false};
+
+    // Used when bOrderedMerge is true
+    struct BlockAccumulator
     {
-        ReportError(CE_Failure, CPLE_IllegalArg,
-                    "dfMax should be strictly greater than dfMin");
-        return CE_Failure;
-    }
+        Accumulator oAcc;
+        std::atomic<bool> bDone{false};
 
-    GDALRasterIOExtraArg sExtraArg;
-    INIT_RASTERIO_EXTRA_ARG(sExtraArg);
+        explicit BlockAccumulator(const Accumulator &oAccIn) : oAcc(oAccIn)
+        {
+        }
+    };
 
-    const double dfScale = nBuckets / (dfMax - dfMin);
-    if (dfScale == 0 || !std::isfinite(dfScale))
+    std::deque<std::unique_ptr<BlockAccumulator>> apoBlockAcc;
+
+    if (!bOrderedMerge)
     {
-        ReportError(CE_Failure, CPLE_IllegalArg,
-                    "dfMin and dfMax should be finite values such that "
-                    "nBuckets / (dfMax - dfMin) is non-zero");
-        return CE_Failure;
+        aoPoolAcc.resize(nMaxJobsInFlight, oEmptyAcc);
+        for (auto &oPoolAcc : aoPoolAcc)
+            apoFreeAcc.push_back(&oPoolAcc);
     }
-    memset(panHistogram, 0, sizeof(GUIntBig) * nBuckets);
 
-    GDALNoDataValues sNoDataValues(this, eDataType);
-    GDALRasterBand *poMaskBand = nullptr;
-    if (!sNoDataValues.bGotNoDataValue)
+    const auto MergeFinishedBlocks = [&oAcc, &apoBlockAcc]()
     {
-        const int l_nMaskFlags = GetMaskFlags();
-        if (l_nMaskFlags != GMF_ALL_VALID && l_nMaskFlags != GMF_NODATA &&
-            GetColorInterpretation() != GCI_AlphaBand)
+        while (!apoBlockAcc.empty() &&
+               apoBlockAcc.front()->bDone.load(std::memory_order_acquire))
         {
-            poMaskBand = GetMaskBand();
+            oAcc.Merge(apoBlockAcc.front()->oAcc);
+            apoBlockAcc.pop_front();
         }
-    }
-
-    bool bSignedByte = false;
-    if (eDataType == GDT_Byte)
-    {
-        EnablePixelTypeSignedByteWarning(false);
-        const char *pszPixelType =
-            GetMetadataItem("PIXELTYPE", "IMAGE_STRUCTURE");
-        EnablePixelTypeSignedByteWarning(true);
-        bSignedByte =
-            pszPixelType != nullptr && EQUAL(pszPixelType, "SIGNEDBYTE");
-    }
+    };
 
-    if (bApproxOK && HasArbitraryOverviews())
+    CPLErr eErr = CE_None;
+    for (GIntBig iSampleBlock = 0; iSampleBlock < nTotalBlocks;
+         iSampleBlock += nSampleRate)
     {
-        /* --------------------------------------------------------------------
-         */
-        /*      Figure out how much the image should be reduced to get an */
-        /*      approximate value. */
-        /* --------------------------------------------------------------------
-         */
-        const double dfReduction =
-            sqrt(static_cast<double>(nRasterXSize) * nRasterYSize /
-                 GDALSTAT_APPROX_NUMSAMPLES);
+        const int iYBlock = static_cast<int>(iSampleBlock / nBlocksPerRow);
+        const int iXBlock = static_cast<int>(iSampleBlock % nBlocksPerRow);
 
-        int nXReduced = nRasterXSize;
-        int nYReduced = nRasterYSize;
-        if (dfReduction > 1.0)
+        // Limit the number of blocks locked at the same time.
+        poJobQueue->WaitCompletion(nMaxJobsInFlight - 1);
+        if (bOrderedMerge)
         {
-            nXReduced = static_cast<int>(nRasterXSize / dfReduction);
-            nYReduced = static_cast<int>(nRasterYSize / dfReduction);
-
-            // Catch the case of huge resizing ratios here
-            if (nXReduced == 0)
-                nXReduced = 1;
-            if (nYReduced == 0)
-                nYReduced = 1;
+            MergeFinishedBlocks();
+            if constexpr (bHasCanStop)
+            {
+                if (canStop(oAcc))
+                    break;
+            }
+        }
+        else if (bCanStop.load(std::memory_order_relaxed))
+        {
+            break;
         }
 
-        void *pData = VSI_MALLOC3_VERBOSE(GDALGetDataTypeSizeBytes(eDataType),
-                                          nXReduced, nYReduced);
-        if (!pData)
-            return CE_Failure;
-
-        const CPLErr eErr =
-            IRasterIO(GF_Read, 0, 0, nRasterXSize, nRasterYSize, pData,
-                      nXReduced, nYReduced, eDataType, 0, 0, &sExtraArg);
-        if (eErr != CE_None)
+        GDALRasterBlock *const poBlock =
+            poBand->GetLockedBlockRef(iXBlock, iYBlock);
+        if (poBlock == nullptr)
         {
-            CPLFree(pData);
-            return eErr;
+            eErr = CE_Failure;
+            break;
         }
 
-        GByte *pabyMaskData = nullptr;
+        int nXCheck = 0, nYCheck = 0;
+        poBand->GetActualBlockSize(iXBlock, iYBlock, &nXCheck, &nYCheck);
+
+        std::shared_ptr<std::vector<GByte>> poMaskData;
         if (poMaskBand)
         {
-            pabyMaskData =
-                static_cast<GByte *>(VSI_MALLOC2_VERBOSE(nXReduced, nYReduced));
-            if (!pabyMaskData)
+            try
             {
-                CPLFree(pData);
-                return CE_Failure;
+                poMaskData = std::make_shared<std::vector<GByte>>(nMaskSize);
             }
-
-            if (poMaskBand->RasterIO(GF_Read, 0, 0, nRasterXSize, nRasterYSize,
-                                     pabyMaskData, nXReduced, nYReduced,
-                                     GDT_Byte, 0, 0, nullptr) != CE_None)
+            catch (const std::exception &)
             {
-                CPLFree(pData);
-                CPLFree(pabyMaskData);
-                return CE_Failure;
+                poBand->ReportError(CE_Failure, CPLE_OutOfMemory,
+                                    "Out of memory allocating mask buffer");
+                poBlock->DropLock();
+                eErr = CE_Failure;
+                break;
+            }
+            if (poMaskBand->RasterIO(GF_Read, iXBlock * nBlockXSize,
+                                     iYBlock * nBlockYSize, nXCheck, nYCheck,
+                                     poMaskData->data(), nXCheck, nYCheck,
+                                     GDT_Byte, 0, nBlockXSize,
+                                     nullptr) != CE_None)
+            {
+                poBlock->DropLock();
+                eErr = CE_Failure;
+                break;
             }
         }
 
-        // This isn't the fastest way to do this, but is easier for now.
-        for (int iY = 0; iY < nYReduced; iY++)
+        BlockAccumulator *poBlockAcc = nullptr;
+        if (bOrderedMerge)
         {
-            for (int iX = 0; iX < nXReduced; iX++)
-            {
-                const int iOffset = iX + iY * nXReduced;
-                double dfValue = 0.0;
-
-                if (pabyMaskData && pabyMaskData[iOffset] == 0)
-                    continue;
+            apoBlockAcc.push_back(
+                std::make_unique<BlockAccumulator>(oEmptyAcc));
+            poBlockAcc = apoBlockAcc.back().get();
+        }
 
-                switch (eDataType)
+        poJobQueue->SubmitJob(
+            [&processBlock, &canStop, &oMutexFreeAcc, &apoFreeAcc, &oStopAcc,
+             &bCanStop, poBlock, poMaskData, poBlockAcc, nXCheck, nYCheck,
+             nBlockXSize]()
+            {
+                const GByte *pabyMaskData =
+                    poMaskData ? poMaskData->data() : nullptr;
+                if (poBlockAcc)
+                {
+                    processBlock(poBlock->GetDataRef(), pabyMaskData, nXCheck,
+                                 nYCheck, nBlockXSize, poBlockAcc->oAcc);
+                    poBlock->DropLock();
+                    poBlockAcc->bDone.store(true, std::memory_order_release);
+                }
+                else
                 {
-                    case GDT_Byte:
+                    Accumulator *poAcc;
                     {
-                        if (bSignedByte)
-                            dfValue =
-                                static_cast<signed char *>(pData)[iOffset];
-                        else
-                            dfValue = static_cast<GByte *>(pData)[iOffset];
-                        break;
+                        std::lock_guard oLock(oMutexFreeAcc);
+                        poAcc = apoFreeAcc.back();
+                        apoFreeAcc.pop_back();
                     }
-                    case GDT_Int8:
-                        dfValue = static_cast<GInt8 *>(pData)[iOffset];
-                        break;
-                    case GDT_UInt16:
-                        dfValue = static_cast<GUInt16 *>(pData)[iOffset];
-                        break;
-                    case GDT_Int16:
-                        dfValue = static_cast<GInt16 *>(pData)[iOffset];
-                        break;
-                    case GDT_UInt32:
-                        dfValue = static_cast<GUInt32 *>(pData)[iOffset];
-                        break;
-                    case GDT_Int32:
-                        dfValue = static_cast<GInt32 *>(pData)[iOffset];
-                        break;
-                    case GDT_UInt64:
-                        dfValue = static_cast<double>(
-                            static_cast<GUInt64 *>(pData)[iOffset]);
-                        break;
-                    case GDT_Int64:
-                        dfValue = static_cast<double>(
-                            static_cast<GInt64 *>(pData)[iOffset]);
-                        break;
-                    case GDT_Float16:
+                    processBlock(poBlock->GetDataRef(), pabyMaskData, nXCheck,
+                                 nYCheck, nBlockXSize, *poAcc);
+                    poBlock->DropLock();
                     {
-                        using namespace std;
-                        const GFloat16 hfValue =
-                            static_cast<GFloat16 *>(pData)[iOffset];
-                        if (isnan(hfValue) ||
-                            (sNoDataValues.bGotFloat16NoDataValue &&
-                             ARE_REAL_EQUAL(hfValue,
-                                            sNoDataValues.hfNoDataValue)))
-                            continue;
-                        dfValue = hfValue;
-                        break;
-                    }
-                    case GDT_Float32:
-                    {
-                        const float fValue =
-                            static_cast<float *>(pData)[iOffset];
-                        if (std::isnan(fValue) ||
-                            (sNoDataValues.bGotFloatNoDataValue &&
-                             ARE_REAL_EQUAL(fValue,
-                                            sNoDataValues.fNoDataValue)))
-                            continue;
-                        dfValue = fValue;
-                        break;
-                    }
-                    case GDT_Float64:
-                        dfValue = static_cast<double *>(pData)[iOffset];
-                        if (std::isnan(dfValue))
-                            continue;
-                        break;
-                    case GDT_CInt16:
-                    {
-                        const double dfReal =
-                            static_cast<GInt16 *>(pData)[iOffset * 2];
-                        const double dfImag =
-                            static_cast<GInt16 *>(pData)[iOffset * 2 + 1];
-                        if (std::isnan(dfReal) || std::isnan(dfImag))
-                            continue;
-                        dfValue = sqrt(dfReal * dfReal + dfImag * dfImag);
-                    }
-                    break;
-                    case GDT_CInt32:
-                    {
-                        const double dfReal =
-                            static_cast<GInt32 *>(pData)[iOffset * 2];
-                        const double dfImag =
-                            static_cast<GInt32 *>(pData)[iOffset * 2 + 1];
-                        if (std::isnan(dfReal) || std::isnan(dfImag))
-                            continue;
-                        dfValue = sqrt(dfReal * dfReal + dfImag * dfImag);
-                    }
-                    break;
-                    case GDT_CFloat16:
-                    {
-                        const double dfReal =
-                            static_cast<GFloat16 *>(pData)[iOffset * 2];
-                        const double dfImag =
-                            static_cast<GFloat16 *>(pData)[iOffset * 2 + 1];
-                        if (std::isnan(dfReal) || std::isnan(dfImag))
-                            continue;
-                        dfValue = sqrt(dfReal * dfReal + dfImag * dfImag);
-                        break;
-                    }
-                    case GDT_CFloat32:
-                    {
-                        const double dfReal =
-                            static_cast<float *>(pData)[iOffset * 2];
-                        const double dfImag =
-                            static_cast<float *>(pData)[iOffset * 2 + 1];
-                        if (std::isnan(dfReal) || std::isnan(dfImag))
-                            continue;
-                        dfValue = sqrt(dfReal * dfReal + dfImag * dfImag);
-                        break;
-                    }
-                    case GDT_CFloat64:
-                    {
-                        const double dfReal =
-                            static_cast<double *>(pData)[iOffset * 2];
-                        const double dfImag =
-                            static_cast<double *>(pData)[iOffset * 2 + 1];
-                        if (std::isnan(dfReal) || std::isnan(dfImag))
-                            continue;
-                        dfValue = sqrt(dfReal * dfReal + dfImag * dfImag);
-                        break;
+                        std::lock_guard oLock(oMutexFreeAcc);
+                        if constexpr (bHasCanStop)
+                        {
+                            oStopAcc.Merge(*poAcc);
+                            if (canStop(oStopAcc))
+                                bCanStop = true;
+                        }
+                        apoFreeAcc.push_back(poAcc);
                     }
-                    case GDT_Unknown:
-                    case GDT_TypeCount:
-                        CPLAssert(false);
                 }
+            });
 
-                if (eDataType != GDT_Float16 && eDataType != GDT_Float32 &&
-                    sNoDataValues.bGotNoDataValue &&
-                    ARE_REAL_EQUAL(dfValue, sNoDataValues.dfNoDataValue))
-                    continue;
-
-                // Given that dfValue and dfMin are not NaN, and dfScale > 0 and
-                // finite, the result of the multiplication cannot be NaN
-                const double dfIndex = floor((dfValue - dfMin) * dfScale);
-
-                if (dfIndex < 0)
-                {
-                    if (bIncludeOutOfRange)
-                        panHistogram[0]++;
-                }
-                else if (dfIndex >= nBuckets)
-                {
-                    if (bIncludeOutOfRange)
-                        ++panHistogram[nBuckets - 1];
-                }
-                else
-                {
-                    ++panHistogram[static_cast<int>(dfIndex)];
-                }
-            }
+        if (!progress(iSampleBlock))
+        {
+            *pbInterrupted = true;
+            eErr = CE_Failure;
+            break;
         }
+    }
 
-        CPLFree(pData);
-        CPLFree(pabyMaskData);
+    poJobQueue->WaitCompletion();
+
+    if (bOrderedMerge)
+    {
+        MergeFinishedBlocks();
     }
-    else  // No arbitrary overviews.
+    else
     {
-        if (!InitBlockInfo())
-            return CE_Failure;
+        for (const auto &oPoolAcc : aoPoolAcc)
+            oAcc.Merge(oPoolAcc);
+    }
 
-        /* --------------------------------------------------------------------
-         */
-        /*      Figure out the ratio of blocks we will read to get an */
-        /*      approximate value. */
-        /* --------------------------------------------------------------------
-         */
+    return eErr;
+}
 
-        int nSampleRate = 1;
-        if (bApproxOK)
-        {
-            nSampleRate = static_cast<int>(std::max(
-                1.0,
-                sqrt(static_cast<double>(nBlocksPerRow) * nBlocksPerColumn)));
-            // We want to avoid probing only the first column of blocks for
-            // a square shaped raster, because it is not unlikely that it may
-            // be padding only (#6378).
-            if (nSampleRate == nBlocksPerRow && nBlocksPerRow > 1)
-                nSampleRate += 1;
-        }
+/************************************************************************/
+/*                       GDALHistogramAccumulator                       */
+/************************************************************************/
 
-        GByte *pabyMaskData = nullptr;
-        if (poMaskBand)
+namespace
+{
+struct GDALHistogramAccumulator
+{
+    std::vector<GUIntBig> anHistogram{};
+
+    explicit GDALHistogramAccumulator(int nBuckets) : anHistogram(nBuckets)
+    {
+    }
+
+    void Merge(const GDALHistogramAccumulator &other)
+    {
+        for (size_t i = 0; i < anHistogram.size(); ++i)
+            anHistogram[i] += other.anHistogram[i];
+    }
+};
+}  // namespace
+
+/************************************************************************/
+/*                      ComputeHistogramForBlock()                      */
+/************************************************************************/
+
+/** Return in dfValue the value of the pixel at iOffset of a block of type
+ * T (or of complex type with components of type T), or false if it must
+ * be ignored (nodata or NaN).
+ */
+template <class T, bool COMPLEX>
+static inline bool GetHistogramPixelValue(const void *pData,
+                                          GPtrDiff_t iOffset,
+                                          const GDALNoDataValues &sNoDataValues,
+                                          double &dfValue)
+{
+    const T *const paData = static_cast<const T *>(pData);
+    if constexpr (COMPLEX)
+    {
+        const double dfReal = static_cast<double>(paData[iOffset * 2]);
+        const double dfImag = static_cast<double>(paData[iOffset * 2 + 1]);
+        if (std::isnan(dfReal) || std::isnan(dfImag))
+            return false;
+        dfValue = sqrt(dfReal * dfReal + dfImag * dfImag);
+    }
+    else if constexpr (std::is_same_v<T, GFloat16>)
+    {
+        using namespace std;
+        const GFloat16 hfValue = paData[iOffset];
+        if (isnan(hfValue) ||
+            (sNoDataValues.bGotFloat16NoDataValue &&
+             ARE_REAL_EQUAL(hfValue, sNoDataValues.hfNoDataValue)))
+            return false;
+        dfValue = hfValue;
+        return true;
+    }
+    else if constexpr (std::is_same_v<T, float>)
+    {
+        const float fValue = paData[iOffset];
+        if (std::isnan(fValue) ||
+            (sNoDataValues.bGotFloatNoDataValue &&
+             ARE_REAL_EQUAL(fValue, sNoDataValues.fNoDataValue)))
+            return false;
+        dfValue = fValue;
+        return true;
+    }
+    else
+    {
+        dfValue = static_cast<double>(paData[iOffset]);
+        if constexpr (std::is_same_v<T, double>)
         {
-            pabyMaskData = static_cast<GByte *>(
-                VSI_MALLOC2_VERBOSE(nBlockXSize, nBlockYSize));
-            if (!pabyMaskData)
-            {
-                return CE_Failure;
-            }
+            if (std::isnan(dfValue))
+                return false;
         }
+    }
+    return !(sNoDataValues.bGotNoDataValue &&
+             ARE_REAL_EQUAL(dfValue, sNoDataValues.dfNoDataValue));
+}
 
-        /* --------------------------------------------------------------------
-         */
-        /*      Read the blocks, and add to histogram. */
-        /* --------------------------------------------------------------------
-         */
-        for (GIntBig iSampleBlock = 0;
-             iSampleBlock <
-             static_cast<GIntBig>(nBlocksPerRow) * nBlocksPerColumn;
-             iSampleBlock += nSampleRate)
+/** Accumulate into panHistogram the pixels of a block of type T (or of
+ * complex type with components of type T).
+ */
+template <class T, bool COMPLEX>
+static void ComputeHistogramForBlock(const GDALNoDataValues &sNoDataValues,
+                                     double dfMin, double dfScale,
+                                     int nBuckets, bool bIncludeOutOfRange,
+                                     const void *pData,
+                                     const GByte *pabyMaskData, int nXCheck,
+                                     int nYCheck, int nBlockXSize,
+                                     GUIntBig *panHistogram)
+{
+    for (int iY = 0; iY < nYCheck; iY++)
+    {
+        for (int iX = 0; iX < nXCheck; iX++)
         {
-            if (!pfnProgress(
-                    static_cast<double>(iSampleBlock) /
-                        (static_cast<double>(nBlocksPerRow) * nBlocksPerColumn),
-                    "Compute Histogram", pProgressData))
-            {
-                CPLFree(pabyMaskData);
-                return CE_Failure;
-            }
-
-            const int iYBlock = static_cast<int>(iSampleBlock / nBlocksPerRow);
-            const int iXBlock = static_cast<int>(iSampleBlock % nBlocksPerRow);
+            const GPtrDiff_t iOffset =
+                iX + static_cast<GPtrDiff_t>(iY) * nBlockXSize;
 
-            GDALRasterBlock *poBlock = GetLockedBlockRef(iXBlock, iYBlock);
-            if (poBlock == nullptr)
-            {
-                CPLFree(pabyMaskData);
-                return CE_Failure;
-            }
+            if (pabyMaskData && pabyMaskData[iOffset] == 0)
+                continue;
 
-            void *pData = poBlock->GetDataRef();
+            double dfValue = 0.0;
+            if (!GetHistogramPixelValue<T, COMPLEX>(pData, iOffset,
+                                                    sNoDataValues, dfValue))
+                continue;
 
-            int nXCheck = 0, nYCheck = 0;
-            GetActualBlockSize(iXBlock, iYBlock, &nXCheck, &nYCheck);
+            // Given that dfValue and dfMin are not NaN, and dfScale > 0
+            // and finite, the result of the multiplication cannot be
+            // NaN
+            const double dfIndex = floor((dfValue - dfMin) * dfScale);
 
-            if (poMaskBand &&
-                poMaskBand->RasterIO(GF_Read, iXBlock * nBlockXSize,
-                                     iYBlock * nBlockYSize, nXCheck, nYCheck,
-                                     pabyMaskData, nXCheck, nYCheck, GDT_Byte,
-                                     0, nBlockXSize, nullptr) != CE_None)
+            if (dfIndex < 0)
             {
-                CPLFree(pabyMaskData);
-                poBlock->DropLock();
-                return CE_Failure;
+                if (bIncludeOutOfRange)
+                    panHistogram[0]++;
             }
-
-            // this is a special case for a common situation.
-            if (eDataType == GDT_Byte && !bSignedByte && dfScale == 1.0 &&
-                (dfMin >= -0.5 && dfMin <= 0.5) && nYCheck == nBlockYSize &&
-                nXCheck == nBlockXSize && nBuckets == 256)
+            else if (dfIndex >= nBuckets)
             {
-                const GPtrDiff_t nPixels =
-                    static_cast<GPtrDiff_t>(nXCheck) * nYCheck;
-                GByte *pabyData = static_cast<GByte *>(pData);
-
-                for (GPtrDiff_t i = 0; i < nPixels; i++)
-                {
-                    if (pabyMaskData && pabyMaskData[i] == 0)
-                        continue;
-                    if (!(sNoDataValues.bGotNoDataValue &&
-                          (pabyData[i] ==
-                           static_cast<GByte>(sNoDataValues.dfNoDataValue))))
-                    {
-                        panHistogram[pabyData[i]]++;
-                    }
-                }
-
-                poBlock->DropLock();
-                continue;  // To next sample block.
+                if (bIncludeOutOfRange)
+                    ++panHistogram[nBuckets - 1];
             }
-
-            // This isn't the fastest way to do this, but is easier for now.
-            for (int iY = 0; iY < nYCheck; iY++)
+            else
             {
-                for (int iX = 0; iX < nXCheck; iX++)
-                {
-                    const GPtrDiff_t iOffset =
-                        iX + static_cast<GPtrDiff_t>(iY) * nBlockXSize;
-
-                    if (pabyMaskData && pabyMaskData[iOffset] == 0)
-                        continue;
-
-                    double dfValue = 0.0;
-
-                    switch (eDataType)
-                    {
-                        case GDT_Byte:
-                        {
-                            if (bSignedByte)
-                                dfValue =
-                                    static_cast<signed char *>(pData)[iOffset];
-                            else
-                                dfValue = static_cast<GByte *>(pData)[iOffset];
-                            break;
-                        }
-                        case GDT_Int8:
-                            dfValue = static_cast<GInt8 *>(pData)[iOffset];
-                            break;
-                        case GDT_UInt16:
-                            dfValue = static_cast<GUInt16 *>(pData)[iOffset];
-                            break;
-                        case GDT_Int16:
-                            dfValue = static_cast<GInt16 *>(pData)[iOffset];
-                            break;
-                        case GDT_UInt32:
-                            dfValue = static_cast<GUInt32 *>(pData)[iOffset];
-                            break;
-                        case GDT_Int32:
-                            dfValue = static_cast<GInt32 *>(pData)[iOffset];
-                            break;
-                        case GDT_UInt64:
-                            dfValue = static_cast<double>(
-                                static_cast<GUInt64 *>(pData)[iOffset]);
-                            break;
-                        case GDT_Int64:
-                            dfValue = static_cast<double>(
-                                static_cast<GInt64 *>(pData)[iOffset]);
-                            break;
-                        case GDT_Float16:
-                        {
-                            using namespace std;
-                            const GFloat16 hfValue =
-                                static_cast<GFloat16 *>(pData)[iOffset];
-                            if (isnan(hfValue) ||
-                                (sNoDataValues.bGotFloat16NoDataValue &&
-                                 ARE_REAL_EQUAL(hfValue,
-                                                sNoDataValues.hfNoDataValue)))
-                                continue;
-                            dfValue = hfValue;
-                            break;
-                        }
-                        case GDT_Float32:
-                        {
-                            const float fValue =
-                                static_cast<float *>(pData)[iOffset];
-                            if (std::isnan(fValue) ||
-                                (sNoDataValues.bGotFloatNoDataValue &&
-                                 ARE_REAL_EQUAL(fValue,
-                                                sNoDataValues.fNoDataValue)))
-                                continue;
-                            dfValue = fValue;
-                            break;
-                        }
-                        case GDT_Float64:
-                            dfValue = static_cast<double *>(pData)[iOffset];
-                            if (std::isnan(dfValue))
-                                continue;
-                            break;
-                        case GDT_CInt16:
-                        {
-                            double dfReal =
-                                static_cast<GInt16 *>(pData)[iOffset * 2];
-                            double dfImag =
-                                static_cast<GInt16 *>(pData)[iOffset * 2 + 1];
-                            dfValue = sqrt(dfReal * dfReal + dfImag * dfImag);
-                            break;
-                        }
-                        case GDT_CInt32:
-                        {
-                            double dfReal =
-                                static_cast<GInt32 *>(pData)[iOffset * 2];
-                            double dfImag =
-                                static_cast<GInt32 *>(pData)[iOffset * 2 + 1];
-                            dfValue = sqrt(dfReal * dfReal + dfImag * dfImag);
-                            break;
-                        }
-                        case GDT_CFloat16:
-                        {
-                            double dfReal =
-                                static_cast<GFloat16 *>(pData)[iOffset * 2];
-                            double dfImag =
-                                static_cast<GFloat16 *>(pData)[iOffset * 2 + 1];
-                            if (std::isnan(dfReal) || std::isnan(dfImag))
-                                continue;
-                            dfValue = sqrt(dfReal * dfReal + dfImag * dfImag);
-                            break;
-                        }
-                        case GDT_CFloat32:
-                        {
-                            double dfReal =
-                                static_cast<float *>(pData)[iOffset * 2];
-                            double dfImag =
-                                static_cast<float *>(pData)[iOffset * 2 + 1];
-                            if (std::isnan(dfReal) || std::isnan(dfImag))
-                                continue;
-                            dfValue = sqrt(dfReal * dfReal + dfImag * dfImag);
-                            break;
-                        }
-                        case GDT_CFloat64:
-                        {
-                            double dfReal =
-                                static_cast<double *>(pData)[iOffset * 2];
-                            double dfImag =
-                                static_cast<double *>(pData)[iOffset * 2 + 1];
-                            if (std::isnan(dfReal) || std::isnan(dfImag))
-                                continue;
-                            dfValue = sqrt(dfReal * dfReal + dfImag * dfImag);
-                            break;
-                        }
-                        case GDT_Unknown:
-                        case GDT_TypeCount:
-                            CPLAssert(false);
-                            CPLFree(pabyMaskData);
-                            return CE_Failure;
-                    }
-
-                    if (eDataType != GDT_Float16 && eDataType != GDT_Float32 &&
-                        sNoDataValues.bGotNoDataValue &&
-                        ARE_REAL_EQUAL(dfValue, sNoDataValues.dfNoDataValue))
-                        continue;
-
-                    // Given that dfValue and dfMin are not NaN, and dfScale > 0
-                    // and finite, the result of the multiplication cannot be
-                    // NaN
-                    const double dfIndex = floor((dfValue - dfMin) * dfScale);
-
-                    if (dfIndex < 0)
-                    {
-                        if (bIncludeOutOfRange)
-                            panHistogram[0]++;
-                    }
-                    else if (dfIndex >= nBuckets)
-                    {
-                        if (bIncludeOutOfRange)
-                            ++panHistogram[nBuckets - 1];
-                    }
-                    else
-                    {
-                        ++panHistogram[static_cast<int>(dfIndex)];
-                    }
-                }
+                ++panHistogram[static_cast<int>(dfIndex)];
             }
-
-            poBlock->DropLock();
         }
-
-        CPLFree(pabyMaskData);
     }
-
-    pfnProgress(1.0, "Compute Histogram", pProgressData);
-
-    return CE_None;
 }
 
-/************************************************************************/
-/*                       GDALGetRasterHistogram()                       */
-/************************************************************************/
-
-/**
- * \brief Compute raster histogram.
- *
- * Use GDALGetRasterHistogramEx() instead to get correct counts for values
- * exceeding 2 billion.
- *
- * @see GDALRasterBand::GetHistogram()
- * @see GDALGetRasterHistogramEx()
- */
+static void ComputeHistogramForBlock(
+    GDALDataType eDataType, bool bSignedByte,
+    const GDALNoDataValues &sNoDataValues, double dfMin, double dfScale,
+    int nBuckets, bool bIncludeOutOfRange, const void *pData,
+    const GByte *pabyMaskData, int nXCheck, int nYCheck, int nBlockXSize,
+    int nBlockYSize, GUIntBig *panHistogram)
+{
+    // this is a special case for a common situation.
+    if (eDataType == GDT_Byte && !bSignedByte && dfScale == 1.0 &&
+        (dfMin >= -0.5 && dfMin <= 0.5) && nYCheck == nBlockYSize &&
+        nXCheck == nBlockXSize && nBuckets == 256)
+    {
+        const GPtrDiff_t nPixels =
+            static_cast<GPtrDiff_t>(nXCheck) * nYCheck;
+        const GByte *pabyData = static_cast<const GByte *>(pData);
 
-CPLErr CPL_STDCALL GDALGetRasterHistogram(GDALRasterBandH hBand, double dfMin,
-                                          double dfMax, int nBuckets,
-                                          int *panHistogram,
-                                          int bIncludeOutOfRange, int bApproxOK,
-                                          GDALProgressFunc pfnProgress,
-                                          void *pProgressData)
+        for (GPtrDiff_t i = 0; i < nPixels; i++)
+        {
+            if (pabyMaskData && pabyMaskData[i] == 0)
+                continue;
+            if (!(sNoDataValues.bGotNoDataValue &&
+                  (pabyData[i] ==
+                   static_cast<GByte>(sNoDataValues.dfNoDataValue))))
+            {
+                panHistogram[pabyData[i]]++;
+            }
+        }
 
-{
-    VALIDATE_POINTER1(hBand, "GDALGetRasterHistogram", CE_Failure);
-    VALIDATE_POINTER1(panHistogram, "GDALGetRasterHistogram", CE_Failure);
+        return;
+    }
 
-    GDALRasterBand *poBand = GDALRasterBand::FromHandle(hBand);
+    const auto Process = [&](auto pfnComputeHistogramForBlock)
+    {
+        pfnComputeHistogramForBlock(sNoDataValues, dfMin, dfScale, nBuckets,
+                                    bIncludeOutOfRange, pData, pabyMaskData,
+                                    nXCheck, nYCheck, nBlockXSize,
+                                    panHistogram);
+    };
 
-    GUIntBig *panHistogramTemp =
-        static_cast<GUIntBig *>(VSIMalloc2(sizeof(GUIntBig), nBuckets));
-    if (panHistogramTemp == nullptr)
-    {
-        poBand->ReportError(CE_Failure, CPLE_OutOfMemory,
-                            "Out of memory in GDALGetRasterHistogram().");
-        return CE_Failure;
-    }
-
-    CPLErr eErr = poBand->GetHistogram(dfMin, dfMax, nBuckets, panHistogramTemp,
-                                       bIncludeOutOfRange, bApproxOK,
-                                       pfnProgress, pProgressData);
-
-    if (eErr == CE_None)
+    switch (eDataType)
     {
-        for (int i = 0; i < nBuckets; i++)
-        {
-            if (panHistogramTemp[i] > INT_MAX)
-            {
-                CPLError(CE_Warning, CPLE_AppDefined,
-                         "Count for bucket %d, which is " CPL_FRMT_GUIB
-                         " exceeds maximum 32 bit value",
-                         i, panHistogramTemp[i]);
-                panHistogram[i] = INT_MAX;
-            }
+        case GDT_Byte:
+            if (bSignedByte)
+                Process(ComputeHistogramForBlock<signed char, false>);
             else
-            {
-                panHistogram[i] = static_cast<int>(panHistogramTemp[i]);
-            }
-        }
+                Process(ComputeHistogramForBlock<GByte, false>);
+            break;
+        case GDT_Int8:
+            Process(ComputeHistogramForBlock<GInt8, false>);
+            break;
+        case GDT_UInt16:
+            Process(ComputeHistogramForBlock<GUInt16, false>);
+            break;
+        case GDT_Int16:
+            Process(ComputeHistogramForBlock<GInt16, false>);
+            break;
+        case GDT_UInt32:
+            Process(ComputeHistogramForBlock<GUInt32, false>);
+            break;
+        case GDT_Int32:
+            Process(ComputeHistogramForBlock<GInt32, false>);
+            break;
+        case GDT_UInt64:
+            Process(ComputeHistogramForBlock<GUInt64, false>);
+            break;
+        case GDT_Int64:
+            Process(ComputeHistogramForBlock<GInt64, false>);
+            break;
+        case GDT_Float16:
+            Process(ComputeHistogramForBlock<GFloat16, false>);
+            break;
+        case GDT_Float32:
+            Process(ComputeHistogramForBlock<float, false>);
+            break;
+        case GDT_Float64:
+            Process(ComputeHistogramForBlock<double, false>);
+            break;
+        case GDT_CInt16:
+            Process(ComputeHistogramForBlock<GInt16, true>);
+            break;
+        case GDT_CInt32:
+            Process(ComputeHistogramForBlock<GInt32, true>);
+            break;
+        case GDT_CFloat16:
+            Process(ComputeHistogramForBlock<GFloat16, true>);
+            break;
+        case GDT_CFloat32:
+            Process(ComputeHistogramForBlock<float, true>);
+            break;
+        case GDT_CFloat64:
+            Process(ComputeHistogramForBlock<double, true>);
+            break;
+        case GDT_Unknown:
+        case GDT_TypeCount:
+            CPLAssert(false);
+            break;
     }
-
-    CPLFree(panHistogramTemp);
-
-    return eErr;
 }
 
+static bool TakeMultiBandPassHistogram(GDALRasterBand *poBand, double dfMin,
+                                       double dfMax, int nBuckets,
+                                       bool bIncludeOutOfRange,
+                                       int nSampleRate, GUIntBig *panHistogram,
+                                       bool &bError);
+
 /************************************************************************/
-/*                      GDALGetRasterHistogramEx()                      */
+/*                            GetHistogram()                            */
 /************************************************************************/
 
 /**
  * \brief Compute raster histogram.
  *
- * @see GDALRasterBand::GetHistogram()
+ * Note that the bucket size is (dfMax-dfMin) / nBuckets.
  *
- * @since GDAL 2.0
- */
-
-CPLErr CPL_STDCALL GDALGetRasterHistogramEx(
-    GDALRasterBandH hBand, double dfMin, double dfMax, int nBuckets,
-    GUIntBig *panHistogram, int bIncludeOutOfRange, int bApproxOK,
-    GDALProgressFunc pfnProgress, void *pProgressData)
-
-{
-    VALIDATE_POINTER1(hBand, "GDALGetRasterHistogramEx", CE_Failure);
-    VALIDATE_POINTER1(panHistogram, "GDALGetRasterHistogramEx", CE_Failure);
-
-    GDALRasterBand *poBand = GDALRasterBand::FromHandle(hBand);
-
-    return poBand->GetHistogram(dfMin, dfMax, nBuckets, panHistogram,
-                                bIncludeOutOfRange, bApproxOK, pfnProgress,
-                                pProgressData);
-}
-
-/************************************************************************/
-/*                        GetDefaultHistogram()                         */
-/************************************************************************/
+ * For example to compute a simple 256 entry histogram of eight bit data,
+ * the following would be suitable.  The unusual bounds are to ensure that
+ * bucket boundaries don't fall right on integer values causing possible errors
+ * due to rounding after scaling.
+\code{.cpp}
+    GUIntBig anHistogram[256];
 
-/**
- * \brief Fetch default raster histogram.
+    poBand->GetHistogram( -0.5, 255.5, 256, anHistogram, FALSE, FALSE,
+                          GDALDummyProgress, nullptr );
+\endcode
  *
- * The default method in GDALRasterBand will compute a default histogram. This
- * method is overridden by derived classes (such as GDALPamRasterBand,
- * VRTDataset, HFADataset...) that may be able to fetch efficiently an already
- * stored histogram.
+ * Note that setting bApproxOK will generally result in a subsampling of the
+ * file, and will utilize overviews if available.  It should generally
+ * produce a representative histogram for the data that is suitable for use
+ * in generating histogram based luts for instance.  Generally bApproxOK is
+ * much faster than an exactly computed histogram.
  *
- * This method is the same as the C functions GDALGetDefaultHistogram() and
- * GDALGetDefaultHistogramEx().
+ * Starting with GDAL 3.12, the GDAL_NUM_THREADS configuration option can be
+ * set to an integer or ALL_CPUS to process the content of blocks in several
+ * threads, while they are read by the calling thread.
  *
- * @param pdfMin pointer to double value that will contain the lower bound of
- * the histogram.
- * @param pdfMax pointer to double value that will contain the upper bound of
- * the histogram.
- * @param pnBuckets pointer to int value that will contain the number of buckets
- * in *ppanHistogram.
- * @param ppanHistogram pointer to array into which the histogram totals are
- * placed. To be freed with VSIFree
- * @param bForce TRUE to force the computation. If FALSE and no default
- * histogram is available, the method will return CE_Warning
+ * This method is the same as the C functions GDALGetRasterHistogram() and
+ * GDALGetRasterHistogramEx().
+ *
+ * @param dfMin the lower bound of the histogram.
+ * @param dfMax the upper bound of the histogram.
+ * @param nBuckets the number of buckets in panHistogram.
+ * @param panHistogram array into which the histogram totals are placed.
+ * @param bIncludeOutOfRange if TRUE values below the histogram range will
+ * mapped into panHistogram[0], and values above will be mapped into
+ * panHistogram[nBuckets-1] otherwise out of range values are discarded.
+ * @param bApproxOK TRUE if an approximate, or incomplete histogram OK.
  * @param pfnProgress function to report progress to completion.
  * @param pProgressData application data to pass to pfnProgress.
  *
- * @return CE_None on success, CE_Failure if something goes wrong, or
- * CE_Warning if no default histogram is available.
+ * @return CE_None on success, or CE_Failure if something goes wrong.
  */
 
-CPLErr GDALRasterBand::GetDefaultHistogram(double *pdfMin, double *pdfMax,
-                                           int *pnBuckets,
-                                           GUIntBig **ppanHistogram, int bForce,
-                                           GDALProgressFunc pfnProgress,
-                                           void *pProgressData)
+CPLErr GDALRasterBand::GetHistogram(double dfMin, double dfMax, int nBuckets,
+                                    GUIntBig *panHistogram,
+                                    int bIncludeOutOfRange, int bApproxOK,
+                                    GDALProgressFunc pfnProgress,
+                                    void *pProgressData)
 
 {
-    CPLAssert(nullptr != pnBuckets);
-    CPLAssert(nullptr != ppanHistogram);
-    CPLAssert(nullptr != pdfMin);
-    CPLAssert(nullptr != pdfMax);
+    CPLAssert(nullptr != panHistogram);
 
-    *pnBuckets = 0;
-    *ppanHistogram = nullptr;
+    if (pfnProgress == nullptr)
+        pfnProgress = GDALDummyProgress;
 
-    if (!bForce)
-        return CE_Warning;
+    /* -------------------------------------------------------------------- */
+    /*      If we have overviews, use them for the histogram.               */
+    /* -------------------------------------------------------------------- */
+    if (bApproxOK && GetOverviewCount() > 0 && !HasArbitraryOverviews())
+    {
+        // FIXME: should we use the most reduced overview here or use some
+        // minimum number of samples like GDALRasterBand::ComputeStatistics()
+        // does?
+        GDALRasterBand *poBestOverview = GetRasterSampleOverview(0);
 
-    const int nBuckets = 256;
+        if (poBestOverview != this)
+        {
+            return poBestOverview->GetHistogram(
+                dfMin, dfMax, nBuckets, panHistogram, bIncludeOutOfRange,
+                bApproxOK, pfnProgress, pProgressData);
+        }
+    }
 
-    bool bSignedByte = false;
-    if (eDataType == GDT_Byte)
+    /* -------------------------------------------------------------------- */
+    /*      Read actual data and build histogram.                           */
+    /* -------------------------------------------------------------------- */
+    if (!pfnProgress(0.0, "Compute Histogram", pProgressData))
     {
-        EnablePixelTypeSignedByteWarning(false);
-        const char *pszPixelType =
-            GetMetadataItem("PIXELTYPE", "IMAGE_STRUCTURE");
-        EnablePixelTypeSignedByteWarning(true);
-        bSignedByte =
-            pszPixelType != nullptr && EQUAL(pszPixelType, "SIGNEDBYTE");
+        ReportError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+        return CE_Failure;
     }
 
-    if (GetRasterDataType() == GDT_Byte && !bSignedByte)
+    // Written this way to deal with NaN
+    if (!(dfMax > dfMin))
     {
-        *pdfMin = -0.5;
-        *pdfMax = 255.5;
+        ReportError(CE_Failure, CPLE_IllegalArg,
+                    "dfMax should be strictly greater than dfMin");
+        return CE_Failure;
     }
-    else
-    {
-
-        const CPLErr eErr =
-            GetStatistics(TRUE, TRUE, pdfMin, pdfMax, nullptr, nullptr);
-        const double dfHalfBucket = (*pdfMax - *pdfMin) / (2 * (nBuckets - 1));
-        *pdfMin -= dfHalfBucket;
-        *pdfMax += dfHalfBucket;
 
-        if (eErr != CE_None)
-            return eErr;
-    }
+    GDALRasterIOExtraArg sExtraArg;
+    INIT_RASTERIO_EXTRA_ARG(sExtraArg);
 
-    *ppanHistogram =
-        static_cast<GUIntBig *>(VSICalloc(sizeof(GUIntBig), nBuckets));
-    if (*ppanHistogram == nullptr)
+    const double dfScale = nBuckets / (dfMax - dfMin);
+    if (dfScale == 0 || !std::isfinite(dfScale))
     {
-        ReportError(CE_Failure, CPLE_OutOfMemory,
-                    "Out of memory in InitBlockInfo().");
+        ReportError(CE_Failure, CPLE_IllegalArg,
+                    "dfMin and dfMax should be finite values such that "
+                    "nBuckets / (dfMax - dfMin) is non-zero");
         return CE_Failure;
     }
+    memset(panHistogram, 0, sizeof(GUIntBig) * nBuckets);
 
-    *pnBuckets = nBuckets;
-    CPLErr eErr = GetHistogram(*pdfMin, *pdfMax, *pnBuckets, *ppanHistogram,
-                               TRUE, FALSE, pfnProgress, pProgressData);
-    if (eErr != CE_None)
+    GDALNoDataValues sNoDataValues(this, eDataType);
+    GDALRasterBand *poMaskBand = nullptr;
+    if (!sNoDataValues.bGotNoDataValue)
     {
-        *pnBuckets = 0;
+        const int l_nMaskFlags = GetMaskFlags();
+        if (l_nMaskFlags != GMF_ALL_VALID && l_nMaskFlags != GMF_NODATA &&
+            GetColorInterpretation() != GCI_AlphaBand)
+        {
+            poMaskBand = GetMaskBand();
+        }
     }
-    return eErr;
-}
 
-/************************************************************************/
-/*                      GDALGetDefaultHistogram()                       */
-/************************************************************************/
+    bool bSignedByte = false;
+    if (eDataType == GDT_Byte)
+    {
+        EnablePixelTypeSignedByteWarning(false);
+        const char *pszPixelType =
+            GetMetadataItem("PIXELTYPE", "IMAGE_STRUCTURE");
+        EnablePixelTypeSignedByteWarning(true);
+        bSignedByte =
+            pszPixelType != nullptr && EQUAL(pszPixelType, "SIGNEDBYTE");
+    }
+
+    if (bApproxOK && HasArbitraryOverviews())
+    {
+        /* --------------------------------------------------------------------
+         */
+        /*      Figure out how much the image should be reduced to get an */
+        /*      approximate value. */
+        /* --------------------------------------------------------------------
+         */
+        const double dfReduction =
+            sqrt(static_cast<double>(nRasterXSize) * nRasterYSize /
+                 GDALSTAT_APPROX_NUMSAMPLES);
+
+        int nXReduced = nRasterXSize;
+        int nYReduced = nRasterYSize;
+        if (dfReduction > 1.0)
+        {
+            nXReduced = static_cast<int>(nRasterXSize / dfReduction);
+            nYReduced = static_cast<int>(nRasterYSize / dfReduction);
+
+            // Catch the case of huge resizing ratios here
+            if (nXReduced == 0)
+                nXReduced = 1;
+            if (nYReduced == 0)
+                nYReduced = 1;
+        }
+
+        void *pData = VSI_MALLOC3_VERBOSE(GDALGetDataTypeSizeBytes(eDataType),
+                                          nXReduced, nYReduced);
+        if (!pData)
+            return CE_Failure;
+
+        const CPLErr eErr =
+            IRasterIO(GF_Read, 0, 0, nRasterXSize, nRasterYSize, pData,
+                      nXReduced, nYReduced, eDataType, 0, 0, &sExtraArg);
+        if (eErr != CE_None)
+        {
+            CPLFree(pData);
+            return eErr;
+        }
+
+        GByte *pabyMaskData = nullptr;
+        if (poMaskBand)
+        {
+            pabyMaskData =
+                static_cast<GByte *>(VSI_MALLOC2_VERBOSE(nXReduced, nYReduced));
+            if (!pabyMaskData)
+            {
+                CPLFree(pData);
+                return CE_Failure;
+            }
+
+            if (poMaskBand->RasterIO(GF_Read, 0, 0, nRasterXSize, nRasterYSize,
+                                     pabyMaskData, nXReduced, nYReduced,
+                                     GDT_Byte, 0, 0, nullptr) != CE_None)
+            {
+                CPLFree(pData);
+                CPLFree(pabyMaskData);
+                return CE_Failure;
+            }
+        }
+
+        ComputeHistogramForBlock(eDataType, bSignedByte, sNoDataValues, dfMin,
+                                 dfScale, nBuckets,
+                                 CPL_TO_BOOL(bIncludeOutOfRange), pData,
+                                 pabyMaskData, nXReduced, nYReduced, nXReduced,
+                                 nYReduced, panHistogram);
+
+        CPLFree(pData);
+        CPLFree(pabyMaskData);
+    }
+    else  // No arbitrary overviews.
+    {
+        if (!InitBlockInfo())
+            return CE_Failure;
+
+        /* --------------------------------------------------------------------
+         */
+        /*      Figure out the ratio of blocks we will read to get an */
+        /*      approximate value. */
+        /* --------------------------------------------------------------------
+         */
+
+        int nSampleRate = 1;
+        if (bApproxOK)
+        {
+            nSampleRate = static_cast<int>(std::max(
+                1.0,
+                sqrt(static_cast<double>(nBlocksPerRow) * nBlocksPerColumn)));
+            // We want to avoid probing only the first column of blocks for
+            // a square shaped raster, because it is not unlikely that it may
+            // be padding only (#6378).
+            if (nSampleRate == nBlocksPerRow && nBlocksPerRow > 1)
+                nSampleRate += 1;
+        }
+
+        /* --------------------------------------------------------------------
+         */
+        /*      Read the blocks, and add to histogram. */
+        /* --------------------------------------------------------------------
+         */
+        const auto processBlock =
+            [this, dfMin, dfScale, nBuckets, bIncludeOutOfRange, bSignedByte,
+             &sNoDataValues](const void *pData, const GByte *pabyMaskData,
+                             int nXCheck, int nYCheck, int nLineStride,
+                             GDALHistogramAccumulator &oAcc)
+        {
+            ComputeHistogramForBlock(
+                eDataType, bSignedByte, sNoDataValues, dfMin, dfScale, nBuckets,
+                CPL_TO_BOOL(bIncludeOutOfRange), pData, pabyMaskData, nXCheck,
+                nYCheck, nLineStride, nBlockYSize, oAcc.anHistogram.data());
+        };
+
+        const double dfTotalBlocks =
+            static_cast<double>(nBlocksPerRow) * nBlocksPerColumn;
+        const auto progress = [pfnProgress, pProgressData, nSampleRate,
+                               dfTotalBlocks](GIntBig iSampleBlock)
+        {
+            const double dfComplete =
+                static_cast<double>(iSampleBlock + nSampleRate) / dfTotalBlocks;
+            return pfnProgress(std::min(1.0, dfComplete), "Compute Histogram",
+                               pProgressData) != FALSE;
+        };
+
+        GDALHistogramAccumulator oAcc(nBuckets);
+        // Histogram computed by GDALDataset::GetHistogram() together with
+        // the ones of other bands.
+        bool bPassError = false;
+        if (TakeMultiBandPassHistogram(
+                this, dfMin, dfMax, nBuckets, CPL_TO_BOOL(bIncludeOutOfRange),
+                nSampleRate, oAcc.anHistogram.data(), bPassError))
+        {
+            if (bPassError)
+                return CE_Failure;
+        }
+        else
+        {
+            bool bInterrupted = false;
+            const CPLErr eErr = ProcessSampledBlocks(
+                this, nSampleRate, poMaskBand, /* bOrderedMerge = */ false,
+                oAcc, processBlock, progress,
+                /* canStop = */ nullptr, &bInterrupted);
+            if (eErr != CE_None)
+                return CE_Failure;
+        }
+        memcpy(panHistogram, oAcc.anHistogram.data(),
+               sizeof(GUIntBig) * nBuckets);
+    }
+
+    pfnProgress(1.0, "Compute Histogram", pProgressData);
+
+    return CE_None;
+}
+
+/************************************************************************/
+/*                       GDALGetRasterHistogram()                       */
+/************************************************************************/
 
 /**
- * \brief Fetch default raster histogram.
+ * \brief Compute raster histogram.
  *
  * Use GDALGetRasterHistogramEx() instead to get correct counts for values
  * exceeding 2 billion.
  *
- * @see GDALRasterBand::GDALGetDefaultHistogram()
+ * @see GDALRasterBand::GetHistogram()
  * @see GDALGetRasterHistogramEx()
  */
 
-CPLErr CPL_STDCALL GDALGetDefaultHistogram(GDALRasterBandH hBand,
-                                           double *pdfMin, double *pdfMax,
-                                           int *pnBuckets, int **ppanHistogram,
-                                           int bForce,
-                                           GDALProgressFunc pfnProgress,
-                                           void *pProgressData)
+CPLErr CPL_STDCALL GDALGetRasterHistogram(GDALRasterBandH hBand, double dfMin,
+                                          double dfMax, int nBuckets,
+                                          int *panHistogram,
+                                          int bIncludeOutOfRange, int bApproxOK,
+                                          GDALProgressFunc pfnProgress,
+                                          void *pProgressData)
 
 {
-    VALIDATE_POINTER1(hBand, "GDALGetDefaultHistogram", CE_Failure);
-    VALIDATE_POINTER1(pdfMin, "GDALGetDefaultHistogram", CE_Failure);
-    VALIDATE_POINTER1(pdfMax, "GDALGetDefaultHistogram", CE_Failure);
-    VALIDATE_POINTER1(pnBuckets, "GDALGetDefaultHistogram", CE_Failure);
-    VALIDATE_POINTER1(ppanHistogram, "GDALGetDefaultHistogram", CE_Failure);
+    VALIDATE_POINTER1(hBand, "GDALGetRasterHistogram", CE_Failure);
+    VALIDATE_POINTER1(panHistogram, "GDALGetRasterHistogram", CE_Failure);
 
-    GDALRasterBand *const poBand = GDALRasterBand::FromHandle(hBand);
-    GUIntBig *panHistogramTemp = nullptr;
-    CPLErr eErr = poBand->GetDefaultHistogram(pdfMin, pdfMax, pnBuckets,
-                                              &panHistogramTemp, bForce,
-                                              pfnProgress, pProgressData);
-    if (eErr == CE_None)
+    GDALRasterBand *poBand = GDALRasterBand::FromHandle(hBand);
+
+    GUIntBig *panHistogramTemp =
+        static_cast<GUIntBig *>(VSIMalloc2(sizeof(GUIntBig), nBuckets));
+    if (panHistogramTemp == nullptr)
     {
-        const int nBuckets = *pnBuckets;
-        *ppanHistogram = static_cast<int *>(VSIMalloc2(sizeof(int), nBuckets));
-        if (*ppanHistogram == nullptr)
-        {
-            poBand->ReportError(CE_Failure, CPLE_OutOfMemory,
-                                "Out of memory in GDALGetDefaultHistogram().");
-            VSIFree(panHistogramTemp);
-            return CE_Failure;
-        }
+        poBand->ReportError(CE_Failure, CPLE_OutOfMemory,
+                            "Out of memory in GDALGetRasterHistogram().");
+        return CE_Failure;
+    }
 
-        for (int i = 0; i < nBuckets; ++i)
+    CPLErr eErr = poBand->GetHistogram(dfMin, dfMax, nBuckets, panHistogramTemp,
+                                       bIncludeOutOfRange, bApproxOK,
+                                       pfnProgress, pProgressData);
+
+    if (eErr == CE_None)
+    {
+        for (int i = 0; i < nBuckets; i++)
         {
             if (panHistogramTemp[i] > INT_MAX)
             {
@@ -4962,90 +5034,285 @@ CPLErr CPL_STDCALL GDALGetDefaultHistogram(GDALRasterBandH hBand,
                          "Count for bucket %d, which is " CPL_FRMT_GUIB
                          " exceeds maximum 32 bit value",
                          i, panHistogramTemp[i]);
-                (*ppanHistogram)[i] = INT_MAX;
+                panHistogram[i] = INT_MAX;
             }
             else
             {
-                (*ppanHistogram)[i] = static_cast<int>(panHistogramTemp[i]);
+                panHistogram[i] = static_cast<int>(panHistogramTemp[i]);
             }
         }
-
-        CPLFree(panHistogramTemp);
-    }
-    else
-    {
-        *ppanHistogram = nullptr;
     }
 
+    CPLFree(panHistogramTemp);
+
     return eErr;
 }
 
 /************************************************************************/
-/*                      GDALGetDefaultHistogramEx()                     */
+/*                      GDALGetRasterHistogramEx()                      */
 /************************************************************************/
 
 /**
- * \brief Fetch default raster histogram.
+ * \brief Compute raster histogram.
  *
- * @see GDALRasterBand::GetDefaultHistogram()
+ * @see GDALRasterBand::GetHistogram()
  *
  * @since GDAL 2.0
  */
 
-CPLErr CPL_STDCALL
-GDALGetDefaultHistogramEx(GDALRasterBandH hBand, double *pdfMin, double *pdfMax,
-                          int *pnBuckets, GUIntBig **ppanHistogram, int bForce,
-                          GDALProgressFunc pfnProgress, void *pProgressData)
+CPLErr CPL_STDCALL GDALGetRasterHistogramEx(
+    GDALRasterBandH hBand, double dfMin, double dfMax, int nBuckets,
+    GUIntBig *panHistogram, int bIncludeOutOfRange, int bApproxOK,
+    GDALProgressFunc pfnProgress, void *pProgressData)
 
 {
-    VALIDATE_POINTER1(hBand, "GDALGetDefaultHistogram", CE_Failure);
-    VALIDATE_POINTER1(pdfMin, "GDALGetDefaultHistogram", CE_Failure);
-    VALIDATE_POINTER1(pdfMax, "GDALGetDefaultHistogram", CE_Failure);
-    VALIDATE_POINTER1(pnBuckets, "GDALGetDefaultHistogram", CE_Failure);
-    VALIDATE_POINTER1(ppanHistogram, "GDALGetDefaultHistogram", CE_Failure);
+    VALIDATE_POINTER1(hBand, "GDALGetRasterHistogramEx", CE_Failure);
+    VALIDATE_POINTER1(panHistogram, "GDALGetRasterHistogramEx", CE_Failure);
 
     GDALRasterBand *poBand = GDALRasterBand::FromHandle(hBand);
-    return poBand->GetDefaultHistogram(pdfMin, pdfMax, pnBuckets, ppanHistogram,
-                                       bForce, pfnProgress, pProgressData);
+
+    return poBand->GetHistogram(dfMin, dfMax, nBuckets, panHistogram,
+                                bIncludeOutOfRange, bApproxOK, pfnProgress,
+                                pProgressData);
 }
 
 /************************************************************************/
-/*                             AdviseRead()                             */
+/*                        GetDefaultHistogram()                         */
 /************************************************************************/
 
 /**
- * \fn GDALRasterBand::AdviseRead(int,int,int,int,int,int,GDALDataType,char**)
- * \brief Advise driver of upcoming read requests.
- *
- * Some GDAL drivers operate more efficiently if they know in advance what
- * set of upcoming read requests will be made.  The AdviseRead() method allows
- * an application to notify the driver of the region of interest,
- * and at what resolution the region will be read.
- *
- * Many drivers just ignore the AdviseRead() call, but it can dramatically
- * accelerate access via some drivers.
- *
- * Depending on call paths, drivers might receive several calls to
- * AdviseRead() with the same parameters.
- *
- * @param nXOff The pixel offset to the top left corner of the region
- * of the band to be accessed.  This would be zero to start from the left side.
- *
- * @param nYOff The line offset to the top left corner of the region
- * of the band to be accessed.  This would be zero to start from the top.
- *
- * @param nXSize The width of the region of the band to be accessed in pixels.
+ * \brief Fetch default raster histogram.
  *
- * @param nYSize The height of the region of the band to be accessed in lines.
+ * The default method in GDALRasterBand will compute a default histogram. This
+ * method is overridden by derived classes (such as GDALPamRasterBand,
+ * VRTDataset, HFADataset...) that may be able to fetch efficiently an already
+ * stored histogram.
  *
- * @param nBufXSize the width of the buffer image into which the desired region
- * is to be read, or from which it is to be written.
+ * This method is the same as the C functions GDALGetDefaultHistogram() and
+ * GDALGetDefaultHistogramEx().
  *
- * @param nBufYSize the height of the buffer image into which the desired
- * region is to be read, or from which it is to be written.
+ * @param pdfMin pointer to double value that will contain the lower bound of
+ * the histogram.
+ * @param pdfMax pointer to double value that will contain the upper bound of
+ * the histogram.
+ * @param pnBuckets pointer to int value that will contain the number of buckets
+ * in *ppanHistogram.
+ * @param ppanHistogram pointer to array into which the histogram totals are
+ * placed. To be freed with VSIFree
+ * @param bForce TRUE to force the computation. If FALSE and no default
+ * histogram is available, the method will return CE_Warning
+ * @param pfnProgress function to report progress to completion.
+ * @param pProgressData application data to pass to pfnProgress.
  *
- * @param eBufType the type of the pixel values in the pData data buffer.  The
- * pixel values will automatically be translated to/from the GDALRasterBand
+ * @return CE_None on success, CE_Failure if something goes wrong, or
+ * CE_Warning if no default histogram is available.
+ */
+
+CPLErr GDALRasterBand::GetDefaultHistogram(double *pdfMin, double *pdfMax,
+                                           int *pnBuckets,
+                                           GUIntBig **ppanHistogram, int bForce,
+                                           GDALProgressFunc pfnProgress,
+                                           void *pProgressData)
+
+{
+    CPLAssert(nullptr != pnBuckets);
+    CPLAssert(nullptr != ppanHistogram);
+    CPLAssert(nullptr != pdfMin);
+    CPLAssert(nullptr != pdfMax);
+
+    *pnBuckets = 0;
+    *ppanHistogram = nullptr;
+
+    if (!bForce)
+        return CE_Warning;
+
+    const int nBuckets = 256;
+
+    bool bSignedByte = false;
+    if (eDataType == GDT_Byte)
+    {
+        EnablePixelTypeSignedByteWarning(false);
+        const char *pszPixelType =
+            GetMetadataItem("PIXELTYPE", "IMAGE_STRUCTURE");
+        EnablePixelTypeSignedByteWarning(true);
+        bSignedByte =
+            pszPixelType != nullptr && EQUAL(pszPixelType, "SIGNEDBYTE");
+    }
+
+    if (GetRasterDataType() == GDT_Byte && !bSignedByte)
+    {
+        *pdfMin = -0.5;
+        *pdfMax = 255.5;
+    }
+    else
+    {
+
+        const CPLErr eErr =
+            GetStatistics(TRUE, TRUE, pdfMin, pdfMax, nullptr, nullptr);
+        const double dfHalfBucket = (*pdfMax - *pdfMin) / (2 * (nBuckets - 1));
+        *pdfMin -= dfHalfBucket;
+        *pdfMax += dfHalfBucket;
+
+        if (eErr != CE_None)
+            return eErr;
+    }
+
+    *ppanHistogram =
+        static_cast<GUIntBig *>(VSICalloc(sizeof(GUIntBig), nBuckets));
+    if (*ppanHistogram == nullptr)
+    {
+        ReportError(CE_Failure, CPLE_OutOfMemory,
+                    "Out of memory in InitBlockInfo().");
+        return CE_Failure;
+    }
+
+    *pnBuckets = nBuckets;
+    CPLErr eErr = GetHistogram(*pdfMin, *pdfMax, *pnBuckets, *ppanHistogram,
+                               TRUE, FALSE, pfnProgress, pProgressData);
+    if (eErr != CE_None)
+    {
+        *pnBuckets = 0;
+    }
+    return eErr;
+}
+
+/************************************************************************/
+/*                      GDALGetDefaultHistogram()                       */
+/************************************************************************/
+
+/**
+ * \brief Fetch default raster histogram.
+ *
+ * Use GDALGetRasterHistogramEx() instead to get correct counts for values
+ * exceeding 2 billion.
+ *
+ * @see GDALRasterBand::GDALGetDefaultHistogram()
+ * @see GDALGetRasterHistogramEx()
+ */
+
+CPLErr CPL_STDCALL GDALGetDefaultHistogram(GDALRasterBandH hBand,
+                                           double *pdfMin, double *pdfMax,
+                                           int *pnBuckets, int **ppanHistogram,
+                                           int bForce,
+                                           GDALProgressFunc pfnProgress,
+                                           void *pProgressData)
+
+{
+    VALIDATE_POINTER1(hBand, "GDALGetDefaultHistogram", CE_Failure);
+    VALIDATE_POINTER1(pdfMin, "GDALGetDefaultHistogram", CE_Failure);
+    VALIDATE_POINTER1(pdfMax, "GDALGetDefaultHistogram", CE_Failure);
+    VALIDATE_POINTER1(pnBuckets, "GDALGetDefaultHistogram", CE_Failure);
+    VALIDATE_POINTER1(ppanHistogram, "GDALGetDefaultHistogram", CE_Failure);
+
+    GDALRasterBand *const poBand = GDALRasterBand::FromHandle(hBand);
+    GUIntBig *panHistogramTemp = nullptr;
+    CPLErr eErr = poBand->GetDefaultHistogram(pdfMin, pdfMax, pnBuckets,
+                                              &panHistogramTemp, bForce,
+                                              pfnProgress, pProgressData);
+    if (eErr == CE_None)
+    {
+        const int nBuckets = *pnBuckets;
+        *ppanHistogram = static_cast<int *>(VSIMalloc2(sizeof(int), nBuckets));
+        if (*ppanHistogram == nullptr)
+        {
+            poBand->ReportError(CE_Failure, CPLE_OutOfMemory,
+                                "Out of memory in GDALGetDefaultHistogram().");
+            VSIFree(panHistogramTemp);
+            return CE_Failure;
+        }
+
+        for (int i = 0; i < nBuckets; ++i)
+        {
+            if (panHistogramTemp[i] > INT_MAX)
+            {
+                CPLError(CE_Warning, CPLE_AppDefined,
+                         "Count for bucket %d, which is " CPL_FRMT_GUIB
+                         " exceeds maximum 32 bit value",
+                         i, panHistogramTemp[i]);
+                (*ppanHistogram)[i] = INT_MAX;
+            }
+            else
+            {
+                (*ppanHistogram)[i] = static_cast<int>(panHistogramTemp[i]);
+            }
+        }
+
+        CPLFree(panHistogramTemp);
+    }
+    else
+    {
+        *ppanHistogram = nullptr;
+    }
+
+    return eErr;
+}
+
+/************************************************************************/
+/*                      GDALGetDefaultHistogramEx()                     */
+/************************************************************************/
+
+/**
+ * \brief Fetch default raster histogram.
+ *
+ * @see GDALRasterBand::GetDefaultHistogram()
+ *
+ * @since GDAL 2.0
+ */
+
+CPLErr CPL_STDCALL
+GDALGetDefaultHistogramEx(GDALRasterBandH hBand, double *pdfMin, double *pdfMax,
+                          int *pnBuckets, GUIntBig **ppanHistogram, int bForce,
+                          GDALProgressFunc pfnProgress, void *pProgressData)
+
+{
+    VALIDATE_POINTER1(hBand, "GDALGetDefaultHistogram", CE_Failure);
+    VALIDATE_POINTER1(pdfMin, "GDALGetDefaultHistogram", CE_Failure);
+    VALIDATE_POINTER1(pdfMax, "GDALGetDefaultHistogram", CE_Failure);
+    VALIDATE_POINTER1(pnBuckets, "GDALGetDefaultHistogram", CE_Failure);
+    VALIDATE_POINTER1(ppanHistogram, "GDALGetDefaultHistogram", CE_Failure);
+
+    GDALRasterBand *poBand = GDALRasterBand::FromHandle(hBand);
+    return poBand->GetDefaultHistogram(pdfMin, pdfMax, pnBuckets, ppanHistogram,
+                                       bForce, pfnProgress, pProgressData);
+}
+
+/************************************************************************/
+/*                             AdviseRead()                             */
+/************************************************************************/
+
+/**
+ * \fn GDALRasterBand::AdviseRead(int,int,int,int,int,int,GDALDataType,char**)
+ * \brief Advise driver of upcoming read requests.
+ *
+ * Some GDAL drivers operate more efficiently if they know in advance what
+ * set of upcoming read requests will be made.  The AdviseRead() method allows
+ * an application to notify the driver of the region of interest,
+ * and at what resolution the region will be read.
+ *
+ * Many drivers just ignore the AdviseRead() call, but it can dramatically
+ * accelerate access via some drivers.
+ *
+ * Depending on call paths, drivers might receive several calls to
+ * AdviseRead() with the same parameters.
+ *
+ * @param nXOff The pixel offset to the top left corner of the region
+ * of the band to be accessed.  This would be zero to start from the left side.
+ *
+ * @param nYOff The line offset to the top left corner of the region
+ * of the band to be accessed.  This would be zero to start from the top.
+ *
+ * @param nXSize The width of the region of the band to be accessed in pixels.
+ *
+ * @param nYSize The height of the region of the band to be accessed in lines.
+ *
+ * @param nBufXSize the width of the buffer image into which the desired region
+ * is to be read, or from which it is to be written.
+ *
+ * @param nBufYSize the height of the buffer image into which the desired
+ * region is to be read, or from which it is to be written.
+ *
+ * @param eBufType the type of the pixel values in the pData data buffer.  The
+ * pixel values will automatically be translated to/from the GDALRasterBand
  * data type as needed.
  *
  * @param papszOptions a list of name=value strings with special control
@@ -6225,799 +6492,2147 @@ struct ComputeStatisticsInternal<GUInt16, COMPUTE_OTHER_STATS>
                 nSumSquare += anSumSquare[0] + anSumSquare[1] + anSumSquare[2] +
                               anSumSquare[3];
 
-                // Unshift the sum of squares
-                UnshiftSumSquare(nSumSquare, nSumThis,
-                                 static_cast<GUIntBig>(i));
+                // Unshift the sum of squares
+                UnshiftSumSquare(nSumSquare, nSumThis,
+                                 static_cast<GUIntBig>(i));
+
+                nSum += nSumThis;
+
+                for (; i < nBlockPixels; i++)
+                {
+                    const GUInt32 nValue = pData[i];
+                    if (nValue < nMin)
+                        nMin = nValue;
+                    if (nValue > nMax)
+                        nMax = nValue;
+                    nSum += nValue;
+                    nSumSquare +=
+                        static_cast_for_coverity_scan<GUIntBig>(nValue) *
+                        nValue;
+                }
+
+                nSampleCount += static_cast<GUIntBig>(nXCheck) * nYCheck;
+                nValidCount += static_cast<GUIntBig>(nXCheck) * nYCheck;
+            }
+        }
+        else
+        {
+            ComputeStatisticsInternalGeneric<GUInt16, COMPUTE_OTHER_STATS>::f(
+                nXCheck, nBlockXSize, nYCheck, pData, bHasNoData, nNoDataValue,
+                nMin, nMax, nSum, nSumSquare, nSampleCount, nValidCount);
+        }
+    }
+};
+
+#endif
+// (defined(__x86_64__) || defined(_M_X64)) && (defined(__GNUC__) ||
+// defined(_MSC_VER))
+
+/************************************************************************/
+/*                          GetPixelValue()                             */
+/************************************************************************/
+
+static inline double GetPixelValue(GDALDataType eDataType, bool bSignedByte,
+                                   const void *pData, GPtrDiff_t iOffset,
+                                   const GDALNoDataValues &sNoDataValues,
+                                   bool &bValid)
+{
+    bValid = true;
+    double dfValue = 0;
+    switch (eDataType)
+    {
+        case GDT_Byte:
+        {
+            if (bSignedByte)
+                dfValue = static_cast<const signed char *>(pData)[iOffset];
+            else
+                dfValue = static_cast<const GByte *>(pData)[iOffset];
+            break;
+        }
+        case GDT_Int8:
+            dfValue = static_cast<const GInt8 *>(pData)[iOffset];
+            break;
+        case GDT_UInt16:
+            dfValue = static_cast<const GUInt16 *>(pData)[iOffset];
+            break;
+        case GDT_Int16:
+            dfValue = static_cast<const GInt16 *>(pData)[iOffset];
+            break;
+        case GDT_UInt32:
+            dfValue = static_cast<const GUInt32 *>(pData)[iOffset];
+            break;
+        case GDT_Int32:
+            dfValue = static_cast<const GInt32 *>(pData)[iOffset];
+            break;
+        case GDT_UInt64:
+            dfValue = static_cast<double>(
+                static_cast<const std::uint64_t *>(pData)[iOffset]);
+            break;
+        case GDT_Int64:
+            dfValue = static_cast<double>(
+                static_cast<const std::int64_t *>(pData)[iOffset]);
+            break;
+        case GDT_Float16:
+        {
+            using namespace std;
+            const GFloat16 hfValue =
+                static_cast<const GFloat16 *>(pData)[iOffset];
+            if (isnan(hfValue) ||
+                (sNoDataValues.bGotFloat16NoDataValue &&
+                 ARE_REAL_EQUAL(hfValue, sNoDataValues.hfNoDataValue)))
+            {
+                bValid = false;
+                return 0.0;
+            }
+            dfValue = hfValue;
+            return dfValue;
+        }
+        case GDT_Float32:
+        {
+            const float fValue = static_cast<const float *>(pData)[iOffset];
+            if (std::isnan(fValue) ||
+                (sNoDataValues.bGotFloatNoDataValue &&
+                 ARE_REAL_EQUAL(fValue, sNoDataValues.fNoDataValue)))
+            {
+                bValid = false;
+                return 0.0;
+            }
+            dfValue = fValue;
+            return dfValue;
+        }
+        case GDT_Float64:
+            dfValue = static_cast<const double *>(pData)[iOffset];
+            if (std::isnan(dfValue))
+            {
+                bValid = false;
+                return 0.0;
+            }
+            break;
+        case GDT_CInt16:
+            dfValue = static_cast<const GInt16 *>(pData)[iOffset * 2];
+            break;
+        case GDT_CInt32:
+            dfValue = static_cast<const GInt32 *>(pData)[iOffset * 2];
+            break;
+        case GDT_CFloat16:
+            dfValue = static_cast<const GFloat16 *>(pData)[iOffset * 2];
+            if (std::isnan(dfValue))
+            {
+                bValid = false;
+                return 0.0;
+            }
+            break;
+        case GDT_CFloat32:
+            dfValue = static_cast<const float *>(pData)[iOffset * 2];
+            if (std::isnan(dfValue))
+            {
+                bValid = false;
+                return 0.0;
+            }
+            break;
+        case GDT_CFloat64:
+            dfValue = static_cast<const double *>(pData)[iOffset * 2];
+            if (std::isnan(dfValue))
+            {
+                bValid = false;
+                return 0.0;
+            }
+            break;
+        case GDT_Unknown:
+        case GDT_TypeCount:
+            CPLAssert(false);
+            break;
+    }
+
+    if (sNoDataValues.bGotNoDataValue &&
+        ARE_REAL_EQUAL(dfValue, sNoDataValues.dfNoDataValue))
+    {
+        bValid = false;
+        return 0.0;
+    }
+    return dfValue;
+}
+
+/************************************************************************/
+/*                         SetValidPercent()                            */
+/************************************************************************/
+
+//! @cond Doxygen_Suppress
+/**
+ * \brief Set percentage of valid (not nodata) pixels.
+ *
+ * Stores the percentage of valid pixels in the metadata item
+ * STATISTICS_VALID_PERCENT
+ *
+ * @param nSampleCount Number of sampled pixels.
+ *
+ * @param nValidCount Number of valid pixels.
+ */
+
+void GDALRasterBand::SetValidPercent(GUIntBig nSampleCount,
+                                     GUIntBig nValidCount)
+{
+    if (nValidCount == 0)
+    {
+        SetMetadataItem("STATISTICS_VALID_PERCENT", "0");
+    }
+    else if (nValidCount == nSampleCount)
+    {
+        SetMetadataItem("STATISTICS_VALID_PERCENT", "100");
+    }
+    else /* nValidCount < nSampleCount */
+    {
+        char szValue[128] = {0};
+
+        /* percentage is only an indicator: limit precision */
+        CPLsnprintf(szValue, sizeof(szValue), "%.4g",
+                    100. * static_cast<double>(nValidCount) / nSampleCount);
+
+        if (EQUAL(szValue, "100"))
+        {
+            /* don't set 100 percent valid
+             * because some of the sampled pixels were nodata */
+            SetMetadataItem("STATISTICS_VALID_PERCENT", "99.999");
+        }
+        else
+        {
+            SetMetadataItem("STATISTICS_VALID_PERCENT", szValue);
+        }
+    }
+}
+
+//! @endcond
+
+/************************************************************************/
+/*                     GDALIntegralStatsAccumulator                     */
+/************************************************************************/
+
+namespace
+{
+struct GDALIntegralStatsAccumulator
+{
+    GUInt32 nMin;
+    GUInt32 nMax = 0;
+    GUIntBig nSum = 0;
+    GUIntBig nSumSquare = 0;
+    GUIntBig nSampleCount = 0;
+    GUIntBig nValidCount = 0;
+
+    explicit GDALIntegralStatsAccumulator(GUInt32 nMaxValueType)
+        : nMin(nMaxValueType)
+    {
+    }
+
+    void Merge(const GDALIntegralStatsAccumulator &other)
+    {
+        nMin = std::min(nMin, other.nMin);
+        nMax = std::max(nMax, other.nMax);
+        nSum += other.nSum;
+        nSumSquare += other.nSumSquare;
+        nSampleCount += other.nSampleCount;
+        nValidCount += other.nValidCount;
+    }
+};
+
+/************************************************************************/
+/*                        GDALWelfordAccumulator                        */
+/************************************************************************/
+
+// Using Welford algorithm:
+// http://en.wikipedia.org/wiki/Algorithms_for_calculating_variance
+// to compute standard deviation in a more numerically robust way than
+// the difference of the sum of square values with the square of the sum.
+// dfMean and dfM2 are updated at each sample.
+// dfM2 is the sum of square of differences to the current mean.
+// Partial results are combined with the parallel algorithm of Chan et al.
+struct GDALWelfordAccumulator
+{
+    double dfMin = std::numeric_limits<double>::infinity();
+    double dfMax = -std::numeric_limits<double>::infinity();
+    double dfMean = 0.0;
+    double dfM2 = 0.0;
+    GUIntBig nSampleCount = 0;
+    GUIntBig nValidCount = 0;
+
+    inline void Add(double dfValue)
+    {
+        dfMin = std::min(dfMin, dfValue);
+        dfMax = std::max(dfMax, dfValue);
+
+        nValidCount++;
+        if (dfMin == dfMax)
+        {
+            if (nValidCount == 1)
+                dfMean = dfMin;
+        }
+        else
+        {
+            const double dfDelta = dfValue - dfMean;
+            dfMean += dfDelta / static_cast<double>(nValidCount);
+            dfM2 += dfDelta * (dfValue - dfMean);
+        }
+    }
+
+    void Merge(const GDALWelfordAccumulator &other)
+    {
+        nSampleCount += other.nSampleCount;
+        if (other.nValidCount == 0)
+            return;
+        dfMin = std::min(dfMin, other.dfMin);
+        dfMax = std::max(dfMax, other.dfMax);
+        if (nValidCount == 0)
+        {
+            dfMean = other.dfMean;
+            dfM2 = other.dfM2;
+            nValidCount = other.nValidCount;
+            return;
+        }
+        const double dfN1 = static_cast<double>(nValidCount);
+        const double dfN2 = static_cast<double>(other.nValidCount);
+        const double dfN = dfN1 + dfN2;
+        const double dfDelta = other.dfMean - dfMean;
+        dfMean += dfDelta * (dfN2 / dfN);
+        dfM2 += other.dfM2 + dfDelta * dfDelta * (dfN1 * dfN2 / dfN);
+        nValidCount += other.nValidCount;
+    }
+};
+}  // namespace
+
+/************************************************************************/
+/*                  ComputeStatisticsGenericForBlock()                  */
+/************************************************************************/
+
+static void ComputeStatisticsGenericForBlock(
+    GDALDataType eDataType, bool bSignedByte,
+    const GDALNoDataValues &sNoDataValues, const void *pData,
+    const GByte *pabyMaskData, int nXCheck, int nYCheck, int nBlockXSize,
+    GDALWelfordAccumulator &oAcc)
+{
+    // This isn't the fastest way to do this, but is easier for now.
+    for (int iY = 0; iY < nYCheck; iY++)
+    {
+        for (int iX = 0; iX < nXCheck; iX++)
+        {
+            const GPtrDiff_t iOffset =
+                iX + static_cast<GPtrDiff_t>(iY) * nBlockXSize;
+            if (pabyMaskData && pabyMaskData[iOffset] == 0)
+                continue;
+
+            bool bValid = true;
+            double dfValue = GetPixelValue(eDataType, bSignedByte, pData,
+                                           iOffset, sNoDataValues, bValid);
+
+            if (!bValid)
+                continue;
+
+            oAcc.Add(dfValue);
+        }
+    }
+
+    oAcc.nSampleCount += static_cast<GUIntBig>(nXCheck) * nYCheck;
+}
+
+static bool TakeMultiBandPassStatistics(GDALRasterBand *poBand,
+                                        int nSampleRate,
+                                        GDALIntegralStatsAccumulator *poIntAcc,
+                                        GDALWelfordAccumulator *poAcc,
+                                        bool &bError);
+
+/************************************************************************/
+/*                         ComputeStatistics()                          */
+/************************************************************************/
+
+/**
+ * \brief Compute image statistics.
+ *
+ * Returns the minimum, maximum, mean and standard deviation of all
+ * pixel values in this band.  If approximate statistics are sufficient,
+ * the bApproxOK flag can be set to true in which case overviews, or a
+ * subset of image tiles may be used in computing the statistics.
+ *
+ * Once computed, the statistics will generally be "set" back on the
+ * raster band using SetStatistics().
+ *
+ * Cached statistics can be cleared with GDALDataset::ClearStatistics().
+ *
+ * Starting with GDAL 3.12, the GDAL_NUM_THREADS configuration option can be
+ * set to an integer or ALL_CPUS to process the content of blocks in several
+ * threads, while they are read by the calling thread. Partial results are
+ * merged in block order, so that the result does not depend on the number
+ * of threads.
+ *
+ * This method is the same as the C function GDALComputeRasterStatistics().
+ *
+ * @param bApproxOK If TRUE statistics may be computed based on overviews
+ * or a subset of all tiles.
+ *
+ * @param pdfMin Location into which to load image minimum (may be NULL).
+ *
+ * @param pdfMax Location into which to load image maximum (may be NULL).-
+ *
+ * @param pdfMean Location into which to load image mean (may be NULL).
+ *
+ * @param pdfStdDev Location into which to load image standard deviation
+ * (may be NULL).
+ *
+ * @param pfnProgress a function to call to report progress, or NULL.
+ *
+ * @param pProgressData application data to pass to the progress function.
+ *
+ * @return CE_None on success, or CE_Failure if an error occurs or processing
+ * is terminated by the user.
+ */
+
+CPLErr GDALRasterBand::ComputeStatistics(int bApproxOK, double *pdfMin,
+                                         double *pdfMax, double *pdfMean,
+                                         double *pdfStdDev,
+                                         GDALProgressFunc pfnProgress,
+                                         void *pProgressData)
+
+{
+    if (pfnProgress == nullptr)
+        pfnProgress = GDALDummyProgress;
+
+    /* -------------------------------------------------------------------- */
+    /*      If we have overview bands, use them for statistics.             */
+    /* -------------------------------------------------------------------- */
+    if (bApproxOK && GetOverviewCount() > 0 && !HasArbitraryOverviews())
+    {
+        GDALRasterBand *poBand =
+            GetRasterSampleOverview(GDALSTAT_APPROX_NUMSAMPLES);
+
+        if (poBand != this)
+        {
+            CPLErr eErr = poBand->ComputeStatistics(FALSE, pdfMin, pdfMax,
+                                                    pdfMean, pdfStdDev,
+                                                    pfnProgress, pProgressData);
+            if (eErr == CE_None)
+            {
+                if (pdfMin && pdfMax && pdfMean && pdfStdDev)
+                {
+                    SetMetadataItem("STATISTICS_APPROXIMATE", "YES");
+                    SetStatistics(*pdfMin, *pdfMax, *pdfMean, *pdfStdDev);
+                }
+
+                /* transfer metadata from overview band to this */
+                const char *pszPercentValid =
+                    poBand->GetMetadataItem("STATISTICS_VALID_PERCENT");
+
+                if (pszPercentValid != nullptr)
+                {
+                    SetMetadataItem("STATISTICS_VALID_PERCENT",
+                                    pszPercentValid);
+                }
+            }
+            return eErr;
+        }
+    }
+
+    if (!pfnProgress(0.0, "Compute Statistics", pProgressData))
+    {
+        ReportError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+        return CE_Failure;
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Read actual data and compute statistics.                        */
+    /* -------------------------------------------------------------------- */
+    // Using Welford algorithm:
+    // http://en.wikipedia.org/wiki/Algorithms_for_calculating_variance
+    // to compute standard deviation in a more numerically robust way than
+    // the difference of the sum of square values with the square of the sum.
+    // dfMean and dfM2 are updated at each sample.
+    // dfM2 is the sum of square of differences to the current mean.
+    double dfMin = std::numeric_limits<double>::infinity();
+    double dfMax = -std::numeric_limits<double>::infinity();
+    double dfMean = 0.0;
+    double dfM2 = 0.0;
+
+    GDALRasterIOExtraArg sExtraArg;
+    INIT_RASTERIO_EXTRA_ARG(sExtraArg);
+
+    GDALNoDataValues sNoDataValues(this, eDataType);
+    GDALRasterBand *poMaskBand = nullptr;
+    if (!sNoDataValues.bGotNoDataValue)
+    {
+        const int l_nMaskFlags = GetMaskFlags();
+        if (l_nMaskFlags != GMF_ALL_VALID && l_nMaskFlags != GMF_NODATA &&
+            GetColorInterpretation() != GCI_AlphaBand)
+        {
+            poMaskBand = GetMaskBand();
+        }
+    }
+
+    bool bSignedByte = false;
+    if (eDataType == GDT_Byte)
+    {
+        EnablePixelTypeSignedByteWarning(false);
+        const char *pszPixelType =
+            GetMetadataItem("PIXELTYPE", "IMAGE_STRUCTURE");
+        EnablePixelTypeSignedByteWarning(true);
+        bSignedByte =
+            pszPixelType != nullptr && EQUAL(pszPixelType, "SIGNEDBYTE");
+    }
+
+    GUIntBig nSampleCount = 0;
+    GUIntBig nValidCount = 0;
+
+    if (bApproxOK && HasArbitraryOverviews())
+    {
+        /* --------------------------------------------------------------------
+         */
+        /*      Figure out how much the image should be reduced to get an */
+        /*      approximate value. */
+        /* --------------------------------------------------------------------
+         */
+        double dfReduction = sqrt(static_cast<double>(nRasterXSize) *
+                                  nRasterYSize / GDALSTAT_APPROX_NUMSAMPLES);
+
+        int nXReduced = nRasterXSize;
+        int nYReduced = nRasterYSize;
+        if (dfReduction > 1.0)
+        {
+            nXReduced = static_cast<int>(nRasterXSize / dfReduction);
+            nYReduced = static_cast<int>(nRasterYSize / dfReduction);
+
+            // Catch the case of huge resizing ratios here
+            if (nXReduced == 0)
+                nXReduced = 1;
+            if (nYReduced == 0)
+                nYReduced = 1;
+        }
+
+        void *pData = CPLMalloc(cpl::fits_on<int>(
+            GDALGetDataTypeSizeBytes(eDataType) * nXReduced * nYReduced));
+
+        const CPLErr eErr =
+            IRasterIO(GF_Read, 0, 0, nRasterXSize, nRasterYSize, pData,
+                      nXReduced, nYReduced, eDataType, 0, 0, &sExtraArg);
+        if (eErr != CE_None)
+        {
+            CPLFree(pData);
+            return eErr;
+        }
+
+        GByte *pabyMaskData = nullptr;
+        if (poMaskBand)
+        {
+            pabyMaskData =
+                static_cast<GByte *>(VSI_MALLOC2_VERBOSE(nXReduced, nYReduced));
+            if (!pabyMaskData)
+            {
+                CPLFree(pData);
+                return CE_Failure;
+            }
+
+            if (poMaskBand->RasterIO(GF_Read, 0, 0, nRasterXSize, nRasterYSize,
+                                     pabyMaskData, nXReduced, nYReduced,
+                                     GDT_Byte, 0, 0, nullptr) != CE_None)
+            {
+                CPLFree(pData);
+                CPLFree(pabyMaskData);
+                return CE_Failure;
+            }
+        }
+
+        /* this isn't the fastest way to do this, but is easier for now */
+        for (int iY = 0; iY < nYReduced; iY++)
+        {
+            for (int iX = 0; iX < nXReduced; iX++)
+            {
+                const int iOffset = iX + iY * nXReduced;
+                if (pabyMaskData && pabyMaskData[iOffset] == 0)
+                    continue;
+
+                bool bValid = true;
+                double dfValue = GetPixelValue(eDataType, bSignedByte, pData,
+                                               iOffset, sNoDataValues, bValid);
+                if (!bValid)
+                    continue;
+
+                dfMin = std::min(dfMin, dfValue);
+                dfMax = std::max(dfMax, dfValue);
+
+                nValidCount++;
+                if (dfMin == dfMax)
+                {
+                    if (nValidCount == 1)
+                        dfMean = dfMin;
+                }
+                else
+                {
+                    const double dfDelta = dfValue - dfMean;
+                    dfMean += dfDelta / nValidCount;
+                    dfM2 += dfDelta * (dfValue - dfMean);
+                }
+            }
+        }
+
+        nSampleCount = static_cast<GUIntBig>(nXReduced) * nYReduced;
+
+        CPLFree(pData);
+        CPLFree(pabyMaskData);
+    }
+
+    else  // No arbitrary overviews.
+    {
+        if (!InitBlockInfo())
+            return CE_Failure;
+
+        /* --------------------------------------------------------------------
+         */
+        /*      Figure out the ratio of blocks we will read to get an */
+        /*      approximate value. */
+        /* --------------------------------------------------------------------
+         */
+        int nSampleRate = 1;
+        if (bApproxOK)
+        {
+            nSampleRate = static_cast<int>(std::max(
+                1.0,
+                sqrt(static_cast<double>(nBlocksPerRow) * nBlocksPerColumn)));
+            // We want to avoid probing only the first column of blocks for
+            // a square shaped raster, because it is not unlikely that it may
+            // be padding only (#6378)
+            if (nSampleRate == nBlocksPerRow && nBlocksPerRow > 1)
+                nSampleRate += 1;
+        }
+        if (nSampleRate == 1)
+            bApproxOK = false;
+
+        const double dfTotalBlocks =
+            static_cast<double>(nBlocksPerRow) * nBlocksPerColumn;
+        const auto progress =
+            [pfnProgress, pProgressData, dfTotalBlocks](GIntBig iSampleBlock)
+        {
+            return pfnProgress(static_cast<double>(iSampleBlock) /
+                                   dfTotalBlocks,
+                               "Compute Statistics", pProgressData) != FALSE;
+        };
+
+        // Particular case for GDT_Byte that only use integral types for all
+        // intermediate computations. Only possible if the number of pixels
+        // explored is lower than GUINTBIG_MAX / (255*255), so that nSumSquare
+        // can fit on a uint64. Should be 99.99999% of cases.
+        // For GUInt16, this limits to raster of 4 giga pixels
+        if ((!poMaskBand && eDataType == GDT_Byte && !bSignedByte &&
+             static_cast<GUIntBig>(nBlocksPerRow) * nBlocksPerColumn /
+                     nSampleRate <
+                 GUINTBIG_MAX / (255U * 255U) /
+                     (static_cast<GUInt64>(nBlockXSize) *
+                      static_cast<GUInt64>(nBlockYSize))) ||
+            (eDataType == GDT_UInt16 &&
+             static_cast<GUIntBig>(nBlocksPerRow) * nBlocksPerColumn /
+                     nSampleRate <
+                 GUINTBIG_MAX / (65535U * 65535U) /
+                     (static_cast<GUInt64>(nBlockXSize) *
+                      static_cast<GUInt64>(nBlockYSize))))
+        {
+            const GUInt32 nMaxValueType = (eDataType == GDT_Byte) ? 255 : 65535;
+            // If no valid nodata, map to invalid value (256 for Byte)
+            const GUInt32 nNoDataValue =
+                (sNoDataValues.bGotNoDataValue &&
+                 sNoDataValues.dfNoDataValue >= 0 &&
+                 sNoDataValues.dfNoDataValue <= nMaxValueType &&
+                 fabs(sNoDataValues.dfNoDataValue -
+                      static_cast<GUInt32>(sNoDataValues.dfNoDataValue +
+                                           1e-10)) < 1e-10)
+                    ? static_cast<GUInt32>(sNoDataValues.dfNoDataValue + 1e-10)
+                    : nMaxValueType + 1;
+
+            const auto processBlock =
+                [this, nMaxValueType,
+                 nNoDataValue](const void *pData, const GByte *, int nXCheck,
+                               int nYCheck, int nLineStride,
+                               GDALIntegralStatsAccumulator &oAcc)
+            {
+                if (eDataType == GDT_Byte)
+                {
+                    ComputeStatisticsInternal<
+                        GByte, /* COMPUTE_OTHER_STATS = */ true>::
+                        f(nXCheck, nLineStride, nYCheck,
+                          static_cast<const GByte *>(pData),
+                          nNoDataValue <= nMaxValueType, nNoDataValue,
+                          oAcc.nMin, oAcc.nMax, oAcc.nSum, oAcc.nSumSquare,
+                          oAcc.nSampleCount, oAcc.nValidCount);
+                }
+                else
+                {
+                    ComputeStatisticsInternal<
+                        GUInt16, /* COMPUTE_OTHER_STATS = */ true>::
+                        f(nXCheck, nLineStride, nYCheck,
+                          static_cast<const GUInt16 *>(pData),
+                          nNoDataValue <= nMaxValueType, nNoDataValue,
+                          oAcc.nMin, oAcc.nMax, oAcc.nSum, oAcc.nSumSquare,
+                          oAcc.nSampleCount, oAcc.nValidCount);
+                }
+            };
+
+            GDALIntegralStatsAccumulator oAcc(nMaxValueType);
+            // Statistics computed by GDALDataset::ComputeStatistics()
+            // together with the ones of other bands.
+            bool bPassError = false;
+            if (TakeMultiBandPassStatistics(this, nSampleRate, &oAcc, nullptr,
+                                            bPassError))
+            {
+                if (bPassError)
+                    return CE_Failure;
+            }
+            else
+            {
+                bool bInterrupted = false;
+                const CPLErr eErr = ProcessSampledBlocks(
+                    this, nSampleRate, nullptr, /* bOrderedMerge = */ false,
+                    oAcc, processBlock, progress,
+                    /* canStop = */ nullptr, &bInterrupted);
+                if (eErr != CE_None)
+                {
+                    if (bInterrupted)
+                        ReportError(CE_Failure, CPLE_UserInterrupt,
+                                    "User terminated");
+                    return CE_Failure;
+                }
+            }
+
+            const GUInt32 nMin = oAcc.nMin;
+            const GUInt32 nMax = oAcc.nMax;
+            const GUIntBig nSum = oAcc.nSum;
+            const GUIntBig nSumSquare = oAcc.nSumSquare;
+            nSampleCount = oAcc.nSampleCount;
+            nValidCount = oAcc.nValidCount;
+
+            if (!pfnProgress(1.0, "Compute Statistics", pProgressData))
+            {
+                ReportError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+                return CE_Failure;
+            }
+
+            /* --------------------------------------------------------------------
+             */
+            /*      Save computed information. */
+            /* --------------------------------------------------------------------
+             */
+            if (nValidCount)
+                dfMean = static_cast<double>(nSum) / nValidCount;
+
+            // To avoid potential precision issues when doing the difference,
+            // we need to do that computation on 128 bit rather than casting
+            // to double
+            const GDALUInt128 nTmpForStdDev(
+                GDALUInt128::Mul(nSumSquare, nValidCount) -
+                GDALUInt128::Mul(nSum, nSum));
+            const double dfStdDev =
+                nValidCount > 0
+                    ? sqrt(static_cast<double>(nTmpForStdDev)) / nValidCount
+                    : 0.0;
+
+            if (nValidCount > 0)
+            {
+                if (bApproxOK)
+                {
+                    SetMetadataItem("STATISTICS_APPROXIMATE", "YES");
+                }
+                else if (GetMetadataItem("STATISTICS_APPROXIMATE"))
+                {
+                    SetMetadataItem("STATISTICS_APPROXIMATE", nullptr);
+                }
+                SetStatistics(nMin, nMax, dfMean, dfStdDev);
+            }
+
+            SetValidPercent(nSampleCount, nValidCount);
+
+            /* --------------------------------------------------------------------
+             */
+            /*      Record results. */
+            /* --------------------------------------------------------------------
+             */
+            if (pdfMin != nullptr)
+                *pdfMin = nValidCount ? nMin : 0;
+            if (pdfMax != nullptr)
+                *pdfMax = nValidCount ? nMax : 0;
+
+            if (pdfMean != nullptr)
+                *pdfMean = dfMean;
+
+            if (pdfStdDev != nullptr)
+                *pdfStdDev = dfStdDev;
 
-                nSum += nSumThis;
+            if (nValidCount > 0)
+                return CE_None;
 
-                for (; i < nBlockPixels; i++)
-                {
-                    const GUInt32 nValue = pData[i];
-                    if (nValue < nMin)
-                        nMin = nValue;
-                    if (nValue > nMax)
-                        nMax = nValue;
-                    nSum += nValue;
-                    nSumSquare +=
-                        static_cast_for_coverity_scan<GUIntBig>(nValue) *
-                        nValue;
-                }
+            ReportError(CE_Failure, CPLE_AppDefined,
+                        "Failed to compute statistics, no valid pixels found "
+                        "in sampling.");
+            return CE_Failure;
+        }
 
-                nSampleCount += static_cast<GUIntBig>(nXCheck) * nYCheck;
-                nValidCount += static_cast<GUIntBig>(nXCheck) * nYCheck;
-            }
+        // Each block is accumulated separately and merged in block order,
+        // so that the result does not depend on the number of threads.
+        const auto processBlock =
+            [this, bSignedByte, &sNoDataValues](
+                const void *pData, const GByte *pabyMaskData, int nXCheck,
+                int nYCheck, int nLineStride, GDALWelfordAccumulator &oAcc)
+        {
+            ComputeStatisticsGenericForBlock(eDataType, bSignedByte,
+                                             sNoDataValues, pData,
+                                             pabyMaskData, nXCheck, nYCheck,
+                                             nLineStride, oAcc);
+        };
+
+        GDALWelfordAccumulator oAcc;
+        bool bPassError = false;
+        if (TakeMultiBandPassStatistics(this, nSampleRate, nullptr, &oAcc,
+                                        bPassError))
+        {
+            if (bPassError)
+                return CE_Failure;
         }
         else
         {
-            ComputeStatisticsInternalGeneric<GUInt16, COMPUTE_OTHER_STATS>::f(
-                nXCheck, nBlockXSize, nYCheck, pData, bHasNoData, nNoDataValue,
-                nMin, nMax, nSum, nSumSquare, nSampleCount, nValidCount);
+            bool bInterrupted = false;
+            const CPLErr eErr = ProcessSampledBlocks(
+                this, nSampleRate, poMaskBand, /* bOrderedMerge = */ true,
+                oAcc, processBlock, progress,
+                /* canStop = */ nullptr, &bInterrupted);
+            if (eErr != CE_None)
+            {
+                if (bInterrupted)
+                    ReportError(CE_Failure, CPLE_UserInterrupt,
+                                "User terminated");
+                return CE_Failure;
+            }
         }
+
+        dfMin = oAcc.dfMin;
+        dfMax = oAcc.dfMax;
+        dfMean = oAcc.dfMean;
+        dfM2 = oAcc.dfM2;
+        nSampleCount = oAcc.nSampleCount;
+        nValidCount = oAcc.nValidCount;
     }
-};
 
-#endif
-// (defined(__x86_64__) || defined(_M_X64)) && (defined(__GNUC__) ||
-// defined(_MSC_VER))
+    if (!pfnProgress(1.0, "Compute Statistics", pProgressData))
+    {
+        ReportError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+        return CE_Failure;
+    }
 
-/************************************************************************/
-/*                          GetPixelValue()                             */
-/************************************************************************/
+    /* -------------------------------------------------------------------- */
+    /*      Save computed information.                                      */
+    /* -------------------------------------------------------------------- */
+    const double dfStdDev = nValidCount > 0 ? sqrt(dfM2 / nValidCount) : 0.0;
 
-static inline double GetPixelValue(GDALDataType eDataType, bool bSignedByte,
-                                   const void *pData, GPtrDiff_t iOffset,
-                                   const GDALNoDataValues &sNoDataValues,
-                                   bool &bValid)
-{
-    bValid = true;
-    double dfValue = 0;
-    switch (eDataType)
+    if (nValidCount > 0)
     {
-        case GDT_Byte:
-        {
-            if (bSignedByte)
-                dfValue = static_cast<const signed char *>(pData)[iOffset];
-            else
-                dfValue = static_cast<const GByte *>(pData)[iOffset];
-            break;
-        }
-        case GDT_Int8:
-            dfValue = static_cast<const GInt8 *>(pData)[iOffset];
-            break;
-        case GDT_UInt16:
-            dfValue = static_cast<const GUInt16 *>(pData)[iOffset];
-            break;
-        case GDT_Int16:
-            dfValue = static_cast<const GInt16 *>(pData)[iOffset];
-            break;
-        case GDT_UInt32:
-            dfValue = static_cast<const GUInt32 *>(pData)[iOffset];
-            break;
-        case GDT_Int32:
-            dfValue = static_cast<const GInt32 *>(pData)[iOffset];
-            break;
-        case GDT_UInt64:
-            dfValue = static_cast<double>(
-                static_cast<const std::uint64_t *>(pData)[iOffset]);
-            break;
-        case GDT_Int64:
-            dfValue = static_cast<double>(
-                static_cast<const std::int64_t *>(pData)[iOffset]);
-            break;
-        case GDT_Float16:
+        if (bApproxOK)
         {
-            using namespace std;
-            const GFloat16 hfValue =
-                static_cast<const GFloat16 *>(pData)[iOffset];
-            if (isnan(hfValue) ||
-                (sNoDataValues.bGotFloat16NoDataValue &&
-                 ARE_REAL_EQUAL(hfValue, sNoDataValues.hfNoDataValue)))
-            {
-                bValid = false;
-                return 0.0;
-            }
-            dfValue = hfValue;
-            return dfValue;
+            SetMetadataItem("STATISTICS_APPROXIMATE", "YES");
         }
-        case GDT_Float32:
+        else if (GetMetadataItem("STATISTICS_APPROXIMATE"))
         {
-            const float fValue = static_cast<const float *>(pData)[iOffset];
-            if (std::isnan(fValue) ||
-                (sNoDataValues.bGotFloatNoDataValue &&
-                 ARE_REAL_EQUAL(fValue, sNoDataValues.fNoDataValue)))
-            {
-                bValid = false;
-                return 0.0;
-            }
-            dfValue = fValue;
-            return dfValue;
+            SetMetadataItem("STATISTICS_APPROXIMATE", nullptr);
         }
-        case GDT_Float64:
-            dfValue = static_cast<const double *>(pData)[iOffset];
-            if (std::isnan(dfValue))
-            {
-                bValid = false;
-                return 0.0;
-            }
-            break;
-        case GDT_CInt16:
-            dfValue = static_cast<const GInt16 *>(pData)[iOffset * 2];
-            break;
-        case GDT_CInt32:
-            dfValue = static_cast<const GInt32 *>(pData)[iOffset * 2];
-            break;
-        case GDT_CFloat16:
-            dfValue = static_cast<const GFloat16 *>(pData)[iOffset * 2];
-            if (std::isnan(dfValue))
-            {
-                bValid = false;
-                return 0.0;
-            }
-            break;
-        case GDT_CFloat32:
-            dfValue = static_cast<const float *>(pData)[iOffset * 2];
-            if (std::isnan(dfValue))
-            {
-                bValid = false;
-                return 0.0;
-            }
-            break;
-        case GDT_CFloat64:
-            dfValue = static_cast<const double *>(pData)[iOffset * 2];
-            if (std::isnan(dfValue))
-            {
-                bValid = false;
-                return 0.0;
-            }
-            break;
-        case GDT_Unknown:
-        case GDT_TypeCount:
-            CPLAssert(false);
-            break;
+        SetStatistics(dfMin, dfMax, dfMean, dfStdDev);
     }
-
-    if (sNoDataValues.bGotNoDataValue &&
-        ARE_REAL_EQUAL(dfValue, sNoDataValues.dfNoDataValue))
+    else
     {
-        bValid = false;
-        return 0.0;
+        dfMin = 0.0;
+        dfMax = 0.0;
     }
-    return dfValue;
+
+    SetValidPercent(nSampleCount, nValidCount);
+
+    /* -------------------------------------------------------------------- */
+    /*      Record results.                                                 */
+    /* -------------------------------------------------------------------- */
+    if (pdfMin != nullptr)
+        *pdfMin = dfMin;
+    if (pdfMax != nullptr)
+        *pdfMax = dfMax;
+
+    if (pdfMean != nullptr)
+        *pdfMean = dfMean;
+
+    if (pdfStdDev != nullptr)
+        *pdfStdDev = dfStdDev;
+
+    if (nValidCount > 0)
+        return CE_None;
+
+    ReportError(
+        CE_Failure, CPLE_AppDefined,
+        "Failed to compute statistics, no valid pixels found in sampling.");
+    return CE_Failure;
 }
 
 /************************************************************************/
-/*                         SetValidPercent()                            */
+/*                    GDALComputeRasterStatistics()                     */
 /************************************************************************/
 
-//! @cond Doxygen_Suppress
 /**
- * \brief Set percentage of valid (not nodata) pixels.
- *
- * Stores the percentage of valid pixels in the metadata item
- * STATISTICS_VALID_PERCENT
- *
- * @param nSampleCount Number of sampled pixels.
+ * \brief Compute image statistics.
  *
- * @param nValidCount Number of valid pixels.
+ * @see GDALRasterBand::ComputeStatistics()
  */
 
-void GDALRasterBand::SetValidPercent(GUIntBig nSampleCount,
-                                     GUIntBig nValidCount)
+CPLErr CPL_STDCALL GDALComputeRasterStatistics(GDALRasterBandH hBand,
+                                               int bApproxOK, double *pdfMin,
+                                               double *pdfMax, double *pdfMean,
+                                               double *pdfStdDev,
+                                               GDALProgressFunc pfnProgress,
+                                               void *pProgressData)
+
 {
-    if (nValidCount == 0)
+    VALIDATE_POINTER1(hBand, "GDALComputeRasterStatistics", CE_Failure);
+
+    GDALRasterBand *poBand = GDALRasterBand::FromHandle(hBand);
+
+    return poBand->ComputeStatistics(bApproxOK, pdfMin, pdfMax, pdfMean,
+                                     pdfStdDev, pfnProgress, pProgressData);
+}
+
+/************************************************************************/
+/*                      GetBandMapForStatistics()                       */
+/************************************************************************/
+
+static bool GetBandMapForStatistics(GDALDataset *poDS, int nBandCount,
+                                    const int *panBandMap, const char *pszFunc,
+                                    std::vector<GDALRasterBand *> &apoBands)
+{
+    if (nBandCount == 0)
     {
-        SetMetadataItem("STATISTICS_VALID_PERCENT", "0");
+        for (int i = 1; i <= poDS->GetRasterCount(); ++i)
+            apoBands.push_back(poDS->GetRasterBand(i));
+        return true;
     }
-    else if (nValidCount == nSampleCount)
+    if (nBandCount < 0 || panBandMap == nullptr)
     {
-        SetMetadataItem("STATISTICS_VALID_PERCENT", "100");
+        poDS->ReportError(CE_Failure, CPLE_IllegalArg,
+                          "%s(): invalid band list", pszFunc);
+        return false;
     }
-    else /* nValidCount < nSampleCount */
+    for (int i = 0; i < nBandCount; ++i)
     {
-        char szValue[128] = {0};
-
-        /* percentage is only an indicator: limit precision */
-        CPLsnprintf(szValue, sizeof(szValue), "%.4g",
-                    100. * static_cast<double>(nValidCount) / nSampleCount);
-
-        if (EQUAL(szValue, "100"))
-        {
-            /* don't set 100 percent valid
-             * because some of the sampled pixels were nodata */
-            SetMetadataItem("STATISTICS_VALID_PERCENT", "99.999");
-        }
-        else
+        if (panBandMap[i] < 1 || panBandMap[i] > poDS->GetRasterCount())
         {
-            SetMetadataItem("STATISTICS_VALID_PERCENT", szValue);
+            poDS->ReportError(CE_Failure, CPLE_IllegalArg,
+                              "%s(): invalid band number: %d", pszFunc,
+                              panBandMap[i]);
+            return false;
         }
+        apoBands.push_back(poDS->GetRasterBand(panBandMap[i]));
     }
+    return true;
 }
 
-//! @endcond
+/************************************************************************/
+/*                      CanUseSinglePassOnBands()                       */
+/************************************************************************/
+
+/** Returns whether statistics or histograms of the bands can be computed by
+ * iterating once over the blocks of the dataset, and processing the
+ * corresponding block of each band together. This is only done for
+ * pixel-interleaved datasets, where reading a block of a band decodes the
+ * blocks of all bands, and when the per-band computation would not use
+ * overviews.
+ */
+static bool
+CanUseSinglePassOnBands(GDALDataset *poDS,
+                        const std::vector<GDALRasterBand *> &apoBands,
+                        bool bApproxOK)
+{
+    if (apoBands.size() < 2)
+        return false;
+    const char *pszInterleave =
+        poDS->GetMetadataItem("INTERLEAVE", "IMAGE_STRUCTURE");
+    if (!pszInterleave || !EQUAL(pszInterleave, "PIXEL"))
+        return false;
+
+    int nBlockXSize = 0;
+    int nBlockYSize = 0;
+    apoBands[0]->GetBlockSize(&nBlockXSize, &nBlockYSize);
+    for (GDALRasterBand *poBand : apoBands)
+    {
+        int nThisBlockXSize = 0;
+        int nThisBlockYSize = 0;
+        poBand->GetBlockSize(&nThisBlockXSize, &nThisBlockYSize);
+        if (nThisBlockXSize != nBlockXSize || nThisBlockYSize != nBlockYSize)
+            return false;
+        if (bApproxOK &&
+            (poBand->GetOverviewCount() > 0 || poBand->HasArbitraryOverviews()))
+            return false;
+    }
+    return nBlockXSize > 0 && nBlockYSize > 0;
+}
 
 /************************************************************************/
-/*                         ComputeStatistics()                          */
+/*                       ProcessBlocksOfBands()                         */
 /************************************************************************/
 
-/**
- * \brief Compute image statistics.
- *
- * Returns the minimum, maximum, mean and standard deviation of all
- * pixel values in this band.  If approximate statistics are sufficient,
- * the bApproxOK flag can be set to true in which case overviews, or a
- * subset of image tiles may be used in computing the statistics.
- *
- * Once computed, the statistics will generally be "set" back on the
- * raster band using SetStatistics().
- *
- * Cached statistics can be cleared with GDALDataset::ClearStatistics().
- *
- * This method is the same as the C function GDALComputeRasterStatistics().
- *
- * @param bApproxOK If TRUE statistics may be computed based on overviews
- * or a subset of all tiles.
- *
- * @param pdfMin Location into which to load image minimum (may be NULL).
- *
- * @param pdfMax Location into which to load image maximum (may be NULL).-
- *
- * @param pdfMean Location into which to load image mean (may be NULL).
- *
- * @param pdfStdDev Location into which to load image standard deviation
- * (may be NULL).
- *
- * @param pfnProgress a function to call to report progress, or NULL.
+/** Iterate over one block every nSampleRate blocks of a dataset, and call
+ * processBandBlock(iBand, pData, pabyMaskData, nXCheck, nYCheck) for each
+ * band of apoBands.
  *
- * @param pProgressData application data to pass to the progress function.
- *
- * @return CE_None on success, or CE_Failure if an error occurs or processing
- * is terminated by the user.
+ * Blocks are read band after band by the calling thread. When
+ * GDAL_NUM_THREADS is greater than 1, the processing of the blocks of the
+ * different bands at a given location is done in parallel.
  */
+template <class ProcessBandBlockFunc>
+static CPLErr ProcessBlocksOfBands(
+    const std::vector<GDALRasterBand *> &apoBands,
+    const std::vector<GDALRasterBand *> &apoMaskBands, int nSampleRate,
+    const ProcessBandBlockFunc &processBandBlock, const char *pszMessage,
+    GDALProgressFunc pfnProgress, void *pProgressData)
+{
+    GDALRasterBand *poFirstBand = apoBands[0];
+    int nBlockXSize = 0;
+    int nBlockYSize = 0;
+    poFirstBand->GetBlockSize(&nBlockXSize, &nBlockYSize);
+    const int nBlocksPerRow =
+        DIV_ROUND_UP(poFirstBand->GetXSize(), nBlockXSize);
+    const int nBlocksPerColumn =
+        DIV_ROUND_UP(poFirstBand->GetYSize(), nBlockYSize);
+    const GIntBig nTotalBlocks =
+        static_cast<GIntBig>(nBlocksPerRow) * nBlocksPerColumn;
+    const int nBands = static_cast<int>(apoBands.size());
 
-CPLErr GDALRasterBand::ComputeStatistics(int bApproxOK, double *pdfMin,
-                                         double *pdfMax, double *pdfMean,
-                                         double *pdfStdDev,
-                                         GDALProgressFunc pfnProgress,
-                                         void *pProgressData)
+    std::vector<std::vector<GByte>> aabyMaskData(nBands);
+    try
+    {
+        for (int i = 0; i < nBands; ++i)
+        {
+            if (apoMaskBands[i])
+                aabyMaskData[i].resize(static_cast<size_t>(nBlockXSize) *
+                                       nBlockYSize);
+        }
+    }
+    catch (const std::exception &)
+    {
+        poFirstBand->ReportError(CE_Failure, CPLE_OutOfMemory,
+                                 "Out of memory allocating mask buffer");
+        return CE_Failure;
+    }
 
-{
-    if (pfnProgress == nullptr)
-        pfnProgress = GDALDummyProgress;
+    const int nThreads = GetNumThreadsForBlockProcessing(nBands);
+    CPLWorkerThreadPool *poThreadPool =
+        nThreads > 1 ? GDALGetGlobalThreadPool(nThreads) : nullptr;
+    auto poJobQueue = poThreadPool ? poThreadPool->CreateJobQueue()
+                                   : std::unique_ptr<CPLJobQueue>(nullptr);
 
-    /* -------------------------------------------------------------------- */
-    /*      If we have overview bands, use them for statistics.             */
-    /* -------------------------------------------------------------------- */
-    if (bApproxOK && GetOverviewCount() > 0 && !HasArbitraryOverviews())
+    std::vector<GDALRasterBlock *> apoBlocks(nBands);
+    for (GIntBig iSampleBlock = 0; iSampleBlock < nTotalBlocks;
+         iSampleBlock += nSampleRate)
     {
-        GDALRasterBand *poBand =
-            GetRasterSampleOverview(GDALSTAT_APPROX_NUMSAMPLES);
+        const int iYBlock = static_cast<int>(iSampleBlock / nBlocksPerRow);
+        const int iXBlock = static_cast<int>(iSampleBlock % nBlocksPerRow);
 
-        if (poBand != this)
+        int nXCheck = 0, nYCheck = 0;
+        poFirstBand->GetActualBlockSize(iXBlock, iYBlock, &nXCheck, &nYCheck);
+
+        bool bError = false;
+        for (int i = 0; i < nBands && !bError; ++i)
         {
-            CPLErr eErr = poBand->ComputeStatistics(FALSE, pdfMin, pdfMax,
-                                                    pdfMean, pdfStdDev,
-                                                    pfnProgress, pProgressData);
-            if (eErr == CE_None)
+            apoBlocks[i] = apoBands[i]->GetLockedBlockRef(iXBlock, iYBlock);
+            if (apoBlocks[i] == nullptr)
             {
-                if (pdfMin && pdfMax && pdfMean && pdfStdDev)
-                {
-                    SetMetadataItem("STATISTICS_APPROXIMATE", "YES");
-                    SetStatistics(*pdfMin, *pdfMax, *pdfMean, *pdfStdDev);
-                }
-
-                /* transfer metadata from overview band to this */
-                const char *pszPercentValid =
-                    poBand->GetMetadataItem("STATISTICS_VALID_PERCENT");
+                bError = true;
+            }
+            else if (apoMaskBands[i] &&
+                     apoMaskBands[i]->RasterIO(
+                         GF_Read, iXBlock * nBlockXSize, iYBlock * nBlockYSize,
+                         nXCheck, nYCheck, aabyMaskData[i].data(), nXCheck,
+                         nYCheck, GDT_Byte, 0, nBlockXSize,
+                         nullptr) != CE_None)
+            {
+                apoBlocks[i]->DropLock();
+                apoBlocks[i] = nullptr;
+                bError = true;
+            }
+        }
 
-                if (pszPercentValid != nullptr)
+        if (!bError)
+        {
+            for (int i = 0; i < nBands; ++i)
+            {
+                const auto processBlock =
+                    [&processBandBlock, &apoBlocks, &aabyMaskData, i, nXCheck,
+                     nYCheck]()
                 {
-                    SetMetadataItem("STATISTICS_VALID_PERCENT",
-                                    pszPercentValid);
-                }
+                    processBandBlock(i, apoBlocks[i]->GetDataRef(),
+                                     aabyMaskData[i].empty()
+                                         ? nullptr
+                                         : aabyMaskData[i].data(),
+                                     nXCheck, nYCheck);
+                };
+                if (poJobQueue)
+                    poJobQueue->SubmitJob(processBlock);
+                else
+                    processBlock();
             }
-            return eErr;
+            if (poJobQueue)
+                poJobQueue->WaitCompletion();
+        }
+
+        for (auto &poBlock : apoBlocks)
+        {
+            if (poBlock)
+                poBlock->DropLock();
+            poBlock = nullptr;
+        }
+        if (bError)
+            return CE_Failure;
+
+        if (!pfnProgress(static_cast<double>(iSampleBlock) /
+                             static_cast<double>(nTotalBlocks),
+                         pszMessage, pProgressData))
+        {
+            poFirstBand->ReportError(CE_Failure, CPLE_UserInterrupt,
+                                     "User terminated");
+            return CE_Failure;
         }
     }
 
-    if (!pfnProgress(0.0, "Compute Statistics", pProgressData))
+    return CE_None;
+}
+
+/************************************************************************/
+/*                    GetSampleRateForMultiBandPass()                   */
+/************************************************************************/
+
+static int GetSampleRateForMultiBandPass(GDALRasterBand *poBand,
+                                         bool bApproxOK)
+{
+    int nBlockXSize = 0;
+    int nBlockYSize = 0;
+    poBand->GetBlockSize(&nBlockXSize, &nBlockYSize);
+    const int nBlocksPerRow = DIV_ROUND_UP(poBand->GetXSize(), nBlockXSize);
+    const int nBlocksPerColumn =
+        DIV_ROUND_UP(poBand->GetYSize(), nBlockYSize);
+    int nSampleRate = 1;
+    if (bApproxOK)
     {
-        ReportError(CE_Failure, CPLE_UserInterrupt, "User terminated");
-        return CE_Failure;
+        nSampleRate = static_cast<int>(std::max(
+            1.0, sqrt(static_cast<double>(nBlocksPerRow) * nBlocksPerColumn)));
+        // We want to avoid probing only the first column of blocks for
+        // a square shaped raster, because it is not unlikely that it may
+        // be padding only (#6378)
+        if (nSampleRate == nBlocksPerRow && nBlocksPerRow > 1)
+            nSampleRate += 1;
     }
+    return nSampleRate;
+}
 
-    /* -------------------------------------------------------------------- */
-    /*      Read actual data and compute statistics.                        */
-    /* -------------------------------------------------------------------- */
-    // Using Welford algorithm:
-    // http://en.wikipedia.org/wiki/Algorithms_for_calculating_variance
-    // to compute standard deviation in a more numerically robust way than
-    // the difference of the sum of square values with the square of the sum.
-    // dfMean and dfM2 are updated at each sample.
-    // dfM2 is the sum of square of differences to the current mean.
-    double dfMin = std::numeric_limits<double>::infinity();
-    double dfMax = -std::numeric_limits<double>::infinity();
-    double dfMean = 0.0;
-    double dfM2 = 0.0;
+/************************************************************************/
+/*                          GDALMultiBandPass                           */
+/************************************************************************/
 
-    GDALRasterIOExtraArg sExtraArg;
-    INIT_RASTERIO_EXTRA_ARG(sExtraArg);
+namespace
+{
+/** Computation of the statistics or histograms of several bands of a
+ * pixel-interleaved dataset with a single pass over its blocks.
+ *
+ * GDALDataset::ComputeStatistics() and GDALDataset::GetHistogram() install
+ * it for the calling thread, and then call the method of each band, which
+ * may be overridden by the driver. The first band whose call reaches the
+ * GDALRasterBand implementation runs the pass for itself and the following
+ * bands, which then take their result instead of reading their blocks again.
+ */
+struct GDALMultiBandPass
+{
+    bool bHistogram = false;
+    std::vector<GDALRasterBand *> apoBands{};
+    int nSampleRate = 1;
+    GDALProgressFunc pfnProgress = GDALDummyProgress;
+    void *pProgressData = nullptr;
+
+    // Statistics: whether to also count the pixels of each value of 8 and
+    // 16-bit integer bands, from which any of their histograms can be derived.
+    bool bCollectValueHistograms = false;
+
+    // Histograms
+    std::vector<double> adfMin{};
+    std::vector<double> adfMax{};
+    int nBuckets = 0;
+    bool bIncludeOutOfRange = false;
+
+    bool bDone = false;
+    bool bFailed = false;
+
+    struct BandResult
+    {
+        bool bRequested = true;
+        bool bAvailable = false;
+        bool bIntegral = false;
+        GDALIntegralStatsAccumulator oIntegralAcc{0};
+        GDALWelfordAccumulator oAcc{};
+        std::vector<GUIntBig> anHistogram{};
+        // Number of pixels of value dfValueHistogramMin + i
+        std::vector<GUIntBig> anValueHistogram{};
+        double dfValueHistogramMin = 0;
+    };
 
-    GDALNoDataValues sNoDataValues(this, eDataType);
-    GDALRasterBand *poMaskBand = nullptr;
-    if (!sNoDataValues.bGotNoDataValue)
+    std::vector<BandResult> aoResults{};
+
+    int GetBandIndex(const GDALRasterBand *poBand) const
     {
-        const int l_nMaskFlags = GetMaskFlags();
-        if (l_nMaskFlags != GMF_ALL_VALID && l_nMaskFlags != GMF_NODATA &&
-            GetColorInterpretation() != GCI_AlphaBand)
+        for (size_t i = 0; i < apoBands.size(); ++i)
         {
-            poMaskBand = GetMaskBand();
+            if (apoBands[i] == poBand)
+                return static_cast<int>(i);
         }
+        return -1;
     }
+};
 
-    bool bSignedByte = false;
-    if (eDataType == GDT_Byte)
+thread_local GDALMultiBandPass *tlsMultiBandPass = nullptr;
+
+/** Installs a GDALMultiBandPass for the calling thread */
+class GDALMultiBandPassSetter
+{
+    GDALMultiBandPass *const m_poOldPass;
+
+    CPL_DISALLOW_COPY_ASSIGN(GDALMultiBandPassSetter)
+
+  public:
+    explicit GDALMultiBandPassSetter(GDALMultiBandPass *poPass)
+        : m_poOldPass(tlsMultiBandPass)
     {
-        EnablePixelTypeSignedByteWarning(false);
-        const char *pszPixelType =
-            GetMetadataItem("PIXELTYPE", "IMAGE_STRUCTURE");
-        EnablePixelTypeSignedByteWarning(true);
-        bSignedByte =
-            pszPixelType != nullptr && EQUAL(pszPixelType, "SIGNEDBYTE");
+        tlsMultiBandPass = poPass;
     }
 
-    GUIntBig nSampleCount = 0;
-    GUIntBig nValidCount = 0;
+    ~GDALMultiBandPassSetter()
+    {
+        tlsMultiBandPass = m_poOldPass;
+    }
+};
+}  // namespace
 
-    if (bApproxOK && HasArbitraryOverviews())
+/************************************************************************/
+/*                       GetValueHistogramRange()                       */
+/************************************************************************/
+
+/** Returns whether all histograms of a band can be derived from the number
+ * of pixels of each of its values, and the range of those values.
+ */
+static bool GetValueHistogramRange(GDALDataType eDataType, bool bSignedByte,
+                                   const GDALNoDataValues &sNoDataValues,
+                                   double &dfValueMin, int &nValues)
+{
+    switch (eDataType)
     {
-        /* --------------------------------------------------------------------
-         */
-        /*      Figure out how much the image should be reduced to get an */
-        /*      approximate value. */
-        /* --------------------------------------------------------------------
-         */
-        double dfReduction = sqrt(static_cast<double>(nRasterXSize) *
-                                  nRasterYSize / GDALSTAT_APPROX_NUMSAMPLES);
+        case GDT_Byte:
+            dfValueMin = bSignedByte ? -128 : 0;
+            nValues = 256;
+            break;
+        case GDT_Int8:
+            dfValueMin = -128;
+            nValues = 256;
+            break;
+        case GDT_UInt16:
+            dfValueMin = 0;
+            nValues = 65536;
+            break;
+        case GDT_Int16:
+            dfValueMin = -32768;
+            nValues = 65536;
+            break;
+        default:
+            return false;
+    }
 
-        int nXReduced = nRasterXSize;
-        int nYReduced = nRasterYSize;
-        if (dfReduction > 1.0)
-        {
-            nXReduced = static_cast<int>(nRasterXSize / dfReduction);
-            nYReduced = static_cast<int>(nRasterYSize / dfReduction);
+    // The fast path of ComputeHistogramForBlock() for Byte does not
+    // compare the nodata value in the same way as the generic one when it
+    // is not a valid value of the data type.
+    const double dfNoData = sNoDataValues.dfNoDataValue;
+    return !sNoDataValues.bGotNoDataValue ||
+           (dfNoData >= dfValueMin && dfNoData < dfValueMin + nValues &&
+            dfNoData == std::floor(dfNoData));
+}
 
-            // Catch the case of huge resizing ratios here
-            if (nXReduced == 0)
-                nXReduced = 1;
-            if (nYReduced == 0)
-                nYReduced = 1;
-        }
+/************************************************************************/
+/*                        RebinValueHistogram()                         */
+/************************************************************************/
 
-        void *pData = CPLMalloc(cpl::fits_on<int>(
-            GDALGetDataTypeSizeBytes(eDataType) * nXReduced * nYReduced));
+/** Accumulate into panHistogram the pixel counts of anValueHistogram */
+static void RebinValueHistogram(const std::vector<GUIntBig> &anValueHistogram,
+                                double dfValueMin, double dfMin,
+                                double dfScale, int nBuckets,
+                                bool bIncludeOutOfRange,
+                                GUIntBig *panHistogram)
+{
+    for (size_t i = 0; i < anValueHistogram.size(); ++i)
+    {
+        const GUIntBig nCount = anValueHistogram[i];
+        if (nCount == 0)
+            continue;
 
-        const CPLErr eErr =
-            IRasterIO(GF_Read, 0, 0, nRasterXSize, nRasterYSize, pData,
-                      nXReduced, nYReduced, eDataType, 0, 0, &sExtraArg);
-        if (eErr != CE_None)
+        // Same as in ComputeHistogramForBlock()
+        const double dfValue = dfValueMin + static_cast<double>(i);
+        const double dfIndex = floor((dfValue - dfMin) * dfScale);
+        if (dfIndex < 0)
         {
-            CPLFree(pData);
-            return eErr;
+            if (bIncludeOutOfRange)
+                panHistogram[0] += nCount;
         }
-
-        GByte *pabyMaskData = nullptr;
-        if (poMaskBand)
+        else if (dfIndex >= nBuckets)
         {
-            pabyMaskData =
-                static_cast<GByte *>(VSI_MALLOC2_VERBOSE(nXReduced, nYReduced));
-            if (!pabyMaskData)
-            {
-                CPLFree(pData);
-                return CE_Failure;
-            }
-
-            if (poMaskBand->RasterIO(GF_Read, 0, 0, nRasterXSize, nRasterYSize,
-                                     pabyMaskData, nXReduced, nYReduced,
-                                     GDT_Byte, 0, 0, nullptr) != CE_None)
-            {
-                CPLFree(pData);
-                CPLFree(pabyMaskData);
-                return CE_Failure;
-            }
+            if (bIncludeOutOfRange)
+                panHistogram[nBuckets - 1] += nCount;
         }
+        else
+        {
+            panHistogram[static_cast<int>(dfIndex)] += nCount;
+        }
+    }
+}
 
-        /* this isn't the fastest way to do this, but is easier for now */
-        for (int iY = 0; iY < nYReduced; iY++)
-        {
-            for (int iX = 0; iX < nXReduced; iX++)
-            {
-                const int iOffset = iX + iY * nXReduced;
-                if (pabyMaskData && pabyMaskData[iOffset] == 0)
-                    continue;
-
-                bool bValid = true;
-                double dfValue = GetPixelValue(eDataType, bSignedByte, pData,
-                                               iOffset, sNoDataValues, bValid);
-                if (!bValid)
-                    continue;
+/************************************************************************/
+/*                          RunStatisticsPass()                         */
+/************************************************************************/
 
-                dfMin = std::min(dfMin, dfValue);
-                dfMax = std::max(dfMax, dfValue);
+/** Compute the statistics of the bands of oPass from iFirstBand, with the
+ * same intermediate computations as GDALRasterBand::ComputeStatistics().
+ */
+static void RunStatisticsPass(GDALMultiBandPass &oPass, size_t iFirstBand)
+{
+    oPass.bDone = true;
 
-                nValidCount++;
-                if (dfMin == dfMax)
-                {
-                    if (nValidCount == 1)
-                        dfMean = dfMin;
-                }
-                else
-                {
-                    const double dfDelta = dfValue - dfMean;
-                    dfMean += dfDelta / nValidCount;
-                    dfM2 += dfDelta * (dfValue - dfMean);
-                }
-            }
-        }
+    const std::vector<GDALRasterBand *> apoBands(
+        oPass.apoBands.begin() + iFirstBand, oPass.apoBands.end());
+    int nBlockXSize = 0;
+    int nBlockYSize = 0;
+    apoBands[0]->GetBlockSize(&nBlockXSize, &nBlockYSize);
+    const GUIntBig nTotalBlocks =
+        static_cast<GUIntBig>(
+            DIV_ROUND_UP(apoBands[0]->GetXSize(), nBlockXSize)) *
+        DIV_ROUND_UP(apoBands[0]->GetYSize(), nBlockYSize);
+    const int nSampleRate = oPass.nSampleRate;
 
-        nSampleCount = static_cast<GUIntBig>(nXReduced) * nYReduced;
+    struct BandState
+    {
+        GDALMultiBandPass::BandResult &oResult;
+        GDALDataType eDataType;
+        GDALNoDataValues sNoDataValues;
+        bool bSignedByte = false;
+        GUInt32 nMaxValueType = 0;
+        GUInt32 nNoDataValue = 0;
+        int nValues = 0;
 
-        CPLFree(pData);
-        CPLFree(pabyMaskData);
-    }
+        BandState(GDALMultiBandPass::BandResult &oResultIn,
+                  GDALRasterBand *poBand)
+            : oResult(oResultIn), eDataType(poBand->GetRasterDataType()),
+              sNoDataValues(poBand, eDataType)
+        {
+        }
+    };
 
-    else  // No arbitrary overviews.
+    std::vector<std::unique_ptr<BandState>> apoStates;
+    std::vector<GDALRasterBand *> apoMaskBands;
+    for (size_t i = 0; i < apoBands.size(); ++i)
     {
-        if (!InitBlockInfo())
-            return CE_Failure;
+        GDALRasterBand *poBand = apoBands[i];
+        apoStates.push_back(std::make_unique<BandState>(
+            oPass.aoResults[iFirstBand + i], poBand));
+        BandState &oState = *(apoStates.back());
+        GDALMultiBandPass::BandResult &oResult = oState.oResult;
+        const GDALDataType eDataType = oState.eDataType;
 
-        /* --------------------------------------------------------------------
-         */
-        /*      Figure out the ratio of blocks we will read to get an */
-        /*      approximate value. */
-        /* --------------------------------------------------------------------
-         */
-        int nSampleRate = 1;
-        if (bApproxOK)
+        GDALRasterBand *poMaskBand = nullptr;
+        if (!oState.sNoDataValues.bGotNoDataValue)
         {
-            nSampleRate = static_cast<int>(std::max(
-                1.0,
-                sqrt(static_cast<double>(nBlocksPerRow) * nBlocksPerColumn)));
-            // We want to avoid probing only the first column of blocks for
-            // a square shaped raster, because it is not unlikely that it may
-            // be padding only (#6378)
-            if (nSampleRate == nBlocksPerRow && nBlocksPerRow > 1)
-                nSampleRate += 1;
+            const int l_nMaskFlags = poBand->GetMaskFlags();
+            if (l_nMaskFlags != GMF_ALL_VALID && l_nMaskFlags != GMF_NODATA &&
+                poBand->GetColorInterpretation() != GCI_AlphaBand)
+            {
+                poMaskBand = poBand->GetMaskBand();
+            }
         }
-        if (nSampleRate == 1)
-            bApproxOK = false;
 
-        // Particular case for GDT_Byte that only use integral types for all
-        // intermediate computations. Only possible if the number of pixels
-        // explored is lower than GUINTBIG_MAX / (255*255), so that nSumSquare
-        // can fit on a uint64. Should be 99.99999% of cases.
-        // For GUInt16, this limits to raster of 4 giga pixels
-        if ((!poMaskBand && eDataType == GDT_Byte && !bSignedByte &&
-             static_cast<GUIntBig>(nBlocksPerRow) * nBlocksPerColumn /
-                     nSampleRate <
+        if (eDataType == GDT_Byte)
+        {
+            poBand->EnablePixelTypeSignedByteWarning(false);
+            const char *pszPixelType =
+                poBand->GetMetadataItem("PIXELTYPE", "IMAGE_STRUCTURE");
+            poBand->EnablePixelTypeSignedByteWarning(true);
+            oState.bSignedByte =
+                pszPixelType != nullptr && EQUAL(pszPixelType, "SIGNEDBYTE");
+        }
+
+        // Same conditions as in GDALRasterBand::ComputeStatistics() to use
+        // integral types for all intermediate computations.
+        oResult.bIntegral =
+            (!poMaskBand && eDataType == GDT_Byte && !oState.bSignedByte &&
+             nTotalBlocks / nSampleRate <
                  GUINTBIG_MAX / (255U * 255U) /
                      (static_cast<GUInt64>(nBlockXSize) *
                       static_cast<GUInt64>(nBlockYSize))) ||
             (eDataType == GDT_UInt16 &&
-             static_cast<GUIntBig>(nBlocksPerRow) * nBlocksPerColumn /
-                     nSampleRate <
+             nTotalBlocks / nSampleRate <
                  GUINTBIG_MAX / (65535U * 65535U) /
                      (static_cast<GUInt64>(nBlockXSize) *
-                      static_cast<GUInt64>(nBlockYSize))))
+                      static_cast<GUInt64>(nBlockYSize)));
+        if (oResult.bIntegral)
         {
-            const GUInt32 nMaxValueType = (eDataType == GDT_Byte) ? 255 : 65535;
-            GUInt32 nMin = nMaxValueType;
-            GUInt32 nMax = 0;
-            GUIntBig nSum = 0;
-            GUIntBig nSumSquare = 0;
+            const GDALNoDataValues &sNoDataValues = oState.sNoDataValues;
+            oState.nMaxValueType = (eDataType == GDT_Byte) ? 255 : 65535;
+            oResult.oIntegralAcc =
+                GDALIntegralStatsAccumulator(oState.nMaxValueType);
             // If no valid nodata, map to invalid value (256 for Byte)
-            const GUInt32 nNoDataValue =
+            oState.nNoDataValue =
                 (sNoDataValues.bGotNoDataValue &&
                  sNoDataValues.dfNoDataValue >= 0 &&
-                 sNoDataValues.dfNoDataValue <= nMaxValueType &&
+                 sNoDataValues.dfNoDataValue <= oState.nMaxValueType &&
                  fabs(sNoDataValues.dfNoDataValue -
                       static_cast<GUInt32>(sNoDataValues.dfNoDataValue +
                                            1e-10)) < 1e-10)
                     ? static_cast<GUInt32>(sNoDataValues.dfNoDataValue + 1e-10)
-                    : nMaxValueType + 1;
+                    : oState.nMaxValueType + 1;
+        }
 
-            for (GIntBig iSampleBlock = 0;
-                 iSampleBlock <
-                 static_cast<GIntBig>(nBlocksPerRow) * nBlocksPerColumn;
-                 iSampleBlock += nSampleRate)
-            {
-                const int iYBlock =
-                    static_cast<int>(iSampleBlock / nBlocksPerRow);
-                const int iXBlock =
-                    static_cast<int>(iSampleBlock % nBlocksPerRow);
-
-                GDALRasterBlock *const poBlock =
-                    GetLockedBlockRef(iXBlock, iYBlock);
-                if (poBlock == nullptr)
-                    return CE_Failure;
+        // Value histograms must count all pixels, with the mask band used
+        // by GDALRasterBand::GetHistogram(), which the integral computation
+        // of statistics ignores.
+        double dfValueMin = 0;
+        if (oPass.bCollectValueHistograms && nSampleRate == 1 &&
+            GetValueHistogramRange(eDataType, oState.bSignedByte,
+                                   oState.sNoDataValues, dfValueMin,
+                                   oState.nValues))
+        {
+            oResult.anValueHistogram.resize(oState.nValues);
+            oResult.dfValueHistogramMin = dfValueMin;
+        }
+        else if (oResult.bIntegral)
+        {
+            poMaskBand = nullptr;
+        }
+        apoMaskBands.push_back(poMaskBand);
+    }
 
-                void *const pData = poBlock->GetDataRef();
+    const auto processBandBlock =
+        [&apoStates, nBlockXSize, nBlockYSize](
+            int iBand, const void *pData, const GByte *pabyMaskData,
+            int nXCheck, int nYCheck)
+    {
+        BandState &oState = *(apoStates[iBand]);
+        GDALMultiBandPass::BandResult &oResult = oState.oResult;
+        const GDALDataType eDataType = oState.eDataType;
+        if (!oResult.anValueHistogram.empty())
+        {
+            ComputeHistogramForBlock(
+                eDataType, oState.bSignedByte, oState.sNoDataValues,
+                oResult.dfValueHistogramMin - 0.5, 1.0, oState.nValues,
+                /* bIncludeOutOfRange = */ false, pData, pabyMaskData,
+                nXCheck, nYCheck, nBlockXSize, nBlockYSize,
+                oResult.anValueHistogram.data());
+        }
 
-                int nXCheck = 0, nYCheck = 0;
-                GetActualBlockSize(iXBlock, iYBlock, &nXCheck, &nYCheck);
+        if (!oResult.bIntegral)
+        {
+            // Merged block per block, as in
+            // GDALRasterBand::ComputeStatistics()
+            GDALWelfordAccumulator oBlockAcc;
+            ComputeStatisticsGenericForBlock(
+                eDataType, oState.bSignedByte, oState.sNoDataValues, pData,
+                pabyMaskData, nXCheck, nYCheck, nBlockXSize, oBlockAcc);
+            oResult.oAcc.Merge(oBlockAcc);
+            return;
+        }
 
-                if (eDataType == GDT_Byte)
-                {
-                    ComputeStatisticsInternal<
-                        GByte, /* COMPUTE_OTHER_STATS = */ true>::
-                        f(nXCheck, nBlockXSize, nYCheck,
-                          static_cast<const GByte *>(pData),
-                          nNoDataValue <= nMaxValueType, nNoDataValue, nMin,
-                          nMax, nSum, nSumSquare, nSampleCount, nValidCount);
-                }
-                else
-                {
-                    ComputeStatisticsInternal<
-                        GUInt16, /* COMPUTE_OTHER_STATS = */ true>::
-                        f(nXCheck, nBlockXSize, nYCheck,
-                          static_cast<const GUInt16 *>(pData),
-                          nNoDataValue <= nMaxValueType, nNoDataValue, nMin,
-                          nMax, nSum, nSumSquare, nSampleCount, nValidCount);
-                }
+        auto &oAcc = oResult.oIntegralAcc;
+        const bool bHasNoData = oState.nNoDataValue <= oState.nMaxValueType;
+        if (eDataType == GDT_Byte)
+        {
+            ComputeStatisticsInternal<GByte, /* COMPUTE_OTHER_STATS = */ true>::
+                f(nXCheck, nBlockXSize, nYCheck,
+                  static_cast<const GByte *>(pData), bHasNoData,
+                  oState.nNoDataValue, oAcc.nMin, oAcc.nMax, oAcc.nSum,
+                  oAcc.nSumSquare, oAcc.nSampleCount, oAcc.nValidCount);
+        }
+        else
+        {
+            ComputeStatisticsInternal<GUInt16,
+                                      /* COMPUTE_OTHER_STATS = */ true>::
+                f(nXCheck, nBlockXSize, nYCheck,
+                  static_cast<const GUInt16 *>(pData), bHasNoData,
+                  oState.nNoDataValue, oAcc.nMin, oAcc.nMax, oAcc.nSum,
+                  oAcc.nSumSquare, oAcc.nSampleCount, oAcc.nValidCount);
+        }
+    };
 
-                poBlock->DropLock();
+    if (ProcessBlocksOfBands(apoBands, apoMaskBands, nSampleRate,
+                             processBandBlock, "Compute Statistics",
+                             oPass.pfnProgress,
+                             oPass.pProgressData) != CE_None)
+    {
+        oPass.bFailed = true;
+        return;
+    }
 
-                if (!pfnProgress(static_cast<double>(iSampleBlock) /
-                                     (static_cast<double>(nBlocksPerRow) *
-                                      nBlocksPerColumn),
-                                 "Compute Statistics", pProgressData))
-                {
-                    ReportError(CE_Failure, CPLE_UserInterrupt,
-                                "User terminated");
-                    return CE_Failure;
-                }
-            }
+    for (auto &poState : apoStates)
+        poState->oResult.bAvailable = true;
+}
 
-            if (!pfnProgress(1.0, "Compute Statistics", pProgressData))
-            {
-                ReportError(CE_Failure, CPLE_UserInterrupt, "User terminated");
-                return CE_Failure;
-            }
+/************************************************************************/
+/*                    TakeMultiBandPassStatistics()                     */
+/************************************************************************/
 
-            /* --------------------------------------------------------------------
-             */
-            /*      Save computed information. */
-            /* --------------------------------------------------------------------
-             */
-            if (nValidCount)
-                dfMean = static_cast<double>(nSum) / nValidCount;
+/** Fill the accumulator of GDALRasterBand::ComputeStatistics() from the
+ * GDALMultiBandPass of the calling thread, running it if needed.
+ *
+ * @return false if there is no result for poBand, in which case it must
+ * compute its statistics by itself. bError is set to true if the pass
+ * failed.
+ */
+static bool TakeMultiBandPassStatistics(GDALRasterBand *poBand,
+                                        int nSampleRate,
+                                        GDALIntegralStatsAccumulator *poIntAcc,
+                                        GDALWelfordAccumulator *poAcc,
+                                        bool &bError)
+{
+    bError = false;
+    GDALMultiBandPass *poPass = tlsMultiBandPass;
+    if (!poPass || poPass->bHistogram || poPass->nSampleRate != nSampleRate)
+        return false;
+    const int iBand = poPass->GetBandIndex(poBand);
+    if (iBand < 0)
+        return false;
 
-            // To avoid potential precision issues when doing the difference,
-            // we need to do that computation on 128 bit rather than casting
-            // to double
-            const GDALUInt128 nTmpForStdDev(
-                GDALUInt128::Mul(nSumSquare, nValidCount) -
-                GDALUInt128::Mul(nSum, nSum));
-            const double dfStdDev =
-                nValidCount > 0
-                    ? sqrt(static_cast<double>(nTmpForStdDev)) / nValidCount
-                    : 0.0;
+    if (!poPass->bDone)
+        RunStatisticsPass(*poPass, iBand);
+    if (poPass->bFailed)
+    {
+        bError = true;
+        return true;
+    }
 
-            if (nValidCount > 0)
-            {
-                if (bApproxOK)
-                {
-                    SetMetadataItem("STATISTICS_APPROXIMATE", "YES");
-                }
-                else if (GetMetadataItem("STATISTICS_APPROXIMATE"))
-                {
-                    SetMetadataItem("STATISTICS_APPROXIMATE", nullptr);
-                }
-                SetStatistics(nMin, nMax, dfMean, dfStdDev);
-            }
+    auto &oResult = poPass->aoResults[iBand];
+    if (!oResult.bAvailable || oResult.bIntegral != (poIntAcc != nullptr))
+        return false;
+    oResult.bAvailable = false;
+    if (poIntAcc)
+        *poIntAcc = oResult.oIntegralAcc;
+    else
+        *poAcc = oResult.oAcc;
+    return true;
+}
 
-            SetValidPercent(nSampleCount, nValidCount);
+/************************************************************************/
+/*                          RunHistogramPass()                          */
+/************************************************************************/
 
-            /* --------------------------------------------------------------------
-             */
-            /*      Record results. */
-            /* --------------------------------------------------------------------
-             */
-            if (pdfMin != nullptr)
-                *pdfMin = nValidCount ? nMin : 0;
-            if (pdfMax != nullptr)
-                *pdfMax = nValidCount ? nMax : 0;
+/** Compute the histograms of the bands of oPass from iFirstBand that
+ * cannot be derived from a value histogram.
+ */
+static void RunHistogramPass(GDALMultiBandPass &oPass, size_t iFirstBand)
+{
+    oPass.bDone = true;
 
-            if (pdfMean != nullptr)
-                *pdfMean = dfMean;
+    struct BandState
+    {
+        GDALMultiBandPass::BandResult &oResult;
+        GDALDataType eDataType;
+        GDALNoDataValues sNoDataValues;
+        bool bSignedByte = false;
+        double dfMin = 0;
+        double dfScale = 0;
 
-            if (pdfStdDev != nullptr)
-                *pdfStdDev = dfStdDev;
+        BandState(GDALMultiBandPass::BandResult &oResultIn,
+                  GDALRasterBand *poBand)
+            : oResult(oResultIn), eDataType(poBand->GetRasterDataType()),
+              sNoDataValues(poBand, eDataType)
+        {
+        }
+    };
 
-            if (nValidCount > 0)
-                return CE_None;
+    std::vector<GDALRasterBand *> apoBands;
+    std::vector<std::unique_ptr<BandState>> apoStates;
+    std::vector<GDALRasterBand *> apoMaskBands;
+    for (size_t i = iFirstBand; i < oPass.apoBands.size(); ++i)
+    {
+        GDALMultiBandPass::BandResult &oResult = oPass.aoResults[i];
+        if (!oResult.bRequested || !oResult.anValueHistogram.empty())
+            continue;
 
-            ReportError(CE_Failure, CPLE_AppDefined,
-                        "Failed to compute statistics, no valid pixels found "
-                        "in sampling.");
-            return CE_Failure;
-        }
+        GDALRasterBand *poBand = oPass.apoBands[i];
+        apoBands.push_back(poBand);
+        apoStates.push_back(std::make_unique<BandState>(oResult, poBand));
+        BandState &oState = *(apoStates.back());
+        oState.dfMin = oPass.adfMin[i];
+        oState.dfScale = oPass.nBuckets / (oPass.adfMax[i] - oPass.adfMin[i]);
+        oResult.anHistogram.resize(oPass.nBuckets);
 
-        GByte *pabyMaskData = nullptr;
-        if (poMaskBand)
+        GDALRasterBand *poMaskBand = nullptr;
+        if (!oState.sNoDataValues.bGotNoDataValue)
         {
-            pabyMaskData = static_cast<GByte *>(
-                VSI_MALLOC2_VERBOSE(nBlockXSize, nBlockYSize));
-            if (!pabyMaskData)
+            const int l_nMaskFlags = poBand->GetMaskFlags();
+            if (l_nMaskFlags != GMF_ALL_VALID && l_nMaskFlags != GMF_NODATA &&
+                poBand->GetColorInterpretation() != GCI_AlphaBand)
             {
-                return CE_Failure;
+                poMaskBand = poBand->GetMaskBand();
             }
         }
+        apoMaskBands.push_back(poMaskBand);
 
-        for (GIntBig iSampleBlock = 0;
-             iSampleBlock <
-             static_cast<GIntBig>(nBlocksPerRow) * nBlocksPerColumn;
-             iSampleBlock += nSampleRate)
+        if (oState.eDataType == GDT_Byte)
         {
-            const int iYBlock = static_cast<int>(iSampleBlock / nBlocksPerRow);
-            const int iXBlock = static_cast<int>(iSampleBlock % nBlocksPerRow);
+            poBand->EnablePixelTypeSignedByteWarning(false);
+            const char *pszPixelType =
+                poBand->GetMetadataItem("PIXELTYPE", "IMAGE_STRUCTURE");
+            poBand->EnablePixelTypeSignedByteWarning(true);
+            oState.bSignedByte =
+                pszPixelType != nullptr && EQUAL(pszPixelType, "SIGNEDBYTE");
+        }
+    }
+    if (apoBands.empty())
+        return;
+
+    int nBlockXSize = 0;
+    int nBlockYSize = 0;
+    apoBands[0]->GetBlockSize(&nBlockXSize, &nBlockYSize);
+    const int nBuckets = oPass.nBuckets;
+    const bool bIncludeOutOfRange = oPass.bIncludeOutOfRange;
+    const auto processBandBlock =
+        [&apoStates, nBuckets, bIncludeOutOfRange, nBlockXSize,
+         nBlockYSize](int iBand, const void *pData, const GByte *pabyMaskData,
+                      int nXCheck, int nYCheck)
+    {
+        BandState &oState = *(apoStates[iBand]);
+        ComputeHistogramForBlock(
+            oState.eDataType, oState.bSignedByte, oState.sNoDataValues,
+            oState.dfMin, oState.dfScale, nBuckets, bIncludeOutOfRange, pData,
+            pabyMaskData, nXCheck, nYCheck, nBlockXSize, nBlockYSize,
+            oState.oResult.anHistogram.data());
+    };
 
-            GDALRasterBlock *const poBlock =
-                GetLockedBlockRef(iXBlock, iYBlock);
-            if (poBlock == nullptr)
-            {
-                CPLFree(pabyMaskData);
-                return CE_Failure;
-            }
+    if (ProcessBlocksOfBands(apoBands, apoMaskBands, oPass.nSampleRate,
+                             processBandBlock, "Compute Histogram",
+                             oPass.pfnProgress,
+                             oPass.pProgressData) != CE_None)
+    {
+        oPass.bFailed = true;
+        return;
+    }
 
-            void *const pData = poBlock->GetDataRef();
+    for (auto &poState : apoStates)
+        poState->oResult.bAvailable = true;
+}
 
-            int nXCheck = 0, nYCheck = 0;
-            GetActualBlockSize(iXBlock, iYBlock, &nXCheck, &nYCheck);
+/************************************************************************/
+/*                     TakeMultiBandPassHistogram()                     */
+/************************************************************************/
 
-            if (poMaskBand &&
-                poMaskBand->RasterIO(GF_Read, iXBlock * nBlockXSize,
-                                     iYBlock * nBlockYSize, nXCheck, nYCheck,
-                                     pabyMaskData, nXCheck, nYCheck, GDT_Byte,
-                                     0, nBlockXSize, nullptr) != CE_None)
-            {
-                CPLFree(pabyMaskData);
-                poBlock->DropLock();
-                return CE_Failure;
-            }
+/** Fill the histogram of GDALRasterBand::GetHistogram() from the
+ * GDALMultiBandPass of the calling thread, running it if needed.
+ *
+ * @return false if there is no result for poBand and those parameters, in
+ * which case it must compute its histogram by itself. bError is set to true
+ * if the pass failed.
+ */
+static bool TakeMultiBandPassHistogram(GDALRasterBand *poBand, double dfMin,
+                                       double dfMax, int nBuckets,
+                                       bool bIncludeOutOfRange,
+                                       int nSampleRate, GUIntBig *panHistogram,
+                                       bool &bError)
+{
+    bError = false;
+    GDALMultiBandPass *poPass = tlsMultiBandPass;
+    if (!poPass || !poPass->bHistogram || poPass->nSampleRate != nSampleRate ||
+        poPass->nBuckets != nBuckets ||
+        poPass->bIncludeOutOfRange != bIncludeOutOfRange)
+        return false;
+    const int iBand = poPass->GetBandIndex(poBand);
+    if (iBand < 0 || poPass->adfMin[iBand] != dfMin ||
+        poPass->adfMax[iBand] != dfMax)
+        return false;
+    auto &oResult = poPass->aoResults[iBand];
+    if (!oResult.bRequested)
+        return false;
+
+    if (!oResult.anValueHistogram.empty())
+    {
+        oResult.bRequested = false;
+        RebinValueHistogram(oResult.anValueHistogram,
+                            oResult.dfValueHistogramMin, dfMin,
+                            nBuckets / (dfMax - dfMin), nBuckets,
+                            bIncludeOutOfRange, panHistogram);
+        return true;
+    }
+
+    if (!poPass->bDone)
+        RunHistogramPass(*poPass, iBand);
+    if (poPass->bFailed)
+    {
+        bError = true;
+        return true;
+    }
+    if (!oResult.bAvailable)
+        return false;
+    oResult.bRequested = false;
+    oResult.bAvailable = false;
+    memcpy(panHistogram, oResult.anHistogram.data(),
+           sizeof(GUIntBig) * nBuckets);
+    return true;
+}
+
+/************************************************************************/
+/*                     GetDefaultHistogramBounds()                      */
+/************************************************************************/
+
+/** Returns the bounds of the histogram computed by
+ * GDALRasterBand::GetDefaultHistogram().
+ */
+static bool GetDefaultHistogramBounds(GDALRasterBand *poBand, int nBuckets,
+                                      double &dfMin, double &dfMax)
+{
+    bool bSignedByte = false;
+    if (poBand->GetRasterDataType() == GDT_Byte)
+    {
+        poBand->EnablePixelTypeSignedByteWarning(false);
+        const char *pszPixelType =
+            poBand->GetMetadataItem("PIXELTYPE", "IMAGE_STRUCTURE");
+        poBand->EnablePixelTypeSignedByteWarning(true);
+        bSignedByte =
+            pszPixelType != nullptr && EQUAL(pszPixelType, "SIGNEDBYTE");
+        if (!bSignedByte)
+        {
+            dfMin = -0.5;
+            dfMax = 255.5;
+            return true;
+        }
+    }
 
-            // This isn't the fastest way to do this, but is easier for now.
-            for (int iY = 0; iY < nYCheck; iY++)
-            {
-                for (int iX = 0; iX < nXCheck; iX++)
-                {
-                    const GPtrDiff_t iOffset =
-                        iX + static_cast<GPtrDiff_t>(iY) * nBlockXSize;
-                    if (pabyMaskData && pabyMaskData[iOffset] == 0)
-                        continue;
+    if (poBand->GetStatistics(TRUE, TRUE, &dfMin, &dfMax, nullptr,
+                              nullptr) != CE_None)
+        return false;
+    const double dfHalfBucket = (dfMax - dfMin) / (2 * (nBuckets - 1));
+    dfMin -= dfHalfBucket;
+    dfMax += dfHalfBucket;
+    return true;
+}
 
-                    bool bValid = true;
-                    double dfValue =
-                        GetPixelValue(eDataType, bSignedByte, pData, iOffset,
-                                      sNoDataValues, bValid);
+/************************************************************************/
+/*                   GDALDataset::ComputeStatistics()                   */
+/************************************************************************/
 
-                    if (!bValid)
-                        continue;
+/**
+ * \brief Compute image statistics of several bands.
+ *
+ * This calls GDALRasterBand::ComputeStatistics() on each requested band, so
+ * that the statistics are set on the bands in the same way, and driver
+ * specific implementations are used.
+ *
+ * On pixel-interleaved datasets, the generic implementation reads the
+ * blocks once for all bands, and updates the statistics of all bands
+ * together, instead of decoding each block once per band. This is not done
+ * if bApproxOK is true and the bands have overviews.
+ *
+ * If ppanHistograms is not nullptr, the default histogram of each band, as
+ * returned by GDALRasterBand::GetDefaultHistogram() once its statistics are
+ * computed, is also fetched. For 8 and 16-bit integer bands, it is derived
+ * from counts of each value collected during the same pass over the blocks
+ * as the statistics, when all blocks are read. Histograms of other bands
+ * need a second pass.
+ *
+ * The GDAL_NUM_THREADS configuration option can be set to process the
+ * blocks of the different bands in parallel.
+ *
+ * This method is the same as the C function GDALDatasetComputeStatistics().
+ *
+ * @param bApproxOK If true statistics may be computed based on overviews
+ * or a subset of all tiles.
+ * @param nBandCount Number of bands in panBandMap, or 0 to process all bands.
+ * @param panBandMap Array of nBandCount 1-based band numbers, or nullptr if
+ * nBandCount == 0.
+ * @param padfMin Array of nBandCount (or GetRasterCount() if nBandCount == 0)
+ * values into which to load image minimums (may be nullptr).
+ * @param padfMax Same as padfMin for the maximums (may be nullptr).
+ * @param padfMean Same as padfMin for the means (may be nullptr).
+ * @param padfStdDev Same as padfMin for the standard deviations (may be
+ * nullptr).
+ * @param padfHistMin Same as padfMin for the lower bounds of the default
+ * histograms (must be set if ppanHistograms is set).
+ * @param padfHistMax Same as padfMin for the upper bounds of the default
+ * histograms (must be set if ppanHistograms is set).
+ * @param panHistBuckets Same as padfMin for the number of buckets of the
+ * default histograms (must be set if ppanHistograms is set).
+ * @param ppanHistograms Array of nBandCount pointers set to the default
+ * histograms, allocated with VSIMalloc(), to be freed with VSIFree() by the
+ * caller, or to nullptr for bands for which it could not be computed.
+ * nullptr to only compute statistics.
+ * @param pfnProgress a function to call to report progress, or nullptr.
+ * @param pProgressData application data to pass to the progress function.
+ *
+ * @return CE_None on success, or CE_Failure if an error occurs, processing
+ * is terminated by the user, or no valid pixel is found in one of the bands.
+ *
+ * @since GDAL 3.12
+ */
 
-                    dfMin = std::min(dfMin, dfValue);
-                    dfMax = std::max(dfMax, dfValue);
+CPLErr GDALDataset::ComputeStatistics(
+    bool bApproxOK, int nBandCount, const int *panBandMap, double *padfMin,
+    double *padfMax, double *padfMean, double *padfStdDev, double *padfHistMin,
+    double *padfHistMax, int *panHistBuckets, GUIntBig **ppanHistograms,
+    GDALProgressFunc pfnProgress, void *pProgressData)
+{
+    if (pfnProgress == nullptr)
+        pfnProgress = GDALDummyProgress;
 
-                    nValidCount++;
-                    if (dfMin == dfMax)
-                    {
-                        if (nValidCount == 1)
-                            dfMean = dfMin;
-                    }
-                    else
-                    {
-                        const double dfDelta = dfValue - dfMean;
-                        dfMean += dfDelta / nValidCount;
-                        dfM2 += dfDelta * (dfValue - dfMean);
-                    }
-                }
-            }
+    if (ppanHistograms && !(padfHistMin && padfHistMax && panHistBuckets))
+    {
+        ReportError(CE_Failure, CPLE_IllegalArg,
+                    "ComputeStatistics(): padfHistMin, padfHistMax and "
+                    "panHistBuckets must be set with ppanHistograms");
+        return CE_Failure;
+    }
 
-            nSampleCount += static_cast<GUIntBig>(nXCheck) * nYCheck;
+    std::vector<GDALRasterBand *> apoBands;
+    if (!GetBandMapForStatistics(this, nBandCount, panBandMap,
+                                 "ComputeStatistics", apoBands))
+        return CE_Failure;
+    const int nBandsToProcess = static_cast<int>(apoBands.size());
+    if (ppanHistograms)
+    {
+        for (int i = 0; i < nBandsToProcess; ++i)
+        {
+            padfHistMin[i] = 0;
+            padfHistMax[i] = 0;
+            panHistBuckets[i] = 0;
+            ppanHistograms[i] = nullptr;
+        }
+    }
 
-            poBlock->DropLock();
+    // Statistics take the first half of the progress if histograms are
+    // also computed.
+    const double dfStatsProgressEnd = ppanHistograms ? 0.5 : 1.0;
 
-            if (!pfnProgress(
-                    static_cast<double>(iSampleBlock) /
-                        (static_cast<double>(nBlocksPerRow) * nBlocksPerColumn),
-                    "Compute Statistics", pProgressData))
+    /* -------------------------------------------------------------------- */
+    /*      Compute the statistics of each band, with a single pass over    */
+    /*      the blocks if possible.                                         */
+    /* -------------------------------------------------------------------- */
+    GDALMultiBandPass oPass;
+    const bool bSinglePass = CanUseSinglePassOnBands(this, apoBands, bApproxOK);
+    if (bSinglePass)
+    {
+        oPass.apoBands = apoBands;
+        oPass.aoResults.resize(apoBands.size());
+        oPass.nSampleRate =
+            GetSampleRateForMultiBandPass(apoBands[0], bApproxOK);
+        oPass.bCollectValueHistograms = ppanHistograms != nullptr;
+        oPass.pfnProgress = GDALScaledProgress;
+        oPass.pProgressData = GDALCreateScaledProgress(
+            0.0, dfStatsProgressEnd, pfnProgress, pProgressData);
+    }
+
+    CPLErr eErr = CE_None;
+    bool bStop = false;
+    std::vector<bool> abStatsOK(nBandsToProcess);
+    {
+        GDALMultiBandPassSetter oSetter(bSinglePass ? &oPass : nullptr);
+        for (int i = 0; i < nBandsToProcess && !bStop; ++i)
+        {
+            void *pScaledProgress =
+                bSinglePass ? nullptr
+                            : GDALCreateScaledProgress(
+                                  dfStatsProgressEnd * i / nBandsToProcess,
+                                  dfStatsProgressEnd * (i + 1) /
+                                      nBandsToProcess,
+                                  pfnProgress, pProgressData);
+            double dfMin = 0, dfMax = 0, dfMean = 0, dfStdDev = 0;
+            const CPLErr eBandErr = apoBands[i]->ComputeStatistics(
+                bApproxOK, &dfMin, &dfMax, &dfMean, &dfStdDev,
+                pScaledProgress ? GDALScaledProgress : nullptr,
+                pScaledProgress);
+            GDALDestroyScaledProgress(pScaledProgress);
+            if (padfMin)
+                padfMin[i] = dfMin;
+            if (padfMax)
+                padfMax[i] = dfMax;
+            if (padfMean)
+                padfMean[i] = dfMean;
+            if (padfStdDev)
+                padfStdDev[i] = dfStdDev;
+            abStatsOK[i] = eBandErr == CE_None;
+            if (eBandErr != CE_None)
             {
-                ReportError(CE_Failure, CPLE_UserInterrupt, "User terminated");
-                CPLFree(pabyMaskData);
-                return CE_Failure;
+                eErr = eBandErr;
+                bStop = oPass.bFailed ||
+                        CPLGetLastErrorNo() == CPLE_UserInterrupt;
             }
         }
-
-        CPLFree(pabyMaskData);
     }
+    GDALDestroyScaledProgress(oPass.pProgressData);
 
-    if (!pfnProgress(1.0, "Compute Statistics", pProgressData))
+    if (!ppanHistograms || bStop)
     {
-        ReportError(CE_Failure, CPLE_UserInterrupt, "User terminated");
-        return CE_Failure;
+        if (!bStop && !pfnProgress(1.0, "Compute Statistics", pProgressData))
+        {
+            ReportError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            return CE_Failure;
+        }
+        return eErr;
     }
 
     /* -------------------------------------------------------------------- */
-    /*      Save computed information.                                      */
+    /*      Fetch the default histograms, derived from value histograms, or */
+    /*      computed with a single pass over the blocks if possible.        */
     /* -------------------------------------------------------------------- */
-    const double dfStdDev = nValidCount > 0 ? sqrt(dfM2 / nValidCount) : 0.0;
+    GDALMultiBandPass oHistPass;
+    const bool bHistSinglePass =
+        CanUseSinglePassOnBands(this, apoBands, false);
+    oHistPass.bHistogram = true;
+    oHistPass.apoBands = apoBands;
+    oHistPass.aoResults.resize(apoBands.size());
+    oHistPass.adfMin.resize(apoBands.size());
+    oHistPass.adfMax.resize(apoBands.size());
+    // Same parameters as GDALRasterBand::GetDefaultHistogram()
+    oHistPass.nBuckets = 256;
+    oHistPass.bIncludeOutOfRange = true;
+    // Only value histograms can be used otherwise
+    oHistPass.bDone = !bHistSinglePass;
+    oHistPass.pfnProgress = GDALScaledProgress;
+    oHistPass.pProgressData =
+        GDALCreateScaledProgress(0.5, 1.0, pfnProgress, pProgressData);
+
+    for (int i = 0; i < nBandsToProcess; ++i)
+    {
+        auto &oResult = oHistPass.aoResults[i];
+        oResult.bRequested = false;
+        if (!abStatsOK[i])
+            continue;
 
-    if (nValidCount > 0)
-    {
-        if (bApproxOK)
+        // Histogram already available, for example in the .aux.xml file
+        if (apoBands[i]->GetDefaultHistogram(
+                &padfHistMin[i], &padfHistMax[i], &panHistBuckets[i],
+                &ppanHistograms[i], FALSE, nullptr, nullptr) == CE_None)
         {
-            SetMetadataItem("STATISTICS_APPROXIMATE", "YES");
+            continue;
         }
-        else if (GetMetadataItem("STATISTICS_APPROXIMATE"))
+        VSIFree(ppanHistograms[i]);
+        ppanHistograms[i] = nullptr;
+        panHistBuckets[i] = 0;
+
+        if (GetDefaultHistogramBounds(apoBands[i], oHistPass.nBuckets,
+                                      oHistPass.adfMin[i],
+                                      oHistPass.adfMax[i]))
         {
-            SetMetadataItem("STATISTICS_APPROXIMATE", nullptr);
+            oResult.bRequested = true;
+            if (bSinglePass)
+            {
+                oResult.anValueHistogram =
+                    std::move(oPass.aoResults[i].anValueHistogram);
+                oResult.dfValueHistogramMin =
+                    oPass.aoResults[i].dfValueHistogramMin;
+            }
         }
-        SetStatistics(dfMin, dfMax, dfMean, dfStdDev);
     }
-    else
+
     {
-        dfMin = 0.0;
-        dfMax = 0.0;
+        GDALMultiBandPassSetter oSetter(&oHistPass);
+        for (int i = 0; i < nBandsToProcess; ++i)
+        {
+            if (!abStatsOK[i] || ppanHistograms[i])
+                continue;
+            void *pScaledProgress =
+                bHistSinglePass
+                    ? nullptr
+                    : GDALCreateScaledProgress(
+                          0.5 + 0.5 * i / nBandsToProcess,
+                          0.5 + 0.5 * (i + 1) / nBandsToProcess, pfnProgress,
+                          pProgressData);
+            const CPLErr eBandErr = apoBands[i]->GetDefaultHistogram(
+                &padfHistMin[i], &padfHistMax[i], &panHistBuckets[i],
+                &ppanHistograms[i], TRUE,
+                pScaledProgress ? GDALScaledProgress : nullptr,
+                pScaledProgress);
+            GDALDestroyScaledProgress(pScaledProgress);
+            if (eBandErr != CE_None)
+            {
+                VSIFree(ppanHistograms[i]);
+                ppanHistograms[i] = nullptr;
+                panHistBuckets[i] = 0;
+                eErr = eBandErr;
+                if (oHistPass.bFailed ||
+                    CPLGetLastErrorNo() == CPLE_UserInterrupt)
+                {
+                    bStop = true;
+                    break;
+                }
+            }
+        }
     }
+    GDALDestroyScaledProgress(oHistPass.pProgressData);
 
-    SetValidPercent(nSampleCount, nValidCount);
-
-    /* -------------------------------------------------------------------- */
-    /*      Record results.                                                 */
-    /* -------------------------------------------------------------------- */
-    if (pdfMin != nullptr)
-        *pdfMin = dfMin;
-    if (pdfMax != nullptr)
-        *pdfMax = dfMax;
+    if (!bStop && !pfnProgress(1.0, "Compute Statistics", pProgressData))
+    {
+        ReportError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+        return CE_Failure;
+    }
+    return eErr;
+}
 
-    if (pdfMean != nullptr)
-        *pdfMean = dfMean;
+/************************************************************************/
+/*                    GDALDatasetComputeStatistics()                    */
+/************************************************************************/
 
-    if (pdfStdDev != nullptr)
-        *pdfStdDev = dfStdDev;
+/**
+ * \brief Compute image statistics of several bands.
+ *
+ * @see GDALDataset::ComputeStatistics()
+ * @since GDAL 3.12
+ */
 
-    if (nValidCount > 0)
-        return CE_None;
+CPLErr GDALDatasetComputeStatistics(
+    GDALDatasetH hDS, int bApproxOK, int nBandCount, const int *panBandMap,
+    double *padfMin, double *padfMax, double *padfMean, double *padfStdDev,
+    double *padfHistMin, double *padfHistMax, int *panHistBuckets,
+    GUIntBig **ppanHistograms, GDALProgressFunc pfnProgress,
+    void *pProgressData)
+{
+    VALIDATE_POINTER1(hDS, __func__, CE_Failure);
 
-    ReportError(
-        CE_Failure, CPLE_AppDefined,
-        "Failed to compute statistics, no valid pixels found in sampling.");
-    return CE_Failure;
+    return GDALDataset::FromHandle(hDS)->ComputeStatistics(
+        CPL_TO_BOOL(bApproxOK), nBandCount, panBandMap, padfMin, padfMax,
+        padfMean, padfStdDev, padfHistMin, padfHistMax, panHistBuckets,
+        ppanHistograms, pfnProgress, pProgressData);
 }
 
 /************************************************************************/
-/*                    GDALComputeRasterStatistics()                     */
+/*                     GDALDataset::GetHistogram()                      */
 /************************************************************************/
 
 /**
- * \brief Compute image statistics.
+ * \brief Compute raster histograms of several bands.
  *
- * @see GDALRasterBand::ComputeStatistics()
+ * This calls GDALRasterBand::GetHistogram() on each requested band, so that
+ * driver specific implementations, for example to store the histograms in
+ * the .aux.xml file, are used.
+ *
+ * On pixel-interleaved datasets, the generic implementation reads the
+ * blocks once for all bands, and updates the histograms of all bands
+ * together, instead of decoding each block once per band. This is not done
+ * if bApproxOK is true and the bands have overviews.
+ *
+ * The GDAL_NUM_THREADS configuration option can be set to process the
+ * blocks of the different bands in parallel.
+ *
+ * This method is the same as the C function GDALDatasetGetHistogram().
+ *
+ * @param nBandCount Number of bands in panBandMap, or 0 to process all bands.
+ * @param panBandMap Array of nBandCount 1-based band numbers, or nullptr if
+ * nBandCount == 0.
+ * @param padfMin Array of the lower bound of the histogram of each band.
+ * @param padfMax Array of the upper bound of the histogram of each band.
+ * @param nBuckets the number of buckets of each histogram.
+ * @param ppanHistograms Array of nBandCount (or GetRasterCount() if
+ * nBandCount == 0) arrays of nBuckets values into which the histogram
+ * totals are placed.
+ * @param bIncludeOutOfRange if true values below the histogram range will
+ * mapped into the first bucket, and values above will be mapped into
+ * the last bucket, otherwise out of range values are discarded.
+ * @param bApproxOK true if an approximate, or incomplete histogram OK.
+ * @param pfnProgress function to report progress to completion.
+ * @param pProgressData application data to pass to pfnProgress.
+ *
+ * @return CE_None on success, or CE_Failure if something goes wrong.
+ *
+ * @since GDAL 3.12
  */
 
-CPLErr CPL_STDCALL GDALComputeRasterStatistics(GDALRasterBandH hBand,
-                                               int bApproxOK, double *pdfMin,
-                                               double *pdfMax, double *pdfMean,
-                                               double *pdfStdDev,
-                                               GDALProgressFunc pfnProgress,
-                                               void *pProgressData)
-
+CPLErr GDALDataset::GetHistogram(int nBandCount, const int *panBandMap,
+                                 const double *padfMin, const double *padfMax,
+                                 int nBuckets, GUIntBig **ppanHistograms,
+                                 bool bIncludeOutOfRange, bool bApproxOK,
+                                 GDALProgressFunc pfnProgress,
+                                 void *pProgressData)
 {
-    VALIDATE_POINTER1(hBand, "GDALComputeRasterStatistics", CE_Failure);
+    if (pfnProgress == nullptr)
+        pfnProgress = GDALDummyProgress;
 
-    GDALRasterBand *poBand = GDALRasterBand::FromHandle(hBand);
+    std::vector<GDALRasterBand *> apoBands;
+    if (!GetBandMapForStatistics(this, nBandCount, panBandMap, "GetHistogram",
+                                 apoBands))
+        return CE_Failure;
+    const int nBandsToProcess = static_cast<int>(apoBands.size());
 
-    return poBand->ComputeStatistics(bApproxOK, pdfMin, pdfMax, pdfMean,
-                                     pdfStdDev, pfnProgress, pProgressData);
+    /* -------------------------------------------------------------------- */
+    /*      Set up a single pass over the blocks if possible.               */
+    /* -------------------------------------------------------------------- */
+    GDALMultiBandPass oPass;
+    bool bSinglePass = CanUseSinglePassOnBands(this, apoBands, bApproxOK);
+    for (int i = 0; bSinglePass && i < nBandsToProcess; ++i)
+    {
+        // Invalid bounds are reported by GDALRasterBand::GetHistogram()
+        const double dfScale = nBuckets / (padfMax[i] - padfMin[i]);
+        bSinglePass = padfMax[i] > padfMin[i] && dfScale != 0 &&
+                      std::isfinite(dfScale);
+    }
+    if (bSinglePass)
+    {
+        oPass.bHistogram = true;
+        oPass.apoBands = apoBands;
+        oPass.aoResults.resize(apoBands.size());
+        oPass.adfMin.assign(padfMin, padfMin + nBandsToProcess);
+        oPass.adfMax.assign(padfMax, padfMax + nBandsToProcess);
+        oPass.nBuckets = nBuckets;
+        oPass.bIncludeOutOfRange = bIncludeOutOfRange;
+        oPass.nSampleRate =
+            GetSampleRateForMultiBandPass(apoBands[0], bApproxOK);
+        oPass.pfnProgress = pfnProgress;
+        oPass.pProgressData = pProgressData;
+    }
+
+    GDALMultiBandPassSetter oSetter(bSinglePass ? &oPass : nullptr);
+    for (int i = 0; i < nBandsToProcess; ++i)
+    {
+        void *pScaledProgress =
+            bSinglePass
+                ? nullptr
+                : GDALCreateScaledProgress(
+                      static_cast<double>(i) / nBandsToProcess,
+                      static_cast<double>(i + 1) / nBandsToProcess,
+                      pfnProgress, pProgressData);
+        const CPLErr eErr = apoBands[i]->GetHistogram(
+            padfMin[i], padfMax[i], nBuckets, ppanHistograms[i],
+            bIncludeOutOfRange, bApproxOK,
+            pScaledProgress ? GDALScaledProgress : nullptr, pScaledProgress);
+        GDALDestroyScaledProgress(pScaledProgress);
+        if (eErr != CE_None)
+            return eErr;
+    }
+
+    pfnProgress(1.0, "Compute Histogram", pProgressData);
+
+    return CE_None;
+}
+
+/************************************************************************/
+/*                      GDALDatasetGetHistogram()                       */
+/************************************************************************/
+
+/**
+ * \brief Compute raster histograms of several bands.
+ *
+ * @see GDALDataset::GetHistogram()
+ * @since GDAL 3.12
+ */
+
+CPLErr GDALDatasetGetHistogram(GDALDatasetH hDS, int nBandCount,
+                               const int *panBandMap, const double *padfMin,
+                               const double *padfMax, int nBuckets,
+                               GUIntBig **ppanHistograms,
+                               int bIncludeOutOfRange, int bApproxOK,
+                               GDALProgressFunc pfnProgress,
+                               void *pProgressData)
+{
+    VALIDATE_POINTER1(hDS, __func__, CE_Failure);
+    VALIDATE_POINTER1(padfMin, __func__, CE_Failure);
+    VALIDATE_POINTER1(padfMax, __func__, CE_Failure);
+    VALIDATE_POINTER1(ppanHistograms, __func__, CE_Failure);
+
+    return GDALDataset::FromHandle(hDS)->GetHistogram(
+        nBandCount, panBandMap, padfMin, padfMax, nBuckets, ppanHistograms,
+        CPL_TO_BOOL(bIncludeOutOfRange), CPL_TO_BOOL(bApproxOK), pfnProgress,
+        pProgressData);
 }
 
 /************************************************************************/
@@ -7269,66 +8884,37 @@ static void ComputeMinMaxGeneric(const void *pData, GDALDataType eDataType,
     }
 }
 
-static bool ComputeMinMaxGenericIterBlocks(
-    GDALRasterBand *poBand, GDALDataType eDataType, bool bSignedByte,
-    GIntBig nTotalBlocks, int nSampleRate, int nBlocksPerRow,
-    const GDALNoDataValues &sNoDataValues, GDALRasterBand *poMaskBand,
-    double &dfMin, double &dfMax)
-
+namespace
 {
-    GByte *pabyMaskData = nullptr;
-    int nBlockXSize, nBlockYSize;
-    poBand->GetBlockSize(&nBlockXSize, &nBlockYSize);
+struct GDALMinMaxAccumulator
+{
+    GUInt32 nMin;     // used for GByte & GUInt16 cases
+    GUInt32 nMax = 0;  // used for GByte & GUInt16 cases
+    GInt16 nMinInt16 =
+        std::numeric_limits<GInt16>::max();  // used for GInt16 case
+    GInt16 nMaxInt16 =
+        std::numeric_limits<GInt16>::lowest();  // used for GInt16 case
+    double dfMin =
+        std::numeric_limits<double>::infinity();  // used for generic code path
+    double dfMax =
+        -std::numeric_limits<double>::infinity();  // used for generic code path
 
-    if (poMaskBand)
+    explicit GDALMinMaxAccumulator(GDALDataType eDataType)
+        : nMin(eDataType == GDT_Byte ? 255 : 65535)
     {
-        pabyMaskData =
-            static_cast<GByte *>(VSI_MALLOC2_VERBOSE(nBlockXSize, nBlockYSize));
-        if (!pabyMaskData)
-        {
-            return false;
-        }
     }
 
-    for (GIntBig iSampleBlock = 0; iSampleBlock < nTotalBlocks;
-         iSampleBlock += nSampleRate)
+    void Merge(const GDALMinMaxAccumulator &other)
     {
-        const int iYBlock = static_cast<int>(iSampleBlock / nBlocksPerRow);
-        const int iXBlock = static_cast<int>(iSampleBlock % nBlocksPerRow);
-
-        GDALRasterBlock *poBlock = poBand->GetLockedBlockRef(iXBlock, iYBlock);
-        if (poBlock == nullptr)
-        {
-            CPLFree(pabyMaskData);
-            return false;
-        }
-
-        void *const pData = poBlock->GetDataRef();
-
-        int nXCheck = 0, nYCheck = 0;
-        poBand->GetActualBlockSize(iXBlock, iYBlock, &nXCheck, &nYCheck);
-
-        if (poMaskBand &&
-            poMaskBand->RasterIO(GF_Read, iXBlock * nBlockXSize,
-                                 iYBlock * nBlockYSize, nXCheck, nYCheck,
-                                 pabyMaskData, nXCheck, nYCheck, GDT_Byte, 0,
-                                 nBlockXSize, nullptr) != CE_None)
-        {
-            poBlock->DropLock();
-            CPLFree(pabyMaskData);
-            return false;
-        }
-
-        ComputeMinMaxGeneric(pData, eDataType, bSignedByte, nXCheck, nYCheck,
-                             nBlockXSize, sNoDataValues, pabyMaskData, dfMin,
-                             dfMax);
-
-        poBlock->DropLock();
+        nMin = std::min(nMin, other.nMin);
+        nMax = std::max(nMax, other.nMax);
+        nMinInt16 = std::min(nMinInt16, other.nMinInt16);
+        nMaxInt16 = std::max(nMaxInt16, other.nMaxInt16);
+        dfMin = std::min(dfMin, other.dfMin);
+        dfMax = std::max(dfMax, other.dfMax);
     }
-
-    CPLFree(pabyMaskData);
-    return true;
-}
+};
+}  // namespace
 
 /**
  * \brief Compute the min/max values for a band.
@@ -7341,6 +8927,10 @@ static bool ComputeMinMaxGenericIterBlocks(
  * If bApprox is FALSE, then all pixels will be read and used to compute
  * an exact range.
  *
+ * Starting with GDAL 3.12, the GDAL_NUM_THREADS configuration option can be
+ * set to an integer or ALL_CPUS to process the content of blocks in several
+ * threads, while they are read by the calling thread.
+ *
  * This method is the same as the C function GDALComputeRasterMinMax().
  *
  * @param bApproxOK TRUE if an approximate (faster) answer is OK, otherwise
@@ -7414,26 +9004,15 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
     GDALRasterIOExtraArg sExtraArg;
     INIT_RASTERIO_EXTRA_ARG(sExtraArg);
 
-    GUInt32 nMin = (eDataType == GDT_Byte)
-                       ? 255
-                       : 65535;  // used for GByte & GUInt16 cases
-    GUInt32 nMax = 0;            // used for GByte & GUInt16 cases
-    GInt16 nMinInt16 =
-        std::numeric_limits<GInt16>::max();  // used for GInt16 case
-    GInt16 nMaxInt16 =
-        std::numeric_limits<GInt16>::lowest();  // used for GInt16 case
-    double dfMin =
-        std::numeric_limits<double>::infinity();  // used for generic code path
-    double dfMax =
-        -std::numeric_limits<double>::infinity();  // used for generic code path
+    GDALMinMaxAccumulator oAcc(eDataType);
     const bool bUseOptimizedPath =
         !poMaskBand && ((eDataType == GDT_Byte && !bSignedByte) ||
                         eDataType == GDT_Int16 || eDataType == GDT_UInt16);
 
     const auto ComputeMinMaxForBlock =
-        [this, bSignedByte, &sNoDataValues, &nMin, &nMax, &nMinInt16,
-         &nMaxInt16](const void *pData, int nXCheck, int nBufferWidth,
-                     int nYCheck)
+        [this, bSignedByte,
+         &sNoDataValues](const void *pData, int nXCheck, int nBufferWidth,
+                         int nYCheck, GDALMinMaxAccumulator &oBlockAcc)
     {
         if (eDataType == GDT_Byte && !bSignedByte)
         {
@@ -7450,7 +9029,8 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
                                       /* COMPUTE_OTHER_STATS = */ false>::
                 f(nXCheck, nBufferWidth, nYCheck,
                   static_cast<const GByte *>(pData), bHasNoData, nNoDataValue,
-                  nMin, nMax, nSum, nSumSquare, nSampleCount, nValidCount);
+                  oBlockAcc.nMin, oBlockAcc.nMax, nSum, nSumSquare,
+                  nSampleCount, nValidCount);
         }
         else if (eDataType == GDT_UInt16)
         {
@@ -7467,7 +9047,8 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
                                       /* COMPUTE_OTHER_STATS = */ false>::
                 f(nXCheck, nBufferWidth, nYCheck,
                   static_cast<const GUInt16 *>(pData), bHasNoData, nNoDataValue,
-                  nMin, nMax, nSum, nSumSquare, nSampleCount, nValidCount);
+                  oBlockAcc.nMin, oBlockAcc.nMax, nSum, nSumSquare,
+                  nSampleCount, nValidCount);
         }
         else if (eDataType == GDT_Int16)
         {
@@ -7485,7 +9066,8 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
                     ComputeMinMax<int16_t, true>(
                         static_cast<const int16_t *>(pData) +
                             static_cast<size_t>(iY) * nBufferWidth,
-                        nXCheck, nNoDataValue, &nMinInt16, &nMaxInt16);
+                        nXCheck, nNoDataValue, &oBlockAcc.nMinInt16,
+                        &oBlockAcc.nMaxInt16);
                 }
             }
             else
@@ -7495,7 +9077,8 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
                     ComputeMinMax<int16_t, false>(
                         static_cast<const int16_t *>(pData) +
                             static_cast<size_t>(iY) * nBufferWidth,
-                        nXCheck, 0, &nMinInt16, &nMaxInt16);
+                        nXCheck, 0, &oBlockAcc.nMinInt16,
+                        &oBlockAcc.nMaxInt16);
                 }
             }
         }
@@ -7561,13 +9144,14 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
 
         if (bUseOptimizedPath)
         {
-            ComputeMinMaxForBlock(pData, nXReduced, nXReduced, nYReduced);
+            ComputeMinMaxForBlock(pData, nXReduced, nXReduced, nYReduced,
+                                  oAcc);
         }
         else
         {
             ComputeMinMaxGeneric(pData, eDataType, bSignedByte, nXReduced,
                                  nYReduced, nXReduced, sNoDataValues,
-                                 pabyMaskData, dfMin, dfMax);
+                                 pabyMaskData, oAcc.dfMin, oAcc.dfMax);
         }
 
         CPLFree(pData);
@@ -7599,60 +9183,68 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
                 nSampleRate += 1;
         }
 
+        const auto progress = [](GIntBig) { return true; };
+        bool bInterrupted = false;
+        CPLErr eErr;
         if (bUseOptimizedPath)
         {
-            for (GIntBig iSampleBlock = 0;
-                 iSampleBlock <
-                 static_cast<GIntBig>(nBlocksPerRow) * nBlocksPerColumn;
-                 iSampleBlock += nSampleRate)
-            {
-                const int iYBlock =
-                    static_cast<int>(iSampleBlock / nBlocksPerRow);
-                const int iXBlock =
-                    static_cast<int>(iSampleBlock % nBlocksPerRow);
-
-                GDALRasterBlock *poBlock = GetLockedBlockRef(iXBlock, iYBlock);
-                if (poBlock == nullptr)
-                    return CE_Failure;
-
-                void *const pData = poBlock->GetDataRef();
-
-                int nXCheck = 0, nYCheck = 0;
-                GetActualBlockSize(iXBlock, iYBlock, &nXCheck, &nYCheck);
-
-                ComputeMinMaxForBlock(pData, nXCheck, nBlockXSize, nYCheck);
-
-                poBlock->DropLock();
-
-                if (eDataType == GDT_Byte && !bSignedByte && nMin == 0 &&
-                    nMax == 255)
-                    break;
-            }
+            eErr = ProcessSampledBlocks(
+                this, nSampleRate, nullptr, /* bOrderedMerge = */ false, oAcc,
+                [&ComputeMinMaxForBlock](const void *pData, const GByte *,
+                                         int nXCheck, int nYCheck,
+                                         int nLineStride,
+                                         GDALMinMaxAccumulator &oBlockAcc)
+                {
+                    ComputeMinMaxForBlock(pData, nXCheck, nLineStride,
+                                          nYCheck, oBlockAcc);
+                },
+                progress,
+                [this, bSignedByte](const GDALMinMaxAccumulator &oCurAcc)
+                {
+                    // Stop once the whole range of the data type is reached
+                    return ((eDataType == GDT_Byte && !bSignedByte &&
+                             oCurAcc.nMax == 255) ||
+                            (eDataType == GDT_UInt16 &&
+                             oCurAcc.nMax == 65535)) &&
+                           oCurAcc.nMin == 0;
+                },
+                &bInterrupted);
         }
         else
         {
-            const GIntBig nTotalBlocks =
-                static_cast<GIntBig>(nBlocksPerRow) * nBlocksPerColumn;
-            if (!ComputeMinMaxGenericIterBlocks(
-                    this, eDataType, bSignedByte, nTotalBlocks, nSampleRate,
-                    nBlocksPerRow, sNoDataValues, poMaskBand, dfMin, dfMax))
-            {
-                return CE_Failure;
-            }
+            eErr = ProcessSampledBlocks(
+                this, nSampleRate, poMaskBand, /* bOrderedMerge = */ false,
+                oAcc,
+                [this, bSignedByte, &sNoDataValues](
+                    const void *pData, const GByte *pabyMaskData, int nXCheck,
+                    int nYCheck, int nLineStride,
+                    GDALMinMaxAccumulator &oBlockAcc)
+                {
+                    ComputeMinMaxGeneric(pData, eDataType, bSignedByte,
+                                         nXCheck, nYCheck, nLineStride,
+                                         sNoDataValues, pabyMaskData,
+                                         oBlockAcc.dfMin, oBlockAcc.dfMax);
+                },
+                progress, /* canStop = */ nullptr,
+                &bInterrupted);
         }
+        if (eErr != CE_None)
+            return CE_Failure;
     }
 
+    double dfMin = oAcc.dfMin;
+    double dfMax = oAcc.dfMax;
     if (bUseOptimizedPath)
     {
         if ((eDataType == GDT_Byte && !bSignedByte) || eDataType == GDT_UInt16)
         {
-            dfMin = nMin;
-            dfMax = nMax;
+            dfMin = oAcc.nMin;
+            dfMax = oAcc.nMax;
         }
         else if (eDataType == GDT_Int16)
         {
-            dfMin = nMinInt16;
-            dfMax = nMaxInt16;
+            dfMin = oAcc.nMinInt16;
+            dfMax = oAcc.nMaxInt16;
         }
     }
 
@@ -17,9 +17,14 @@
 #include "gdal_priv.h"
 
 #include <algorithm>
+#include <atomic>
 #include <climits>
 #include <cstring>
+#include <deque>
+#include <functional>
+#include <memory>
 #include <mutex>
+#include <unordered_map>
 
 #include "cpl_atomic_ops.h"
 #include "cpl_conv.h"
@@ -30,21 +35,211 @@
 
 // Will later be overridden by the default 5% if GDAL_CACHEMAX not defined.
 static GIntBig nCacheMax = 40 * 1024 * 1024;
-static GIntBig nCacheUsed = 0;
 
-static GDALRasterBlock *poOldest = nullptr;  // Tail.
-static GDALRasterBlock *poNewest = nullptr;  // Head.
+constexpr int MAX_CACHE_SHARDS = 256;
 
-static int nDisableDirtyBlockFlushCounter = 0;
+// Lists in which a block may be stored (value of GDALRasterBlock::nCacheList)
+// With the LRU policy, only CACHE_LIST_MAIN is used.
+// With the 2Q policy, CACHE_LIST_MAIN is the "Am" LRU list of blocks that have
+// been referenced again after having been evicted from the "A1in" FIFO list of
+// blocks loaded once (CACHE_LIST_A1IN).
+constexpr int CACHE_LIST_MAIN = 0;
+constexpr int CACHE_LIST_A1IN = 1;
 
-#if 0
-static CPLMutex *hRBLock = nullptr;
-#define INITIALIZE_LOCK CPLMutexHolderD(&hRBLock)
-#define TAKE_LOCK CPLMutexHolderOptionalLockD(hRBLock)
-#define DESTROY_LOCK CPLDestroyMutex(hRBLock)
-#else
+// 2Q tuning: maximum size of A1in, and of the ghost A1out list, as a ratio
+// of the cache size. Values suggested in the 2Q paper by Johnson & Shasha.
+constexpr int TWO_Q_A1IN_PERCENT = 25;
+constexpr int TWO_Q_A1OUT_PERCENT = 50;
+
+namespace
+{
+/************************************************************************/
+/*                        GDALRasterBlockCacheKey                       */
+/************************************************************************/
+
+struct GDALRasterBlockCacheKey
+{
+    const GDALRasterBand *poBand;
+    int nXOff;
+    int nYOff;
+
+    bool operator==(const GDALRasterBlockCacheKey &other) const
+    {
+        return poBand == other.poBand && nXOff == other.nXOff &&
+               nYOff == other.nYOff;
+    }
+};
+
+struct GDALRasterBlockCacheKeyHasher
+{
+    size_t operator()(const GDALRasterBlockCacheKey &oKey) const
+    {
+        // Mix the band pointer with the block coordinates
+        // (boost::hash_combine like)
+        size_t nHash = std::hash<const void *>()(oKey.poBand);
+        nHash ^= static_cast<size_t>(oKey.nYOff) + 0x9e3779b9U +
+                 (nHash << 6) + (nHash >> 2);
+        nHash ^= static_cast<size_t>(oKey.nXOff) + 0x9e3779b9U +
+                 (nHash << 6) + (nHash >> 2);
+        return nHash;
+    }
+};
+
+// Entry of the 2Q "A1out" ghost list
+struct GDALRasterBlockCacheGhost
+{
+    GDALRasterBlockCacheKey oKey;
+    // Sequence number, so that stale FIFO entries can be recognized.
+    GUIntBig nId;
+    size_t nSize;
+};
+
+/************************************************************************/
+/*                     GDALRasterBlockCacheGhostList                    */
+/************************************************************************/
+
+// 2Q "A1out" ghost list: keys of the blocks recently evicted from the A1in
+// list.
+struct GDALRasterBlockCacheGhostList
+{
+    std::deque<GDALRasterBlockCacheGhost> aoFIFO{};
+    std::unordered_map<GDALRasterBlockCacheKey, GUIntBig,
+                       GDALRasterBlockCacheKeyHasher>
+        oMap{};
+    GIntBig nCacheUsed = 0;
+    GUIntBig nCounter = 0;
+};
+
+/************************************************************************/
+/*                        GDALRasterBlockCacheList                      */
+/************************************************************************/
+
+struct GDALRasterBlockCacheList
+{
+    GDALRasterBlock *poOldest = nullptr;  // Tail.
+    GDALRasterBlock *poNewest = nullptr;  // Head.
+};
+
+/************************************************************************/
+/*                       GDALRasterBlockCacheShard                      */
+/************************************************************************/
+
+// The global block cache is made of one or several shards (see
+// GDAL_BLOCK_CACHE_SHARDS). Each shard has its own lock, block lists and
+// memory budget, so that threads working on blocks belonging to different
+// shards do not contend on the same lock.
+struct alignas(64) GDALRasterBlockCacheShard
+{
+    CPLLock *hLock = nullptr;
+    GDALRasterBlockCacheList aoLists[2]{};
+    GIntBig nCacheUsed = 0;
+    GIntBig nA1InCacheUsed = 0;
+
+    // 2Q "A1out" ghost list. Only allocated once a block is evicted from
+    // the A1in list, that is never with the LRU policy.
+    std::unique_ptr<GDALRasterBlockCacheGhostList> poGhosts{};
+
+    // Blocks of the shard, per dataset, in order of age (linked through
+    // GDALRasterBlock::poDatasetNext/poDatasetPrevious), so that a dataset
+    // above its quota can find its eviction candidates without walking
+    // the blocks of other datasets.
+    std::unordered_map<const GDALDataset *, GDALRasterBlockCacheList>
+        oMapDatasetLists{};
+
+    // Statistics
+    std::atomic<GIntBig> nHits{0};
+    std::atomic<GIntBig> nMisses{0};
+    std::atomic<GIntBig> nEvictions{0};
+
+    // Returns the list from which eviction candidates must be looked for
+    // first.
+    int GetFirstEvictionList(GIntBig nShardCacheMax) const
+    {
+        return nA1InCacheUsed > nShardCacheMax / 100 * TWO_Q_A1IN_PERCENT
+                   ? CACHE_LIST_A1IN
+                   : CACHE_LIST_MAIN;
+    }
+
+    GDALRasterBlock *GetFirstEvictionCandidate(int iFirstList) const
+    {
+        GDALRasterBlock *poBlock = aoLists[iFirstList].poOldest;
+        return poBlock ? poBlock : aoLists[1 - iFirstList].poOldest;
+    }
+
+    // poPrevious and nList are the members of the current candidate
+    GDALRasterBlock *GetNextEvictionCandidate(GDALRasterBlock *poPrevious,
+                                              int nList, int iFirstList) const
+    {
+        if (poPrevious)
+            return poPrevious;
+        return nList == iFirstList ? aoLists[1 - iFirstList].poOldest
+                                   : nullptr;
+    }
+
+    void RecordEviction(const GDALRasterBlockCacheKey &oKey, int nList,
+                        size_t nSize, GIntBig nShardCacheMax);
+
+    bool RemoveGhost(const GDALRasterBlockCacheKey &oKey);
+};
+
+/************************************************************************/
+/*                           RecordEviction()                           */
+/************************************************************************/
+
+void GDALRasterBlockCacheShard::RecordEviction(
+    const GDALRasterBlockCacheKey &oKey, int nList, size_t nSize,
+    GIntBig nShardCacheMax)
+{
+    nEvictions.fetch_add(1, std::memory_order_relaxed);
+    if (nList != CACHE_LIST_A1IN)
+        return;
+
+    // Remember the key in the A1out list, so that if it is referenced
+    // again, it goes to the Am list.
+    if (!poGhosts)
+        poGhosts = std::make_unique<GDALRasterBlockCacheGhostList>();
+    const GUIntBig nId = ++poGhosts->nCounter;
+    poGhosts->oMap[oKey] = nId;
+    poGhosts->aoFIFO.push_back(GDALRasterBlockCacheGhost{oKey, nId, nSize});
+    poGhosts->nCacheUsed += nSize;
+
+    const GIntBig nGhostCacheMax = nShardCacheMax / 100 * TWO_Q_A1OUT_PERCENT;
+    while (poGhosts->nCacheUsed > nGhostCacheMax && !poGhosts->aoFIFO.empty())
+    {
+        const auto &oOldest = poGhosts->aoFIFO.front();
+        const auto oIter = poGhosts->oMap.find(oOldest.oKey);
+        if (oIter != poGhosts->oMap.end() && oIter->second == oOldest.nId)
+            poGhosts->oMap.erase(oIter);
+        poGhosts->nCacheUsed -= oOldest.nSize;
+        poGhosts->aoFIFO.pop_front();
+    }
+}
+
+/************************************************************************/
+/*                            RemoveGhost()                             */
+/************************************************************************/
+
+// Returns true if the key was in the A1out list.
+bool GDALRasterBlockCacheShard::RemoveGhost(const GDALRasterBlockCacheKey &oKey)
+{
+    // Entries of aoFIFO are not removed, and will be skipped when reaching
+    // the front of the FIFO.
+    return poGhosts && poGhosts->oMap.erase(oKey) != 0;
+}
+
+}  // namespace
+
+// Shards are only allocated when GDAL_BLOCK_CACHE_SHARDS > 1. Otherwise
+// pasCacheShards points to sDefaultCacheShard.
+static GDALRasterBlockCacheShard sDefaultCacheShard;
+static std::unique_ptr<GDALRasterBlockCacheShard[]> pasAllocatedCacheShards;
+static GDALRasterBlockCacheShard *pasCacheShards = &sDefaultCacheShard;
+static int nCacheShards = 1;
+static bool bUse2QPolicy = false;
+static std::atomic<unsigned> nFlushCacheBlockShardCounter{0};
+
+static int nDisableDirtyBlockFlushCounter = 0;
 
-static CPLLock *hRBLock = nullptr;
 static bool bDebugContention = false;
 static bool bSleepsForBockCacheDebug = false;
 
@@ -75,13 +270,76 @@ static CPLLockType GetLockType()
     return static_cast<CPLLockType>(nLockType);
 }
 
-#define INITIALIZE_LOCK                                                        \
-    CPLLockHolderD(&hRBLock, GetLockType());                                   \
-    CPLLockSetDebugPerf(hRBLock, bDebugContention)
-#define TAKE_LOCK CPLLockHolderOptionalLockD(hRBLock)
-#define DESTROY_LOCK CPLDestroyLock(hRBLock)
+#define INITIALIZE_LOCK(psShard)                                               \
+    CPLLockHolderD(&((psShard)->hLock), GetLockType());                        \
+    CPLLockSetDebugPerf((psShard)->hLock, bDebugContention)
+#define TAKE_LOCK(psShard) CPLLockHolderOptionalLockD((psShard)->hLock)
+#define DESTROY_LOCK(psShard) CPLDestroyLock((psShard)->hLock)
 
-#endif
+/************************************************************************/
+/*                          InitializeLocks()                           */
+/************************************************************************/
+
+static void InitializeLocks()
+{
+    for (int i = 0; i < nCacheShards; ++i)
+    {
+        INITIALIZE_LOCK(&pasCacheShards[i]);
+    }
+}
+
+/************************************************************************/
+/*                          GetCacheShard()                             */
+/************************************************************************/
+
+// Returns the index of the shard in which the block must be stored.
+// Blocks of a same band are spread over all shards.
+static int GetCacheShard(const GDALRasterBlockCacheKey &oKey)
+{
+    if (nCacheShards == 1)
+        return 0;
+    return static_cast<int>(GDALRasterBlockCacheKeyHasher()(oKey) %
+                            static_cast<size_t>(nCacheShards));
+}
+
+/************************************************************************/
+/*                         GetShardCacheMax()                           */
+/************************************************************************/
+
+// Returns the memory budget of a single shard.
+static GIntBig GetShardCacheMax(GIntBig nCurCacheMax)
+{
+    return nCacheShards == 1
+               ? nCurCacheMax
+               : std::max<GIntBig>(1, nCurCacheMax / nCacheShards);
+}
+
+/************************************************************************/
+/*                          GetCacheUsed()                              */
+/************************************************************************/
+
+static GIntBig GetCacheUsed()
+{
+    GIntBig nCacheUsed = 0;
+    for (int i = 0; i < nCacheShards; ++i)
+        nCacheUsed += pasCacheShards[i].nCacheUsed;
+    return nCacheUsed;
+}
+
+/************************************************************************/
+/*                        GetEffectiveBlockSize()                       */
+/************************************************************************/
+
+static size_t GetEffectiveBlockSize(GPtrDiff_t nBlockSize)
+{
+    // The real cost of a block allocation is more than just nBlockSize
+    // As we allocate with 64-byte alignment, use 64 as a multiple.
+    // We arbitrarily add 2 * sizeof(GDALRasterBlock) to account for that
+    return static_cast<size_t>(
+        std::min(static_cast<GUIntBig>(UINT_MAX),
+                 static_cast<GUIntBig>(DIV_ROUND_UP(nBlockSize, 64)) * 64 +
+                     2 * sizeof(GDALRasterBlock)));
+}
 
 // #define ENABLE_DEBUG
 
@@ -146,13 +404,13 @@ void CPL_STDCALL GDALSetCacheMax64(GIntBig nNewSizeInBytes)
     /*      Flush blocks till we are under the new limit or till we         */
     /*      can't seem to flush anymore.                                    */
     /* -------------------------------------------------------------------- */
-    while (nCacheUsed > nCacheMax)
+    while (GetCacheUsed() > nCacheMax)
     {
-        const GIntBig nOldCacheUsed = nCacheUsed;
+        const GIntBig nOldCacheUsed = GetCacheUsed();
 
         GDALFlushCacheBlock();
 
-        if (nCacheUsed == nOldCacheUsed)
+        if (GetCacheUsed() == nOldCacheUsed)
             break;
     }
 }
@@ -221,9 +479,39 @@ GIntBig CPL_STDCALL GDALGetCacheMax64()
         flagSetupGDALGetCacheMax64,
         []()
         {
+            const char *pszCacheShards =
+                CPLGetConfigOption("GDAL_BLOCK_CACHE_SHARDS", "1");
+            const int nRequestedShards = EQUAL(pszCacheShards, "ALL_CPUS")
+                                             ? CPLGetNumCPUs()
+                                             : atoi(pszCacheShards);
+            const int nShards =
+                std::clamp(nRequestedShards, 1, MAX_CACHE_SHARDS);
+            if (nShards > 1)
             {
-                INITIALIZE_LOCK;
+                CPLDebug("GDAL", "Using %d block cache shards", nShards);
+                pasAllocatedCacheShards.reset(
+                    new GDALRasterBlockCacheShard[nShards]);
+                pasCacheShards = pasAllocatedCacheShards.get();
+                nCacheShards = nShards;
             }
+
+            const char *pszCachePolicy =
+                CPLGetConfigOption("GDAL_BLOCK_CACHE_POLICY", "LRU");
+            if (EQUAL(pszCachePolicy, "2Q"))
+            {
+                bUse2QPolicy = true;
+                CPLDebug("GDAL", "Using 2Q block cache policy");
+            }
+            else if (!EQUAL(pszCachePolicy, "LRU"))
+            {
+                CPLError(CE_Warning, CPLE_NotSupported,
+                         "GDAL_BLOCK_CACHE_POLICY=%s not supported. "
+                         "Falling back to LRU",
+                         pszCachePolicy);
+            }
+
+            InitializeLocks();
+
             bSleepsForBockCacheDebug =
                 CPLTestBool(CPLGetConfigOption("GDAL_DEBUG_BLOCK_CACHE", "NO"));
 
@@ -272,6 +560,7 @@ GIntBig CPL_STDCALL GDALGetCacheMax64()
 
 int CPL_STDCALL GDALGetCacheUsed()
 {
+    const GIntBig nCacheUsed = GetCacheUsed();
     if (nCacheUsed > INT_MAX)
     {
         CPLErrorOnce(CE_Warning, CPLE_AppDefined,
@@ -297,7 +586,71 @@ int CPL_STDCALL GDALGetCacheUsed()
 
 GIntBig CPL_STDCALL GDALGetCacheUsed64()
 {
-    return nCacheUsed;
+    return GetCacheUsed();
+}
+
+/************************************************************************/
+/*                       GDALGetCacheStatistics()                       */
+/************************************************************************/
+
+/**
+ * \brief Get statistics about the use of the block cache.
+ *
+ * A hit is counted each time a block is found in the cache. A miss is counted
+ * each time a block must be added to the cache (and generally read from
+ * its dataset). An eviction is counted each time a block is removed from the
+ * cache to release memory, as opposed to blocks flushed when their band is
+ * flushed or closed.
+ *
+ * Those counters may be used to compare the efficiency of the cache policies
+ * selected with the GDAL_BLOCK_CACHE_POLICY configuration option.
+ *
+ * @param pnHits Pointer to the number of hits, or NULL.
+ * @param pnMisses Pointer to the number of misses, or NULL.
+ * @param pnEvictions Pointer to the number of evictions, or NULL.
+ *
+ * @since GDAL 3.12
+ */
+
+void GDALGetCacheStatistics(GIntBig *pnHits, GIntBig *pnMisses,
+                            GIntBig *pnEvictions)
+{
+    GIntBig nHits = 0;
+    GIntBig nMisses = 0;
+    GIntBig nEvictions = 0;
+    for (int i = 0; i < nCacheShards; ++i)
+    {
+        nHits += pasCacheShards[i].nHits.load(std::memory_order_relaxed);
+        nMisses += pasCacheShards[i].nMisses.load(std::memory_order_relaxed);
+        nEvictions +=
+            pasCacheShards[i].nEvictions.load(std::memory_order_relaxed);
+    }
+    if (pnHits)
+        *pnHits = nHits;
+    if (pnMisses)
+        *pnMisses = nMisses;
+    if (pnEvictions)
+        *pnEvictions = nEvictions;
+}
+
+/************************************************************************/
+/*                      GDALResetCacheStatistics()                      */
+/************************************************************************/
+
+/**
+ * \brief Reset the statistics returned by GDALGetCacheStatistics().
+ *
+ * @since GDAL 3.12
+ */
+
+void GDALResetCacheStatistics()
+{
+    for (int i = 0; i < nCacheShards; ++i)
+    {
+        pasCacheShards[i].nHits = 0;
+        pasCacheShards[i].nMisses = 0;
+        pasCacheShards[i].nEvictions = 0;
+    }
 }
 
 /************************************************************************/
@@ -337,6 +690,11 @@ int CPL_STDCALL GDALFlushCacheBlock()
  * a least recently used (LRU) list and an upper cache limit (see
  * GDALSetCacheMax()) under which the cache size is normally kept.
  *
+ * When the GDAL_BLOCK_CACHE_SHARDS configuration option is set to a value
+ * greater than 1, the global cache is split into that number of shards,
+ * each one with its own lock, LRU list and an equal share of the cache limit.
+ * Blocks are dispatched to shards depending on their band and position.
+ *
  * Some blocks in the cache may be modified relative to the state on disk
  * (they are marked "Dirty") and must be flushed to disk before they can
  * be discarded.  Other (Clean) blocks may just be discarded if their memory
@@ -377,11 +735,23 @@ int CPL_STDCALL GDALFlushCacheBlock()
 int GDALRasterBlock::FlushCacheBlock(int bDirtyBlocksOnly)
 
 {
-    GDALRasterBlock *poTarget;
-
+    GDALRasterBlock *poTarget = nullptr;
+
+    // Start from a different shard at each call, so that repeated calls
+    // (e.g. from GDALSetCacheMax64()) evenly drain all shards.
+    const int nShards = nCacheShards;
+    const int iFirstShard =
+        nShards == 1 ? 0
+                     : static_cast<int>(nFlushCacheBlockShardCounter++ %
+                                        static_cast<unsigned>(nShards));
+    for (int i = 0; i < nShards && poTarget == nullptr; ++i)
     {
-        INITIALIZE_LOCK;
-        poTarget = poOldest;
+        GDALRasterBlockCacheShard *psShard =
+            &pasCacheShards[(iFirstShard + i) % nShards];
+        INITIALIZE_LOCK(psShard);
+        const GIntBig nShardCacheMax = GetShardCacheMax(nCacheMax);
+        const int iFirstList = psShard->GetFirstEvictionList(nShardCacheMax);
+        poTarget = psShard->GetFirstEvictionCandidate(iFirstList);
 
         while (poTarget != nullptr)
         {
@@ -391,11 +761,12 @@ int GDALRasterBlock::FlushCacheBlock(int bDirtyBlocksOnly)
                 if (CPLAtomicCompareAndExchange(&(poTarget->nLockCount), 0, -1))
                     break;
             }
-            poTarget = poTarget->poPrevious;
+            poTarget = psShard->GetNextEvictionCandidate(
+                poTarget->poPrevious, poTarget->nCacheList, iFirstList);
         }
 
         if (poTarget == nullptr)
-            return FALSE;
+            continue;
 #ifndef __COVERITY__
         // Disabled to avoid complains about sleeping under locks, that
         // are only true for debug/testing code
@@ -408,10 +779,18 @@ int GDALRasterBlock::FlushCacheBlock(int bDirtyBlocksOnly)
         }
 #endif
 
+        psShard->RecordEviction(
+            GDALRasterBlockCacheKey{poTarget->poBand, poTarget->nXOff,
+                                    poTarget->nYOff},
+            poTarget->nCacheList,
+            GetEffectiveBlockSize(poTarget->GetBlockSize()), nShardCacheMax);
         poTarget->Detach_unlocked();
         poTarget->GetBand()->UnreferenceBlock(poTarget);
     }
 
+    if (poTarget == nullptr)
+        return FALSE;
+
 #ifndef __COVERITY__
     // Disabled to avoid complains about sleeping under locks, that
     // are only true for debug/testing code
@@ -534,13 +913,15 @@ GDALRasterBlock::GDALRasterBlock(GDALRasterBand *poBandIn, int nXOffIn,
                                  int nYOffIn)
     : eType(poBandIn->GetRasterDataType()), bDirty(false), nLockCount(0),
       nXOff(nXOffIn), nYOff(nYOffIn), nXSize(0), nYSize(0), pData(nullptr),
-      poBand(poBandIn), poNext(nullptr), poPrevious(nullptr), bMustDetach(true)
+      poBand(poBandIn), poNext(nullptr), poPrevious(nullptr), bMustDetach(true),
+      nCacheShard(0), nCacheList(CACHE_LIST_MAIN), bPrefetched(false),
+      poDatasetNext(nullptr), poDatasetPrevious(nullptr)
 {
-    if (!hRBLock)
+    if (!pasCacheShards[0].hLock)
     {
         // Needed for scenarios where GDALAllRegister() is called after
         // GDALDestroyDriverManager()
-        INITIALIZE_LOCK;
+        InitializeLocks();
     }
 
     CPLAssert(poBandIn != nullptr);
@@ -568,7 +949,9 @@ GDALRasterBlock::GDALRasterBlock(GDALRasterBand *poBandIn, int nXOffIn,
 GDALRasterBlock::GDALRasterBlock(int nXOffIn, int nYOffIn)
     : eType(GDT_Unknown), bDirty(false), nLockCount(0), nXOff(nXOffIn),
       nYOff(nYOffIn), nXSize(0), nYSize(0), pData(nullptr), poBand(nullptr),
-      poNext(nullptr), poPrevious(nullptr), bMustDetach(false)
+      poNext(nullptr), poPrevious(nullptr), bMustDetach(false), nCacheShard(0),
+      nCacheList(CACHE_LIST_MAIN), bPrefetched(false), poDatasetNext(nullptr),
+      poDatasetPrevious(nullptr)
 {
 }
 
@@ -591,10 +974,14 @@ void GDALRasterBlock::RecycleFor(int nXOffIn, int nYOffIn)
 
     poNext = nullptr;
     poPrevious = nullptr;
+    poDatasetNext = nullptr;
+    poDatasetPrevious = nullptr;
 
     nXOff = nXOffIn;
     nYOff = nYOffIn;
     bMustDetach = true;
+    nCacheList = CACHE_LIST_MAIN;
+    bPrefetched = false;
 }
 
 /************************************************************************/
@@ -624,21 +1011,6 @@ GDALRasterBlock::~GDALRasterBlock()
 #endif
 }
 
-/************************************************************************/
-/*                        GetEffectiveBlockSize()                       */
-/************************************************************************/
-
-static size_t GetEffectiveBlockSize(GPtrDiff_t nBlockSize)
-{
-    // The real cost of a block allocation is more than just nBlockSize
-    // As we allocate with 64-byte alignment, use 64 as a multiple.
-    // We arbitrarily add 2 * sizeof(GDALRasterBlock) to account for that
-    return static_cast<size_t>(
-        std::min(static_cast<GUIntBig>(UINT_MAX),
-                 static_cast<GUIntBig>(DIV_ROUND_UP(nBlockSize, 64)) * 64 +
-                     2 * sizeof(GDALRasterBlock)));
-}
-
 /************************************************************************/
 /*                               Detach()                               */
 /************************************************************************/
@@ -657,19 +1029,22 @@ void GDALRasterBlock::Detach()
 {
     if (bMustDetach)
     {
-        TAKE_LOCK;
+        TAKE_LOCK(&pasCacheShards[nCacheShard]);
         Detach_unlocked();
     }
 }
 
 void GDALRasterBlock::Detach_unlocked()
 {
-    if (poOldest == this)
-        poOldest = poPrevious;
+    GDALRasterBlockCacheShard &oShard = pasCacheShards[nCacheShard];
+    GDALRasterBlockCacheList &oList = oShard.aoLists[nCacheList];
+
+    if (oList.poOldest == this)
+        oList.poOldest = poPrevious;
 
-    if (poNewest == this)
+    if (oList.poNewest == this)
     {
-        poNewest = poNext;
+        oList.poNewest = poNext;
     }
 
     if (poPrevious != nullptr)
@@ -682,8 +1057,17 @@ void GDALRasterBlock::Detach_unlocked()
     poNext = nullptr;
     bMustDetach = false;
 
+    DetachFromDatasetList_unlocked();
+
     if (pData)
-        nCacheUsed -= GetEffectiveBlockSize(GetBlockSize());
+    {
+        const auto nEffectiveSize = GetEffectiveBlockSize(GetBlockSize());
+        oShard.nCacheUsed -= nEffectiveSize;
+        if (nCacheList == CACHE_LIST_A1IN)
+            oShard.nA1InCacheUsed -= nEffectiveSize;
+        if (GDALDataset *poDS = poBand->GetDataset())
+            poDS->UpdateBlockCacheUsage(-nEffectiveSize, 0);
+    }
 
 #ifdef ENABLE_DEBUG
     Verify();
@@ -703,26 +1087,37 @@ void GDALRasterBlock::Detach_unlocked()
 void GDALRasterBlock::Verify()
 
 {
-    TAKE_LOCK;
-
-    CPLAssert((poNewest == nullptr && poOldest == nullptr) ||
-              (poNewest != nullptr && poOldest != nullptr));
-
-    if (poNewest != nullptr)
+    for (int i = 0; i < nCacheShards; ++i)
     {
-        CPLAssert(poNewest->poPrevious == nullptr);
-        CPLAssert(poOldest->poNext == nullptr);
+        const GDALRasterBlockCacheShard &oShard = pasCacheShards[i];
+        TAKE_LOCK(&oShard);
 
-        GDALRasterBlock *poLast = nullptr;
-        for (GDALRasterBlock *poBlock = poNewest; poBlock != nullptr;
-             poBlock = poBlock->poNext)
+        for (int iList = 0; iList < 2; ++iList)
         {
-            CPLAssert(poBlock->poPrevious == poLast);
+            const GDALRasterBlockCacheList &oList = oShard.aoLists[iList];
+            CPLAssert(
+                (oList.poNewest == nullptr && oList.poOldest == nullptr) ||
+                (oList.poNewest != nullptr && oList.poOldest != nullptr));
 
-            poLast = poBlock;
-        }
+            if (oList.poNewest != nullptr)
+            {
+                CPLAssert(oList.poNewest->poPrevious == nullptr);
+                CPLAssert(oList.poOldest->poNext == nullptr);
+
+                GDALRasterBlock *poLast = nullptr;
+                for (GDALRasterBlock *poBlock = oList.poNewest;
+                     poBlock != nullptr; poBlock = poBlock->poNext)
+                {
+                    CPLAssert(poBlock->poPrevious == poLast);
+                    CPLAssert(poBlock->nCacheShard == i);
+                    CPLAssert(poBlock->nCacheList == iList);
 
-        CPLAssert(poOldest == poLast);
+                    poLast = poBlock;
+                }
+
+                CPLAssert(oList.poOldest == poLast);
+            }
+        }
     }
 }
 
@@ -735,24 +1130,31 @@ void GDALRasterBlock::Verify()
 #ifdef notdef
 void GDALRasterBlock::CheckNonOrphanedBlocks(GDALRasterBand *poBand)
 {
-    TAKE_LOCK;
-    for (GDALRasterBlock *poBlock = poNewest; poBlock != nullptr;
-         poBlock = poBlock->poNext)
+    for (int i = 0; i < nCacheShards; ++i)
     {
-        if (poBlock->GetBand() == poBand)
+        TAKE_LOCK(&pasCacheShards[i]);
+        for (const auto &oList : pasCacheShards[i].aoLists)
         {
-            printf("Cache has still blocks of band %p\n", poBand); /*ok*/
-            printf("Band : %d\n", poBand->GetBand());              /*ok*/
-            printf("nRasterXSize = %d\n", poBand->GetXSize());     /*ok*/
-            printf("nRasterYSize = %d\n", poBand->GetYSize());     /*ok*/
-            int nBlockXSize, nBlockYSize;
-            poBand->GetBlockSize(&nBlockXSize, &nBlockYSize);
-            printf("nBlockXSize = %d\n", nBlockXSize);      /*ok*/
-            printf("nBlockYSize = %d\n", nBlockYSize);      /*ok*/
-            printf("Dataset : %p\n", poBand->GetDataset()); /*ok*/
-            if (poBand->GetDataset())
-                printf("Dataset : %s\n", /*ok*/
-                       poBand->GetDataset()->GetDescription());
+            for (GDALRasterBlock *poBlock = oList.poNewest; poBlock != nullptr;
+                 poBlock = poBlock->poNext)
+            {
+                if (poBlock->GetBand() == poBand)
+                {
+                    printf("Cache has still blocks of band %p\n", /*ok*/
+                           poBand);
+                    printf("Band : %d\n", poBand->GetBand());          /*ok*/
+                    printf("nRasterXSize = %d\n", poBand->GetXSize()); /*ok*/
+                    printf("nRasterYSize = %d\n", poBand->GetYSize()); /*ok*/
+                    int nBlockXSize, nBlockYSize;
+                    poBand->GetBlockSize(&nBlockXSize, &nBlockYSize);
+                    printf("nBlockXSize = %d\n", nBlockXSize);      /*ok*/
+                    printf("nBlockYSize = %d\n", nBlockYSize);      /*ok*/
+                    printf("Dataset : %p\n", poBand->GetDataset()); /*ok*/
+                    if (poBand->GetDataset())
+                        printf("Dataset : %s\n", /*ok*/
+                               poBand->GetDataset()->GetDescription());
+                }
+            }
         }
     }
 }
@@ -809,11 +1211,19 @@ CPLErr GDALRasterBlock::Write()
 void GDALRasterBlock::Touch()
 
 {
+    // With the 2Q policy, blocks of the A1in list are kept in FIFO order,
+    // so that the numerous accesses to a block during a single scan do not
+    // make it look as frequently used.
+    if (nCacheList == CACHE_LIST_A1IN)
+        return;
+
+    GDALRasterBlockCacheShard &oShard = pasCacheShards[nCacheShard];
+
     // Can be safely tested outside the lock
-    if (poNewest == this)
+    if (oShard.aoLists[nCacheList].poNewest == this)
         return;
 
-    TAKE_LOCK;
+    TAKE_LOCK(&oShard);
     Touch_unlocked();
 }
 
@@ -826,15 +1236,17 @@ void GDALRasterBlock::Touch_unlocked()
     // 1. Thread 1 calls Touch() and poNewest != this at that point
     // 2. Thread 2 detaches poNewest
     // 3. Thread 1 arrives here
-    if (poNewest == this)
+    GDALRasterBlockCacheList &oList =
+        pasCacheShards[nCacheShard].aoLists[nCacheList];
+    if (oList.poNewest == this)
         return;
 
     // We should not try to touch a block that has been detached.
     // If that happen, corruption has already occurred.
     CPLAssert(bMustDetach);
 
-    if (poOldest == this)
-        poOldest = this->poPrevious;
+    if (oList.poOldest == this)
+        oList.poOldest = this->poPrevious;
 
     if (poPrevious != nullptr)
         poPrevious->poNext = poNext;
@@ -843,25 +1255,100 @@ void GDALRasterBlock::Touch_unlocked()
         poNext->poPrevious = poPrevious;
 
     poPrevious = nullptr;
-    poNext = poNewest;
+    poNext = oList.poNewest;
 
-    if (poNewest != nullptr)
+    if (oList.poNewest != nullptr)
     {
-        CPLAssert(poNewest->poPrevious == nullptr);
-        poNewest->poPrevious = this;
+        CPLAssert(oList.poNewest->poPrevious == nullptr);
+        oList.poNewest->poPrevious = this;
     }
-    poNewest = this;
+    oList.poNewest = this;
 
-    if (poOldest == nullptr)
+    if (oList.poOldest == nullptr)
     {
         CPLAssert(poPrevious == nullptr && poNext == nullptr);
-        poOldest = this;
+        oList.poOldest = this;
     }
+
+    TouchInDatasetList_unlocked();
 #ifdef ENABLE_DEBUG
     Verify();
 #endif
 }
 
+/************************************************************************/
+/*                    TouchInDatasetList_unlocked()                     */
+/************************************************************************/
+
+// Move the block to the head of the list of blocks of its dataset in its
+// shard.
+void GDALRasterBlock::TouchInDatasetList_unlocked()
+{
+    const GDALDataset *poDS = poBand->GetDataset();
+    if (!poDS)
+        return;
+
+    GDALRasterBlockCacheList &oList =
+        pasCacheShards[nCacheShard].oMapDatasetLists[poDS];
+    if (oList.poNewest == this)
+        return;
+
+    if (oList.poOldest == this)
+        oList.poOldest = poDatasetPrevious;
+
+    if (poDatasetPrevious != nullptr)
+        poDatasetPrevious->poDatasetNext = poDatasetNext;
+
+    if (poDatasetNext != nullptr)
+        poDatasetNext->poDatasetPrevious = poDatasetPrevious;
+
+    poDatasetPrevious = nullptr;
+    poDatasetNext = oList.poNewest;
+
+    if (oList.poNewest != nullptr)
+        oList.poNewest->poDatasetPrevious = this;
+    oList.poNewest = this;
+
+    if (oList.poOldest == nullptr)
+        oList.poOldest = this;
+}
+
+/************************************************************************/
+/*                   DetachFromDatasetList_unlocked()                   */
+/************************************************************************/
+
+// Remove the block from the list of blocks of its dataset in its shard.
+void GDALRasterBlock::DetachFromDatasetList_unlocked()
+{
+    const GDALDataset *poDS = poBand->GetDataset();
+    if (!poDS)
+        return;
+
+    auto &oMapDatasetLists = pasCacheShards[nCacheShard].oMapDatasetLists;
+    const auto oIter = oMapDatasetLists.find(poDS);
+    if (oIter == oMapDatasetLists.end())
+        return;
+
+    GDALRasterBlockCacheList &oList = oIter->second;
+    if (oList.poOldest == this)
+        oList.poOldest = poDatasetPrevious;
+
+    if (oList.poNewest == this)
+        oList.poNewest = poDatasetNext;
+
+    if (poDatasetPrevious != nullptr)
+        poDatasetPrevious->poDatasetNext = poDatasetNext;
+
+    if (poDatasetNext != nullptr)
+        poDatasetNext->poDatasetPrevious = poDatasetPrevious;
+
+    poDatasetPrevious = nullptr;
+    poDatasetNext = nullptr;
+
+    if (oList.poNewest == nullptr)
+        oMapDatasetLists.erase(oIter);
+}
+
 /************************************************************************/
 /*                            Internalize()                             */
 /************************************************************************/
@@ -872,7 +1359,9 @@ void GDALRasterBlock::Touch_unlocked()
  * This method allocates memory for the block, and attempts to flush other
  * blocks, if necessary, to bring the total cache size back within the limits.
  * The newly allocated block is touched and will be considered most recently
- * used in the LRU list.
+ * used in the LRU list (or, with the 2Q policy, most recently loaded in the
+ * A1in list, unless it has been recently evicted from it, in which case it
+ * goes to the head of the Am list).
  *
  * @return CE_None on success or CE_Failure if memory allocation fails.
  */
@@ -884,32 +1373,90 @@ CPLErr GDALRasterBlock::Internalize()
 
     void *pNewData = nullptr;
 
-    // This call will initialize the hRBLock mutex. Other call places can
+    // This call will initialize the block cache locks. Other call places can
     // only be called if we have go through there.
-    const GIntBig nCurCacheMax = GDALGetCacheMax64();
+    // Each shard is only allowed its share of the global cache size.
+    const GIntBig nCurCacheMax = GetShardCacheMax(GDALGetCacheMax64());
 
     // No risk of overflow as it is checked in GDALRasterBand::InitBlockInfo().
     const auto nSizeInBytes = GetBlockSize();
 
+    const GDALRasterBlockCacheKey oKey{poBand, nXOff, nYOff};
+    nCacheShard = GetCacheShard(oKey);
+    GDALRasterBlockCacheShard &oShard = pasCacheShards[nCacheShard];
+    oShard.nMisses.fetch_add(1, std::memory_order_relaxed);
+
+    GDALDataset *poThisDS = poBand->GetDataset();
+    if (poThisDS)
+        poThisDS->IncBlockCacheMisses();
+
     /* -------------------------------------------------------------------- */
-    /*      Flush old blocks if we are nearing our memory limit.            */
+    /*      Flush old blocks if we are nearing our memory limit, or if      */
+    /*      this dataset is above its own quota (in which case only its     */
+    /*      blocks are evicted).                                            */
     /* -------------------------------------------------------------------- */
     bool bFirstIter = true;
     bool bLoopAgain = false;
-    GDALDataset *poThisDS = poBand->GetDataset();
+    // Read outside of the lock, as it may need to read a configuration option
+    const GIntBig nDatasetCacheMax =
+        poThisDS ? poThisDS->GetBlockCacheMax() : 0;
+    const auto MustEvict = [&oShard, nCurCacheMax, poThisDS, nDatasetCacheMax]()
+    {
+        return oShard.nCacheUsed > nCurCacheMax ||
+               (nDatasetCacheMax > 0 &&
+                poThisDS->GetBlockCacheUsage() > nDatasetCacheMax);
+    };
     do
     {
         bLoopAgain = false;
         GDALRasterBlock *apoBlocksToFree[64] = {nullptr};
         int nBlocksToFree = 0;
         {
-            TAKE_LOCK;
+            TAKE_LOCK(&oShard);
 
             if (bFirstIter)
-                nCacheUsed += GetEffectiveBlockSize(nSizeInBytes);
-            GDALRasterBlock *poTarget = poOldest;
-            while (nCacheUsed > nCurCacheMax)
             {
+                oShard.nCacheUsed += GetEffectiveBlockSize(nSizeInBytes);
+                if (poThisDS)
+                    poThisDS->UpdateBlockCacheUsage(
+                        GetEffectiveBlockSize(nSizeInBytes), 0);
+            }
+            const int iFirstList = oShard.GetFirstEvictionList(nCurCacheMax);
+            // When only the blocks of this dataset are candidates, they are
+            // taken from its own list.
+            const auto GetFirstCandidate =
+                [&oShard, iFirstList, poThisDS](bool bOnlyThisDataset)
+            {
+                if (!bOnlyThisDataset)
+                    return oShard.GetFirstEvictionCandidate(iFirstList);
+                const auto oIter = oShard.oMapDatasetLists.find(poThisDS);
+                return oIter != oShard.oMapDatasetLists.end()
+                           ? oIter->second.poOldest
+                           : nullptr;
+            };
+            const auto GetNextCandidate =
+                [&oShard, iFirstList](const GDALRasterBlock *poBlock,
+                                      bool bOnlyThisDataset)
+            {
+                return bOnlyThisDataset
+                           ? poBlock->poDatasetPrevious
+                           : oShard.GetNextEvictionCandidate(
+                                 poBlock->poPrevious, poBlock->nCacheList,
+                                 iFirstList);
+            };
+            bool bTargetOnlyThisDataset = false;
+            GDALRasterBlock *poTarget = GetFirstCandidate(false);
+            while (MustEvict())
+            {
+                // If the global limit is respected, we are only there
+                // because of the quota of this dataset.
+                const bool bOnlyThisDataset =
+                    oShard.nCacheUsed <= nCurCacheMax;
+                if (bOnlyThisDataset != bTargetOnlyThisDataset)
+                {
+                    bTargetOnlyThisDataset = bOnlyThisDataset;
+                    poTarget = GetFirstCandidate(bOnlyThisDataset);
+                }
                 GDALRasterBlock *poDirtyBlockOtherDataset = nullptr;
                 // In this first pass, only discard dirty blocks of this
                 // dataset. We do this to decrease significantly the likelihood
@@ -941,7 +1488,7 @@ CPLErr GDALRasterBlock::Internalize()
                             poDirtyBlockOtherDataset = poTarget;
                         }
                     }
-                    poTarget = poTarget->poPrevious;
+                    poTarget = GetNextCandidate(poTarget, bOnlyThisDataset);
                 }
                 if (poTarget == nullptr && poDirtyBlockOtherDataset)
                 {
@@ -954,7 +1501,7 @@ CPLErr GDALRasterBlock::Internalize()
                     }
                     else
                     {
-                        poTarget = poOldest;
+                        poTarget = oShard.GetFirstEvictionCandidate(iFirstList);
                         while (poTarget != nullptr)
                         {
                             if (CPLAtomicCompareAndExchange(
@@ -965,7 +1512,9 @@ CPLErr GDALRasterBlock::Internalize()
                                     "Evicting dirty block of another dataset");
                                 break;
                             }
-                            poTarget = poTarget->poPrevious;
+                            poTarget = oShard.GetNextEvictionCandidate(
+                                poTarget->poPrevious, poTarget->nCacheList,
+                                iFirstList);
                         }
                     }
                 }
@@ -984,8 +1533,16 @@ CPLErr GDALRasterBlock::Internalize()
                     }
 #endif
 
-                    GDALRasterBlock *_poPrevious = poTarget->poPrevious;
+                    GDALRasterBlock *_poPrevious =
+                        GetNextCandidate(poTarget, bOnlyThisDataset);
 
+                    oShard.RecordEviction(
+                        GDALRasterBlockCacheKey{poTarget->poBand,
+                                                poTarget->nXOff,
+                                                poTarget->nYOff},
+                        poTarget->nCacheList,
+                        GetEffectiveBlockSize(poTarget->GetBlockSize()),
+                        nCurCacheMax);
                     poTarget->Detach_unlocked();
                     poTarget->GetBand()->UnreferenceBlock(poTarget);
 
@@ -995,12 +1552,12 @@ CPLErr GDALRasterBlock::Internalize()
                         // Only free one dirty block at a time so that
                         // other dirty blocks of other bands with the same
                         // coordinates can be found with TryGetLockedBlock()
-                        bLoopAgain = nCacheUsed > nCurCacheMax;
+                        bLoopAgain = MustEvict();
                         break;
                     }
                     if (nBlocksToFree == 64)
                     {
-                        bLoopAgain = (nCacheUsed > nCurCacheMax);
+                        bLoopAgain = MustEvict();
                         break;
                     }
 
@@ -1018,7 +1575,22 @@ CPLErr GDALRasterBlock::Internalize()
             /* ------------------------------------------------------------------
              */
             if (!bLoopAgain)
+            {
+                // With the 2Q policy, the block goes to the Am list if it has
+                // been recently evicted from the A1in list, and to the A1in
+                // list otherwise.
+                if (bUse2QPolicy && !oShard.RemoveGhost(oKey))
+                {
+                    nCacheList = CACHE_LIST_A1IN;
+                    oShard.nA1InCacheUsed +=
+                        GetEffectiveBlockSize(nSizeInBytes);
+                }
+                else
+                {
+                    nCacheList = CACHE_LIST_MAIN;
+                }
                 Touch_unlocked();
+            }
         }
 
         bFirstIter = false;
@@ -1099,7 +1671,11 @@ void GDALRasterBlock::MarkDirty()
     {
         poBand->InitRWLock();
         if (!bDirty)
+        {
             poBand->IncDirtyBlocks(1);
+            if (GDALDataset *poDS = poBand->GetDataset())
+                poDS->UpdateBlockCacheUsage(0, GetBlockSize());
+        }
     }
     bDirty = true;
 }
@@ -1118,7 +1694,11 @@ void GDALRasterBlock::MarkDirty()
 void GDALRasterBlock::MarkClean()
 {
     if (bDirty && poBand)
+    {
         poBand->IncDirtyBlocks(-1);
+        if (GDALDataset *poDS = poBand->GetDataset())
+            poDS->UpdateBlockCacheUsage(0, -GetBlockSize());
+    }
     bDirty = false;
 }
 
@@ -1129,9 +1709,13 @@ void GDALRasterBlock::MarkClean()
 /*! @cond Doxygen_Suppress */
 void GDALRasterBlock::DestroyRBMutex()
 {
-    if (hRBLock != nullptr)
-        DESTROY_LOCK;
-    hRBLock = nullptr;
+    for (int i = 0; i < nCacheShards; ++i)
+    {
+        GDALRasterBlockCacheShard *psShard = &pasCacheShards[i];
+        if (psShard->hLock != nullptr)
+            DESTROY_LOCK(psShard);
+        psShard->hLock = nullptr;
+    }
 }
 
 /*! @endcond */
@@ -1183,6 +1767,9 @@ int GDALRasterBlock::TakeLock()
 
         return FALSE;
     }
+    pasCacheShards[nCacheShard].nHits.fetch_add(1, std::memory_order_relaxed);
+    if (GDALDataset *poDS = poBand->GetDataset())
+        poDS->IncBlockCacheHits();
     Touch();
     return TRUE;
 }
@@ -1214,7 +1801,7 @@ int GDALRasterBlock::DropLockForRemovalFromStorage()
 #endif
 
     // Wait for the block for having been unreferenced.
-    TAKE_LOCK;
+    TAKE_LOCK(&pasCacheShards[nCacheShard]);
 
     return FALSE;
 }
@@ -1223,14 +1810,20 @@ int GDALRasterBlock::DropLockForRemovalFromStorage()
 void GDALRasterBlock::DumpAll()
 {
     int iBlock = 0;
-    for( GDALRasterBlock *poBlock = poNewest;
-         poBlock != nullptr;
-         poBlock = poBlock->poNext )
+    for( int i = 0; i < nCacheShards; ++i )
     {
-        printf("Block %d\n", iBlock);/*ok*/
-        poBlock->DumpBlock();
-        printf("\n");/*ok*/
-        iBlock++;
+        for( const auto &oList : pasCacheShards[i].aoLists )
+        {
+            for( GDALRasterBlock *poBlock = oList.poNewest;
+                 poBlock != nullptr;
+                 poBlock = poBlock->poNext )
+            {
+                printf("Block %d\n", iBlock);/*ok*/
+                poBlock->DumpBlock();
+                printf("\n");/*ok*/
+                iBlock++;
+            }
+        }
     }
 }
 
@@ -0,0 +1,181 @@
+/******************************************************************************
+ *
+ * Project:  GDAL Core
+ * Purpose:  Asynchronous read-ahead of raster blocks
+ * Author:   agent <agent at local>
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, agent <agent at local>
+ *
+ * SPDX-License-Identifier: MIT
+ ****************************************************************************/
+
+#include "gdalrasterblockprefetcher.h"
+
+#include "cpl_error.h"
+#include "gdal_priv.h"
+#include "gdal_thread_pool.h"
+
+#include <chrono>
+
+//! @cond Doxygen_Suppress
+
+/************************************************************************/
+/*                      GDALRasterBlockPrefetcher()                     */
+/************************************************************************/
+
+GDALRasterBlockPrefetcher::GDALRasterBlockPrefetcher(
+    int nDepth, CPLWorkerThreadPool *poPool)
+    : m_nDepth(nDepth), m_poQueue(poPool->CreateJobQueue())
+{
+}
+
+/************************************************************************/
+/*                     ~GDALRasterBlockPrefetcher()                     */
+/************************************************************************/
+
+GDALRasterBlockPrefetcher::~GDALRasterBlockPrefetcher()
+{
+    Stop();
+}
+
+/************************************************************************/
+/*                               Create()                               */
+/************************************************************************/
+
+/** Instantiate a prefetcher reading up to nDepth blocks ahead per band.
+ *
+ * @return a new prefetcher, or nullptr if nDepth <= 0 or the prefetch thread
+ * pool cannot be created.
+ */
+std::unique_ptr<GDALRasterBlockPrefetcher>
+GDALRasterBlockPrefetcher::Create(int nDepth)
+{
+    if (nDepth <= 0)
+        return nullptr;
+    CPLWorkerThreadPool *poPool =
+        GDALGetBlockPrefetchThreadPool(CPLGetNumCPUs());
+    if (!poPool)
+        return nullptr;
+    return std::make_unique<GDALRasterBlockPrefetcher>(nDepth, poPool);
+}
+
+/************************************************************************/
+/*                                Stop()                                */
+/************************************************************************/
+
+/** Cancel prefetch jobs that have not started, and wait for the running
+ * ones to finish.
+ *
+ * Jobs waiting for the dataset mutex give up, so this may be called with
+ * the dataset mutex held.
+ */
+void GDALRasterBlockPrefetcher::Stop()
+{
+    m_bStopped = true;
+    if (m_poQueue)
+        m_poQueue->WaitCompletion();
+}
+
+/************************************************************************/
+/*                         NotifyBlockRequest()                         */
+/************************************************************************/
+
+/** Called, with the dataset mutex held, when a block that was not in the
+ * cache, or that had been prefetched, is requested.
+ */
+void GDALRasterBlockPrefetcher::NotifyBlockRequest(GDALRasterBand *poBand,
+                                                   int nXBlockOff,
+                                                   int nYBlockOff)
+{
+    if (m_bInPrefetchJob || m_bStopped)
+        return;
+
+    int nBlockXSize = 0;
+    int nBlockYSize = 0;
+    poBand->GetBlockSize(&nBlockXSize, &nBlockYSize);
+    if (nBlockXSize <= 0 || nBlockYSize <= 0)
+        return;
+    const int nBlocksPerRow = DIV_ROUND_UP(poBand->GetXSize(), nBlockXSize);
+    const int nBlocksPerColumn =
+        DIV_ROUND_UP(poBand->GetYSize(), nBlockYSize);
+    const GIntBig nBlockCount =
+        static_cast<GIntBig>(nBlocksPerRow) * nBlocksPerColumn;
+    const GIntBig nBlockIdx =
+        static_cast<GIntBig>(nYBlockOff) * nBlocksPerRow + nXBlockOff;
+
+    std::lock_guard oLock(m_oMutex);
+    BandState &oState = m_oMapBandState[poBand];
+    const GIntBig nStride = nBlockIdx - oState.nLastBlockIdx;
+    const bool bPatternConfirmed = oState.nLastBlockIdx >= 0 && nStride > 0 &&
+                                   nStride == oState.nLastStride;
+    oState.nLastStride = oState.nLastBlockIdx >= 0 ? nStride : 0;
+    oState.nLastBlockIdx = nBlockIdx;
+    if (!bPatternConfirmed)
+        return;
+
+    for (int i = 1; i <= m_nDepth; ++i)
+    {
+        const GIntBig nNextBlockIdx = nBlockIdx + i * nStride;
+        if (nNextBlockIdx >= nBlockCount)
+            break;
+        const int nNextXBlockOff =
+            static_cast<int>(nNextBlockIdx % nBlocksPerRow);
+        const int nNextYBlockOff =
+            static_cast<int>(nNextBlockIdx / nBlocksPerRow);
+        const auto oKey =
+            std::make_tuple(poBand, nNextXBlockOff, nNextYBlockOff);
+        if (!m_oSetPendingBlocks.insert(oKey).second)
+            continue;
+        if (!m_poQueue->SubmitJob(
+                [this, poBand, nNextXBlockOff, nNextYBlockOff]()
+                { PrefetchBlock(poBand, nNextXBlockOff, nNextYBlockOff); }))
+        {
+            m_oSetPendingBlocks.erase(oKey);
+            break;
+        }
+    }
+}
+
+/************************************************************************/
+/*                           PrefetchBlock()                            */
+/************************************************************************/
+
+/** Job run on the thread pool that reads a block into the cache. */
+void GDALRasterBlockPrefetcher::PrefetchBlock(GDALRasterBand *poBand,
+                                              int nXBlockOff, int nYBlockOff)
+{
+    // Wait for the user of the dataset to release it, but not past Stop().
+    std::unique_lock oLock(m_oDatasetMutex, std::defer_lock);
+    while (!m_bStopped &&
+           !oLock.try_lock_for(std::chrono::milliseconds(10)))
+    {
+    }
+
+    if (oLock.owns_lock())
+    {
+        if (!m_bStopped)
+        {
+            m_bInPrefetchJob = true;
+            GDALRasterBlock *poBlock =
+                poBand->TryGetLockedBlockRef(nXBlockOff, nYBlockOff);
+            if (!poBlock)
+            {
+                // Errors will be reported when the user requests the block.
+                CPLErrorStateBackuper oErrorStateBackuper(CPLQuietErrorHandler);
+                poBlock = poBand->GetLockedBlockRef(nXBlockOff, nYBlockOff);
+                if (poBlock)
+                    poBlock->SetPrefetched(true);
+            }
+            if (poBlock)
+                poBlock->DropLock();
+            m_bInPrefetchJob = false;
+        }
+        oLock.unlock();
+    }
+
+    std::lock_guard oPendingLock(m_oMutex);
+    m_oSetPendingBlocks.erase(std::make_tuple(poBand, nXBlockOff, nYBlockOff));
+}
+
+//! @endcond
@@ -0,0 +1,102 @@
+/******************************************************************************
+ *
+ * Project:  GDAL Core
+ * Purpose:  Asynchronous read-ahead of raster blocks
+ * Author:   agent <agent at local>
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, agent <agent at local>
+ *
+ * SPDX-License-Identifier: MIT
+ ****************************************************************************/
+
+#ifndef GDALRASTERBLOCKPREFETCHER_H_INCLUDED
+#define GDALRASTERBLOCKPREFETCHER_H_INCLUDED
+
+//! @cond Doxygen_Suppress
+
+#include "cpl_port.h"
+#include "cpl_worker_thread_pool.h"
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <tuple>
+
+class GDALDataset;
+class GDALRasterBand;
+
+/************************************************************************/
+/*                      GDALRasterBlockPrefetcher                       */
+/************************************************************************/
+
+/** Reads ahead, on a dedicated thread pool, the blocks that are likely to be
+ * requested next on the bands of a dataset.
+ *
+ * The access pattern is detected from the sequence of blocks requested
+ * through GDALRasterBand::GetLockedBlockRef(): when two consecutive requests
+ * on a band are separated by the same positive stride (in row-major block
+ * index), the following blocks at that stride are read in the background.
+ *
+ * As GDAL datasets are not thread-safe, the prefetch jobs and the user of
+ * the dataset are serialized through a recursive mutex, taken by the
+ * RasterIO(), ReadBlock(), GetLockedBlockRef() and FlushCache() entry points.
+ * Decoding of the next blocks thus overlaps with the processing done by the
+ * caller between two requests.
+ *
+ * A prefetch job may wait for that mutex while the user thread holds it and
+ * itself waits for jobs of the global thread pool (multi-threaded decoding
+ * in drivers), hence the use of a dedicated pool. The jobs only wait for the
+ * mutex with a timeout, and give up once Stop() has been called, so that
+ * Stop() can be called whether the mutex is held or not.
+ */
+class GDALRasterBlockPrefetcher
+{
+    CPL_DISALLOW_COPY_ASSIGN(GDALRasterBlockPrefetcher)
+
+    struct BandState
+    {
+        GIntBig nLastBlockIdx = -1;
+        GIntBig nLastStride = 0;
+    };
+
+    const int m_nDepth;
+    std::unique_ptr<CPLJobQueue> m_poQueue{};
+
+    // Serializes accesses to the dataset between the user and prefetch jobs.
+    std::recursive_timed_mutex m_oDatasetMutex{};
+
+    // Protects the below members.
+    std::mutex m_oMutex{};
+    std::map<GDALRasterBand *, BandState> m_oMapBandState{};
+    std::set<std::tuple<GDALRasterBand *, int, int>> m_oSetPendingBlocks{};
+
+    std::atomic<bool> m_bStopped{false};
+
+    // Set while a prefetch job runs. Only accessed with m_oDatasetMutex held.
+    bool m_bInPrefetchJob = false;
+
+    void PrefetchBlock(GDALRasterBand *poBand, int nXBlockOff, int nYBlockOff);
+
+  public:
+    GDALRasterBlockPrefetcher(int nDepth, CPLWorkerThreadPool *poPool);
+    ~GDALRasterBlockPrefetcher();
+
+    static std::unique_ptr<GDALRasterBlockPrefetcher> Create(int nDepth);
+
+    std::recursive_timed_mutex &GetDatasetMutex()
+    {
+        return m_oDatasetMutex;
+    }
+
+    void NotifyBlockRequest(GDALRasterBand *poBand, int nXBlockOff,
+                            int nYBlockOff);
+
+    void Stop();
+};
+
+//! @endcond
+
+#endif /* GDALRASTERBLOCKPREFETCHER_H_INCLUDED */
@@ -1820,6 +1820,145 @@ GDALResampleChunk_AverageOrRMS(const GDALOverviewResampleArgs &args,
     return CE_Failure;
 }
 
+/************************************************************************/
+/*             GDALDownsampleIntegerFactor_AverageOrRMS()               */
+/************************************************************************/
+
+// Computes one destination line of an average or RMS downsampling by an
+// integer factor, without nodata, with the same kernels and rounding rules as
+// GDALResampleChunk_AverageOrRMS_T().
+template <class T, class Tsum, GDALDataType eWrkDataType, bool bQuadraticMean>
+static void GDALDownsampleIntegerFactor_AverageOrRMS(int nFactor,
+                                                     const void *pSrc,
+                                                     int nSrcLineStride,
+                                                     int nDstXSize, void *pDst)
+{
+    const T *pSrcScanlineShifted = static_cast<const T *>(pSrc);
+    T *const pDstScanline = static_cast<T *>(pDst);
+
+    if (nFactor == 2)
+    {
+        int iDstPixel = 0;
+#ifdef USE_SSE2
+        if constexpr (eWrkDataType == GDT_Byte)
+        {
+            if constexpr (bQuadraticMean)
+                iDstPixel = QuadraticMeanByteSSE2OrAVX2(
+                    nDstXSize, nSrcLineStride, pSrcScanlineShifted,
+                    pDstScanline);
+            else
+                iDstPixel =
+                    AverageByteSSE2OrAVX2(nDstXSize, nSrcLineStride,
+                                          pSrcScanlineShifted, pDstScanline);
+        }
+        else if constexpr (eWrkDataType == GDT_UInt16)
+        {
+            if constexpr (bQuadraticMean)
+                iDstPixel = QuadraticMeanUInt16SSE2(
+                    nDstXSize, nSrcLineStride, pSrcScanlineShifted,
+                    pDstScanline);
+            else
+                iDstPixel =
+                    AverageUInt16SSE2(nDstXSize, nSrcLineStride,
+                                      pSrcScanlineShifted, pDstScanline);
+        }
+        else if constexpr (eWrkDataType == GDT_Float32)
+        {
+            if constexpr (bQuadraticMean)
+                iDstPixel =
+                    QuadraticMeanFloatSSE2(nDstXSize, nSrcLineStride,
+                                           pSrcScanlineShifted, pDstScanline);
+            else
+                iDstPixel =
+                    AverageFloatSSE2(nDstXSize, nSrcLineStride,
+                                     pSrcScanlineShifted, pDstScanline);
+        }
+#endif
+        for (; iDstPixel < nDstXSize; ++iDstPixel)
+        {
+            const T *const p = pSrcScanlineShifted;
+            if constexpr (eWrkDataType == GDT_Float32 ||
+                          eWrkDataType == GDT_Float64)
+            {
+                if constexpr (bQuadraticMean)
+                    pDstScanline[iDstPixel] = static_cast<T>(std::sqrt(
+                        0.25 * (SQUARE<double>(p[0]) + SQUARE<double>(p[1]) +
+                                SQUARE<double>(p[nSrcLineStride]) +
+                                SQUARE<double>(p[1 + nSrcLineStride]))));
+                else
+                    pDstScanline[iDstPixel] = static_cast<T>(
+                        0.25f * (p[0] + p[1] + p[nSrcLineStride] +
+                                 p[1 + nSrcLineStride]));
+            }
+            else if constexpr (bQuadraticMean)
+            {
+                const Tsum nTotal = SQUARE<Tsum>(p[0]) + SQUARE<Tsum>(p[1]) +
+                                    SQUARE<Tsum>(p[nSrcLineStride]) +
+                                    SQUARE<Tsum>(p[1 + nSrcLineStride]);
+                pDstScanline[iDstPixel] = ComputeIntegerRMS_4values<T>(nTotal);
+            }
+            else
+            {
+                const Tsum nTotal =
+                    p[0] + p[1] + p[nSrcLineStride] + p[1 + nSrcLineStride];
+                pDstScanline[iDstPixel] = static_cast<T>((nTotal + 2) / 4);
+            }
+            pSrcScanlineShifted += 2;
+        }
+        return;
+    }
+
+    const double dfTotalWeight = static_cast<double>(nFactor) * nFactor;
+    for (int iDstPixel = 0; iDstPixel < nDstXSize; ++iDstPixel)
+    {
+        // Accumulate line by line, in the same order as the generic code.
+        double dfTotal = 0;
+        const T *pSrcLine = pSrcScanlineShifted;
+        for (int iY = 0; iY < nFactor; ++iY)
+        {
+            double dfTotalLine = 0;
+            for (int iX = 0; iX < nFactor; ++iX)
+            {
+                if constexpr (bQuadraticMean)
+                    dfTotalLine += SQUARE<double>(pSrcLine[iX]);
+                else
+                    dfTotalLine += pSrcLine[iX];
+            }
+            dfTotal += dfTotalLine;
+            pSrcLine += nSrcLineStride;
+        }
+
+        if constexpr (eWrkDataType == GDT_Byte)
+        {
+            if constexpr (bQuadraticMean)
+                pDstScanline[iDstPixel] =
+                    ComputeIntegerRMS<T, int>(dfTotal, dfTotalWeight);
+            else
+                pDstScanline[iDstPixel] =
+                    static_cast<T>(dfTotal / dfTotalWeight + 0.5);
+        }
+        else if constexpr (eWrkDataType == GDT_UInt16)
+        {
+            if constexpr (bQuadraticMean)
+                pDstScanline[iDstPixel] =
+                    ComputeIntegerRMS<T, uint64_t>(dfTotal, dfTotalWeight);
+            else
+                pDstScanline[iDstPixel] =
+                    static_cast<T>(dfTotal / dfTotalWeight + 0.5);
+        }
+        else
+        {
+            if constexpr (bQuadraticMean)
+                pDstScanline[iDstPixel] =
+                    static_cast<T>(sqrt(dfTotal / dfTotalWeight));
+            else
+                pDstScanline[iDstPixel] =
+                    static_cast<T>(dfTotal / dfTotalWeight);
+        }
+        pSrcScanlineShifted += nFactor;
+    }
+}
+
 /************************************************************************/
 /*                     GDALResampleChunk_Gauss()                        */
 /************************************************************************/
@@ -2515,6 +2654,210 @@ static CPLErr GDALResampleChunk_Mode(const GDALOverviewResampleArgs &args,
     return CE_Failure;
 }
 
+/************************************************************************/
+/*                 GDALDownsampleIntegerFactor_ModeByte()               */
+/************************************************************************/
+
+// Computes one destination line of a mode downsampling of a Byte band by an
+// integer factor, without nodata. Ties are resolved as in
+// GDALResampleChunk_ModeT(): the first value to reach the maximum count wins.
+static void GDALDownsampleIntegerFactor_ModeByte(int nFactor, const void *pSrc,
+                                                 int nSrcLineStride,
+                                                 int nDstXSize, void *pDst)
+{
+    const GByte *pabySrc = static_cast<const GByte *>(pSrc);
+    GByte *const pabyDst = static_cast<GByte *>(pDst);
+    int anCounts[256] = {0};
+
+    for (int iDstPixel = 0; iDstPixel < nDstXSize; ++iDstPixel)
+    {
+        int nMaxCount = 0;
+        int iMaxVal = 0;
+        const GByte *pabySrcLine = pabySrc;
+        for (int iY = 0; iY < nFactor; ++iY)
+        {
+            for (int iX = 0; iX < nFactor; ++iX)
+            {
+                const int nVal = pabySrcLine[iX];
+                if (++anCounts[nVal] > nMaxCount)
+                {
+                    iMaxVal = nVal;
+                    nMaxCount = anCounts[nVal];
+                }
+            }
+            pabySrcLine += nSrcLineStride;
+        }
+        pabyDst[iDstPixel] = static_cast<GByte>(iMaxVal);
+
+        // Only reset the histogram entries that have been touched, which is
+        // much cheaper than clearing the 256 entries for small factors.
+        pabySrcLine = pabySrc;
+        for (int iY = 0; iY < nFactor; ++iY)
+        {
+            for (int iX = 0; iX < nFactor; ++iX)
+                anCounts[pabySrcLine[iX]] = 0;
+            pabySrcLine += nSrcLineStride;
+        }
+        pabySrc += nFactor;
+    }
+}
+
+/************************************************************************/
+/*                   GDALDownsampleIntegerFactor_ModeT()                */
+/************************************************************************/
+
+// Computes one destination line of a mode downsampling by an integer factor,
+// without nodata, for data types other than Byte, with the same algorithm
+// as the regular processing of GDALResampleChunk_ModeT(), so that ties are
+// resolved the same way.
+template <class T>
+static void GDALDownsampleIntegerFactor_ModeT(int nFactor, const void *pSrc,
+                                              int nSrcLineStride,
+                                              int nDstXSize, void *pDst)
+{
+    const T *paSrc = static_cast<const T *>(pSrc);
+    T *const paDst = static_cast<T *>(pDst);
+    const size_t nNumPx = static_cast<size_t>(nFactor) * nFactor;
+    std::vector<T> aVals(nNumPx);
+    std::vector<int> anSums(nNumPx);
+
+    for (int iDstPixel = 0; iDstPixel < nDstXSize; ++iDstPixel)
+    {
+        size_t iMaxInd = 0;
+        size_t iMaxVal = 0;
+        const T *paSrcLine = paSrc;
+        for (int iY = 0; iY < nFactor; ++iY)
+        {
+            for (int iX = 0; iX < nFactor; ++iX)
+            {
+                const T val = paSrcLine[iX];
+                size_t i = 0;  // Used after for.
+
+                // Check array for existing entry.
+                for (; i < iMaxInd; ++i)
+                {
+                    if (IsSame(aVals[i], val) && ++anSums[i] > anSums[iMaxVal])
+                    {
+                        iMaxVal = i;
+                        break;
+                    }
+                }
+
+                // Add to arr if entry not already there.
+                if (i == iMaxInd)
+                {
+                    aVals[iMaxInd] = val;
+                    anSums[iMaxInd] = 1;
+                    ++iMaxInd;
+                }
+            }
+            paSrcLine += nSrcLineStride;
+        }
+        paDst[iDstPixel] = aVals[iMaxVal];
+        paSrc += nFactor;
+    }
+}
+
+/************************************************************************/
+/*               GDALGetDownsampleIntegerFactorFunction()               */
+/************************************************************************/
+
+/** Return a function that computes one line of a downsampling by an integer
+ * factor, for the cases where a specialized implementation exists.
+ *
+ * The returned function takes the factor, a pointer to the top-left pixel of
+ * the factor x factor source windows, the source line stride (in pixels), the
+ * number of destination pixels and the destination line (of type eDataType,
+ * packed). It does not handle nodata values or masks. Its output is the
+ * same as the one of the function returned by GDALGetResampleFunction() for
+ * that working data type.
+ *
+ * All non-complex data types are handled, provided that eDataType is the
+ * working data type returned by GDALGetOvrWorkDataType(): Byte, UInt16,
+ * Float32 and Float64 for AVERAGE and RMS, and any of them for MODE.
+ *
+ * @param pszResampling Resampling method: AVERAGE, RMS or MODE.
+ * @param eDataType Working data type, of both the source and the
+ * destination.
+ * @return a function, or nullptr if there is no specialized implementation.
+ */
+GDALDownsampleIntegerFactorFunction
+GDALGetDownsampleIntegerFactorFunction(const char *pszResampling,
+                                       GDALDataType eDataType)
+{
+    if (EQUAL(pszResampling, "AVERAGE"))
+    {
+        switch (eDataType)
+        {
+            case GDT_Byte:
+                return GDALDownsampleIntegerFactor_AverageOrRMS<GByte, int,
+                                                                GDT_Byte,
+                                                                false>;
+            case GDT_UInt16:
+                return GDALDownsampleIntegerFactor_AverageOrRMS<
+                    GUInt16, GUInt32, GDT_UInt16, false>;
+            case GDT_Float32:
+                return GDALDownsampleIntegerFactor_AverageOrRMS<
+                    float, double, GDT_Float32, false>;
+            case GDT_Float64:
+                return GDALDownsampleIntegerFactor_AverageOrRMS<
+                    double, double, GDT_Float64, false>;
+            default:
+                break;
+        }
+    }
+    else if (EQUAL(pszResampling, "RMS"))
+    {
+        switch (eDataType)
+        {
+            case GDT_Byte:
+                return GDALDownsampleIntegerFactor_AverageOrRMS<GByte, int,
+                                                                GDT_Byte, true>;
+            case GDT_UInt16:
+                // Use double as accumulation type, as UInt32 could overflow
+                return GDALDownsampleIntegerFactor_AverageOrRMS<
+                    GUInt16, double, GDT_UInt16, true>;
+            case GDT_Float32:
+                return GDALDownsampleIntegerFactor_AverageOrRMS<
+                    float, double, GDT_Float32, true>;
+            case GDT_Float64:
+                return GDALDownsampleIntegerFactor_AverageOrRMS<
+                    double, double, GDT_Float64, true>;
+            default:
+                break;
+        }
+    }
+    else if (EQUAL(pszResampling, "MODE"))
+    {
+        // As in GDALResampleChunk_Mode(), only the size of the data type
+        // matters, except for Byte and floating point values.
+        switch (eDataType)
+        {
+            case GDT_Byte:
+                return GDALDownsampleIntegerFactor_ModeByte;
+            case GDT_Int8:
+                return GDALDownsampleIntegerFactor_ModeT<int8_t>;
+            case GDT_Int16:
+            case GDT_UInt16:
+            case GDT_Float16:
+                return GDALDownsampleIntegerFactor_ModeT<uint16_t>;
+            case GDT_Int32:
+            case GDT_UInt32:
+                return GDALDownsampleIntegerFactor_ModeT<uint32_t>;
+            case GDT_Float32:
+                return GDALDownsampleIntegerFactor_ModeT<float>;
+            case GDT_Int64:
+            case GDT_UInt64:
+                return GDALDownsampleIntegerFactor_ModeT<uint64_t>;
+            case GDT_Float64:
+                return GDALDownsampleIntegerFactor_ModeT<double>;
+            default:
+                break;
+        }
+    }
+    return nullptr;
+}
+
 /************************************************************************/
 /*                  GDALResampleConvolutionHorizontal()                 */
 /************************************************************************/
@@ -50,6 +50,11 @@
 #define HAVE_SSE2
 #endif
 
+#if defined(HAVE_AVX2_AT_COMPILE_TIME) && (defined(__x86_64) || defined(_M_X64))
+#include "rasterio_avx2.h"
+#define HAVE_AVX2_DISPATCH
+#endif
+
 #ifdef HAVE_SSSE3_AT_COMPILE_TIME
 #include "rasterio_ssse3.h"
 #ifdef __SSSE3__
@@ -1011,6 +1016,103 @@ static int GDALRasterIOTransformer(void *pTransformerArg, int bDstToSrc,
     return TRUE;
 }
 
+/************************************************************************/
+/*                    DownsamplingIntegerFactor()                       */
+/************************************************************************/
+
+// Implements average, RMS and mode downsampling by an integer factor, on
+// bands without nodata or mask, by reading groups of source lines into a
+// single buffer and computing the destination lines directly in the user
+// buffer. This avoids the allocations and the MEM dataset of the generic
+// RasterIOResampled() code path. As in the generic code path, source pixels
+// are read as eWrkDataType, and the result is converted to the data type of
+// the band before being converted to eBufType.
+static CPLErr
+DownsamplingIntegerFactor(GDALRasterBand *poBand,
+                          GDALDownsampleIntegerFactorFunction pfnDownsample,
+                          GDALDataType eWrkDataType, int nFactor, int nXOff,
+                          int nYOff, int nXSize, void *pData, int nBufXSize,
+                          int nBufYSize, GDALDataType eBufType,
+                          GSpacing nPixelSpace, GSpacing nLineSpace,
+                          GDALRasterIOExtraArg *psExtraArg)
+{
+    const GDALDataType eDataType = poBand->GetRasterDataType();
+    const int nDTSize = GDALGetDataTypeSizeBytes(eDataType);
+    const int nWrkDTSize = GDALGetDataTypeSizeBytes(eWrkDataType);
+    const bool bSameWrkDataType = eWrkDataType == eDataType;
+    const bool bDirectOutput =
+        bSameWrkDataType && eBufType == eDataType && nPixelSpace == nDTSize;
+
+    // Read about one mega-pixel of source data at once, as the generic code.
+    const int nDstLinesPerChunk = static_cast<int>(std::clamp<GIntBig>(
+        1024 * 1024 / (static_cast<GIntBig>(nXSize) * nFactor), 1,
+        nBufYSize));
+
+    std::unique_ptr<void, VSIFreeReleaser> pSrcChunk(VSI_MALLOC3_VERBOSE(
+        nXSize, static_cast<size_t>(nDstLinesPerChunk) * nFactor,
+        nWrkDTSize));
+    std::unique_ptr<void, VSIFreeReleaser> pDstLine(
+        bDirectOutput ? nullptr : VSI_MALLOC2_VERBOSE(nBufXSize, nWrkDTSize));
+    std::unique_ptr<void, VSIFreeReleaser> pDstLineDT(
+        bSameWrkDataType ? nullptr : VSI_MALLOC2_VERBOSE(nBufXSize, nDTSize));
+    if (!pSrcChunk || (!bDirectOutput && !pDstLine) ||
+        (!bSameWrkDataType && !pDstLineDT))
+        return CE_Failure;
+
+    for (int iDstYOff = 0; iDstYOff < nBufYSize; iDstYOff += nDstLinesPerChunk)
+    {
+        const int nDstYCount =
+            std::min(nDstLinesPerChunk, nBufYSize - iDstYOff);
+        const int nSrcYCount = nDstYCount * nFactor;
+        if (poBand->RasterIO(GF_Read, nXOff, nYOff + iDstYOff * nFactor,
+                             nXSize, nSrcYCount, pSrcChunk.get(), nXSize,
+                             nSrcYCount, eWrkDataType, 0, 0,
+                             nullptr) != CE_None)
+        {
+            return CE_Failure;
+        }
+
+        for (int iDstY = 0; iDstY < nDstYCount; ++iDstY)
+        {
+            const GByte *pabySrc =
+                static_cast<const GByte *>(pSrcChunk.get()) +
+                static_cast<size_t>(iDstY) * nFactor * nXSize * nWrkDTSize;
+            GByte *pabyDst = static_cast<GByte *>(pData) +
+                             static_cast<GPtrDiff_t>(iDstYOff + iDstY) *
+                                 nLineSpace;
+            if (bDirectOutput)
+            {
+                pfnDownsample(nFactor, pabySrc, nXSize, nBufXSize, pabyDst);
+            }
+            else
+            {
+                pfnDownsample(nFactor, pabySrc, nXSize, nBufXSize,
+                              pDstLine.get());
+                const void *pLine = pDstLine.get();
+                if (!bSameWrkDataType)
+                {
+                    GDALCopyWords64(pDstLine.get(), eWrkDataType, nWrkDTSize,
+                                    pDstLineDT.get(), eDataType, nDTSize,
+                                    nBufXSize);
+                    pLine = pDstLineDT.get();
+                }
+                GDALCopyWords64(pLine, eDataType, nDTSize, pabyDst, eBufType,
+                                static_cast<int>(nPixelSpace), nBufXSize);
+            }
+        }
+
+        if (psExtraArg->pfnProgress != nullptr &&
+            !psExtraArg->pfnProgress(
+                1.0 * (iDstYOff + nDstYCount) / nBufYSize, "",
+                psExtraArg->pProgressData))
+        {
+            return CE_Failure;
+        }
+    }
+
+    return CE_None;
+}
+
 /************************************************************************/
 /*                          RasterIOResampled()                         */
 /************************************************************************/
@@ -1039,6 +1141,43 @@ CPLErr GDALRasterBand::RasterIOResampled(
         dfYSize = psExtraArg->dfYSize;
     }
 
+    // Fast path for average, RMS or mode downsampling by the same integer
+    // factor in both dimensions, of a band without nodata or mask.
+    const int nIntegerFactor = nXSize / nBufXSize;
+    if (!bUseWarp && nIntegerFactor >= 2 &&
+        nXSize == nIntegerFactor * nBufXSize &&
+        nYSize / nBufYSize == nIntegerFactor &&
+        nYSize == nIntegerFactor * nBufYSize && dfXOff == nXOff &&
+        dfYOff == nYOff && dfXSize == nXSize && dfYSize == nYSize &&
+        (psExtraArg->eResampleAlg == GRIORA_Average ||
+         psExtraArg->eResampleAlg == GRIORA_RMS ||
+         psExtraArg->eResampleAlg == GRIORA_Mode))
+    {
+        const bool bIsMode = psExtraArg->eResampleAlg == GRIORA_Mode;
+        const GDALColorTable *poColorTable = GetColorTable();
+        // Average and RMS on a paletted band operate on the colors.
+        const bool bColorTableCompatible =
+            poColorTable == nullptr ||
+            (bIsMode && poColorTable->GetColorEntryCount() <= 256);
+        const char *pszResampling =
+            psExtraArg->eResampleAlg == GRIORA_Average ? "AVERAGE"
+            : bIsMode                                  ? "MODE"
+                                                       : "RMS";
+        const GDALDataType eWrkDataType =
+            GDALGetOvrWorkDataType(pszResampling, eDataType);
+        const GDALDownsampleIntegerFactorFunction pfnDownsample =
+            GDALGetDownsampleIntegerFactorFunction(pszResampling,
+                                                   eWrkDataType);
+        if (pfnDownsample && bColorTableCompatible &&
+            GetMaskFlags() == GMF_ALL_VALID)
+        {
+            return DownsamplingIntegerFactor(
+                this, pfnDownsample, eWrkDataType, nIntegerFactor, nXOff,
+                nYOff, nXSize, pData, nBufXSize, nBufYSize, eBufType,
+                nPixelSpace, nLineSpace, psExtraArg);
+        }
+    }
+
     const double dfXRatioDstToSrc = dfXSize / nBufXSize;
     const double dfYRatioDstToSrc = dfYSize / nBufYSize;
 
@@ -2850,6 +2989,29 @@ CPL_NOINLINE void GDALCopyWordsT(const uint16_t *const CPL_RESTRICT pSrcData,
     }
 }
 
+#ifdef HAVE_AVX2_DISPATCH
+
+template <>
+CPL_NOINLINE void GDALCopyWordsT(const int32_t *const CPL_RESTRICT pSrcData,
+                                 int nSrcPixelStride,
+                                 float *const CPL_RESTRICT pDstData,
+                                 int nDstPixelStride, GPtrDiff_t nWordCount)
+{
+    if (nSrcPixelStride == static_cast<int>(sizeof(*pSrcData)) &&
+        nDstPixelStride == static_cast<int>(sizeof(*pDstData)) &&
+        CPLHaveRuntimeAVX2())
+    {
+        GDALCopyInt32ToFloat32_AVX2(pSrcData, pDstData, nWordCount);
+    }
+    else
+    {
+        GDALCopyWordsGenericT(pSrcData, nSrcPixelStride, pDstData,
+                              nDstPixelStride, nWordCount);
+    }
+}
+
+#endif  // HAVE_AVX2_DISPATCH
+
 template <>
 CPL_NOINLINE void GDALCopyWordsT(const int16_t *const CPL_RESTRICT pSrcData,
                                  int nSrcPixelStride,
@@ -2859,6 +3021,13 @@ CPL_NOINLINE void GDALCopyWordsT(const int16_t *const CPL_RESTRICT pSrcData,
     if (nSrcPixelStride == static_cast<int>(sizeof(*pSrcData)) &&
         nDstPixelStride == static_cast<int>(sizeof(*pDstData)))
     {
+#ifdef HAVE_AVX2_DISPATCH
+        if (CPLHaveRuntimeAVX2())
+        {
+            GDALCopyInt16ToFloat32_AVX2(pSrcData, pDstData, nWordCount);
+            return;
+        }
+#endif
         decltype(nWordCount) n = 0;
         GByte *CPL_RESTRICT pabyDstDataPtr =
             reinterpret_cast<GByte *>(pDstData);
@@ -2897,6 +3066,13 @@ CPL_NOINLINE void GDALCopyWordsT(const uint16_t *const CPL_RESTRICT pSrcData,
     if (nSrcPixelStride == static_cast<int>(sizeof(*pSrcData)) &&
         nDstPixelStride == static_cast<int>(sizeof(*pDstData)))
     {
+#ifdef HAVE_AVX2_DISPATCH
+        if (CPLHaveRuntimeAVX2())
+        {
+            GDALCopyUInt16ToFloat64_AVX2(pSrcData, pDstData, nWordCount);
+            return;
+        }
+#endif
         decltype(nWordCount) n = 0;
         const __m128i xmm_zero = _mm_setzero_si128();
         GByte *CPL_RESTRICT pabyDstDataPtr =
@@ -2996,6 +3172,15 @@ CPL_NOINLINE void GDALCopyWordsT(const double *const CPL_RESTRICT pSrcData,
                                  GByte *const CPL_RESTRICT pDstData,
                                  int nDstPixelStride, GPtrDiff_t nWordCount)
 {
+#ifdef HAVE_AVX2_DISPATCH
+    if (nSrcPixelStride == static_cast<int>(sizeof(*pSrcData)) &&
+        nDstPixelStride == static_cast<int>(sizeof(*pDstData)) &&
+        CPLHaveRuntimeAVX2())
+    {
+        GDALCopyFloat64ToByte_AVX2(pSrcData, pDstData, nWordCount);
+        return;
+    }
+#endif
     GDALCopyWordsT_8atatime(pSrcData, nSrcPixelStride, pDstData,
                             nDstPixelStride, nWordCount);
 }
@@ -6051,6 +6236,56 @@ static void GDALDeinterleave4Byte(const GByte *CPL_RESTRICT pabySrc,
 
 #endif
 
+/************************************************************************/
+/*                        GetSIMDInterleaveISA()                        */
+/************************************************************************/
+
+#if defined(HAVE_SSE2) && defined(HAVE_SSSE3_AT_COMPILE_TIME)
+
+namespace
+{
+enum class SIMDInterleaveISA
+{
+    NONE,
+    SSSE3,
+    AVX2
+};
+}  // namespace
+
+// Returns which of the generic shuffle-based (de)interleaving kernels of
+// rasterio_ssse3.cpp or rasterio_avx2.cpp can be used for nComponents words
+// of nWordSize bytes, if any.
+static SIMDInterleaveISA GetSIMDInterleaveISA(size_t nComponents,
+                                              int nWordSize)
+{
+    if (nComponents < 2 || nComponents > 8)
+        return SIMDInterleaveISA::NONE;
+
+#ifdef HAVE_AVX2_DISPATCH
+    if ((nWordSize == 1 || nWordSize == 2 || nWordSize == 4 ||
+         nWordSize == 8) &&
+        CPLHaveRuntimeAVX2())
+    {
+        return SIMDInterleaveISA::AVX2;
+    }
+#endif
+
+    // With 128-bit vectors, the number of shuffles needed per output vector
+    // grows with the pixel size, and beyond 12 bytes this is not faster
+    // than the scalar code.
+    if ((nWordSize == 1 ||
+         ((nWordSize == 2 || nWordSize == 4) &&
+          nComponents * nWordSize <= 12)) &&
+        CPLHaveRuntimeSSSE3())
+    {
+        return SIMDInterleaveISA::SSSE3;
+    }
+
+    return SIMDInterleaveISA::NONE;
+}
+
+#endif
+
 /************************************************************************/
 /*                      GDALDeinterleave()                              */
 /************************************************************************/
@@ -6066,7 +6301,8 @@ static void GDALDeinterleave4Byte(const GByte *CPL_RESTRICT pabySrc,
     \endverbatim
 
     The implementation is optimized for a few cases, like de-interleaving
-    of 3 or 4-components Byte buffers.
+    of 3 or 4-components Byte buffers, and, since GDAL 3.12, for 2 to 8
+    components of the same data type (SSSE3 or AVX2 shuffles).
 
     \since GDAL 3.6
  */
@@ -6151,6 +6387,30 @@ void GDALDeinterleave(const void *pSourceBuffer, GDALDataType eSourceDT,
 #endif
         }
 #endif
+
+#if defined(HAVE_SSE2) && defined(HAVE_SSSE3_AT_COMPILE_TIME)
+        const int nWordSize = GDALGetDataTypeSizeBytes(eSourceDT);
+        const auto eISA =
+            GetSIMDInterleaveISA(static_cast<size_t>(nComponents), nWordSize);
+        if (eISA != SIMDInterleaveISA::NONE)
+        {
+            const GByte *pabySrc = static_cast<const GByte *>(pSourceBuffer);
+            GByte *apabyDest[8];
+            for (int iComp = 0; iComp < nComponents; ++iComp)
+                apabyDest[iComp] = static_cast<GByte *>(ppDestBuffer[iComp]);
+#ifdef HAVE_AVX2_DISPATCH
+            if (eISA == SIMDInterleaveISA::AVX2)
+            {
+                GDALDeinterleave_AVX2(pabySrc, nComponents, nWordSize,
+                                      apabyDest, nIters);
+                return;
+            }
+#endif
+            GDALDeinterleave_SSSE3(pabySrc, nComponents, nWordSize, apabyDest,
+                                   nIters);
+            return;
+        }
+#endif
     }
 
     const int nSourceDTSize = GDALGetDataTypeSizeBytes(eSourceDT);
@@ -6581,7 +6841,9 @@ GDALInterleave4Byte(const uint8_t *CPL_RESTRICT pSrc,
 void GDALTranspose2D(const void *pSrc, GDALDataType eSrcType, void *pDst,
                      GDALDataType eDstType, size_t nSrcWidth, size_t nSrcHeight)
 {
-    if (eSrcType == eDstType && (eSrcType == GDT_Byte || eSrcType == GDT_Int8))
+    const bool bIsByte =
+        eSrcType == eDstType && (eSrcType == GDT_Byte || eSrcType == GDT_Int8);
+    if (bIsByte)
     {
         if (nSrcHeight == 2)
         {
@@ -6595,22 +6857,59 @@ void GDALTranspose2D(const void *pSrc, GDALDataType eSrcType, void *pDst,
                                 static_cast<uint8_t *>(pDst), nSrcWidth);
             return;
         }
+    }
+
+    // Whether the specialized GDALTranspose2D_Byte_SSSE3() can be used, in
+    // which case it is preferred to the generic interleaving kernels.
 #if (defined(HAVE_SSSE3_AT_COMPILE_TIME) &&                                    \
      (defined(__x86_64) || defined(_M_X64)))
-        if (CPLHaveRuntimeSSSE3())
-        {
-            GDALTranspose2D_Byte_SSSE3(static_cast<const uint8_t *>(pSrc),
-                                       static_cast<uint8_t *>(pDst), nSrcWidth,
-                                       nSrcHeight);
-            return;
-        }
+    const bool bUseTranspose2DByteSSSE3 = bIsByte && CPLHaveRuntimeSSSE3();
 #elif defined(USE_NEON_OPTIMIZATIONS)
+    const bool bUseTranspose2DByteSSSE3 = bIsByte;
+#else
+    constexpr bool bUseTranspose2DByteSSSE3 = false;
+#endif
+
+#if defined(HAVE_SSE2) && defined(HAVE_SSSE3_AT_COMPILE_TIME)
+    // Interleaving of a few components
+    if (eSrcType == eDstType && !bUseTranspose2DByteSSSE3)
+    {
+        const int nWordSize = GDALGetDataTypeSizeBytes(eSrcType);
+        const auto eISA = GetSIMDInterleaveISA(nSrcHeight, nWordSize);
+        if (eISA != SIMDInterleaveISA::NONE)
         {
-            GDALTranspose2D_Byte_SSSE3(static_cast<const uint8_t *>(pSrc),
-                                       static_cast<uint8_t *>(pDst), nSrcWidth,
-                                       nSrcHeight);
+            const int nComponents = static_cast<int>(nSrcHeight);
+            const GByte *apabySrc[8];
+            for (int iComp = 0; iComp < nComponents; ++iComp)
+            {
+                apabySrc[iComp] = static_cast<const GByte *>(pSrc) +
+                                  iComp * nSrcWidth * nWordSize;
+            }
+            GByte *pabyDst = static_cast<GByte *>(pDst);
+#ifdef HAVE_AVX2_DISPATCH
+            if (eISA == SIMDInterleaveISA::AVX2)
+            {
+                GDALInterleave_AVX2(apabySrc, nComponents, nWordSize, pabyDst,
+                                    nSrcWidth);
+                return;
+            }
+#endif
+            GDALInterleave_SSSE3(apabySrc, nComponents, nWordSize, pabyDst,
+                                 nSrcWidth);
             return;
         }
+    }
+#endif
+
+    if (bUseTranspose2DByteSSSE3)
+    {
+#if (defined(HAVE_SSSE3_AT_COMPILE_TIME) &&                                    \
+     (defined(__x86_64) || defined(_M_X64))) ||                                \
+    defined(USE_NEON_OPTIMIZATIONS)
+        GDALTranspose2D_Byte_SSSE3(static_cast<const uint8_t *>(pSrc),
+                                   static_cast<uint8_t *>(pDst), nSrcWidth,
+                                   nSrcHeight);
+        return;
 #endif
     }
 
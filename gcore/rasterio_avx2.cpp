@@ -0,0 +1,420 @@
+/******************************************************************************
+ *
+ * Project:  GDAL Core
+ * Purpose:  AVX2 specializations
+ * Author:   agent <agent at local>
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, agent <agent at local>
+ *
+ * SPDX-License-Identifier: MIT
+ ****************************************************************************/
+
+#include "cpl_port.h"
+
+#if defined(HAVE_AVX2_AT_COMPILE_TIME) && (defined(__x86_64) || defined(_M_X64))
+
+#include "rasterio_avx2.h"
+
+#include <immintrin.h>
+
+#include <cstring>
+
+#include "cpl_error.h"
+#include "gdal_priv_templates.hpp"
+
+/************************************************************************/
+/*                    GDALCopyInt16ToFloat32_AVX2()                     */
+/************************************************************************/
+
+void GDALCopyInt16ToFloat32_AVX2(const int16_t *CPL_RESTRICT pSrc,
+                                 float *CPL_RESTRICT pDst, GPtrDiff_t nIters)
+{
+    GPtrDiff_t n = 0;
+    for (; n < nIters - 15; n += 16)
+    {
+        const __m256i ymm =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pSrc + n));
+        const __m256i ymm0 = _mm256_cvtepi16_epi32(_mm256_castsi256_si128(ymm));
+        const __m256i ymm1 =
+            _mm256_cvtepi16_epi32(_mm256_extracti128_si256(ymm, 1));
+        _mm256_storeu_ps(pDst + n, _mm256_cvtepi32_ps(ymm0));
+        _mm256_storeu_ps(pDst + n + 8, _mm256_cvtepi32_ps(ymm1));
+    }
+    for (; n < nIters; n++)
+    {
+        pDst[n] = pSrc[n];
+    }
+}
+
+/************************************************************************/
+/*                    GDALCopyUInt16ToFloat64_AVX2()                    */
+/************************************************************************/
+
+void GDALCopyUInt16ToFloat64_AVX2(const uint16_t *CPL_RESTRICT pSrc,
+                                  double *CPL_RESTRICT pDst, GPtrDiff_t nIters)
+{
+    GPtrDiff_t n = 0;
+    for (; n < nIters - 15; n += 16)
+    {
+        const __m256i ymm =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pSrc + n));
+        // UInt16 values fit in Int32, so the signed Int32 to Float64
+        // conversion can be used.
+        const __m256i ymm0 = _mm256_cvtepu16_epi32(_mm256_castsi256_si128(ymm));
+        const __m256i ymm1 =
+            _mm256_cvtepu16_epi32(_mm256_extracti128_si256(ymm, 1));
+        _mm256_storeu_pd(pDst + n,
+                         _mm256_cvtepi32_pd(_mm256_castsi256_si128(ymm0)));
+        _mm256_storeu_pd(pDst + n + 4,
+                         _mm256_cvtepi32_pd(_mm256_extracti128_si256(ymm0, 1)));
+        _mm256_storeu_pd(pDst + n + 8,
+                         _mm256_cvtepi32_pd(_mm256_castsi256_si128(ymm1)));
+        _mm256_storeu_pd(pDst + n + 12,
+                         _mm256_cvtepi32_pd(_mm256_extracti128_si256(ymm1, 1)));
+    }
+    for (; n < nIters; n++)
+    {
+        pDst[n] = pSrc[n];
+    }
+}
+
+/************************************************************************/
+/*                    GDALCopyInt32ToFloat32_AVX2()                     */
+/************************************************************************/
+
+void GDALCopyInt32ToFloat32_AVX2(const int32_t *CPL_RESTRICT pSrc,
+                                 float *CPL_RESTRICT pDst, GPtrDiff_t nIters)
+{
+    GPtrDiff_t n = 0;
+    for (; n < nIters - 15; n += 16)
+    {
+        const __m256i ymm0 =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pSrc + n));
+        const __m256i ymm1 =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pSrc + n + 8));
+        // Rounds to nearest, as static_cast<float>() does.
+        _mm256_storeu_ps(pDst + n, _mm256_cvtepi32_ps(ymm0));
+        _mm256_storeu_ps(pDst + n + 8, _mm256_cvtepi32_ps(ymm1));
+    }
+    for (; n < nIters; n++)
+    {
+        pDst[n] = static_cast<float>(pSrc[n]);
+    }
+}
+
+/************************************************************************/
+/*                     GDALCopyFloat64ToByte_AVX2()                     */
+/************************************************************************/
+
+// Same semantics as GDALCopyWord<double, GByte>(): round to nearest (half
+// up), clamp to [0, 255] and map NaN to 0.
+static inline __m128i GDALCvt4Float64ToInt32_AVX2(const double *pSrc)
+{
+    const __m256d p0d5 = _mm256_set1_pd(0.5);
+    const __m256d ymm_max = _mm256_set1_pd(255);
+    __m256d ymm = _mm256_loadu_pd(pSrc);
+    ymm = _mm256_add_pd(ymm, p0d5);
+    // _mm256_max_pd() returns its second operand if one of them is NaN
+    ymm = _mm256_min_pd(_mm256_max_pd(ymm, p0d5), ymm_max);
+    return _mm256_cvttpd_epi32(ymm);
+}
+
+void GDALCopyFloat64ToByte_AVX2(const double *CPL_RESTRICT pSrc,
+                                uint8_t *CPL_RESTRICT pDst, GPtrDiff_t nIters)
+{
+    GPtrDiff_t n = 0;
+    for (; n < nIters - 15; n += 16)
+    {
+        const __m128i xmm0 = GDALCvt4Float64ToInt32_AVX2(pSrc + n);
+        const __m128i xmm1 = GDALCvt4Float64ToInt32_AVX2(pSrc + n + 4);
+        const __m128i xmm2 = GDALCvt4Float64ToInt32_AVX2(pSrc + n + 8);
+        const __m128i xmm3 = GDALCvt4Float64ToInt32_AVX2(pSrc + n + 12);
+        // Values are in [0, 255], so saturation does not kick in
+        const __m128i xmm01 = _mm_packs_epi32(xmm0, xmm1);
+        const __m128i xmm23 = _mm_packs_epi32(xmm2, xmm3);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(pDst + n),
+                         _mm_packus_epi16(xmm01, xmm23));
+    }
+    for (; n < nIters; n++)
+    {
+        GDALCopyWord(pSrc[n], pDst[n]);
+    }
+}
+
+/************************************************************************/
+/*                       GDALDeinterleave_AVX2()                        */
+/************************************************************************/
+
+// Same algorithm as GDALDeinterleaveNW_SSSE3(), except that each 128-bit
+// lane processes its own group of 16 / W pixels, as _mm256_shuffle_epi8()
+// does not cross lanes. The two lanes of an output vector are thus
+// contiguous in the destination buffer.
+template <int N, int W>
+static void GDALDeinterleaveNW_AVX2(const GByte *CPL_RESTRICT pabySrc,
+                                    GByte *const *ppabyDest, size_t nIters)
+{
+    constexpr int PIXEL_SIZE = N * W;
+    constexpr int PIXELS_PER_LANE = 16 / W;
+    constexpr int PIXELS_PER_ITER = 2 * PIXELS_PER_LANE;
+
+    __m256i aymmMask[N][N];
+    for (int iComp = 0; iComp < N; ++iComp)
+    {
+        for (int iVector = 0; iVector < N; ++iVector)
+        {
+            alignas(16) signed char achMask[16];
+            for (int iByte = 0; iByte < 16; ++iByte)
+            {
+                const int nSrcOffset =
+                    (iByte / W) * PIXEL_SIZE + iComp * W + iByte % W;
+                achMask[iByte] = nSrcOffset / 16 == iVector
+                                     ? static_cast<signed char>(nSrcOffset % 16)
+                                     : -1;
+            }
+            aymmMask[iComp][iVector] = _mm256_broadcastsi128_si256(
+                _mm_load_si128(reinterpret_cast<const __m128i *>(achMask)));
+        }
+    }
+
+    size_t i = 0;
+    for (; i + PIXELS_PER_ITER <= nIters; i += PIXELS_PER_ITER)
+    {
+        __m256i aymmSrc[N];
+        for (int iVector = 0; iVector < N; ++iVector)
+        {
+            const GByte *pabySrcVector =
+                pabySrc + i * PIXEL_SIZE + 16 * iVector;
+            aymmSrc[iVector] = _mm256_inserti128_si256(
+                _mm256_castsi128_si256(_mm_loadu_si128(
+                    reinterpret_cast<const __m128i *>(pabySrcVector))),
+                _mm_loadu_si128(reinterpret_cast<const __m128i *>(
+                    pabySrcVector + PIXELS_PER_LANE * PIXEL_SIZE)),
+                1);
+        }
+        for (int iComp = 0; iComp < N; ++iComp)
+        {
+            const int iFirstVector = (iComp * W) / 16;
+            const int iLastVector =
+                ((PIXELS_PER_LANE - 1) * PIXEL_SIZE + (iComp + 1) * W - 1) / 16;
+            __m256i ymm = _mm256_shuffle_epi8(aymmSrc[iFirstVector],
+                                              aymmMask[iComp][iFirstVector]);
+            for (int iVector = iFirstVector + 1; iVector <= iLastVector;
+                 ++iVector)
+            {
+                ymm = _mm256_or_si256(
+                    ymm, _mm256_shuffle_epi8(aymmSrc[iVector],
+                                             aymmMask[iComp][iVector]));
+            }
+            _mm256_storeu_si256(
+                reinterpret_cast<__m256i *>(ppabyDest[iComp] + i * W), ymm);
+        }
+    }
+    for (; i < nIters; ++i)
+    {
+        for (int iComp = 0; iComp < N; ++iComp)
+        {
+            memcpy(ppabyDest[iComp] + i * W,
+                   pabySrc + i * PIXEL_SIZE + iComp * W, W);
+        }
+    }
+}
+
+template <int N>
+static void GDALDeinterleaveN_AVX2(const GByte *CPL_RESTRICT pabySrc,
+                                   int nWordSize, GByte *const *ppabyDest,
+                                   size_t nIters)
+{
+    switch (nWordSize)
+    {
+        case 1:
+            GDALDeinterleaveNW_AVX2<N, 1>(pabySrc, ppabyDest, nIters);
+            break;
+        case 2:
+            GDALDeinterleaveNW_AVX2<N, 2>(pabySrc, ppabyDest, nIters);
+            break;
+        case 4:
+            GDALDeinterleaveNW_AVX2<N, 4>(pabySrc, ppabyDest, nIters);
+            break;
+        case 8:
+            GDALDeinterleaveNW_AVX2<N, 8>(pabySrc, ppabyDest, nIters);
+            break;
+        default:
+            CPLAssert(false);
+            break;
+    }
+}
+
+void GDALDeinterleave_AVX2(const GByte *CPL_RESTRICT pabySrc, int nComponents,
+                           int nWordSize, GByte *const *ppabyDest,
+                           size_t nIters)
+{
+    switch (nComponents)
+    {
+        case 2:
+            GDALDeinterleaveN_AVX2<2>(pabySrc, nWordSize, ppabyDest, nIters);
+            break;
+        case 3:
+            GDALDeinterleaveN_AVX2<3>(pabySrc, nWordSize, ppabyDest, nIters);
+            break;
+        case 4:
+            GDALDeinterleaveN_AVX2<4>(pabySrc, nWordSize, ppabyDest, nIters);
+            break;
+        case 5:
+            GDALDeinterleaveN_AVX2<5>(pabySrc, nWordSize, ppabyDest, nIters);
+            break;
+        case 6:
+            GDALDeinterleaveN_AVX2<6>(pabySrc, nWordSize, ppabyDest, nIters);
+            break;
+        case 7:
+            GDALDeinterleaveN_AVX2<7>(pabySrc, nWordSize, ppabyDest, nIters);
+            break;
+        case 8:
+            GDALDeinterleaveN_AVX2<8>(pabySrc, nWordSize, ppabyDest, nIters);
+            break;
+        default:
+            CPLAssert(false);
+            break;
+    }
+}
+
+/************************************************************************/
+/*                        GDALInterleave_AVX2()                         */
+/************************************************************************/
+
+// Reverse operation of GDALDeinterleaveNW_AVX2()
+template <int N, int W>
+static void GDALInterleaveNW_AVX2(const GByte *const *ppabySrc,
+                                  GByte *CPL_RESTRICT pabyDest, size_t nIters)
+{
+    constexpr int PIXEL_SIZE = N * W;
+    constexpr int PIXELS_PER_LANE = 16 / W;
+    constexpr int PIXELS_PER_ITER = 2 * PIXELS_PER_LANE;
+
+    __m256i aymmMask[N][N];
+    for (int iVector = 0; iVector < N; ++iVector)
+    {
+        for (int iComp = 0; iComp < N; ++iComp)
+        {
+            alignas(16) signed char achMask[16];
+            for (int iByte = 0; iByte < 16; ++iByte)
+            {
+                const int nDstOffset = 16 * iVector + iByte;
+                const int nOffsetInPixel = nDstOffset % PIXEL_SIZE;
+                const int nSrcOffset =
+                    (nDstOffset / PIXEL_SIZE) * W + nOffsetInPixel % W;
+                achMask[iByte] = nOffsetInPixel / W == iComp
+                                     ? static_cast<signed char>(nSrcOffset)
+                                     : -1;
+            }
+            aymmMask[iVector][iComp] = _mm256_broadcastsi128_si256(
+                _mm_load_si128(reinterpret_cast<const __m128i *>(achMask)));
+        }
+    }
+
+    size_t i = 0;
+    for (; i + PIXELS_PER_ITER <= nIters; i += PIXELS_PER_ITER)
+    {
+        __m256i aymmSrc[N];
+        for (int iComp = 0; iComp < N; ++iComp)
+        {
+            aymmSrc[iComp] = _mm256_loadu_si256(
+                reinterpret_cast<const __m256i *>(ppabySrc[iComp] + i * W));
+        }
+        GByte *pabyDestIter = pabyDest + i * PIXEL_SIZE;
+        for (int iVector = 0; iVector < N; ++iVector)
+        {
+            const int nFirstOffset = 16 * iVector;
+            const int nLastOffset = nFirstOffset + 15;
+            const bool bSinglePixel =
+                nFirstOffset / PIXEL_SIZE == nLastOffset / PIXEL_SIZE;
+            const int iFirstComp =
+                bSinglePixel ? (nFirstOffset % PIXEL_SIZE) / W : 0;
+            const int iLastComp =
+                bSinglePixel ? (nLastOffset % PIXEL_SIZE) / W : N - 1;
+            __m256i ymm = _mm256_shuffle_epi8(aymmSrc[iFirstComp],
+                                              aymmMask[iVector][iFirstComp]);
+            for (int iComp = iFirstComp + 1; iComp <= iLastComp; ++iComp)
+            {
+                ymm = _mm256_or_si256(
+                    ymm, _mm256_shuffle_epi8(aymmSrc[iComp],
+                                             aymmMask[iVector][iComp]));
+            }
+            _mm_storeu_si128(
+                reinterpret_cast<__m128i *>(pabyDestIter + 16 * iVector),
+                _mm256_castsi256_si128(ymm));
+            _mm_storeu_si128(
+                reinterpret_cast<__m128i *>(pabyDestIter +
+                                            PIXELS_PER_LANE * PIXEL_SIZE +
+                                            16 * iVector),
+                _mm256_extracti128_si256(ymm, 1));
+        }
+    }
+    for (; i < nIters; ++i)
+    {
+        for (int iComp = 0; iComp < N; ++iComp)
+        {
+            memcpy(pabyDest + i * PIXEL_SIZE + iComp * W,
+                   ppabySrc[iComp] + i * W, W);
+        }
+    }
+}
+
+template <int N>
+static void GDALInterleaveN_AVX2(const GByte *const *ppabySrc, int nWordSize,
+                                 GByte *CPL_RESTRICT pabyDest, size_t nIters)
+{
+    switch (nWordSize)
+    {
+        case 1:
+            GDALInterleaveNW_AVX2<N, 1>(ppabySrc, pabyDest, nIters);
+            break;
+        case 2:
+            GDALInterleaveNW_AVX2<N, 2>(ppabySrc, pabyDest, nIters);
+            break;
+        case 4:
+            GDALInterleaveNW_AVX2<N, 4>(ppabySrc, pabyDest, nIters);
+            break;
+        case 8:
+            GDALInterleaveNW_AVX2<N, 8>(ppabySrc, pabyDest, nIters);
+            break;
+        default:
+            CPLAssert(false);
+            break;
+    }
+}
+
+void GDALInterleave_AVX2(const GByte *const *ppabySrc, int nComponents,
+                         int nWordSize, GByte *CPL_RESTRICT pabyDest,
+                         size_t nIters)
+{
+    switch (nComponents)
+    {
+        case 2:
+            GDALInterleaveN_AVX2<2>(ppabySrc, nWordSize, pabyDest, nIters);
+            break;
+        case 3:
+            GDALInterleaveN_AVX2<3>(ppabySrc, nWordSize, pabyDest, nIters);
+            break;
+        case 4:
+            GDALInterleaveN_AVX2<4>(ppabySrc, nWordSize, pabyDest, nIters);
+            break;
+        case 5:
+            GDALInterleaveN_AVX2<5>(ppabySrc, nWordSize, pabyDest, nIters);
+            break;
+        case 6:
+            GDALInterleaveN_AVX2<6>(ppabySrc, nWordSize, pabyDest, nIters);
+            break;
+        case 7:
+            GDALInterleaveN_AVX2<7>(ppabySrc, nWordSize, pabyDest, nIters);
+            break;
+        case 8:
+            GDALInterleaveN_AVX2<8>(ppabySrc, nWordSize, pabyDest, nIters);
+            break;
+        default:
+            CPLAssert(false);
+            break;
+    }
+}
+
+#endif
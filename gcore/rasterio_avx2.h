@@ -0,0 +1,48 @@
+/******************************************************************************
+ *
+ * Project:  GDAL Core
+ * Purpose:  AVX2 specializations
+ * Author:   agent <agent at local>
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, agent <agent at local>
+ *
+ * SPDX-License-Identifier: MIT
+ ****************************************************************************/
+
+#ifndef RASTERIO_AVX2_H_INCLUDED
+#define RASTERIO_AVX2_H_INCLUDED
+
+#include "cpl_port.h"
+
+#include <cstdint>
+
+#if defined(HAVE_AVX2_AT_COMPILE_TIME) && (defined(__x86_64) || defined(_M_X64))
+
+// Those functions only handle packed arrays (pixel stride == type size).
+// They must only be called if CPLHaveRuntimeAVX2() is true.
+
+void GDALCopyInt16ToFloat32_AVX2(const int16_t *CPL_RESTRICT pSrc,
+                                 float *CPL_RESTRICT pDst, GPtrDiff_t nIters);
+
+void GDALCopyUInt16ToFloat64_AVX2(const uint16_t *CPL_RESTRICT pSrc,
+                                  double *CPL_RESTRICT pDst, GPtrDiff_t nIters);
+
+void GDALCopyInt32ToFloat32_AVX2(const int32_t *CPL_RESTRICT pSrc,
+                                 float *CPL_RESTRICT pDst, GPtrDiff_t nIters);
+
+void GDALCopyFloat64ToByte_AVX2(const double *CPL_RESTRICT pSrc,
+                                uint8_t *CPL_RESTRICT pDst, GPtrDiff_t nIters);
+
+// nComponents must be in [2, 8] and nWordSize in 1, 2, 4 or 8
+void GDALDeinterleave_AVX2(const GByte *CPL_RESTRICT pabySrc, int nComponents,
+                           int nWordSize, GByte *const *ppabyDest,
+                           size_t nIters);
+
+void GDALInterleave_AVX2(const GByte *const *ppabySrc, int nComponents,
+                         int nWordSize, GByte *CPL_RESTRICT pabyDest,
+                         size_t nIters);
+
+#endif
+
+#endif /* RASTERIO_AVX2_H_INCLUDED */
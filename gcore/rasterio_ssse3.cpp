@@ -11,8 +11,10 @@
  ****************************************************************************/
 
 #include "cpl_port.h"
+#include "cpl_error.h"
 
 #include <algorithm>
+#include <cstring>
 
 #if (defined(HAVE_SSSE3_AT_COMPILE_TIME) &&                                    \
      (defined(__x86_64) || defined(_M_X64))) ||                                \
@@ -767,4 +769,267 @@ void GDALTranspose2D_Byte_SSSE3(const uint8_t *CPL_RESTRICT pSrc,
     }
 }
 
+/************************************************************************/
+/*                       GDALDeinterleave_SSSE3()                       */
+/************************************************************************/
+
+// De-interleaving of N components of W bytes each.
+// Each iteration processes 16 / W pixels: the N input vectors are loaded,
+// and each output vector is assembled by OR'ing the _mm_shuffle_epi8() of
+// the input vectors that contain some of its bytes.
+template <int N, int W>
+static void GDALDeinterleaveNW_SSSE3(const GByte *CPL_RESTRICT pabySrc,
+                                     GByte *const *ppabyDest, size_t nIters)
+{
+    constexpr int PIXEL_SIZE = N * W;
+    constexpr int PIXELS_PER_ITER = 16 / W;
+
+    // Shuffle mask to extract from input vector iVector the bytes of
+    // component iComp
+    __m128i axmmMask[N][N];
+    for (int iComp = 0; iComp < N; ++iComp)
+    {
+        for (int iVector = 0; iVector < N; ++iVector)
+        {
+            alignas(16) signed char achMask[16];
+            for (int iByte = 0; iByte < 16; ++iByte)
+            {
+                const int nSrcOffset =
+                    (iByte / W) * PIXEL_SIZE + iComp * W + iByte % W;
+                achMask[iByte] = nSrcOffset / 16 == iVector
+                                     ? static_cast<signed char>(nSrcOffset % 16)
+                                     : -1;
+            }
+            axmmMask[iComp][iVector] =
+                _mm_load_si128(reinterpret_cast<const __m128i *>(achMask));
+        }
+    }
+
+    size_t i = 0;
+    for (; i + PIXELS_PER_ITER <= nIters; i += PIXELS_PER_ITER)
+    {
+        __m128i axmmSrc[N];
+        for (int iVector = 0; iVector < N; ++iVector)
+        {
+            axmmSrc[iVector] =
+                _mm_loadu_si128(reinterpret_cast<const __m128i *>(
+                    pabySrc + i * PIXEL_SIZE + 16 * iVector));
+        }
+        for (int iComp = 0; iComp < N; ++iComp)
+        {
+            // Range of input vectors containing bytes of iComp
+            const int iFirstVector = (iComp * W) / 16;
+            const int iLastVector =
+                ((PIXELS_PER_ITER - 1) * PIXEL_SIZE + (iComp + 1) * W - 1) / 16;
+            __m128i xmm = _mm_shuffle_epi8(axmmSrc[iFirstVector],
+                                           axmmMask[iComp][iFirstVector]);
+            for (int iVector = iFirstVector + 1; iVector <= iLastVector;
+                 ++iVector)
+            {
+                xmm = _mm_or_si128(xmm,
+                                   _mm_shuffle_epi8(axmmSrc[iVector],
+                                                    axmmMask[iComp][iVector]));
+            }
+            _mm_storeu_si128(
+                reinterpret_cast<__m128i *>(ppabyDest[iComp] + i * W), xmm);
+        }
+    }
+    for (; i < nIters; ++i)
+    {
+        for (int iComp = 0; iComp < N; ++iComp)
+        {
+            memcpy(ppabyDest[iComp] + i * W,
+                   pabySrc + i * PIXEL_SIZE + iComp * W, W);
+        }
+    }
+}
+
+template <int N>
+static void GDALDeinterleaveN_SSSE3(const GByte *CPL_RESTRICT pabySrc,
+                                    int nWordSize, GByte *const *ppabyDest,
+                                    size_t nIters)
+{
+    switch (nWordSize)
+    {
+        case 1:
+            GDALDeinterleaveNW_SSSE3<N, 1>(pabySrc, ppabyDest, nIters);
+            break;
+        case 2:
+            GDALDeinterleaveNW_SSSE3<N, 2>(pabySrc, ppabyDest, nIters);
+            break;
+        case 4:
+            GDALDeinterleaveNW_SSSE3<N, 4>(pabySrc, ppabyDest, nIters);
+            break;
+        default:
+            CPLAssert(false);
+            break;
+    }
+}
+
+void GDALDeinterleave_SSSE3(const GByte *CPL_RESTRICT pabySrc,
+                            int nComponents, int nWordSize,
+                            GByte *const *ppabyDest, size_t nIters)
+{
+    switch (nComponents)
+    {
+        case 2:
+            GDALDeinterleaveN_SSSE3<2>(pabySrc, nWordSize, ppabyDest, nIters);
+            break;
+        case 3:
+            GDALDeinterleaveN_SSSE3<3>(pabySrc, nWordSize, ppabyDest, nIters);
+            break;
+        case 4:
+            GDALDeinterleaveN_SSSE3<4>(pabySrc, nWordSize, ppabyDest, nIters);
+            break;
+        case 5:
+            GDALDeinterleaveN_SSSE3<5>(pabySrc, nWordSize, ppabyDest, nIters);
+            break;
+        case 6:
+            GDALDeinterleaveN_SSSE3<6>(pabySrc, nWordSize, ppabyDest, nIters);
+            break;
+        case 7:
+            GDALDeinterleaveN_SSSE3<7>(pabySrc, nWordSize, ppabyDest, nIters);
+            break;
+        case 8:
+            GDALDeinterleaveN_SSSE3<8>(pabySrc, nWordSize, ppabyDest, nIters);
+            break;
+        default:
+            CPLAssert(false);
+            break;
+    }
+}
+
+/************************************************************************/
+/*                        GDALInterleave_SSSE3()                        */
+/************************************************************************/
+
+// Reverse operation of GDALDeinterleaveNW_SSSE3(): each output vector is
+// assembled from the shuffled vectors of the components it contains.
+template <int N, int W>
+static void GDALInterleaveNW_SSSE3(const GByte *const *ppabySrc,
+                                   GByte *CPL_RESTRICT pabyDest, size_t nIters)
+{
+    constexpr int PIXEL_SIZE = N * W;
+    constexpr int PIXELS_PER_ITER = 16 / W;
+
+    // Shuffle mask to place the bytes of component iComp in output vector
+    // iVector
+    __m128i axmmMask[N][N];
+    for (int iVector = 0; iVector < N; ++iVector)
+    {
+        for (int iComp = 0; iComp < N; ++iComp)
+        {
+            alignas(16) signed char achMask[16];
+            for (int iByte = 0; iByte < 16; ++iByte)
+            {
+                const int nDstOffset = 16 * iVector + iByte;
+                const int nOffsetInPixel = nDstOffset % PIXEL_SIZE;
+                const int nSrcOffset =
+                    (nDstOffset / PIXEL_SIZE) * W + nOffsetInPixel % W;
+                achMask[iByte] = nOffsetInPixel / W == iComp
+                                     ? static_cast<signed char>(nSrcOffset)
+                                     : -1;
+            }
+            axmmMask[iVector][iComp] =
+                _mm_load_si128(reinterpret_cast<const __m128i *>(achMask));
+        }
+    }
+
+    size_t i = 0;
+    for (; i + PIXELS_PER_ITER <= nIters; i += PIXELS_PER_ITER)
+    {
+        __m128i axmmSrc[N];
+        for (int iComp = 0; iComp < N; ++iComp)
+        {
+            axmmSrc[iComp] = _mm_loadu_si128(
+                reinterpret_cast<const __m128i *>(ppabySrc[iComp] + i * W));
+        }
+        for (int iVector = 0; iVector < N; ++iVector)
+        {
+            // Range of components contained in iVector
+            const int nFirstOffset = 16 * iVector;
+            const int nLastOffset = nFirstOffset + 15;
+            const bool bSinglePixel =
+                nFirstOffset / PIXEL_SIZE == nLastOffset / PIXEL_SIZE;
+            const int iFirstComp =
+                bSinglePixel ? (nFirstOffset % PIXEL_SIZE) / W : 0;
+            const int iLastComp =
+                bSinglePixel ? (nLastOffset % PIXEL_SIZE) / W : N - 1;
+            __m128i xmm = _mm_shuffle_epi8(axmmSrc[iFirstComp],
+                                           axmmMask[iVector][iFirstComp]);
+            for (int iComp = iFirstComp + 1; iComp <= iLastComp; ++iComp)
+            {
+                xmm = _mm_or_si128(xmm,
+                                   _mm_shuffle_epi8(axmmSrc[iComp],
+                                                    axmmMask[iVector][iComp]));
+            }
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(
+                                 pabyDest + i * PIXEL_SIZE + 16 * iVector),
+                             xmm);
+        }
+    }
+    for (; i < nIters; ++i)
+    {
+        for (int iComp = 0; iComp < N; ++iComp)
+        {
+            memcpy(pabyDest + i * PIXEL_SIZE + iComp * W,
+                   ppabySrc[iComp] + i * W, W);
+        }
+    }
+}
+
+template <int N>
+static void GDALInterleaveN_SSSE3(const GByte *const *ppabySrc, int nWordSize,
+                                  GByte *CPL_RESTRICT pabyDest, size_t nIters)
+{
+    switch (nWordSize)
+    {
+        case 1:
+            GDALInterleaveNW_SSSE3<N, 1>(ppabySrc, pabyDest, nIters);
+            break;
+        case 2:
+            GDALInterleaveNW_SSSE3<N, 2>(ppabySrc, pabyDest, nIters);
+            break;
+        case 4:
+            GDALInterleaveNW_SSSE3<N, 4>(ppabySrc, pabyDest, nIters);
+            break;
+        default:
+            CPLAssert(false);
+            break;
+    }
+}
+
+void GDALInterleave_SSSE3(const GByte *const *ppabySrc, int nComponents,
+                          int nWordSize, GByte *CPL_RESTRICT pabyDest,
+                          size_t nIters)
+{
+    switch (nComponents)
+    {
+        case 2:
+            GDALInterleaveN_SSSE3<2>(ppabySrc, nWordSize, pabyDest, nIters);
+            break;
+        case 3:
+            GDALInterleaveN_SSSE3<3>(ppabySrc, nWordSize, pabyDest, nIters);
+            break;
+        case 4:
+            GDALInterleaveN_SSSE3<4>(ppabySrc, nWordSize, pabyDest, nIters);
+            break;
+        case 5:
+            GDALInterleaveN_SSSE3<5>(ppabySrc, nWordSize, pabyDest, nIters);
+            break;
+        case 6:
+            GDALInterleaveN_SSSE3<6>(ppabySrc, nWordSize, pabyDest, nIters);
+            break;
+        case 7:
+            GDALInterleaveN_SSSE3<7>(ppabySrc, nWordSize, pabyDest, nIters);
+            break;
+        case 8:
+            GDALInterleaveN_SSSE3<8>(ppabySrc, nWordSize, pabyDest, nIters);
+            break;
+        default:
+            CPLAssert(false);
+            break;
+    }
+}
+
 #endif  // HAVE_SSSE3_AT_COMPILE_TIME
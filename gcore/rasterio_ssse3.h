@@ -54,6 +54,15 @@ void GDALDeinterleave4UInt16_SSSE3(const GUInt16 *CPL_RESTRICT panSrc,
                                    size_t nIters);
 #endif
 
+// nComponents must be in [2, 8] and nWordSize in 1, 2 or 4
+void GDALDeinterleave_SSSE3(const GByte *CPL_RESTRICT pabySrc,
+                            int nComponents, int nWordSize,
+                            GByte *const *ppabyDest, size_t nIters);
+
+void GDALInterleave_SSSE3(const GByte *const *ppabySrc, int nComponents,
+                          int nWordSize, GByte *CPL_RESTRICT pabyDest,
+                          size_t nIters);
+
 void GDALTranspose2D_Byte_SSSE3(const uint8_t *CPL_RESTRICT pSrc,
                                 uint8_t *CPL_RESTRICT pDst, size_t nSrcWidth,
                                 size_t nSrcHeight);
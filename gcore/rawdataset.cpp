@@ -193,6 +193,13 @@ RawRasterBand::RawRasterBand(VSILFILE *fpRawLIn, vsi_l_offset nImgOffsetIn,
 void RawRasterBand::Initialize()
 
 {
+    const char *pszVirtualMemIO =
+        CPLGetConfigOption("RAW_VIRTUAL_MEM_IO", "NO");
+    if (EQUAL(pszVirtualMemIO, "IF_ENOUGH_RAM"))
+        m_eVirtualMemIOUsage = VirtualMemIOEnum::IF_ENOUGH_RAM;
+    else if (CPLTestBool(pszVirtualMemIO))
+        m_eVirtualMemIOUsage = VirtualMemIOEnum::YES;
+
     vsi_l_offset nSmallestOffset = nImgOffset;
     vsi_l_offset nLargestOffset = nImgOffset;
     if (nLineOffset < 0)
@@ -322,6 +329,9 @@ RawRasterBand::~RawRasterBand()
 
     RawRasterBand::FlushCache(true);
 
+    if (m_psVirtualMemIOMapping)
+        CPLVirtualMemFree(m_psVirtualMemIOMapping);
+
     if (bOwnsFP)
     {
         if (VSIFCloseL(fpRawL) != 0)
@@ -1069,6 +1079,15 @@ CPLErr RawRasterBand::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
 #endif
     const int nBufDataSize = GDALGetDataTypeSizeBytes(eBufType);
 
+    if (CanUseVirtualMemIO(eRWFlag, nXSize, nYSize, nBufXSize, nBufYSize,
+                           psExtraArg))
+    {
+        const int nErr = VirtualMemIO(nXOff, nYOff, nXSize, nYSize, pData,
+                                      eBufType, nPixelSpace, nLineSpace);
+        if (nErr >= 0)
+            return static_cast<CPLErr>(nErr);
+    }
+
     if (!CanUseDirectIO(nXOff, nYOff, nXSize, nYSize, eBufType, psExtraArg))
     {
         return GDALRasterBand::IRasterIO(eRWFlag, nXOff, nYOff, nXSize, nYSize,
@@ -1495,6 +1514,139 @@ GDALColorInterp RawRasterBand::GetColorInterpretation()
     return eInterp;
 }
 
+/************************************************************************/
+/*                          GetMetadataItem()                           */
+/************************************************************************/
+
+const char *RawRasterBand::GetMetadataItem(const char *pszName,
+                                           const char *pszDomain)
+{
+    // For testing purposes
+    if (pszName && pszDomain && EQUAL(pszDomain, "_DEBUG_") &&
+        EQUAL(pszName, "VIRTUAL_MEM_IO_COUNT"))
+    {
+        return CPLSPrintf(CPL_FRMT_GUIB, m_nVirtualMemIOCount);
+    }
+    return GDALPamRasterBand::GetMetadataItem(pszName, pszDomain);
+}
+
+/************************************************************************/
+/*                        GetVirtualMemIOMapping()                      */
+/************************************************************************/
+
+// Returns a read-only memory mapping of the whole file, created on first use,
+// or nullptr if it cannot be established.
+const GByte *RawRasterBand::GetVirtualMemIOMapping(size_t &nMappingSize)
+{
+    // Bands of the same file share the mapping of the first band
+    if (nBand > 1 && poDS != nullptr)
+    {
+        auto poFirstBand =
+            dynamic_cast<RawRasterBand *>(poDS->GetRasterBand(1));
+        if (poFirstBand != nullptr && poFirstBand->fpRawL == fpRawL)
+            return poFirstBand->GetVirtualMemIOMapping(nMappingSize);
+    }
+
+    if (m_psVirtualMemIOMapping == nullptr)
+    {
+        if (m_eVirtualMemIOUsage == VirtualMemIOEnum::NO ||
+            !CPLIsVirtualMemFileMapAvailable() ||
+            VSIFGetNativeFileDescriptorL(fpRawL) == nullptr ||
+            VSIFSeekL(fpRawL, 0, SEEK_END) != 0)
+        {
+            m_eVirtualMemIOUsage = VirtualMemIOEnum::NO;
+            return nullptr;
+        }
+        const vsi_l_offset nLength = VSIFTellL(fpRawL);
+        if (nLength == 0 || static_cast<size_t>(nLength) != nLength)
+        {
+            m_eVirtualMemIOUsage = VirtualMemIOEnum::NO;
+            return nullptr;
+        }
+        if (m_eVirtualMemIOUsage == VirtualMemIOEnum::IF_ENOUGH_RAM &&
+            static_cast<GIntBig>(nLength) > CPLGetUsablePhysicalRAM())
+        {
+            CPLDebug("RAW", "Not enough RAM to map whole file into memory.");
+            m_eVirtualMemIOUsage = VirtualMemIOEnum::NO;
+            return nullptr;
+        }
+        m_psVirtualMemIOMapping = CPLVirtualMemFileMapNew(
+            fpRawL, 0, nLength, VIRTUALMEM_READONLY, nullptr, nullptr);
+        if (m_psVirtualMemIOMapping == nullptr)
+        {
+            m_eVirtualMemIOUsage = VirtualMemIOEnum::NO;
+            return nullptr;
+        }
+        m_eVirtualMemIOUsage = VirtualMemIOEnum::YES;
+    }
+
+    nMappingSize = CPLVirtualMemGetSize(m_psVirtualMemIOMapping);
+    return static_cast<const GByte *>(
+        CPLVirtualMemGetAddr(m_psVirtualMemIOMapping));
+}
+
+/************************************************************************/
+/*                         CanUseVirtualMemIO()                         */
+/************************************************************************/
+
+bool RawRasterBand::CanUseVirtualMemIO(
+    GDALRWFlag eRWFlag, int nXSize, int nYSize, int nBufXSize, int nBufYSize,
+    const GDALRasterIOExtraArg *psExtraArg) const
+{
+    // The mapping is read-only, and would not reflect pending writes.
+    return m_eVirtualMemIOUsage != VirtualMemIOEnum::NO &&
+           eRWFlag == GF_Read && eAccess == GA_ReadOnly &&
+           nXSize == nBufXSize && nYSize == nBufYSize &&
+           psExtraArg->eResampleAlg == GRIORA_NearestNeighbour &&
+           !NeedsByteOrderChange();
+}
+
+/************************************************************************/
+/*                            VirtualMemIO()                            */
+/************************************************************************/
+
+// Read a window directly from a memory mapping of the file into the user
+// buffer, thus bypassing both the block cache and the read() system calls.
+// Returns -1 if that cannot be done, or a CPLErr value otherwise.
+int RawRasterBand::VirtualMemIO(int nXOff, int nYOff, int nXSize, int nYSize,
+                                void *pData, GDALDataType eBufType,
+                                GSpacing nPixelSpace, GSpacing nLineSpace)
+{
+    size_t nMappingSize = 0;
+    const GByte *pabyMapping = GetVirtualMemIOMapping(nMappingSize);
+    if (pabyMapping == nullptr)
+        return -1;
+
+    // Check that the window fully lies in the file. Otherwise the regular
+    // code path takes care of zero-filling missing data.
+    const int nDTSize = GDALGetDataTypeSizeBytes(eDataType);
+    const GIntBig nFirstPixel = static_cast<GIntBig>(nImgOffset) +
+                                static_cast<GIntBig>(nYOff) * nLineOffset +
+                                static_cast<GIntBig>(nXOff) * nPixelOffset;
+    const GIntBig nLastLineDelta =
+        static_cast<GIntBig>(nYSize - 1) * nLineOffset;
+    const GIntBig nLastPixelDelta =
+        static_cast<GIntBig>(nXSize - 1) * nPixelOffset;
+    const GIntBig nMin = nFirstPixel + std::min<GIntBig>(0, nLastLineDelta) +
+                         std::min<GIntBig>(0, nLastPixelDelta);
+    const GIntBig nMax = nFirstPixel + std::max<GIntBig>(0, nLastLineDelta) +
+                         std::max<GIntBig>(0, nLastPixelDelta) + nDTSize;
+    if (nMin < 0 || static_cast<uint64_t>(nMax) > nMappingSize)
+        return -1;
+
+    CPLDebugOnly("RAW", "Using VirtualMemIO");
+    ++m_nVirtualMemIOCount;
+    for (int iY = 0; iY < nYSize; ++iY)
+    {
+        GDALCopyWords64(pabyMapping + nFirstPixel +
+                            static_cast<GIntBig>(iY) * nLineOffset,
+                        eDataType, nPixelOffset,
+                        static_cast<GByte *>(pData) + iY * nLineSpace,
+                        eBufType, static_cast<int>(nPixelSpace), nXSize);
+    }
+    return CE_None;
+}
+
 /************************************************************************/
 /*                           GetVirtualMemAuto()                        */
 /************************************************************************/
@@ -1613,7 +1765,10 @@ CPLErr RawDataset::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
                 break;
             }
             else if (!poBand->CanUseDirectIO(nXOff, nYOff, nXSize, nYSize,
-                                             eBufType, psExtraArg))
+                                             eBufType, psExtraArg) &&
+                     !poBand->CanUseVirtualMemIO(eRWFlag, nXSize, nYSize,
+                                                 nBufXSize, nBufYSize,
+                                                 psExtraArg))
             {
                 bCanUseDirectIO = false;
                 if (!bCanDirectAccessToBIPDataset)
@@ -1662,19 +1817,35 @@ CPLErr RawDataset::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
             const int nDTSize = GDALGetDataTypeSizeBytes(eDT);
             const bool bNeedsByteOrderChange =
                 poFirstBand->NeedsByteOrderChange();
+            size_t nMappingSize = 0;
+            const GByte *pabyMapping =
+                poFirstBand->CanUseVirtualMemIO(eRWFlag, nXSize, nYSize,
+                                                nBufXSize, nBufYSize,
+                                                psExtraArg)
+                    ? poFirstBand->GetVirtualMemIOMapping(nMappingSize)
+                    : nullptr;
             for (int iY = 0; iY < nYSize; ++iY)
             {
                 GByte *pabyOut = static_cast<GByte *>(pData) + iY * nLineSpace;
-                VSIFSeekL(poFirstBand->fpRawL,
-                          poFirstBand->nImgOffset +
-                              static_cast<vsi_l_offset>(nYOff + iY) *
-                                  poFirstBand->nLineOffset +
-                              static_cast<vsi_l_offset>(nXOff) *
-                                  poFirstBand->nPixelOffset,
-                          SEEK_SET);
-                if (VSIFReadL(pabyOut,
-                              static_cast<size_t>(nXSize * nPixelSpace), 1,
-                              poFirstBand->fpRawL) != 1)
+                const vsi_l_offset nLineStartOffset =
+                    poFirstBand->nImgOffset +
+                    static_cast<vsi_l_offset>(nYOff + iY) *
+                        poFirstBand->nLineOffset +
+                    static_cast<vsi_l_offset>(nXOff) *
+                        poFirstBand->nPixelOffset;
+                const size_t nLineBytes =
+                    static_cast<size_t>(nXSize * nPixelSpace);
+                if (pabyMapping &&
+                    nLineStartOffset + nLineBytes <= nMappingSize)
+                {
+                    if (iY == 0)
+                        ++poFirstBand->m_nVirtualMemIOCount;
+                    memcpy(pabyOut, pabyMapping + nLineStartOffset, nLineBytes);
+                    continue;
+                }
+                VSIFSeekL(poFirstBand->fpRawL, nLineStartOffset, SEEK_SET);
+                if (VSIFReadL(pabyOut, nLineBytes, 1, poFirstBand->fpRawL) !=
+                    1)
                 {
                     return CE_Failure;
                 }
@@ -192,6 +192,9 @@ class CPL_DLL RawRasterBand : public GDALPamRasterBand
     char **GetCategoryNames() override;
     CPLErr SetCategoryNames(char **) override;
 
+    const char *GetMetadataItem(const char *pszName,
+                                const char *pszDomain = "") override;
+
     CPLErr FlushCache(bool bAtClosing) override;
 
     CPLVirtualMem *GetVirtualMemAuto(GDALRWFlag eRWFlag, int *pnPixelSpace,
@@ -239,6 +242,26 @@ class CPL_DLL RawRasterBand : public GDALPamRasterBand
   private:
     CPL_DISALLOW_COPY_ASSIGN(RawRasterBand)
 
+    enum class VirtualMemIOEnum
+    {
+        NO,
+        YES,
+        IF_ENOUGH_RAM
+    };
+
+    VirtualMemIOEnum m_eVirtualMemIOUsage = VirtualMemIOEnum::NO;
+    CPLVirtualMem *m_psVirtualMemIOMapping = nullptr;
+    // Number of RasterIO() requests served from the mapping, for testing
+    GUIntBig m_nVirtualMemIOCount = 0;
+
+    const GByte *GetVirtualMemIOMapping(size_t &nMappingSize);
+    bool CanUseVirtualMemIO(GDALRWFlag eRWFlag, int nXSize, int nYSize,
+                            int nBufXSize, int nBufYSize,
+                            const GDALRasterIOExtraArg *psExtraArg) const;
+    int VirtualMemIO(int nXOff, int nYOff, int nXSize, int nYSize, void *pData,
+                     GDALDataType eBufType, GSpacing nPixelSpace,
+                     GSpacing nLineSpace);
+
     bool NeedsByteOrderChange() const;
     void DoByteSwap(void *pBuffer, size_t nValues, int nByteSkip,
                     bool bDiskToCPU) const;
@@ -1,6 +1,11 @@
 # SPDX-License-Identifier: MIT
 # Copyright 2021 Even Rouault
 
+# Typical use:
+# python computestatistics.py
+# python computestatistics.py 1 2 4 8   (values of GDAL_NUM_THREADS to test)
+
+import sys
 import timeit
 
 from osgeo import gdal
@@ -21,25 +26,53 @@ def test(dt):
     tab_ds[dt].GetRasterBand(1).ComputeStatistics(False)
 
 
+def test_minmax(dt):
+    tab_ds[dt].GetRasterBand(1).ComputeRasterMinMax(False)
+
+
+def test_histogram(dt):
+    tab_ds[dt].GetRasterBand(1).GetHistogram(
+        -0.5, 255.5, 256, include_out_of_range=1, approx_ok=0
+    )
+
+
 NITERS = 500
-setup = "from osgeo import gdal; from __main__ import test"
-print(
-    "testByte(): %.3f"
-    % timeit.timeit("test(gdal.GDT_Byte)", setup=setup, number=NITERS)
-)
-print(
-    "testUInt16(): %.3f"
-    % timeit.timeit("test(gdal.GDT_UInt16)", setup=setup, number=NITERS)
-)
-print(
-    "testInt16(): %.3f"
-    % timeit.timeit("test(gdal.GDT_Int16)", setup=setup, number=NITERS)
-)
-print(
-    "testFloat32(): %.3f"
-    % timeit.timeit("test(gdal.GDT_Float32)", setup=setup, number=NITERS)
-)
-print(
-    "testFloat64(): %.3f"
-    % timeit.timeit("test(gdal.GDT_Float64)", setup=setup, number=NITERS)
-)
+setup = "from osgeo import gdal; from __main__ import test, test_minmax, test_histogram"
+
+num_threads = sys.argv[1:] if len(sys.argv) > 1 else ["1", "ALL_CPUS"]
+for threads in num_threads:
+    print("GDAL_NUM_THREADS=%s" % threads)
+    with gdal.config_option("GDAL_NUM_THREADS", threads):
+        for name in ("Byte", "UInt16", "Int16", "Float32", "Float64"):
+            print(
+                "test%s(): %.3f"
+                % (
+                    name,
+                    timeit.timeit(
+                        "test(gdal.GDT_%s)" % name, setup=setup, number=NITERS
+                    ),
+                )
+            )
+        for name in ("Byte", "Float32"):
+            print(
+                "test_minmax%s(): %.3f"
+                % (
+                    name,
+                    timeit.timeit(
+                        "test_minmax(gdal.GDT_%s)" % name,
+                        setup=setup,
+                        number=NITERS,
+                    ),
+                )
+            )
+            print(
+                "test_histogram%s(): %.3f"
+                % (
+                    name,
+                    timeit.timeit(
+                        "test_histogram(gdal.GDT_%s)" % name,
+                        setup=setup,
+                        number=NITERS,
+                    ),
+                )
+            )
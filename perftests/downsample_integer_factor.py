@@ -119,6 +119,14 @@ def testRMSFloat32(downsampling_factor):
     )
 
 
+def testMode(downsampling_factor):
+    ds.ReadRaster(
+        buf_xsize=ds.RasterXSize // downsampling_factor,
+        buf_ysize=ds.RasterYSize // downsampling_factor,
+        resample_alg=gdal.GRIORA_Mode,
+    )
+
+
 def testCubic(downsampling_factor):
     ds.ReadRaster(
         buf_xsize=ds.RasterXSize // downsampling_factor,
@@ -207,6 +215,12 @@ print(
         "testAverage(4)", setup="from __main__ import testAverage", number=NITERS
     )
 )
+print(
+    "testAverage(8): %.3f"
+    % timeit.timeit(
+        "testAverage(8)", setup="from __main__ import testAverage", number=NITERS
+    )
+)
 print(
     "testAverageNoData(4): %.3f"
     % timeit.timeit(
@@ -225,6 +239,32 @@ print(
     % timeit.timeit("testRMS(4)", setup="from __main__ import testRMS", number=NITERS)
 )
 
+print(
+    "testAverageUInt16(4): %.3f"
+    % timeit.timeit(
+        "testAverageUInt16(4)",
+        setup="from __main__ import testAverageUInt16",
+        number=NITERS,
+    )
+)
+print(
+    "testAverageFloat32(4): %.3f"
+    % timeit.timeit(
+        "testAverageFloat32(4)",
+        setup="from __main__ import testAverageFloat32",
+        number=NITERS,
+    )
+)
+
+print(
+    "testMode(2): %.3f"
+    % timeit.timeit("testMode(2)", setup="from __main__ import testMode", number=NITERS)
+)
+print(
+    "testMode(4): %.3f"
+    % timeit.timeit("testMode(4)", setup="from __main__ import testMode", number=NITERS)
+)
+
 print(
     "testCubic(2): %.3f"
     % timeit.timeit(
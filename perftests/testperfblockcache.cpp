@@ -0,0 +1,147 @@
+/******************************************************************************
+ *
+ * Project:  GDAL Core
+ * Purpose:  Test scalability of the global raster block cache with the
+ *           number of threads.
+ * Author:   agent <agent at local>
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, agent <agent at local>
+ *
+ * SPDX-License-Identifier: MIT
+ ****************************************************************************/
+
+// Typical use:
+// testperfblockcache
+// testperfblockcache --config GDAL_BLOCK_CACHE_SHARDS ALL_CPUS
+// testperfblockcache --config GDAL_BLOCK_CACHE_POLICY 2Q
+
+#include "gdal_priv.h"
+#include "cpl_conv.h"
+#include "cpl_string.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+static void Usage()
+{
+    printf("Usage: testperfblockcache [-max_threads X] [-iters X] "
+           "[-size X] [-cache_ratio X]\n");
+    exit(1);
+}
+
+int main(int argc, char *argv[])
+{
+    GDALAllRegister();
+    argc = GDALGeneralCmdLineProcessor(argc, &argv, 0);
+    if (argc < 1)
+        return 1;
+
+    int nMaxThreads = CPLGetNumCPUs();
+    int nIters = 1000 * 1000;
+    int nSize = 2048;
+    // Fraction of the total size of the datasets that fit in the cache
+    double dfCacheRatio = 0.5;
+    for (int i = 1; i < argc; i++)
+    {
+        if (EQUAL(argv[i], "-max_threads") && i + 1 < argc)
+            nMaxThreads = atoi(argv[++i]);
+        else if (EQUAL(argv[i], "-iters") && i + 1 < argc)
+            nIters = atoi(argv[++i]);
+        else if (EQUAL(argv[i], "-size") && i + 1 < argc)
+            nSize = atoi(argv[++i]);
+        else if (EQUAL(argv[i], "-cache_ratio") && i + 1 < argc)
+            dfCacheRatio = CPLAtof(argv[++i]);
+        else
+            Usage();
+    }
+    CSLDestroy(argv);
+    if (nMaxThreads <= 0 || nIters <= 0 || nSize <= 0 || dfCacheRatio <= 0)
+        Usage();
+
+    auto poDriver = GetGDALDriverManager()->GetDriverByName("MEM");
+    if (!poDriver)
+    {
+        fprintf(stderr, "MEM driver missing\n");
+        return 1;
+    }
+
+    // One dataset per thread, so that threads do not contend on the
+    // per-band block cache, but only on the global one.
+    std::vector<std::unique_ptr<GDALDataset>> apoDS;
+    for (int i = 0; i < nMaxThreads; ++i)
+    {
+        apoDS.emplace_back(
+            poDriver->Create("", nSize, nSize, 1, GDT_Byte, nullptr));
+        if (!apoDS.back())
+            return 1;
+    }
+
+    printf("GDAL_BLOCK_CACHE_SHARDS = %s\n",
+           CPLGetConfigOption("GDAL_BLOCK_CACHE_SHARDS", "1"));
+    printf("GDAL_BLOCK_CACHE_POLICY = %s\n",
+           CPLGetConfigOption("GDAL_BLOCK_CACHE_POLICY", "LRU"));
+
+    for (int nThreads = 1; nThreads <= nMaxThreads;
+         nThreads = (nThreads == nMaxThreads)
+                        ? nThreads + 1
+                        : std::min(nThreads * 2, nMaxThreads))
+    {
+        // Scale the cache with the number of active threads, so that each
+        // of them experiences the same hit ratio.
+        GDALSetCacheMax64(static_cast<GIntBig>(
+            dfCacheRatio * nThreads * static_cast<double>(nSize) * nSize));
+
+        GDALResetCacheStatistics();
+        const auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> aoThreads;
+        for (int iThread = 0; iThread < nThreads; ++iThread)
+        {
+            aoThreads.emplace_back(
+                [&apoDS, iThread, nIters, nSize]()
+                {
+                    GDALRasterBand *poBand =
+                        apoDS[iThread]->GetRasterBand(1);
+                    std::mt19937 oGenerator(iThread);
+                    std::uniform_int_distribution<int> oDist(0, nSize - 1);
+                    for (int i = 0; i < nIters; ++i)
+                    {
+                        GDALRasterBlock *poBlock =
+                            poBand->GetLockedBlockRef(0, oDist(oGenerator));
+                        if (poBlock)
+                            poBlock->DropLock();
+                    }
+                });
+        }
+        for (auto &oThread : aoThreads)
+            oThread.join();
+        const double dfElapsed =
+            std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                          start)
+                .count();
+
+        GIntBig nHits = 0;
+        GIntBig nMisses = 0;
+        GDALGetCacheStatistics(&nHits, &nMisses, nullptr);
+        printf("%d thread(s): %.2f s, %.2f Mblocks/s, hit ratio = %.1f %%\n",
+               nThreads, dfElapsed,
+               static_cast<double>(nIters) * nThreads / dfElapsed / 1e6,
+               100.0 * static_cast<double>(nHits) /
+                   static_cast<double>(std::max<GIntBig>(1, nHits + nMisses)));
+
+        for (auto &poDS : apoDS)
+            poDS->FlushCache(false);
+        GDALSetCacheMax64(0);
+    }
+
+    apoDS.clear();
+    GDALDestroyDriverManager();
+
+    return 0;
+}
@@ -0,0 +1,279 @@
+/******************************************************************************
+ *
+ * Project:  CPL - Common Portability Library
+ * Purpose:  Test performance of the builtin compressors and decompressors
+ *           of the CPLCompressor registry.
+ * Author:   agent <agent at local>
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, agent <agent at local>
+ *
+ * SPDX-License-Identifier: MIT
+ ****************************************************************************/
+
+// Typical use:
+// testperfcompressor -codec zstd -size 256 -chunk 256 -threads 8
+//
+// For each codec, a buffer of -size MB is compressed and decompressed:
+// - chunk by chunk (chunks of -chunk KB, as tiles of a raster), sequentially;
+// - chunk by chunk, with concurrent calls from -threads threads;
+// - in a single call with the NUM_THREADS=-threads option, for codecs that
+//   advertise the PREFERRED_CHUNK_SIZE metadata item.
+// By default, the buffer contains synthetic data (smooth gradients with some
+// noise). -file can be used to use the first -size MB of a given file instead.
+
+#include "cpl_compressor.h"
+#include "cpl_conv.h"
+#include "cpl_string.h"
+#include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+static void Usage()
+{
+    printf("Usage: testperfcompressor [-codec X]* [-size X] [-chunk X] "
+           "[-threads X] [-iters X] [-level X] [-file X]\n");
+    exit(1);
+}
+
+static double Time(int nIters, const std::function<bool()> &func)
+{
+    double dfBest = 1e100;
+    for (int iIter = 0; iIter < nIters; ++iIter)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        if (!func())
+        {
+            fprintf(stderr, "Error during benchmark\n");
+            exit(1);
+        }
+        const auto end = std::chrono::steady_clock::now();
+        dfBest = std::min(dfBest,
+                          std::chrono::duration<double>(end - start).count());
+    }
+    return dfBest;
+}
+
+int main(int argc, char *argv[])
+{
+    CPLStringList aosCodecs;
+    int nSizeMB = 128;
+    int nChunkKB = 256;
+    int nThreads = CPLGetNumCPUs();
+    int nIters = 3;
+    const char *pszLevel = nullptr;
+    const char *pszFilename = nullptr;
+    for (int i = 1; i < argc; i++)
+    {
+        if (EQUAL(argv[i], "-codec") && i + 1 < argc)
+            aosCodecs.AddString(argv[++i]);
+        else if (EQUAL(argv[i], "-size") && i + 1 < argc)
+            nSizeMB = atoi(argv[++i]);
+        else if (EQUAL(argv[i], "-chunk") && i + 1 < argc)
+            nChunkKB = atoi(argv[++i]);
+        else if (EQUAL(argv[i], "-threads") && i + 1 < argc)
+            nThreads = atoi(argv[++i]);
+        else if (EQUAL(argv[i], "-iters") && i + 1 < argc)
+            nIters = atoi(argv[++i]);
+        else if (EQUAL(argv[i], "-level") && i + 1 < argc)
+            pszLevel = argv[++i];
+        else if (EQUAL(argv[i], "-file") && i + 1 < argc)
+            pszFilename = argv[++i];
+        else
+            Usage();
+    }
+    if (nSizeMB <= 0 || nChunkKB <= 0 || nThreads <= 0 || nIters <= 0)
+        Usage();
+    if (aosCodecs.empty())
+    {
+        for (const char *pszCodec : {"zlib", "gzip", "zstd", "lz4", "lzma"})
+            aosCodecs.AddString(pszCodec);
+    }
+
+    const size_t nSize = static_cast<size_t>(nSizeMB) * 1024 * 1024;
+    const size_t nChunkSize =
+        std::min(nSize, static_cast<size_t>(nChunkKB) * 1024);
+    std::vector<GByte> abyInput(nSize);
+    if (pszFilename)
+    {
+        VSILFILE *fp = VSIFOpenL(pszFilename, "rb");
+        if (!fp)
+        {
+            fprintf(stderr, "Cannot open %s\n", pszFilename);
+            return 1;
+        }
+        abyInput.resize(VSIFReadL(abyInput.data(), 1, nSize, fp));
+        VSIFCloseL(fp);
+        if (abyInput.empty())
+            return 1;
+    }
+    else
+    {
+        // Smooth gradients with some noise
+        std::mt19937 oRandom(0);
+        for (size_t i = 0; i < nSize; ++i)
+        {
+            abyInput[i] = static_cast<GByte>(((i % 4096) + (i / 65536)) / 32 +
+                                             (oRandom() % 8));
+        }
+    }
+    const size_t nInputSize = abyInput.size();
+
+    std::vector<std::pair<size_t, size_t>> anChunks;
+    for (size_t nOffset = 0; nOffset < nInputSize; nOffset += nChunkSize)
+        anChunks.emplace_back(nOffset,
+                              std::min(nChunkSize, nInputSize - nOffset));
+
+    CPLWorkerThreadPool oPool;
+    if (!oPool.Setup(nThreads, nullptr, nullptr))
+        return 1;
+
+    printf("%.1f MB, chunks of %d KB, %d threads\n",
+           static_cast<double>(nInputSize) / (1024 * 1024), nChunkKB,
+           nThreads);
+
+    for (const char *pszCodec : aosCodecs)
+    {
+        const auto poCompressor = CPLGetCompressor(pszCodec);
+        const auto poDecompressor = CPLGetDecompressor(pszCodec);
+        if (!poCompressor || !poDecompressor)
+        {
+            printf("%s: not available\n", pszCodec);
+            continue;
+        }
+
+        CPLStringList aosOptions;
+        if (pszLevel)
+        {
+            aosOptions.SetNameValue(EQUAL(pszCodec, "lzma")  ? "PRESET"
+                                    : EQUAL(pszCodec, "lz4") ? "ACCELERATION"
+                                                             : "LEVEL",
+                                    pszLevel);
+        }
+
+        // Compressed chunks, allocated by the compressor
+        std::vector<void *> apCompressed(anChunks.size(), nullptr);
+        std::vector<size_t> anCompressedSize(anChunks.size(), 0);
+        std::vector<GByte> abyDecompressed(nInputSize);
+
+        const auto CompressChunk = [&](size_t i)
+        {
+            VSIFree(apCompressed[i]);
+            apCompressed[i] = nullptr;
+            anCompressedSize[i] = 0;
+            return poCompressor->pfnFunc(
+                abyInput.data() + anChunks[i].first, anChunks[i].second,
+                &apCompressed[i], &anCompressedSize[i], aosOptions.List(),
+                poCompressor->user_data);
+        };
+
+        const auto DecompressChunk = [&](size_t i)
+        {
+            void *pOut = abyDecompressed.data() + anChunks[i].first;
+            size_t nOutSize = anChunks[i].second;
+            return poDecompressor->pfnFunc(
+                       apCompressed[i], anCompressedSize[i], &pOut, &nOutSize,
+                       nullptr, poDecompressor->user_data) &&
+                   nOutSize == anChunks[i].second;
+        };
+
+        const auto Sequential =
+            [&anChunks](const std::function<bool(size_t)> &func)
+        {
+            for (size_t i = 0; i < anChunks.size(); ++i)
+            {
+                if (!func(i))
+                    return false;
+            }
+            return true;
+        };
+
+        const auto Concurrent =
+            [&oPool, &anChunks](const std::function<bool(size_t)> &func)
+        {
+            std::atomic<bool> bOK{true};
+            auto poQueue = oPool.CreateJobQueue();
+            for (size_t i = 0; i < anChunks.size(); ++i)
+            {
+                poQueue->SubmitJob(
+                    [&func, &bOK, i]()
+                    {
+                        if (!func(i))
+                            bOK = false;
+                    });
+            }
+            poQueue->WaitCompletion();
+            return bOK.load();
+        };
+
+        const auto MBPerSec = [nInputSize](double dfTime)
+        { return static_cast<double>(nInputSize) / (1024 * 1024) / dfTime; };
+
+        const double dfSeqCompress =
+            Time(nIters, [&]() { return Sequential(CompressChunk); });
+        size_t nCompressedSize = 0;
+        for (size_t nChunkCompressedSize : anCompressedSize)
+            nCompressedSize += nChunkCompressedSize;
+        const double dfSeqDecompress =
+            Time(nIters, [&]() { return Sequential(DecompressChunk); });
+        if (abyDecompressed != abyInput)
+        {
+            fprintf(stderr, "%s: round-trip failed\n", pszCodec);
+            return 1;
+        }
+        const double dfConcurrentCompress =
+            Time(nIters, [&]() { return Concurrent(CompressChunk); });
+        const double dfConcurrentDecompress =
+            Time(nIters, [&]() { return Concurrent(DecompressChunk); });
+        for (void *p : apCompressed)
+            VSIFree(p);
+
+        printf("%s: ratio %.2f\n", pszCodec,
+               static_cast<double>(nInputSize) /
+                   static_cast<double>(nCompressedSize));
+        printf("  sequential chunks:  compress %8.1f MB/s, "
+               "decompress %8.1f MB/s\n",
+               MBPerSec(dfSeqCompress), MBPerSec(dfSeqDecompress));
+        printf("  concurrent chunks:  compress %8.1f MB/s, "
+               "decompress %8.1f MB/s\n",
+               MBPerSec(dfConcurrentCompress),
+               MBPerSec(dfConcurrentDecompress));
+
+        if (CSLFetchNameValue(poCompressor->papszMetadata,
+                              "PREFERRED_CHUNK_SIZE"))
+        {
+            aosOptions.SetNameValue("NUM_THREADS", CPLSPrintf("%d", nThreads));
+            void *pCompressed = nullptr;
+            size_t nWholeCompressedSize = 0;
+            const double dfWholeCompress = Time(
+                nIters,
+                [&]()
+                {
+                    VSIFree(pCompressed);
+                    pCompressed = nullptr;
+                    nWholeCompressedSize = 0;
+                    return poCompressor->pfnFunc(
+                        abyInput.data(), nInputSize, &pCompressed,
+                        &nWholeCompressedSize, aosOptions.List(),
+                        poCompressor->user_data);
+                });
+            VSIFree(pCompressed);
+            printf("  NUM_THREADS=%d:     compress %8.1f MB/s, ratio %.2f\n",
+                   nThreads, MBPerSec(dfWholeCompress),
+                   static_cast<double>(nInputSize) /
+                       static_cast<double>(nWholeCompressedSize));
+        }
+    }
+
+    CPLDestroyCompressorRegistry();
+    return 0;
+}
@@ -15,6 +15,14 @@
 #include <cstdio>
 #include <cstdlib>
 #include <ctime>
+#include <utility>
+
+static double Throughput(clock_t start, clock_t end, int nIters)
+{
+    // In Mpixels/s
+    const double dfElapsed = (end - start) * 1.0 / CLOCKS_PER_SEC;
+    return dfElapsed > 0 ? nIters * 256.0 * 256 / dfElapsed / 1e6 : 0.0;
+}
 
 static void bench(void *in, void *out, int intype, int outtype)
 {
@@ -26,9 +34,10 @@ static void bench(void *in, void *out, int intype, int outtype)
 
     clock_t end = clock();
 
-    printf("%s -> %s : %.2f s\n", GDALGetDataTypeName((GDALDataType)intype),
+    printf("%s -> %s : %.2f s (%.0f Mpixels/s)\n",
+           GDALGetDataTypeName((GDALDataType)intype),
            GDALGetDataTypeName((GDALDataType)outtype),
-           (end - start) * 1.0 / CLOCKS_PER_SEC);
+           (end - start) * 1.0 / CLOCKS_PER_SEC, Throughput(start, end, 1000));
 
     start = clock();
 
@@ -41,10 +50,10 @@ static void bench(void *in, void *out, int intype, int outtype)
 
     end = clock();
 
-    printf("%s -> %s (packed) : %.2f s\n",
+    printf("%s -> %s (packed) : %.2f s (%.0f Mpixels/s)\n",
            GDALGetDataTypeName((GDALDataType)intype),
            GDALGetDataTypeName((GDALDataType)outtype),
-           (end - start) * 1.0 / CLOCKS_PER_SEC);
+           (end - start) * 1.0 / CLOCKS_PER_SEC, Throughput(start, end, 1000));
 }
 
 int main(int /* argc */, char * /* argv */[])
@@ -94,5 +103,34 @@ int main(int /* argc */, char * /* argv */[])
     }
     CPLSetConfigOption("GDAL_USE_SSSE3", nullptr);
 
+    // Pairs that have AVX2 kernels. Disabling them through GDAL_USE_AVX2
+    // is only honoured in DEBUG builds.
+    const std::pair<GDALDataType, GDALDataType> apairs[] = {
+        {GDT_Int16, GDT_Float32},
+        {GDT_UInt16, GDT_Float64},
+        {GDT_Int32, GDT_Float32},
+        {GDT_Float64, GDT_Byte},
+    };
+    for (int k = 0; k < 2; k++)
+    {
+        if (k == 1)
+        {
+            printf("Disabling AVX2\n");
+            CPLSetConfigOption("GDAL_USE_AVX2", "NO");
+        }
+        for (const auto &[eIn, eOut] : apairs)
+        {
+            const clock_t start = clock();
+            for (int i = 0; i < 10000; i++)
+                GDALCopyWords(in, eIn, GDALGetDataTypeSizeBytes(eIn), out,
+                              eOut, GDALGetDataTypeSizeBytes(eOut), 256 * 256);
+            const clock_t end = clock();
+            printf("%s -> %s (packed) : %.0f Mpixels/s\n",
+                   GDALGetDataTypeName(eIn), GDALGetDataTypeName(eOut),
+                   Throughput(start, end, 10000));
+        }
+    }
+    CPLSetConfigOption("GDAL_USE_AVX2", nullptr);
+
     return 0;
 }
@@ -0,0 +1,107 @@
+/******************************************************************************
+ *
+ * Project:  CPL - Common Portability Library
+ * Purpose:  Test performance of sequential reads of a /vsicurl/ file, with
+ *           and without background readahead.
+ * Author:   agent <agent at local>
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, agent <agent at local>
+ *
+ * SPDX-License-Identifier: MIT
+ ****************************************************************************/
+
+// Typical use:
+// testperfcurlreadahead -url http://localhost:8080/big_file.bin
+//
+// The file must be served by a HTTP server that supports range requests
+// (for example nginx). To emulate object storage, latency can be added to
+// the loopback interface with "tc qdisc add dev lo root netem delay 20ms".
+
+#include "gdal_priv.h"
+#include "cpl_conv.h"
+#include "cpl_string.h"
+#include "cpl_vsi.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+static void Usage()
+{
+    printf("Usage: testperfcurlreadahead -url X [-read-size X] [-iters X]\n");
+    exit(1);
+}
+
+int main(int argc, char *argv[])
+{
+    GDALAllRegister();
+    argc = GDALGeneralCmdLineProcessor(argc, &argv, 0);
+    if (argc < 1)
+        return 1;
+
+    std::string osURL;
+    int nReadSize = 64 * 1024;
+    int nIters = 3;
+    for (int i = 1; i < argc; i++)
+    {
+        if (EQUAL(argv[i], "-url") && i + 1 < argc)
+            osURL = argv[++i];
+        else if (EQUAL(argv[i], "-read-size") && i + 1 < argc)
+            nReadSize = atoi(argv[++i]);
+        else if (EQUAL(argv[i], "-iters") && i + 1 < argc)
+            nIters = atoi(argv[++i]);
+        else
+            Usage();
+    }
+    CSLDestroy(argv);
+    if (osURL.empty() || nReadSize <= 0 || nIters <= 0)
+        Usage();
+
+    const std::string osFilename = "/vsicurl/" + osURL;
+    std::vector<GByte> abyBuffer(nReadSize);
+
+    CPLSetConfigOption("GDAL_DISABLE_READDIR_ON_OPEN", "EMPTY_DIR");
+    for (const char *pszMaxSize : {"0", "64MB"})
+    {
+        CPLSetConfigOption("CPL_VSIL_CURL_READAHEAD_MAX_SIZE", pszMaxSize);
+        double dfBest = 1e100;
+        vsi_l_offset nTotalRead = 0;
+        for (int iIter = 0; iIter < nIters; ++iIter)
+        {
+            VSICurlClearCache();
+            const auto start = std::chrono::steady_clock::now();
+            VSILFILE *fp = VSIFOpenL(osFilename.c_str(), "rb");
+            if (!fp)
+            {
+                fprintf(stderr, "Cannot open %s\n", osFilename.c_str());
+                return 1;
+            }
+            nTotalRead = 0;
+            while (true)
+            {
+                const size_t nRead =
+                    VSIFReadL(abyBuffer.data(), 1, abyBuffer.size(), fp);
+                nTotalRead += nRead;
+                if (nRead < abyBuffer.size())
+                    break;
+            }
+            VSIFCloseL(fp);
+            const auto end = std::chrono::steady_clock::now();
+            dfBest = std::min(
+                dfBest, std::chrono::duration<double>(end - start).count());
+        }
+        printf("CPL_VSIL_CURL_READAHEAD_MAX_SIZE=%s: " CPL_FRMT_GUIB
+               " bytes in %.1f ms (%.1f MB/s)\n",
+               pszMaxSize, nTotalRead, dfBest * 1e3,
+               static_cast<double>(nTotalRead) / dfBest / (1024 * 1024));
+    }
+    CPLSetConfigOption("CPL_VSIL_CURL_READAHEAD_MAX_SIZE", nullptr);
+    CPLSetConfigOption("GDAL_DISABLE_READDIR_ON_OPEN", nullptr);
+
+    GDALDestroyDriverManager();
+    return 0;
+}
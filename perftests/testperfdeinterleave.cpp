@@ -27,9 +27,18 @@ int main(int /* argc */, char * /* argv */[])
     void *dst2 = malloc(SIZE * SIZE);
     void *dst3 = malloc(SIZE * SIZE);
 
-    for (int k = 0; k < 2; k++)
+    // Planar buffer for the generic N-components cases
+    GByte *planar = static_cast<GByte *>(malloc(SIZE * SIZE * 4));
+
+    // Disabling SIMD through GDAL_USE_xxx is only honoured in DEBUG builds
+    for (int k = 0; k < 3; k++)
     {
         if (k == 1)
+        {
+            printf("Disabling AVX2\n");
+            CPLSetConfigOption("GDAL_USE_AVX2", "NO");
+        }
+        else if (k == 2)
         {
             printf("Disabling SSSE3\n");
             CPLSetConfigOption("GDAL_USE_SSSE3", "NO");
@@ -78,7 +87,40 @@ int main(int /* argc */, char * /* argv */[])
             printf("GDALDeinterleave UInt16 4 : %.2f\n",
                    (end - start) * 1.0 / CLOCKS_PER_SEC);
         }
+
+        for (GDALDataType eDT :
+             {GDT_Byte, GDT_UInt16, GDT_Float32, GDT_Float64})
+        {
+            const int nDTSize = GDALGetDataTypeSizeBytes(eDT);
+            for (int nComponents : {2, 3, 5, 8})
+            {
+                const size_t nIters = static_cast<size_t>(SIZE) * SIZE * 4 /
+                                      nComponents / nDTSize;
+                void *apDst[8];
+                for (int iComp = 0; iComp < nComponents; ++iComp)
+                    apDst[iComp] = planar + iComp * nIters * nDTSize;
+
+                auto start = clock();
+                for (int i = 0; i < 500; ++i)
+                    GDALDeinterleave(src, eDT, nComponents, apDst, eDT,
+                                     nIters);
+                auto end = clock();
+                printf("GDALDeinterleave %s %d : %.2f\n",
+                       GDALGetDataTypeName(eDT), nComponents,
+                       (end - start) * 1.0 / CLOCKS_PER_SEC);
+
+                start = clock();
+                for (int i = 0; i < 500; ++i)
+                    GDALTranspose2D(planar, eDT, src, eDT, nIters,
+                                    nComponents);
+                end = clock();
+                printf("GDALTranspose2D (interleave) %s %d : %.2f\n",
+                       GDALGetDataTypeName(eDT), nComponents,
+                       (end - start) * 1.0 / CLOCKS_PER_SEC);
+            }
+        }
     }
+    CPLSetConfigOption("GDAL_USE_AVX2", nullptr);
     CPLSetConfigOption("GDAL_USE_SSSE3", nullptr);
 
     VSIFree(src);
@@ -86,6 +128,7 @@ int main(int /* argc */, char * /* argv */[])
     VSIFree(dst1);
     VSIFree(dst2);
     VSIFree(dst3);
+    VSIFree(planar);
 
     return 0;
 }
@@ -0,0 +1,225 @@
+/******************************************************************************
+ *
+ * Project:  CPL - Common Portability Library
+ * Purpose:  Compare throughput and page cache footprint of buffered and
+ *           direct I/O (CPL_VSIL_LOCAL_DIRECT_IO) on local files.
+ * Author:   agent <agent at local>
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, agent <agent at local>
+ *
+ * SPDX-License-Identifier: MIT
+ ****************************************************************************/
+
+// Typical use:
+// testperfdirectio -file /path/to/tmp.tif -size 16384 -of GTiff
+//
+// A tiled uncompressed raster is written block by block, and then read back
+// block by block, with CPL_VSIL_LOCAL_DIRECT_IO=NO and YES. Timings of the
+// write pass include flushing the file to disk. On Linux, the number of
+// pages of the file resident in the page cache is reported after each pass.
+
+#include "gdal_priv.h"
+#include "cpl_conv.h"
+#include "cpl_string.h"
+#include "cpl_vsi.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+static void Usage()
+{
+    printf("Usage: testperfdirectio [-file X] [-size X] [-of GTiff|ENVI]\n");
+    exit(1);
+}
+
+#if defined(__linux__)
+static void SyncFile(const char *pszFilename)
+{
+    const int fd = open(pszFilename, O_RDONLY);
+    if (fd >= 0)
+    {
+        fsync(fd);
+        close(fd);
+    }
+}
+
+static void EvictFromPageCache(const char *pszFilename)
+{
+    const int fd = open(pszFilename, O_RDONLY);
+    if (fd >= 0)
+    {
+        posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+        close(fd);
+    }
+}
+
+// Returns the number of MB of the file resident in the page cache
+static double GetResidentMB(const char *pszFilename)
+{
+    const int fd = open(pszFilename, O_RDONLY);
+    if (fd < 0)
+        return -1;
+    const off_t nSize = lseek(fd, 0, SEEK_END);
+    double dfRet = -1;
+    void *pMap = nSize > 0
+                     ? mmap(nullptr, nSize, PROT_READ, MAP_SHARED, fd, 0)
+                     : MAP_FAILED;
+    if (pMap != MAP_FAILED)
+    {
+        const size_t nPageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        std::vector<unsigned char> abyVec((nSize + nPageSize - 1) /
+                                          nPageSize);
+        if (mincore(pMap, nSize, abyVec.data()) == 0)
+        {
+            size_t nResident = 0;
+            for (unsigned char ch : abyVec)
+                nResident += (ch & 1);
+            dfRet = static_cast<double>(nResident) * nPageSize / 1e6;
+        }
+        munmap(pMap, nSize);
+    }
+    close(fd);
+    return dfRet;
+}
+#else
+static void SyncFile(const char *)
+{
+}
+
+static void EvictFromPageCache(const char *)
+{
+}
+
+static double GetResidentMB(const char *)
+{
+    return -1;
+}
+#endif
+
+int main(int argc, char *argv[])
+{
+    GDALAllRegister();
+    argc = GDALGeneralCmdLineProcessor(argc, &argv, 0);
+    if (argc < 1)
+        return 1;
+
+    std::string osFilename = "testperfdirectio.tif";
+    std::string osFormat = "GTiff";
+    int nSize = 16384;
+    for (int i = 1; i < argc; i++)
+    {
+        if (EQUAL(argv[i], "-file") && i + 1 < argc)
+            osFilename = argv[++i];
+        else if (EQUAL(argv[i], "-size") && i + 1 < argc)
+            nSize = atoi(argv[++i]);
+        else if (EQUAL(argv[i], "-of") && i + 1 < argc)
+            osFormat = argv[++i];
+        else
+            Usage();
+    }
+    CSLDestroy(argv);
+    if (nSize <= 0)
+        Usage();
+
+    auto poDriver = GetGDALDriverManager()->GetDriverByName(osFormat.c_str());
+    if (!poDriver)
+    {
+        fprintf(stderr, "Driver %s not available\n", osFormat.c_str());
+        return 1;
+    }
+    const char *const apszTiledOptions[] = {"TILED=YES", "BLOCKXSIZE=512",
+                                            "BLOCKYSIZE=512", nullptr};
+    char **papszOptions = EQUAL(osFormat.c_str(), "GTiff")
+                              ? const_cast<char **>(apszTiledOptions)
+                              : nullptr;
+    const double dfMB = static_cast<double>(nSize) * nSize / 1e6;
+
+    for (const char *pszDirectIO : {"NO", "YES"})
+    {
+        CPLSetConfigOption("CPL_VSIL_LOCAL_DIRECT_IO", pszDirectIO);
+
+        // Write pass
+        const auto startWrite = std::chrono::steady_clock::now();
+        {
+            std::unique_ptr<GDALDataset> poDS(poDriver->Create(
+                osFilename.c_str(), nSize, nSize, 1, GDT_Byte, papszOptions));
+            if (!poDS)
+                return 1;
+            auto poBand = poDS->GetRasterBand(1);
+            int nBlockXSize = 0;
+            int nBlockYSize = 0;
+            poBand->GetBlockSize(&nBlockXSize, &nBlockYSize);
+            std::vector<GByte> abyBlock(static_cast<size_t>(nBlockXSize) *
+                                        nBlockYSize);
+            const int nBlocksX = DIV_ROUND_UP(nSize, nBlockXSize);
+            const int nBlocksY = DIV_ROUND_UP(nSize, nBlockYSize);
+            for (int iY = 0; iY < nBlocksY; ++iY)
+            {
+                for (int iX = 0; iX < nBlocksX; ++iX)
+                {
+                    memset(abyBlock.data(), iX + iY, abyBlock.size());
+                    if (poBand->WriteBlock(iX, iY, abyBlock.data()) !=
+                        CE_None)
+                        return 1;
+                }
+            }
+        }
+        SyncFile(osFilename.c_str());
+        const auto endWrite = std::chrono::steady_clock::now();
+        const double dfResidentAfterWrite = GetResidentMB(osFilename.c_str());
+
+        // Read pass
+        EvictFromPageCache(osFilename.c_str());
+        const auto startRead = std::chrono::steady_clock::now();
+        {
+            std::unique_ptr<GDALDataset> poDS(
+                GDALDataset::Open(osFilename.c_str(), GDAL_OF_RASTER));
+            if (!poDS)
+                return 1;
+            auto poBand = poDS->GetRasterBand(1);
+            int nBlockXSize = 0;
+            int nBlockYSize = 0;
+            poBand->GetBlockSize(&nBlockXSize, &nBlockYSize);
+            std::vector<GByte> abyBlock(static_cast<size_t>(nBlockXSize) *
+                                        nBlockYSize);
+            const int nBlocksX = DIV_ROUND_UP(nSize, nBlockXSize);
+            const int nBlocksY = DIV_ROUND_UP(nSize, nBlockYSize);
+            for (int iY = 0; iY < nBlocksY; ++iY)
+            {
+                for (int iX = 0; iX < nBlocksX; ++iX)
+                {
+                    if (poBand->ReadBlock(iX, iY, abyBlock.data()) != CE_None)
+                        return 1;
+                }
+            }
+        }
+        const auto endRead = std::chrono::steady_clock::now();
+        const double dfResidentAfterRead = GetResidentMB(osFilename.c_str());
+
+        const double dfWrite =
+            std::chrono::duration<double>(endWrite - startWrite).count();
+        const double dfRead =
+            std::chrono::duration<double>(endRead - startRead).count();
+        printf("CPL_VSIL_LOCAL_DIRECT_IO=%s: write %.0f MB/s "
+               "(%.1f MB cached), read %.0f MB/s (%.1f MB cached)\n",
+               pszDirectIO, dfMB / dfWrite, dfResidentAfterWrite,
+               dfMB / dfRead, dfResidentAfterRead);
+
+        poDriver->Delete(osFilename.c_str());
+    }
+    CPLSetConfigOption("CPL_VSIL_LOCAL_DIRECT_IO", nullptr);
+
+    GDALDestroyDriverManager();
+    return 0;
+}
@@ -0,0 +1,214 @@
+/******************************************************************************
+ *
+ * Project:  CPL - Common Portability Library
+ * Purpose:  Test performance of VSIFReadMultiRangeL() on local files, by
+ *           reading scattered tiles of a big local COG.
+ * Author:   agent <agent at local>
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, agent <agent at local>
+ *
+ * SPDX-License-Identifier: MIT
+ ****************************************************************************/
+
+// Typical use:
+// testperflocalmultirange -file /path/to/big_cog.tif -tiles 1000
+//
+// If the file does not exist, a 32768x32768 uncompressed COG with 512x512
+// tiles (1 GB) is created. On Linux, the file is evicted from the page cache
+// with posix_fadvise(POSIX_FADV_DONTNEED) before each run, so that timings
+// reflect actual disk accesses.
+
+#include "gdal_priv.h"
+#include "cpl_conv.h"
+#include "cpl_string.h"
+#include "cpl_vsi.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+static void Usage()
+{
+    printf("Usage: testperflocalmultirange [-file X] [-size X] [-tiles X] "
+           "[-iters X]\n");
+    exit(1);
+}
+
+static bool CreateCOG(const char *pszFilename, int nSize)
+{
+    auto poMEMDriver = GetGDALDriverManager()->GetDriverByName("MEM");
+    auto poCOGDriver = GetGDALDriverManager()->GetDriverByName("COG");
+    if (!poMEMDriver || !poCOGDriver)
+        return false;
+    std::unique_ptr<GDALDataset> poSrcDS(
+        poMEMDriver->Create("", nSize, nSize, 1, GDT_Byte, nullptr));
+    if (!poSrcDS)
+        return false;
+    std::vector<GByte> abyLine(nSize);
+    for (int iY = 0; iY < nSize; ++iY)
+    {
+        for (int iX = 0; iX < nSize; ++iX)
+            abyLine[iX] = static_cast<GByte>(iX + iY);
+        if (poSrcDS->GetRasterBand(1)->RasterIO(GF_Write, 0, iY, nSize, 1,
+                                                abyLine.data(), nSize, 1,
+                                                GDT_Byte, 0, 0,
+                                                nullptr) != CE_None)
+            return false;
+    }
+    const char *const apszOptions[] = {"COMPRESS=NONE", "BLOCKSIZE=512",
+                                       "OVERVIEWS=NONE", nullptr};
+    std::unique_ptr<GDALDataset> poDstDS(
+        poCOGDriver->CreateCopy(pszFilename, poSrcDS.get(), false,
+                                const_cast<char **>(apszOptions), nullptr,
+                                nullptr));
+    return poDstDS != nullptr;
+}
+
+static void EvictFromPageCache(const char *pszFilename)
+{
+#if defined(__linux__) && defined(POSIX_FADV_DONTNEED)
+    const int fd = open(pszFilename, O_RDONLY);
+    if (fd >= 0)
+    {
+        posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+        close(fd);
+    }
+#else
+    CPL_IGNORE_RET_VAL(pszFilename);
+#endif
+}
+
+int main(int argc, char *argv[])
+{
+    GDALAllRegister();
+    argc = GDALGeneralCmdLineProcessor(argc, &argv, 0);
+    if (argc < 1)
+        return 1;
+
+    std::string osFilename = "testperflocalmultirange.tif";
+    int nSize = 32768;
+    int nTiles = 1000;
+    int nIters = 3;
+    for (int i = 1; i < argc; i++)
+    {
+        if (EQUAL(argv[i], "-file") && i + 1 < argc)
+            osFilename = argv[++i];
+        else if (EQUAL(argv[i], "-size") && i + 1 < argc)
+            nSize = atoi(argv[++i]);
+        else if (EQUAL(argv[i], "-tiles") && i + 1 < argc)
+            nTiles = atoi(argv[++i]);
+        else if (EQUAL(argv[i], "-iters") && i + 1 < argc)
+            nIters = atoi(argv[++i]);
+        else
+            Usage();
+    }
+    CSLDestroy(argv);
+    if (nSize <= 0 || nTiles <= 0 || nIters <= 0)
+        Usage();
+
+    VSIStatBufL sStat;
+    if (VSIStatL(osFilename.c_str(), &sStat) != 0)
+    {
+        printf("Creating %s...\n", osFilename.c_str());
+        if (!CreateCOG(osFilename.c_str(), nSize))
+        {
+            fprintf(stderr, "Cannot create %s\n", osFilename.c_str());
+            return 1;
+        }
+    }
+
+    // Collect the location of all tiles
+    std::vector<std::pair<vsi_l_offset, size_t>> aoTiles;
+    {
+        std::unique_ptr<GDALDataset> poDS(
+            GDALDataset::Open(osFilename.c_str(), GDAL_OF_RASTER));
+        if (!poDS)
+            return 1;
+        auto poBand = poDS->GetRasterBand(1);
+        int nBlockXSize = 0;
+        int nBlockYSize = 0;
+        poBand->GetBlockSize(&nBlockXSize, &nBlockYSize);
+        const int nBlocksX = DIV_ROUND_UP(poBand->GetXSize(), nBlockXSize);
+        const int nBlocksY = DIV_ROUND_UP(poBand->GetYSize(), nBlockYSize);
+        for (int iY = 0; iY < nBlocksY; ++iY)
+        {
+            for (int iX = 0; iX < nBlocksX; ++iX)
+            {
+                const char *pszOffset = poBand->GetMetadataItem(
+                    CPLSPrintf("BLOCK_OFFSET_%d_%d", iX, iY), "TIFF");
+                const char *pszSize = poBand->GetMetadataItem(
+                    CPLSPrintf("BLOCK_SIZE_%d_%d", iX, iY), "TIFF");
+                if (pszOffset && pszSize)
+                {
+                    aoTiles.emplace_back(
+                        std::strtoull(pszOffset, nullptr, 10),
+                        static_cast<size_t>(
+                            std::strtoull(pszSize, nullptr, 10)));
+                }
+            }
+        }
+    }
+    if (aoTiles.empty())
+    {
+        fprintf(stderr, "No tile found\n");
+        return 1;
+    }
+    nTiles = std::min(nTiles, static_cast<int>(aoTiles.size()));
+
+    std::mt19937 oRandom(0);
+    std::shuffle(aoTiles.begin(), aoTiles.end(), oRandom);
+    std::vector<vsi_l_offset> anOffsets;
+    std::vector<size_t> anSizes;
+    std::vector<std::vector<GByte>> aabyBuffers;
+    std::vector<void *> apData;
+    for (int i = 0; i < nTiles; ++i)
+    {
+        anOffsets.push_back(aoTiles[i].first);
+        anSizes.push_back(aoTiles[i].second);
+        aabyBuffers.emplace_back(aoTiles[i].second);
+        apData.push_back(aabyBuffers.back().data());
+    }
+
+    for (const char *pszMethod : {"NO", "THREADS", "AUTO"})
+    {
+        CPLSetConfigOption("CPL_VSIL_LOCAL_READ_MULTI_RANGE", pszMethod);
+        double dfBest = 1e100;
+        for (int iIter = 0; iIter < nIters; ++iIter)
+        {
+            EvictFromPageCache(osFilename.c_str());
+            VSILFILE *fp = VSIFOpenL(osFilename.c_str(), "rb");
+            if (!fp)
+                return 1;
+            const auto start = std::chrono::steady_clock::now();
+            const int nRet = VSIFReadMultiRangeL(nTiles, apData.data(),
+                                                 anOffsets.data(),
+                                                 anSizes.data(), fp);
+            const auto end = std::chrono::steady_clock::now();
+            VSIFCloseL(fp);
+            if (nRet != 0)
+            {
+                fprintf(stderr, "VSIFReadMultiRangeL() failed\n");
+                return 1;
+            }
+            dfBest = std::min(
+                dfBest, std::chrono::duration<double>(end - start).count());
+        }
+        printf("CPL_VSIL_LOCAL_READ_MULTI_RANGE=%s: %d tiles in %.1f ms\n",
+               pszMethod, nTiles, dfBest * 1e3);
+    }
+    CPLSetConfigOption("CPL_VSIL_LOCAL_READ_MULTI_RANGE", nullptr);
+
+    GDALDestroyDriverManager();
+    return 0;
+}
@@ -0,0 +1,187 @@
+/******************************************************************************
+ *
+ * Project:  CPL - Common Portability Library
+ * Purpose:  Test job throughput of CPLWorkerThreadPool
+ * Author:   agent <agent at local>
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, agent <agent at local>
+ *
+ * SPDX-License-Identifier: MIT
+ ****************************************************************************/
+
+#include "cpl_conv.h"
+#include "cpl_multiproc.h"
+#include "cpl_worker_thread_pool.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Typical use:
+// testperfworkerthreadpool [number_of_jobs] [max_threads]
+
+namespace
+{
+
+/************************************************************************/
+/*                          SingleQueuePool                             */
+/************************************************************************/
+
+// Reference pool with a single mutex-protected job queue shared by all
+// threads, as CPLWorkerThreadPool was implemented up to GDAL 3.11.
+class SingleQueuePool
+{
+    std::mutex m_mutex{};
+    std::condition_variable m_cvJob{};
+    std::condition_variable m_cvDone{};
+    std::deque<std::function<void()>> m_jobs{};
+    int m_nPendingJobs = 0;
+    bool m_bStop = false;
+    std::vector<std::thread> m_threads{};
+
+    void Run()
+    {
+        while (true)
+        {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> oGuard(m_mutex);
+                m_cvJob.wait(oGuard,
+                             [this] { return m_bStop || !m_jobs.empty(); });
+                if (m_jobs.empty())
+                    return;
+                task = std::move(m_jobs.front());
+                m_jobs.pop_front();
+            }
+            task();
+            std::lock_guard<std::mutex> oGuard(m_mutex);
+            if (--m_nPendingJobs == 0)
+                m_cvDone.notify_all();
+        }
+    }
+
+  public:
+    explicit SingleQueuePool(int nThreads)
+    {
+        for (int i = 0; i < nThreads; ++i)
+            m_threads.emplace_back([this] { Run(); });
+    }
+
+    ~SingleQueuePool()
+    {
+        {
+            std::lock_guard<std::mutex> oGuard(m_mutex);
+            m_bStop = true;
+            m_cvJob.notify_all();
+        }
+        for (auto &t : m_threads)
+            t.join();
+    }
+
+    void SubmitJob(std::function<void()> task)
+    {
+        std::lock_guard<std::mutex> oGuard(m_mutex);
+        m_jobs.emplace_back(std::move(task));
+        ++m_nPendingJobs;
+        m_cvJob.notify_one();
+    }
+
+    void WaitCompletion()
+    {
+        std::unique_lock<std::mutex> oGuard(m_mutex);
+        m_cvDone.wait(oGuard, [this] { return m_nPendingJobs == 0; });
+    }
+};
+
+// Small job, of the order of magnitude of decoding a tiny tile.
+void SmallJob(std::atomic<int> &nCounter)
+{
+    volatile double dfSum = 0;
+    for (int i = 0; i < 100; ++i)
+        dfSum = dfSum + i;
+    ++nCounter;
+}
+
+template <class Pool> double TimeFlatJobs(Pool &oPool, int nJobs)
+{
+    std::atomic<int> nCounter{0};
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < nJobs; ++i)
+        oPool.SubmitJob([&nCounter] { SmallJob(nCounter); });
+    oPool.WaitCompletion();
+    const auto end = std::chrono::steady_clock::now();
+    if (nCounter != nJobs)
+    {
+        fprintf(stderr, "Wrong number of jobs run\n");
+        exit(1);
+    }
+    return std::chrono::duration<double>(end - start).count();
+}
+
+// Jobs submitting sub-jobs and waiting for them, which is only possible
+// with CPLWorkerThreadPool.
+double TimeNestedJobs(CPLWorkerThreadPool &oPool, int nJobs)
+{
+    constexpr int SUBJOBS = 16;
+    std::atomic<int> nCounter{0};
+    const auto start = std::chrono::steady_clock::now();
+    {
+        auto poQueue = oPool.CreateJobQueue();
+        for (int i = 0; i < nJobs / SUBJOBS; ++i)
+        {
+            poQueue->SubmitJob(
+                [&oPool, &nCounter]
+                {
+                    auto poSubQueue = oPool.CreateJobQueue();
+                    for (int j = 0; j < SUBJOBS; ++j)
+                        poSubQueue->SubmitJob([&nCounter]
+                                              { SmallJob(nCounter); });
+                    poSubQueue->WaitCompletion();
+                });
+        }
+        poQueue->WaitCompletion();
+    }
+    const auto end = std::chrono::steady_clock::now();
+    if (nCounter != nJobs / SUBJOBS * SUBJOBS)
+    {
+        fprintf(stderr, "Wrong number of jobs run\n");
+        exit(1);
+    }
+    return std::chrono::duration<double>(end - start).count();
+}
+
+}  // namespace
+
+int main(int argc, char *argv[])
+{
+    const int nJobs = argc >= 2 ? atoi(argv[1]) : 1000 * 1000;
+    const int nMaxThreads = argc >= 3 ? atoi(argv[2]) : CPLGetNumCPUs();
+
+    for (int nThreads = 1; nThreads <= nMaxThreads; nThreads *= 2)
+    {
+        double dfRef;
+        {
+            SingleQueuePool oPool(nThreads);
+            dfRef = TimeFlatJobs(oPool, nJobs);
+        }
+        CPLWorkerThreadPool oPool;
+        oPool.Setup(nThreads, nullptr, nullptr);
+        const double dfFlat = TimeFlatJobs(oPool, nJobs);
+        const double dfNested = TimeNestedJobs(oPool, nJobs);
+        printf("%d thread(s): single queue: %.2f Mjobs/s, "
+               "CPLWorkerThreadPool: %.2f Mjobs/s, "
+               "CPLWorkerThreadPool nested: %.2f Mjobs/s\n",
+               nThreads, nJobs / dfRef * 1e-6, nJobs / dfFlat * 1e-6,
+               nJobs / dfNested * 1e-6);
+    }
+
+    return 0;
+}
@@ -14,6 +14,7 @@
 #include "cpl_multiproc.h"
 #include "cpl_string.h"
 #include "cpl_conv.h"  // CPLZLibInflate()
+#include "cpl_worker_thread_pool.h"
 
 #if defined(__clang__)
 #pragma clang diagnostic push
@@ -27,9 +28,8 @@
 
 #ifdef HAVE_LIBDEFLATE
 #include "libdeflate.h"
-#else
-#include "zlib.h"
 #endif
+#include "cpl_zlib_header.h"  // to avoid warnings when including zlib.h
 
 #ifdef HAVE_LZMA
 #include <lzma.h>
@@ -47,7 +47,10 @@
 #pragma clang diagnostic pop
 #endif
 
+#include <algorithm>
+#include <functional>
 #include <limits>
+#include <memory>
 #include <mutex>
 #include <type_traits>
 #include <vector>
@@ -56,6 +59,367 @@ static std::mutex gMutex;
 static std::vector<CPLCompressor *> *gpCompressors = nullptr;
 static std::vector<CPLCompressor *> *gpDecompressors = nullptr;
 
+namespace
+{
+
+/************************************************************************/
+/*                        CPLCodecContextPool                           */
+/************************************************************************/
+
+// Pool of codec contexts (zstd contexts, libdeflate compressors), so that
+// they are reused from one call to another instead of being allocated and
+// initialized each time. A context is owned by a single call while it is
+// acquired, so that concurrent calls never share one.
+// A mutex-protected free list is used rather than thread_local objects, which
+// are not safe to use with non-trivial destructors in Windows DLLs.
+template <class T> class CPLCodecContextPool
+{
+    CPL_DISALLOW_COPY_ASSIGN(CPLCodecContextPool)
+
+    std::mutex m_oMutex{};
+    std::vector<T *> m_apoFree{};
+    const std::function<T *()> m_pfnCreate;
+    const std::function<void(T *)> m_pfnDestroy;
+
+  public:
+    struct Releaser
+    {
+        CPLCodecContextPool *m_poPool = nullptr;
+
+        void operator()(T *poCtx) const
+        {
+            m_poPool->Release(poCtx);
+        }
+    };
+
+    using Ptr = std::unique_ptr<T, Releaser>;
+
+    CPLCodecContextPool(std::function<T *()> pfnCreate,
+                        std::function<void(T *)> pfnDestroy)
+        : m_pfnCreate(std::move(pfnCreate)), m_pfnDestroy(std::move(pfnDestroy))
+    {
+    }
+
+    ~CPLCodecContextPool()
+    {
+        Clear();
+    }
+
+    Ptr Acquire()
+    {
+        T *poCtx = nullptr;
+        {
+            std::lock_guard<std::mutex> oLock(m_oMutex);
+            if (!m_apoFree.empty())
+            {
+                poCtx = m_apoFree.back();
+                m_apoFree.pop_back();
+            }
+        }
+        if (!poCtx)
+            poCtx = m_pfnCreate();
+        return Ptr(poCtx, Releaser{this});
+    }
+
+    void Release(T *poCtx)
+    {
+        if (poCtx)
+        {
+            std::lock_guard<std::mutex> oLock(m_oMutex);
+            m_apoFree.push_back(poCtx);
+        }
+    }
+
+    // To be used instead of letting poCtx return to the pool, when it is
+    // left in an undefined state, typically after a failed call.
+    void Discard(Ptr &&poCtx)
+    {
+        m_pfnDestroy(poCtx.release());
+    }
+
+    void Clear()
+    {
+        std::lock_guard<std::mutex> oLock(m_oMutex);
+        for (T *poCtx : m_apoFree)
+            m_pfnDestroy(poCtx);
+        m_apoFree.clear();
+    }
+};
+
+}  // namespace
+
+#ifdef HAVE_ZSTD
+static CPLCodecContextPool<ZSTD_CCtx> &GetZSTDCCtxPool()
+{
+    static CPLCodecContextPool<ZSTD_CCtx> oPool(
+        ZSTD_createCCtx, [](ZSTD_CCtx *ctx) { ZSTD_freeCCtx(ctx); });
+    return oPool;
+}
+
+static CPLCodecContextPool<ZSTD_DCtx> &GetZSTDDCtxPool()
+{
+    static CPLCodecContextPool<ZSTD_DCtx> oPool(
+        ZSTD_createDCtx, [](ZSTD_DCtx *ctx) { ZSTD_freeDCtx(ctx); });
+    return oPool;
+}
+#endif
+
+#ifdef HAVE_LIBDEFLATE
+// libdeflate accepts compression levels from 0 to 12
+constexpr int LIBDEFLATE_MAX_LEVEL = 12;
+
+static CPLCodecContextPool<libdeflate_compressor> &
+GetLibdeflateCompressorPool(int nLevel)
+{
+    static std::vector<std::unique_ptr<
+        CPLCodecContextPool<libdeflate_compressor>>> apoPools = []()
+    {
+        std::vector<
+            std::unique_ptr<CPLCodecContextPool<libdeflate_compressor>>>
+            ret;
+        for (int i = 0; i <= LIBDEFLATE_MAX_LEVEL; ++i)
+        {
+            ret.emplace_back(
+                std::make_unique<CPLCodecContextPool<libdeflate_compressor>>(
+                    [i]() { return libdeflate_alloc_compressor(i); },
+                    libdeflate_free_compressor));
+        }
+        return ret;
+    }();
+    return *(apoPools[nLevel]);
+}
+#endif
+
+static void CPLClearCodecContextPools()
+{
+#ifdef HAVE_ZSTD
+    GetZSTDCCtxPool().Clear();
+    GetZSTDDCtxPool().Clear();
+#endif
+#ifdef HAVE_LIBDEFLATE
+    for (int i = 0; i <= LIBDEFLATE_MAX_LEVEL; ++i)
+        GetLibdeflateCompressorPool(i).Clear();
+#endif
+}
+
+/************************************************************************/
+/*                    Multi-threaded compression support                */
+/************************************************************************/
+
+// Size of the pieces in which the input of the zlib, gzip and zstd
+// compressors is split when NUM_THREADS > 1. Inputs smaller than twice that
+// size are compressed by the calling thread only.
+constexpr size_t MT_CHUNK_SIZE = 1024 * 1024;
+#define MT_CHUNK_SIZE_METADATA "PREFERRED_CHUNK_SIZE=1048576"
+
+static std::mutex gThreadPoolMutex;
+static std::unique_ptr<CPLWorkerThreadPool> gpoThreadPool;
+
+static int CPLCompressorGetNumThreads(CSLConstList options)
+{
+    const char *pszNumThreads =
+        CSLFetchNameValueDef(options, "NUM_THREADS", "1");
+    const int nThreads = EQUAL(pszNumThreads, "ALL_CPUS")
+                             ? CPLGetNumCPUs()
+                             : atoi(pszNumThreads);
+    return std::clamp(nThreads, 1, 128);
+}
+
+// Return a thread pool with at least nThreads threads. It is distinct from
+// the GDAL global thread pool, so that compression methods can be called from
+// jobs of the latter without risking dead locks.
+static CPLWorkerThreadPool *CPLCompressorGetThreadPool(int nThreads)
+{
+    std::lock_guard<std::mutex> oLock(gThreadPoolMutex);
+    if (!gpoThreadPool)
+        gpoThreadPool = std::make_unique<CPLWorkerThreadPool>();
+    if (!gpoThreadPool->Setup(nThreads, nullptr, nullptr, false))
+    {
+        gpoThreadPool.reset();
+        return nullptr;
+    }
+    return gpoThreadPool.get();
+}
+
+/************************************************************************/
+/*                       CPLDeflateCompressMT()                         */
+/************************************************************************/
+
+// Returns an upper bound of the size of the output of CPLDeflateCompressMT()
+static size_t CPLDeflateCompressMTBound(size_t nInputSize)
+{
+    const size_t nChunks = (nInputSize + MT_CHUNK_SIZE - 1) / MT_CHUNK_SIZE;
+    // Each chunk is a raw deflate stream (compressBound() accounts for the
+    // zlib header and trailer it has not) terminated by an empty stored block
+    // of 5 bytes, plus the gzip header and trailer for the whole stream.
+    return static_cast<size_t>(compressBound(static_cast<uLong>(
+               std::min(nInputSize, MT_CHUNK_SIZE)))) *
+               nChunks +
+           5 * nChunks + 18;
+}
+
+// Compress input_data as a single zlib or gzip stream, in the way of pigz:
+// the input is split in chunks of MT_CHUNK_SIZE bytes that are compressed in
+// parallel as raw deflate streams, each one terminated by a sync flush (except
+// the last one) so that they can be concatenated. The 32 KB preceding a chunk
+// is used as its dictionary, so that the compression ratio is very close to
+// the one of a single-threaded compression. The result can be read by any
+// zlib/gzip decoder.
+static bool CPLDeflateCompressMT(const void *input_data, size_t input_size,
+                                 bool bGZip, int nLevel, int nThreads,
+                                 void *output_data, size_t *output_size)
+{
+    const size_t nOutAvailable = *output_size;
+    *output_size = 0;
+
+    auto poPool = CPLCompressorGetThreadPool(nThreads);
+    if (!poPool)
+        return false;
+    auto poQueue = poPool->CreateJobQueue();
+
+    struct Chunk
+    {
+        const Bytef *pabyIn = nullptr;
+        size_t nInSize = 0;
+        size_t nDictSize = 0;
+        bool bLast = false;
+        std::vector<Bytef> abyOut{};
+        uLong nCheck = 0;
+        bool bOK = false;
+    };
+
+    const size_t nChunks = (input_size + MT_CHUNK_SIZE - 1) / MT_CHUNK_SIZE;
+    std::vector<Chunk> asChunks(nChunks);
+    const Bytef *pabyIn = static_cast<const Bytef *>(input_data);
+    for (size_t i = 0; i < nChunks; ++i)
+    {
+        Chunk &sChunk = asChunks[i];
+        const size_t nOffset = i * MT_CHUNK_SIZE;
+        sChunk.pabyIn = pabyIn + nOffset;
+        sChunk.nInSize = std::min(MT_CHUNK_SIZE, input_size - nOffset);
+        sChunk.nDictSize = std::min<size_t>(nOffset, 32768);
+        sChunk.bLast = (i + 1 == nChunks);
+
+        // Limit the number of simultaneous jobs of this call to nThreads
+        poQueue->WaitCompletion(nThreads - 1);
+        poQueue->SubmitJob(
+            [&sChunk, nLevel, bGZip]()
+            {
+                sChunk.nCheck =
+                    bGZip ? crc32(0, sChunk.pabyIn,
+                                  static_cast<uInt>(sChunk.nInSize))
+                          : adler32(1, sChunk.pabyIn,
+                                    static_cast<uInt>(sChunk.nInSize));
+
+                z_stream strm;
+                memset(&strm, 0, sizeof(strm));
+                if (deflateInit2(&strm, nLevel, Z_DEFLATED, -MAX_WBITS, 8,
+                                 Z_DEFAULT_STRATEGY) != Z_OK)
+                    return;
+                if (sChunk.nDictSize &&
+                    deflateSetDictionary(
+                        &strm, sChunk.pabyIn - sChunk.nDictSize,
+                        static_cast<uInt>(sChunk.nDictSize)) != Z_OK)
+                {
+                    deflateEnd(&strm);
+                    return;
+                }
+                sChunk.abyOut.resize(
+                    static_cast<size_t>(
+                        compressBound(static_cast<uLong>(sChunk.nInSize))) +
+                    5);
+                strm.next_in = const_cast<Bytef *>(sChunk.pabyIn);
+                strm.avail_in = static_cast<uInt>(sChunk.nInSize);
+                strm.next_out = sChunk.abyOut.data();
+                strm.avail_out = static_cast<uInt>(sChunk.abyOut.size());
+                const int ret =
+                    deflate(&strm, sChunk.bLast ? Z_FINISH : Z_SYNC_FLUSH);
+                sChunk.bOK = sChunk.bLast ? ret == Z_STREAM_END
+                                          : ret == Z_OK && strm.avail_out > 0;
+                sChunk.abyOut.resize(static_cast<size_t>(strm.total_out));
+                deflateEnd(&strm);
+            });
+    }
+    poQueue->WaitCompletion();
+
+    GByte *pabyOut = static_cast<GByte *>(output_data);
+    size_t nOutSize = 0;
+    const auto Append = [pabyOut, nOutAvailable,
+                         &nOutSize](const void *pData, size_t nSize)
+    {
+        if (nSize > nOutAvailable - nOutSize)
+            return false;
+        memcpy(pabyOut + nOutSize, pData, nSize);
+        nOutSize += nSize;
+        return true;
+    };
+
+    if (bGZip)
+    {
+        // No file name, no modification time, OS = Unix
+        const GByte abyHeader[] = {
+            0x1f, 0x8b, Z_DEFLATED, 0, 0, 0, 0, 0,
+            static_cast<GByte>(nLevel == 9 ? 2 : nLevel == 1 ? 4 : 0), 0x03};
+        if (!Append(abyHeader, sizeof(abyHeader)))
+            return false;
+    }
+    else
+    {
+        // Same flags as zlib's deflate()
+        const int nLevelFlags = nLevel < 2    ? 0
+                                : nLevel < 6  ? 1
+                                : nLevel == 6 ? 2
+                                              : 3;
+        const int nHeader = (Z_DEFLATED + ((MAX_WBITS - 8) << 4)) * 256 +
+                            (nLevelFlags << 6);
+        const int nHeaderWithCheck = nHeader + 31 - (nHeader % 31);
+        const GByte abyHeader[] = {static_cast<GByte>(nHeaderWithCheck >> 8),
+                                   static_cast<GByte>(nHeaderWithCheck & 0xff)};
+        if (!Append(abyHeader, sizeof(abyHeader)))
+            return false;
+    }
+
+    uLong nCheck = bGZip ? crc32(0, nullptr, 0) : adler32(0, nullptr, 0);
+    for (const Chunk &sChunk : asChunks)
+    {
+        if (!sChunk.bOK || !Append(sChunk.abyOut.data(), sChunk.abyOut.size()))
+            return false;
+        const auto nLen = static_cast<z_off_t>(sChunk.nInSize);
+        nCheck = bGZip ? crc32_combine(nCheck, sChunk.nCheck, nLen)
+                       : adler32_combine(nCheck, sChunk.nCheck, nLen);
+    }
+
+    if (bGZip)
+    {
+        const uint32_t nCRC = static_cast<uint32_t>(nCheck);
+        const uint32_t nISize = static_cast<uint32_t>(input_size);
+        const GByte abyTrailer[] = {
+            static_cast<GByte>(nCRC & 0xff),
+            static_cast<GByte>((nCRC >> 8) & 0xff),
+            static_cast<GByte>((nCRC >> 16) & 0xff),
+            static_cast<GByte>(nCRC >> 24),
+            static_cast<GByte>(nISize & 0xff),
+            static_cast<GByte>((nISize >> 8) & 0xff),
+            static_cast<GByte>((nISize >> 16) & 0xff),
+            static_cast<GByte>(nISize >> 24)};
+        if (!Append(abyTrailer, sizeof(abyTrailer)))
+            return false;
+    }
+    else
+    {
+        const uint32_t nAdler = static_cast<uint32_t>(nCheck);
+        const GByte abyTrailer[] = {static_cast<GByte>(nAdler >> 24),
+                                    static_cast<GByte>((nAdler >> 16) & 0xff),
+                                    static_cast<GByte>((nAdler >> 8) & 0xff),
+                                    static_cast<GByte>(nAdler & 0xff)};
+        if (!Append(abyTrailer, sizeof(abyTrailer)))
+            return false;
+    }
+
+    *output_size = nOutSize;
+    return true;
+}
+
 #ifdef HAVE_BLOSC
 static bool CPLBloscCompressor(const void *input_data, size_t input_size,
                                void **output_data, size_t *output_size,
@@ -376,19 +740,21 @@ static bool CPLZSTDCompressor(const void *input_data, size_t input_size,
     if (output_data != nullptr && *output_data != nullptr &&
         output_size != nullptr && *output_size != 0)
     {
-        ZSTD_CCtx *ctx = ZSTD_createCCtx();
+        auto poCtx = GetZSTDCCtxPool().Acquire();
+        ZSTD_CCtx *ctx = poCtx.get();
         if (ctx == nullptr)
         {
             *output_size = 0;
             return false;
         }
+        // Contexts coming from the pool may hold parameters of a previous call
+        ZSTD_CCtx_reset(ctx, ZSTD_reset_session_and_parameters);
 
         const int level = atoi(CSLFetchNameValueDef(options, "LEVEL", "13"));
         if (ZSTD_isError(
                 ZSTD_CCtx_setParameter(ctx, ZSTD_c_compressionLevel, level)))
         {
             CPLError(CE_Failure, CPLE_AppDefined, "Invalid compression level");
-            ZSTD_freeCCtx(ctx);
             *output_size = 0;
             return false;
         }
@@ -399,11 +765,32 @@ static bool CPLZSTDCompressor(const void *input_data, size_t input_size,
                 ZSTD_CCtx_setParameter(ctx, ZSTD_c_checksumFlag, 1));
         }
 
+        const int nThreads = CPLCompressorGetNumThreads(options);
+        if (nThreads > 1 && input_size >= 2 * MT_CHUNK_SIZE)
+        {
+            // Fails if libzstd has been built without multi-threading support,
+            // in which case the compression is done by this thread.
+            if (ZSTD_isError(ZSTD_CCtx_setParameter(ctx, ZSTD_c_nbWorkers,
+                                                    nThreads)))
+            {
+                CPLDebugOnce("ZSTD",
+                             "libzstd does not support multi-threading");
+            }
+            else
+            {
+                CPL_IGNORE_RET_VAL(ZSTD_CCtx_setParameter(
+                    ctx, ZSTD_c_jobSize, static_cast<int>(MT_CHUNK_SIZE)));
+            }
+        }
+
         size_t ret = ZSTD_compress2(ctx, *output_data, *output_size, input_data,
                                     input_size);
-        ZSTD_freeCCtx(ctx);
         if (ZSTD_isError(ret))
         {
+            // Reusing a multi-threaded context after a failed compression
+            // (e.g. too small output buffer) is not safe with some libzstd
+            // versions.
+            GetZSTDCCtxPool().Discard(std::move(poCtx));
             *output_size = 0;
             return false;
         }
@@ -490,8 +877,12 @@ static bool CPLZSTDDecompressor(const void *input_data, size_t input_size,
     if (output_data != nullptr && *output_data != nullptr &&
         output_size != nullptr && *output_size != 0)
     {
-        size_t ret =
-            ZSTD_decompress(*output_data, *output_size, input_data, input_size);
+        auto poCtx = GetZSTDDCtxPool().Acquire();
+        size_t ret = poCtx ? ZSTD_decompressDCtx(poCtx.get(), *output_data,
+                                                 *output_size, input_data,
+                                                 input_size)
+                           : ZSTD_decompress(*output_data, *output_size,
+                                             input_data, input_size);
         if (ZSTD_isError(ret))
         {
             *output_size = CPLZSTDGetDecompressedSize(input_data, input_size);
@@ -519,8 +910,12 @@ static bool CPLZSTDDecompressor(const void *input_data, size_t input_size,
             return false;
         }
 
-        size_t ret =
-            ZSTD_decompress(*output_data, nOutSize, input_data, input_size);
+        auto poCtx = GetZSTDDCtxPool().Acquire();
+        size_t ret = poCtx ? ZSTD_decompressDCtx(poCtx.get(), *output_data,
+                                                 nOutSize, input_data,
+                                                 input_size)
+                           : ZSTD_decompress(*output_data, nOutSize,
+                                             input_data, input_size);
         if (ZSTD_isError(ret))
         {
             *output_size = 0;
@@ -796,6 +1191,39 @@ static bool CPLLZ4Decompressor(const void *input_data, size_t input_size,
 
 #endif  // HAVE_LZ4
 
+#ifdef HAVE_LIBDEFLATE
+static size_t CPLLibdeflateCompressBound(bool bGZip, int nLevel,
+                                         size_t input_size)
+{
+    if (nLevel < 0)
+        nLevel = 7;
+    if (nLevel > LIBDEFLATE_MAX_LEVEL)
+        return 0;
+    auto enc = GetLibdeflateCompressorPool(nLevel).Acquire();
+    if (!enc)
+        return 0;
+    return bGZip ? libdeflate_gzip_compress_bound(enc.get(), input_size)
+                 : libdeflate_zlib_compress_bound(enc.get(), input_size);
+}
+
+static size_t CPLLibdeflateCompress(bool bGZip, int nLevel,
+                                    const void *input_data, size_t input_size,
+                                    void *output_data, size_t output_size)
+{
+    if (nLevel < 0)
+        nLevel = 7;
+    if (nLevel > LIBDEFLATE_MAX_LEVEL)
+        return 0;
+    auto enc = GetLibdeflateCompressorPool(nLevel).Acquire();
+    if (!enc)
+        return 0;
+    return bGZip ? libdeflate_gzip_compress(enc.get(), input_data, input_size,
+                                            output_data, output_size)
+                 : libdeflate_zlib_compress(enc.get(), input_data, input_size,
+                                            output_data, output_size);
+}
+#endif
+
 static void *CPLGZipCompress(const void *ptr, size_t nBytes, int nLevel,
                              void *outptr, size_t nOutAvailableBytes,
                              size_t *pnOutBytes)
@@ -805,27 +1233,18 @@ static void *CPLGZipCompress(const void *ptr, size_t nBytes, int nLevel,
 
     size_t nTmpSize = 0;
     void *pTmp;
-#ifdef HAVE_LIBDEFLATE
-    struct libdeflate_compressor *enc =
-        libdeflate_alloc_compressor(nLevel < 0 ? 7 : nLevel);
-    if (enc == nullptr)
-    {
-        return nullptr;
-    }
-#endif
     if (outptr == nullptr)
     {
 #ifdef HAVE_LIBDEFLATE
-        nTmpSize = libdeflate_gzip_compress_bound(enc, nBytes);
+        nTmpSize = CPLLibdeflateCompressBound(true, nLevel, nBytes);
+        if (nTmpSize == 0)
+            return nullptr;
 #else
         nTmpSize = 32 + nBytes * 2;
 #endif
         pTmp = VSIMalloc(nTmpSize);
         if (pTmp == nullptr)
         {
-#ifdef HAVE_LIBDEFLATE
-            libdeflate_free_compressor(enc);
-#endif
             return nullptr;
         }
     }
@@ -837,8 +1256,7 @@ static void *CPLGZipCompress(const void *ptr, size_t nBytes, int nLevel,
 
 #ifdef HAVE_LIBDEFLATE
     size_t nCompressedBytes =
-        libdeflate_gzip_compress(enc, ptr, nBytes, pTmp, nTmpSize);
-    libdeflate_free_compressor(enc);
+        CPLLibdeflateCompress(true, nLevel, ptr, nBytes, pTmp, nTmpSize);
     if (nCompressedBytes == 0)
     {
         if (pTmp != outptr)
@@ -871,6 +1289,7 @@ static void *CPLGZipCompress(const void *ptr, size_t nBytes, int nLevel,
     ret = deflate(&strm, Z_FINISH);
     if (ret != Z_STREAM_END)
     {
+        deflateEnd(&strm);
         if (pTmp != outptr)
             VSIFree(pTmp);
         return nullptr;
@@ -888,8 +1307,10 @@ static bool CPLZlibCompressor(const void *input_data, size_t input_size,
                               CSLConstList options, void *compressor_user_data)
 {
     const char *alg = static_cast<const char *>(compressor_user_data);
-    const auto pfnCompress =
-        strcmp(alg, "zlib") == 0 ? CPLZLibDeflate : CPLGZipCompress;
+    const bool bGZip = strcmp(alg, "zlib") != 0;
+#ifndef HAVE_LIBDEFLATE
+    const auto pfnCompress = bGZip ? CPLGZipCompress : CPLZLibDeflate;
+#endif
     const int clevel = atoi(CSLFetchNameValueDef(options, "LEVEL",
 #if HAVE_LIBDEFLATE
                                                  "7"
@@ -898,12 +1319,32 @@ static bool CPLZlibCompressor(const void *input_data, size_t input_size,
 #endif
                                                  ));
 
+    // Big buffers are compressed by several threads with zlib, since
+    // libdeflate cannot produce the non-final deflate blocks this requires.
+    const int nThreads = CPLCompressorGetNumThreads(options);
+    const bool bMultiThreaded = nThreads > 1 && input_size >= 2 * MT_CHUNK_SIZE;
+    const int nZLibLevel = clevel < 0 ? 6 : std::min(clevel, 9);
+
     if (output_data != nullptr && *output_data != nullptr &&
         output_size != nullptr && *output_size != 0)
     {
+        if (bMultiThreaded)
+        {
+            return CPLDeflateCompressMT(input_data, input_size, bGZip,
+                                        nZLibLevel, nThreads, *output_data,
+                                        output_size);
+        }
+
+#ifdef HAVE_LIBDEFLATE
+        const size_t nOutBytes =
+            CPLLibdeflateCompress(bGZip, clevel, input_data, input_size,
+                                  *output_data, *output_size);
+        if (nOutBytes == 0)
+#else
         size_t nOutBytes = 0;
         if (nullptr == pfnCompress(input_data, input_size, clevel, *output_data,
                                    *output_size, &nOutBytes))
+#endif
         {
             *output_size = 0;
             return false;
@@ -915,18 +1356,16 @@ static bool CPLZlibCompressor(const void *input_data, size_t input_size,
 
     if (output_data == nullptr && output_size != nullptr)
     {
-#if HAVE_LIBDEFLATE
-        struct libdeflate_compressor *enc = libdeflate_alloc_compressor(clevel);
-        if (enc == nullptr)
+        if (bMultiThreaded)
         {
-            *output_size = 0;
-            return false;
+            *output_size = CPLDeflateCompressMTBound(input_size);
+            return true;
         }
-        if (strcmp(alg, "zlib") == 0)
-            *output_size = libdeflate_zlib_compress_bound(enc, input_size);
-        else
-            *output_size = libdeflate_gzip_compress_bound(enc, input_size);
-        libdeflate_free_compressor(enc);
+
+#if HAVE_LIBDEFLATE
+        *output_size = CPLLibdeflateCompressBound(bGZip, clevel, input_size);
+        if (*output_size == 0)
+            return false;
 #else
         // Really inefficient !
         size_t nOutSize = 0;
@@ -946,6 +1385,36 @@ static bool CPLZlibCompressor(const void *input_data, size_t input_size,
     if (output_data != nullptr && *output_data == nullptr &&
         output_size != nullptr)
     {
+#ifdef HAVE_LIBDEFLATE
+        const bool bUseBound = true;
+#else
+        const bool bUseBound = bMultiThreaded;
+#endif
+        if (bUseBound)
+        {
+            size_t nSafeSize = 0;
+            if (!CPLZlibCompressor(input_data, input_size, nullptr, &nSafeSize,
+                                   options, compressor_user_data))
+            {
+                *output_size = 0;
+                return false;
+            }
+            *output_data = VSI_MALLOC_VERBOSE(nSafeSize);
+            *output_size = nSafeSize;
+            if (*output_data == nullptr)
+                return false;
+            bool ret =
+                CPLZlibCompressor(input_data, input_size, output_data,
+                                  output_size, options, compressor_user_data);
+            if (!ret)
+            {
+                VSIFree(*output_data);
+                *output_data = nullptr;
+            }
+            return ret;
+        }
+
+#ifndef HAVE_LIBDEFLATE
         size_t nOutSize = 0;
         *output_data =
             pfnCompress(input_data, input_size, clevel, nullptr, 0, &nOutSize);
@@ -956,6 +1425,7 @@ static bool CPLZlibCompressor(const void *input_data, size_t input_size,
         }
         *output_size = nOutSize;
         return true;
+#endif
     }
 
     CPLError(CE_Failure, CPLE_AppDefined, "Invalid use of API");
@@ -1319,7 +1789,8 @@ static void CPLAddBuiltinCompressors()
             "</Options>";
 
         const char *const apszMetadata[] = {
-            "BLOSC_VERSION=" BLOSC_VERSION_STRING, options.c_str(), nullptr};
+            "BLOSC_VERSION=" BLOSC_VERSION_STRING, "THREAD_SAFE=YES",
+            options.c_str(), nullptr};
         sComp.papszMetadata = apszMetadata;
         sComp.pfnFunc = CPLBloscCompressor;
         sComp.user_data = nullptr;
@@ -1336,7 +1807,8 @@ static void CPLAddBuiltinCompressors()
             "  <Option name='LEVEL' type='int' description='Compression level' "
             "min='1' max='9' default='6' />"
             "</Options>";
-        const char *const apszMetadata[] = {pszOptions, nullptr};
+        const char *const apszMetadata[] = {
+            "THREAD_SAFE=YES", MT_CHUNK_SIZE_METADATA, pszOptions, nullptr};
         sComp.papszMetadata = apszMetadata;
         sComp.pfnFunc = CPLZlibCompressor;
         sComp.user_data = const_cast<char *>("zlib");
@@ -1352,7 +1824,8 @@ static void CPLAddBuiltinCompressors()
             "  <Option name='LEVEL' type='int' description='Compression level' "
             "min='1' max='9' default='6' />"
             "</Options>";
-        const char *const apszMetadata[] = {pszOptions, nullptr};
+        const char *const apszMetadata[] = {
+            "THREAD_SAFE=YES", MT_CHUNK_SIZE_METADATA, pszOptions, nullptr};
         sComp.papszMetadata = apszMetadata;
         sComp.pfnFunc = CPLZlibCompressor;
         sComp.user_data = const_cast<char *>("gzip");
@@ -1371,7 +1844,8 @@ static void CPLAddBuiltinCompressors()
             "  <Option name='DELTA' type='int' description='Delta distance in "
             "byte' default='1' />"
             "</Options>";
-        const char *const apszMetadata[] = {pszOptions, nullptr};
+        const char *const apszMetadata[] = {"THREAD_SAFE=YES", pszOptions,
+                                            nullptr};
         sComp.papszMetadata = apszMetadata;
         sComp.pfnFunc = CPLLZMACompressor;
         sComp.user_data = nullptr;
@@ -1392,7 +1866,8 @@ static void CPLAddBuiltinCompressors()
             "to store a checksum when writing that will be verified' "
             "default='NO' />"
             "</Options>";
-        const char *const apszMetadata[] = {pszOptions, nullptr};
+        const char *const apszMetadata[] = {
+            "THREAD_SAFE=YES", MT_CHUNK_SIZE_METADATA, pszOptions, nullptr};
         sComp.papszMetadata = apszMetadata;
         sComp.pfnFunc = CPLZSTDCompressor;
         sComp.user_data = nullptr;
@@ -1414,7 +1889,8 @@ static void CPLAddBuiltinCompressors()
             "header with the uncompressed size should be included (as used by "
             "Zarr)' default='YES' />"
             "</Options>";
-        const char *const apszMetadata[] = {pszOptions, nullptr};
+        const char *const apszMetadata[] = {"THREAD_SAFE=YES", pszOptions,
+                                            nullptr};
         sComp.papszMetadata = apszMetadata;
         sComp.pfnFunc = CPLLZ4Compressor;
         sComp.user_data = nullptr;
@@ -1431,7 +1907,8 @@ static void CPLAddBuiltinCompressors()
             "  <Option name='DTYPE' type='string' description='Data type "
             "following NumPy array protocol type string (typestr) format'/>"
             "</Options>";
-        const char *const apszMetadata[] = {pszOptions, nullptr};
+        const char *const apszMetadata[] = {"THREAD_SAFE=YES", pszOptions,
+                                            nullptr};
         sComp.papszMetadata = apszMetadata;
         sComp.pfnFunc = CPLDeltaCompressor;
         sComp.user_data = nullptr;
@@ -1771,7 +2248,8 @@ static void CPLAddBuiltinDecompressors()
             "set to ALL_CPUS' default='1' />"
             "</Options>";
         const char *const apszMetadata[] = {
-            "BLOSC_VERSION=" BLOSC_VERSION_STRING, pszOptions, nullptr};
+            "BLOSC_VERSION=" BLOSC_VERSION_STRING, "THREAD_SAFE=YES",
+            pszOptions, nullptr};
         sComp.papszMetadata = apszMetadata;
         sComp.pfnFunc = CPLBloscDecompressor;
         sComp.user_data = nullptr;
@@ -1783,7 +2261,8 @@ static void CPLAddBuiltinDecompressors()
         sComp.nStructVersion = 1;
         sComp.eType = CCT_COMPRESSOR;
         sComp.pszId = "zlib";
-        sComp.papszMetadata = nullptr;
+        const char *const apszMetadata[] = {"THREAD_SAFE=YES", nullptr};
+        sComp.papszMetadata = apszMetadata;
         sComp.pfnFunc = CPLZlibDecompressor;
         sComp.user_data = nullptr;
         CPLAddDecompressor(&sComp);
@@ -1793,7 +2272,8 @@ static void CPLAddBuiltinDecompressors()
         sComp.nStructVersion = 1;
         sComp.eType = CCT_COMPRESSOR;
         sComp.pszId = "gzip";
-        sComp.papszMetadata = nullptr;
+        const char *const apszMetadata[] = {"THREAD_SAFE=YES", nullptr};
+        sComp.papszMetadata = apszMetadata;
         sComp.pfnFunc = CPLZlibDecompressor;
         sComp.user_data = nullptr;
         CPLAddDecompressor(&sComp);
@@ -1804,7 +2284,8 @@ static void CPLAddBuiltinDecompressors()
         sComp.nStructVersion = 1;
         sComp.eType = CCT_COMPRESSOR;
         sComp.pszId = "lzma";
-        sComp.papszMetadata = nullptr;
+        const char *const apszMetadata[] = {"THREAD_SAFE=YES", nullptr};
+        sComp.papszMetadata = apszMetadata;
         sComp.pfnFunc = CPLLZMADecompressor;
         sComp.user_data = nullptr;
         CPLAddDecompressor(&sComp);
@@ -1816,7 +2297,8 @@ static void CPLAddBuiltinDecompressors()
         sComp.nStructVersion = 1;
         sComp.eType = CCT_COMPRESSOR;
         sComp.pszId = "zstd";
-        sComp.papszMetadata = nullptr;
+        const char *const apszMetadata[] = {"THREAD_SAFE=YES", nullptr};
+        sComp.papszMetadata = apszMetadata;
         sComp.pfnFunc = CPLZSTDDecompressor;
         sComp.user_data = nullptr;
         CPLAddDecompressor(&sComp);
@@ -1834,7 +2316,8 @@ static void CPLAddBuiltinDecompressors()
             "header with the uncompressed size should be included (as used by "
             "Zarr)' default='YES' />"
             "</Options>";
-        const char *const apszMetadata[] = {pszOptions, nullptr};
+        const char *const apszMetadata[] = {"THREAD_SAFE=YES", pszOptions,
+                                            nullptr};
         sComp.papszMetadata = apszMetadata;
         sComp.pfnFunc = CPLLZ4Decompressor;
         sComp.user_data = nullptr;
@@ -1851,7 +2334,8 @@ static void CPLAddBuiltinDecompressors()
             "  <Option name='DTYPE' type='string' description='Data type "
             "following NumPy array protocol type string (typestr) format'/>"
             "</Options>";
-        const char *const apszMetadata[] = {pszOptions, nullptr};
+        const char *const apszMetadata[] = {"THREAD_SAFE=YES", pszOptions,
+                                            nullptr};
         sComp.papszMetadata = apszMetadata;
         sComp.pfnFunc = CPLDeltaDecompressor;
         sComp.user_data = nullptr;
@@ -2034,6 +2518,12 @@ void CPLDestroyCompressorRegistry(void)
 
     CPLDestroyCompressorRegistryInternal(gpCompressors);
     CPLDestroyCompressorRegistryInternal(gpDecompressors);
+
+    CPLClearCodecContextPools();
+    {
+        std::lock_guard<std::mutex> oLock(gThreadPoolMutex);
+        gpoThreadPool.reset();
+    }
 }
 
 /*! @endcond */
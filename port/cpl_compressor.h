@@ -83,6 +83,15 @@ typedef struct
      * &lt;Options&gt;
      *   &lt;Option name='' type='' description='' default=''/&gt;
      * &lt;/Options&gt;
+     * The THREAD_SAFE=YES metadata item (since GDAL 3.12) indicates that the
+     * callback may be called concurrently from several threads.
+     * The PREFERRED_CHUNK_SIZE=bytes metadata item (since GDAL 3.12) indicates
+     * that the compressor accepts a NUM_THREADS=integer|ALL_CPUS option (not
+     * listed in OPTIONS, as it does not affect the compressed stream), and
+     * the size of the pieces in which the input is then split. Inputs
+     * smaller than twice that size are processed by a single thread, so
+     * callers having many small buffers should rather process them
+     * concurrently.
      */
     CSLConstList papszMetadata;
     /** Compressor/decompressor callback. Should NOT be NULL. */
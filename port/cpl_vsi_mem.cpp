@@ -365,6 +365,8 @@ int VSIMemHandle::Close()
                  this, poFile->osFilename.c_str(),
                  static_cast<int>(poFile.use_count()));
 #endif
+        if (bUpdate)
+            VSISharedCachedFileInvalidate(poFile->osFilename.c_str());
         poFile = nullptr;
     }
 
@@ -717,6 +719,8 @@ VSIVirtualHandle *VSIMemFilesystemHandler::Open(const char *pszFilename,
     poHandle->bUpdate = strchr(pszAccess, 'w') || strchr(pszAccess, '+') ||
                         strchr(pszAccess, 'a');
     poHandle->m_bReadAllowed = strchr(pszAccess, 'r') || strchr(pszAccess, '+');
+    if (poHandle->bUpdate)
+        VSISharedCachedFileInvalidate(poFile->osFilename.c_str());
 
 #ifdef DEBUG_VERBOSE
     CPLDebug("VSIMEM", "Opening handle %p on %s: ref_count=%d", poHandle,
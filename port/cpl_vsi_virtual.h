@@ -557,6 +557,11 @@ VSIVirtualHandle CPL_DLL *
 VSICreateCachedFile(VSIVirtualHandle *poBaseHandle,
                     size_t nChunkSize = VSI_CACHED_DEFAULT_CHUNK_SIZE,
                     size_t nCacheSize = 0);
+VSIVirtualHandle CPL_DLL *
+VSICreateSharedCachedFile(VSIVirtualHandle *poBaseHandle,
+                          const char *pszFilename,
+                          size_t nChunkSize = VSI_CACHED_DEFAULT_CHUNK_SIZE);
+void VSISharedCachedFileInvalidate(const char *pszFilename);
 
 const int CPL_DEFLATE_TYPE_GZIP = 0;
 const int CPL_DEFLATE_TYPE_ZLIB = 1;
@@ -25,6 +25,8 @@
 #endif
 
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <limits>
 #include <map>
 #include <memory>
@@ -36,10 +38,12 @@
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
+#include "cpl_error_internal.h"
 #include "cpl_multiproc.h"
 #include "cpl_string.h"
 #include "cpl_vsi_virtual.h"
 #include "cpl_vsil_curl_class.h"
+#include "cpl_worker_thread_pool.h"
 
 // To avoid aliasing to GetDiskFreeSpace to GetDiskFreeSpaceA on Windows
 #ifdef GetDiskFreeSpace
@@ -910,6 +914,11 @@ int VSIMove(const char *oldpath, const char *newpath,
  * - /vsiadls/ -> /vsiadls/
  * - any of the above or /vsicurl/ -> /vsiaz/ (starting with GDAL 3.8)
  *
+ * Otherwise, starting with GDAL 3.12, sources on network file systems that
+ * are large enough are read with parallel ranged requests, as controlled by
+ * the CPL_VSIL_COPYFILE_NUM_THREADS and CPL_VSIL_COPYFILE_CHUNK_SIZE
+ * configuration options.
+ *
  * @param pszSource Source filename. UTF-8 encoded. May be NULL if fpSource is
  * not NULL.
  * @param pszTarget Target filename.  UTF-8 encoded. Must not be NULL
@@ -2038,6 +2047,161 @@ VSIVirtualHandle *VSIFilesystemHandler::Open(const char *pszFilename,
     return Open(pszFilename, pszAccess, false, nullptr);
 }
 
+/************************************************************************/
+/*                       CopyFileParallelRanges()                       */
+/************************************************************************/
+
+/** Copy the bytes of pszSource from nStartOffset to its size nSourceSize
+ * into fpOut, by reading chunks of nChunkSize bytes with nThreads parallel
+ * ranged reads, each one from its own handle on pszSource, and writing them
+ * in order.
+ *
+ * At most nThreads chunks are held in memory at a time.
+ */
+static int CopyFileParallelRanges(const char *pszSource, const char *pszTarget,
+                                  VSILFILE *fpOut, vsi_l_offset nStartOffset,
+                                  vsi_l_offset nSourceSize, size_t nChunkSize,
+                                  int nThreads,
+                                  const std::string &osMsg,
+                                  GDALProgressFunc pProgressFunc,
+                                  void *pProgressData, GUIntBig &nOffset)
+{
+    CPLWorkerThreadPool oPool;
+    if (!oPool.Setup(nThreads, nullptr, nullptr))
+        return -1;
+
+    struct Chunk
+    {
+        std::vector<GByte> abyData{};
+        bool bDone = false;
+        bool bOK = false;
+    };
+
+    // Ring buffer of chunks, indexed by chunk number modulo nThreads
+    std::vector<Chunk> aoChunks(nThreads);
+    std::mutex oMutex;
+    std::condition_variable oCV;
+    std::atomic<bool> bStop{false};
+    CPLErrorAccumulator oErrorAccumulator;
+
+    const vsi_l_offset nCopySize = nSourceSize - nStartOffset;
+    const auto GetChunkSize = [nCopySize, nChunkSize](uint64_t iChunk)
+    {
+        return static_cast<size_t>(std::min<vsi_l_offset>(
+            nChunkSize, nCopySize - iChunk * nChunkSize));
+    };
+
+    const auto SubmitChunk = [&](uint64_t iChunk)
+    {
+        Chunk &oChunk = aoChunks[iChunk % nThreads];
+        const size_t nSize = GetChunkSize(iChunk);
+        try
+        {
+            oChunk.abyData.resize(nSize);
+        }
+        catch (const std::exception &)
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "Cannot allocate %" PRIu64 " bytes",
+                     static_cast<uint64_t>(nSize));
+            return false;
+        }
+        oChunk.bDone = false;
+        oChunk.bOK = false;
+        const vsi_l_offset nStart = nStartOffset + iChunk * nChunkSize;
+        return oPool.SubmitJob(
+            [pszSource, nStart, nSize, &oChunk, &oMutex, &oCV, &bStop,
+             &oErrorAccumulator]()
+            {
+                bool bOK = false;
+                if (!bStop)
+                {
+                    auto oAccumulator =
+                        oErrorAccumulator.InstallForCurrentScope();
+                    CPL_IGNORE_RET_VAL(oAccumulator);
+
+                    VSIVirtualHandleUniquePtr fp(
+                        VSIFOpenExL(pszSource, "rb", TRUE));
+                    bOK = fp && fp->Seek(nStart, SEEK_SET) == 0 &&
+                          fp->Read(oChunk.abyData.data(), 1, nSize) == nSize;
+                }
+                std::lock_guard oLock(oMutex);
+                oChunk.bOK = bOK;
+                oChunk.bDone = true;
+                oCV.notify_all();
+            });
+    };
+
+    const uint64_t nChunks =
+        nCopySize / nChunkSize + ((nCopySize % nChunkSize) != 0 ? 1 : 0);
+    uint64_t iNextChunk = 0;
+    bool bReadError = false;
+    bool bWriteError = false;
+    bool bStopped = false;
+    for (; iNextChunk < nChunks && iNextChunk < static_cast<uint64_t>(nThreads);
+         ++iNextChunk)
+    {
+        if (!SubmitChunk(iNextChunk))
+        {
+            bStopped = true;
+            break;
+        }
+    }
+
+    for (uint64_t iChunk = 0; !bStopped && iChunk < nChunks; ++iChunk)
+    {
+        Chunk &oChunk = aoChunks[iChunk % nThreads];
+        {
+            std::unique_lock oLock(oMutex);
+            oCV.wait(oLock, [&oChunk] { return oChunk.bDone; });
+        }
+        if (!oChunk.bOK)
+        {
+            bReadError = true;
+            break;
+        }
+        const size_t nSize = GetChunkSize(iChunk);
+        if (VSIFWriteL(oChunk.abyData.data(), 1, nSize, fpOut) != nSize)
+        {
+            bWriteError = true;
+            break;
+        }
+        nOffset += nSize;
+        if (pProgressFunc &&
+            !pProgressFunc(double(nOffset) / nSourceSize,
+                           !osMsg.empty() ? osMsg.c_str() : nullptr,
+                           pProgressData))
+        {
+            bStopped = true;
+            break;
+        }
+        if (iNextChunk < nChunks && !SubmitChunk(iNextChunk++))
+        {
+            bStopped = true;
+            break;
+        }
+    }
+
+    bStop = true;
+    oPool.WaitCompletion();
+    oErrorAccumulator.ReplayErrors();
+
+    if (bReadError)
+    {
+        CPLError(CE_Failure, CPLE_FileIO,
+                 "Copying of %s to %s failed: error while reading source file",
+                 pszSource, pszTarget);
+    }
+    else if (bWriteError)
+    {
+        CPLError(CE_Failure, CPLE_FileIO,
+                 "Copying of %s to %s failed: error while writing into "
+                 "target file",
+                 pszSource, pszTarget);
+    }
+    return bReadError || bWriteError || bStopped ? -1 : 0;
+}
+
 /************************************************************************/
 /*                             CopyFile()                               */
 /************************************************************************/
@@ -2070,6 +2234,57 @@ int VSIFilesystemHandler::CopyFile(const char *pszSource, const char *pszTarget,
         }
     }
 
+    // Large files on network file systems are read with parallel ranged
+    // requests, since a single sequential stream rarely saturates the link.
+    // As the sequential copy, they go from the current position of fpSource
+    // to the end of the file.
+    int nParallelThreads = 0;
+    size_t nParallelChunkSize = 0;
+    vsi_l_offset nParallelStartOffset = 0;
+    if (pszSource)
+    {
+        VSIFilesystemHandler *poSourceFSHandler =
+            VSIFileManager::GetHandler(pszSource);
+        if (!poSourceFSHandler->IsLocal(pszSource) &&
+            poSourceFSHandler->HasOptimizedReadMultiRange(pszSource))
+        {
+            const char *pszNumThreads =
+                CPLGetConfigOption("CPL_VSIL_COPYFILE_NUM_THREADS", "4");
+            nParallelThreads = EQUAL(pszNumThreads, "ALL_CPUS")
+                                   ? CPLGetNumCPUs()
+                                   : std::clamp(atoi(pszNumThreads), 0, 64);
+            const GIntBig nChunkSize = CPLParseMemorySize(
+                CPLGetConfigOption("CPL_VSIL_COPYFILE_CHUNK_SIZE", "8MB"),
+                nullptr, nullptr);
+            if (nChunkSize > 0 && nChunkSize <= 1024 * 1024 * 1024)
+                nParallelChunkSize = static_cast<size_t>(nChunkSize);
+            if (nParallelThreads > 1 && nParallelChunkSize > 0)
+            {
+                // The ranges are read from pszSource, which must thus be
+                // the file behind fpSource, with the expected size.
+                VSIStatBufL sStat;
+                if (VSIStatL(pszSource, &sStat) == 0 &&
+                    (nSourceSize == static_cast<vsi_l_offset>(-1) ||
+                     nSourceSize == static_cast<vsi_l_offset>(sStat.st_size)))
+                {
+                    nSourceSize = sStat.st_size;
+                    nParallelStartOffset = VSIFTellL(fpSource);
+                }
+                else
+                {
+                    nParallelThreads = 0;
+                }
+            }
+            if (nParallelChunkSize == 0 ||
+                nSourceSize == static_cast<vsi_l_offset>(-1) ||
+                nParallelStartOffset > nSourceSize ||
+                (nSourceSize - nParallelStartOffset) / 2 < nParallelChunkSize)
+            {
+                nParallelThreads = 0;
+            }
+        }
+    }
+
     VSILFILE *fpOut = VSIFOpenEx2L(pszTarget, "wb", TRUE, papszOptions);
     if (!fpOut)
     {
@@ -2084,51 +2299,71 @@ int VSIFilesystemHandler::CopyFile(const char *pszSource, const char *pszTarget,
         pszSource = "(unknown filename)";
 
     int ret = 0;
-    constexpr size_t nBufferSize = 10 * 4096;
-    std::vector<GByte> abyBuffer(nBufferSize, 0);
     GUIntBig nOffset = 0;
-    while (true)
+    if (nParallelThreads > 1)
     {
-        const size_t nRead = VSIFReadL(&abyBuffer[0], 1, nBufferSize, fpSource);
-        if (nRead < nBufferSize && VSIFErrorL(fpSource))
-        {
-            CPLError(
-                CE_Failure, CPLE_FileIO,
-                "Copying of %s to %s failed: error while reading source file",
-                pszSource, pszTarget);
-            ret = -1;
-            break;
-        }
-        if (nRead > 0)
+        CPLDebug("VSI", "Copying %s with %d threads and %" PRIu64
+                        "-byte chunks",
+                 pszSource, nParallelThreads,
+                 static_cast<uint64_t>(nParallelChunkSize));
+        ret = CopyFileParallelRanges(
+            pszSource, pszTarget, fpOut, nParallelStartOffset, nSourceSize,
+            nParallelChunkSize, nParallelThreads, osMsg, pProgressFunc,
+            pProgressData, nOffset);
+        // Leave fpSource at the end of file, as the sequential copy does
+        if (ret == 0)
+            VSIFSeekL(fpSource, nSourceSize, SEEK_SET);
+    }
+    else
+    {
+        constexpr size_t nBufferSize = 10 * 4096;
+        std::vector<GByte> abyBuffer(nBufferSize, 0);
+        while (true)
         {
-            const size_t nWritten = VSIFWriteL(&abyBuffer[0], 1, nRead, fpOut);
-            if (nWritten != nRead)
+            const size_t nRead =
+                VSIFReadL(&abyBuffer[0], 1, nBufferSize, fpSource);
+            if (nRead < nBufferSize && VSIFErrorL(fpSource))
             {
                 CPLError(CE_Failure, CPLE_FileIO,
-                         "Copying of %s to %s failed: error while writing into "
-                         "target file",
+                         "Copying of %s to %s failed: error while reading "
+                         "source file",
                          pszSource, pszTarget);
                 ret = -1;
                 break;
             }
-            nOffset += nRead;
-            if (pProgressFunc &&
-                !pProgressFunc(
-                    nSourceSize == 0 ? 1.0
-                    : nSourceSize > 0 &&
-                            nSourceSize != static_cast<vsi_l_offset>(-1)
-                        ? double(nOffset) / nSourceSize
-                        : 0.0,
-                    !osMsg.empty() ? osMsg.c_str() : nullptr, pProgressData))
+            if (nRead > 0)
+            {
+                const size_t nWritten =
+                    VSIFWriteL(&abyBuffer[0], 1, nRead, fpOut);
+                if (nWritten != nRead)
+                {
+                    CPLError(CE_Failure, CPLE_FileIO,
+                             "Copying of %s to %s failed: error while writing "
+                             "into target file",
+                             pszSource, pszTarget);
+                    ret = -1;
+                    break;
+                }
+                nOffset += nRead;
+                if (pProgressFunc &&
+                    !pProgressFunc(
+                        nSourceSize == 0 ? 1.0
+                        : nSourceSize > 0 &&
+                                nSourceSize != static_cast<vsi_l_offset>(-1)
+                            ? double(nOffset) / nSourceSize
+                            : 0.0,
+                        !osMsg.empty() ? osMsg.c_str() : nullptr,
+                        pProgressData))
+                {
+                    ret = -1;
+                    break;
+                }
+            }
+            if (nRead < nBufferSize)
             {
-                ret = -1;
                 break;
             }
         }
-        if (nRead < nBufferSize)
-        {
-            break;
-        }
     }
 
     if (nSourceSize != static_cast<vsi_l_offset>(-1) && nOffset != nSourceSize)
@@ -2750,6 +2985,12 @@ VSILFILE *VSIFOpenExL(const char *pszFilename, const char *pszAccess,
  * set the FILE_FLAG_WRITE_THROUGH flag to the CreateFile() function. In that
  * mode, the data is written to the system cache but is flushed to disk without
  * delay.</li>
+ * <li>DIRECT_IO=YES (GDAL >= 3.12) for the Unix regular files to open them
+ * with the O_DIRECT flag, so that reads and writes bypass the page cache. Data
+ * goes through an internal 4 MB bounce buffer. Append modes are not
+ * supported and are silently opened in buffered mode, as are files on file
+ * systems that do not support O_DIRECT. Defaults to the value of the
+ * CPL_VSIL_LOCAL_DIRECT_IO configuration option.</li>
  * </ul>
  *
  * Options specifics to /vsis3/, /vsigs/, /vsioss/ and /vsiaz/ in "w" mode:
@@ -2758,6 +2999,12 @@ VSILFILE *VSIFOpenExL(const char *pszFilename, const char *pszAccess,
  * For /vsis3/, /vsigz/, /vsioss/, it can be up to 5000 MiB.
  * For /vsiaz/, only taken into account when BLOB_TYPE=BLOCK. It can be up to 4000 MiB.
  * </li>
+ * <li>NUM_THREADS=integer or ALL_CPUS. (GDAL >= 3.12) Number of parts that
+ * can be uploaded in the background while the next one is being filled.
+ * For /vsiaz/, only taken into account when BLOB_TYPE=BLOCK. Defaults to the
+ * value of the CPL_VSIL_MULTIPART_UPLOAD_NUM_THREADS configuration option,
+ * or 0 (synchronous upload of each part).
+ * </li>
  * </ul>
  *
  * Options specifics to /vsiaz/ in "w" mode:
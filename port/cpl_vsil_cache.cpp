@@ -21,10 +21,18 @@
 #endif
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <functional>
 #include <limits>
+#include <list>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
@@ -497,6 +505,503 @@ int VSICachedFile::Flush()
     return 0;
 }
 
+/************************************************************************/
+/* ==================================================================== */
+/*                          VSISharedChunkCache                         */
+/* ==================================================================== */
+/************************************************************************/
+
+/** Process-wide cache of file chunks, shared by all VSISharedCachedFile
+ * handles.
+ *
+ * Chunks are keyed by a string identifying the file content (filename,
+ * modification time, size, generation and chunk size) and the chunk index.
+ * The generation of a file is incremented every time it is opened or closed
+ * in write mode in this process, since its modification time may not change
+ * if it is rewritten quickly with the same size. The cache is
+ * split into shards, each one with its own mutex and LRU list, so that
+ * concurrent readers of different chunks rarely contend. Chunks are
+ * reference-counted, so that they can be copied out of the cache without
+ * holding the shard lock.
+ */
+class VSISharedChunkCache
+{
+  public:
+    struct Key
+    {
+        std::string osFileKey{};
+        vsi_l_offset nChunk = 0;
+
+        bool operator==(const Key &other) const
+        {
+            return nChunk == other.nChunk && osFileKey == other.osFileKey;
+        }
+    };
+
+    struct KeyHasher
+    {
+        size_t operator()(const Key &key) const
+        {
+            return std::hash<std::string>()(key.osFileKey) ^
+                   (std::hash<vsi_l_offset>()(key.nChunk) * 31);
+        }
+    };
+
+    using ChunkPtr = std::shared_ptr<const cpl::NonCopyableVector<GByte>>;
+
+    static VSISharedChunkCache &Get();
+
+    ChunkPtr Lookup(const Key &key);
+    ChunkPtr Insert(const Key &key, cpl::NonCopyableVector<GByte> &&oData);
+    void SetMaxSize(size_t nMaxSize);
+
+    size_t GetMaxSize() const
+    {
+        return m_nMaxSizePerShard * SHARD_COUNT;
+    }
+
+    uint64_t GetGeneration(const std::string &osFilename);
+    void Invalidate(const char *pszFilename);
+
+  private:
+    static constexpr int SHARD_COUNT = 16;
+
+    using LRUCache = lru11::Cache<
+        Key, ChunkPtr, lru11::NullLock,
+        std::unordered_map<
+            Key,
+            typename std::list<lru11::KeyValuePair<Key, ChunkPtr>>::iterator,
+            KeyHasher>>;
+
+    struct Shard
+    {
+        std::mutex oMutex{};
+        // Unbounded: eviction is driven by nSize against the byte budget
+        LRUCache oCache{0, 0};
+        size_t nSize = 0;
+    };
+
+    std::array<Shard, SHARD_COUNT> m_aoShards{};
+    std::atomic<size_t> m_nMaxSizePerShard{0};
+
+    // Generation of the files opened through the cache
+    std::mutex m_oMutexGenerations{};
+    std::map<std::string, uint64_t> m_oMapGenerations{};
+
+    VSISharedChunkCache() = default;
+
+    Shard &GetShard(const Key &key)
+    {
+        return m_aoShards[KeyHasher()(key) % SHARD_COUNT];
+    }
+};
+
+/************************************************************************/
+/*                     VSISharedChunkCache::Get()                       */
+/************************************************************************/
+
+// Whether VSICreateSharedCachedFile() has been called, so that file systems
+// notifying writes do not instantiate the cache
+static std::atomic<bool> gbSharedChunkCacheUsed{false};
+
+VSISharedChunkCache &VSISharedChunkCache::Get()
+{
+    static VSISharedChunkCache oCache;
+    return oCache;
+}
+
+/************************************************************************/
+/*                    VSISharedChunkCache::Lookup()                     */
+/************************************************************************/
+
+VSISharedChunkCache::ChunkPtr VSISharedChunkCache::Lookup(const Key &key)
+{
+    Shard &oShard = GetShard(key);
+    std::lock_guard oLock(oShard.oMutex);
+    ChunkPtr poChunk;
+    oShard.oCache.tryGet(key, poChunk);
+    return poChunk;
+}
+
+/************************************************************************/
+/*                    VSISharedChunkCache::Insert()                     */
+/************************************************************************/
+
+/** Insert a chunk, and evict the least recently used chunks of the shard
+ * if it exceeds its byte budget.
+ *
+ * If another thread has inserted the same chunk in the meantime, the
+ * existing one is returned.
+ */
+VSISharedChunkCache::ChunkPtr
+VSISharedChunkCache::Insert(const Key &key,
+                            cpl::NonCopyableVector<GByte> &&oData)
+{
+    auto poChunk =
+        std::make_shared<const cpl::NonCopyableVector<GByte>>(std::move(oData));
+    Shard &oShard = GetShard(key);
+    std::lock_guard oLock(oShard.oMutex);
+    ChunkPtr poExisting;
+    if (oShard.oCache.tryGet(key, poExisting))
+        return poExisting;
+    oShard.oCache.insert(key, poChunk);
+    oShard.nSize += poChunk->size();
+    const size_t nMaxSize = m_nMaxSizePerShard;
+    ChunkPtr poEvicted;
+    while (oShard.nSize > nMaxSize && oShard.oCache.size() > 1 &&
+           oShard.oCache.removeAndRecycleOldestEntry(poEvicted))
+    {
+        oShard.nSize -= poEvicted->size();
+    }
+    return poChunk;
+}
+
+/************************************************************************/
+/*                  VSISharedChunkCache::SetMaxSize()                   */
+/************************************************************************/
+
+void VSISharedChunkCache::SetMaxSize(size_t nMaxSize)
+{
+    m_nMaxSizePerShard = std::max<size_t>(1, nMaxSize / SHARD_COUNT);
+}
+
+/************************************************************************/
+/*                 VSISharedChunkCache::GetGeneration()                 */
+/************************************************************************/
+
+uint64_t VSISharedChunkCache::GetGeneration(const std::string &osFilename)
+{
+    std::lock_guard oLock(m_oMutexGenerations);
+    // Creates the entry, so that Invalidate() tracks the file
+    return m_oMapGenerations[osFilename];
+}
+
+/************************************************************************/
+/*                  VSISharedChunkCache::Invalidate()                   */
+/************************************************************************/
+
+/** Make the chunks cached for pszFilename unreachable by handles opened
+ * afterwards. They are evicted as they become the least recently used ones.
+ */
+void VSISharedChunkCache::Invalidate(const char *pszFilename)
+{
+    std::lock_guard oLock(m_oMutexGenerations);
+    auto oIter = m_oMapGenerations.find(pszFilename);
+    if (oIter != m_oMapGenerations.end())
+        ++oIter->second;
+}
+
+/************************************************************************/
+/* ==================================================================== */
+/*                          VSISharedCachedFile                         */
+/* ==================================================================== */
+/************************************************************************/
+
+/** Read-only handle whose reads go through the process-wide
+ * VSISharedChunkCache.
+ *
+ * PRead() is thread-safe and only serializes on the base handle for chunks
+ * that are not in the cache, and only if the base handle has no PRead()
+ * implementation of its own.
+ */
+class VSISharedCachedFile final : public VSIVirtualHandle
+{
+    CPL_DISALLOW_COPY_ASSIGN(VSISharedCachedFile)
+
+    VSIVirtualHandleUniquePtr m_poBase{};
+    std::string m_osFileKey{};
+    size_t m_nChunkSize = 0;
+    vsi_l_offset m_nFileSize = 0;
+    vsi_l_offset m_nOffset = 0;
+    bool m_bEOF = false;
+    bool m_bError = false;
+    mutable std::mutex m_oMutexBase{};
+    mutable std::atomic<bool> m_bBaseError{false};
+
+    size_t ReadFromBase(void *pBuffer, size_t nSize,
+                        vsi_l_offset nOffset) const;
+    size_t ReadAt(void *pBuffer, size_t nSize, vsi_l_offset nOffset) const;
+
+  public:
+    VSISharedCachedFile(VSIVirtualHandle *poBaseHandle,
+                        const std::string &osFileKey, size_t nChunkSize);
+
+    ~VSISharedCachedFile() override
+    {
+        VSISharedCachedFile::Close();
+    }
+
+    int Seek(vsi_l_offset nOffset, int nWhence) override;
+
+    vsi_l_offset Tell() override
+    {
+        return m_nOffset;
+    }
+
+    size_t Read(void *pBuffer, size_t nSize, size_t nMemb) override;
+    int ReadMultiRange(int nRanges, void **ppData,
+                       const vsi_l_offset *panOffsets,
+                       const size_t *panSizes) override;
+
+    void AdviseRead(int nRanges, const vsi_l_offset *panOffsets,
+                    const size_t *panSizes) override
+    {
+        std::lock_guard oLock(m_oMutexBase);
+        m_poBase->AdviseRead(nRanges, panOffsets, panSizes);
+    }
+
+    size_t Write(const void *, size_t, size_t) override
+    {
+        return 0;
+    }
+
+    void ClearErr() override
+    {
+        std::lock_guard oLock(m_oMutexBase);
+        m_poBase->ClearErr();
+        m_bEOF = false;
+        m_bError = false;
+        m_bBaseError = false;
+    }
+
+    int Eof() override
+    {
+        return m_bEOF;
+    }
+
+    int Error() override
+    {
+        return m_bError;
+    }
+
+    int Close() override
+    {
+        m_poBase.reset();
+        return 0;
+    }
+
+    void *GetNativeFileDescriptor() override
+    {
+        return m_poBase->GetNativeFileDescriptor();
+    }
+
+    bool HasPRead() const override
+    {
+        return true;
+    }
+
+    size_t PRead(void *pBuffer, size_t nSize,
+                 vsi_l_offset nOffset) const override
+    {
+        return ReadAt(pBuffer, nSize, nOffset);
+    }
+};
+
+/************************************************************************/
+/*                        VSISharedCachedFile()                         */
+/************************************************************************/
+
+VSISharedCachedFile::VSISharedCachedFile(VSIVirtualHandle *poBaseHandle,
+                                         const std::string &osFileKey,
+                                         size_t nChunkSize)
+    : m_poBase(poBaseHandle), m_nChunkSize(nChunkSize)
+{
+    m_poBase->Seek(0, SEEK_END);
+    m_nFileSize = m_poBase->Tell();
+    m_osFileKey = osFileKey;
+    m_osFileKey += '\0';
+    m_osFileKey += std::to_string(m_nFileSize);
+    m_osFileKey += '\0';
+    m_osFileKey += std::to_string(m_nChunkSize);
+}
+
+/************************************************************************/
+/*                                Seek()                                */
+/************************************************************************/
+
+int VSISharedCachedFile::Seek(vsi_l_offset nOffset, int nWhence)
+{
+    m_bEOF = false;
+    if (nWhence == SEEK_CUR)
+        nOffset += m_nOffset;
+    else if (nWhence == SEEK_END)
+        nOffset += m_nFileSize;
+    m_nOffset = nOffset;
+    return 0;
+}
+
+/************************************************************************/
+/*                            ReadFromBase()                            */
+/************************************************************************/
+
+size_t VSISharedCachedFile::ReadFromBase(void *pBuffer, size_t nSize,
+                                         vsi_l_offset nOffset) const
+{
+    size_t nRead;
+    if (m_poBase->HasPRead())
+    {
+        // Callers never read past the end of file, so a short read is an
+        // error
+        nRead = m_poBase->PRead(pBuffer, nSize, nOffset);
+        if (nRead < nSize)
+            m_bBaseError = true;
+    }
+    else
+    {
+        std::lock_guard oLock(m_oMutexBase);
+        nRead = m_poBase->Seek(nOffset, SEEK_SET) == 0
+                    ? m_poBase->Read(pBuffer, 1, nSize)
+                    : 0;
+        if (nRead < nSize && m_poBase->Error())
+            m_bBaseError = true;
+    }
+    return nRead;
+}
+
+/************************************************************************/
+/*                               ReadAt()                               */
+/************************************************************************/
+
+size_t VSISharedCachedFile::ReadAt(void *pBuffer, size_t nSize,
+                                   vsi_l_offset nOffset) const
+{
+    if (nSize == 0 || nOffset >= m_nFileSize)
+        return 0;
+    nSize = static_cast<size_t>(
+        std::min<vsi_l_offset>(nSize, m_nFileSize - nOffset));
+
+    auto &oCache = VSISharedChunkCache::Get();
+    // Caching a request larger than the cache would only evict everything
+    // else
+    if (nSize >= oCache.GetMaxSize())
+        return ReadFromBase(pBuffer, nSize, nOffset);
+
+    const vsi_l_offset nStartChunk = nOffset / m_nChunkSize;
+    const vsi_l_offset nEndChunk = (nOffset + nSize - 1) / m_nChunkSize;
+
+    // Hold references to the chunks of the request, so that they cannot be
+    // evicted by other readers before being copied.
+    std::vector<VSISharedChunkCache::ChunkPtr> apoChunks;
+    try
+    {
+        apoChunks.resize(static_cast<size_t>(nEndChunk - nStartChunk + 1));
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory situation in VSISharedCachedFile::ReadAt()");
+        return 0;
+    }
+    VSISharedChunkCache::Key key;
+    key.osFileKey = m_osFileKey;
+    for (size_t i = 0; i < apoChunks.size(); ++i)
+    {
+        key.nChunk = nStartChunk + i;
+        apoChunks[i] = oCache.Lookup(key);
+    }
+
+    // Load runs of missing chunks with a single read each
+    for (size_t i = 0; i < apoChunks.size();)
+    {
+        if (apoChunks[i])
+        {
+            ++i;
+            continue;
+        }
+        size_t nCount = 1;
+        while (i + nCount < apoChunks.size() && !apoChunks[i + nCount])
+            ++nCount;
+
+        const vsi_l_offset nRunOffset = (nStartChunk + i) * m_nChunkSize;
+        const size_t nRunSize = static_cast<size_t>(std::min<vsi_l_offset>(
+            nCount * m_nChunkSize, m_nFileSize - nRunOffset));
+        try
+        {
+            cpl::NonCopyableVector<GByte> abyRun(nRunSize);
+            const size_t nRead =
+                ReadFromBase(abyRun.data(), nRunSize, nRunOffset);
+            for (size_t j = 0; j < nCount && j * m_nChunkSize < nRead; ++j)
+            {
+                const size_t nChunkDataSize =
+                    std::min(m_nChunkSize, nRead - j * m_nChunkSize);
+                cpl::NonCopyableVector<GByte> oData(nChunkDataSize);
+                memcpy(oData.data(), abyRun.data() + j * m_nChunkSize,
+                       nChunkDataSize);
+                key.nChunk = nStartChunk + i + j;
+                apoChunks[i + j] = oCache.Insert(key, std::move(oData));
+            }
+            if (nRead < nRunSize)
+                break;
+        }
+        catch (const std::exception &)
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "Out of memory situation in "
+                     "VSISharedCachedFile::ReadAt()");
+            break;
+        }
+        i += nCount;
+    }
+
+    // Copy data into the target buffer to the extent possible
+    size_t nCopied = 0;
+    for (size_t i = 0; i < apoChunks.size() && nCopied < nSize; ++i)
+    {
+        if (!apoChunks[i])
+            break;
+        const vsi_l_offset nChunkOffset = (nStartChunk + i) * m_nChunkSize;
+        const size_t nOffsetInChunk =
+            static_cast<size_t>(nOffset + nCopied - nChunkOffset);
+        if (nOffsetInChunk >= apoChunks[i]->size())
+            break;
+        const size_t nToCopy =
+            std::min(nSize - nCopied, apoChunks[i]->size() - nOffsetInChunk);
+        memcpy(static_cast<GByte *>(pBuffer) + nCopied,
+               apoChunks[i]->data() + nOffsetInChunk, nToCopy);
+        nCopied += nToCopy;
+        // A partial chunk means a short read of the base handle
+        if (apoChunks[i]->size() < m_nChunkSize)
+            break;
+    }
+    return nCopied;
+}
+
+/************************************************************************/
+/*                                Read()                                */
+/************************************************************************/
+
+size_t VSISharedCachedFile::Read(void *pBuffer, size_t nSize, size_t nCount)
+{
+    if (nSize == 0 || nCount == 0)
+        return 0;
+    const size_t nRequestedBytes = nSize * nCount;
+    const size_t nRead = ReadAt(pBuffer, nRequestedBytes, m_nOffset);
+    m_nOffset += nRead;
+    if (m_bBaseError)
+        m_bError = true;
+
+    const size_t nRet = nRead / nSize;
+    if (nRet != nCount && !m_bError)
+        m_bEOF = true;
+    return nRet;
+}
+
+/************************************************************************/
+/*                           ReadMultiRange()                           */
+/************************************************************************/
+
+int VSISharedCachedFile::ReadMultiRange(int nRanges, void **ppData,
+                                        const vsi_l_offset *panOffsets,
+                                        const size_t *panSizes)
+{
+    for (int i = 0; i < nRanges; ++i)
+    {
+        if (ReadAt(ppData[i], panSizes[i], panOffsets[i]) != panSizes[i])
+            return -1;
+    }
+    return 0;
+}
+
 /************************************************************************/
 /*                      VSICachedFilesystemHandler                      */
 /************************************************************************/
@@ -505,7 +1010,8 @@ class VSICachedFilesystemHandler final : public VSIFilesystemHandler
 {
     static bool AnalyzeFilename(const char *pszFilename,
                                 std::string &osUnderlyingFilename,
-                                size_t &nChunkSize, size_t &nCacheSize);
+                                size_t &nChunkSize, size_t &nCacheSize,
+                                bool &bShared);
 
   public:
     VSIVirtualHandle *Open(const char *pszFilename, const char *pszAccess,
@@ -575,7 +1081,7 @@ static bool ParseSize(const char *pszKey, const char *pszValue, size_t nMaxVal,
 
 bool VSICachedFilesystemHandler::AnalyzeFilename(
     const char *pszFilename, std::string &osUnderlyingFilename,
-    size_t &nChunkSize, size_t &nCacheSize)
+    size_t &nChunkSize, size_t &nCacheSize, bool &bShared)
 {
 
     if (!STARTS_WITH(pszFilename, "/vsicached?"))
@@ -587,6 +1093,7 @@ bool VSICachedFilesystemHandler::AnalyzeFilename(
     osUnderlyingFilename.clear();
     nChunkSize = 0;
     nCacheSize = 0;
+    bShared = false;
 
     for (int i = 0; i < aosTokens.size(); ++i)
     {
@@ -620,6 +1127,10 @@ bool VSICachedFilesystemHandler::AnalyzeFilename(
                     return false;
                 }
             }
+            else if (strcmp(pszKey, "shared") == 0)
+            {
+                bShared = CPLTestBool(pszValue);
+            }
             else
             {
                 CPLError(CE_Warning, CPLE_NotSupported,
@@ -649,8 +1160,9 @@ VSIVirtualHandle *VSICachedFilesystemHandler::Open(const char *pszFilename,
     std::string osUnderlyingFilename;
     size_t nChunkSize = 0;
     size_t nCacheSize = 0;
+    bool bShared = false;
     if (!AnalyzeFilename(pszFilename, osUnderlyingFilename, nChunkSize,
-                         nCacheSize))
+                         nCacheSize, bShared))
         return nullptr;
     if (strcmp(pszAccess, "r") != 0 && strcmp(pszAccess, "rb") != 0)
     {
@@ -666,6 +1178,11 @@ VSIVirtualHandle *VSICachedFilesystemHandler::Open(const char *pszFilename,
                            papszOptions);
     if (!fp)
         return nullptr;
+    if (bShared)
+    {
+        return VSICreateSharedCachedFile(fp, osUnderlyingFilename.c_str(),
+                                         nChunkSize);
+    }
     return VSICreateCachedFile(fp, nChunkSize, nCacheSize);
 }
 
@@ -679,8 +1196,9 @@ int VSICachedFilesystemHandler::Stat(const char *pszFilename,
     std::string osUnderlyingFilename;
     size_t nChunkSize = 0;
     size_t nCacheSize = 0;
+    bool bShared = false;
     if (!AnalyzeFilename(pszFilename, osUnderlyingFilename, nChunkSize,
-                         nCacheSize))
+                         nCacheSize, bShared))
         return -1;
     return VSIStatExL(osUnderlyingFilename.c_str(), pStatBuf, nFlags);
 }
@@ -695,8 +1213,9 @@ char **VSICachedFilesystemHandler::ReadDirEx(const char *pszDirname,
     std::string osUnderlyingFilename;
     size_t nChunkSize = 0;
     size_t nCacheSize = 0;
+    bool bShared = false;
     if (!AnalyzeFilename(pszDirname, osUnderlyingFilename, nChunkSize,
-                         nCacheSize))
+                         nCacheSize, bShared))
         return nullptr;
     return VSIReadDirEx(osUnderlyingFilename.c_str(), nMaxFiles);
 }
@@ -728,6 +1247,107 @@ VSIVirtualHandle *VSICreateCachedFile(VSIVirtualHandle *poBaseHandle,
     return new VSICachedFile(poBaseHandle, nChunkSize, nCacheSize);
 }
 
+/************************************************************************/
+/*                   GetModificationTimeNanoseconds()                   */
+/************************************************************************/
+
+/** Return the nanoseconds part of the modification time, or 0 if the
+ * platform or the file system does not report it.
+ */
+static int64_t GetModificationTimeNanoseconds(const VSIStatBufL &sStat)
+{
+#if defined(__linux__) || defined(__FreeBSD__) || defined(__NetBSD__) ||     \
+    defined(__OpenBSD__) || defined(__sun)
+    return static_cast<int64_t>(sStat.st_mtim.tv_nsec);
+#elif defined(__APPLE__)
+    return static_cast<int64_t>(sStat.st_mtimespec.tv_nsec);
+#else
+    CPL_IGNORE_RET_VAL(sStat);
+    return 0;
+#endif
+}
+
+/************************************************************************/
+/*                     VSICreateSharedCachedFile()                      */
+/************************************************************************/
+
+/** Wraps a file handle in another one, whose read-operations go through a
+ * process-wide cache shared by all handles created by this function.
+ *
+ * Contrary to VSICreateCachedFile(), the cache is not discarded when the
+ * handle is closed, and handles opened on the same file (for example by
+ * several threads) share the chunks they read. Chunks are keyed by
+ * pszFilename, the modification time (with nanoseconds where available) and
+ * size of the file, the chunk size and the chunk index, so that a modified
+ * file does not use stale chunks. Files rewritten in this process through
+ * local file systems or /vsimem/ are also detected with
+ * VSISharedCachedFileInvalidate().
+ *
+ * The total size of the cache is set by the VSI_SHARED_CACHE_SIZE
+ * configuration option (default 64 MB). The returned handle implements a
+ * thread-safe PRead(), which does not serialize readers of cached chunks.
+ *
+ * @param poBaseHandle base handle, opened on pszFilename
+ * @param pszFilename name of the file, used to build the cache key
+ * @param nChunkSize chunk size, in bytes. If 0, defaults to 32 KB
+ * @return a new handle
+ * @since GDAL 3.12
+ */
+VSIVirtualHandle *VSICreateSharedCachedFile(VSIVirtualHandle *poBaseHandle,
+                                            const char *pszFilename,
+                                            size_t nChunkSize)
+{
+    gbSharedChunkCacheUsed = true;
+    auto &oCache = VSISharedChunkCache::Get();
+    std::string osFileKey(pszFilename);
+    osFileKey += '\0';
+    osFileKey += std::to_string(oCache.GetGeneration(pszFilename));
+    osFileKey += '\0';
+    VSIStatBufL sStat;
+    if (VSIStatL(pszFilename, &sStat) == 0)
+    {
+        osFileKey += std::to_string(static_cast<int64_t>(sStat.st_mtime));
+        osFileKey += '.';
+        osFileKey += std::to_string(GetModificationTimeNanoseconds(sStat));
+    }
+
+    GIntBig nMaxSize = 0;
+    if (CPLParseMemorySize(
+            CPLGetConfigOption("VSI_SHARED_CACHE_SIZE", "64MB"), &nMaxSize,
+            nullptr) != CE_None ||
+        nMaxSize <= 0)
+    {
+        nMaxSize = 64 * 1024 * 1024;
+    }
+    oCache.SetMaxSize(static_cast<size_t>(std::min<GIntBig>(
+        nMaxSize,
+        static_cast<GIntBig>(std::numeric_limits<size_t>::max() / 2))));
+
+    return new VSISharedCachedFile(
+        poBaseHandle, osFileKey,
+        nChunkSize ? nChunkSize : VSI_CACHED_DEFAULT_CHUNK_SIZE);
+}
+
+/************************************************************************/
+/*                   VSISharedCachedFileInvalidate()                    */
+/************************************************************************/
+
+/** Notify the cache used by VSICreateSharedCachedFile() that pszFilename is
+ * being, or has been, modified.
+ *
+ * File system handlers call it when a file is opened or closed in write
+ * mode. Handles opened on pszFilename afterwards do not use the chunks
+ * cached before.
+ *
+ * @param pszFilename name of the file, as given to VSICreateSharedCachedFile()
+ * @since GDAL 3.12
+ */
+void VSISharedCachedFileInvalidate(const char *pszFilename)
+{
+    if (gbSharedChunkCacheUsed)
+        VSISharedChunkCache::Get().Invalidate(pszFilename);
+}
+
 /************************************************************************/
 /*                   VSIInstallCachedFileHandler()                      */
 /************************************************************************/
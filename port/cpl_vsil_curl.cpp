@@ -510,6 +510,8 @@ VSICurlHandle::VSICurlHandle(VSICurlFilesystemHandlerBase *poFSIn,
 
 VSICurlHandle::~VSICurlHandle()
 {
+    StopReadahead();
+
     if (m_oThreadAdviseRead.joinable())
     {
         m_oThreadAdviseRead.join();
@@ -1489,7 +1491,8 @@ retry:
                             std::min<size_t>(sWriteFuncData.nSize - nOffset,
                                              knDOWNLOAD_CHUNK_SIZE);
                         poFS->AddRegion(m_pszURL, nOffset, nToCache,
-                                        sWriteFuncData.pBuffer + nOffset);
+                                        sWriteFuncData.pBuffer + nOffset,
+                                        m_bCached);
                         nOffset += nToCache;
                     }
                 }
@@ -2138,6 +2141,9 @@ retry:
         return std::string();
     }
 
+    if (response_code == 206)
+        poFS->RecordTransferStatistics(hCurlHandle, sWriteFuncData.nSize);
+
     if (!oFileProp.bHasComputedFileSize && sWriteFuncHeaderData.pBuffer)
     {
         // Try to retrieve the filesize from the HTTP headers
@@ -2302,7 +2308,9 @@ void VSICurlHandle::DownloadRegionPostProcess(const vsi_l_offset startOffset,
 #endif
         const size_t nChunkSize =
             std::min(static_cast<size_t>(knDOWNLOAD_CHUNK_SIZE), nSize);
-        poFS->AddRegion(m_pszURL, l_startOffset, nChunkSize, pBuffer);
+        if (m_bAddToRegionCache)
+            poFS->AddRegion(m_pszURL, l_startOffset, nChunkSize, pBuffer,
+                            m_bCached);
         l_startOffset += nChunkSize;
         pBuffer += nChunkSize;
         nSize -= nChunkSize;
@@ -2336,6 +2344,16 @@ size_t VSICurlHandle::Read(void *const pBufferIn, size_t const nSize,
     const int knDOWNLOAD_CHUNK_SIZE = VSICURLGetDownloadChunkSize();
     while (nBufferRequestSize)
     {
+        const size_t nReadFromReadahead =
+            ReadFromReadahead(iterOffset, pBuffer, nBufferRequestSize);
+        if (nReadFromReadahead > 0)
+        {
+            pBuffer = static_cast<char *>(pBuffer) + nReadFromReadahead;
+            iterOffset += nReadFromReadahead;
+            nBufferRequestSize -= nReadFromReadahead;
+            continue;
+        }
+
         // Don't try to read after end of file.
         poFS->GetCachedFileProp(m_pszURL, oFileProp);
         if (oFileProp.bHasComputedFileSize && iterOffset >= oFileProp.fileSize)
@@ -2361,13 +2379,14 @@ size_t VSICurlHandle::Read(void *const pBufferIn, size_t const nSize,
         }
         else
         {
-            if (nOffsetToDownload == lastDownloadedOffset)
+            constexpr int MAX_CHUNK_SIZE_INCREASE_FACTOR = 128;
+            const bool bSequential = nOffsetToDownload == lastDownloadedOffset;
+            if (bSequential)
             {
                 // In case of consecutive reads (of small size), we use a
                 // heuristic that we will read the file sequentially, so
                 // we double the requested size to decrease the number of
                 // client/server roundtrips.
-                constexpr int MAX_CHUNK_SIZE_INCREASE_FACTOR = 128;
                 if (nBlocksToDownload < MAX_CHUNK_SIZE_INCREASE_FACTOR)
                     nBlocksToDownload *= 2;
             }
@@ -2417,6 +2436,18 @@ size_t VSICurlHandle::Read(void *const pBufferIn, size_t const nSize,
                     bError = true;
                 return 0;
             }
+
+            // Once the above heuristic has reached its maximum, keep on
+            // growing the window, but download it in the background while
+            // the caller consumes the current one.
+            if (bSequential &&
+                nBlocksToDownload >= MAX_CHUNK_SIZE_INCREASE_FACTOR &&
+                osRegion.size() == static_cast<size_t>(nBlocksToDownload) *
+                                       knDOWNLOAD_CHUNK_SIZE)
+            {
+                StartReadahead(nOffsetToDownload + osRegion.size(),
+                               2 * nBlocksToDownload);
+            }
         }
 
         const vsi_l_offset nRegionOffset = iterOffset - nOffsetToDownload;
@@ -2455,6 +2486,182 @@ size_t VSICurlHandle::Read(void *const pBufferIn, size_t const nSize,
     return ret;
 }
 
+/************************************************************************/
+/*                          StartReadahead()                            */
+/************************************************************************/
+
+/** Start downloading nBlocks blocks from nOffset in the background.
+ *
+ * The window is capped to half of CPL_VSIL_CURL_READAHEAD_MAX_SIZE bytes, so
+ * that the window being consumed and the one being downloaded fit in it.
+ * Nothing is done if a download is already in progress, or if readahead is
+ * disabled.
+ */
+void VSICurlHandle::StartReadahead(vsi_l_offset nOffset, int nBlocks)
+{
+    const int knDOWNLOAD_CHUNK_SIZE = VSICURLGetDownloadChunkSize();
+    GIntBig nMaxSize = 64 * 1024 * 1024;
+    if (const char *pszMaxSize =
+            CPLGetConfigOption("CPL_VSIL_CURL_READAHEAD_MAX_SIZE", nullptr))
+    {
+        if (CPLParseMemorySize(pszMaxSize, &nMaxSize, nullptr) != CE_None)
+            return;
+    }
+    const int nMaxBlocks = static_cast<int>(
+        std::min<GIntBig>(INT_MAX, nMaxSize / 2 / knDOWNLOAD_CHUNK_SIZE));
+    nBlocks = std::min(nBlocks, nMaxBlocks);
+    if (nBlocks <= 0)
+        return;
+
+    if (oFileProp.bHasComputedFileSize && nOffset >= oFileProp.fileSize)
+        return;
+
+    if (!m_oThreadReadahead.joinable())
+    {
+        m_poReadaheadHandle.reset(
+            poFS->CreateFileHandle(m_osFilename.c_str()));
+        if (!m_poReadaheadHandle)
+            return;
+        // The windows may be much larger than the region cache
+        m_poReadaheadHandle->m_bAddToRegionCache = false;
+        m_poReadaheadHandle->m_aosHeaders = m_aosHeaders;
+
+        m_oThreadReadahead = std::thread(
+            [this]()
+            {
+                NetworkStatisticsFileSystem oContextFS(
+                    poFS->GetFSPrefix().c_str());
+                NetworkStatisticsFile oContextFile(m_osFilename.c_str());
+                NetworkStatisticsAction oContextAction("Read");
+
+                std::unique_lock<std::mutex> oLock(m_oMutexReadahead);
+                while (true)
+                {
+                    m_oCVReadahead.wait(
+                        oLock,
+                        [this]()
+                        {
+                            return m_bStopReadahead ||
+                                   m_eReadaheadState ==
+                                       ReadaheadState::REQUESTED;
+                        });
+                    if (m_bStopReadahead)
+                        break;
+                    const vsi_l_offset nStartOffset = m_nReadaheadPendingOffset;
+                    const int nWindowBlocks = m_nReadaheadPendingBlocks;
+                    oLock.unlock();
+
+                    std::string osData = m_poReadaheadHandle->DownloadRegion(
+                        nStartOffset, nWindowBlocks);
+
+                    oLock.lock();
+                    m_osReadaheadPendingData = std::move(osData);
+                    m_eReadaheadState = ReadaheadState::DONE;
+                    m_oCVReadahead.notify_all();
+                }
+            });
+    }
+
+    std::lock_guard<std::mutex> oLock(m_oMutexReadahead);
+    if (m_eReadaheadState == ReadaheadState::REQUESTED)
+        return;
+    // A completed window that was not consumed is discarded
+    std::string().swap(m_osReadaheadPendingData);
+#if DEBUG_VERBOSE
+    CPLDebug(poFS->GetDebugKey(), "Readahead of %d bytes at " CPL_FRMT_GUIB,
+             nBlocks * knDOWNLOAD_CHUNK_SIZE, nOffset);
+#endif
+    m_nReadaheadPendingOffset = nOffset;
+    m_nReadaheadPendingBlocks = nBlocks;
+    m_eReadaheadState = ReadaheadState::REQUESTED;
+    m_oCVReadahead.notify_all();
+}
+
+/************************************************************************/
+/*                           StopReadahead()                            */
+/************************************************************************/
+
+void VSICurlHandle::StopReadahead()
+{
+    if (m_oThreadReadahead.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> oLock(m_oMutexReadahead);
+            m_bStopReadahead = true;
+            m_poReadaheadHandle->Interrupt();
+        }
+        m_oCVReadahead.notify_all();
+        m_oThreadReadahead.join();
+    }
+}
+
+/************************************************************************/
+/*                         ReadFromReadahead()                          */
+/************************************************************************/
+
+/** Copy into pBuffer the bytes starting at nOffset that have been, or are
+ * being, downloaded in the background.
+ *
+ * When nOffset is in the window being downloaded, wait for it, and start
+ * downloading the next window, twice larger.
+ *
+ * @return the number of bytes copied, 0 if nOffset is not in a readahead
+ * window.
+ */
+size_t VSICurlHandle::ReadFromReadahead(vsi_l_offset nOffset, void *pBuffer,
+                                        size_t nSize)
+{
+    if (!m_oThreadReadahead.joinable())
+        return 0;
+
+    const int knDOWNLOAD_CHUNK_SIZE = VSICURLGetDownloadChunkSize();
+    int nCompletedBlocks = 0;
+    {
+        std::unique_lock<std::mutex> oLock(m_oMutexReadahead);
+        if (m_eReadaheadState != ReadaheadState::IDLE &&
+            nOffset >= m_nReadaheadPendingOffset &&
+            nOffset - m_nReadaheadPendingOffset <
+                static_cast<vsi_l_offset>(m_nReadaheadPendingBlocks) *
+                    knDOWNLOAD_CHUNK_SIZE)
+        {
+            m_oCVReadahead.wait(
+                oLock, [this]()
+                { return m_eReadaheadState == ReadaheadState::DONE; });
+            m_nReadaheadOffset = m_nReadaheadPendingOffset;
+            m_osReadaheadData = std::move(m_osReadaheadPendingData);
+            std::string().swap(m_osReadaheadPendingData);
+            m_eReadaheadState = ReadaheadState::IDLE;
+            nCompletedBlocks = m_nReadaheadPendingBlocks;
+        }
+    }
+
+    // Start downloading the next window, unless we reached end of file
+    if (nCompletedBlocks > 0 &&
+        m_osReadaheadData.size() ==
+            static_cast<size_t>(nCompletedBlocks) * knDOWNLOAD_CHUNK_SIZE)
+    {
+        StartReadahead(m_nReadaheadOffset + m_osReadaheadData.size(),
+                       nCompletedBlocks <= INT_MAX / 2 ? 2 * nCompletedBlocks
+                                                       : nCompletedBlocks);
+    }
+
+    if (nOffset < m_nReadaheadOffset ||
+        nOffset - m_nReadaheadOffset >= m_osReadaheadData.size())
+    {
+        return 0;
+    }
+    const size_t nOffsetInData =
+        static_cast<size_t>(nOffset - m_nReadaheadOffset);
+    const size_t nToCopy =
+        std::min(nSize, m_osReadaheadData.size() - nOffsetInData);
+    memcpy(pBuffer, m_osReadaheadData.data() + nOffsetInData, nToCopy);
+
+    // Release the window as soon as it has been consumed
+    if (nOffsetInData + nToCopy == m_osReadaheadData.size())
+        std::string().swap(m_osReadaheadData);
+    return nToCopy;
+}
+
 /************************************************************************/
 /*                           ReadMultiRange()                           */
 /************************************************************************/
@@ -2515,42 +2722,75 @@ int VSICurlHandle::ReadMultiRange(int const nRanges, void **const ppData,
     }
 #endif
 
-    std::vector<CURL *> aHandles;
-    std::vector<WriteFuncStruct> asWriteFuncData(nRanges);
-    std::vector<WriteFuncStruct> asWriteFuncHeaderData(nRanges);
-    std::vector<char *> apszRanges;
-    std::vector<struct curl_slist *> aHeaders;
+    const bool bMergeConsecutiveRanges = CPLTestBool(
+        CPLGetConfigOption("GDAL_HTTP_MERGE_CONSECUTIVE_RANGES", "TRUE"));
+    const size_t nMaxGap =
+        bMergeConsecutiveRanges ? poFS->GetMultiRangeMaxGap() : 0;
 
-    struct CurlErrBuffer
+    // Group ranges that are consecutive, or separated by less than
+    // nMaxGap bytes, into a single request.
+    struct MergedRequest
     {
-        std::array<char, CURL_ERROR_SIZE + 1> szCurlErrBuf;
+        vsi_l_offset nStartOffset = 0;
+        vsi_l_offset nEndOffset = 0;  // included
+        int iFirstRange = 0;
+        int iLastRange = 0;  // included
     };
 
-    std::vector<CurlErrBuffer> asCurlErrors(nRanges);
-
-    const bool bMergeConsecutiveRanges = CPLTestBool(
-        CPLGetConfigOption("GDAL_HTTP_MERGE_CONSECUTIVE_RANGES", "TRUE"));
-
-    for (int i = 0, iRequest = 0; i < nRanges;)
+    std::vector<MergedRequest> asRequests;
+    for (int i = 0; i < nRanges;)
     {
-        size_t nSize = 0;
+        if (panSizes[i] == 0)
+        {
+            ++i;
+            continue;
+        }
+        vsi_l_offset nEndOffset = panOffsets[i] + panSizes[i];
         int iNext = i;
-        // Identify consecutive ranges
-        while (bMergeConsecutiveRanges && iNext + 1 < nRanges &&
-               panOffsets[iNext] + panSizes[iNext] == panOffsets[iNext + 1])
+        while (bMergeConsecutiveRanges && iNext + 1 < nRanges)
         {
-            nSize += panSizes[iNext];
+            if (panSizes[iNext + 1] != 0)
+            {
+                const vsi_l_offset nNextOffset = panOffsets[iNext + 1];
+                if (nNextOffset < nEndOffset ||
+                    nNextOffset - nEndOffset > nMaxGap)
+                {
+                    break;
+                }
+                nEndOffset = nNextOffset + panSizes[iNext + 1];
+            }
             iNext++;
         }
-        nSize += panSizes[iNext];
 
-        if (nSize == 0)
-        {
-            i = iNext + 1;
-            continue;
-        }
+        MergedRequest sRequest;
+        sRequest.nStartOffset = panOffsets[i];
+        sRequest.nEndOffset = nEndOffset - 1;
+        sRequest.iFirstRange = i;
+        sRequest.iLastRange = iNext;
+        asRequests.push_back(sRequest);
+
+        i = iNext + 1;
+    }
+
+    const size_t nRequests = asRequests.size();
+    std::vector<CURL *> aHandles;
+    std::vector<WriteFuncStruct> asWriteFuncData(nRequests);
+    std::vector<WriteFuncStruct> asWriteFuncHeaderData(nRequests);
+    std::vector<char *> apszRanges;
+    std::vector<struct curl_slist *> aHeaders;
+
+    struct CurlErrBuffer
+    {
+        std::array<char, CURL_ERROR_SIZE + 1> szCurlErrBuf;
+    };
+
+    std::vector<CurlErrBuffer> asCurlErrors(nRequests);
 
+    std::map<CURL *, size_t> oMapHandleToIdx;
+    for (size_t iRequest = 0; iRequest < nRequests; ++iRequest)
+    {
         CURL *hCurlHandle = curl_easy_init();
+        oMapHandleToIdx[hCurlHandle] = iRequest;
         aHandles.push_back(hCurlHandle);
 
         // As the multi-range request is likely not the first one, we don't
@@ -2574,9 +2814,10 @@ int VSICurlHandle::ReadMultiRange(int const nRanges, void **const ppData,
         unchecked_curl_easy_setopt(hCurlHandle, CURLOPT_HEADERFUNCTION,
                                    VSICurlHandleWriteFunc);
         asWriteFuncHeaderData[iRequest].bIsHTTP = STARTS_WITH(m_pszURL, "http");
-        asWriteFuncHeaderData[iRequest].nStartOffset = panOffsets[i];
-
-        asWriteFuncHeaderData[iRequest].nEndOffset = panOffsets[i] + nSize - 1;
+        asWriteFuncHeaderData[iRequest].nStartOffset =
+            asRequests[iRequest].nStartOffset;
+        asWriteFuncHeaderData[iRequest].nEndOffset =
+            asRequests[iRequest].nEndOffset;
 
         char rangeStr[512] = {};
         snprintf(rangeStr, sizeof(rangeStr), CPL_FRMT_GUIB "-" CPL_FRMT_GUIB,
@@ -2608,34 +2849,99 @@ int VSICurlHandle::ReadMultiRange(int const nRanges, void **const ppData,
         headers = VSICurlMergeHeaders(headers, GetCurlHeaders("GET", headers));
         unchecked_curl_easy_setopt(hCurlHandle, CURLOPT_HTTPHEADER, headers);
         aHeaders.push_back(headers);
-        curl_multi_add_handle(hMultiHandle, hCurlHandle);
-
-        i = iNext + 1;
-        iRequest++;
     }
 
-    if (!aHandles.empty())
+    // Schedule requests so that no more than nMaxInFlightBytes are
+    // requested at once. With HTTP/2 multiplexing, all streams share the
+    // bandwidth of the connection, so issuing everything at once delays the
+    // completion of the first ranges.
+    const size_t nMaxInFlightBytes = static_cast<size_t>(
+        std::min<unsigned long long>(
+            std::numeric_limits<size_t>::max(),
+            std::strtoull(
+                CPLGetConfigOption("GDAL_HTTP_MULTIRANGE_MAX_IN_FLIGHT_BYTES",
+                                   "16777216"),
+                nullptr, 10)));
+    size_t nInFlightBytes = 0;
+    size_t iNextRequest = 0;
+    const auto AddRequests = [&]()
+    {
+        bool bAdded = false;
+        while (iNextRequest < nRequests)
+        {
+            const auto &sRequest = asRequests[iNextRequest];
+            const size_t nSize = static_cast<size_t>(sRequest.nEndOffset -
+                                                     sRequest.nStartOffset + 1);
+            if (nInFlightBytes > 0 &&
+                nInFlightBytes + nSize > nMaxInFlightBytes)
+            {
+                break;
+            }
+            curl_multi_add_handle(hMultiHandle, aHandles[iNextRequest]);
+            nInFlightBytes += nSize;
+            ++iNextRequest;
+            bAdded = true;
+        }
+        return bAdded;
+    };
+
+    if (nRequests > 0)
     {
-        VSICURLMultiPerform(hMultiHandle);
+        void *old_handler = CPLHTTPIgnoreSigPipe();
+        int repeats = 0;
+        AddRequests();
+        while (true)
+        {
+            int still_running = 0;
+            while (curl_multi_perform(hMultiHandle, &still_running) ==
+                   CURLM_CALL_MULTI_PERFORM)
+            {
+                // loop
+            }
+
+            int msgq = 0;
+            while (CURLMsg *msg = curl_multi_info_read(hMultiHandle, &msgq))
+            {
+                if (msg->msg != CURLMSG_DONE)
+                    continue;
+                auto oIter = oMapHandleToIdx.find(msg->easy_handle);
+                CPLAssert(oIter != oMapHandleToIdx.end());
+                const auto &sRequest = asRequests[oIter->second];
+                nInFlightBytes -=
+                    std::min(nInFlightBytes,
+                             static_cast<size_t>(sRequest.nEndOffset -
+                                                 sRequest.nStartOffset + 1));
+                long response_code = 0;
+                curl_easy_getinfo(msg->easy_handle, CURLINFO_HTTP_CODE,
+                                  &response_code);
+                if (response_code == 206 || response_code == 225)
+                {
+                    poFS->RecordTransferStatistics(
+                        msg->easy_handle,
+                        asWriteFuncData[oIter->second].nSize);
+                }
+            }
+
+            if (AddRequests())
+                continue;
+            if (!still_running)
+                break;
+
+            CPLMultiPerformWait(hMultiHandle, repeats);
+        }
+        CPLHTTPRestoreSigPipeHandler(old_handler);
     }
 
     int nRet = 0;
-    size_t iReq = 0;
-    int iRange = 0;
     size_t nTotalDownloaded = 0;
-    for (; iReq < aHandles.size(); iReq++, iRange++)
+    for (size_t iReq = 0; iReq < nRequests; iReq++)
     {
-        while (iRange < nRanges && panSizes[iRange] == 0)
-        {
-            iRange++;
-        }
-        if (iRange == nRanges)
-            break;
+        const auto &sRequest = asRequests[iReq];
 
         long response_code = 0;
         curl_easy_getinfo(aHandles[iReq], CURLINFO_HTTP_CODE, &response_code);
 
-        if (ENABLE_DEBUG && asCurlErrors[iRange].szCurlErrBuf[0] != '\0')
+        if (ENABLE_DEBUG && asCurlErrors[iReq].szCurlErrBuf[0] != '\0')
         {
             char rangeStr[512] = {};
             snprintf(rangeStr, sizeof(rangeStr),
@@ -2643,7 +2949,7 @@ int VSICurlHandle::ReadMultiRange(int const nRanges, void **const ppData,
                      asWriteFuncHeaderData[iReq].nStartOffset,
                      asWriteFuncHeaderData[iReq].nEndOffset);
 
-            const char *pszErrorMsg = &asCurlErrors[iRange].szCurlErrBuf[0];
+            const char *pszErrorMsg = &asCurlErrors[iReq].szCurlErrBuf[0];
             CPLDebug(poFS->GetDebugKey(),
                      "ReadMultiRange(%s), %s: response_code=%d, msg=%s",
                      osURL.c_str(), rangeStr, static_cast<int>(response_code),
@@ -2668,37 +2974,18 @@ int VSICurlHandle::ReadMultiRange(int const nRanges, void **const ppData,
         }
         else if (nRet == 0)
         {
-            size_t nOffset = 0;
-            size_t nRemainingSize = asWriteFuncData[iReq].nSize;
-            nTotalDownloaded += nRemainingSize;
-            CPLAssert(iRange < nRanges);
-            while (true)
+            nTotalDownloaded += asWriteFuncData[iReq].nSize;
+            for (int iRange = sRequest.iFirstRange;
+                 iRange <= sRequest.iLastRange; ++iRange)
             {
-                if (nRemainingSize < panSizes[iRange])
-                {
-                    nRet = -1;
-                    break;
-                }
-
                 if (panSizes[iRange] > 0)
                 {
                     memcpy(ppData[iRange],
-                           asWriteFuncData[iReq].pBuffer + nOffset,
+                           asWriteFuncData[iReq].pBuffer +
+                               static_cast<size_t>(panOffsets[iRange] -
+                                                   sRequest.nStartOffset),
                            panSizes[iRange]);
                 }
-
-                if (bMergeConsecutiveRanges && iRange + 1 < nRanges &&
-                    panOffsets[iRange] + panSizes[iRange] ==
-                        panOffsets[iRange + 1])
-                {
-                    nOffset += panSizes[iRange];
-                    nRemainingSize -= panSizes[iRange];
-                    iRange++;
-                }
-                else
-                {
-                    break;
-                }
             }
         }
 
@@ -3357,6 +3644,10 @@ void VSICurlHandle::AdviseRead(int nRanges, const vsi_l_offset *panOffsets,
 
     const bool bMergeConsecutiveRanges = CPLTestBool(
         CPLGetConfigOption("GDAL_HTTP_MERGE_CONSECUTIVE_RANGES", "TRUE"));
+    constexpr size_t SIZE_COG_MARKERS = 2 * sizeof(uint32_t);
+    const size_t nMaxGap = std::max<size_t>(
+        SIZE_COG_MARKERS,
+        bMergeConsecutiveRanges ? poFS->GetMultiRangeMaxGap() : 0);
 
     try
     {
@@ -3365,15 +3656,24 @@ void VSICurlHandle::AdviseRead(int nRanges, const vsi_l_offset *panOffsets,
         for (int i = 0; i < nRanges;)
         {
             int iNext = i;
-            // Identify consecutive ranges
-            constexpr size_t SIZE_COG_MARKERS = 2 * sizeof(uint32_t);
+            // Identify consecutive ranges, or ranges separated by a small
+            // enough gap, as long as the bytes of the gaps do not make us
+            // exceed the memory limit.
             auto nEndOffset = panOffsets[iNext] + panSizes[iNext];
             while (bMergeConsecutiveRanges && iNext + 1 < nRanges &&
                    panOffsets[iNext + 1] > panOffsets[iNext] &&
-                   panOffsets[iNext] + panSizes[iNext] + SIZE_COG_MARKERS >=
+                   panOffsets[iNext] + panSizes[iNext] + nMaxGap >=
                        panOffsets[iNext + 1] &&
                    panOffsets[iNext + 1] + panSizes[iNext + 1] > nEndOffset)
             {
+                const vsi_l_offset nGap =
+                    panOffsets[iNext + 1] > nEndOffset
+                        ? panOffsets[iNext + 1] - nEndOffset
+                        : 0;
+                if (nGap <= nLimit - nMaxSize)
+                    nMaxSize += nGap;
+                else if (nGap > SIZE_COG_MARKERS)
+                    break;
                 iNext++;
                 nEndOffset = panOffsets[iNext] + panSizes[iNext];
             }
@@ -3903,6 +4203,90 @@ CURLM *VSICurlFilesystemHandlerBase::GetCurlMultiHandleFor(
     return conn.hCurlMultiHandle;
 }
 
+/************************************************************************/
+/*                     RecordTransferStatistics()                       */
+/************************************************************************/
+
+/** Update the latency and bandwidth estimates from a completed range
+ * request. */
+void VSICurlFilesystemHandlerBase::RecordTransferStatistics(CURL *hCurlHandle,
+                                                            size_t nDownloaded)
+{
+    curl_off_t nPreTransferTime = 0;
+    curl_off_t nStartTransferTime = 0;
+    curl_off_t nTotalTime = 0;
+    if (curl_easy_getinfo(hCurlHandle, CURLINFO_PRETRANSFER_TIME_T,
+                          &nPreTransferTime) != CURLE_OK ||
+        curl_easy_getinfo(hCurlHandle, CURLINFO_STARTTRANSFER_TIME_T,
+                          &nStartTransferTime) != CURLE_OK ||
+        curl_easy_getinfo(hCurlHandle, CURLINFO_TOTAL_TIME_T, &nTotalTime) !=
+            CURLE_OK ||
+        nStartTransferTime < nPreTransferTime ||
+        nTotalTime < nStartTransferTime)
+    {
+        return;
+    }
+
+    // Small responses are dominated by the time to first byte and say
+    // nothing reliable about the throughput of the link.
+    constexpr size_t MIN_SIZE_FOR_BANDWIDTH = 64 * 1024;
+    constexpr double EWMA_WEIGHT = 0.25;
+
+    const double dfLatency =
+        static_cast<double>(nStartTransferTime - nPreTransferTime) * 1e-6;
+    const double dfTransferTime =
+        static_cast<double>(nTotalTime - nStartTransferTime) * 1e-6;
+
+    std::lock_guard<std::mutex> oLock(m_oMutexTransferStats);
+    m_dfLatencyEWMA = m_dfLatencyEWMA == 0
+                          ? dfLatency
+                          : (1 - EWMA_WEIGHT) * m_dfLatencyEWMA +
+                                EWMA_WEIGHT * dfLatency;
+    if (nDownloaded >= MIN_SIZE_FOR_BANDWIDTH && dfTransferTime > 0)
+    {
+        const double dfBandwidth =
+            static_cast<double>(nDownloaded) / dfTransferTime;
+        m_dfBandwidthEWMA = m_dfBandwidthEWMA == 0
+                                ? dfBandwidth
+                                : (1 - EWMA_WEIGHT) * m_dfBandwidthEWMA +
+                                      EWMA_WEIGHT * dfBandwidth;
+    }
+}
+
+/************************************************************************/
+/*                       GetMultiRangeMaxGap()                          */
+/************************************************************************/
+
+/** Return the maximum number of bytes between two ranges for them to be
+ * fetched with a single request by ReadMultiRange().
+ *
+ * In AUTO mode, this is the bandwidth-delay product of the link: downloading
+ * fewer unneeded bytes than that takes less time than waiting for the first
+ * byte of an extra request. Links with a small latency (local network) do not
+ * benefit from it, and no coalescing is done until a throughput estimate is
+ * available.
+ */
+size_t VSICurlFilesystemHandlerBase::GetMultiRangeMaxGap()
+{
+    const char *pszMaxGap =
+        CPLGetConfigOption("GDAL_HTTP_MULTIRANGE_MAX_GAP", "AUTO");
+    if (!EQUAL(pszMaxGap, "AUTO"))
+    {
+        return static_cast<size_t>(std::min<unsigned long long>(
+            std::numeric_limits<size_t>::max(),
+            std::strtoull(pszMaxGap, nullptr, 10)));
+    }
+
+    constexpr double MIN_LATENCY = 0.005;  // 5 ms
+    constexpr double MAX_AUTO_GAP = 4 * 1024 * 1024;
+
+    std::lock_guard<std::mutex> oLock(m_oMutexTransferStats);
+    if (m_dfLatencyEWMA < MIN_LATENCY || m_dfBandwidthEWMA == 0)
+        return 0;
+    return static_cast<size_t>(
+        std::min(MAX_AUTO_GAP, m_dfLatencyEWMA * m_dfBandwidthEWMA));
+}
+
 /************************************************************************/
 /*                          GetRegionCache()                            */
 /************************************************************************/
@@ -3927,17 +4311,49 @@ std::shared_ptr<std::string>
 VSICurlFilesystemHandlerBase::GetRegion(const char *pszURL,
                                         vsi_l_offset nFileOffsetStart)
 {
-    CPLMutexHolder oHolder(&hMutex);
-
     const int knDOWNLOAD_CHUNK_SIZE = VSICURLGetDownloadChunkSize();
     nFileOffsetStart =
         (nFileOffsetStart / knDOWNLOAD_CHUNK_SIZE) * knDOWNLOAD_CHUNK_SIZE;
 
-    std::shared_ptr<std::string> out;
-    if (GetRegionCache()->tryGet(
-            FilenameOffsetPair(std::string(pszURL), nFileOffsetStart), out))
     {
-        return out;
+        CPLMutexHolder oHolder(&hMutex);
+
+        std::shared_ptr<std::string> out;
+        if (GetRegionCache()->tryGet(
+                FilenameOffsetPair(std::string(pszURL), nFileOffsetStart), out))
+        {
+            return out;
+        }
+    }
+
+    // Fallback to the persistent disk cache, if enabled. Done without
+    // hMutex held, so that other threads are not blocked by disk I/O.
+    auto poDiskCache = VSICurlDiskCache::Get();
+    if (poDiskCache)
+    {
+        FileProp oFileProp;
+        if (GetCachedFileProp(pszURL, oFileProp))
+        {
+            const std::string osValidator =
+                VSICurlDiskCache::GetValidator(oFileProp);
+            if (!osValidator.empty())
+            {
+                auto out = std::make_shared<std::string>();
+                if (poDiskCache->Read(pszURL, osValidator, nFileOffsetStart,
+                                      knDOWNLOAD_CHUNK_SIZE, *out))
+                {
+                    NetworkStatisticsLogger::LogDiskCacheHit(out->size());
+
+                    CPLMutexHolder oHolder(&hMutex);
+                    GetRegionCache()->insert(
+                        FilenameOffsetPair(std::string(pszURL),
+                                           nFileOffsetStart),
+                        out);
+                    return out;
+                }
+                NetworkStatisticsLogger::LogDiskCacheMiss();
+            }
+        }
     }
 
     return nullptr;
@@ -3949,14 +4365,38 @@ VSICurlFilesystemHandlerBase::GetRegion(const char *pszURL,
 
 void VSICurlFilesystemHandlerBase::AddRegion(const char *pszURL,
                                              vsi_l_offset nFileOffsetStart,
-                                             size_t nSize, const char *pData)
+                                             size_t nSize, const char *pData,
+                                             bool bAllowDiskCache)
 {
-    CPLMutexHolder oHolder(&hMutex);
+    {
+        CPLMutexHolder oHolder(&hMutex);
+
+        std::shared_ptr<std::string> value(new std::string());
+        value->assign(pData, nSize);
+        GetRegionCache()->insert(
+            FilenameOffsetPair(std::string(pszURL), nFileOffsetStart), value);
+    }
 
-    std::shared_ptr<std::string> value(new std::string());
-    value->assign(pData, nSize);
-    GetRegionCache()->insert(
-        FilenameOffsetPair(std::string(pszURL), nFileOffsetStart), value);
+    if (!bAllowDiskCache)
+        return;
+    auto poDiskCache = VSICurlDiskCache::Get();
+    if (poDiskCache)
+    {
+        // Chunks can only be persisted once the validator of the file is
+        // known.
+        FileProp oFileProp;
+        if (GetCachedFileProp(pszURL, oFileProp))
+        {
+            const std::string osValidator =
+                VSICurlDiskCache::GetValidator(oFileProp);
+            if (!osValidator.empty())
+            {
+                poDiskCache->Write(pszURL, osValidator, nFileOffsetStart,
+                                   VSICURLGetDownloadChunkSize(), pData,
+                                   nSize);
+            }
+        }
+    }
 }
 
 /************************************************************************/
@@ -4221,6 +4661,13 @@ const char *VSICurlFilesystemHandlerBase::GetActualURL(const char *pszFilename)
     "  <Option name='GDAL_HTTP_MERGE_CONSECUTIVE_RANGES' type='boolean' "      \
     "description='Whether to merge consecutive ranges in multirange "          \
     "requests' default='YES'/>"                                                \
+    "  <Option name='GDAL_HTTP_MULTIRANGE_MAX_GAP' type='string' "             \
+    "description='Maximum number of bytes between two ranges of a multirange " \
+    "request for them to be fetched by a single request, or AUTO' "            \
+    "default='AUTO'/>"                                                         \
+    "  <Option name='GDAL_HTTP_MULTIRANGE_MAX_IN_FLIGHT_BYTES' type='int' "    \
+    "description='Maximum number of bytes of multirange requests being "       \
+    "downloaded at the same time' default='16777216'/>"                        \
     "  <Option name='CPL_VSIL_CURL_NON_CACHED' type='string' "                 \
     "description='Colon-separated list of filenames whose content"             \
     "must not be cached across open attempts'/>"                               \
@@ -4242,9 +4689,17 @@ const char *VSICurlFilesystemHandlerBase::GetActualURL(const char *pszFilename)
     "  <Option name='CPL_VSIL_CURL_CHUNK_SIZE' type='integer' "                \
     "description='Size in bytes of the minimum amount of data read in a "      \
     "file' default='16384' min='1024' max='10485760'/>"                        \
+    "  <Option name='CPL_VSIL_CURL_READAHEAD_MAX_SIZE' type='integer' "        \
+    "description='Maximum size in bytes of the window downloaded in the "      \
+    "background during sequential reads. 0 to disable' default='67108864'/>"   \
     "  <Option name='CPL_VSIL_CURL_CACHE_SIZE' type='integer' "                \
     "description='Size in bytes of the global /vsicurl/ cache' "               \
     "default='16384000'/>"                                                     \
+    "  <Option name='CPL_VSIL_CURL_DISK_CACHE_DIR' type='string' "             \
+    "description='Directory of the persistent cache of downloaded chunks'/>"   \
+    "  <Option name='CPL_VSIL_CURL_DISK_CACHE_SIZE' type='integer' "           \
+    "description='Maximum size in bytes of the persistent cache' "             \
+    "default='1073741824'/>"                                                   \
     "  <Option name='CPL_VSIL_CURL_IGNORE_GLACIER_STORAGE' type='boolean' "    \
     "description='Whether to skip files with Glacier storage class in "        \
     "directory listing.' default='YES'/>"                                      \
@@ -4437,7 +4892,10 @@ VSIVirtualHandle *VSICurlFilesystemHandlerBase::Open(const char *pszFilename,
         }
     }
 
-    if (CPLTestBool(CPLGetConfigOption("VSI_CACHE", "FALSE")))
+    const char *pszVSICache = CPLGetConfigOption("VSI_CACHE", "FALSE");
+    if (EQUAL(pszVSICache, "SHARED"))
+        return VSICreateSharedCachedFile(poHandle, pszFilename);
+    else if (CPLTestBool(pszVSICache))
         return VSICreateCachedFile(poHandle);
     else
         return poHandle;
@@ -5997,6 +6455,29 @@ void NetworkStatisticsLogger::LogDELETE()
     }
 }
 
+void NetworkStatisticsLogger::LogDiskCacheHit(size_t nReadBytes)
+{
+    if (!IsEnabled())
+        return;
+    std::lock_guard<std::mutex> oLock(gInstance.m_mutex);
+    for (auto counters : gInstance.GetCountersForContext())
+    {
+        counters->nDiskCacheHit++;
+        counters->nDiskCacheReadBytes += nReadBytes;
+    }
+}
+
+void NetworkStatisticsLogger::LogDiskCacheMiss()
+{
+    if (!IsEnabled())
+        return;
+    std::lock_guard<std::mutex> oLock(gInstance.m_mutex);
+    for (auto counters : gInstance.GetCountersForContext())
+    {
+        counters->nDiskCacheMiss++;
+    }
+}
+
 void NetworkStatisticsLogger::Reset()
 {
     std::lock_guard<std::mutex> oLock(gInstance.m_mutex);
@@ -6026,6 +6507,14 @@ void NetworkStatisticsLogger::Stats::AsJSON(CPLJSONObject &oJSON) const
     if (counters.nDELETE)
         oMethods.Add("DELETE/count", counters.nDELETE);
     oJSON.Add("methods", oMethods);
+    if (counters.nDiskCacheHit || counters.nDiskCacheMiss)
+    {
+        CPLJSONObject oDiskCache;
+        oDiskCache.Add("hit_count", counters.nDiskCacheHit);
+        oDiskCache.Add("miss_count", counters.nDiskCacheMiss);
+        oDiskCache.Add("read_bytes", counters.nDiskCacheReadBytes);
+        oJSON.Add("disk_cache", oDiskCache);
+    }
     CPLJSONObject oFiles;
     bool bFilesAdded = false;
     for (const auto &kv : children)
@@ -6539,6 +7028,11 @@ void VSINetworkStatsReset(void)
  * }
  * \endcode
  *
+ * When the persistent disk cache is enabled with the
+ * CPL_VSIL_CURL_DISK_CACHE_DIR configuration option, each level also contains
+ * a "disk_cache" object with "hit_count", "miss_count" and "read_bytes"
+ * members (since GDAL 3.12).
+ *
  * @param papszOptions Unused.
  * @return a JSON serialized string to free with VSIFree(), or nullptr
  * @since GDAL 3.2.0
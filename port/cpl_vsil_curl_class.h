@@ -17,6 +17,7 @@
 
 #include "cpl_aws.h"
 #include "cpl_azure.h"
+#include "cpl_error_internal.h"
 #include "cpl_port.h"
 #include "cpl_json.h"
 #include "cpl_http.h"
@@ -34,8 +35,12 @@
 #include <memory>
 #include <mutex>
 #include <thread>
+#include <tuple>
+#include <unordered_map>
 #include <utility>
 
+class CPLWorkerThreadPool;
+
 // To avoid aliasing to CopyFile to CopyFileA on Windows
 #ifdef CopyFile
 #undef CopyFile
@@ -136,6 +141,70 @@ struct PutData
     }
 };
 
+/************************************************************************/
+/*                          VSICurlDiskCache                            */
+/************************************************************************/
+
+// Persistent cache of downloaded chunks, stored in the directory pointed by
+// the CPL_VSIL_CURL_DISK_CACHE_DIR configuration option, and that can be
+// shared by several processes.
+// Chunks are keyed by the URL, the validator of the remote file (ETag, or
+// Last-Modified date and size) and the chunk size, so that chunks of a file
+// that has been modified on the server are never reused.
+class VSICurlDiskCache
+{
+    CPL_DISALLOW_COPY_ASSIGN(VSICurlDiskCache)
+
+    std::string m_osDir;
+    std::string m_osSizeOption;
+    GIntBig m_nMaxSize;
+
+    // Access time, whether the access was done by this process, and
+    // sequence number to break ties.
+    using LRUKey = std::tuple<GIntBig, bool, GUIntBig>;
+
+    struct Entry
+    {
+        GIntBig nSize = 0;
+        LRUKey oKey{};
+    };
+
+    // Protects the below members.
+    std::mutex m_oMutex{};
+    // Index of the chunk files, by path relative to m_osDir, and the same
+    // files from the least to the most recently used.
+    std::unordered_map<std::string, Entry> m_oMapEntries{};
+    std::map<LRUKey, std::string> m_oLRU{};
+    GUIntBig m_nSeq = 0;
+    GIntBig m_nCurrentSize = 0;
+    GIntBig m_nWrittenSinceScan = 0;
+    bool m_bScanned = false;
+    bool m_bMaintenanceInProgress = false;
+
+    static std::string GetChunkRelativeFilename(const std::string &osURL,
+                                                const std::string &osValidator,
+                                                vsi_l_offset nOffset,
+                                                int nChunkSize);
+    void Touch(const std::string &osRelFilename, GIntBig nSize);
+    void Remove(const std::string &osRelFilename);
+    void Maintain(bool bRescan);
+
+  public:
+    VSICurlDiskCache(const std::string &osDir,
+                     const std::string &osSizeOption);
+
+    static std::shared_ptr<VSICurlDiskCache> Get();
+
+    static std::string GetValidator(const FileProp &oFileProp);
+
+    bool Read(const std::string &osURL, const std::string &osValidator,
+              vsi_l_offset nOffset, int nChunkSize, std::string &osData);
+
+    void Write(const std::string &osURL, const std::string &osValidator,
+               vsi_l_offset nOffset, int nChunkSize, const char *pData,
+               size_t nSize);
+};
+
 /************************************************************************/
 /*                     VSICurlFilesystemHandler                         */
 /************************************************************************/
@@ -146,6 +215,8 @@ class VSICurlFilesystemHandlerBase : public VSIFilesystemHandler
 {
     CPL_DISALLOW_COPY_ASSIGN(VSICurlFilesystemHandlerBase)
 
+    friend class VSICurlHandle;
+
     struct FilenameOffsetPair
     {
         std::string filename_;
@@ -213,6 +284,13 @@ class VSICurlFilesystemHandlerBase : public VSIFilesystemHandler
     std::map<std::string, std::unique_ptr<RegionInDownload>>
         m_oMapRegionInDownload{};
 
+    // Exponentially weighted moving averages of the time to first byte and
+    // of the download throughput of range requests, used to size the gap
+    // below which ReadMultiRange() coalesces neighbouring ranges.
+    std::mutex m_oMutexTransferStats{};
+    double m_dfLatencyEWMA = 0;    // in seconds
+    double m_dfBandwidthEWMA = 0;  // in bytes per second
+
   protected:
     CPLMutex *hMutex = nullptr;
 
@@ -295,7 +373,8 @@ class VSICurlFilesystemHandlerBase : public VSIFilesystemHandler
                                            vsi_l_offset nFileOffsetStart);
 
     void AddRegion(const char *pszURL, vsi_l_offset nFileOffsetStart,
-                   size_t nSize, const char *pData);
+                   size_t nSize, const char *pData,
+                   bool bAllowDiskCache = true);
 
     std::pair<bool, std::string>
     NotifyStartDownloadRegion(const std::string &osURL,
@@ -310,6 +389,9 @@ class VSICurlFilesystemHandlerBase : public VSIFilesystemHandler
 
     CURLM *GetCurlMultiHandleFor(const std::string &osURL);
 
+    void RecordTransferStatistics(CURL *hCurlHandle, size_t nDownloaded);
+    size_t GetMultiRangeMaxGap();
+
     virtual void ClearCache();
     virtual void PartialClearCache(const char *pszFilename);
 
@@ -442,6 +524,35 @@ class VSICurlHandle : public VSIVirtualHandle
     std::thread m_oThreadAdviseRead{};
     CURLM *m_hCurlMultiHandleForAdviseRead = nullptr;
 
+    // Background readahead of sequential reads. Windows are downloaded by
+    // m_poReadaheadHandle, a handle on the same file only used by
+    // m_oThreadReadahead, so that the state of this handle is not shared.
+    enum class ReadaheadState
+    {
+        IDLE,
+        REQUESTED,
+        DONE
+    };
+
+    std::unique_ptr<VSICurlHandle> m_poReadaheadHandle{};
+    std::thread m_oThreadReadahead{};
+    std::mutex m_oMutexReadahead{};
+    std::condition_variable m_oCVReadahead{};
+    ReadaheadState m_eReadaheadState = ReadaheadState::IDLE;
+    bool m_bStopReadahead = false;
+    vsi_l_offset m_nReadaheadPendingOffset = 0;
+    int m_nReadaheadPendingBlocks = 0;
+    std::string m_osReadaheadPendingData{};
+    // Last completed window, only accessed by the thread calling Read()
+    vsi_l_offset m_nReadaheadOffset = 0;
+    std::string m_osReadaheadData{};
+    bool m_bAddToRegionCache = true;
+
+    void StartReadahead(vsi_l_offset nOffset, int nBlocks);
+    void StopReadahead();
+    size_t ReadFromReadahead(vsi_l_offset nOffset, void *pBuffer,
+                             size_t nSize);
+
   protected:
     virtual struct curl_slist *
     GetCurlHeaders(const std::string & /*osVerb*/,
@@ -598,6 +709,8 @@ class IVSIS3LikeFSHandler : public VSICurlFilesystemHandlerBaseWritable
 {
     CPL_DISALLOW_COPY_ASSIGN(IVSIS3LikeFSHandler)
 
+    friend class VSIMultipartWriteHandle;
+
     virtual int MkdirInternal(const char *pszDirname, long nMode,
                               bool bDoStatCheck);
 
@@ -837,9 +950,20 @@ class VSIMultipartWriteHandle final : public VSIVirtualHandle
     std::vector<std::string> m_aosEtags{};
     bool m_bError = false;
 
+    // Background upload of parts (when NUM_THREADS > 0)
+    std::unique_ptr<CPLWorkerThreadPool> m_poThreadPool{};
+    std::mutex m_oMutexBackgroundUpload{};
+    // Protected by m_oMutexBackgroundUpload
+    std::vector<GByte *> m_apabyFreeBuffers{};
+    bool m_bBackgroundUploadError = false;
+    CPLErrorAccumulator m_oErrorAccumulator{};
+    bool m_bBackgroundErrorsReplayed = false;
+
     WriteFuncStruct m_sWriteFuncHeaderData{};
 
     bool UploadPart();
+    bool UploadPartInBackground();
+    bool WaitForBackgroundUploads();
     bool DoSinglePartPUT();
 
     void InvalidateParentDirectory();
@@ -1108,6 +1232,9 @@ class NetworkStatisticsLogger
         GIntBig nPUTUploadedBytes = 0;
         GIntBig nPOSTDownloadedBytes = 0;
         GIntBig nPOSTUploadedBytes = 0;
+        GIntBig nDiskCacheHit = 0;
+        GIntBig nDiskCacheMiss = 0;
+        GIntBig nDiskCacheReadBytes = 0;
     };
 
     enum class ContextPathType
@@ -1187,6 +1314,10 @@ class NetworkStatisticsLogger
 
     static void LogDELETE();
 
+    static void LogDiskCacheHit(size_t nReadBytes);
+
+    static void LogDiskCacheMiss();
+
     static void Reset();
 
     static std::string GetReportAsSerializedJSON();
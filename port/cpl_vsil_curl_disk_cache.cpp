@@ -0,0 +1,492 @@
+/******************************************************************************
+ *
+ * Project:  CPL - Common Portability Library
+ * Purpose:  Persistent disk cache of chunks downloaded by /vsicurl/ and
+ *           related file systems
+ * Author:   agent <agent at local>
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, agent <agent at local>
+ *
+ * SPDX-License-Identifier: MIT
+ ****************************************************************************/
+
+#include "cpl_port.h"
+#include "cpl_vsil_curl_class.h"
+
+#ifdef HAVE_CURL
+
+#include "cpl_conv.h"
+#include "cpl_multiproc.h"
+#include "cpl_sha256.h"
+#include "cpl_string.h"
+#include "cpl_vsi.h"
+#include "cpl_vsi_virtual.h"
+
+#include <algorithm>
+#include <cstring>
+#include <ctime>
+#include <set>
+#include <vector>
+
+// Layout of the cache directory:
+// - <dir>/.lock: lock file taken by the process trimming the cache.
+// - <dir>/<xx>/<yyyy...>_<offset>: one file per chunk, where xxyyyy... is the
+//   hexadecimal SHA256 hash of the URL, validator and chunk size. The file
+//   starts with a 16-byte header made of a 8-byte magic and of the chunk size
+//   as a little-endian uint64, followed by the chunk data.
+//
+// Chunk files are written to a temporary file and renamed afterwards, so
+// readers never see a partially written chunk, and several processes can
+// share the same directory.
+//
+// Each process keeps an in-memory index of the chunk files, ordered by last
+// access. It is initialized from a scan of the directory, using the
+// modification time of the files as their access time, and updated on each
+// read and write. The directory is rescanned after a tenth of the maximum
+// size has been written by the process, to account for the chunks written
+// or removed by other processes. Scanning and trimming the cache are done by
+// the thread whose write triggered them, without holding the mutex of the
+// index, so other threads are not blocked by that I/O. Trimming is done by
+// the process that holds the lock file, and removes the least recently used
+// chunks first.
+
+namespace cpl
+{
+
+constexpr const char DISK_CACHE_MAGIC[] = "GDALCCH1";
+constexpr int DISK_CACHE_MAGIC_SIZE = 8;
+constexpr int DISK_CACHE_HEADER_SIZE = DISK_CACHE_MAGIC_SIZE + 8;
+constexpr const char DISK_CACHE_LOCK_FILENAME[] = ".lock";
+constexpr GIntBig DISK_CACHE_SIZE_DEFAULT = 1024 * 1024 * 1024;
+
+/************************************************************************/
+/*                         VSICurlDiskCache()                           */
+/************************************************************************/
+
+VSICurlDiskCache::VSICurlDiskCache(const std::string &osDir,
+                                   const std::string &osSizeOption)
+    : m_osDir(osDir), m_osSizeOption(osSizeOption),
+      m_nMaxSize(DISK_CACHE_SIZE_DEFAULT)
+{
+    if (!osSizeOption.empty())
+    {
+        GIntBig nSize = 0;
+        if (CPLParseMemorySize(osSizeOption.c_str(), &nSize, nullptr) !=
+                CE_None ||
+            nSize <= 0)
+        {
+            CPLError(CE_Warning, CPLE_AppDefined,
+                     "Invalid value for CPL_VSIL_CURL_DISK_CACHE_SIZE. "
+                     "Using default value of " CPL_FRMT_GIB " instead.",
+                     m_nMaxSize);
+        }
+        else
+        {
+            m_nMaxSize = nSize;
+        }
+    }
+
+    VSIStatBufL sStat;
+    if (VSIStatL(m_osDir.c_str(), &sStat) != 0 &&
+        VSIMkdirRecursive(m_osDir.c_str(), 0755) != 0)
+    {
+        CPLDebug("VSICURL", "Cannot create disk cache directory %s",
+                 m_osDir.c_str());
+    }
+}
+
+/************************************************************************/
+/*                                Get()                                 */
+/************************************************************************/
+
+/** Return the disk cache, or nullptr if CPL_VSIL_CURL_DISK_CACHE_DIR is not
+ * set. */
+std::shared_ptr<VSICurlDiskCache> VSICurlDiskCache::Get()
+{
+    const char *pszDir =
+        CPLGetConfigOption("CPL_VSIL_CURL_DISK_CACHE_DIR", nullptr);
+    if (pszDir == nullptr || pszDir[0] == '\0')
+        return nullptr;
+    const char *pszSize =
+        CPLGetConfigOption("CPL_VSIL_CURL_DISK_CACHE_SIZE", "");
+
+    static std::mutex oMutex;
+    static std::shared_ptr<VSICurlDiskCache> poCache;
+    std::lock_guard<std::mutex> oLock(oMutex);
+    if (!poCache || poCache->m_osDir != pszDir ||
+        poCache->m_osSizeOption != pszSize)
+    {
+        poCache = std::make_shared<VSICurlDiskCache>(pszDir, pszSize);
+    }
+    return poCache;
+}
+
+/************************************************************************/
+/*                            GetValidator()                            */
+/************************************************************************/
+
+/** Return a string identifying the version of a remote file, or an empty
+ * string if it cannot be cached. */
+std::string VSICurlDiskCache::GetValidator(const FileProp &oFileProp)
+{
+    if (oFileProp.eExists != EXIST_YES || !oFileProp.bHasComputedFileSize ||
+        oFileProp.bIsDirectory)
+    {
+        return std::string();
+    }
+    if (!oFileProp.ETag.empty())
+    {
+        return CPLSPrintf("etag=%s;size=" CPL_FRMT_GUIB,
+                          oFileProp.ETag.c_str(),
+                          static_cast<GUIntBig>(oFileProp.fileSize));
+    }
+    if (oFileProp.mTime != 0)
+    {
+        return CPLSPrintf("mtime=" CPL_FRMT_GIB ";size=" CPL_FRMT_GUIB,
+                          static_cast<GIntBig>(oFileProp.mTime),
+                          static_cast<GUIntBig>(oFileProp.fileSize));
+    }
+    return std::string();
+}
+
+/************************************************************************/
+/*                      GetChunkRelativeFilename()                      */
+/************************************************************************/
+
+std::string VSICurlDiskCache::GetChunkRelativeFilename(
+    const std::string &osURL, const std::string &osValidator,
+    vsi_l_offset nOffset, int nChunkSize)
+{
+    std::string osKey(osURL);
+    osKey += '\0';
+    osKey += osValidator;
+    osKey += '\0';
+    osKey += std::to_string(nChunkSize);
+
+    GByte abyHash[CPL_SHA256_HASH_SIZE];
+    CPL_SHA256(osKey.data(), osKey.size(), abyHash);
+    char *pszHex = CPLBinaryToHex(CPL_SHA256_HASH_SIZE, abyHash);
+    const std::string osHex(pszHex);
+    CPLFree(pszHex);
+
+    std::string osFilename(osHex.substr(0, 2));
+    osFilename += '/';
+    osFilename += osHex.substr(2);
+    osFilename += CPLSPrintf("_" CPL_FRMT_GUIB, static_cast<GUIntBig>(nOffset));
+    return osFilename;
+}
+
+/************************************************************************/
+/*                                Read()                                */
+/************************************************************************/
+
+/** Read a chunk from the cache. Returns false if it is not cached. */
+bool VSICurlDiskCache::Read(const std::string &osURL,
+                            const std::string &osValidator,
+                            vsi_l_offset nOffset, int nChunkSize,
+                            std::string &osData)
+{
+    const std::string osRelFilename =
+        GetChunkRelativeFilename(osURL, osValidator, nOffset, nChunkSize);
+    const std::string osFilename = m_osDir + '/' + osRelFilename;
+    auto fp = VSIVirtualHandleUniquePtr(VSIFOpenL(osFilename.c_str(), "rb"));
+    if (!fp)
+        return false;
+
+    GByte abyHeader[DISK_CACHE_HEADER_SIZE];
+    if (fp->Read(abyHeader, sizeof(abyHeader), 1) != 1 ||
+        memcmp(abyHeader, DISK_CACHE_MAGIC, DISK_CACHE_MAGIC_SIZE) != 0)
+    {
+        CPLDebug("VSICURL", "Invalid disk cache file %s", osFilename.c_str());
+        return false;
+    }
+    uint64_t nSize;
+    memcpy(&nSize, abyHeader + DISK_CACHE_MAGIC_SIZE, sizeof(nSize));
+    CPL_LSBPTR64(&nSize);
+    if (nSize == 0 || nSize > static_cast<uint64_t>(nChunkSize))
+    {
+        CPLDebug("VSICURL", "Invalid disk cache file %s", osFilename.c_str());
+        return false;
+    }
+
+    osData.resize(static_cast<size_t>(nSize));
+    if (fp->Read(&osData[0], osData.size(), 1) != 1)
+    {
+        CPLDebug("VSICURL", "Invalid disk cache file %s", osFilename.c_str());
+        osData.clear();
+        return false;
+    }
+
+    std::lock_guard<std::mutex> oLock(m_oMutex);
+    Touch(osRelFilename, static_cast<GIntBig>(DISK_CACHE_HEADER_SIZE + nSize));
+    return true;
+}
+
+/************************************************************************/
+/*                                Write()                               */
+/************************************************************************/
+
+/** Write a chunk to the cache, and trim it if it got too large. Errors are
+ * not reported, as the cache is only an optimization. */
+void VSICurlDiskCache::Write(const std::string &osURL,
+                             const std::string &osValidator,
+                             vsi_l_offset nOffset, int nChunkSize,
+                             const char *pData, size_t nSize)
+{
+    if (nSize == 0 || nSize > static_cast<size_t>(nChunkSize))
+        return;
+
+    const std::string osRelFilename =
+        GetChunkRelativeFilename(osURL, osValidator, nOffset, nChunkSize);
+    const std::string osFilename = m_osDir + '/' + osRelFilename;
+    VSIStatBufL sStat;
+    if (VSIStatL(osFilename.c_str(), &sStat) == 0)
+    {
+        // Already written, for example by another process.
+        return;
+    }
+
+    const std::string osTmpFilename(
+        CPLSPrintf("%s.%d_" CPL_FRMT_GIB ".tmp", osFilename.c_str(),
+                   CPLGetCurrentProcessID(), CPLGetPID()));
+    auto fp = VSIVirtualHandleUniquePtr(VSIFOpenL(osTmpFilename.c_str(), "wb"));
+    if (!fp)
+    {
+        VSIMkdir(CPLGetPathSafe(osFilename.c_str()).c_str(), 0755);
+        fp.reset(VSIFOpenL(osTmpFilename.c_str(), "wb"));
+        if (!fp)
+            return;
+    }
+
+    GByte abyHeader[DISK_CACHE_HEADER_SIZE];
+    memcpy(abyHeader, DISK_CACHE_MAGIC, DISK_CACHE_MAGIC_SIZE);
+    uint64_t nSize64 = static_cast<uint64_t>(nSize);
+    CPL_LSBPTR64(&nSize64);
+    memcpy(abyHeader + DISK_CACHE_MAGIC_SIZE, &nSize64, sizeof(nSize64));
+    bool bOK = fp->Write(abyHeader, sizeof(abyHeader), 1) == 1 &&
+               fp->Write(pData, nSize, 1) == 1;
+    bOK = fp->Close() == 0 && bOK;
+    fp.reset();
+    if (!bOK || VSIRename(osTmpFilename.c_str(), osFilename.c_str()) != 0)
+    {
+        VSIUnlink(osTmpFilename.c_str());
+        return;
+    }
+
+    bool bRescan = false;
+    {
+        std::lock_guard<std::mutex> oLock(m_oMutex);
+        const GIntBig nWritten =
+            static_cast<GIntBig>(DISK_CACHE_HEADER_SIZE + nSize);
+        Touch(osRelFilename, nWritten);
+        m_nWrittenSinceScan += nWritten;
+        // Other processes might also write in the cache, hence we rescan it
+        // after a tenth of its maximum size has been written by this process.
+        bRescan = !m_bScanned || m_nWrittenSinceScan > m_nMaxSize / 10;
+        if (m_bMaintenanceInProgress ||
+            (!bRescan && m_nCurrentSize <= m_nMaxSize))
+        {
+            return;
+        }
+        m_bMaintenanceInProgress = true;
+    }
+    Maintain(bRescan);
+}
+
+/************************************************************************/
+/*                                Touch()                               */
+/************************************************************************/
+
+// Must be called with m_oMutex held.
+// Insert a chunk file in the index, or mark it as the most recently used.
+void VSICurlDiskCache::Touch(const std::string &osRelFilename, GIntBig nSize)
+{
+    const LRUKey oKey(static_cast<GIntBig>(time(nullptr)), true, ++m_nSeq);
+    auto oIter = m_oMapEntries.find(osRelFilename);
+    if (oIter == m_oMapEntries.end())
+    {
+        Entry oEntry;
+        oEntry.nSize = nSize;
+        oEntry.oKey = oKey;
+        m_oMapEntries[osRelFilename] = oEntry;
+        m_nCurrentSize += nSize;
+    }
+    else
+    {
+        m_oLRU.erase(oIter->second.oKey);
+        m_nCurrentSize += nSize - oIter->second.nSize;
+        oIter->second.nSize = nSize;
+        oIter->second.oKey = oKey;
+    }
+    m_oLRU[oKey] = osRelFilename;
+}
+
+/************************************************************************/
+/*                               Remove()                               */
+/************************************************************************/
+
+// Must be called with m_oMutex held.
+void VSICurlDiskCache::Remove(const std::string &osRelFilename)
+{
+    auto oIter = m_oMapEntries.find(osRelFilename);
+    if (oIter != m_oMapEntries.end())
+    {
+        m_oLRU.erase(oIter->second.oKey);
+        m_nCurrentSize -= oIter->second.nSize;
+        m_oMapEntries.erase(oIter);
+    }
+}
+
+/************************************************************************/
+/*                              Maintain()                              */
+/************************************************************************/
+
+namespace
+{
+struct DiskCacheEntry
+{
+    std::string osName{};
+    GIntBig nSize = 0;
+    GIntBig nMTime = 0;
+};
+}  // namespace
+
+static void ScanDiskCache(const std::string &osDir,
+                          std::vector<DiskCacheEntry> &aoEntries)
+{
+    aoEntries.clear();
+    VSIDIR *psDir = VSIOpenDir(osDir.c_str(), 1, nullptr);
+    if (psDir)
+    {
+        while (const auto psEntry = VSIGetNextDirEntry(psDir))
+        {
+            if (!VSI_ISREG(psEntry->nMode) || !psEntry->bSizeKnown ||
+                strcmp(psEntry->pszName, DISK_CACHE_LOCK_FILENAME) == 0)
+            {
+                continue;
+            }
+            DiskCacheEntry oEntry;
+            oEntry.osName = psEntry->pszName;
+#ifdef _WIN32
+            std::replace(oEntry.osName.begin(), oEntry.osName.end(), '\\',
+                         '/');
+#endif
+            oEntry.nSize = static_cast<GIntBig>(psEntry->nSize);
+            oEntry.nMTime = psEntry->nMTime;
+            aoEntries.push_back(std::move(oEntry));
+        }
+        VSICloseDir(psDir);
+    }
+}
+
+// Must be called without m_oMutex held, and with m_bMaintenanceInProgress
+// set by the caller, which guarantees that a single thread runs it.
+// Rescan the cache directory if bRescan is set, and trim the cache if it is
+// larger than its maximum size.
+void VSICurlDiskCache::Maintain(bool bRescan)
+{
+    if (bRescan)
+    {
+        GUIntBig nSeqBeforeScan;
+        {
+            std::lock_guard<std::mutex> oLock(m_oMutex);
+            nSeqBeforeScan = m_nSeq;
+        }
+
+        std::vector<DiskCacheEntry> aoEntries;
+        ScanDiskCache(m_osDir, aoEntries);
+
+        std::lock_guard<std::mutex> oLock(m_oMutex);
+        // Forget the files that have been removed, typically by another
+        // process, unless they were accessed during the scan.
+        std::set<std::string> oSetScanned;
+        for (const auto &oEntry : aoEntries)
+            oSetScanned.insert(oEntry.osName);
+        std::vector<std::string> aosRemoved;
+        for (const auto &oIter : m_oMapEntries)
+        {
+            if (std::get<2>(oIter.second.oKey) <= nSeqBeforeScan &&
+                !cpl::contains(oSetScanned, oIter.first))
+            {
+                aosRemoved.push_back(oIter.first);
+            }
+        }
+        for (const auto &osRelFilename : aosRemoved)
+            Remove(osRelFilename);
+
+        // Add the files unknown to the index, typically written by another
+        // process, as used when they were last modified. Within the same
+        // second, they are considered as less recently used than the files
+        // accessed by this process.
+        for (const auto &oEntry : aoEntries)
+        {
+            if (!cpl::contains(m_oMapEntries, oEntry.osName))
+            {
+                Entry oNewEntry;
+                oNewEntry.nSize = oEntry.nSize;
+                oNewEntry.oKey = LRUKey(oEntry.nMTime, false, ++m_nSeq);
+                m_oMapEntries[oEntry.osName] = oNewEntry;
+                m_oLRU[oNewEntry.oKey] = oEntry.osName;
+                m_nCurrentSize += oEntry.nSize;
+            }
+        }
+        m_bScanned = true;
+        m_nWrittenSinceScan = 0;
+    }
+
+    std::vector<std::string> aosToRemove;
+    {
+        std::lock_guard<std::mutex> oLock(m_oMutex);
+        if (m_nCurrentSize <= m_nMaxSize)
+        {
+            m_bMaintenanceInProgress = false;
+            return;
+        }
+    }
+
+    // Only one process at a time trims the cache. If another one is already
+    // doing it, there is nothing to do.
+    const std::string osLockFilename =
+        CPLFormFilenameSafe(m_osDir.c_str(), DISK_CACHE_LOCK_FILENAME, nullptr);
+    const char *const apszLockOptions[] = {"WAIT_TIME=0", nullptr};
+    CPLLockFileHandle hLockFileHandle = nullptr;
+    if (CPLLockFileEx(osLockFilename.c_str(), &hLockFileHandle,
+                      apszLockOptions) != CLFS_OK)
+    {
+        std::lock_guard<std::mutex> oLock(m_oMutex);
+        m_bMaintenanceInProgress = false;
+        return;
+    }
+
+    {
+        // Trim down to 90% of the maximum size, to avoid trimming again
+        // on the next write. The files are removed from the index before
+        // being unlinked, so that other threads can keep using it.
+        std::lock_guard<std::mutex> oLock(m_oMutex);
+        const GIntBig nTargetSize = m_nMaxSize / 10 * 9;
+        while (m_nCurrentSize > nTargetSize && !m_oLRU.empty())
+        {
+            std::string osRelFilename = m_oLRU.begin()->second;
+            Remove(osRelFilename);
+            aosToRemove.push_back(std::move(osRelFilename));
+        }
+    }
+
+    for (const auto &osRelFilename : aosToRemove)
+    {
+        const std::string osFilename = m_osDir + '/' + osRelFilename;
+        VSIUnlink(osFilename.c_str());
+    }
+
+    CPLUnlockFileEx(hLockFileHandle);
+
+    std::lock_guard<std::mutex> oLock(m_oMutex);
+    CPLDebug("VSICURL", "Disk cache trimmed to " CPL_FRMT_GIB " bytes",
+             m_nCurrentSize);
+    m_bMaintenanceInProgress = false;
+}
+
+}  // namespace cpl
+
+#endif  // HAVE_CURL
@@ -93,6 +93,7 @@
 #include <vector>
 
 #include "cpl_error.h"
+#include "cpl_mem_cache.h"
 #include "cpl_minizip_ioapi.h"
 #include "cpl_minizip_unzip.h"
 #include "cpl_multiproc.h"
@@ -340,6 +341,8 @@ class VSIDeflate64Handle final : public VSIVirtualHandle
 };
 #endif
 
+struct VSIGZipIndex;
+
 class VSIGZipFilesystemHandler final : public VSIFilesystemHandler
 {
     CPL_DISALLOW_COPY_ASSIGN(VSIGZipFilesystemHandler)
@@ -348,6 +351,19 @@ class VSIGZipFilesystemHandler final : public VSIFilesystemHandler
     VSIGZipHandle *poHandleLastGZipFile = nullptr;
     bool m_bInSaveInfo = false;
 
+    std::mutex m_oIndexMutex{};
+    std::string m_osLastIndexBaseFileName{};
+    std::shared_ptr<const VSIGZipIndex> m_poLastIndex{};
+
+    // Shared by the handles using a seek index
+    std::mutex m_oMutexDecodeThreadPool{};
+    std::unique_ptr<CPLWorkerThreadPool> m_poDecodeThreadPool{};
+
+    std::shared_ptr<const VSIGZipIndex> GetIndex(const char *pszBaseFileName,
+                                                 const VSIStatBufL &sStat,
+                                                 bool bBuild);
+    VSIVirtualHandle *OpenIndexed(const char *pszFilename);
+
   public:
     VSIGZipFilesystemHandler() = default;
     ~VSIGZipFilesystemHandler() override;
@@ -374,6 +390,8 @@ class VSIGZipFilesystemHandler final : public VSIFilesystemHandler
 
     void SaveInfo(VSIGZipHandle *poHandle);
     void SaveInfo_unlocked(VSIGZipHandle *poHandle);
+
+    CPLWorkerThreadPool *GetDecodeThreadPool(int nThreads);
 };
 
 /************************************************************************/
@@ -1309,6 +1327,940 @@ int VSIGZipHandle::Close()
     return 0;
 }
 
+/************************************************************************/
+/* ==================================================================== */
+/*                            VSIGZipIndex                              */
+/* ==================================================================== */
+/************************************************************************/
+
+// A seek index of a .gz file is made of "access points" from which
+// decompression can be resumed without decompressing the preceding data, as
+// in the zran.c example of zlib. An access point is either the start of a
+// gzip member (BGZF files and files made of concatenated .gz streams are
+// composed of many independent members), or a deflate block boundary, in
+// which case the 32 KB of uncompressed data that precede it are stored to be
+// used as the inflate dictionary.
+// The index can be persisted in a .gz.idx file next to the .gz file.
+
+constexpr unsigned GZIP_WINDOW_SIZE = 1U << MAX_WBITS;
+constexpr const char GZIP_INDEX_SIGNATURE[] = "GDALGZI1";
+constexpr size_t GZIP_INDEX_SIGNATURE_SIZE = sizeof(GZIP_INDEX_SIGNATURE) - 1;
+
+struct VSIGZipAccessPoint
+{
+    // Offset in the compressed file of the first byte that is fully part
+    // of the data after the access point
+    vsi_l_offset nIn = 0;
+    // Offset in the uncompressed stream
+    vsi_l_offset nOut = 0;
+    // Number of bits (1 to 7) of the byte at nIn - 1 that belong to the
+    // data after the access point, or 0.
+    int nBits = 0;
+    // Whether nIn is the start of the header of a gzip member
+    bool bMemberStart = false;
+    // Dictionary for access points in the middle of a member
+    std::vector<GByte> abyWindow{};
+};
+
+struct VSIGZipIndex
+{
+    vsi_l_offset nCompressedSize = 0;
+    GIntBig nMTime = 0;
+    vsi_l_offset nUncompressedSize = 0;
+    std::vector<VSIGZipAccessPoint> asPoints{};
+
+    bool Build(VSIVirtualHandle *poHandle, vsi_l_offset nSpan);
+    bool BuildBGZF(VSIVirtualHandle *poHandle, vsi_l_offset nSpan);
+    bool Load(const char *pszIndexFilename,
+              vsi_l_offset nExpectedCompressedSize, GIntBig nExpectedMTime);
+    bool Save(const char *pszIndexFilename) const;
+
+    size_t GetPointCount() const
+    {
+        return asPoints.size();
+    }
+
+    // Return the index of the access point that contains nOffset
+    size_t FindPoint(vsi_l_offset nOffset) const;
+
+    vsi_l_offset GetChunkSize(size_t iPoint) const
+    {
+        return (iPoint + 1 < asPoints.size() ? asPoints[iPoint + 1].nOut
+                                             : nUncompressedSize) -
+               asPoints[iPoint].nOut;
+    }
+
+    vsi_l_offset GetChunkCompressedEnd(size_t iPoint) const
+    {
+        return iPoint + 1 < asPoints.size() ? asPoints[iPoint + 1].nIn
+                                            : nCompressedSize;
+    }
+};
+
+/************************************************************************/
+/*                        VSIGZipSkipHeader()                           */
+/************************************************************************/
+
+// Skip a gzip member header, reading bytes with GetByte(), which returns
+// -1 at end of input. If pnBGZFBlockSize is not null, it is set to the total
+// size of the member when it has a BGZF "BC" extra subfield, or to 0.
+template <class GetByteFunc>
+static bool VSIGZipSkipHeader(GetByteFunc &&GetByte, int *pnBGZFBlockSize)
+{
+    if (pnBGZFBlockSize)
+        *pnBGZFBlockSize = 0;
+    if (GetByte() != gz_magic[0] || GetByte() != gz_magic[1])
+        return false;
+    const int method = GetByte();
+    const int flags = GetByte();
+    if (method != Z_DEFLATED || flags < 0 || (flags & RESERVED) != 0)
+        return false;
+
+    // Skip time, xflags and OS code
+    for (int i = 0; i < 6; ++i)
+    {
+        if (GetByte() < 0)
+            return false;
+    }
+
+    if ((flags & EXTRA_FIELD) != 0)
+    {
+        const int nXLenLow = GetByte();
+        const int nXLenHigh = GetByte();
+        if (nXLenLow < 0 || nXLenHigh < 0)
+            return false;
+        int nXLen = nXLenLow | (nXLenHigh << 8);
+        while (nXLen >= 4)
+        {
+            const int nSI1 = GetByte();
+            const int nSI2 = GetByte();
+            const int nSLenLow = GetByte();
+            const int nSLenHigh = GetByte();
+            if (nSLenHigh < 0)
+                return false;
+            int nSLen = nSLenLow | (nSLenHigh << 8);
+            nXLen -= 4;
+            if (nSI1 == 'B' && nSI2 == 'C' && nSLen == 2 && nXLen >= 2)
+            {
+                const int nBSizeLow = GetByte();
+                const int nBSizeHigh = GetByte();
+                if (nBSizeHigh < 0)
+                    return false;
+                if (pnBGZFBlockSize)
+                    *pnBGZFBlockSize = (nBSizeLow | (nBSizeHigh << 8)) + 1;
+                nXLen -= 2;
+                continue;
+            }
+            for (; nSLen > 0 && nXLen > 0; --nSLen, --nXLen)
+            {
+                if (GetByte() < 0)
+                    return false;
+            }
+        }
+        for (; nXLen > 0; --nXLen)
+        {
+            if (GetByte() < 0)
+                return false;
+        }
+    }
+
+    // Skip the original file name and the comment
+    for (const int nFlag : {ORIG_NAME, COMMENT})
+    {
+        if ((flags & nFlag) != 0)
+        {
+            int c;
+            while ((c = GetByte()) != 0)
+            {
+                if (c < 0)
+                    return false;
+            }
+        }
+    }
+
+    if ((flags & HEAD_CRC) != 0)
+    {
+        if (GetByte() < 0 || GetByte() < 0)
+            return false;
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                             FindPoint()                              */
+/************************************************************************/
+
+size_t VSIGZipIndex::FindPoint(vsi_l_offset nOffset) const
+{
+    const auto oIter =
+        std::upper_bound(asPoints.begin(), asPoints.end(), nOffset,
+                         [](vsi_l_offset nVal, const VSIGZipAccessPoint &sPoint)
+                         { return nVal < sPoint.nOut; });
+    return oIter == asPoints.begin()
+               ? 0
+               : static_cast<size_t>(oIter - asPoints.begin()) - 1;
+}
+
+/************************************************************************/
+/*                             BuildBGZF()                              */
+/************************************************************************/
+
+// Build the index of a BGZF file, whose members carry their compressed size
+// in the header and their uncompressed size in the trailer, without
+// decompressing anything.
+bool VSIGZipIndex::BuildBGZF(VSIVirtualHandle *poHandle, vsi_l_offset nSpan)
+{
+    asPoints.clear();
+    std::vector<GByte> abyBlock(65536);
+    vsi_l_offset nOffset = 0;
+    vsi_l_offset nOut = 0;
+    vsi_l_offset nLastPointOut = 0;
+    while (nOffset < nCompressedSize)
+    {
+        const size_t nToRead = static_cast<size_t>(
+            std::min(static_cast<vsi_l_offset>(abyBlock.size()),
+                     nCompressedSize - nOffset));
+        if (poHandle->Seek(nOffset, SEEK_SET) != 0 ||
+            poHandle->Read(abyBlock.data(), 1, nToRead) != nToRead)
+        {
+            return false;
+        }
+        size_t nPos = 0;
+        int nBlockSize = 0;
+        if (!VSIGZipSkipHeader(
+                [&abyBlock, &nPos, nToRead]()
+                { return nPos < nToRead ? abyBlock[nPos++] : -1; },
+                &nBlockSize) ||
+            nBlockSize < static_cast<int>(nPos) + 8 ||
+            static_cast<size_t>(nBlockSize) > nToRead)
+        {
+            return false;
+        }
+        const GByte *pabyISize = abyBlock.data() + nBlockSize - 4;
+        const vsi_l_offset nISize =
+            pabyISize[0] | (pabyISize[1] << 8) | (pabyISize[2] << 16) |
+            (static_cast<vsi_l_offset>(pabyISize[3]) << 24);
+        if (asPoints.empty() || nOut - nLastPointOut >= nSpan)
+        {
+            VSIGZipAccessPoint sPoint;
+            sPoint.nIn = nOffset;
+            sPoint.nOut = nOut;
+            sPoint.bMemberStart = true;
+            asPoints.push_back(std::move(sPoint));
+            nLastPointOut = nOut;
+        }
+        nOut += nISize;
+        nOffset += nBlockSize;
+    }
+    nUncompressedSize = nOut;
+    return !asPoints.empty();
+}
+
+/************************************************************************/
+/*                               Build()                                */
+/************************************************************************/
+
+bool VSIGZipIndex::Build(VSIVirtualHandle *poHandle, vsi_l_offset nSpan)
+{
+    {
+        // Files whose first member is a BGZF block are generally made only
+        // of BGZF blocks, which can be indexed much faster.
+        GByte abyHeader[32] = {};
+        size_t nRead = 0;
+        if (poHandle->Seek(0, SEEK_SET) == 0)
+            nRead = poHandle->Read(abyHeader, 1, sizeof(abyHeader));
+        size_t nPos = 0;
+        int nBlockSize = 0;
+        if (VSIGZipSkipHeader(
+                [&abyHeader, &nPos, nRead]()
+                { return nPos < nRead ? abyHeader[nPos++] : -1; },
+                &nBlockSize) &&
+            nBlockSize > 0 && BuildBGZF(poHandle, nSpan))
+        {
+            return true;
+        }
+    }
+
+    asPoints.clear();
+    if (poHandle->Seek(0, SEEK_SET) != 0)
+        return false;
+
+    z_stream sStream;
+    memset(&sStream, 0, sizeof(sStream));
+    if (inflateInit2(&sStream, -MAX_WBITS) != Z_OK)
+        return false;
+
+    std::vector<GByte> abyIn(Z_BUFSIZE);
+    // Circular buffer with the last 32 KB of uncompressed data
+    std::vector<GByte> abyWindow(GZIP_WINDOW_SIZE);
+    vsi_l_offset nInBufferEnd = 0;
+    const auto Fill = [poHandle, &sStream, &abyIn, &nInBufferEnd]()
+    {
+        const size_t nRead = poHandle->Read(abyIn.data(), 1, abyIn.size());
+        nInBufferEnd += nRead;
+        sStream.next_in = abyIn.data();
+        sStream.avail_in = static_cast<uInt>(nRead);
+        return nRead > 0;
+    };
+    const auto GetByte = [&sStream, &Fill]() -> int
+    {
+        if (sStream.avail_in == 0 && !Fill())
+            return -1;
+        sStream.avail_in--;
+        return *(sStream.next_in)++;
+    };
+
+    vsi_l_offset nOut = 0;
+    vsi_l_offset nLastPointOut = 0;
+    bool bOK = true;
+    while (bOK)
+    {
+        const vsi_l_offset nMemberStart = nInBufferEnd - sStream.avail_in;
+        if (!VSIGZipSkipHeader(GetByte, nullptr))
+        {
+            bOK = false;
+            break;
+        }
+        if (asPoints.empty() || nOut - nLastPointOut >= nSpan)
+        {
+            VSIGZipAccessPoint sPoint;
+            sPoint.nIn = nMemberStart;
+            sPoint.nOut = nOut;
+            sPoint.bMemberStart = true;
+            asPoints.push_back(std::move(sPoint));
+            nLastPointOut = nOut;
+        }
+
+        inflateReset(&sStream);
+        uLong nCRC = crc32(0, nullptr, 0);
+        vsi_l_offset nMemberOut = 0;
+        int nRet = Z_OK;
+        while (nRet != Z_STREAM_END)
+        {
+            if (sStream.avail_in == 0 && !Fill())
+            {
+                bOK = false;
+                break;
+            }
+            const uInt nWindowPos =
+                static_cast<uInt>(nMemberOut % GZIP_WINDOW_SIZE);
+            sStream.next_out = abyWindow.data() + nWindowPos;
+            sStream.avail_out = GZIP_WINDOW_SIZE - nWindowPos;
+            // Z_BLOCK makes inflate() stop at each deflate block boundary
+            nRet = inflate(&sStream, Z_BLOCK);
+            const uInt nProduced =
+                GZIP_WINDOW_SIZE - nWindowPos - sStream.avail_out;
+            nCRC = crc32(nCRC, abyWindow.data() + nWindowPos, nProduced);
+            nMemberOut += nProduced;
+            nOut += nProduced;
+            if (nRet != Z_OK && nRet != Z_STREAM_END)
+            {
+                bOK = false;
+                break;
+            }
+
+            // Bit 7 of data_type is set at the end of a deflate block, and
+            // bit 6 if that block is the last one of the member.
+            if ((sStream.data_type & 128) != 0 &&
+                (sStream.data_type & 64) == 0 && nRet != Z_STREAM_END &&
+                nOut - nLastPointOut >= nSpan)
+            {
+                VSIGZipAccessPoint sPoint;
+                sPoint.nIn = nInBufferEnd - sStream.avail_in;
+                sPoint.nOut = nOut;
+                sPoint.nBits = sStream.data_type & 7;
+                if (nMemberOut >= GZIP_WINDOW_SIZE)
+                {
+                    sPoint.abyWindow.insert(sPoint.abyWindow.end(),
+                                            abyWindow.begin() + nWindowPos +
+                                                nProduced,
+                                            abyWindow.end());
+                    sPoint.abyWindow.insert(sPoint.abyWindow.end(),
+                                            abyWindow.begin(),
+                                            abyWindow.begin() + nWindowPos +
+                                                nProduced);
+                }
+                else
+                {
+                    sPoint.abyWindow.insert(
+                        sPoint.abyWindow.end(), abyWindow.begin(),
+                        abyWindow.begin() + static_cast<size_t>(nMemberOut));
+                }
+                asPoints.push_back(std::move(sPoint));
+                nLastPointOut = nOut;
+            }
+        }
+        if (!bOK)
+            break;
+
+        // Check the CRC32 and ISIZE trailer
+        uLong nReadCRC = 0;
+        uLong nISize = 0;
+        for (int i = 0; i < 8; ++i)
+        {
+            const int c = GetByte();
+            if (c < 0)
+            {
+                bOK = false;
+                break;
+            }
+            if (i < 4)
+                nReadCRC |= static_cast<uLong>(c) << (8 * i);
+            else
+                nISize |= static_cast<uLong>(c) << (8 * (i - 4));
+        }
+        if (bOK && (nReadCRC != nCRC ||
+                    nISize != static_cast<uLong>(nMemberOut & 0xFFFFFFFFU)))
+        {
+            CPLError(CE_Failure, CPLE_FileIO,
+                     "CRC error while building .gz index");
+            bOK = false;
+        }
+
+        // Stop at end of file. Trailing data that is not a gzip member is
+        // not handled.
+        if (bOK && sStream.avail_in == 0 && !Fill())
+            break;
+    }
+    inflateEnd(&sStream);
+
+    nUncompressedSize = nOut;
+    return bOK && !asPoints.empty();
+}
+
+/************************************************************************/
+/*                                Save()                                */
+/************************************************************************/
+
+bool VSIGZipIndex::Save(const char *pszIndexFilename) const
+{
+    VSILFILE *fp = VSIFOpenL(pszIndexFilename, "wb");
+    if (!fp)
+        return false;
+
+    bool bOK = VSIFWriteL(GZIP_INDEX_SIGNATURE, GZIP_INDEX_SIGNATURE_SIZE, 1,
+                          fp) == 1;
+    const auto WriteUInt64 = [fp, &bOK](uint64_t nVal)
+    {
+        CPL_LSBPTR64(&nVal);
+        bOK = bOK && VSIFWriteL(&nVal, sizeof(nVal), 1, fp) == 1;
+    };
+    const auto WriteUInt32 = [fp, &bOK](uint32_t nVal)
+    {
+        CPL_LSBPTR32(&nVal);
+        bOK = bOK && VSIFWriteL(&nVal, sizeof(nVal), 1, fp) == 1;
+    };
+
+    WriteUInt64(nCompressedSize);
+    WriteUInt64(static_cast<uint64_t>(nMTime));
+    WriteUInt64(nUncompressedSize);
+    WriteUInt64(asPoints.size());
+    for (const auto &sPoint : asPoints)
+    {
+        WriteUInt64(sPoint.nIn);
+        WriteUInt64(sPoint.nOut);
+        const GByte abyFlags[2] = {static_cast<GByte>(sPoint.nBits),
+                                   static_cast<GByte>(sPoint.bMemberStart)};
+        bOK = bOK && VSIFWriteL(abyFlags, sizeof(abyFlags), 1, fp) == 1;
+        WriteUInt32(static_cast<uint32_t>(sPoint.abyWindow.size()));
+        if (sPoint.abyWindow.empty())
+        {
+            WriteUInt32(0);
+            continue;
+        }
+        // Windows of text data compress well
+        size_t nCompressedWindowSize = 0;
+        void *pCompressedWindow =
+            CPLZLibDeflate(sPoint.abyWindow.data(), sPoint.abyWindow.size(),
+                           -1, nullptr, 0, &nCompressedWindowSize);
+        bOK = bOK && pCompressedWindow != nullptr;
+        WriteUInt32(static_cast<uint32_t>(nCompressedWindowSize));
+        bOK = bOK && VSIFWriteL(pCompressedWindow, nCompressedWindowSize, 1,
+                                fp) == 1;
+        VSIFree(pCompressedWindow);
+    }
+
+    if (VSIFCloseL(fp) != 0)
+        bOK = false;
+    return bOK;
+}
+
+/************************************************************************/
+/*                                Load()                                */
+/************************************************************************/
+
+bool VSIGZipIndex::Load(const char *pszIndexFilename,
+                        vsi_l_offset nExpectedCompressedSize,
+                        GIntBig nExpectedMTime)
+{
+    VSIVirtualHandleUniquePtr fp(VSIFOpenL(pszIndexFilename, "rb"));
+    if (!fp || fp->Seek(0, SEEK_END) != 0)
+        return false;
+    const vsi_l_offset nIndexSize = fp->Tell();
+    if (fp->Seek(0, SEEK_SET) != 0)
+        return false;
+
+    char szSignature[GZIP_INDEX_SIGNATURE_SIZE] = {};
+    if (fp->Read(szSignature, 1, sizeof(szSignature)) != sizeof(szSignature) ||
+        memcmp(szSignature, GZIP_INDEX_SIGNATURE, sizeof(szSignature)) != 0)
+    {
+        return false;
+    }
+
+    bool bOK = true;
+    const auto ReadUInt64 = [&fp, &bOK]()
+    {
+        uint64_t nVal = 0;
+        bOK = bOK && fp->Read(&nVal, sizeof(nVal), 1) == 1;
+        CPL_LSBPTR64(&nVal);
+        return nVal;
+    };
+    const auto ReadUInt32 = [&fp, &bOK]()
+    {
+        uint32_t nVal = 0;
+        bOK = bOK && fp->Read(&nVal, sizeof(nVal), 1) == 1;
+        CPL_LSBPTR32(&nVal);
+        return nVal;
+    };
+
+    nCompressedSize = ReadUInt64();
+    nMTime = static_cast<GIntBig>(ReadUInt64());
+    nUncompressedSize = ReadUInt64();
+    const uint64_t nPoints = ReadUInt64();
+    // An index made for another version of the .gz file is useless.
+    // Each access point takes at least 26 bytes in the index file.
+    if (!bOK || nCompressedSize != nExpectedCompressedSize ||
+        nMTime != nExpectedMTime || nPoints == 0 || nPoints > nIndexSize / 26)
+    {
+        return false;
+    }
+
+    asPoints.clear();
+    asPoints.resize(static_cast<size_t>(nPoints));
+    std::vector<GByte> abyCompressedWindow;
+    for (size_t i = 0; bOK && i < asPoints.size(); ++i)
+    {
+        auto &sPoint = asPoints[i];
+        sPoint.nIn = ReadUInt64();
+        sPoint.nOut = ReadUInt64();
+        GByte abyFlags[2] = {};
+        bOK = bOK && fp->Read(abyFlags, sizeof(abyFlags), 1) == 1;
+        sPoint.nBits = abyFlags[0];
+        sPoint.bMemberStart = abyFlags[1] != 0;
+        const uint32_t nWindowSize = ReadUInt32();
+        const uint32_t nCompressedWindowSize = ReadUInt32();
+        if (!bOK || sPoint.nBits > 7 || sPoint.nIn > nCompressedSize ||
+            sPoint.nOut > nUncompressedSize ||
+            (i > 0 && (sPoint.nIn <= asPoints[i - 1].nIn ||
+                       sPoint.nOut <= asPoints[i - 1].nOut)) ||
+            (i == 0 && sPoint.nOut != 0) || nWindowSize > GZIP_WINDOW_SIZE ||
+            (sPoint.bMemberStart && nWindowSize != 0) ||
+            nCompressedWindowSize > 2 * GZIP_WINDOW_SIZE)
+        {
+            return false;
+        }
+        if (nWindowSize == 0)
+            continue;
+        abyCompressedWindow.resize(nCompressedWindowSize);
+        sPoint.abyWindow.resize(nWindowSize);
+        size_t nOutBytes = 0;
+        bOK = fp->Read(abyCompressedWindow.data(), 1, nCompressedWindowSize) ==
+                  nCompressedWindowSize &&
+              CPLZLibInflate(abyCompressedWindow.data(), nCompressedWindowSize,
+                             sPoint.abyWindow.data(), nWindowSize,
+                             &nOutBytes) != nullptr &&
+              nOutBytes == nWindowSize;
+    }
+    return bOK;
+}
+
+/************************************************************************/
+/*                        VSIGZipDecodeChunk()                          */
+/************************************************************************/
+
+// Decompress the data between an access point and the next one.
+// pabyIn starts at the compressed byte that contains the access point, and
+// ends at the compressed byte that contains the next one.
+static bool VSIGZipDecodeChunk(const VSIGZipAccessPoint &sPoint,
+                               const GByte *pabyIn, size_t nInSize,
+                               GByte *pabyOut, size_t nOutSize)
+{
+    if (nOutSize > UINT_MAX)
+        return false;
+
+    z_stream sStream;
+    memset(&sStream, 0, sizeof(sStream));
+    if (inflateInit2(&sStream, -MAX_WBITS) != Z_OK)
+        return false;
+
+    size_t nPos = 0;
+    const auto GetByte = [pabyIn, nInSize, &nPos]() -> int
+    { return nPos < nInSize ? pabyIn[nPos++] : -1; };
+
+    bool bOK = true;
+    if (sPoint.bMemberStart)
+    {
+        bOK = VSIGZipSkipHeader(GetByte, nullptr);
+    }
+    else
+    {
+        if (sPoint.nBits)
+        {
+            bOK = nInSize > 0 &&
+                  inflatePrime(&sStream, sPoint.nBits,
+                               pabyIn[0] >> (8 - sPoint.nBits)) == Z_OK;
+            nPos = 1;
+        }
+        if (bOK && !sPoint.abyWindow.empty())
+        {
+            bOK = inflateSetDictionary(
+                      &sStream, sPoint.abyWindow.data(),
+                      static_cast<uInt>(sPoint.abyWindow.size())) == Z_OK;
+        }
+    }
+
+    sStream.next_out = pabyOut;
+    sStream.avail_out = static_cast<uInt>(nOutSize);
+    while (bOK && sStream.avail_out > 0)
+    {
+        const size_t nAvailIn =
+            std::min<size_t>(nInSize - nPos, std::numeric_limits<uInt>::max());
+        // Casting away const is safe: inflate() does not modify its input
+        sStream.next_in = const_cast<GByte *>(pabyIn + nPos);
+        sStream.avail_in = static_cast<uInt>(nAvailIn);
+        const int nRet = inflate(&sStream, Z_NO_FLUSH);
+        nPos += nAvailIn - sStream.avail_in;
+        if (nRet == Z_STREAM_END)
+        {
+            if (sStream.avail_out == 0)
+                break;
+            // Skip the trailer of this member and the header of the next one
+            nPos += 8;
+            bOK = nPos < nInSize && VSIGZipSkipHeader(GetByte, nullptr) &&
+                  inflateReset(&sStream) == Z_OK;
+        }
+        else if (nRet != Z_OK)
+        {
+            bOK = false;
+        }
+    }
+    inflateEnd(&sStream);
+    return bOK;
+}
+
+/************************************************************************/
+/* ==================================================================== */
+/*                        VSIGZipIndexedHandle                          */
+/* ==================================================================== */
+/************************************************************************/
+
+// Read-only handle on a .gz file with a seek index. Chunks between two
+// access points are decompressed independently, possibly by several threads
+// when reading sequentially.
+
+class VSIGZipIndexedHandle final : public VSIVirtualHandle
+{
+    struct DecodeJob
+    {
+        const VSIGZipAccessPoint *psPoint = nullptr;
+        std::vector<GByte> abyIn{};
+        std::shared_ptr<std::vector<GByte>> poOut{};
+        bool bOK = false;
+    };
+
+    VSIGZipFilesystemHandler *const m_poFS;
+    VSIVirtualHandleUniquePtr m_poBaseHandle{};
+    std::shared_ptr<const VSIGZipIndex> m_poIndex{};
+    const int m_nThreads;
+    CPLJobQueuePtr m_poJobQueue{};
+    lru11::Cache<size_t, std::shared_ptr<std::vector<GByte>>> m_oCache;
+    vsi_l_offset m_nOffset = 0;
+    // End of the last read, or max() if there has been none yet
+    vsi_l_offset m_nLastReadEnd = std::numeric_limits<vsi_l_offset>::max();
+    bool m_bEOF = false;
+    bool m_bError = false;
+
+    bool DecodeChunks(size_t iFirst, size_t iLast);
+
+    CPL_DISALLOW_COPY_ASSIGN(VSIGZipIndexedHandle)
+
+  public:
+    VSIGZipIndexedHandle(VSIGZipFilesystemHandler *poFS,
+                         VSIVirtualHandleUniquePtr &&poBaseHandle,
+                         const std::shared_ptr<const VSIGZipIndex> &poIndex,
+                         int nThreads);
+
+    int Seek(vsi_l_offset nOffset, int nWhence) override;
+    vsi_l_offset Tell() override;
+    size_t Read(void *pBuffer, size_t nSize, size_t nMemb) override;
+    size_t Write(const void *pBuffer, size_t nSize, size_t nMemb) override;
+    void ClearErr() override;
+    int Eof() override;
+    int Error() override;
+    int Close() override;
+};
+
+/************************************************************************/
+/*                       VSIGZipIndexedHandle()                         */
+/************************************************************************/
+
+VSIGZipIndexedHandle::VSIGZipIndexedHandle(
+    VSIGZipFilesystemHandler *poFS, VSIVirtualHandleUniquePtr &&poBaseHandle,
+    const std::shared_ptr<const VSIGZipIndex> &poIndex, int nThreads)
+    : m_poFS(poFS), m_poBaseHandle(std::move(poBaseHandle)), m_poIndex(poIndex),
+      m_nThreads(nThreads),
+      // Room for the chunks decoded ahead, and the current one
+      m_oCache(2 * static_cast<size_t>(nThreads) + 1, 0)
+{
+}
+
+/************************************************************************/
+/*                               Seek()                                 */
+/************************************************************************/
+
+int VSIGZipIndexedHandle::Seek(vsi_l_offset nOffset, int nWhence)
+{
+    m_bEOF = false;
+    if (nWhence == SEEK_SET)
+        m_nOffset = nOffset;
+    else if (nWhence == SEEK_CUR)
+        m_nOffset += nOffset;
+    else
+        m_nOffset = m_poIndex->nUncompressedSize + nOffset;
+    return 0;
+}
+
+/************************************************************************/
+/*                               Tell()                                 */
+/************************************************************************/
+
+vsi_l_offset VSIGZipIndexedHandle::Tell()
+{
+    return m_nOffset;
+}
+
+/************************************************************************/
+/*                           DecodeChunks()                             */
+/************************************************************************/
+
+bool VSIGZipIndexedHandle::DecodeChunks(size_t iFirst, size_t iLast)
+{
+    std::vector<DecodeJob> asJobs;
+    for (size_t i = iFirst; i <= iLast; ++i)
+    {
+        std::shared_ptr<std::vector<GByte>> poChunk;
+        if (m_oCache.tryGet(i, poChunk))
+            continue;
+
+        // Read the compressed data in the main thread, so that the base
+        // handle does not need to be thread-safe.
+        const auto &sPoint = m_poIndex->asPoints[i];
+        const vsi_l_offset nStart = sPoint.nIn - (sPoint.nBits ? 1 : 0);
+        const vsi_l_offset nEnd = m_poIndex->GetChunkCompressedEnd(i);
+        const vsi_l_offset nOutSize = m_poIndex->GetChunkSize(i);
+        if (nEnd < nStart ||
+            nEnd - nStart > std::numeric_limits<size_t>::max() ||
+            nOutSize > std::numeric_limits<size_t>::max())
+        {
+            return false;
+        }
+        DecodeJob sJob;
+        sJob.psPoint = &sPoint;
+        try
+        {
+            sJob.abyIn.resize(static_cast<size_t>(nEnd - nStart));
+            sJob.poOut = std::make_shared<std::vector<GByte>>(
+                static_cast<size_t>(nOutSize));
+        }
+        catch (const std::exception &)
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "Cannot allocate memory for .gz chunk");
+            return false;
+        }
+        if (m_poBaseHandle->Seek(nStart, SEEK_SET) != 0 ||
+            m_poBaseHandle->Read(sJob.abyIn.data(), 1, sJob.abyIn.size()) !=
+                sJob.abyIn.size())
+        {
+            CPLError(CE_Failure, CPLE_FileIO, "Cannot read .gz data");
+            return false;
+        }
+        asJobs.push_back(std::move(sJob));
+    }
+
+    const auto Decode = [](DecodeJob &sJob)
+    {
+        sJob.bOK =
+            VSIGZipDecodeChunk(*sJob.psPoint, sJob.abyIn.data(),
+                               sJob.abyIn.size(), sJob.poOut->data(),
+                               sJob.poOut->size());
+    };
+
+    if (asJobs.size() > 1 && m_nThreads > 1 && !m_poJobQueue)
+    {
+        if (auto poPool = m_poFS->GetDecodeThreadPool(m_nThreads))
+            m_poJobQueue = poPool->CreateJobQueue();
+    }
+    if (asJobs.size() > 1 && m_poJobQueue)
+    {
+        for (auto &sJob : asJobs)
+            m_poJobQueue->SubmitJob([&sJob, &Decode]() { Decode(sJob); });
+        m_poJobQueue->WaitCompletion();
+    }
+    else
+    {
+        for (auto &sJob : asJobs)
+            Decode(sJob);
+    }
+
+    for (auto &sJob : asJobs)
+    {
+        if (!sJob.bOK)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Decompression of .gz chunk failed");
+            return false;
+        }
+        m_oCache.insert(
+            static_cast<size_t>(sJob.psPoint - m_poIndex->asPoints.data()),
+            std::move(sJob.poOut));
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                               Read()                                 */
+/************************************************************************/
+
+size_t VSIGZipIndexedHandle::Read(void *pBuffer, size_t nSize, size_t nMemb)
+{
+    const size_t nToRead = nSize * nMemb;
+    if (nToRead == 0 || m_bError)
+        return 0;
+    const vsi_l_offset nUncompressedSize = m_poIndex->nUncompressedSize;
+    if (m_nOffset >= nUncompressedSize)
+    {
+        m_bEOF = true;
+        return 0;
+    }
+
+    const vsi_l_offset nEnd =
+        std::min<vsi_l_offset>(m_nOffset + nToRead, nUncompressedSize);
+    const size_t iFirst = m_poIndex->FindPoint(m_nOffset);
+    const size_t iLast = m_poIndex->FindPoint(nEnd - 1);
+    // When reading sequentially, that is when this read starts where the
+    // previous one ended, decode the next chunks at the same time, so that
+    // all threads are busy.
+    const size_t iLastToDecode =
+        m_nOffset == m_nLastReadEnd
+            ? std::min(m_poIndex->GetPointCount() - 1,
+                       iLast + static_cast<size_t>(m_nThreads) - 1)
+            : iLast;
+    if (iLast - iFirst + 1 > static_cast<size_t>(m_nThreads))
+    {
+        // Too many chunks to keep them all in the cache: decode them by
+        // batches.
+        size_t nRead = 0;
+        while (nRead < nToRead && !m_bEOF && !m_bError)
+        {
+            const size_t iCur = m_poIndex->FindPoint(m_nOffset);
+            const size_t nBatch = static_cast<size_t>(std::min(
+                static_cast<vsi_l_offset>(nToRead - nRead),
+                m_poIndex->GetChunkSize(iCur) -
+                    (m_nOffset - m_poIndex->asPoints[iCur].nOut)));
+            const size_t nReadThisTime =
+                Read(static_cast<GByte *>(pBuffer) + nRead, 1, nBatch);
+            if (nReadThisTime == 0)
+                break;
+            nRead += nReadThisTime;
+        }
+        return nRead / nSize;
+    }
+
+    if (!DecodeChunks(iFirst, iLastToDecode))
+    {
+        m_bError = true;
+        return 0;
+    }
+
+    GByte *pabyOut = static_cast<GByte *>(pBuffer);
+    for (size_t i = iFirst; i <= iLast; ++i)
+    {
+        std::shared_ptr<std::vector<GByte>> poChunk;
+        if (!m_oCache.tryGet(i, poChunk))
+        {
+            // Should not happen given the cache size
+            m_bError = true;
+            return 0;
+        }
+        const vsi_l_offset nChunkStart = m_poIndex->asPoints[i].nOut;
+        const size_t nOffsetInChunk =
+            static_cast<size_t>(m_nOffset - nChunkStart);
+        const size_t nToCopy = static_cast<size_t>(std::min<vsi_l_offset>(
+            poChunk->size() - nOffsetInChunk, nEnd - m_nOffset));
+        memcpy(pabyOut, poChunk->data() + nOffsetInChunk, nToCopy);
+        pabyOut += nToCopy;
+        m_nOffset += nToCopy;
+    }
+    m_nLastReadEnd = m_nOffset;
+
+    const size_t nRead = static_cast<size_t>(pabyOut -
+                                             static_cast<GByte *>(pBuffer));
+    if (nRead < nToRead)
+        m_bEOF = true;
+    return nRead / nSize;
+}
+
+/************************************************************************/
+/*                               Write()                                */
+/************************************************************************/
+
+size_t VSIGZipIndexedHandle::Write(const void * /* pBuffer */,
+                                   size_t /* nSize */, size_t /* nMemb */)
+{
+    CPLError(CE_Failure, CPLE_NotSupported,
+             "VSIFWriteL is not supported on GZip streams");
+    return 0;
+}
+
+/************************************************************************/
+/*                               Eof()                                  */
+/************************************************************************/
+
+int VSIGZipIndexedHandle::Eof()
+{
+    return m_bEOF;
+}
+
+/************************************************************************/
+/*                              Error()                                 */
+/************************************************************************/
+
+int VSIGZipIndexedHandle::Error()
+{
+    return m_bError;
+}
+
+/************************************************************************/
+/*                             ClearErr()                               */
+/************************************************************************/
+
+void VSIGZipIndexedHandle::ClearErr()
+{
+    m_poBaseHandle->ClearErr();
+    m_bEOF = false;
+    m_bError = false;
+}
+
+/************************************************************************/
+/*                              Close()                                 */
+/************************************************************************/
+
+int VSIGZipIndexedHandle::Close()
+{
+    return 0;
+}
+
 #ifdef ENABLE_DEFLATE64
 
 /************************************************************************/
@@ -2982,6 +3934,29 @@ VSIGZipFilesystemHandler::~VSIGZipFilesystemHandler()
     hMutex = nullptr;
 }
 
+/************************************************************************/
+/*                        GetDecodeThreadPool()                         */
+/************************************************************************/
+
+// Return the pool of threads used by VSIGZipIndexedHandle, grown to
+// nThreads if needed.
+CPLWorkerThreadPool *VSIGZipFilesystemHandler::GetDecodeThreadPool(int nThreads)
+{
+    std::lock_guard oLock(m_oMutexDecodeThreadPool);
+    if (!m_poDecodeThreadPool)
+    {
+        auto poPool = std::make_unique<CPLWorkerThreadPool>();
+        if (!poPool->Setup(nThreads, nullptr, nullptr, false))
+            return nullptr;
+        m_poDecodeThreadPool = std::move(poPool);
+    }
+    else if (nThreads > m_poDecodeThreadPool->GetThreadCount())
+    {
+        m_poDecodeThreadPool->Setup(nThreads, nullptr, nullptr, false);
+    }
+    return m_poDecodeThreadPool.get();
+}
+
 /************************************************************************/
 /*                            SaveInfo()                                */
 /************************************************************************/
@@ -3066,6 +4041,9 @@ VSIGZipFilesystemHandler::Open(const char *pszFilename, const char *pszAccess,
     /*      Otherwise we are in the read access case.                       */
     /* -------------------------------------------------------------------- */
 
+    if (VSIVirtualHandle *poIndexedHandle = OpenIndexed(pszFilename))
+        return poIndexedHandle;
+
     VSIGZipHandle *poGZIPHandle = OpenGZipReadOnly(pszFilename, pszAccess);
     if (poGZIPHandle)
         // Wrap the VSIGZipHandle inside a buffered reader that will
@@ -3076,6 +4054,147 @@ VSIGZipFilesystemHandler::Open(const char *pszFilename, const char *pszAccess,
     return nullptr;
 }
 
+/************************************************************************/
+/*                              GetIndex()                              */
+/************************************************************************/
+
+// Return the seek index of a .gz file, either from the cache of the last
+// one used, or from its .gz.idx file. If bBuild is set and no valid index
+// is found, build it by decompressing the whole file once, and try to save
+// it as a .gz.idx file.
+std::shared_ptr<const VSIGZipIndex>
+VSIGZipFilesystemHandler::GetIndex(const char *pszBaseFileName,
+                                   const VSIStatBufL &sStat, bool bBuild)
+{
+    const vsi_l_offset nCompressedSize =
+        static_cast<vsi_l_offset>(sStat.st_size);
+    const GIntBig nMTime = static_cast<GIntBig>(sStat.st_mtime);
+    {
+        std::lock_guard oLock(m_oIndexMutex);
+        if (m_poLastIndex && m_osLastIndexBaseFileName == pszBaseFileName &&
+            m_poLastIndex->nCompressedSize == nCompressedSize &&
+            m_poLastIndex->nMTime == nMTime)
+        {
+            return m_poLastIndex;
+        }
+    }
+
+    const std::string osIndexFilename =
+        std::string(pszBaseFileName).append(".idx");
+    auto poIndex = std::make_shared<VSIGZipIndex>();
+    bool bOK;
+    {
+        CPLErrorStateBackuper oErrorStateBackuper(CPLQuietErrorHandler);
+        bOK = poIndex->Load(osIndexFilename.c_str(), nCompressedSize, nMTime);
+    }
+    if (!bOK)
+    {
+        if (!bBuild)
+            return nullptr;
+
+        VSIVirtualHandleUniquePtr poBaseHandle(
+            VSIFileManager::GetHandler(pszBaseFileName)
+                ->Open(pszBaseFileName, "rb"));
+        if (!poBaseHandle)
+            return nullptr;
+
+        GIntBig nSpan = 0;
+        if (CPLParseMemorySize(
+                CPLGetConfigOption("CPL_VSIL_GZIP_INDEX_SPAN", "1MB"), &nSpan,
+                nullptr) != CE_None)
+        {
+            nSpan = 1024 * 1024;
+        }
+        nSpan = std::max<GIntBig>(GZIP_WINDOW_SIZE,
+                                  std::min<GIntBig>(nSpan, 1024 * 1024 * 1024));
+
+        poIndex = std::make_shared<VSIGZipIndex>();
+        poIndex->nCompressedSize = nCompressedSize;
+        poIndex->nMTime = nMTime;
+        if (!poIndex->Build(poBaseHandle.get(),
+                            static_cast<vsi_l_offset>(nSpan)))
+        {
+            CPLDebug("GZIP", "Cannot build index of %s", pszBaseFileName);
+            return nullptr;
+        }
+        CPLDebug("GZIP", "Index of %s built with %d access points",
+                 pszBaseFileName, static_cast<int>(poIndex->GetPointCount()));
+
+        if (!STARTS_WITH(pszBaseFileName, "/vsicurl/") &&
+            !STARTS_WITH(pszBaseFileName, "/vsitar/") &&
+            !STARTS_WITH(pszBaseFileName, "/vsizip/"))
+        {
+            CPLErrorStateBackuper oErrorStateBackuper(CPLQuietErrorHandler);
+            if (!poIndex->Save(osIndexFilename.c_str()))
+            {
+                VSIUnlink(osIndexFilename.c_str());
+                CPLDebug("GZIP", "Cannot write %s", osIndexFilename.c_str());
+            }
+        }
+    }
+
+    std::lock_guard oLock(m_oIndexMutex);
+    m_osLastIndexBaseFileName = pszBaseFileName;
+    m_poLastIndex = poIndex;
+    return poIndex;
+}
+
+/************************************************************************/
+/*                           UseGZipIndex()                             */
+/************************************************************************/
+
+// Whether the .gz.idx file of pszBaseFileName must be looked for, according
+// to CPL_VSIL_GZIP_INDEX.
+static bool UseGZipIndex(const char *pszBaseFileName)
+{
+    const char *pszIndex = CPLGetConfigOption("CPL_VSIL_GZIP_INDEX", "AUTO");
+    if (EQUAL(pszIndex, "AUTO"))
+    {
+        // Do not issue a request for a .gz.idx file that is most likely
+        // missing each time a remote file is opened.
+        return VSIFileManager::GetHandler(pszBaseFileName)
+            ->IsLocal(pszBaseFileName);
+    }
+    return EQUAL(pszIndex, "BUILD") || CPLTestBool(pszIndex);
+}
+
+/************************************************************************/
+/*                            OpenIndexed()                             */
+/************************************************************************/
+
+VSIVirtualHandle *
+VSIGZipFilesystemHandler::OpenIndexed(const char *pszFilename)
+{
+    const char *pszBaseFileName = pszFilename + strlen("/vsigzip/");
+    if (!UseGZipIndex(pszBaseFileName))
+        return nullptr;
+
+    VSIStatBufL sStat;
+    if (VSIStatL(pszBaseFileName, &sStat) != 0 || VSI_ISDIR(sStat.st_mode))
+        return nullptr;
+
+    auto poIndex = GetIndex(
+        pszBaseFileName, sStat,
+        EQUAL(CPLGetConfigOption("CPL_VSIL_GZIP_INDEX", "AUTO"), "BUILD"));
+    if (!poIndex)
+        return nullptr;
+
+    VSIVirtualHandleUniquePtr poBaseHandle(
+        VSIFileManager::GetHandler(pszBaseFileName)
+            ->Open(pszBaseFileName, "rb"));
+    if (!poBaseHandle)
+        return nullptr;
+
+    const char *pszThreads = CPLGetConfigOption("GDAL_NUM_THREADS", "ALL_CPUS");
+    int nThreads = EQUAL(pszThreads, "ALL_CPUS") ? CPLGetNumCPUs()
+                                                 : atoi(pszThreads);
+    // Each thread keeps up to two decompressed chunks in memory
+    nThreads = std::max(1, std::min(32, nThreads));
+
+    return new VSIGZipIndexedHandle(this, std::move(poBaseHandle), poIndex,
+                                    nThreads);
+}
+
 /************************************************************************/
 /*                      SupportsSequentialWrite()                       */
 /************************************************************************/
@@ -3185,6 +4304,18 @@ int VSIGZipFilesystemHandler::Stat(const char *pszFilename,
 
     if (ret == 0 && (nFlags & VSI_STAT_SIZE_FLAG))
     {
+        // A seek index also stores the uncompressed size
+        if (UseGZipIndex(pszFilename + strlen("/vsigzip/")))
+        {
+            const auto poIndex = GetIndex(pszFilename + strlen("/vsigzip/"),
+                                          *pStatBuf, false);
+            if (poIndex)
+            {
+                pStatBuf->st_size = poIndex->nUncompressedSize;
+                return ret;
+            }
+        }
+
         CPLString osCacheFilename(pszFilename + strlen("/vsigzip/"));
         osCacheFilename += ".properties";
 
@@ -3276,11 +4407,24 @@ const char *VSIGZipFilesystemHandler::GetOptions()
 {
     return "<Options>"
            "  <Option name='GDAL_NUM_THREADS' type='string' "
-           "description='Number of threads for compression. Either a integer "
+           "description='Number of threads for compression, and for "
+           "decompression of files with a seek index. Either a integer "
            "or ALL_CPUS'/>"
            "  <Option name='CPL_VSIL_DEFLATE_CHUNK_SIZE' type='string' "
            "description='Chunk of uncompressed data for parallelization. "
            "Use K(ilobytes) or M(egabytes) suffix' default='1M'/>"
+           "  <Option name='CPL_VSIL_GZIP_INDEX' type='string-select' "
+           "description='Whether to use a .gz.idx seek index, and to build "
+           "it if it is missing' default='AUTO'>"
+           "    <Value>AUTO</Value>"
+           "    <Value>YES</Value>"
+           "    <Value>NO</Value>"
+           "    <Value>BUILD</Value>"
+           "  </Option>"
+           "  <Option name='CPL_VSIL_GZIP_INDEX_SPAN' type='string' "
+           "description='Amount of uncompressed data between access points "
+           "of a seek index being built. Use K(ilobytes) or M(egabytes) "
+           "suffix' default='1MB'/>"
            "</Options>";
 }
 
@@ -5039,6 +6183,7 @@ void *CPLZLibDeflate(const void *ptr, size_t nBytes, int nLevel, void *outptr,
     ret = deflate(&strm, Z_FINISH);
     if (ret != Z_STREAM_END)
     {
+        deflateEnd(&strm);
         if (pTmp != outptr)
             VSIFree(pTmp);
         return nullptr;
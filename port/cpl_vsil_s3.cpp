@@ -20,6 +20,7 @@
 #include "cpl_time.h"
 #include "cpl_vsil_curl_priv.h"
 #include "cpl_vsil_curl_class.h"
+#include "cpl_worker_thread_pool.h"
 
 #include <errno.h>
 
@@ -784,6 +785,23 @@ VSIMultipartWriteHandle::VSIMultipartWriteHandle(
                  "Cannot allocate working buffer for %s",
                  m_poFS->GetFSPrefix().c_str());
     }
+
+    // Number of parts that can be uploaded in the background while the
+    // caller keeps on filling the next part. 0 means that parts are uploaded
+    // synchronously from Write().
+    const char *pszNumThreads = m_aosOptions.FetchNameValue("NUM_THREADS");
+    if (!pszNumThreads)
+        pszNumThreads = VSIGetPathSpecificOption(
+            pszFilename, "CPL_VSIL_MULTIPART_UPLOAD_NUM_THREADS", "0");
+    const int nThreads = EQUAL(pszNumThreads, "ALL_CPUS")
+                             ? CPLGetNumCPUs()
+                             : std::clamp(atoi(pszNumThreads), 0, 64);
+    if (nThreads > 0 && poFS->SupportsParallelMultipartUpload())
+    {
+        m_poThreadPool = std::make_unique<CPLWorkerThreadPool>();
+        if (!m_poThreadPool->Setup(nThreads, nullptr, nullptr))
+            m_poThreadPool.reset();
+    }
 }
 
 /************************************************************************/
@@ -856,6 +874,8 @@ VSIMultipartWriteHandle::~VSIMultipartWriteHandle()
     VSIMultipartWriteHandle::Close();
     delete m_poS3HandleHelper;
     CPLFree(m_pabyBuffer);
+    for (GByte *pabyBuffer : m_apabyFreeBuffers)
+        CPLFree(pabyBuffer);
     CPLFree(m_sWriteFuncHeaderData.pBuffer);
 }
 
@@ -1025,6 +1045,8 @@ bool VSIMultipartWriteHandle::UploadPart()
                  m_poFS->GetDebugKey());
         return false;
     }
+    if (m_poThreadPool)
+        return UploadPartInBackground();
     const std::string osEtag = m_poFS->UploadPart(
         m_osFilename, m_nPartNumber, m_osUploadID,
         static_cast<vsi_l_offset>(m_nBufferSize) * (m_nPartNumber - 1),
@@ -1038,6 +1060,113 @@ bool VSIMultipartWriteHandle::UploadPart()
     return !osEtag.empty();
 }
 
+/************************************************************************/
+/*                       UploadPartInBackground()                       */
+/************************************************************************/
+
+/** Hand over the current buffer to a worker thread that uploads it as part
+ * m_nPartNumber, and provide a new buffer to Write().
+ *
+ * At most GetThreadCount() parts are in flight at a time, so memory
+ * consumption is bounded by (GetThreadCount() + 1) times the chunk size.
+ */
+bool VSIMultipartWriteHandle::UploadPartInBackground()
+{
+    // Wait for a slot to be available. At full capacity, this also
+    // guarantees that a buffer has been returned to m_apabyFreeBuffers.
+    m_poThreadPool->WaitCompletion(m_poThreadPool->GetThreadCount() - 1);
+
+    const int nPartNumber = m_nPartNumber;
+    GByte *pabyBuffer = m_pabyBuffer;
+    const size_t nBufferSize = m_nBufferOff;
+    m_nBufferOff = 0;
+    {
+        std::lock_guard oLock(m_oMutexBackgroundUpload);
+        m_pabyBuffer = nullptr;
+        if (!m_bBackgroundUploadError)
+        {
+            // Etags are stored by part number, since parts may complete out
+            // of order.
+            m_aosEtags.resize(nPartNumber);
+            if (!m_apabyFreeBuffers.empty())
+            {
+                m_pabyBuffer = m_apabyFreeBuffers.back();
+                m_apabyFreeBuffers.pop_back();
+            }
+            else
+            {
+                m_pabyBuffer = static_cast<GByte *>(VSIMalloc(m_nBufferSize));
+                if (m_pabyBuffer == nullptr)
+                {
+                    CPLError(CE_Failure, CPLE_OutOfMemory,
+                             "Cannot allocate working buffer for %s",
+                             m_poFS->GetFSPrefix().c_str());
+                }
+            }
+        }
+    }
+    if (m_pabyBuffer == nullptr)
+    {
+        m_pabyBuffer = pabyBuffer;
+        WaitForBackgroundUploads();
+        return false;
+    }
+
+    const vsi_l_offset nPosition =
+        static_cast<vsi_l_offset>(m_nBufferSize) * (nPartNumber - 1);
+    return m_poThreadPool->SubmitJob(
+        [this, nPartNumber, nPosition, pabyBuffer, nBufferSize]()
+        {
+            auto oAccumulator = m_oErrorAccumulator.InstallForCurrentScope();
+            CPL_IGNORE_RET_VAL(oAccumulator);
+
+            // The handle helper is modified by UploadPart(), so each job
+            // needs its own one.
+            std::unique_ptr<IVSIS3LikeHandleHelper> poS3HandleHelper(
+                m_poFS->CreateHandleHelper(
+                    m_osFilename.c_str() + m_poFS->GetFSPrefix().size(),
+                    false));
+            std::string osEtag;
+            if (poS3HandleHelper)
+            {
+                osEtag = m_poFS->UploadPart(
+                    m_osFilename, nPartNumber, m_osUploadID, nPosition,
+                    pabyBuffer, nBufferSize, poS3HandleHelper.get(),
+                    m_oRetryParameters, nullptr);
+            }
+
+            std::lock_guard oLock(m_oMutexBackgroundUpload);
+            if (osEtag.empty())
+                m_bBackgroundUploadError = true;
+            else
+                m_aosEtags[nPartNumber - 1] = std::move(osEtag);
+            m_apabyFreeBuffers.push_back(pabyBuffer);
+        });
+}
+
+/************************************************************************/
+/*                      WaitForBackgroundUploads()                      */
+/************************************************************************/
+
+/** Wait for all parts being uploaded in the background to be processed,
+ * and re-emit in the calling thread the errors and warnings they raised.
+ *
+ * @return true if all parts have been successfully uploaded so far.
+ */
+bool VSIMultipartWriteHandle::WaitForBackgroundUploads()
+{
+    if (!m_poThreadPool)
+        return true;
+    m_poThreadPool->WaitCompletion();
+    if (!m_bBackgroundErrorsReplayed)
+    {
+        m_bBackgroundErrorsReplayed = true;
+        m_oErrorAccumulator.ReplayErrors();
+    }
+    std::lock_guard oLock(m_oMutexBackgroundUpload);
+    return !m_bBackgroundUploadError;
+}
+
 std::string IVSIS3LikeFSHandlerWithMultipartUpload::UploadPart(
     const std::string &osFilename, int nPartNumber,
     const std::string &osUploadID, vsi_l_offset /* nPosition */,
@@ -1741,6 +1870,19 @@ int VSIMultipartWriteHandle::Close()
         }
         else
         {
+            if (m_poThreadPool)
+            {
+                // Submit the last part and wait for all parts to be
+                // uploaded. Failures of background uploads are only known
+                // now, so they must be reported by Close().
+                bool bOK = m_bError || m_nBufferOff == 0 || UploadPart();
+                bOK = WaitForBackgroundUploads() && bOK;
+                if (!bOK && !m_bError)
+                {
+                    m_bError = true;
+                    nRet = -1;
+                }
+            }
             if (m_bError)
             {
                 if (!m_poFS->AbortMultipart(m_osFilename, m_osUploadID,
@@ -1748,7 +1890,7 @@ int VSIMultipartWriteHandle::Close()
                                             m_oRetryParameters))
                     nRet = -1;
             }
-            else if (m_nBufferOff > 0 && !UploadPart())
+            else if (!m_poThreadPool && m_nBufferOff > 0 && !UploadPart())
                 nRet = -1;
             else if (m_poFS->CompleteMultipart(
                          m_osFilename, m_osUploadID, m_aosEtags, m_nCurOffset,
@@ -65,6 +65,12 @@
 #ifdef HAVE_PREAD_BSD
 #include <sys/uio.h>
 #endif
+#ifdef HAVE_LINUX_IO_URING
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#endif
 
 #if defined(__MACH__) && defined(__APPLE__)
 #define HAS_CASE_INSENSITIVE_FILE_SYSTEM
@@ -73,8 +79,14 @@
 #include <limits.h>
 #endif
 
+#include <algorithm>
+#include <atomic>
 #include <limits>
+#include <memory>
+#include <mutex>
 #include <new>
+#include <string>
+#include <vector>
 
 #include "cpl_config.h"
 #include "cpl_conv.h"
@@ -82,6 +94,7 @@
 #include "cpl_multiproc.h"
 #include "cpl_string.h"
 #include "cpl_vsi_error.h"
+#include "cpl_worker_thread_pool.h"
 
 #if defined(UNIX_STDIO_64)
 
@@ -156,6 +169,9 @@ class VSIUnixStdioFilesystemHandler final : public VSIFilesystemHandler
     CPLMutex *hMutex = nullptr;
 #endif
 
+    std::mutex m_oMutexReadThreadPool{};
+    std::unique_ptr<CPLWorkerThreadPool> m_poReadThreadPool{};
+
   public:
     VSIUnixStdioFilesystemHandler() = default;
 #ifdef VSI_COUNT_BYTES_READ
@@ -177,6 +193,7 @@ class VSIUnixStdioFilesystemHandler final : public VSIFilesystemHandler
     int SupportsSparseFiles(const char *pszPath) override;
 
     bool IsLocal(const char *pszPath) override;
+    int HasOptimizedReadMultiRange(const char * /* pszPath */) override;
     bool SupportsSequentialWrite(const char *pszPath,
                                  bool /* bAllowLocalTempFile */) override;
     bool SupportsRandomWrite(const char *pszPath,
@@ -197,6 +214,8 @@ class VSIUnixStdioFilesystemHandler final : public VSIFilesystemHandler
 #ifdef VSI_COUNT_BYTES_READ
     void AddToTotal(vsi_l_offset nBytes);
 #endif
+
+    CPLWorkerThreadPool *GetReadThreadPool(int nThreads);
 };
 
 /************************************************************************/
@@ -221,13 +240,16 @@ class VSIUnixStdioHandle final : public VSIVirtualHandle
     // file and thus a call to our Seek(0, SEEK_SET) before a read will be a
     // no-op.
     bool bModeAppendReadWrite = false;
+    VSIUnixStdioFilesystemHandler *poFS = nullptr;
+    // Only set in write mode, to invalidate the shared cache on Close()
+    std::string m_osFilename{};
 #ifdef VSI_COUNT_BYTES_READ
     vsi_l_offset nTotalBytesRead = 0;
-    VSIUnixStdioFilesystemHandler *poFS = nullptr;
 #endif
   public:
     VSIUnixStdioHandle(VSIUnixStdioFilesystemHandler *poFSIn, FILE *fpIn,
-                       bool bReadOnlyIn, bool bModeAppendReadWriteIn);
+                       bool bReadOnlyIn, bool bModeAppendReadWriteIn,
+                       const char *pszFilename);
 
     int Seek(vsi_l_offset nOffsetIn, int nWhence) override;
     vsi_l_offset Tell() override;
@@ -251,26 +273,30 @@ class VSIUnixStdioHandle final : public VSIVirtualHandle
     bool HasPRead() const override;
     size_t PRead(void * /*pBuffer*/, size_t /* nSize */,
                  vsi_l_offset /*nOffset*/) const override;
+    int ReadMultiRange(int nRanges, void **ppData,
+                       const vsi_l_offset *panOffsets,
+                       const size_t *panSizes) override;
 #endif
+    void AdviseRead(int nRanges, const vsi_l_offset *panOffsets,
+                    const size_t *panSizes) override;
 };
 
 /************************************************************************/
 /*                       VSIUnixStdioHandle()                           */
 /************************************************************************/
 
-VSIUnixStdioHandle::VSIUnixStdioHandle(
-#ifndef VSI_COUNT_BYTES_READ
-    CPL_UNUSED
-#endif
-        VSIUnixStdioFilesystemHandler *poFSIn,
-    FILE *fpIn, bool bReadOnlyIn, bool bModeAppendReadWriteIn)
+VSIUnixStdioHandle::VSIUnixStdioHandle(VSIUnixStdioFilesystemHandler *poFSIn,
+                                       FILE *fpIn, bool bReadOnlyIn,
+                                       bool bModeAppendReadWriteIn,
+                                       const char *pszFilename)
     : fp(fpIn), bReadOnly(bReadOnlyIn),
-      bModeAppendReadWrite(bModeAppendReadWriteIn)
-#ifdef VSI_COUNT_BYTES_READ
-      ,
-      poFS(poFSIn)
-#endif
+      bModeAppendReadWrite(bModeAppendReadWriteIn), poFS(poFSIn)
 {
+    if (!bReadOnly)
+    {
+        m_osFilename = pszFilename;
+        VSISharedCachedFileInvalidate(pszFilename);
+    }
 }
 
 /************************************************************************/
@@ -291,6 +317,8 @@ int VSIUnixStdioHandle::Close()
 
     int ret = fclose(fp);
     fp = nullptr;
+    if (!bReadOnly)
+        VSISharedCachedFileInvalidate(m_osFilename.c_str());
     return ret;
 }
 
@@ -686,8 +714,1135 @@ size_t VSIUnixStdioHandle::PRead(void *pBuffer, size_t nSize,
     return pread(fileno(fp), pBuffer, nSize, static_cast<off_t>(nOffset));
 #endif
 }
+
+/************************************************************************/
+/*                            PReadFully()                              */
+/************************************************************************/
+
+// Read exactly nSize bytes at nOffset, looping over short reads.
+static bool PReadFully(int fd, void *pBuffer, size_t nSize,
+                       vsi_l_offset nOffset)
+{
+    GByte *pabyBuffer = static_cast<GByte *>(pBuffer);
+    while (nSize > 0)
+    {
+#ifdef HAVE_PREAD64
+        const auto nRead = pread64(fd, pabyBuffer, nSize, nOffset);
+#else
+        const auto nRead =
+            pread(fd, pabyBuffer, nSize, static_cast<off_t>(nOffset));
+#endif
+        if (nRead < 0 && errno == EINTR)
+            continue;
+        if (nRead <= 0)
+            return false;
+        pabyBuffer += nRead;
+        nSize -= static_cast<size_t>(nRead);
+        nOffset += static_cast<vsi_l_offset>(nRead);
+    }
+    return true;
+}
+
+#ifdef HAVE_LINUX_IO_URING
+
+/************************************************************************/
+/* ==================================================================== */
+/*                            VSIIOUring                                */
+/* ==================================================================== */
+/************************************************************************/
+
+// Minimal io_uring instance, directly using the system calls, to submit a
+// batch of reads at once to the kernel without requiring liburing.
+// An instance is only used by a single thread.
+class VSIIOUring
+{
+    CPL_DISALLOW_COPY_ASSIGN(VSIIOUring)
+
+    int m_fd = -1;
+    unsigned m_nEntries = 0;
+    bool m_bBroken = false;
+
+    void *m_pSQRing = MAP_FAILED;
+    size_t m_nSQRingSize = 0;
+    void *m_pCQRing = MAP_FAILED;
+    size_t m_nCQRingSize = 0;
+    struct io_uring_sqe *m_pasSQE =
+        static_cast<struct io_uring_sqe *>(MAP_FAILED);
+    size_t m_nSQESize = 0;
+
+    unsigned *m_pnSQTail = nullptr;
+    unsigned *m_pnSQMask = nullptr;
+    unsigned *m_panSQArray = nullptr;
+    unsigned *m_pnCQHead = nullptr;
+    unsigned *m_pnCQTail = nullptr;
+    unsigned *m_pnCQMask = nullptr;
+    struct io_uring_cqe *m_pasCQE = nullptr;
+
+    bool Init(unsigned nEntries);
+    void Close();
+    unsigned ReapCompletions(std::vector<size_t> &anRead);
+
+  public:
+    VSIIOUring() = default;
+    ~VSIIOUring();
+
+    static VSIIOUring *GetForCurrentThread(unsigned nEntries);
+
+    bool ReadMultiRange(int fd, int nRanges, void **ppData,
+                        const vsi_l_offset *panOffsets,
+                        const size_t *panSizes);
+};
+
+/************************************************************************/
+/*                           ~VSIIOUring()                              */
+/************************************************************************/
+
+VSIIOUring::~VSIIOUring()
+{
+    Close();
+}
+
+/************************************************************************/
+/*                               Close()                                */
+/************************************************************************/
+
+// Must only be called when the kernel has no read in flight, as they refer
+// to buffers of the caller.
+void VSIIOUring::Close()
+{
+    if (m_pasSQE != MAP_FAILED)
+        munmap(m_pasSQE, m_nSQESize);
+    m_pasSQE = static_cast<struct io_uring_sqe *>(MAP_FAILED);
+    if (m_pCQRing != MAP_FAILED && m_pCQRing != m_pSQRing)
+        munmap(m_pCQRing, m_nCQRingSize);
+    m_pCQRing = MAP_FAILED;
+    if (m_pSQRing != MAP_FAILED)
+        munmap(m_pSQRing, m_nSQRingSize);
+    m_pSQRing = MAP_FAILED;
+    if (m_fd >= 0)
+        close(m_fd);
+    m_fd = -1;
+    // So that GetForCurrentThread() creates a new instance
+    m_bBroken = true;
+}
+
+/************************************************************************/
+/*                               Init()                                 */
+/************************************************************************/
+
+bool VSIIOUring::Init(unsigned nEntries)
+{
+    struct io_uring_params sParams;
+    memset(&sParams, 0, sizeof(sParams));
+    m_fd = static_cast<int>(syscall(__NR_io_uring_setup, nEntries, &sParams));
+    if (m_fd < 0)
+        return false;
+    m_nEntries = sParams.sq_entries;
+
+    m_nSQRingSize =
+        sParams.sq_off.array + sParams.sq_entries * sizeof(unsigned);
+    m_nCQRingSize =
+        sParams.cq_off.cqes + sParams.cq_entries * sizeof(struct io_uring_cqe);
+#ifdef IORING_FEAT_SINGLE_MMAP
+    const bool bSingleMMap = (sParams.features & IORING_FEAT_SINGLE_MMAP) != 0;
+#else
+    constexpr bool bSingleMMap = false;
+#endif
+    if (bSingleMMap)
+        m_nSQRingSize = std::max(m_nSQRingSize, m_nCQRingSize);
+
+    m_pSQRing = mmap(nullptr, m_nSQRingSize, PROT_READ | PROT_WRITE,
+                     MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_SQ_RING);
+    if (m_pSQRing == MAP_FAILED)
+        return false;
+    if (bSingleMMap)
+    {
+        m_pCQRing = m_pSQRing;
+    }
+    else
+    {
+        m_pCQRing = mmap(nullptr, m_nCQRingSize, PROT_READ | PROT_WRITE,
+                         MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_CQ_RING);
+        if (m_pCQRing == MAP_FAILED)
+            return false;
+    }
+    m_nSQESize = sParams.sq_entries * sizeof(struct io_uring_sqe);
+    m_pasSQE = static_cast<struct io_uring_sqe *>(
+        mmap(nullptr, m_nSQESize, PROT_READ | PROT_WRITE,
+             MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_SQES));
+    if (m_pasSQE == MAP_FAILED)
+        return false;
+
+    GByte *pabySQ = static_cast<GByte *>(m_pSQRing);
+    m_pnSQTail = reinterpret_cast<unsigned *>(pabySQ + sParams.sq_off.tail);
+    m_pnSQMask =
+        reinterpret_cast<unsigned *>(pabySQ + sParams.sq_off.ring_mask);
+    m_panSQArray = reinterpret_cast<unsigned *>(pabySQ + sParams.sq_off.array);
+    GByte *pabyCQ = static_cast<GByte *>(m_pCQRing);
+    m_pnCQHead = reinterpret_cast<unsigned *>(pabyCQ + sParams.cq_off.head);
+    m_pnCQTail = reinterpret_cast<unsigned *>(pabyCQ + sParams.cq_off.tail);
+    m_pnCQMask =
+        reinterpret_cast<unsigned *>(pabyCQ + sParams.cq_off.ring_mask);
+    m_pasCQE =
+        reinterpret_cast<struct io_uring_cqe *>(pabyCQ + sParams.cq_off.cqes);
+    return true;
+}
+
+/************************************************************************/
+/*                        GetForCurrentThread()                         */
+/************************************************************************/
+
+/** Return the io_uring instance of the current thread, or nullptr if
+ * io_uring is not available (old kernel, or disabled by a seccomp policy
+ * or the kernel.io_uring_disabled sysctl), or could not be set up. */
+VSIIOUring *VSIIOUring::GetForCurrentThread(unsigned nEntries)
+{
+    static std::atomic<bool> bUnavailable{false};
+    if (bUnavailable)
+        return nullptr;
+
+    thread_local std::unique_ptr<VSIIOUring> tlRing;
+    if (!tlRing || tlRing->m_bBroken || tlRing->m_nEntries < nEntries)
+    {
+        tlRing.reset();
+        auto poRing = std::make_unique<VSIIOUring>();
+        if (!poRing->Init(nEntries))
+        {
+            const int nErrno = errno;
+            // Only give up on io_uring for the whole process if it is not
+            // supported or not allowed. Other errors, like a lack of memory
+            // or of file descriptors, may be transient, so a new instance
+            // is tried on the next call.
+            if (nErrno == ENOSYS || nErrno == EPERM || nErrno == EACCES)
+            {
+                CPLDebug("VSI", "io_uring not available: %s",
+                         VSIStrerror(nErrno));
+                bUnavailable = true;
+            }
+            else
+            {
+                CPLDebug("VSI", "io_uring setup failed: %s",
+                         VSIStrerror(nErrno));
+            }
+            return nullptr;
+        }
+        tlRing = std::move(poRing);
+    }
+    return tlRing.get();
+}
+
+/************************************************************************/
+/*                          ReapCompletions()                           */
+/************************************************************************/
+
+// Take the available completions from the completion queue, and return
+// their number.
+unsigned VSIIOUring::ReapCompletions(std::vector<size_t> &anRead)
+{
+    unsigned nCount = 0;
+    unsigned nHead = *m_pnCQHead;
+    const unsigned nCQTail = __atomic_load_n(m_pnCQTail, __ATOMIC_ACQUIRE);
+    const unsigned nCQMask = *m_pnCQMask;
+    while (nHead != nCQTail)
+    {
+        const struct io_uring_cqe *psCQE = &m_pasCQE[nHead & nCQMask];
+        if (psCQE->res >= 0)
+            anRead[static_cast<size_t>(psCQE->user_data)] =
+                static_cast<size_t>(psCQE->res);
+        ++nHead;
+        ++nCount;
+    }
+    __atomic_store_n(m_pnCQHead, nHead, __ATOMIC_RELEASE);
+    return nCount;
+}
+
+/************************************************************************/
+/*                          ReadMultiRange()                            */
+/************************************************************************/
+
+bool VSIIOUring::ReadMultiRange(int fd, int nRanges, void **ppData,
+                                const vsi_l_offset *panOffsets,
+                                const size_t *panSizes)
+{
+    std::vector<struct iovec> asIOVec(nRanges);
+    std::vector<size_t> anRead(nRanges);
+    unsigned nQueued = 0;    // written in the submission queue
+    unsigned nConsumed = 0;  // taken from the submission queue by the kernel
+    unsigned nCompleted = 0;
+    const unsigned nRangesU = static_cast<unsigned>(nRanges);
+    bool bError = false;
+
+    while (nCompleted < nRangesU)
+    {
+        // Queue as many reads as there are free entries
+        unsigned nTail = *m_pnSQTail;
+        const unsigned nMask = *m_pnSQMask;
+        while (nQueued < nRangesU && nQueued - nCompleted < m_nEntries)
+        {
+            const unsigned nIdx = nTail & nMask;
+            asIOVec[nQueued].iov_base = ppData[nQueued];
+            asIOVec[nQueued].iov_len = panSizes[nQueued];
+            struct io_uring_sqe *psSQE = &m_pasSQE[nIdx];
+            memset(psSQE, 0, sizeof(*psSQE));
+            psSQE->opcode = IORING_OP_READV;
+            psSQE->fd = fd;
+            psSQE->off = panOffsets[nQueued];
+            psSQE->addr = reinterpret_cast<uintptr_t>(&asIOVec[nQueued]);
+            psSQE->len = 1;
+            psSQE->user_data = nQueued;
+            m_panSQArray[nIdx] = nIdx;
+            ++nTail;
+            ++nQueued;
+        }
+        __atomic_store_n(m_pnSQTail, nTail, __ATOMIC_RELEASE);
+
+        // Submit pending entries, and wait for at least one completion
+        const int nRet = static_cast<int>(
+            syscall(__NR_io_uring_enter, m_fd, nQueued - nConsumed, 1,
+                    IORING_ENTER_GETEVENTS, nullptr, 0));
+        if (nRet >= 0)
+        {
+            nConsumed += static_cast<unsigned>(nRet);
+        }
+        else if (errno != EINTR &&
+                 !((errno == EAGAIN || errno == EBUSY) &&
+                   nConsumed > nCompleted))
+        {
+            // EAGAIN and EBUSY are retried as long as there are reads in
+            // flight, whose completion frees resources.
+            bError = true;
+            break;
+        }
+
+        nCompleted += ReapCompletions(anRead);
+    }
+
+    if (bError)
+    {
+        CPLDebug("VSI", "io_uring_enter() failed: %s", VSIStrerror(errno));
+
+        // Wait for the reads already taken by the kernel, as they refer to
+        // our buffers. Completions are posted to the ring even if
+        // io_uring_enter() keeps failing.
+        while (nCompleted < nConsumed)
+        {
+            if (syscall(__NR_io_uring_enter, m_fd, 0, 1,
+                        IORING_ENTER_GETEVENTS, nullptr, 0) < 0 &&
+                errno != EINTR)
+            {
+                CPLSleep(0.001);
+            }
+            nCompleted += ReapCompletions(anRead);
+        }
+
+        // Entries still in the submission queue refer to our buffers too,
+        // so the ring must not be used anymore. The ranges not read are
+        // read synchronously below.
+        Close();
+    }
+
+    // Complete short reads, failed reads (they might have failed because of
+    // a transient condition), and reads not done by the ring, synchronously.
+    for (int i = 0; i < nRanges; ++i)
+    {
+        if (anRead[i] < panSizes[i] &&
+            !PReadFully(fd, static_cast<GByte *>(ppData[i]) + anRead[i],
+                        panSizes[i] - anRead[i], panOffsets[i] + anRead[i]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+#endif  // HAVE_LINUX_IO_URING
+
+/************************************************************************/
+/*                       GetLocalReadQueueDepth()                       */
+/************************************************************************/
+
+static int GetLocalReadQueueDepth()
+{
+    return std::max(
+        1, atoi(CPLGetConfigOption("CPL_VSIL_LOCAL_READ_QUEUE_DEPTH", "32")));
+}
+
+#ifdef HAVE_LINUX_IO_URING
+constexpr int MAX_RING_ENTRIES = 4096;
+#endif
+
+/************************************************************************/
+/*                          ReadMultiRange()                            */
+/************************************************************************/
+
+int VSIUnixStdioHandle::ReadMultiRange(int nRanges, void **ppData,
+                                       const vsi_l_offset *panOffsets,
+                                       const size_t *panSizes)
+{
+    // Buffered writes would not be seen by pread()
+    if (!bReadOnly)
+    {
+        return VSIVirtualHandle::ReadMultiRange(nRanges, ppData, panOffsets,
+                                                panSizes);
+    }
+
+    const int fd = fileno(fp);
+    const char *pszMethod =
+        CPLGetConfigOption("CPL_VSIL_LOCAL_READ_MULTI_RANGE", "AUTO");
+    if (nRanges <= 1 || EQUAL(pszMethod, "NO"))
+    {
+        for (int i = 0; i < nRanges; ++i)
+        {
+            if (!PReadFully(fd, ppData[i], panSizes[i], panOffsets[i]))
+                return -1;
+        }
+        return 0;
+    }
+
+    const int nQueueDepth = GetLocalReadQueueDepth();
+
+#ifdef HAVE_LINUX_IO_URING
+    if (!EQUAL(pszMethod, "THREADS"))
+    {
+        auto poRing = VSIIOUring::GetForCurrentThread(
+            static_cast<unsigned>(std::min(nQueueDepth, MAX_RING_ENTRIES)));
+        if (poRing)
+        {
+            return poRing->ReadMultiRange(fd, nRanges, ppData, panOffsets,
+                                          panSizes)
+                       ? 0
+                       : -1;
+        }
+    }
+#endif
+
+    // Fallback: dispatch the ranges over a pool of threads issuing pread()
+    auto poPool = poFS->GetReadThreadPool(nQueueDepth);
+    if (!poPool)
+    {
+        return VSIVirtualHandle::ReadMultiRange(nRanges, ppData, panOffsets,
+                                                panSizes);
+    }
+    const int nJobs = std::min(nRanges, nQueueDepth);
+    std::atomic<bool> bOK{true};
+    auto poQueue = poPool->CreateJobQueue();
+    for (int iJob = 0; iJob < nJobs; ++iJob)
+    {
+        poQueue->SubmitJob(
+            [fd, iJob, nJobs, nRanges, ppData, panOffsets, panSizes, &bOK]
+            {
+                for (int i = iJob; i < nRanges && bOK; i += nJobs)
+                {
+                    if (!PReadFully(fd, ppData[i], panSizes[i], panOffsets[i]))
+                        bOK = false;
+                }
+            });
+    }
+    poQueue->WaitCompletion();
+    return bOK ? 0 : -1;
+}
 #endif
 
+/************************************************************************/
+/*                             AdviseRead()                             */
+/************************************************************************/
+
+void VSIUnixStdioHandle::AdviseRead(
+#ifndef POSIX_FADV_WILLNEED
+    CPL_UNUSED
+#endif
+    int nRanges,
+#ifndef POSIX_FADV_WILLNEED
+    CPL_UNUSED
+#endif
+    const vsi_l_offset *panOffsets,
+#ifndef POSIX_FADV_WILLNEED
+    CPL_UNUSED
+#endif
+    const size_t *panSizes)
+{
+#ifdef POSIX_FADV_WILLNEED
+    // Let the kernel start reading the ranges asynchronously into the page
+    // cache, so that the subsequent reads, potentially issued from several
+    // threads, do not have to wait for the device one range at a time.
+    const int fd = fileno(fp);
+    for (int i = 0; i < nRanges; ++i)
+    {
+        posix_fadvise(fd, static_cast<off_t>(panOffsets[i]),
+                      static_cast<off_t>(panSizes[i]), POSIX_FADV_WILLNEED);
+    }
+#endif
+}
+
+#if defined(HAVE_PREAD64) && defined(O_DIRECT)
+#define HAVE_VSI_DIRECT_IO
+
+/************************************************************************/
+/* ==================================================================== */
+/*                        VSIUnixDirectIOHandle                         */
+/* ==================================================================== */
+/************************************************************************/
+
+// Handle on a file opened with O_DIRECT, so that reads and writes bypass the
+// page cache. O_DIRECT requires file offsets, transfer sizes and memory
+// buffers to be aligned on the logical block size of the device, so all I/O
+// goes through an aligned bounce buffer acting as a window on the file: it is
+// filled by reads, and accumulates writes until it is full or the file
+// position leaves it.
+
+class VSIUnixDirectIOHandle final : public VSIVirtualHandle
+{
+    CPL_DISALLOW_COPY_ASSIGN(VSIUnixDirectIOHandle)
+
+    // Large enough for the logical block size of all common devices
+    static constexpr size_t ALIGNMENT = 4096;
+    static constexpr size_t BUFFER_SIZE = 4 * 1024 * 1024;
+    // Minimum amount of data read when the buffer is refilled
+    static constexpr size_t MIN_READ_SIZE = 64 * 1024;
+
+    int m_fd = -1;
+    bool m_bReadOnly = true;
+    bool m_bAtEOF = false;
+    bool m_bError = false;
+    vsi_l_offset m_nOffset = 0;
+    // Size of the file, including pending writes
+    vsi_l_offset m_nFileSize = 0;
+    // Size of the file on disk
+    vsi_l_offset m_nDiskSize = 0;
+
+    // BUFFER_SIZE bytes, followed by ALIGNMENT scratch bytes
+    GByte *m_pabyBuffer = nullptr;
+    // File offset of the start of the buffer. Always aligned.
+    vsi_l_offset m_nBufferOffset = 0;
+    // Number of bytes, from the start of the buffer, that match the file
+    // content on disk.
+    size_t m_nBufferValid = 0;
+    // Range of the buffer modified by pending writes
+    size_t m_nDirtyStart = 0;
+    size_t m_nDirtyEnd = 0;
+    // Only set in write mode, to invalidate the shared cache on Close()
+    std::string m_osFilename{};
+
+    VSIUnixDirectIOHandle(int fd, bool bReadOnly, vsi_l_offset nFileSize,
+                          const char *pszFilename)
+        : m_fd(fd), m_bReadOnly(bReadOnly), m_nFileSize(nFileSize),
+          m_nDiskSize(nFileSize)
+    {
+        if (!m_bReadOnly)
+        {
+            m_osFilename = pszFilename;
+            VSISharedCachedFileInvalidate(pszFilename);
+        }
+    }
+
+    static size_t AlignDown(size_t nVal)
+    {
+        return nVal & ~(ALIGNMENT - 1);
+    }
+
+    static size_t AlignUp(size_t nVal)
+    {
+        return AlignDown(nVal + ALIGNMENT - 1);
+    }
+
+    bool AllocBuffer();
+    size_t GetKnownBytesAt(size_t nPosInBuffer) const;
+    bool ReadBlockInto(size_t nPosInBuffer, size_t nStart, size_t nEnd);
+    bool FlushBuffer();
+    ssize_t AlignedPRead(GByte *pabyData, size_t nSize,
+                         vsi_l_offset nOffset) const;
+    bool AlignedPWrite(const GByte *pabyData, size_t nSize,
+                       vsi_l_offset nOffset);
+    bool DisableDirectIO() const;
+
+  public:
+    ~VSIUnixDirectIOHandle() override;
+
+    static VSIUnixDirectIOHandle *Open(const char *pszFilename,
+                                       const char *pszAccess);
+
+    int Seek(vsi_l_offset nOffsetIn, int nWhence) override;
+    vsi_l_offset Tell() override;
+    size_t Read(void *pBuffer, size_t nSize, size_t nMemb) override;
+    size_t Write(const void *pBuffer, size_t nSize, size_t nMemb) override;
+    void ClearErr() override;
+    int Eof() override;
+    int Error() override;
+    int Flush() override;
+    int Close() override;
+    int Truncate(vsi_l_offset nNewSize) override;
+
+    bool HasPRead() const override
+    {
+        // In update mode, pending writes of the buffer would not be seen
+        return m_bReadOnly;
+    }
+
+    size_t PRead(void *pBuffer, size_t nSize,
+                 vsi_l_offset nOffset) const override;
+
+    void *GetNativeFileDescriptor() override
+    {
+        // Make sure that users of the descriptor see pending writes
+        FlushBuffer();
+        return reinterpret_cast<void *>(static_cast<uintptr_t>(m_fd));
+    }
+};
+
+/************************************************************************/
+/*                               Open()                                 */
+/************************************************************************/
+
+VSIUnixDirectIOHandle *VSIUnixDirectIOHandle::Open(const char *pszFilename,
+                                                   const char *pszAccess)
+{
+    const bool bReadOnly =
+        pszAccess[0] == 'r' && strchr(pszAccess, '+') == nullptr;
+    // Write-only modes are opened in read-write mode, since blocks partially
+    // written must be read back.
+    int nFlags = O_DIRECT | (bReadOnly ? O_RDONLY : O_RDWR);
+    if (pszAccess[0] == 'w')
+        nFlags |= O_CREAT | O_TRUNC;
+
+    const int fd = open64(pszFilename, nFlags, 0666);
+    if (fd < 0)
+        return nullptr;
+
+    const off64_t nFileSize = lseek64(fd, 0, SEEK_END);
+    if (nFileSize < 0)
+    {
+        const int nError = errno;
+        close(fd);
+        errno = nError;
+        return nullptr;
+    }
+
+    return new (std::nothrow) VSIUnixDirectIOHandle(
+        fd, bReadOnly, static_cast<vsi_l_offset>(nFileSize), pszFilename);
+}
+
+/************************************************************************/
+/*                       ~VSIUnixDirectIOHandle()                       */
+/************************************************************************/
+
+VSIUnixDirectIOHandle::~VSIUnixDirectIOHandle()
+{
+    VSIUnixDirectIOHandle::Close();
+}
+
+/************************************************************************/
+/*                               Close()                                */
+/************************************************************************/
+
+int VSIUnixDirectIOHandle::Close()
+{
+    if (m_fd < 0)
+        return 0;
+
+    const bool bOK = FlushBuffer();
+    VSIFreeAligned(m_pabyBuffer);
+    m_pabyBuffer = nullptr;
+    const int ret = close(m_fd);
+    m_fd = -1;
+    if (!m_bReadOnly)
+        VSISharedCachedFileInvalidate(m_osFilename.c_str());
+    return bOK ? ret : -1;
+}
+
+/************************************************************************/
+/*                           AllocBuffer()                              */
+/************************************************************************/
+
+bool VSIUnixDirectIOHandle::AllocBuffer()
+{
+    if (!m_pabyBuffer)
+    {
+        m_pabyBuffer = static_cast<GByte *>(
+            VSIMallocAligned(ALIGNMENT, BUFFER_SIZE + ALIGNMENT));
+        if (!m_pabyBuffer)
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "Cannot allocate direct I/O buffer");
+        }
+    }
+    return m_pabyBuffer != nullptr;
+}
+
+/************************************************************************/
+/*                          DisableDirectIO()                           */
+/************************************************************************/
+
+// Some file systems accept O_DIRECT at open time, but reject transfers with
+// our alignment. Rather than failing, go on through the page cache.
+bool VSIUnixDirectIOHandle::DisableDirectIO() const
+{
+    const int nFlags = fcntl(m_fd, F_GETFL);
+    if (nFlags < 0 || (nFlags & O_DIRECT) == 0 ||
+        fcntl(m_fd, F_SETFL, nFlags & ~O_DIRECT) != 0)
+    {
+        return false;
+    }
+    CPLDebug("VSI", "O_DIRECT transfer rejected. Disabling direct I/O");
+    return true;
+}
+
+/************************************************************************/
+/*                           AlignedPRead()                             */
+/************************************************************************/
+
+// Returns the number of bytes read, which is lower than nSize at end of
+// file, or -1 in case of error.
+ssize_t VSIUnixDirectIOHandle::AlignedPRead(GByte *pabyData, size_t nSize,
+                                            vsi_l_offset nOffset) const
+{
+    size_t nTotal = 0;
+    while (nTotal < nSize)
+    {
+        const ssize_t nRead =
+            pread64(m_fd, pabyData + nTotal, nSize - nTotal,
+                    static_cast<off64_t>(nOffset + nTotal));
+        if (nRead < 0)
+        {
+            if (errno == EINTR || (errno == EINVAL && DisableDirectIO()))
+                continue;
+            return -1;
+        }
+        if (nRead == 0)
+            break;
+        nTotal += static_cast<size_t>(nRead);
+        // A short read can only happen at end of file, or at least leave
+        // us unaligned.
+        if ((nTotal % ALIGNMENT) != 0)
+            break;
+    }
+    return static_cast<ssize_t>(nTotal);
+}
+
+/************************************************************************/
+/*                          AlignedPWrite()                             */
+/************************************************************************/
+
+bool VSIUnixDirectIOHandle::AlignedPWrite(const GByte *pabyData, size_t nSize,
+                                          vsi_l_offset nOffset)
+{
+    size_t nTotal = 0;
+    while (nTotal < nSize)
+    {
+        const ssize_t nWritten =
+            pwrite64(m_fd, pabyData + nTotal, nSize - nTotal,
+                     static_cast<off64_t>(nOffset + nTotal));
+        if (nWritten < 0)
+        {
+            if (errno == EINTR || (errno == EINVAL && DisableDirectIO()))
+                continue;
+            return false;
+        }
+        if (nWritten == 0)
+            return false;
+        nTotal += static_cast<size_t>(nWritten);
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                          GetKnownBytesAt()                           */
+/************************************************************************/
+
+// Returns the number of consecutive bytes, starting at nPosInBuffer, whose
+// content is known from the buffer.
+size_t VSIUnixDirectIOHandle::GetKnownBytesAt(size_t nPosInBuffer) const
+{
+    const bool bHasDirty = m_nDirtyEnd > m_nDirtyStart;
+    if (nPosInBuffer < m_nBufferValid)
+    {
+        size_t nEnd = m_nBufferValid;
+        if (bHasDirty && m_nDirtyStart <= m_nBufferValid)
+            nEnd = std::max(nEnd, m_nDirtyEnd);
+        return nEnd - nPosInBuffer;
+    }
+    if (bHasDirty && nPosInBuffer >= m_nDirtyStart &&
+        nPosInBuffer < m_nDirtyEnd)
+    {
+        return m_nDirtyEnd - nPosInBuffer;
+    }
+    return 0;
+}
+
+/************************************************************************/
+/*                           ReadBlockInto()                            */
+/************************************************************************/
+
+// Fill [nStart, nEnd) of the buffer, which must be within the aligned block
+// starting at nPosInBuffer, with the content of the file, or zeroes beyond
+// its end.
+bool VSIUnixDirectIOHandle::ReadBlockInto(size_t nPosInBuffer, size_t nStart,
+                                          size_t nEnd)
+{
+    GByte *pabyScratch = m_pabyBuffer + BUFFER_SIZE;
+    size_t nRead = 0;
+    if (m_nBufferOffset + nPosInBuffer < m_nDiskSize)
+    {
+        const ssize_t nRet = AlignedPRead(pabyScratch, ALIGNMENT,
+                                          m_nBufferOffset + nPosInBuffer);
+        if (nRet < 0)
+            return false;
+        nRead = static_cast<size_t>(nRet);
+    }
+    memset(pabyScratch + nRead, 0, ALIGNMENT - nRead);
+    memcpy(m_pabyBuffer + nStart, pabyScratch + (nStart - nPosInBuffer),
+           nEnd - nStart);
+    return true;
+}
+
+/************************************************************************/
+/*                            FlushBuffer()                             */
+/************************************************************************/
+
+bool VSIUnixDirectIOHandle::FlushBuffer()
+{
+    if (m_nDirtyEnd <= m_nDirtyStart)
+        return true;
+
+    // Complete the partially written blocks at both ends of the dirty range
+    const size_t nStart = AlignDown(m_nDirtyStart);
+    const size_t nEnd = AlignUp(m_nDirtyEnd);
+    bool bOK = true;
+    if (nStart < m_nDirtyStart && m_nDirtyStart > m_nBufferValid)
+        bOK = ReadBlockInto(nStart, nStart, m_nDirtyStart);
+    if (bOK && m_nDirtyEnd < nEnd && nEnd > m_nBufferValid)
+        bOK = ReadBlockInto(nEnd - ALIGNMENT, m_nDirtyEnd, nEnd);
+
+    bOK = bOK && AlignedPWrite(m_pabyBuffer + nStart, nEnd - nStart,
+                               m_nBufferOffset + nStart);
+    // Remove the padding of the last block
+    if (bOK && m_nBufferOffset + nEnd > m_nFileSize)
+    {
+        bOK = ftruncate64(m_fd, static_cast<off64_t>(m_nFileSize)) == 0;
+    }
+
+    if (bOK)
+    {
+        m_nDiskSize = std::max(m_nDiskSize, m_nBufferOffset + m_nDirtyEnd);
+        if (nStart <= m_nBufferValid)
+            m_nBufferValid = std::max(m_nBufferValid, nEnd);
+    }
+    else
+    {
+        m_bError = true;
+        m_nBufferValid = 0;
+    }
+    m_nDirtyStart = 0;
+    m_nDirtyEnd = 0;
+    return bOK;
+}
+
+/************************************************************************/
+/*                                Seek()                                */
+/************************************************************************/
+
+int VSIUnixDirectIOHandle::Seek(vsi_l_offset nOffsetIn, int nWhence)
+{
+    m_bAtEOF = false;
+    if (nWhence == SEEK_SET)
+        m_nOffset = nOffsetIn;
+    else if (nWhence == SEEK_CUR)
+        m_nOffset += nOffsetIn;
+    else if (nWhence == SEEK_END)
+        m_nOffset = m_nFileSize + nOffsetIn;
+    else
+    {
+        errno = EINVAL;
+        return -1;
+    }
+    return 0;
+}
+
+/************************************************************************/
+/*                                Tell()                                */
+/************************************************************************/
+
+vsi_l_offset VSIUnixDirectIOHandle::Tell()
+{
+    return m_nOffset;
+}
+
+/************************************************************************/
+/*                                Read()                                */
+/************************************************************************/
+
+size_t VSIUnixDirectIOHandle::Read(void *pBuffer, size_t nSize, size_t nCount)
+{
+    if (nSize == 0 || nCount == 0)
+        return 0;
+    if (!AllocBuffer())
+    {
+        m_bError = true;
+        return 0;
+    }
+
+    GByte *pabyDst = static_cast<GByte *>(pBuffer);
+    const size_t nToRead = nSize * nCount;
+    size_t nDone = 0;
+    while (nDone < nToRead)
+    {
+        if (m_nOffset >= m_nFileSize)
+        {
+            m_bAtEOF = true;
+            break;
+        }
+        const size_t nRemaining = static_cast<size_t>(std::min<vsi_l_offset>(
+            nToRead - nDone, m_nFileSize - m_nOffset));
+
+        // Serve from the buffer if possible
+        if (m_nOffset >= m_nBufferOffset &&
+            m_nOffset < m_nBufferOffset + BUFFER_SIZE)
+        {
+            const size_t nPosInBuffer =
+                static_cast<size_t>(m_nOffset - m_nBufferOffset);
+            const size_t nKnown = GetKnownBytesAt(nPosInBuffer);
+            if (nKnown > 0)
+            {
+                const size_t nChunk = std::min(nKnown, nRemaining);
+                memcpy(pabyDst + nDone, m_pabyBuffer + nPosInBuffer, nChunk);
+                nDone += nChunk;
+                m_nOffset += nChunk;
+                continue;
+            }
+        }
+
+        if (!FlushBuffer())
+            break;
+
+        // Large aligned reads go directly to the destination buffer
+        if (nRemaining >= BUFFER_SIZE && (m_nOffset % ALIGNMENT) == 0 &&
+            (reinterpret_cast<uintptr_t>(pabyDst + nDone) % ALIGNMENT) == 0)
+        {
+            const size_t nChunk = AlignDown(nRemaining);
+            const ssize_t nRead =
+                AlignedPRead(pabyDst + nDone, nChunk, m_nOffset);
+            if (nRead <= 0)
+            {
+                m_bError = nRead < 0;
+                m_bAtEOF = nRead == 0;
+                break;
+            }
+            nDone += static_cast<size_t>(nRead);
+            m_nOffset += static_cast<size_t>(nRead);
+            continue;
+        }
+
+        // Refill the buffer
+        const vsi_l_offset nBufferOffset =
+            m_nOffset - (m_nOffset % ALIGNMENT);
+        const size_t nPosInBuffer =
+            static_cast<size_t>(m_nOffset - nBufferOffset);
+        const size_t nLoad = std::min(
+            BUFFER_SIZE, AlignUp(std::max(MIN_READ_SIZE,
+                                          nPosInBuffer + nRemaining)));
+        m_nBufferOffset = nBufferOffset;
+        const ssize_t nRead =
+            AlignedPRead(m_pabyBuffer, nLoad, m_nBufferOffset);
+        m_nBufferValid = nRead > 0 ? static_cast<size_t>(nRead) : 0;
+        if (m_nBufferValid <= nPosInBuffer)
+        {
+            m_bError = nRead < 0;
+            m_bAtEOF = nRead >= 0;
+            break;
+        }
+    }
+
+    return nDone / nSize;
+}
+
+/************************************************************************/
+/*                               PRead()                                */
+/************************************************************************/
+
+// Only used in read-only mode, where the file on disk is authoritative. It
+// does not use the shared buffer, so that concurrent callers do not need to
+// synchronize.
+size_t VSIUnixDirectIOHandle::PRead(void *pBuffer, size_t nSize,
+                                    vsi_l_offset nOffset) const
+{
+    if (nSize == 0 || nOffset >= m_nFileSize)
+        return 0;
+    nSize = static_cast<size_t>(
+        std::min<vsi_l_offset>(nSize, m_nFileSize - nOffset));
+
+    GByte *pabyDst = static_cast<GByte *>(pBuffer);
+    GByte *pabyBounce = nullptr;
+    size_t nBounceSize = 0;
+    size_t nDone = 0;
+    while (nDone < nSize)
+    {
+        const vsi_l_offset nCurOffset = nOffset + nDone;
+        const size_t nRemaining = nSize - nDone;
+
+        // Aligned reads go directly to the destination buffer
+        if ((nCurOffset % ALIGNMENT) == 0 && nRemaining >= ALIGNMENT &&
+            (reinterpret_cast<uintptr_t>(pabyDst + nDone) % ALIGNMENT) == 0)
+        {
+            const size_t nChunk = AlignDown(nRemaining);
+            const ssize_t nRead =
+                AlignedPRead(pabyDst + nDone, nChunk, nCurOffset);
+            if (nRead <= 0)
+                break;
+            nDone += static_cast<size_t>(nRead);
+            if (static_cast<size_t>(nRead) < nChunk)
+                break;
+            continue;
+        }
+
+        if (!pabyBounce)
+        {
+            nBounceSize =
+                std::min(BUFFER_SIZE, AlignUp(nRemaining + ALIGNMENT));
+            pabyBounce = static_cast<GByte *>(
+                VSIMallocAligned(ALIGNMENT, nBounceSize));
+            if (!pabyBounce)
+            {
+                CPLError(CE_Failure, CPLE_OutOfMemory,
+                         "Cannot allocate direct I/O buffer");
+                break;
+            }
+        }
+
+        const size_t nSkip = static_cast<size_t>(nCurOffset % ALIGNMENT);
+        const size_t nLoad =
+            std::min(nBounceSize, AlignUp(nSkip + nRemaining));
+        const ssize_t nRead =
+            AlignedPRead(pabyBounce, nLoad, nCurOffset - nSkip);
+        if (nRead <= 0 || static_cast<size_t>(nRead) <= nSkip)
+            break;
+        const size_t nChunk =
+            std::min(static_cast<size_t>(nRead) - nSkip, nRemaining);
+        memcpy(pabyDst + nDone, pabyBounce + nSkip, nChunk);
+        nDone += nChunk;
+        if (static_cast<size_t>(nRead) < nLoad)
+            break;
+    }
+
+    VSIFreeAligned(pabyBounce);
+    return nDone;
+}
+
+/************************************************************************/
+/*                               Write()                                */
+/************************************************************************/
+
+size_t VSIUnixDirectIOHandle::Write(const void *pBuffer, size_t nSize,
+                                    size_t nCount)
+{
+    if (nSize == 0 || nCount == 0)
+        return 0;
+    if (m_bReadOnly || !AllocBuffer())
+    {
+        m_bError = true;
+        return 0;
+    }
+
+    const GByte *pabySrc = static_cast<const GByte *>(pBuffer);
+    const size_t nToWrite = nSize * nCount;
+    size_t nDone = 0;
+    while (nDone < nToWrite)
+    {
+        // The dirty range must remain contiguous
+        const bool bInBuffer = m_nOffset >= m_nBufferOffset &&
+                               m_nOffset < m_nBufferOffset + BUFFER_SIZE;
+        size_t nPosInBuffer =
+            bInBuffer ? static_cast<size_t>(m_nOffset - m_nBufferOffset) : 0;
+        const bool bHasDirty = m_nDirtyEnd > m_nDirtyStart;
+        if (!bInBuffer ||
+            (bHasDirty && (nPosInBuffer > m_nDirtyEnd ||
+                           nPosInBuffer + (nToWrite - nDone) < m_nDirtyStart)))
+        {
+            if (!FlushBuffer())
+                break;
+            if (!bInBuffer)
+            {
+                m_nBufferOffset = m_nOffset - (m_nOffset % ALIGNMENT);
+                m_nBufferValid = 0;
+                nPosInBuffer = static_cast<size_t>(m_nOffset - m_nBufferOffset);
+            }
+        }
+
+        const size_t nChunk =
+            std::min(nToWrite - nDone, BUFFER_SIZE - nPosInBuffer);
+        memcpy(m_pabyBuffer + nPosInBuffer, pabySrc + nDone, nChunk);
+        if (m_nDirtyEnd > m_nDirtyStart)
+        {
+            m_nDirtyStart = std::min(m_nDirtyStart, nPosInBuffer);
+            m_nDirtyEnd = std::max(m_nDirtyEnd, nPosInBuffer + nChunk);
+        }
+        else
+        {
+            m_nDirtyStart = nPosInBuffer;
+            m_nDirtyEnd = nPosInBuffer + nChunk;
+        }
+        nDone += nChunk;
+        m_nOffset += nChunk;
+        m_nFileSize = std::max(m_nFileSize, m_nOffset);
+    }
+
+    return nDone / nSize;
+}
+
+/************************************************************************/
+/*                               Flush()                                */
+/************************************************************************/
+
+int VSIUnixDirectIOHandle::Flush()
+{
+    return FlushBuffer() ? 0 : -1;
+}
+
+/************************************************************************/
+/*                             Truncate()                               */
+/************************************************************************/
+
+int VSIUnixDirectIOHandle::Truncate(vsi_l_offset nNewSize)
+{
+    if (!FlushBuffer())
+        return -1;
+    if (ftruncate64(m_fd, static_cast<off64_t>(nNewSize)) != 0)
+        return -1;
+    m_nFileSize = nNewSize;
+    m_nDiskSize = nNewSize;
+    // The buffer may contain data beyond the new end of file
+    m_nBufferValid = 0;
+    return 0;
+}
+
+/************************************************************************/
+/*                             ClearErr()                               */
+/************************************************************************/
+
+void VSIUnixDirectIOHandle::ClearErr()
+{
+    m_bAtEOF = false;
+    m_bError = false;
+}
+
+/************************************************************************/
+/*                              Error()                                 */
+/************************************************************************/
+
+int VSIUnixDirectIOHandle::Error()
+{
+    return m_bError ? TRUE : FALSE;
+}
+
+/************************************************************************/
+/*                                Eof()                                 */
+/************************************************************************/
+
+int VSIUnixDirectIOHandle::Eof()
+{
+    return m_bAtEOF ? TRUE : FALSE;
+}
+
+#endif  // defined(HAVE_PREAD64) && defined(O_DIRECT)
+
 /************************************************************************/
 /* ==================================================================== */
 /*                       VSIUnixStdioFilesystemHandler                  */
@@ -719,9 +1874,46 @@ VSIUnixStdioFilesystemHandler::~VSIUnixStdioFilesystemHandler()
 VSIVirtualHandle *
 VSIUnixStdioFilesystemHandler::Open(const char *pszFilename,
                                     const char *pszAccess, bool bSetError,
-                                    CSLConstList /* papszOptions */)
+                                    CSLConstList papszOptions)
 
 {
+#ifdef HAVE_VSI_DIRECT_IO
+    // Append modes rely on O_APPEND semantics that do not combine well with
+    // the bounce buffer, and are thus always buffered.
+    if (pszAccess[0] != 'a' &&
+        CPLTestBool(CSLFetchNameValueDef(
+            papszOptions, "DIRECT_IO",
+            CPLGetConfigOption("CPL_VSIL_LOCAL_DIRECT_IO", "NO"))))
+    {
+        VSIVirtualHandle *poHandle =
+            VSIUnixDirectIOHandle::Open(pszFilename, pszAccess);
+        const int nError = errno;
+        VSIDebug3("VSIUnixDirectIOHandle::Open(\"%s\",\"%s\") = %p",
+                  pszFilename, pszAccess, poHandle);
+        if (poHandle)
+        {
+            CPLDebug("VSI", "%s: using direct I/O", pszFilename);
+            return poHandle;
+        }
+        // EINVAL is returned by file systems not supporting O_DIRECT, such
+        // as tmpfs.
+        if (nError != EINVAL)
+        {
+            if (bSetError)
+            {
+                VSIError(VSIE_FileError, "%s: %s", pszFilename,
+                         strerror(nError));
+            }
+            errno = nError;
+            return nullptr;
+        }
+        CPLDebug("VSI", "%s: O_DIRECT not supported. Using buffered I/O",
+                 pszFilename);
+    }
+#else
+    CPL_IGNORE_RET_VAL(papszOptions);
+#endif
+
     FILE *fp = VSI_FOPEN64(pszFilename, pszAccess);
     const int nError = errno;
 
@@ -743,7 +1935,8 @@ VSIUnixStdioFilesystemHandler::Open(const char *pszFilename,
     const bool bModeAppendReadWrite =
         strcmp(pszAccess, "a+b") == 0 || strcmp(pszAccess, "a+") == 0;
     VSIUnixStdioHandle *poHandle = new (std::nothrow)
-        VSIUnixStdioHandle(this, fp, bReadOnly, bModeAppendReadWrite);
+        VSIUnixStdioHandle(this, fp, bReadOnly, bModeAppendReadWrite,
+                           pszFilename);
     if (poHandle == nullptr)
     {
         fclose(fp);
@@ -756,9 +1949,13 @@ VSIUnixStdioFilesystemHandler::Open(const char *pszFilename,
     /*      If VSI_CACHE is set we want to use a cached reader instead      */
     /*      of more direct io on the underlying file.                       */
     /* -------------------------------------------------------------------- */
-    if (bReadOnly && CPLTestBool(CPLGetConfigOption("VSI_CACHE", "FALSE")))
+    if (bReadOnly)
     {
-        return VSICreateCachedFile(poHandle);
+        const char *pszVSICache = CPLGetConfigOption("VSI_CACHE", "FALSE");
+        if (EQUAL(pszVSICache, "SHARED"))
+            return VSICreateSharedCachedFile(poHandle, pszFilename);
+        if (CPLTestBool(pszVSICache))
+            return VSICreateCachedFile(poHandle);
     }
 
     return poHandle;
@@ -1218,6 +2415,53 @@ begin:
     return nullptr;
 }
 
+/************************************************************************/
+/*                     HasOptimizedReadMultiRange()                     */
+/************************************************************************/
+
+int VSIUnixStdioFilesystemHandler::HasOptimizedReadMultiRange(const char *)
+{
+#if defined(HAVE_PREAD64) || (defined(HAVE_PREAD_BSD) && SIZEOF_OFF_T == 8)
+    const char *pszMethod =
+        CPLGetConfigOption("CPL_VSIL_LOCAL_READ_MULTI_RANGE", "AUTO");
+    if (EQUAL(pszMethod, "IO_URING") || EQUAL(pszMethod, "THREADS"))
+        return TRUE;
+#ifdef HAVE_LINUX_IO_URING
+    // By default, only when the reads are batched by the kernel: callers,
+    // like the GTiff driver, then read all needed blocks at once, at the
+    // expense of an extra copy, which a pool of threads does not make up
+    // for when the file is in the page cache.
+    if (EQUAL(pszMethod, "AUTO"))
+    {
+        return VSIIOUring::GetForCurrentThread(static_cast<unsigned>(
+                   std::min(GetLocalReadQueueDepth(), MAX_RING_ENTRIES))) !=
+               nullptr;
+    }
+#endif
+#endif
+    return FALSE;
+}
+
+/************************************************************************/
+/*                         GetReadThreadPool()                          */
+/************************************************************************/
+
+// Return the pool of threads used by VSIUnixStdioHandle::ReadMultiRange()
+// when io_uring is not available.
+CPLWorkerThreadPool *
+VSIUnixStdioFilesystemHandler::GetReadThreadPool(int nThreads)
+{
+    std::lock_guard<std::mutex> oLock(m_oMutexReadThreadPool);
+    if (!m_poReadThreadPool)
+    {
+        auto poPool = std::make_unique<CPLWorkerThreadPool>();
+        if (!poPool->Setup(nThreads, nullptr, nullptr, false))
+            return nullptr;
+        m_poReadThreadPool = std::move(poPool);
+    }
+    return m_poReadThreadPool.get();
+}
+
 #ifdef VSI_COUNT_BYTES_READ
 /************************************************************************/
 /*                            AddToTotal()                              */
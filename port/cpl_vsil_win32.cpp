@@ -107,6 +107,8 @@ class VSIWin32Handle final : public VSIVirtualHandle
     bool bEOF = false;
     bool bError = false;
     bool m_bWriteThrough = false;
+    // Only set in write mode, to invalidate the shared cache on Close()
+    std::string m_osFilename{};
 
     VSIWin32Handle() = default;
 
@@ -242,6 +244,8 @@ int VSIWin32Handle::Close()
         return 0;
     int ret = CloseHandle(hFile) ? 0 : -1;
     hFile = nullptr;
+    if (!m_osFilename.empty())
+        VSISharedCachedFileInvalidate(m_osFilename.c_str());
     return ret;
 }
 
@@ -857,6 +861,11 @@ VSIVirtualHandle *VSIWin32FilesystemHandler::Open(const char *pszFilename,
 
     poHandle->hFile = hFile;
     poHandle->m_bWriteThrough = bWriteThrough;
+    if (!EQUAL(pszAccess, "r") && !EQUAL(pszAccess, "rb"))
+    {
+        poHandle->m_osFilename = pszFilename;
+        VSISharedCachedFileInvalidate(pszFilename);
+    }
 
     if (strchr(pszAccess, 'a') != nullptr)
         poHandle->Seek(0, SEEK_END);
@@ -865,8 +874,14 @@ VSIVirtualHandle *VSIWin32FilesystemHandler::Open(const char *pszFilename,
     /*      If VSI_CACHE is set we want to use a cached reader instead      */
     /*      of more direct io on the underlying file.                       */
     /* -------------------------------------------------------------------- */
+    const char *pszVSICache = CPLGetConfigOption("VSI_CACHE", "FALSE");
     if ((EQUAL(pszAccess, "r") || EQUAL(pszAccess, "rb")) &&
-        CPLTestBool(CPLGetConfigOption("VSI_CACHE", "FALSE")))
+        EQUAL(pszVSICache, "SHARED"))
+    {
+        return VSICreateSharedCachedFile(poHandle, pszFilename);
+    }
+    else if ((EQUAL(pszAccess, "r") || EQUAL(pszAccess, "rb")) &&
+             CPLTestBool(pszVSICache))
     {
         return VSICreateCachedFile(poHandle);
     }
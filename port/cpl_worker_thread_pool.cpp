@@ -13,6 +13,7 @@
 #include "cpl_port.h"
 #include "cpl_worker_thread_pool.h"
 
+#include <algorithm>
 #include <cstddef>
 #include <memory>
 
@@ -22,6 +23,29 @@
 
 static thread_local CPLWorkerThreadPool *threadLocalCurrentThreadPool = nullptr;
 
+// Scheduling overview:
+//
+// Each worker thread owns a queue of jobs. A job is preferably handed to a
+// waiting (idle) thread, or to a new thread if the pool has not reached its
+// maximum number of threads, or otherwise queued to the busy threads in a
+// round-robin way. A thread runs the jobs of its own queue in FIFO order, and
+// when it is empty, steals jobs from the back of the queue of the other
+// threads, before going to sleep.
+//
+// So, contrary to a single job queue, fetching a job and declaring it as
+// finished do not involve any pool-wide lock, which matters when jobs are
+// short. Neither does submitting a job once all threads have been started
+// and are busy, which is the common case when many jobs are submitted: the
+// job is then queued with only the mutex of the queue of the target thread.
+// A thread that is about to wait registers itself as waiting before checking
+// for queued jobs, and a job submitter checks for waiting threads after
+// having queued its job, so that at least one of them sees the other.
+//
+// A job submitted from a worker thread of the pool is only queued if a
+// waiting thread, or a new thread, can take it. Otherwise it is run
+// synchronously, so that a job can submit sub-jobs and wait for them
+// without deadlocking the pool.
+
 /************************************************************************/
 /*                         CPLWorkerThreadPool()                        */
 /************************************************************************/
@@ -31,15 +55,13 @@ static thread_local CPLWorkerThreadPool *threadLocalCurrentThreadPool = nullptr;
  * The pool is in an uninitialized state after this call. The Setup() method
  * must be called.
  */
-CPLWorkerThreadPool::CPLWorkerThreadPool() : jobQueue{}
-{
-}
+CPLWorkerThreadPool::CPLWorkerThreadPool() = default;
 
 /** Instantiate a new pool of worker threads.
  *
  * \param nThreads  Number of threads in the pool.
  */
-CPLWorkerThreadPool::CPLWorkerThreadPool(int nThreads) : jobQueue{}
+CPLWorkerThreadPool::CPLWorkerThreadPool(int nThreads)
 {
     Setup(nThreads, nullptr, nullptr);
 }
@@ -69,8 +91,6 @@ CPLWorkerThreadPool::~CPLWorkerThreadPool()
         }
         CPLJoinThread(wt->hThread);
     }
-
-    CPLListDestroy(psWaitingWorkerThreadsList);
 }
 
 /************************************************************************/
@@ -111,6 +131,141 @@ void CPLWorkerThreadPool::WorkerThreadFunction(void *user_data)
     }
 }
 
+/************************************************************************/
+/*                         StartWorkerThread()                          */
+/************************************************************************/
+
+// Must be called with m_mutex held.
+CPLWorkerThread *
+CPLWorkerThreadPool::StartWorkerThread(CPLThreadFunc pfnInitFunc,
+                                       void *pInitData)
+{
+    auto wt = std::make_unique<CPLWorkerThread>();
+    wt->pfnInitFunc = pfnInitFunc;
+    wt->pInitData = pInitData;
+    wt->poTP = this;
+    wt->psNext = m_psFirstWorkerThread.load();
+    wt->hThread = CPLCreateJoinableThread(WorkerThreadFunction, wt.get());
+    if (wt->hThread == nullptr)
+        return nullptr;
+    m_psFirstWorkerThread = wt.get();
+    aWT.emplace_back(std::move(wt));
+    m_bAllThreadsStarted = static_cast<int>(aWT.size()) >= m_nMaxThreads;
+    return aWT.back().get();
+}
+
+/************************************************************************/
+/*                        GetNextWorkerThread()                         */
+/************************************************************************/
+
+// Return the next worker thread in a round-robin way, or nullptr if there
+// is none. Concurrent callers may get the same thread, which only affects
+// the balance of the queues.
+CPLWorkerThread *CPLWorkerThreadPool::GetNextWorkerThread()
+{
+    CPLWorkerThread *psWorkerThread = m_psNextWorkerThread.load();
+    if (psWorkerThread == nullptr)
+        psWorkerThread = m_psFirstWorkerThread.load();
+    if (psWorkerThread != nullptr)
+        m_psNextWorkerThread = psWorkerThread->psNext;
+    return psWorkerThread;
+}
+
+/************************************************************************/
+/*                              PushJob()                               */
+/************************************************************************/
+
+void CPLWorkerThreadPool::PushJob(CPLWorkerThread *psWorkerThread,
+                                  std::function<void()> &task, bool bWakeUp)
+{
+    std::lock_guard<std::mutex> oGuardWT(psWorkerThread->m_mutex);
+    nPendingJobs++;
+    psWorkerThread->m_jobs.emplace_back(std::move(task));
+    m_nQueuedJobs++;
+    if (bWakeUp)
+    {
+#if DEBUG_VERBOSE
+        CPLDebug("JOB", "Waking up %p", psWorkerThread);
+#endif
+        CPLAssert(psWorkerThread->bMarkedAsWaiting);
+        psWorkerThread->bMarkedAsWaiting = false;
+        psWorkerThread->m_cv.notify_one();
+    }
+}
+
+/************************************************************************/
+/*                              QueueJob()                              */
+/************************************************************************/
+
+// Must be called with m_mutex held.
+// Returns false, without taking ownership of the task, if no worker thread
+// can take it: that is if the job is submitted from a worker thread and no
+// other thread is available, or if the pool has no thread at all.
+bool CPLWorkerThreadPool::QueueJob(std::function<void()> &task,
+                                   bool bFromWorkerThread)
+{
+    if (!m_apoWaitingWorkerThreads.empty())
+    {
+        CPLWorkerThread *psWorkerThread = m_apoWaitingWorkerThreads.back();
+        m_apoWaitingWorkerThreads.pop_back();
+        nWaitingWorkerThreads--;
+        PushJob(psWorkerThread, task, true);
+        return true;
+    }
+
+    if (static_cast<int>(aWT.size()) < m_nMaxThreads)
+    {
+        // CPLDebug("CPL", "Starting new thread...");
+        CPLWorkerThread *psWorkerThread = StartWorkerThread(nullptr, nullptr);
+        if (psWorkerThread)
+        {
+            PushJob(psWorkerThread, task, false);
+            return true;
+        }
+        // If the thread could not be started, the job still needs to run, so
+        // give it to a busy thread.
+    }
+
+    return QueueJobToBusyThread(task, bFromWorkerThread);
+}
+
+/************************************************************************/
+/*                        QueueJobToBusyThread()                        */
+/************************************************************************/
+
+// Returns false, without taking ownership of the task, if the job is
+// submitted from a worker thread, or if the pool has no thread at all.
+bool CPLWorkerThreadPool::QueueJobToBusyThread(std::function<void()> &task,
+                                               bool bFromWorkerThread)
+{
+    if (bFromWorkerThread)
+        return false;
+    CPLWorkerThread *psWorkerThread = GetNextWorkerThread();
+    if (psWorkerThread == nullptr)
+        return false;
+    PushJob(psWorkerThread, task, false);
+    return true;
+}
+
+/************************************************************************/
+/*                      WakeUpWaitingWorkerThread()                     */
+/************************************************************************/
+
+void CPLWorkerThreadPool::WakeUpWaitingWorkerThread()
+{
+    std::lock_guard<std::mutex> oGuard(m_mutex);
+    if (m_apoWaitingWorkerThreads.empty())
+        return;
+    CPLWorkerThread *psWorkerThread = m_apoWaitingWorkerThreads.back();
+    m_apoWaitingWorkerThreads.pop_back();
+    nWaitingWorkerThreads--;
+
+    std::lock_guard<std::mutex> oGuardWT(psWorkerThread->m_mutex);
+    CPLAssert(psWorkerThread->bMarkedAsWaiting);
+    psWorkerThread->bMarkedAsWaiting = false;
+    psWorkerThread->m_cv.notify_one();
+}
+
 /************************************************************************/
 /*                             SubmitJob()                              */
 /************************************************************************/
@@ -127,6 +282,10 @@ bool CPLWorkerThreadPool::SubmitJob(CPLThreadFunc pfnFunc, void *pData)
 }
 
 /** Queue a new job.
+ *
+ * If called from a worker thread of this pool, and no other thread is
+ * available, the job is run synchronously. It is also run synchronously if
+ * the pool has no thread, because none could be started.
  *
  * @param task  Void function to execute.
  * @return true in case of success.
@@ -140,89 +299,33 @@ bool CPLWorkerThreadPool::SubmitJob(std::function<void()> task)
     }
 #endif
 
-    bool bMustIncrementWaitingWorkerThreadsAfterSubmission = false;
-    if (threadLocalCurrentThreadPool == this)
-    {
-        // If there are waiting threads or we have not started all allowed
-        // threads, we can submit this job asynchronously
-        {
-            std::unique_lock<std::mutex> oGuard(m_mutex);
-            if (nWaitingWorkerThreads > 0 ||
-                static_cast<int>(aWT.size()) < m_nMaxThreads)
-            {
-                bMustIncrementWaitingWorkerThreadsAfterSubmission = true;
-                nWaitingWorkerThreads--;
-            }
-        }
-        if (!bMustIncrementWaitingWorkerThreadsAfterSubmission)
-        {
-            // otherwise there is a risk of deadlock, so execute synchronously.
-            task();
-            return true;
-        }
-    }
-
-    std::unique_lock<std::mutex> oGuard(m_mutex);
+    const bool bFromWorkerThread = threadLocalCurrentThreadPool == this;
 
-    if (bMustIncrementWaitingWorkerThreadsAfterSubmission)
-        nWaitingWorkerThreads++;
-
-    if (static_cast<int>(aWT.size()) < m_nMaxThreads)
+    // Fast path when all threads are started and busy: m_mutex is not
+    // taken.
+    if (m_bAllThreadsStarted && nWaitingWorkerThreads == 0 &&
+        QueueJobToBusyThread(task, bFromWorkerThread))
     {
-        // CPLDebug("CPL", "Starting new thread...");
-        auto wt = std::make_unique<CPLWorkerThread>();
-        wt->poTP = this;
-        //ABELL - Why should this fail? And this is a *pool* thread, not necessarily
-        //  tied to the submitted job. The submitted job still needs to run, even if
-        //  this fails. If we can't create a thread, should the entire pool become invalid?
-        wt->hThread = CPLCreateJoinableThread(WorkerThreadFunction, wt.get());
-        /**
-        if (!wt->hThread)
-        {
-            VSIFree(psJob);
-            VSIFree(psItem);
-            return false;
-        }
-        **/
-        if (wt->hThread)
-            aWT.emplace_back(std::move(wt));
+        // A thread may have started to wait after the above check, and
+        // before the job was queued. As GetNextJob() checks for queued jobs
+        // after registering the thread as waiting, either it has seen the
+        // job, or we see it as waiting here.
+        if (nWaitingWorkerThreads > 0)
+            WakeUpWaitingWorkerThread();
+        return true;
     }
 
-    jobQueue.emplace(task);
-    nPendingJobs++;
-
-    if (psWaitingWorkerThreadsList)
+    if (!bFromWorkerThread || !m_bAllThreadsStarted ||
+        nWaitingWorkerThreads > 0)
     {
-        CPLWorkerThread *psWorkerThread =
-            static_cast<CPLWorkerThread *>(psWaitingWorkerThreadsList->pData);
-
-        CPLAssert(psWorkerThread->bMarkedAsWaiting);
-        psWorkerThread->bMarkedAsWaiting = false;
-
-        CPLList *psNext = psWaitingWorkerThreadsList->psNext;
-        CPLList *psToFree = psWaitingWorkerThreadsList;
-        psWaitingWorkerThreadsList = psNext;
-        nWaitingWorkerThreads--;
-
-#if DEBUG_VERBOSE
-        CPLDebug("JOB", "Waking up %p", psWorkerThread);
-#endif
-
-#ifdef __COVERITY__
-        CPLError(CE_Failure, CPLE_AppDefined, "Not implemented");
-#else
-        {
-            std::lock_guard<std::mutex> oGuardWT(psWorkerThread->m_mutex);
-            // coverity[uninit_use_in_call]
-            oGuard.unlock();
-            psWorkerThread->m_cv.notify_one();
-        }
-#endif
-
-        CPLFree(psToFree);
+        std::lock_guard<std::mutex> oGuard(m_mutex);
+        if (QueueJob(task, bFromWorkerThread))
+            return true;
     }
 
-    // coverity[double_unlock]
+    // From a worker thread, there is otherwise a risk of deadlock, so
+    // execute synchronously.
+    task();
     return true;
 }
 
@@ -242,13 +345,6 @@ bool CPLWorkerThreadPool::SubmitJobs(CPLThreadFunc pfnFunc,
     if (apData.empty())
         return false;
 
-#ifdef DEBUG
-    {
-        std::unique_lock<std::mutex> oGuard(m_mutex);
-        CPLAssert(m_nMaxThreads > 0);
-    }
-#endif
-
     if (threadLocalCurrentThreadPool == this)
     {
         // If SubmitJob() is called from a worker thread of this queue,
@@ -258,65 +354,10 @@ bool CPLWorkerThreadPool::SubmitJobs(CPLThreadFunc pfnFunc,
         return true;
     }
 
-    std::unique_lock<std::mutex> oGuard(m_mutex);
-
     for (void *pData : apData)
     {
-        if (static_cast<int>(aWT.size()) < m_nMaxThreads)
-        {
-            std::unique_ptr<CPLWorkerThread> wt(new CPLWorkerThread);
-            wt->poTP = this;
-            wt->hThread =
-                CPLCreateJoinableThread(WorkerThreadFunction, wt.get());
-            if (wt->hThread == nullptr)
-            {
-                if (aWT.empty())
-                    return false;
-            }
-            else
-            {
-                aWT.emplace_back(std::move(wt));
-            }
-        }
-
-        jobQueue.emplace([=] { pfnFunc(pData); });
-        nPendingJobs++;
-    }
-
-    for (size_t i = 0; i < apData.size(); i++)
-    {
-        if (psWaitingWorkerThreadsList)
-        {
-            CPLWorkerThread *psWorkerThread;
-
-            psWorkerThread = static_cast<CPLWorkerThread *>(
-                psWaitingWorkerThreadsList->pData);
-
-            CPLAssert(psWorkerThread->bMarkedAsWaiting);
-            psWorkerThread->bMarkedAsWaiting = false;
-
-            CPLList *psNext = psWaitingWorkerThreadsList->psNext;
-            CPLList *psToFree = psWaitingWorkerThreadsList;
-            psWaitingWorkerThreadsList = psNext;
-            nWaitingWorkerThreads--;
-
-#if DEBUG_VERBOSE
-            CPLDebug("JOB", "Waking up %p", psWorkerThread);
-#endif
-            {
-                std::lock_guard<std::mutex> oGuardWT(psWorkerThread->m_mutex);
-                // coverity[uninit_use_in_call]
-                oGuard.unlock();
-                psWorkerThread->m_cv.notify_one();
-            }
-
-            CPLFree(psToFree);
-            oGuard.lock();
-        }
-        else
-        {
-            break;
-        }
+        if (!SubmitJob([=] { pfnFunc(pData); }))
+            return false;
     }
 
     return true;
@@ -337,8 +378,7 @@ void CPLWorkerThreadPool::WaitCompletion(int nMaxRemainingJobs)
     if (nMaxRemainingJobs < 0)
         nMaxRemainingJobs = 0;
     std::unique_lock<std::mutex> oGuard(m_mutex);
-    m_cv.wait(oGuard, [this, nMaxRemainingJobs]
-              { return nPendingJobs <= nMaxRemainingJobs; });
+    WaitPendingJobsAtMost(oGuard, nMaxRemainingJobs);
 }
 
 /************************************************************************/
@@ -353,11 +393,30 @@ void CPLWorkerThreadPool::WaitEvent()
     // a notification occurs, jobs could be submitted which would increase
     // nPendingJobs, so a job completion may looks like a spurious wakeup.
     std::unique_lock<std::mutex> oGuard(m_mutex);
-    if (nPendingJobs == 0)
-        return;
     const int nPendingJobsBefore = nPendingJobs;
-    m_cv.wait(oGuard, [this, nPendingJobsBefore]
-              { return nPendingJobs < nPendingJobsBefore; });
+    if (nPendingJobsBefore > 0)
+        WaitPendingJobsAtMost(oGuard, nPendingJobsBefore - 1);
+}
+
+/************************************************************************/
+/*                        WaitPendingJobsAtMost()                       */
+/************************************************************************/
+
+// Must be called with m_mutex held by oGuard.
+void CPLWorkerThreadPool::WaitPendingJobsAtMost(
+    std::unique_lock<std::mutex> &oGuard, int nMaxPendingJobs)
+{
+    // DeclareJobFinished() only notifies m_cv when the number of pending jobs
+    // reaches the threshold, so the threshold must be set before checking
+    // nPendingJobs. With several waiters, the highest threshold is kept until
+    // they have all returned, which may only cause spurious wake-ups.
+    ++m_nCompletionWaiters;
+    if (nMaxPendingJobs > m_nCompletionNotifyThreshold)
+        m_nCompletionNotifyThreshold = nMaxPendingJobs;
+    m_cv.wait(oGuard, [this, nMaxPendingJobs]
+              { return nPendingJobs <= nMaxPendingJobs; });
+    if (--m_nCompletionWaiters == 0)
+        m_nCompletionNotifyThreshold = -1;
 }
 
 /************************************************************************/
@@ -392,46 +451,38 @@ bool CPLWorkerThreadPool::Setup(int nThreads, CPLThreadFunc pfnInitFunc,
 {
     CPLAssert(nThreads > 0);
 
+    std::unique_lock<std::mutex> oGuard(m_mutex);
+
     if (nThreads > static_cast<int>(aWT.size()) && pfnInitFunc == nullptr &&
         pasInitData == nullptr && !bWaitallStarted)
     {
-        std::lock_guard<std::mutex> oGuard(m_mutex);
         if (nThreads > m_nMaxThreads)
             m_nMaxThreads = nThreads;
+        m_bAllThreadsStarted = false;
         return true;
     }
 
     bool bRet = true;
     for (int i = static_cast<int>(aWT.size()); i < nThreads; i++)
     {
-        auto wt = std::make_unique<CPLWorkerThread>();
-        wt->pfnInitFunc = pfnInitFunc;
-        wt->pInitData = pasInitData ? pasInitData[i] : nullptr;
-        wt->poTP = this;
-        wt->hThread = CPLCreateJoinableThread(WorkerThreadFunction, wt.get());
-        if (wt->hThread == nullptr)
+        if (!StartWorkerThread(pfnInitFunc,
+                               pasInitData ? pasInitData[i] : nullptr))
         {
             nThreads = i;
             bRet = false;
             break;
         }
-        aWT.emplace_back(std::move(wt));
     }
 
-    {
-        std::lock_guard<std::mutex> oGuard(m_mutex);
-        if (nThreads > m_nMaxThreads)
-            m_nMaxThreads = nThreads;
-    }
+    if (nThreads > m_nMaxThreads)
+        m_nMaxThreads = nThreads;
+    m_bAllThreadsStarted = static_cast<int>(aWT.size()) >= m_nMaxThreads;
 
     if (bWaitallStarted)
     {
         // Wait all threads to be started
-        std::unique_lock<std::mutex> oGuard(m_mutex);
-        while (nWaitingWorkerThreads < nThreads)
-        {
-            m_cv.wait(oGuard);
-        }
+        m_cv.wait(oGuard, [this, nThreads]
+                  { return nWaitingWorkerThreads >= nThreads; });
     }
 
     if (eState == CPLWTS_ERROR)
@@ -446,9 +497,62 @@ bool CPLWorkerThreadPool::Setup(int nThreads, CPLThreadFunc pfnInitFunc,
 
 void CPLWorkerThreadPool::DeclareJobFinished()
 {
-    std::lock_guard<std::mutex> oGuard(m_mutex);
-    nPendingJobs--;
-    m_cv.notify_one();
+    const int nRemainingJobs = --nPendingJobs;
+    // Avoid taking the pool-wide mutex when nobody waits for that number of
+    // pending jobs.
+    if (nRemainingJobs <= m_nCompletionNotifyThreshold)
+    {
+        std::lock_guard<std::mutex> oGuard(m_mutex);
+        m_cv.notify_all();
+    }
+}
+
+/************************************************************************/
+/*                               PopJob()                               */
+/************************************************************************/
+
+// Take the oldest job of the queue of the worker thread.
+bool CPLWorkerThreadPool::PopJob(CPLWorkerThread *psWorkerThread,
+                                 std::function<void()> &task)
+{
+    std::lock_guard<std::mutex> oGuard(psWorkerThread->m_mutex);
+    if (psWorkerThread->m_jobs.empty())
+        return false;
+    task = std::move(psWorkerThread->m_jobs.front());
+    psWorkerThread->m_jobs.pop_front();
+    m_nQueuedJobs--;
+    return true;
+}
+
+/************************************************************************/
+/*                              StealJob()                              */
+/************************************************************************/
+
+// Take the newest job of the queue of another worker thread.
+bool CPLWorkerThreadPool::StealJob(CPLWorkerThread *psWorkerThread,
+                                   std::function<void()> &task)
+{
+    for (CPLWorkerThread *psOther = m_psFirstWorkerThread.load();
+         psOther != nullptr && m_nQueuedJobs > 0; psOther = psOther->psNext)
+    {
+        if (psOther == psWorkerThread)
+            continue;
+        // Skip threads whose queue is being accessed: GetNextJob() will
+        // retry anyway before going to sleep if there are still queued jobs.
+        std::unique_lock<std::mutex> oGuard(psOther->m_mutex,
+                                            std::try_to_lock);
+        if (oGuard.owns_lock() && !psOther->m_jobs.empty())
+        {
+#if DEBUG_VERBOSE
+            CPLDebug("JOB", "%p stole a job from %p", psWorkerThread, psOther);
+#endif
+            task = std::move(psOther->m_jobs.back());
+            psOther->m_jobs.pop_back();
+            m_nQueuedJobs--;
+            return true;
+        }
+    }
+    return false;
 }
 
 /************************************************************************/
@@ -458,64 +562,57 @@ void CPLWorkerThreadPool::DeclareJobFinished()
 std::function<void()>
 CPLWorkerThreadPool::GetNextJob(CPLWorkerThread *psWorkerThread)
 {
-    std::unique_lock<std::mutex> oGuard(m_mutex);
     while (true)
     {
         if (eState == CPLWTS_STOP)
             return std::function<void()>();
 
-        if (jobQueue.size())
+        std::function<void()> task;
+        if (PopJob(psWorkerThread, task) || StealJob(psWorkerThread, task))
         {
 #if DEBUG_VERBOSE
             CPLDebug("JOB", "%p got a job", psWorkerThread);
 #endif
-            auto task = std::move(jobQueue.front());
-            jobQueue.pop();
             return task;
         }
 
-        if (!psWorkerThread->bMarkedAsWaiting)
         {
-            psWorkerThread->bMarkedAsWaiting = true;
-            nWaitingWorkerThreads++;
+            std::lock_guard<std::mutex> oGuard(m_mutex);
+            if (eState == CPLWTS_STOP)
+                return std::function<void()>();
 
-            CPLList *psItem =
-                static_cast<CPLList *>(VSI_MALLOC_VERBOSE(sizeof(CPLList)));
-            if (psItem == nullptr)
+            // Register as waiting before checking for queued jobs: see
+            // SubmitJob(), which can queue jobs without m_mutex.
+            m_apoWaitingWorkerThreads.push_back(psWorkerThread);
+            nWaitingWorkerThreads++;
+            if (m_nQueuedJobs > 0)
             {
-                eState = CPLWTS_ERROR;
-                m_cv.notify_one();
-
-                return nullptr;
+                m_apoWaitingWorkerThreads.pop_back();
+                nWaitingWorkerThreads--;
+                continue;
             }
 
-            psItem->pData = psWorkerThread;
-            psItem->psNext = psWaitingWorkerThreadsList;
-            psWaitingWorkerThreadsList = psItem;
+            {
+                std::lock_guard<std::mutex> oGuardWT(psWorkerThread->m_mutex);
+                psWorkerThread->bMarkedAsWaiting = true;
+            }
 
-#if DEBUG_VERBOSE
-            CPLAssert(CPLListCount(psWaitingWorkerThreadsList) ==
-                      nWaitingWorkerThreads);
-#endif
+            // For Setup() waiting for all threads to be started
+            m_cv.notify_all();
         }
 
-        m_cv.notify_one();
-
 #if DEBUG_VERBOSE
         CPLDebug("JOB", "%p sleeping", psWorkerThread);
 #endif
 
-#ifdef __COVERITY__
-        CPLError(CE_Failure, CPLE_AppDefined, "Not implemented");
-#else
-        std::unique_lock<std::mutex> oGuardThisThread(psWorkerThread->m_mutex);
-        // coverity[uninit_use_in_call]
-        oGuard.unlock();
-        // coverity[wait_not_in_locked_loop]
-        psWorkerThread->m_cv.wait(oGuardThisThread);
-        // coverity[lock_order]
-        oGuard.lock();
-#endif
+        std::unique_lock<std::mutex> oGuardWT(psWorkerThread->m_mutex);
+        psWorkerThread->m_cv.wait(oGuardWT,
+                                  [this, psWorkerThread]
+                                  {
+                                      return !psWorkerThread
+                                                  ->bMarkedAsWaiting ||
+                                             eState == CPLWTS_STOP;
+                                  });
     }
 }
 
@@ -563,7 +660,10 @@ void CPLJobQueue::DeclareJobFinished()
 {
     std::lock_guard<std::mutex> oGuard(m_mutex);
     m_nPendingJobs--;
-    m_cv.notify_one();
+    // Only wake up waiters that may be satisfied, as the wake-up of a thread
+    // can be much more expensive than a short job.
+    if (m_nPendingJobs <= m_nCompletionNotifyThreshold)
+        m_cv.notify_all();
 }
 
 /************************************************************************/
@@ -616,8 +716,7 @@ bool CPLJobQueue::SubmitJob(std::function<void()> task)
 void CPLJobQueue::WaitCompletion(int nMaxRemainingJobs)
 {
     std::unique_lock<std::mutex> oGuard(m_mutex);
-    m_cv.wait(oGuard, [this, nMaxRemainingJobs]
-              { return m_nPendingJobs <= nMaxRemainingJobs; });
+    WaitPendingJobsAtMost(oGuard, nMaxRemainingJobs);
 }
 
 /************************************************************************/
@@ -638,7 +737,25 @@ bool CPLJobQueue::WaitEvent()
         return false;
 
     const int nPendingJobsBefore = m_nPendingJobs;
-    m_cv.wait(oGuard, [this, nPendingJobsBefore]
-              { return m_nPendingJobs < nPendingJobsBefore; });
+    WaitPendingJobsAtMost(oGuard, nPendingJobsBefore - 1);
     return m_nPendingJobs > 0;
 }
+
+/************************************************************************/
+/*                        WaitPendingJobsAtMost()                       */
+/************************************************************************/
+
+// Must be called with m_mutex held by oGuard.
+void CPLJobQueue::WaitPendingJobsAtMost(std::unique_lock<std::mutex> &oGuard,
+                                        int nMaxPendingJobs)
+{
+    // With several waiters, the highest threshold is kept until they have
+    // all returned, which may only cause spurious wake-ups.
+    ++m_nCompletionWaiters;
+    if (nMaxPendingJobs > m_nCompletionNotifyThreshold)
+        m_nCompletionNotifyThreshold = nMaxPendingJobs;
+    m_cv.wait(oGuard, [this, nMaxPendingJobs]
+              { return m_nPendingJobs <= nMaxPendingJobs; });
+    if (--m_nCompletionWaiters == 0)
+        m_nCompletionNotifyThreshold = -1;
+}
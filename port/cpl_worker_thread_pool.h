@@ -16,7 +16,9 @@
 #include "cpl_multiproc.h"
 #include "cpl_list.h"
 
+#include <atomic>
 #include <condition_variable>
+#include <deque>
 #include <functional>
 #include <memory>
 #include <mutex>
@@ -42,10 +44,16 @@ struct CPLWorkerThread
     void *pInitData = nullptr;
     CPLWorkerThreadPool *poTP = nullptr;
     CPLJoinableThread *hThread = nullptr;
-    bool bMarkedAsWaiting = false;
+    // Next worker thread of the pool. Immutable once the thread is published.
+    CPLWorkerThread *psNext = nullptr;
 
+    // Protects the below members.
     std::mutex m_mutex{};
     std::condition_variable m_cv{};
+    bool bMarkedAsWaiting = false;
+    // Jobs assigned to this thread. The thread takes them from the front,
+    // and other threads of the pool steal them from the back.
+    std::deque<std::function<void()>> m_jobs{};
 };
 
 typedef enum
@@ -65,21 +73,51 @@ class CPL_DLL CPLWorkerThreadPool
 {
     CPL_DISALLOW_COPY_ASSIGN(CPLWorkerThreadPool)
 
+    // Protected by m_mutex.
     std::vector<std::unique_ptr<CPLWorkerThread>> aWT{};
+    // Head of the list of worker threads, that can be walked without
+    // holding m_mutex.
+    std::atomic<CPLWorkerThread *> m_psFirstWorkerThread{nullptr};
     mutable std::mutex m_mutex{};
     std::condition_variable m_cv{};
-    volatile CPLWorkerThreadState eState = CPLWTS_OK;
-    std::queue<std::function<void()>> jobQueue;
-    int nPendingJobs = 0;
-
-    CPLList *psWaitingWorkerThreadsList = nullptr;
-    int nWaitingWorkerThreads = 0;
+    std::atomic<CPLWorkerThreadState> eState{CPLWTS_OK};
+    std::atomic<int> nPendingJobs{0};
+    // Number of jobs in the per-thread queues, not yet started.
+    std::atomic<int> m_nQueuedJobs{0};
+    // Number of pending jobs at or below which a job completion must notify
+    // m_cv, or -1 if no thread waits for jobs to complete.
+    std::atomic<int> m_nCompletionNotifyThreshold{-1};
+    // Number of threads in m_apoWaitingWorkerThreads. Only modified with
+    // m_mutex held, but read without it by SubmitJob().
+    std::atomic<int> nWaitingWorkerThreads{0};
+    // Whether all the m_nMaxThreads threads have been started.
+    std::atomic<bool> m_bAllThreadsStarted{false};
+    // Next worker thread to which a job is queued when all are busy.
+    std::atomic<CPLWorkerThread *> m_psNextWorkerThread{nullptr};
+
+    // Protected by m_mutex.
+    std::vector<CPLWorkerThread *> m_apoWaitingWorkerThreads{};
+    int m_nCompletionWaiters = 0;
 
     int m_nMaxThreads = 0;
 
     static void WorkerThreadFunction(void *user_data);
 
+    CPLWorkerThread *StartWorkerThread(CPLThreadFunc pfnInitFunc,
+                                       void *pInitData);
+    CPLWorkerThread *GetNextWorkerThread();
+    void PushJob(CPLWorkerThread *psWorkerThread, std::function<void()> &task,
+                 bool bWakeUp);
+    bool QueueJob(std::function<void()> &task, bool bFromWorkerThread);
+    bool QueueJobToBusyThread(std::function<void()> &task,
+                              bool bFromWorkerThread);
+    void WakeUpWaitingWorkerThread();
     void DeclareJobFinished();
+    void WaitPendingJobsAtMost(std::unique_lock<std::mutex> &oGuard,
+                               int nMaxPendingJobs);
+    bool PopJob(CPLWorkerThread *psWorkerThread, std::function<void()> &task);
+    bool StealJob(CPLWorkerThread *psWorkerThread,
+                  std::function<void()> &task);
     std::function<void()> GetNextJob(CPLWorkerThread *psWorkerThread);
 
   public:
@@ -111,8 +149,14 @@ class CPL_DLL CPLJobQueue
     std::mutex m_mutex{};
     std::condition_variable m_cv{};
     int m_nPendingJobs = 0;
+    int m_nCompletionWaiters = 0;
+    // Number of pending jobs at or below which a job completion must notify
+    // m_cv, or -1 if no thread waits for jobs to complete.
+    int m_nCompletionNotifyThreshold = -1;
 
     void DeclareJobFinished();
+    void WaitPendingJobsAtMost(std::unique_lock<std::mutex> &oGuard,
+                               int nMaxPendingJobs);
 
     //! @cond Doxygen_Suppress
   protected: